@@ -0,0 +1,98 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Compiler Arena
+ * --------------
+ * Bump allocator for front-end data: AST nodes, type information, checker
+ * symbols and IR. Everything allocated during a compilation is released at
+ * once by endCompilation(); nodes are never freed individually.
+ *
+ * Arena memory is not counted by the GC, so building a large AST cannot
+ * trigger a collection. Heap objects the nodes refer to (string literals)
+ * are registered with compilerPinValue() and stay marked until the arena
+ * is released.
+ */
+
+#ifndef PROX_ARENA_H
+#define PROX_ARENA_H
+
+#include "common.h"
+#include "value.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock* blocks;   // Newest first; only the head has free space
+    size_t bytesUsed;
+
+    Value* roots;         // Objects referenced from arena nodes
+    int rootCount;
+    int rootCapacity;
+
+    struct Arena* enclosing; // Compilation this one is nested in
+    struct Arena* nextLive;  // All arenas not yet freed, for the GC
+} Arena;
+
+void initArena(Arena* arena);
+void freeArena(Arena* arena);
+
+// Returns zeroed memory aligned for any node type.
+void* arenaAlloc(Arena* arena, size_t size);
+
+// Grows an allocation made from the same arena. The newest allocation is
+// extended in place; others are copied.
+void* arenaGrow(Arena* arena, void* pointer, size_t oldSize, size_t newSize);
+
+// --- Active compilation ---
+// Front-end constructors allocate from the innermost arena active on the
+// calling thread. Calls made outside beginCompilation() use a
+// process-lifetime arena.
+
+void beginCompilation(Arena* arena);
+void endCompilation(Arena* arena);
+
+// Makes a begun arena inactive without freeing it, so its AST can be
+// handed to another thread, and makes it active again there.
+void leaveCompilation(Arena* arena);
+void enterCompilation(Arena* arena);
+
+void* compilerAlloc(size_t size);
+void* compilerGrow(void* pointer, size_t oldSize, size_t newSize);
+char* compilerCopyString(const char* chars, int length);
+char* compilerStrdup(const char* string);
+void compilerPinValue(Value value);
+
+// Marks pinned values of every live arena (called by the GC).
+void markCompilerArenas(void);
+
+// --- Threaded front-ends ---
+// While front-ends run on several threads, the VM string table and the
+// identifier set are shared; compilerLock() serializes access to them.
+// Both are no-ops unless setCompilerThreaded(true) is in effect.
+
+void setCompilerThreaded(bool threaded);
+void compilerLock(void);
+void compilerUnlock(void);
+
+// Interned string for a literal, safe to call from a front-end thread.
+Value compilerString(const char* chars, int length);
+
+#define COMPILER_NEW(type) ((type*)compilerAlloc(sizeof(type)))
+
+#define COMPILER_GROW_ARRAY(type, pointer, oldCount, newCount)                 \
+  (type *)compilerGrow(pointer, sizeof(type) * (oldCount),                     \
+                       sizeof(type) * (newCount))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROX_ARENA_H
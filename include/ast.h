@@ -54,9 +54,25 @@ typedef enum {
   EXPR_ACTOR_REQUEST
 } ExprType;
 
+// Operators are resolved by the parser, so later passes switch on these
+// instead of comparing lexemes.
+typedef enum {
+  AST_OP_ADD, AST_OP_SUBTRACT, AST_OP_MULTIPLY, AST_OP_DIVIDE, AST_OP_MODULO,
+  AST_OP_POWER, AST_OP_MAT_MUL,
+  AST_OP_EQUAL, AST_OP_NOT_EQUAL,
+  AST_OP_LESS, AST_OP_LESS_EQUAL, AST_OP_GREATER, AST_OP_GREATER_EQUAL,
+  AST_OP_BIT_AND, AST_OP_BIT_OR, AST_OP_BIT_XOR, AST_OP_LEFT_SHIFT, AST_OP_RIGHT_SHIFT,
+
+  // Unary
+  AST_OP_NOT, AST_OP_NEGATE, AST_OP_BIT_NOT,
+
+  // Logical
+  AST_OP_AND, AST_OP_OR
+} AstOperator;
+
 typedef enum {
   STMT_EXPRESSION, STMT_VAR_DECL, STMT_FUNC_DECL, STMT_CLASS_DECL, STMT_INTERFACE_DECL,
-  STMT_USE_DECL, STMT_IF, STMT_WHILE, STMT_FOR, STMT_RETURN,
+  STMT_USE_DECL, STMT_IF, STMT_WHILE, STMT_FOR, STMT_FOR_IN, STMT_RETURN,
   STMT_BLOCK, STMT_BREAK, STMT_CONTINUE, STMT_SWITCH,
   STMT_TRY_CATCH, STMT_PRINT, STMT_EXTERN_DECL,
   STMT_INTENT_DECL, STMT_RESOLVER_DECL,
@@ -132,14 +148,25 @@ struct SwitchCaseList {
   int capacity;
 };
 
+// --- Escape Analysis ---
+// How far a closure value may travel (see escape_analysis.h). Ordered: a
+// closure is stack-allocated only up to ESCAPE_ARGUMENT.
+typedef enum {
+    ESCAPE_NONE,      // Only called or printed where it was created
+    ESCAPE_ARGUMENT,  // Also passed to calls, each guarded at run time
+    ESCAPE_GLOBAL,    // Bound to a global name
+    ESCAPE_RETURN,    // Returned from the enclosing function
+    ESCAPE_HEAP       // Stored, captured, or otherwise unaccounted for
+} EscapeState;
+
 // --- Expression Data Structures ---
-typedef struct { Expr *left; char *operator; Expr *right; } BinaryExpr;
-typedef struct { char *operator; Expr *right; } UnaryExpr;
+typedef struct { Expr *left; AstOperator op; Expr *right; } BinaryExpr;
+typedef struct { AstOperator op; Expr *right; } UnaryExpr;
 typedef struct { Value value; } LiteralExpr;
 typedef struct { Expr *expression; } GroupingExpr;
-typedef struct { char *name; } VariableExpr;
-typedef struct { char *name; Expr *value; } AssignExpr;
-typedef struct { Expr *left; char *operator; Expr *right; } LogicalExpr;
+typedef struct { const char *name; } VariableExpr; // name is interned
+typedef struct { const char *name; Expr *value; } AssignExpr; // name is interned
+typedef struct { Expr *left; AstOperator op; Expr *right; } LogicalExpr;
 typedef struct { Expr *value; } SanitizeExpr;
 typedef struct { Expr *value; bool isEncrypt; } CryptoExpr; // isEncrypt=true (encrypt), false (decrypt)
 typedef struct { Expr *callee; ExprList *arguments; } CallExpr;
@@ -150,7 +177,11 @@ typedef struct { Expr *target; Expr *index; Expr *value; } SetIndexExpr;
 typedef struct { ExprList *elements; } ListExpr;
 typedef struct { DictPairList *pairs; } DictionaryExpr;
 typedef struct { Expr *condition; Expr *true_branch; Expr *false_branch; } TernaryExpr;
-typedef struct { StringList *params; StmtList *body; } LambdaExpr;
+typedef struct {
+  StringList *params; StmtList *body;
+  EscapeState escape;        // Set by analyzeEscapes()
+  uint32_t retainedParams;   // Bit i: parameter i may outlive the call (bit 31 covers the rest)
+} LambdaExpr;
 typedef struct { Expr *expression; } AwaitExpr;
 typedef struct { int dummy; } ThisExpr;
 typedef struct { char *method; } SuperExpr; 
@@ -189,13 +220,15 @@ struct Expr {
 // --- Statement Data Structures ---
 typedef struct { Expr *expression; } ExpressionStmt;
 typedef struct { char *name; Expr *initializer; TypeInfo type; bool is_const; bool isTemporal; int ttl; } VarDeclStmt;
-typedef struct { char *name; StringList *params; StmtList *body; TypeInfo returnType; bool isAsync; AccessLevel access; bool isStatic; bool isAbstract; Expr *contextCondition; StringList *genericParams; StringList *genericBounds; } FuncDeclStmt;
+typedef struct { char *name; StringList *params; StmtList *body; TypeInfo returnType; bool isAsync; AccessLevel access; bool isStatic; bool isAbstract; Expr *contextCondition; StringList *genericParams; StringList *genericBounds;
+                 EscapeState escape; uint32_t retainedParams; /* as in LambdaExpr */ } FuncDeclStmt;
 typedef struct { char *name; Expr *superclass; StringList *interfaces; StmtList *methods; StringList *genericParams; StringList *genericBounds; } ClassDeclStmt;
 typedef struct { char *name; StmtList *methods; } InterfaceDeclStmt;
 typedef struct { StringList *modules; } UseDeclStmt;
 typedef struct { Expr *condition; Stmt *then_branch; Stmt *else_branch; } IfStmt;
 typedef struct { Expr *condition; Stmt *body; } WhileStmt;
 typedef struct { Stmt *initializer; Expr *condition; Expr *increment; Stmt *body; } ForStmt;
+typedef struct { char *name; Expr *iterable; Stmt *body; } ForInStmt; // for (let name in iterable)
 typedef struct { Expr *value; } ReturnStmt;
 typedef struct { StmtList *statements; } BlockStmt;
 typedef struct { int dummy; } BreakStmt;
@@ -244,7 +277,7 @@ struct Stmt {
   union {
     ExpressionStmt expression; VarDeclStmt var_decl; FuncDeclStmt func_decl;
     ClassDeclStmt class_decl; InterfaceDeclStmt interface_decl; UseDeclStmt use_decl; IfStmt if_stmt;
-    WhileStmt while_stmt; ForStmt for_stmt; ReturnStmt return_stmt;
+    WhileStmt while_stmt; ForStmt for_stmt; ForInStmt for_in; ReturnStmt return_stmt;
     BlockStmt block; BreakStmt break_stmt; ContinueStmt continue_stmt;
     SwitchStmt switch_stmt; TryCatchStmt try_catch; PrintStmt print;
     ExternDeclStmt extern_decl;
@@ -278,13 +311,19 @@ struct Stmt {
 };
 
 // --- Function Prototypes ---
-Expr *createBinaryExpr(Expr *left, const char *op, Expr *right, int line, int column);
-Expr *createUnaryExpr(const char *op, Expr *right, int line, int column);
+const char *astOperatorLexeme(AstOperator op);
+
+// Returns the canonical copy of an identifier. Interned names live for the
+// whole process and compare equal only if the pointers are equal.
+const char *internName(const char *chars, int length);
+
+Expr *createBinaryExpr(Expr *left, AstOperator op, Expr *right, int line, int column);
+Expr *createUnaryExpr(AstOperator op, Expr *right, int line, int column);
 Expr *createLiteralExpr(Value value, int line, int column);
 Expr *createGroupingExpr(Expr *expression, int line, int column);
 Expr *createVariableExpr(const char *name, int line, int column);
 Expr *createAssignExpr(const char *name, Expr *value, int line, int column);
-Expr *createLogicalExpr(Expr *left, const char *op, Expr *right, int line, int column);
+Expr *createLogicalExpr(Expr *left, AstOperator op, Expr *right, int line, int column);
 Expr *createCallExpr(Expr *callee, ExprList *arguments, int line, int column);
 Expr *createGetExpr(Expr *object, const char *name, int line, int column);
 Expr *createSetExpr(Expr *object, const char *name, Expr *value, int line, int column);
@@ -315,6 +354,7 @@ Stmt *createUseDeclStmt(StringList *modules, int line, int column);
 Stmt *createIfStmt(Expr *cond, Stmt *then_br, Stmt *else_br, int line, int column);
 Stmt *createWhileStmt(Expr *cond, Stmt *body, int line, int column);
 Stmt *createForStmt(Stmt *init, Expr *cond, Expr *incr, Stmt *body, int line, int column);
+Stmt *createForInStmt(const char *name, Expr *iterable, Stmt *body, int line, int column);
 Stmt *createReturnStmt(Expr *value, int line, int column);
 Stmt *createBlockStmt(StmtList *statements, int line, int column);
 Stmt *createBreakStmt(int line, int column);
@@ -359,21 +399,13 @@ void appendExpr(ExprList *list, Expr *expr);
 Expr *createSanitizeExpr(Expr *value, int line, int column); // Added prototype
 Expr *createLambdaExpr(StringList *params, StmtList *body, int line, int column);
 
-void freeExprList(ExprList *list);
 StmtList *createStmtList();
 void appendStmt(StmtList *list, Stmt *stmt);
-void freeStmtList(StmtList *list);
 StringList *createStringList();
 void appendString(StringList *list, const char *str);
-void freeStringList(StringList *list);
 DictPairList *createDictPairList();
 void appendDictPair(DictPairList *list, Expr *key, Expr *value);
-void freeDictPairList(DictPairList *list);
 SwitchCaseList *createSwitchCaseList();
 void appendSwitchCase(SwitchCaseList *list, Expr *value, StmtList *statements);
-void freeSwitchCaseList(SwitchCaseList *list);
-
-void freeExpr(Expr *expr);
-void freeStmt(Stmt *stmt);
 
 #endif // PROX_AST_H
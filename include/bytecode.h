@@ -95,6 +95,37 @@ typedef enum {
   OP_MAT_MUL, // @ operator
   OP_MAKE_TENSOR,
   OP_UNWRAP,
+  OP_LESS_EQUAL,
+  OP_GREATER_EQUAL,
+  OP_JUMP_IF_FALSE_POP, // Like OP_JUMP_IF_FALSE but pops the condition
+  OP_LOOP_IF_TRUE,      // Pops the condition, loops back if it is truthy
+  // Fused compare-and-loop, always followed by an OP_LOOP_IF_TRUE. With two
+  // numbers the comparison and the branch happen in one dispatch; otherwise
+  // the plain comparison runs and execution falls into the OP_LOOP_IF_TRUE.
+  OP_LOOP_IF_LESS,
+  OP_LOOP_IF_LESS_EQUAL,
+  OP_LOOP_IF_GREATER,
+  OP_LOOP_IF_GREATER_EQUAL,
+  // Operands as OP_CLOSURE. The closure lives in a per-slot block owned by
+  // the VM instead of the heap; escape analysis guarantees it dies with the
+  // slot it is created in.
+  OP_STACK_CLOSURE,
+  // Before OP_CALL with the argument count: copies stack closures among the
+  // arguments to the heap if the callee may retain those parameters.
+  OP_GUARD_ARGS,
+  // Index into the running closure's captures: variables that are never
+  // reassigned, copied by value when the closure was made.
+  OP_GET_CAPTURE,
+  // Replaces the value on top of the stack with an iterator over it (see
+  // iterator.h); a runtime error if it cannot be iterated.
+  OP_ITER,
+  // Head of a for-in loop, whose iterator and loop variable are the two
+  // topmost slots: stores the iterator's next item in the variable, or
+  // jumps forward by the offset once the iterator is exhausted.
+  OP_FOR_ITER,
+  // Prefix: the next instruction's constant index is 24 bits, its slot or
+  // count 16 bits and its jump offset 32 bits, big-endian.
+  OP_WIDE,
   OP_HALT = 0xFF
 } OpCode;
 
@@ -117,6 +148,7 @@ struct Chunk {
   int *lines;
   ValueArray constants;
   ExceptionHandlerTable exceptionHandlers;
+  bool borrowed; // code/lines point into a mapped image and are not owned
 };
 
 void initChunk(Chunk *chunk);
@@ -0,0 +1,96 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Compiled bytecode images (.proxc) and the on-disk compile cache.
+ *
+ * An image holds a complete top-level ObjFunction: nested function
+ * constants, upvalue counts, line tables and exception handler tables,
+ * laid out to be mmap'ed and used in place.
+ * Upvalue descriptors (isLocal, index) travel inside the code stream
+ * after each OP_CLOSURE (or OP_STACK_CLOSURE), so they round-trip with the code bytes.
+ *
+ * The cache stores one image per source text under
+ * <cache dir>/<sha256>.proxc, where the key hashes the compiler version,
+ * the image format version and the source. Since the key covers nothing
+ * else, only programs whose `use` declarations all name native modules are
+ * cached (see entryCacheable). A hit skips parsing, optimization, type
+ * checking and bytecode generation.
+ */
+
+#ifndef PROX_BYTECODE_IMAGE_H
+#define PROX_BYTECODE_IMAGE_H
+
+#include "common.h"
+
+#define PROXC_MAGIC "PRXC"
+// Bump whenever the opcode set, operand encoding or image layout changes.
+#define PROXC_FORMAT_VERSION 8
+#define PROXC_KEY_SIZE 32
+#define PROXC_DEFAULT_CACHE_DIR ".pxcache"
+
+// Serializes 'function' into a freshly malloc'd image. Returns false if the
+// function holds a constant that has no image representation.
+bool proxc_serialize(ObjFunction *function, const uint8_t key[PROXC_KEY_SIZE],
+                     uint8_t **out_buf, size_t *out_len);
+
+// Loads an image in place: chunks reference its code and line tables and
+// strings may be interned straight from it, so 'image' must stay mapped and
+// unmodified for the rest of the process once a function is returned.
+// Returns NULL (having published nothing) when the image is malformed (bad
+// offsets, operands or checksum), was built for another format version or
+// ABI, or (if 'key' is non-NULL) was produced for a different key.
+// Collection is suspended while loading.
+ObjFunction *proxc_load(const uint8_t *image, size_t size,
+                        const uint8_t key[PROXC_KEY_SIZE]);
+
+// Image files are mmap'ed, so processes running the same program share
+// their code, line and string pages.
+int write_function_image(const char *path, ObjFunction *function);
+ObjFunction *read_function_image(const char *path);
+
+// Compile cache. PROXPL_CACHE_DIR overrides the directory and
+// PROXPL_NO_CACHE=1 disables the cache entirely.
+bool proxc_cache_enabled(void);
+const char *proxc_cache_dir(void);
+void proxc_ensure_cache_dir(void);
+void proxc_cache_key(const char *source, size_t length, uint8_t key[PROXC_KEY_SIZE]);
+ObjFunction *proxc_cache_load(const uint8_t key[PROXC_KEY_SIZE]);
+bool proxc_cache_store(const uint8_t key[PROXC_KEY_SIZE], ObjFunction *function);
+
+// File helpers shared with heap snapshots. Writes go through a temp file and
+// a rename; mappings are read-only.
+int proxc_write_file(const char *path, const uint8_t *buf, size_t len);
+uint8_t *proxc_map_file(const char *path, size_t *out_len);
+void proxc_unmap_file(uint8_t *image, size_t len);
+
+// Building blocks shared with heap snapshots, which lay out their string
+// records the same way: each ObjString is written pre-marked (permanently
+// black, so the collector never writes to a mapped page) at a
+// PROXC_STRING_ALIGN boundary, followed by a table of u32 offsets.
+#define PROXC_BYTE_ORDER_MARK 0x01020304u
+#define PROXC_STRING_ALIGN 16
+
+typedef struct {
+    uint8_t *data;
+    size_t count;
+    size_t capacity;
+    bool failed; // set on allocation failure; later writes are dropped
+} ImageWriter;
+
+void proxc_put(ImageWriter *w, const void *bytes, size_t len); // NULL bytes write zeros
+uint32_t proxc_align(ImageWriter *w, size_t alignment);        // returns the new offset
+// Writes 'count' string records and their offset table; returns the table's offset.
+uint32_t proxc_put_strings(ImageWriter *w, ObjString *const *strings, uint32_t count);
+
+bool proxc_in_bounds(size_t size, uint32_t offset, uint64_t length, size_t alignment);
+bool proxc_valid_strings(const uint8_t *image, size_t size, uint32_t table, uint32_t count);
+// Resolves every validated record to its canonical string in 'interned',
+// adopting the record itself when no equal string exists yet.
+void proxc_intern_strings(Table *interned, const uint8_t *image, uint32_t table, uint32_t count,
+                          ObjString **out);
+
+#endif // PROX_BYTECODE_IMAGE_H
@@ -0,0 +1,38 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#ifndef PROX_CHECKSUM_H
+#define PROX_CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fast non-cryptographic hashes for checksums and sharding.
+//
+// XXH64 is xxHash's 64-bit variant: four independent accumulators consume
+// 32 bytes per step, so it runs at memory speed without any SIMD. CRC32C
+// uses the Castagnoli polynomial, which SSE4.2 computes in hardware eight
+// bytes per instruction; without it a slicing-by-8 table is used.
+
+typedef struct {
+    uint64_t totalLength;
+    uint64_t v[4];
+    unsigned char buffer[32];
+    uint32_t bufferLength;
+    uint64_t seed;
+} XXH64_CTX;
+
+void xxh64_init(XXH64_CTX* ctx, uint64_t seed);
+void xxh64_update(XXH64_CTX* ctx, const void* data, size_t len);
+uint64_t xxh64_final(const XXH64_CTX* ctx);
+uint64_t xxh64(const void* data, size_t len, uint64_t seed);
+
+// Running CRC: start from 0 and feed the previous result back in to
+// continue a stream. The result is the finished checksum at every step.
+uint32_t crc32c_update(uint32_t crc, const void* data, size_t len);
+
+#endif
@@ -43,5 +43,6 @@ bool generateBytecode(StmtList* statements, ObjFunction* function);
 Value evaluateComptime(StmtList* statements);
 
 void markCompilerRoots();
+void markBytecodeGenRoots();
 
 #endif
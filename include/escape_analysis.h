@@ -4,20 +4,27 @@
 #include "ast.h"
 #include <stdbool.h>
 
-// Escape Analysis info for closures and functions
-typedef enum {
-    ESCAPE_NONE,      // Non-escaping: stack allocation eligible, zero GC pressure
-    ESCAPE_ARGUMENT,  // Passed as non-escaping argument to local function
-    ESCAPE_GLOBAL,    // Escapes to global variable
-    ESCAPE_RETURN,    // Escapes via return value
-    ESCAPE_HEAP       // Stored into heap object (instance, list, dictionary)
-} EscapeState;
+// Escape analysis for closures (EscapeState is declared in ast.h).
+//
+// Each function body is scanned once. A local function declaration that is
+// only called, printed, or passed as a call argument never outlives the
+// stack slot it was created in, so the bytecode generator creates it with
+// OP_STACK_CLOSURE instead of allocating it. Arguments are the one place
+// the callee is not known statically: every call that may pass a stack
+// closure is preceded by OP_GUARD_ARGS, which copies the closure to the
+// heap when the callee's retainedParams says it may keep that argument.
+// Closures that create closures of their own stay on the heap.
 
-// Analyzes an AST expression or function declaration to determine its escape state
+// Records escape states and retained parameters on every function
+// declaration and lambda in the program.
+void analyzeEscapes(StmtList* program);
+
+// States recorded by analyzeEscapes(); ESCAPE_HEAP before it has run.
 EscapeState analyzeClosureEscape(Stmt* funcDecl);
-EscapeState analyzeLambdaEscape(Expr* lambdaExpr, StmtList* enclosingBody);
+EscapeState analyzeLambdaEscape(Expr* lambdaExpr);
 
-// Returns true if the closure never escapes its lexical scope
+// Returns true if the closure can live in its creating stack slot
 bool isClosureStackEligible(Stmt* funcDecl);
+bool isLambdaStackEligible(Expr* lambdaExpr);
 
 #endif // PROX_ESCAPE_ANALYSIS_H
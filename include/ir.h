@@ -37,10 +37,14 @@ typedef enum {
     IR_OP_RETURN,
     IR_OP_LOAD_VAR,
     IR_OP_STORE_VAR,
-    IR_OP_GET_MEMBER,
-    IR_OP_SET_MEMBER,
+    IR_OP_GET_MEMBER, // object, name
+    IR_OP_SET_MEMBER, // object, name, value
     IR_OP_ALLOCA,
     IR_OP_AWAIT,
+    IR_OP_GET_INDEX, // target, index
+    IR_OP_SET_INDEX, // target, index, value
+    IR_OP_LENGTH,    // len(target)
+    IR_OP_NEW_LIST,  // elements...
 } IROpcode;
 
 typedef struct IRInstruction IRInstruction;
@@ -49,7 +53,8 @@ typedef struct IRBasicBlock IRBasicBlock;
 typedef enum {
     OPERAND_CONST,
     OPERAND_VAL, // SSA Value (Register index)
-    OPERAND_BLOCK // Target block for jumps
+    OPERAND_BLOCK, // Target block for jumps
+    OPERAND_FUNC // Directly called function in the same module
 } OperandType;
 
 typedef struct {
@@ -58,6 +63,7 @@ typedef struct {
         Value constant;
         int ssaVal;
         IRBasicBlock* block;
+        struct IRFunction* func;
     } as;
 } IROperand;
 
@@ -66,8 +72,10 @@ struct IRInstruction {
     int result; // Destination SSA register
     IRType type; // Concrete type resolved during inference
     bool escapes; // Set by Escape Analysis (false = stack allocatable)
+    bool checked; // GET/SET_INDEX: bounds test required (cleared by loop BCE)
     IROperand* operands;
     int operandCount;
+    int operandCapacity;
     IRInstruction* next;
     IRInstruction* prev;
 };
@@ -96,6 +104,9 @@ typedef struct IRFunction {
     int blockCapacity;
     
     int nextSsaVal; // For unique register generation
+    int paramCount; // Parameters are registers 0..paramCount-1
+    IRType* paramTypes; // Proven argument types of a specialized clone, else NULL
+    bool* paramEscapes; // Per parameter, set by runEscapeAnalysis(); NULL before
     bool isAsync;
 } IRFunction;
 
@@ -118,7 +129,6 @@ void addOperand(IRInstruction* instr, IROperand op);
 
 void computeCFGLinks(IRFunction* func);
 void dumpIR(IRModule* module);
-void freeIRModule(IRModule* module);
 
 #ifdef __cplusplus
 }
@@ -14,6 +14,20 @@ void promoteMemoryToRegisters(IRFunction* func);
 void constantFold(IRFunction* func);
 void deadCodeElimination(IRFunction* func);
 void runTypeInferencePass(IRFunction* func);
-void runEscapeAnalysisPass(IRFunction* func);
+
+// Copies small direct callees into their call sites.
+void inlineFunctions(IRModule* module);
+// Redirects all-numeric direct calls to type-specialized clones.
+void specializeCallSites(IRModule* module);
+// Hoists loop invariants, strength-reduces induction variables and drops
+// bounds checks that the loop condition already implies.
+void optimizeLoops(IRFunction* func);
+// Computes which values outlive their function (IRInstruction.escapes,
+// IRFunction.paramEscapes) and scalar-replaces list literals that do not.
+void runEscapeAnalysis(IRModule* module);
+// Runs the whole pipeline: mem2reg, folding, inlining, specialization,
+// type inference, loop optimizations, escape analysis and dead code
+// elimination.
+void optimizeIRModule(IRModule* module);
 
 #endif // PROX_IR_OPT_H
@@ -0,0 +1,42 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#ifndef PROX_ITERATOR_H
+#define PROX_ITERATOR_H
+
+#include <stdbool.h>
+
+#include "object.h"
+
+// The iterator protocol behind for-in loops and std.iter.
+//
+// A pipeline such as take(map(filter(range(0, 1e9), f), g), 10) is a chain
+// of ObjIterator stages. Nothing runs until the last stage is advanced;
+// each step then pulls exactly one item through every stage, so no stage
+// materializes a list and an unbounded source costs constant memory.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Iterator over 'value': 'value' itself if it already is one, otherwise a
+// new ITER_SEQUENCE over a list, tensor, typed array or string. NULL if
+// 'value' cannot be iterated. 'value' must be reachable while this
+// allocates.
+ObjIterator *iteratorOf(Value value);
+
+// Stores the next item in '*out'. Returns false once the iterator is
+// exhausted, after which it stays exhausted, or when a map or filter
+// callback fails; the error is then pending as after vmCallValue(). The
+// iterator must be reachable while this runs.
+bool iteratorNext(ObjIterator *iterator, Value *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROX_ITERATOR_H
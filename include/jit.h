@@ -0,0 +1,136 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Tier-up JIT for hot bytecode functions.
+ *
+ * The interpreter counts calls and loop back-edges per function and records
+ * which parameters have held non-numbers. When a function gets hot it is
+ * analyzed (stack depth and value types at every instruction) and, if it
+ * only uses the numeric subset of the instruction set, compiled to native
+ * code by the LLVM ORC backend, specialized on that feedback.
+ *
+ * Native code keeps the interpreter's frame layout: every guard that fails
+ * (a speculated type, a division by zero, an operator overload) writes the
+ * live stack slots back into the frame and returns the bytecode offset to
+ * resume at, so the interpreter carries on exactly where native code left
+ * off. Loop headers are also entry points, so a long loop running in the
+ * interpreter switches to native code on its next back-edge (OSR).
+ *
+ * PROXPL_NO_JIT=1 disables tier-up. Builds without LLVM keep interpreting.
+ */
+
+#ifndef PROX_JIT_H
+#define PROX_JIT_H
+
+#include "common.h"
+#include "value.h"
+#include "object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calls plus loop back-edges before a function is compiled.
+#define JIT_HOT_THRESHOLD 1000
+// Deopts one compilation may take before it is thrown away.
+#define JIT_MAX_DEOPTS 16
+// Compilations a function may go through before it stays interpreted.
+#define JIT_MAX_RECOMPILES 2
+
+// Parameters past this index are never speculated on.
+#define JIT_FEEDBACK_PARAMS 31
+// Set in paramFeedback once a call has been recorded.
+#define JIT_FEEDBACK_SEEN ((uint32_t)1 << 31)
+
+typedef enum {
+    JIT_COLD,
+    JIT_COMPILED,
+    JIT_FAILED
+} JitState;
+
+// Filled in by native code on every exit. On a deopt, 'ip' is the bytecode
+// offset to resume at and 'depth' the number of live frame slots (-1 when
+// the entry point was unknown and the frame is untouched).
+typedef struct {
+    Value result;
+    int32_t ip;
+    int32_t depth;
+} JitExit;
+
+// Returns 1 when the function returned (result in exit->result), 0 on deopt.
+typedef int (*JitEntry)(Value* slots, int32_t entryIp, JitExit* exit);
+
+typedef struct JitCode {
+    JitEntry entry;
+    int maxDepth;
+    void* handle;  // Backend resources, released with the function
+} JitCode;
+
+// --- Analysis shared with the backend ---
+
+typedef enum {
+    JIT_TYPE_ANY,
+    JIT_TYPE_NUMBER,
+    JIT_TYPE_BOOL,
+    JIT_TYPE_NIL
+} JitType;
+
+#define JIT_FLAG_LEADER 1   // Starts a basic block
+#define JIT_FLAG_OSR    2   // Loop header, enterable from the interpreter
+
+typedef struct {
+    ObjFunction* function;
+    int codeLength;
+    int maxDepth;
+    int16_t* depth;   // Stack depth before each instruction, -1 if none starts there
+    uint8_t* types;   // types[offset * maxDepth + slot], valid below depth[offset]
+    uint8_t* flags;
+} JitPlan;
+
+// Accepts functions whose reachable code uses only locals, constants,
+// arithmetic, comparisons, jumps and return, with a consistent stack depth
+// at every join point. Parameter types come from the recorded feedback.
+bool jitAnalyze(ObjFunction* function, JitPlan* plan);
+void jitFreePlan(JitPlan* plan);
+
+// Backend (src/compiler/jit_llvm.cpp). Returns NULL when the function cannot
+// be compiled or the build has no LLVM.
+JitCode* jitEmitNative(const JitPlan* plan);
+void jitReleaseNative(JitCode* code);
+
+// Mirrors OP_EQUAL for operands that may be objects. Returns -1 when the
+// interpreter must handle it (an instance defining operator==).
+int jitValuesEqual(Value a, Value b);
+
+// --- Tiering ---
+
+static inline void jitRecordCall(ObjFunction* function, Value* args, int argCount) {
+    uint32_t feedback = function->paramFeedback | JIT_FEEDBACK_SEEN;
+    int count = argCount < JIT_FEEDBACK_PARAMS ? argCount : JIT_FEEDBACK_PARAMS;
+    for (int i = 0; i < count; i++) {
+        if (!IS_NUMBER(args[i])) feedback |= (uint32_t)1 << i;
+    }
+    function->paramFeedback = feedback;
+    function->hotness++;
+}
+
+// Compiles 'function', leaving it JIT_COMPILED or JIT_FAILED.
+void jitCompile(ObjFunction* function);
+
+// Runs native code for the frame from 'entryIp' (0 or a loop header).
+// Returns true if the function returned; otherwise the frame slots hold the
+// state to resume interpreting from, as described by 'exit'.
+bool jitEnter(VM* vm, CallFrame* frame, int entryIp, JitExit* exit);
+
+// Drops compiled code (on invalidation or when the function is freed).
+void jitRelease(ObjFunction* function);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROX_JIT_H
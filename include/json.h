@@ -0,0 +1,55 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#ifndef PROX_JSON_H
+#define PROX_JSON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "value.h"
+
+// JSON engine behind std.native.json and std.native.encoding.
+//
+// Parsing runs in two stages. The first classifies the input 64 bytes at a
+// time (AVX2 when the build enables it) into bit masks and records the
+// offset of every structural character, string quote and scalar start. The
+// second walks that index, so it never scans whitespace or string contents
+// byte by byte, and builds lists and dictionaries directly. Objects become
+// dictionaries, arrays lists, and null nil.
+
+// Objects and arrays may nest this deep, both ways.
+#define JSON_MAX_DEPTH 1024
+
+typedef struct {
+    const char* message; // NULL when there was no error
+    size_t offset;       // Byte offset in the input where it was found
+} JsonError;
+
+// One step of a jsonGet() path: an object key, or an array index written
+// in decimal.
+typedef struct {
+    const char* chars;
+    size_t length;
+} JsonPathSegment;
+
+// Parses one JSON document. On malformed input returns false and fills
+// 'error'.
+bool jsonParse(const char* text, size_t length, Value* out, JsonError* error);
+
+// Parses only the value at 'path', skipping everything around it unbuilt.
+// A path that does not exist yields nil. Only the structure up to the value
+// and the value itself are validated.
+bool jsonGet(const char* text, size_t length, const JsonPathSegment* path, int pathLength,
+             Value* out, JsonError* error);
+
+// Serializes 'value' compactly. Dictionaries and instance fields become
+// objects; NaN, infinities and values with no JSON form become null.
+// Returns NULL, filling 'error', when the value nests too deeply (cycles).
+ObjString* jsonStringify(Value value, JsonError* error);
+
+#endif // PROX_JSON_H
@@ -0,0 +1,113 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Module Graph
+ * ------------
+ * Discovers the source modules a program reaches through `use`, runs the
+ * front-end (scan, parse, optimize, type check) of independent modules in
+ * parallel on a small thread pool, and links them into the VM in
+ * dependency order.
+ *
+ * `use lib.math;` resolves to lib/math.prox, searched in the entry file's
+ * directory and then in the importer's search paths. Names without such a
+ * file are left to the importer (native modules). Linking compiles each
+ * module to bytecode on the calling thread, runs its top level once, and
+ * registers an ObjModule whose exports are the globals it defined.
+ *
+ * Builds are incremental. <cache dir>/modules.idx records, per module
+ * file, the SHA-256 of its source, a fingerprint of its exported interface
+ * (top-level names, function arities, class methods) and the names it
+ * uses. A module whose source is unchanged skips its front-end entirely.
+ * Its bytecode image is cached under a key covering its own source and
+ * the interface fingerprints of its dependencies, so editing a function
+ * body leaves dependents alone while renaming or re-declaring an export
+ * recompiles them.
+ */
+
+#ifndef PROX_MODULE_GRAPH_H
+#define PROX_MODULE_GRAPH_H
+
+#include "common.h"
+#include "ast.h"
+#include "vm.h"
+#include "arena.h"
+#include "threading.h"
+#include "bytecode_image.h"
+#include "scanner.h"
+
+typedef struct ModuleUnit {
+    char* name;            // Dotted name as written in `use`
+    char* path;            // Resolved source file
+    char* source;
+    Arena arena;           // AST and types, released once the module is linked
+    StmtList* statements;
+
+    int* deps;             // Indices of the source modules this one uses
+    int depCount;
+    int depCapacity;
+
+    char* uses;            // Comma-separated names from `use`, as recorded
+    uint8_t sourceHash[PROXC_KEY_SIZE];
+    uint8_t interfaceHash[PROXC_KEY_SIZE];
+    uint8_t imageKey[PROXC_KEY_SIZE];
+    ObjFunction* image;    // Cached bytecode, when the front-end was skipped
+
+    bool holdsArena;       // Arena detached and still live
+    bool fresh;            // Source matches the index
+    bool compiled;         // Front-end ran in this build
+    bool hadErrors;        // Recovered parse errors; never cached
+    bool failed;
+    bool linked;
+} ModuleUnit;
+
+typedef struct ModuleRecord ModuleRecord;
+
+typedef struct {
+    ModuleUnit** units;
+    int count;
+    int capacity;
+
+    int* roots;            // Source modules used by the entry file
+    int rootCount;
+    int rootCapacity;
+
+    char** searchDirs;
+    int dirCount;
+
+    ModuleRecord* records; // The index as of the previous build
+    int recordCount;
+
+    // Work queue: units[nextUnit..count) are waiting for a worker
+    PxMutex lock;
+    PxCond changed;
+    int nextUnit;
+    int finished;
+} ModuleGraph;
+
+// entryPath locates the entry file; its directory is searched first.
+void initModuleGraph(ModuleGraph* graph, const char* entryPath);
+void freeModuleGraph(ModuleGraph* graph);
+
+// Finds and compiles the front-end of every source module reachable from
+// the entry file's `use` declarations. Returns false if any module failed
+// to load, parse or type check.
+bool buildModuleGraph(ModuleGraph* graph, StmtList* entry);
+
+// Generates bytecode for each module, dependencies first, and runs it.
+InterpretResult linkModuleGraph(ModuleGraph* graph, VM* vm);
+
+// Generates and caches bytecode for every module without running any of
+// them, for ahead-of-time builds. Returns false if code generation failed.
+bool compileModuleGraph(ModuleGraph* graph, VM* vm);
+
+// Whether the entry file may go through the compile cache, decided from its
+// tokens before any lookup: the cache key covers the entry source only, so
+// every `use` must name a module the VM already has registered (a native
+// module), and UI apps, which emit files while compiling, never qualify.
+bool entryCacheable(VM* vm, const Token* tokens, int count);
+
+#endif // PROX_MODULE_GRAPH_H
@@ -7,6 +7,8 @@
 #ifndef PROX_OBJECT_H
 #define PROX_OBJECT_H
 
+#include <math.h>
+
 #include "common.h"
 #include "value.h"
 #include "bytecode.h" 
@@ -78,6 +80,15 @@
 #define IS_CHANNEL(value) isObjType(value, OBJ_CHANNEL)
 #define AS_CHANNEL(value) ((ObjChannel *)AS_OBJ(value))
 
+#define IS_BUFFER(value) isObjType(value, OBJ_BUFFER)
+#define AS_BUFFER(value) ((ObjBuffer *)AS_OBJ(value))
+
+#define IS_ITERATOR(value) isObjType(value, OBJ_ITERATOR)
+#define AS_ITERATOR(value) ((ObjIterator *)AS_OBJ(value))
+
+#define IS_TYPED_ARRAY(value) isObjType(value, OBJ_TYPED_ARRAY)
+#define AS_TYPED_ARRAY(value) ((ObjTypedArray *)AS_OBJ(value))
+
 typedef enum {
   OBJ_STRING,
   OBJ_FUNCTION,
@@ -101,7 +112,10 @@ typedef enum {
   OBJ_RESOLVER,
   
   OBJ_ACTOR,
-  OBJ_CHANNEL
+  OBJ_CHANNEL,
+  OBJ_BUFFER,
+  OBJ_ITERATOR,
+  OBJ_TYPED_ARRAY
 } ObjType;
 
 struct Obj {
@@ -121,6 +135,7 @@ struct ObjFunction {
   Obj obj;
   int arity;
   int upvalueCount;
+  int captureCount; // Variables copied into the closure by value
   Chunk chunk;
   ObjString *name;
   AccessLevel access;
@@ -128,6 +143,18 @@ struct ObjFunction {
   bool isAbstract;
   struct ObjClass *ownerClass;
   void* cache;
+  // Bit i: the function may keep parameter i past the call (bit 31 covers
+  // the rest). Stack closures passed for other parameters stay on the stack.
+  uint32_t retainedParams;
+  // The one closure of a function that captures nothing, made on first use
+  struct ObjClosure *sharedClosure;
+  // Tier-up state (see jit.h)
+  uint32_t hotness;
+  uint32_t paramFeedback;
+  uint8_t jitState;
+  uint8_t jitDeopts;
+  uint8_t jitRecompiles;
+  struct JitCode* jitCode;
 };
 
 
@@ -148,7 +175,6 @@ typedef struct ObjUpvalue {
   Obj obj;
   Value *location;
   Value closed;
-  struct ObjUpvalue *next;
 } ObjUpvalue;
 
 typedef struct ObjClosure {
@@ -156,6 +182,10 @@ typedef struct ObjClosure {
   ObjFunction *function;
   ObjUpvalue **upvalues;
   int upvalueCount;
+  Value *captures; // Values of variables that are never reassigned
+  int captureCount;
+  bool onStack;                // Made by OP_STACK_CLOSURE; not in vm.objects
+  struct ObjClosure *promoted; // Heap copy of a stack closure, once made
 } ObjClosure;
 
 // Interfaces are essentially named method tables?
@@ -203,6 +233,9 @@ typedef struct ObjForeign {
   ObjString* name;
   void* library; // dlopen/LoadLibrary handle
   void* function; // dlsym/GetProcAddress pointer
+  // Releases native state held in library when the GC frees the object.
+  // Skipped once library has been cleared by an explicit close.
+  void (*finalize)(struct ObjForeign*);
 } ObjForeign;
 
 typedef struct ObjTask ObjTask;
@@ -292,12 +325,116 @@ typedef struct ObjChannel {
   struct ObjTask *waitingSenders;
 } ObjChannel;
 
+typedef struct ObjBuffer ObjBuffer;
+
+// Byte buffer behind std.native.buffer. A slice shares its owner's storage:
+// it keeps 'owner' alive and addresses owner->data + offset, so growing the
+// owner never leaves a slice dangling. Views of mapped files are read-only
+// and hand their storage back through 'release' instead of freeing it.
+struct ObjBuffer {
+  Obj obj;
+  struct ObjBuffer *owner; // NULL when this buffer owns 'data'
+  uint8_t *data;
+  int offset;              // Start of a slice within the owner's storage
+  int size;
+  int capacity;
+  bool readOnly;
+  void (*release)(struct ObjBuffer *buffer);
+  void *mapping;           // Platform handle for mapped views
+};
+
+static inline uint8_t *bufferBytes(ObjBuffer *buffer) {
+  return buffer->owner ? buffer->owner->data + buffer->offset : buffer->data;
+}
+
+// A slice whose window no longer fits its owner (an unmapped view) is empty
+static inline int bufferLength(ObjBuffer *buffer) {
+  if (buffer->owner == NULL) return buffer->size;
+  return buffer->offset + buffer->size <= buffer->owner->capacity ? buffer->size : 0;
+}
+
+typedef enum {
+  ITER_RANGE,     // Numbers from 'start' towards 'stop' by 'step'
+  ITER_SEQUENCE,  // Items of a list, tensor or typed array, or characters of a string
+  ITER_MAP,       // fn(item) for each item of 'source'
+  ITER_FILTER,    // Items of 'source' for which fn(item) is truthy
+  ITER_TAKE,      // The first 'limit' items of 'source'
+  ITER_SKIP,      // 'source' after its first 'limit' items
+  ITER_ZIP,       // [a, b] pairs from 'source' and 'other' until either ends
+  ITER_CHAIN,     // 'source', then 'other'
+  ITER_ENUMERATE  // [index, item] for each item of 'source'
+} IteratorKind;
+
+typedef struct ObjIterator ObjIterator;
+
+// A lazy stage of an iterator pipeline. Each stage pulls one item at a
+// time from the stage in 'source', so a chain of them runs in constant
+// memory however long the input. Stages are only ever advanced through
+// iteratorNext() (see iterator.h).
+struct ObjIterator {
+  Obj obj;
+  IteratorKind kind;
+  bool done;
+  Value source;   // Upstream iterator, or the sequence of ITER_SEQUENCE
+  Value other;    // Second iterator of ITER_ZIP and ITER_CHAIN
+  Value fn;       // Callback of ITER_MAP and ITER_FILTER
+  double start;   // ITER_RANGE bounds
+  double stop;
+  double step;
+  int64_t position; // Items produced (ranges, sequences) or consumed (take, skip)
+  int64_t limit;    // Count of ITER_TAKE and ITER_SKIP
+};
+
+typedef enum {
+  TYPED_FLOAT64,
+  TYPED_INT32
+} TypedArrayKind;
+
+typedef struct ObjTypedArray ObjTypedArray;
+
+// Fixed-length array of unboxed numbers behind std.native.typed. Elements
+// sit contiguously as doubles or int32s, so indexing skips the Value
+// checks of a list and the numeric natives run over the raw storage.
+struct ObjTypedArray {
+  Obj obj;
+  TypedArrayKind kind;
+  int count;
+  union {
+    double *f64;
+    int32_t *i32;
+  } as;
+};
+
+// Number stored into an Int32Array: truncated, then wrapped modulo 2^32;
+// NaN and infinities become 0
+static inline int32_t toInt32(double number) {
+  if (number >= -2147483648.0 && number < 2147483648.0) return (int32_t)number;
+  if (number != number || number - number != 0) return 0;
+  double wrapped = fmod(trunc(number), 4294967296.0);
+  if (wrapped < 0) wrapped += 4294967296.0;
+  return (int32_t)(uint32_t)wrapped;
+}
+
+static inline double typedArrayGet(ObjTypedArray *array, int index) {
+  return array->kind == TYPED_FLOAT64 ? array->as.f64[index] : (double)array->as.i32[index];
+}
+
+static inline void typedArraySet(ObjTypedArray *array, int index, double number) {
+  if (array->kind == TYPED_FLOAT64) {
+    array->as.f64[index] = number;
+  } else {
+    array->as.i32[index] = toInt32(number);
+  }
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 ObjString *takeString(char *chars, int length);
 ObjString *copyString(const char *chars, int length);
+ObjString *allocateRawString(int length);
+ObjString *internRawString(ObjString *string);
 ObjFunction *newFunction();
 ObjNative *newNative(NativeFn function);
 
@@ -317,6 +454,11 @@ struct ObjDictionary *newDictionary();
 ObjForeign *newForeign(ObjString* name, void* library, void* function);
 struct ObjTask *newTask(void* hdl, ResumeFn resume);
 ObjTensor *newTensor(int dimCount, int *dims, double *data);
+ObjBuffer *newBuffer(int capacity);
+ObjBuffer *newBufferSlice(ObjBuffer *buffer, int offset, int size);
+bool bufferReserve(ObjBuffer *buffer, int capacity);
+ObjIterator *newIterator(IteratorKind kind, Value source);
+ObjTypedArray *newTypedArray(TypedArrayKind kind, int count);
 ObjContext *newContext(ObjString *name);
 ObjLayer *newLayer(ObjString *name);
 ObjIntent *newIntent(ObjString *name, int paramCount);
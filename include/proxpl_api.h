@@ -22,4 +22,8 @@ InterpretResult proxpl_interpret_file(VM *vm, const char *path);
 int proxpl_write_chunk_to_file(const char *path, const Chunk *chunk);
 int proxpl_read_chunk_from_file(const char *path, Chunk *out);
 
+/* Compiled function images (.proxc), see bytecode_image.h */
+int proxpl_write_image(const char *path, ObjFunction *function);
+InterpretResult proxpl_interpret_image(VM *vm, const char *path);
+
 #endif /* PROXPL_API_H */
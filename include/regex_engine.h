@@ -0,0 +1,55 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#ifndef PROX_REGEX_ENGINE_H
+#define PROX_REGEX_ENGINE_H
+
+#include <stdbool.h>
+
+// Regular expression engine behind std.native.regex.
+//
+// A pattern is parsed and compiled once into an NFA program. Yes/no
+// questions run on a DFA that is built lazily from that program, one state
+// per distinct set of NFA positions, and cached, so matching is linear in
+// the input. Capture groups come from a Pike VM, which also runs in linear
+// time; it only starts once the DFA has confirmed that a match exists.
+// Patterns that begin with a literal, or with one of a few bytes, skip
+// ahead with a vectorised scan.
+//
+// Supported syntax: literals and escapes (\n \t \xHH ...), '.', classes
+// [a-z] [^...] with \d \w \s and their negations, anchors ^ $ \b \B,
+// groups (...) and (?:...), alternation, and the quantifiers * + ? {n}
+// {n,} {n,m} with lazy '?' forms. Matching is byte-wise; the 'i' flag folds
+// ASCII letters only. Back-references and lookaround are rejected.
+//
+// A compiled Regex carries its DFA cache and match scratch space, so one
+// must not be used from two threads at once.
+
+#define REGEX_ICASE     0x01 // 'i': ASCII case-insensitive
+#define REGEX_MULTILINE 0x02 // 'm': ^ and $ also match at line breaks
+#define REGEX_DOTALL    0x04 // 's': '.' also matches '\n'
+
+typedef struct Regex Regex;
+
+// Compiles 'pattern'. On a syntax error returns NULL and points 'error' at
+// a static message.
+Regex* regexCompile(const char* pattern, int length, int flags, const char** error);
+void regexFree(Regex* regex);
+
+// Number of capture groups, not counting the whole match.
+int regexGroupCount(const Regex* regex);
+
+// Whether the pattern matches anywhere in text[from..length).
+bool regexTest(Regex* regex, const char* text, int length, int from);
+
+// Finds the leftmost match starting at or after 'from' with the same
+// preference order as backtracking engines. 'captures' receives
+// 2 * (groupCount + 1) offsets: start and end of the whole match, then of
+// each group, with -1 for groups that did not take part.
+bool regexSearch(Regex* regex, const char* text, int length, int from, int* captures);
+
+#endif // PROX_REGEX_ENGINE_H
@@ -214,4 +214,8 @@ typedef struct {
 void initScanner(Scanner *scanner, const char *source);
 Token scanToken(Scanner *scanner);
 
+// Scans all of 'source' into a malloc'd array ending with the EOF token, or
+// with the first ERROR token. The caller frees it.
+Token *scanAllTokens(const char *source, int *count);
+
 #endif
@@ -0,0 +1,47 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#ifndef PROX_SCHEDULER_H
+#define PROX_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "common.h"
+
+/*
+ * Data-parallel loops on the work-stealing scheduler.
+ *
+ * scheduler_parallel_for splits [0, count) into chunks of 'grain' items and
+ * runs body once per chunk across a pool of helper threads (started on
+ * first use, PROXPL_THREADS threads or one per CPU) plus the caller. Chunk
+ * ranges are split in halves through each worker's Chase-Lev deque and idle
+ * workers steal from the others. Returns when every chunk has run.
+ *
+ * Bodies run off the VM thread: they must not allocate, touch the GC heap
+ * or call into the VM. A body that starts another parallel loop runs it on
+ * its own thread.
+ */
+
+typedef void (*ParallelBody)(size_t begin, size_t end, void* context);
+
+void scheduler_parallel_for(size_t count, size_t grain, ParallelBody body, void* context);
+
+// Chunk size for count items: at least minGrain, and otherwise a fixed
+// chunk count, so chunk boundaries (and therefore chunked reductions) do
+// not depend on the machine
+size_t scheduler_grain(size_t count, size_t minGrain);
+
+// Threads a parallel loop runs on, including the caller
+int scheduler_parallelism(void);
+
+// Natives that only compute on number arguments, without allocating or
+// touching the VM, may be called from parallel loops
+void scheduler_mark_parallel_safe(NativeFn function);
+bool scheduler_parallel_safe(NativeFn function);
+
+#endif
@@ -17,4 +17,9 @@ void sha256_init(SHA256_CTX *ctx);
 void sha256_update(SHA256_CTX *ctx, const unsigned char data[], size_t len);
 void sha256_final(SHA256_CTX *ctx, unsigned char hash[]);
 
+// Hashes count independent messages. With AVX2 eight messages are
+// compressed side by side; otherwise each is hashed in turn.
+void sha256_many(const unsigned char *const data[], const size_t lens[], int count,
+                 unsigned char hashes[][SHA256_BLOCK_SIZE]);
+
 #endif
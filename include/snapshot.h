@@ -0,0 +1,59 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Heap snapshots: the heap built by registerStdLib (globals, module tables,
+ * natives and interned strings) written to an mmap'able image and restored
+ * by relocation instead of being rebuilt on every launch.
+ *
+ * Natives are stored as indices into the stdlib native table (the lists
+ * registerStdLib defines from), never as code addresses. The header records
+ * the table's size and a hash of its names, and a snapshot is rejected when
+ * either differs or an index is out of range. The default path also embeds
+ * a fingerprint of the executable, which the header repeats; any mismatch is
+ * treated as "no snapshot".
+ *
+ * Only heap objects are captured. An ObjNative comes back as a bare function
+ * pointer, so state a stdlib module keeps outside the heap (registries,
+ * caches, counters) is not restored with it; initStdLibState re-creates that
+ * state and runs both from registerStdLib and after every restore.
+ */
+
+#ifndef PROX_SNAPSHOT_H
+#define PROX_SNAPSHOT_H
+
+#include "common.h"
+#include "vm.h"
+
+#define PROX_SNAPSHOT_VERSION 2
+
+// Returns the malloc'd default snapshot path for this executable in the
+// per-user cache directory (PROXPL_CACHE_DIR, else $XDG_CACHE_HOME/proxpl or
+// ~/.cache/proxpl), never the working directory. NULL when snapshots are
+// unsupported on this platform, the cache is disabled or there is no home.
+char* heapSnapshotPath(void);
+
+// Writes everything reachable from the globals and module tables, creating
+// the directories above 'path' as needed. Fails (writing nothing) if the
+// heap holds objects a snapshot cannot represent.
+bool saveHeapSnapshot(VM* vm, const char* path);
+
+// Restores a snapshot into a freshly initialized VM. Returns false, leaving
+// the VM untouched, when the file is missing, stale or malformed.
+bool loadHeapSnapshot(VM* vm, const char* path);
+
+// The stdlib native table: every native registerStdLib can define, in a
+// fixed order, and a hash of their names standing for the table's ABI.
+uint32_t stdlibNativeCount(void);
+uint64_t stdlibNativeAbi(void);
+NativeFn stdlibNative(uint32_t index); // NULL when out of range
+bool stdlibNativeIndex(NativeFn function, uint32_t* index);
+
+// Re-initializes stdlib state that lives outside the heap (defined with the
+// stdlib registry). Must be idempotent.
+void initStdLibState(VM* vm);
+
+#endif // PROX_SNAPSHOT_H
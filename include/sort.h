@@ -0,0 +1,59 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#ifndef PROX_SORT_H
+#define PROX_SORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "value.h"
+
+// Sorting behind std.collections.sort and sort_by.
+//
+// Numbers are sorted by an LSD radix sort on an order-preserving 64-bit
+// image of each double, which is stable, linear and never compares. Other
+// orders go through a comparison function: sortPdq is pattern-defeating
+// quicksort (unstable, O(n log n) worst case through a heapsort fallback,
+// linear on sorted input) and sortTim merges natural runs for a stable
+// order. Both stay within bounds even if the comparison is inconsistent,
+// since it may be a user callback.
+
+typedef struct {
+    uint64_t key;   // Order-preserving prefix (strings) or radix key
+    Value value;    // The item, or its sort key
+    uint32_t index; // Original position, for tie-breaks and undecorating
+} SortItem;
+
+// Returns true if a must come before b
+typedef bool (*SortLess)(const SortItem* a, const SortItem* b, void* context);
+
+// Key whose unsigned order matches the numeric order of the double
+uint64_t sortNumberKey(double number);
+double sortNumberFromKey(uint64_t key);
+// First eight bytes of a string, big-endian and zero padded
+uint64_t sortStringPrefix(const char* chars, int length);
+
+// Sorts keys ascending, moving indices (when not NULL) along with them.
+// The scratch arrays must hold count entries each.
+void sortRadix(uint64_t* keys, uint32_t* indices, uint64_t* keyScratch,
+               uint32_t* indexScratch, size_t count);
+
+void sortPdq(SortItem* items, size_t count, SortLess less, void* context);
+// Stable; scratch must hold count / 2 + 1 items
+void sortTim(SortItem* items, SortItem* scratch, size_t count, SortLess less, void* context);
+
+// Multi-threaded versions on the scheduler's parallel loops, with the same
+// results as the ones above. sortRadixParallel sorts keys only; sortParallel
+// sorts chunks with pdqsort and merges them pairwise (stable between
+// chunks), so less must be safe to call from several threads and scratch
+// must hold count items.
+void sortRadixParallel(uint64_t* keys, uint64_t* keyScratch, size_t count);
+void sortParallel(SortItem* items, SortItem* scratch, size_t count, SortLess less, void* context);
+
+#endif
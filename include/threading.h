@@ -0,0 +1,96 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Threading Primitives
+ * --------------------
+ * Minimal mutex, condition variable and thread wrappers over pthreads and
+ * Win32, used by the parallel compilation pipeline and parallel loops.
+ */
+
+#ifndef PROX_THREADING_H
+#define PROX_THREADING_H
+
+#include <stdbool.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+
+typedef SRWLOCK PxMutex;
+typedef CONDITION_VARIABLE PxCond;
+typedef HANDLE PxThread;
+
+#define PX_MUTEX_INITIALIZER SRWLOCK_INIT
+#define PX_THREAD_LOCAL __declspec(thread)
+#define PX_THREAD_FN(name) unsigned __stdcall name(void* arg)
+#define PX_THREAD_RETURN 0
+
+static inline void pxMutexInit(PxMutex* mutex) { InitializeSRWLock(mutex); }
+static inline void pxMutexDestroy(PxMutex* mutex) { (void)mutex; }
+static inline void pxMutexLock(PxMutex* mutex) { AcquireSRWLockExclusive(mutex); }
+static inline void pxMutexUnlock(PxMutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+
+static inline void pxCondInit(PxCond* cond) { InitializeConditionVariable(cond); }
+static inline void pxCondDestroy(PxCond* cond) { (void)cond; }
+static inline void pxCondWait(PxCond* cond, PxMutex* mutex) {
+    SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+}
+static inline void pxCondBroadcast(PxCond* cond) { WakeAllConditionVariable(cond); }
+
+static inline bool pxThreadStart(PxThread* thread, unsigned (__stdcall *fn)(void*), void* arg) {
+    *thread = (HANDLE)_beginthreadex(NULL, 0, fn, arg, 0, NULL);
+    return *thread != 0;
+}
+static inline void pxThreadJoin(PxThread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+static inline void pxThreadYield(void) { SwitchToThread(); }
+
+static inline int pxCpuCount(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t PxMutex;
+typedef pthread_cond_t PxCond;
+typedef pthread_t PxThread;
+
+#define PX_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define PX_THREAD_LOCAL __thread
+#define PX_THREAD_FN(name) void* name(void* arg)
+#define PX_THREAD_RETURN NULL
+
+static inline void pxMutexInit(PxMutex* mutex) { pthread_mutex_init(mutex, NULL); }
+static inline void pxMutexDestroy(PxMutex* mutex) { pthread_mutex_destroy(mutex); }
+static inline void pxMutexLock(PxMutex* mutex) { pthread_mutex_lock(mutex); }
+static inline void pxMutexUnlock(PxMutex* mutex) { pthread_mutex_unlock(mutex); }
+
+static inline void pxCondInit(PxCond* cond) { pthread_cond_init(cond, NULL); }
+static inline void pxCondDestroy(PxCond* cond) { pthread_cond_destroy(cond); }
+static inline void pxCondWait(PxCond* cond, PxMutex* mutex) { pthread_cond_wait(cond, mutex); }
+static inline void pxCondBroadcast(PxCond* cond) { pthread_cond_broadcast(cond); }
+
+static inline bool pxThreadStart(PxThread* thread, void* (*fn)(void*), void* arg) {
+    return pthread_create(thread, NULL, fn, arg) == 0;
+}
+static inline void pxThreadJoin(PxThread thread) { pthread_join(thread, NULL); }
+static inline void pxThreadYield(void) { sched_yield(); }
+
+static inline int pxCpuCount(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+#endif
+
+#endif // PROX_THREADING_H
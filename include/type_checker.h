@@ -33,6 +33,7 @@ typedef struct Scope {
 typedef struct {
     int errorCount;
     Scope* currentScope;
+    Scope* freeScopes; // Closed scopes, reused by the next beginScope()
 } TypeChecker;
 
 // --- API ---
@@ -35,7 +35,14 @@ struct VM {
   Table globals;
   Table strings;
   Obj* objects;
-  struct ObjUpvalue* openUpvalues;
+  // Open upvalue of each stack slot, so capturing a slot is a single
+  // lookup; every entry at or above openUpvalueTop is NULL
+  struct ObjUpvalue* openUpvalues[STACK_MAX];
+  int openUpvalueTop;
+  // Storage behind OP_STACK_CLOSURE, one block per stack slot, allocated on
+  // first use; blocks below stackClosureLimit may exist
+  struct StackClosure** stackClosures;
+  int stackClosureLimit;
   
   // GC State
   int grayCount;
@@ -61,6 +68,16 @@ struct VM {
   
   // Exception handling
   jmp_buf exceptionJump;
+
+  // Re-entrant calls from native code (vmCallValue). run() returns once the
+  // frame count drops back to frameBase; frames below it belong to callers
+  // suspended inside a native. An error no handler at or above frameBase
+  // catches is held in nativeError and raised again where the native was
+  // called, so handlers further out still see it.
+  int frameBase;
+  int nativeCallDepth;
+  bool nativeErrorPending;
+  char nativeError[1024];
 };
 
 typedef enum {
@@ -77,18 +94,45 @@ void trackSource(VM* vm, char* source);
 InterpretResult interpret(VM* vm, const char* source);
 InterpretResult interpretChunk(VM* vm, Chunk* chunk);
 InterpretResult interpretAST(VM* vm, StmtList* statements);
+ObjFunction* compileAST(VM* vm, StmtList* statements);
+InterpretResult interpretFunction(VM* vm, ObjFunction* function);
 void push(VM* vm, Value value);
 Value pop(VM* vm);
 Value peek(VM* vm, int distance);
 bool isFalsey(Value value);
 void defineNative(VM* vm, const char* name, NativeFn function);
+// A named native in one of the stdlib's registration lists. Each list
+// ends with {NULL, NULL}.
+typedef struct {
+  const char* name;
+  NativeFn function;
+} NativeDef;
+void defineNatives(VM* vm, const NativeDef* natives);
+void defineModuleNatives(VM* vm, struct ObjModule* module, const NativeDef* natives);
 bool bindMethod(struct ObjClass *klass, struct ObjString *name, VM *vm);
 void defineMethod(struct ObjString *name, VM *vm);
 void closeUpvalues(VM *vm, Value *last);
 struct ObjUpvalue *captureUpvalue(Value *local, VM *vm);
+// Stack closures (OP_STACK_CLOSURE) live in a block owned by the stack slot
+// they are created in, and are reused once that slot is popped.
+struct ObjClosure *newStackClosure(VM *vm, ObjFunction *function, Value *slot);
+void stackUpvalue(struct ObjClosure *closure, int index, Value *location);
+// Heap copy of a stack closure that must outlive its slot; the same copy is
+// returned every time.
+struct ObjClosure *promoteClosure(VM *vm, struct ObjClosure *closure);
+// OP_GUARD_ARGS: promotes stack closures among the top 'argCount' values
+// that the callee below them may retain.
+void guardStackArgs(VM *vm, int argCount);
+void unmarkStackClosures(VM *vm);
+void freeStackClosures(VM *vm);
 bool invokeFromClass(struct ObjClass *klass, struct ObjString *name, int argCount, VM *vm);
 bool invoke(struct ObjString *name, int argCount, VM *vm);
 bool callValue(Value callee, int argCount, VM *vm);
+// Calls callee with args from native code and runs it to completion. On
+// failure the error is pending and the native should return at once; the
+// VM reports it (or hands it to a handler) when the native returns.
+bool vmCallValue(VM *vm, Value callee, int argCount, Value *args, Value *result);
+void raiseNativeError(VM *vm);
 void runtimeError(VM* vm, const char* format, ...);
 
 #endif // PROX_VM_H
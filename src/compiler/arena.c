@@ -0,0 +1,228 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+#include "../../include/arena.h"
+#include "../../include/gc.h"
+#include "../../include/object.h"
+#include "../../include/threading.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 16
+
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t used;
+    size_t capacity;
+    size_t lastOffset; // Start of the newest allocation, for arenaGrow()
+};
+
+#define BLOCK_HEADER (((sizeof(ArenaBlock) + ARENA_ALIGN - 1) / ARENA_ALIGN) * ARENA_ALIGN)
+#define BLOCK_DATA(block) ((char*)(block) + BLOCK_HEADER)
+
+static PX_THREAD_LOCAL Arena* activeArena = NULL;
+static Arena defaultArena;
+static bool defaultArenaReady = false;
+
+// Every begun arena until it is freed; guarded by liveLock since workers
+// begin and end compilations concurrently.
+static Arena* liveArenas = NULL;
+static PxMutex liveLock = PX_MUTEX_INITIALIZER;
+
+static bool compilerThreaded = false;
+static PxMutex compilerMutex = PX_MUTEX_INITIALIZER;
+
+void initArena(Arena* arena) {
+    arena->blocks = NULL;
+    arena->bytesUsed = 0;
+    arena->roots = NULL;
+    arena->rootCount = 0;
+    arena->rootCapacity = 0;
+    arena->enclosing = NULL;
+    arena->nextLive = NULL;
+}
+
+void freeArena(Arena* arena) {
+    ArenaBlock* block = arena->blocks;
+    while (block != NULL) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena->roots);
+    initArena(arena);
+}
+
+void* arenaAlloc(Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    ArenaBlock* block = arena->blocks;
+
+    if (block == NULL || block->used + size > block->capacity) {
+        size_t capacity = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        block = (ArenaBlock*)calloc(1, BLOCK_HEADER + capacity);
+        if (block == NULL) {
+            fprintf(stderr, "Fatal: Out of memory in compiler arena.\n");
+            exit(1);
+        }
+        block->capacity = capacity;
+        // An oversized block is kept behind the head so the head's free
+        // space is not abandoned.
+        if (arena->blocks != NULL && size > ARENA_BLOCK_SIZE) {
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+        } else {
+            block->next = arena->blocks;
+            arena->blocks = block;
+        }
+    }
+
+    block->lastOffset = block->used;
+    block->used += size;
+    arena->bytesUsed += size;
+    return BLOCK_DATA(block) + block->lastOffset;
+}
+
+void* arenaGrow(Arena* arena, void* pointer, size_t oldSize, size_t newSize) {
+    if (pointer == NULL) return arenaAlloc(arena, newSize);
+    if (newSize <= oldSize) return pointer;
+
+    ArenaBlock* block = arena->blocks;
+    if (block != NULL && (char*)pointer == BLOCK_DATA(block) + block->lastOffset) {
+        size_t size = (newSize + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+        if (block->lastOffset + size <= block->capacity) {
+            arena->bytesUsed += size - (block->used - block->lastOffset);
+            block->used = block->lastOffset + size;
+            return pointer;
+        }
+    }
+
+    void* result = arenaAlloc(arena, newSize);
+    memcpy(result, pointer, oldSize);
+    return result;
+}
+
+// --- Active compilation ---
+
+static void addLive(Arena* arena) {
+    pxMutexLock(&liveLock);
+    arena->nextLive = liveArenas;
+    liveArenas = arena;
+    pxMutexUnlock(&liveLock);
+}
+
+static void removeLive(Arena* arena) {
+    pxMutexLock(&liveLock);
+    for (Arena** link = &liveArenas; *link != NULL; link = &(*link)->nextLive) {
+        if (*link == arena) {
+            *link = arena->nextLive;
+            break;
+        }
+    }
+    pxMutexUnlock(&liveLock);
+}
+
+static Arena* currentArena(void) {
+    if (activeArena != NULL) return activeArena;
+    if (!defaultArenaReady) {
+        initArena(&defaultArena);
+        addLive(&defaultArena);
+        defaultArenaReady = true;
+    }
+    return &defaultArena;
+}
+
+void beginCompilation(Arena* arena) {
+    initArena(arena);
+    addLive(arena);
+    enterCompilation(arena);
+}
+
+void endCompilation(Arena* arena) {
+    leaveCompilation(arena);
+    removeLive(arena);
+    freeArena(arena);
+}
+
+void enterCompilation(Arena* arena) {
+    arena->enclosing = activeArena;
+    activeArena = arena;
+}
+
+void leaveCompilation(Arena* arena) {
+    activeArena = arena->enclosing;
+    arena->enclosing = NULL;
+}
+
+void* compilerAlloc(size_t size) {
+    return arenaAlloc(currentArena(), size);
+}
+
+void* compilerGrow(void* pointer, size_t oldSize, size_t newSize) {
+    return arenaGrow(currentArena(), pointer, oldSize, newSize);
+}
+
+char* compilerCopyString(const char* chars, int length) {
+    char* copy = (char*)compilerAlloc(length + 1);
+    memcpy(copy, chars, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+char* compilerStrdup(const char* string) {
+    return compilerCopyString(string, (int)strlen(string));
+}
+
+void compilerPinValue(Value value) {
+    if (!IS_OBJ(value)) return;
+    Arena* arena = currentArena();
+    // Plain realloc: growing the root set must not start a collection
+    // before the value is recorded.
+    if (arena->rootCount == arena->rootCapacity) {
+        arena->rootCapacity = arena->rootCapacity < 16 ? 16 : arena->rootCapacity * 2;
+        arena->roots = (Value*)realloc(arena->roots, sizeof(Value) * arena->rootCapacity);
+        if (arena->roots == NULL) {
+            fprintf(stderr, "Fatal: Out of memory in compiler arena.\n");
+            exit(1);
+        }
+    }
+    arena->roots[arena->rootCount++] = value;
+}
+
+void markCompilerArenas(void) {
+    // Collections only run while no front-end thread is working, so the
+    // root arrays are stable here.
+    pxMutexLock(&liveLock);
+    for (Arena* arena = liveArenas; arena != NULL; arena = arena->nextLive) {
+        for (int i = 0; i < arena->rootCount; i++) {
+            markValue(arena->roots[i]);
+        }
+    }
+    pxMutexUnlock(&liveLock);
+}
+
+// --- Threaded front-ends ---
+
+void setCompilerThreaded(bool threaded) {
+    compilerThreaded = threaded;
+}
+
+void compilerLock(void) {
+    if (compilerThreaded) pxMutexLock(&compilerMutex);
+}
+
+void compilerUnlock(void) {
+    if (compilerThreaded) pxMutexUnlock(&compilerMutex);
+}
+
+Value compilerString(const char* chars, int length) {
+    compilerLock();
+    Value value = OBJ_VAL(copyString(chars, length));
+    compilerUnlock();
+    return value;
+}
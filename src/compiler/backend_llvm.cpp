@@ -23,7 +23,9 @@ class LLVMEmitter {
     std::unique_ptr<llvm::Module> ModuleOb;
     std::unique_ptr<llvm::IRBuilder<>> Builder;
     std::map<IRBasicBlock*, llvm::BasicBlock*> blockMap;
+    std::map<IRBasicBlock*, llvm::BasicBlock*> exitBlockMap; // Where each IR block ends after splitting
     std::vector<llvm::Value*> ssaValues;
+    std::map<IRFunction*, llvm::Function*> functionMap; // Targets of direct calls
 
 public:
     LLVMEmitter() {
@@ -120,6 +122,14 @@ public:
     }
 
     void emitModule(IRModule* module) {
+        // Declare every function first so direct calls can refer to any of them
+        for (int i = 0; i < module->funcCount; i++) {
+            IRFunction* func = module->functions[i];
+            // All functions take and return boxed Values (Int64)
+            std::vector<llvm::Type*> ParamTypes(func->paramCount, Builder->getInt64Ty());
+            llvm::FunctionType *FT = llvm::FunctionType::get(Builder->getInt64Ty(), ParamTypes, false);
+            functionMap[func] = llvm::Function::Create(FT, llvm::Function::ExternalLinkage, func->name, ModuleOb.get());
+        }
         for (int i = 0; i < module->funcCount; i++) {
             emitFunction(module->functions[i]);
         }
@@ -144,12 +154,15 @@ public:
     }
 
     void emitFunction(IRFunction* func) {
-        // All functions return Value (Int64)
-        llvm::FunctionType *FT = llvm::FunctionType::get(Builder->getInt64Ty(), std::vector<llvm::Type*>(), false);
-        llvm::Function *F = llvm::Function::Create(FT, llvm::Function::ExternalLinkage, func->name, ModuleOb.get());
+        llvm::Function *F = functionMap[func];
 
         ssaValues.clear();
         blockMap.clear();
+        exitBlockMap.clear();
+        ssaValues.resize(func->nextSsaVal + 256, nullptr);
+        for (int i = 0; i < func->paramCount; i++) {
+            ssaValues[i] = F->getArg(i);
+        }
 
         // Pass 1: Create all blocks
         for (int i = 0; i < func->blockCount; i++) {
@@ -157,6 +170,14 @@ public:
             snprintf(name, sizeof(name), "block%d", func->blocks[i]->id);
             blockMap[func->blocks[i]] = llvm::BasicBlock::Create(*Context, name, F);
         }
+
+        // A specialized clone's callers proved its arguments numeric
+        if (func->paramTypes && func->blockCount > 0 && !func->isAsync) {
+            Builder->SetInsertPoint(blockMap[func->blocks[0]]);
+            for (int i = 0; i < func->paramCount; i++) {
+                if (isNumericType(func->paramTypes[i])) ssaValues[i] = asNumber(ssaValues[i]);
+            }
+        }
         
         // Async Setup
         llvm::Value* CoroId = nullptr;
@@ -246,7 +267,7 @@ public:
              }
              Builder->CreateCall(Free, {MemToFree});
              // Return NIL/Undef (caller shouldn't see this)
-             Builder->CreateRet(llvm::ConstantInt::get(*Context, llvm::APInt(64, 0x7ffc000000000001, false))); // NIL
+             Builder->CreateRet(boxedConstant(NIL_VAL));
 
              // Resume Path: Actual function body
              // Remap entry block to ResumeBB for subsequent instructions? 
@@ -274,6 +295,7 @@ public:
                 emitInstruction(instr, CoroHdl); // Pass coroutine handle if needed
                 instr = instr->next;
             }
+            exitBlockMap[irBlock] = Builder->GetInsertBlock();
         }
 
         // Pass 3: Fill in Phi operands
@@ -283,15 +305,13 @@ public:
                 if (instr->opcode == IR_OP_PHI) {
                     llvm::PHINode* phi = llvm::cast<llvm::PHINode>(ssaValues[instr->result]);
                     for (int k = 0; k < instr->operandCount; k += 2) {
-                        llvm::Value* val = getOperand(instr->operands[k]);
-                        if (!val) {
-                            uint64_t nilVal = 0x7ffc000000000001;
-                            val = llvm::ConstantInt::get(*Context, llvm::APInt(64, nilVal, false));
-                        }
-                        llvm::BasicBlock* incomingBB = blockMap[instr->operands[k+1].as.block];
-                        if (val && incomingBB) {
-                            phi->addIncoming(val, incomingBB);
-                        }
+                        llvm::BasicBlock* incomingBB = exitBlockMap[instr->operands[k+1].as.block];
+                        if (!incomingBB) continue;
+                        // Convert to the phi's representation at the end of the predecessor
+                        if (llvm::Instruction* Term = incomingBB->getTerminator()) Builder->SetInsertPoint(Term);
+                        else Builder->SetInsertPoint(incomingBB);
+                        llvm::Value* val = coerce(getOperand(instr->operands[k]), instr->type);
+                        phi->addIncoming(val, incomingBB);
                     }
                 }
                 instr = instr->next;
@@ -309,8 +329,7 @@ public:
                  Builder->CreateCall(FCoroEnd, {llvm::ConstantPointerNull::get(Builder->getPtrTy()), Builder->getInt1(0)});
                  Builder->CreateUnreachable(); // Should not return normally from here in coro structure
              } else {
-                 uint64_t nilVal = 0x7ffc000000000001; 
-                 Builder->CreateRet(llvm::ConstantInt::get(*Context, llvm::APInt(64, nilVal, false)));
+                 Builder->CreateRet(boxedConstant(NIL_VAL));
              }
          }
 
@@ -329,33 +348,20 @@ public:
         }
         switch (instr->opcode) {
             case IR_OP_CONST: {
+                Value constant = instr->operands[0].as.constant;
                 llvm::Value* v = nullptr;
-                if (IS_NUMBER(instr->operands[0].as.constant)) {
-                    // Just a double encoded as int64
-                    double num = AS_NUMBER(instr->operands[0].as.constant);
-                    uint64_t bits;
-                    memcpy(&bits, &num, sizeof(double));
-                    v = llvm::ConstantInt::get(*Context, llvm::APInt(64, bits, false));
-                } else if (IS_STRING(instr->operands[0].as.constant)) {
-                    // Define global string constant
-                    ObjString* strObj = AS_STRING(instr->operands[0].as.constant);
-                    llvm::Constant *StrConstant = llvm::ConstantDataArray::getString(*Context, strObj->chars);
-                    llvm::GlobalVariable *ValidStr = new llvm::GlobalVariable(*ModuleOb, StrConstant->getType(), true,
-                        llvm::GlobalValue::PrivateLinkage, StrConstant, ".str");
-                    
+                if (IS_STRING(constant)) {
                     // Call runtime to create ObjString
+                    ObjString* strObj = AS_STRING(constant);
                     llvm::Function *AllocFunc = ModuleOb->getFunction("prox_rt_const_string");
-                    llvm::Value* Zero = Builder->getInt32(0);
-                    llvm::Value* Args[] = { Zero, Zero };
-                    // GEP to get pointer to char array
-                    llvm::Value* StrPtr = Builder->CreateInBoundsGEP(StrConstant->getType(), ValidStr, Args);
-                    
                     v = Builder->CreateCall(AllocFunc, {
-                        StrPtr,
+                        stringPointer(strObj),
                         Builder->getInt32(strObj->length)
                     }, "strObj");
+                } else {
+                    v = boxedConstant(constant);
                 }
-                ssaValues[instr->result] = v;
+                ssaValues[instr->result] = coerce(v, instr->type);
                 break;
             }
             case IR_OP_ADD:
@@ -364,30 +370,86 @@ public:
             case IR_OP_DIV: {
                 llvm::Value* L = getOperand(instr->operands[0]);
                 llvm::Value* R = getOperand(instr->operands[1]);
-                if (instr->type == IR_TYPE_INT || instr->type == IR_TYPE_FLOAT) {
-                    // Type Specialization: Native raw LLVM math
-                    llvm::Value* LF = Builder->CreateBitCast(L, Builder->getDoubleTy(), "l_cast");
-                    llvm::Value* RF = Builder->CreateBitCast(R, Builder->getDoubleTy(), "r_cast");
-                    llvm::Value* ResF = nullptr;
-                    if (instr->opcode == IR_OP_ADD) ResF = Builder->CreateFAdd(LF, RF, "fadd");
-                    else if (instr->opcode == IR_OP_SUB) ResF = Builder->CreateFSub(LF, RF, "fsub");
-                    else if (instr->opcode == IR_OP_MUL) ResF = Builder->CreateFMul(LF, RF, "fmul");
-                    else if (instr->opcode == IR_OP_DIV) ResF = Builder->CreateFDiv(LF, RF, "fdiv");
-                    ssaValues[instr->result] = Builder->CreateBitCast(ResF, Builder->getInt64Ty(), "res_cast");
+                llvm::Value* Res = nullptr;
+                if (isNumericType(instr->type)) {
+                    // Both operands proven numeric: native double math, no boxing.
+                    // Integral values are doubles too, so INT lowers the same way.
+                    llvm::Value* LF = asNumber(L);
+                    llvm::Value* RF = asNumber(R);
+                    if (instr->opcode == IR_OP_ADD) Res = Builder->CreateFAdd(LF, RF, "fadd");
+                    else if (instr->opcode == IR_OP_SUB) Res = Builder->CreateFSub(LF, RF, "fsub");
+                    else if (instr->opcode == IR_OP_MUL) Res = Builder->CreateFMul(LF, RF, "fmul");
+                    else Res = Builder->CreateFDiv(LF, RF, "fdiv");
                 } else {
                     // NaN-Boxing fallback (Hybrid Mode)
                     const char* fname = "prox_rt_add";
                     if (instr->opcode == IR_OP_SUB) fname = "prox_rt_sub";
                     else if (instr->opcode == IR_OP_MUL) fname = "prox_rt_mul";
                     else if (instr->opcode == IR_OP_DIV) fname = "prox_rt_div";
-                    
-                    llvm::Function *OpFunc = ModuleOb->getFunction(fname);
-                    if (!OpFunc) {
-                        llvm::FunctionType* OpType = llvm::FunctionType::get(Builder->getInt64Ty(), {Builder->getInt64Ty(), Builder->getInt64Ty()}, false);
-                        OpFunc = llvm::Function::Create(OpType, llvm::Function::ExternalLinkage, fname, ModuleOb.get());
-                    }
-                    ssaValues[instr->result] = Builder->CreateCall(OpFunc, {L, R}, "optmp");
+                    Res = Builder->CreateCall(runtimeFunction(fname, 2), {box(L), box(R)}, "optmp");
                 }
+                ssaValues[instr->result] = coerce(Res, instr->type);
+                break;
+            }
+            case IR_OP_NEG: {
+                llvm::Value* V = getOperand(instr->operands[0]);
+                llvm::Value* Res = isNumericType(instr->type)
+                    ? Builder->CreateFNeg(asNumber(V), "fneg")
+                    : Builder->CreateCall(runtimeFunction("prox_rt_neg", 1), {box(V)}, "negtmp");
+                ssaValues[instr->result] = coerce(Res, instr->type);
+                break;
+            }
+            case IR_OP_CMP_LT:
+            case IR_OP_CMP_GT:
+            case IR_OP_CMP_EQ: {
+                llvm::Value* L = getOperand(instr->operands[0]);
+                llvm::Value* R = getOperand(instr->operands[1]);
+                llvm::Value* Res = nullptr;
+                if (L && R && L->getType()->isDoubleTy() && R->getType()->isDoubleTy()) {
+                    if (instr->opcode == IR_OP_CMP_LT) Res = Builder->CreateFCmpOLT(L, R, "flt");
+                    else if (instr->opcode == IR_OP_CMP_GT) Res = Builder->CreateFCmpOGT(L, R, "fgt");
+                    else Res = Builder->CreateFCmpOEQ(L, R, "feq");
+                } else if (instr->opcode == IR_OP_CMP_EQ && L && R &&
+                           L->getType()->isIntegerTy(1) && R->getType()->isIntegerTy(1)) {
+                    Res = Builder->CreateICmpEQ(L, R, "beq");
+                } else {
+                    // Unproven operands: compare inline when both turn out to be
+                    // numbers at runtime, otherwise defer to the runtime helper
+                    const char* fname = "prox_rt_equal";
+                    if (instr->opcode == IR_OP_CMP_LT) fname = "prox_rt_less";
+                    else if (instr->opcode == IR_OP_CMP_GT) fname = "prox_rt_greater";
+                    llvm::Value* BL = box(L);
+                    llvm::Value* BR = box(R);
+                    llvm::Function* F = Builder->GetInsertBlock()->getParent();
+                    llvm::BasicBlock* FastBB = llvm::BasicBlock::Create(*Context, "cmp.num", F);
+                    llvm::BasicBlock* SlowBB = llvm::BasicBlock::Create(*Context, "cmp.slow", F);
+                    llvm::BasicBlock* DoneBB = llvm::BasicBlock::Create(*Context, "cmp.done", F);
+                    Builder->CreateCondBr(Builder->CreateAnd(isNumber(BL), isNumber(BR)), FastBB, SlowBB);
+
+                    Builder->SetInsertPoint(FastBB);
+                    llvm::Value* LF = asNumber(BL);
+                    llvm::Value* RF = asNumber(BR);
+                    llvm::Value* Fast = instr->opcode == IR_OP_CMP_LT ? Builder->CreateFCmpOLT(LF, RF, "flt")
+                                      : instr->opcode == IR_OP_CMP_GT ? Builder->CreateFCmpOGT(LF, RF, "fgt")
+                                      : Builder->CreateFCmpOEQ(LF, RF, "feq");
+                    Builder->CreateBr(DoneBB);
+
+                    Builder->SetInsertPoint(SlowBB);
+                    llvm::Value* Slow = asBool(Builder->CreateCall(runtimeFunction(fname, 2), {BL, BR}, "cmptmp"));
+                    Builder->CreateBr(DoneBB);
+
+                    Builder->SetInsertPoint(DoneBB);
+                    llvm::PHINode* Merged = Builder->CreatePHI(Builder->getInt1Ty(), 2, "cmp");
+                    Merged->addIncoming(Fast, FastBB);
+                    Merged->addIncoming(Slow, SlowBB);
+                    Res = Merged;
+                }
+                ssaValues[instr->result] = coerce(Res, instr->type);
+                break;
+            }
+            case IR_OP_NOT: {
+                llvm::Value* V = asBool(getOperand(instr->operands[0]));
+                ssaValues[instr->result] = coerce(Builder->CreateNot(V, "not"), instr->type);
                 break;
             }
             case IR_OP_ALLOCA: {
@@ -414,7 +476,7 @@ public:
             }
             
             case IR_OP_AWAIT: {
-                llvm::Value* TaskToAwait = getOperand(instr->operands[0]);
+                llvm::Value* TaskToAwait = box(getOperand(instr->operands[0]));
 
                 if (!CoroHdl) {
                     // Sync await (e.g. in main)
@@ -464,7 +526,7 @@ public:
                 // Usually void or boolean. 
                 // But our function signature returns Value (Int64).
                 // Return NIL/Placeholder.
-                Builder->CreateRet(llvm::ConstantInt::get(*Context, llvm::APInt(64, 0x7ffc000000000001, false))); // NIL
+                Builder->CreateRet(boxedConstant(NIL_VAL));
 
                 // Cleanup
                 Builder->SetInsertPoint(CleanupBB);
@@ -484,6 +546,78 @@ public:
                 break;
             }
 
+            case IR_OP_GET_INDEX:
+            case IR_OP_SET_INDEX: {
+                // Unchecked forms skip the list bounds test the loop proved
+                bool set = instr->opcode == IR_OP_SET_INDEX;
+                const char* fname = set ? (instr->checked ? "prox_rt_set_index" : "prox_rt_set_index_unchecked")
+                                        : (instr->checked ? "prox_rt_get_index" : "prox_rt_get_index_unchecked");
+                std::vector<llvm::Value*> Args;
+                for (int i = 0; i < instr->operandCount; i++) Args.push_back(box(getOperand(instr->operands[i])));
+                llvm::Value* Res = Builder->CreateCall(runtimeFunction(fname, instr->operandCount), Args, "index");
+                if (!set) ssaValues[instr->result] = coerce(Res, instr->type);
+                break;
+            }
+            case IR_OP_LENGTH: {
+                llvm::Value* V = box(getOperand(instr->operands[0]));
+                llvm::Value* Res = Builder->CreateCall(runtimeFunction("prox_rt_length", 1), {V}, "len");
+                ssaValues[instr->result] = coerce(Res, instr->type);
+                break;
+            }
+            case IR_OP_NEW_LIST: {
+                // Value prox_rt_new_list(Value* items, int count)
+                // Value prox_rt_stack_list(void* storage, Value* items, int count)
+                // Elements are staged in an entry-block array. A list that does
+                // not escape keeps them there and gets its header in this frame.
+                int count = instr->operandCount;
+                llvm::Function* F = Builder->GetInsertBlock()->getParent();
+                llvm::IRBuilder<> Entry(&F->getEntryBlock(), F->getEntryBlock().begin());
+                llvm::Value* Items = Entry.CreateAlloca(Builder->getInt64Ty(), Builder->getInt32(count > 0 ? count : 1), "list_items");
+                for (int i = 0; i < count; i++) {
+                    llvm::Value* Slot = Builder->CreateConstInBoundsGEP1_32(Builder->getInt64Ty(), Items, i);
+                    Builder->CreateStore(box(getOperand(instr->operands[i])), Slot);
+                }
+                const char* fname = instr->escapes ? "prox_rt_new_list" : "prox_rt_stack_list";
+                llvm::Function* Fn = ModuleOb->getFunction(fname);
+                if (!Fn) {
+                    std::vector<llvm::Type*> Params = {Builder->getPtrTy(), Builder->getInt32Ty()};
+                    if (!instr->escapes) Params.insert(Params.begin(), Builder->getPtrTy());
+                    llvm::FunctionType* FT = llvm::FunctionType::get(Builder->getInt64Ty(), Params, false);
+                    Fn = llvm::Function::Create(FT, llvm::Function::ExternalLinkage, fname, ModuleOb.get());
+                }
+                std::vector<llvm::Value*> Args = {Items, Builder->getInt32(count)};
+                if (!instr->escapes) {
+                    llvm::AllocaInst* Storage = Entry.CreateAlloca(
+                        llvm::ArrayType::get(Builder->getInt8Ty(), sizeof(ObjList)), nullptr, "stack_list");
+                    Storage->setAlignment(llvm::Align(alignof(ObjList)));
+                    Args.insert(Args.begin(), Storage);
+                }
+                llvm::Value* Res = Builder->CreateCall(Fn, Args, "list");
+                ssaValues[instr->result] = coerce(Res, instr->type);
+                break;
+            }
+            case IR_OP_GET_MEMBER:
+            case IR_OP_SET_MEMBER: {
+                // Value prox_rt_get_member(Value object, char* name, int length)
+                // Value prox_rt_set_member(Value object, char* name, int length, Value value)
+                bool set = instr->opcode == IR_OP_SET_MEMBER;
+                const char* fname = set ? "prox_rt_set_member" : "prox_rt_get_member";
+                llvm::Function* F = ModuleOb->getFunction(fname);
+                if (!F) {
+                    std::vector<llvm::Type*> Params = {Builder->getInt64Ty(), Builder->getPtrTy(), Builder->getInt32Ty()};
+                    if (set) Params.push_back(Builder->getInt64Ty());
+                    llvm::FunctionType* FT = llvm::FunctionType::get(Builder->getInt64Ty(), Params, false);
+                    F = llvm::Function::Create(FT, llvm::Function::ExternalLinkage, fname, ModuleOb.get());
+                }
+                ObjString* name = AS_STRING(instr->operands[1].as.constant);
+                std::vector<llvm::Value*> Args = {
+                    box(getOperand(instr->operands[0])), stringPointer(name), Builder->getInt32(name->length)
+                };
+                if (set) Args.push_back(box(getOperand(instr->operands[2])));
+                llvm::Value* Res = Builder->CreateCall(F, Args, "member");
+                if (!set) ssaValues[instr->result] = coerce(Res, instr->type);
+                break;
+            }
             case IR_OP_JUMP: {
                 Builder->CreateBr(blockMap[instr->operands[0].as.block]);
                 break;
@@ -493,23 +627,18 @@ public:
                 llvm::BasicBlock* Then = blockMap[instr->operands[1].as.block];
                 llvm::BasicBlock* Else = blockMap[instr->operands[2].as.block];
                 
-                // Temporary: Treat 0 as false
-                 if (Cond) {
-                    llvm::Value* boolCond = Builder->CreateICmpNE(Cond, llvm::ConstantInt::get(*Context, llvm::APInt(64, 0)), "ifcond");
-                    Builder->CreateCondBr(boolCond, Then, Else);
-                 }
+                // Proven booleans branch on the i1 directly; anything else is
+                // tested for truthiness (only null and false are falsey)
+                Builder->CreateCondBr(asBool(Cond), Then, Else);
                 break;
             }
             case IR_OP_PHI: {
-                ssaValues[instr->result] = Builder->CreatePHI(Builder->getInt64Ty(), instr->operandCount / 2, "phitmp");
+                ssaValues[instr->result] = Builder->CreatePHI(typeFor(instr->type), instr->operandCount / 2, "phitmp");
                 break;
             }
             case IR_OP_RETURN: {
-                llvm::Value* V = getOperand(instr->operands[0]);
-                if (!V) {
-                   uint64_t nilVal = 0x7ffc000000000001; 
-                   V = llvm::ConstantInt::get(*Context, llvm::APInt(64, nilVal, false));
-                }
+                // Returned values escape: box them
+                llvm::Value* V = box(instr->operandCount > 0 ? getOperand(instr->operands[0]) : nullptr);
                 
                 if (CoroHdl) {
                     // Async return: Mark task as complete with value V
@@ -528,7 +657,7 @@ public:
                 std::vector<llvm::Value*> Args;
                 std::vector<llvm::Type*> ArgTypes;
                 for (int i = 1; i < instr->operandCount; i++) {
-                    llvm::Value* Arg = getOperand(instr->operands[i]);
+                    llvm::Value* Arg = box(getOperand(instr->operands[i]));
                     if (Arg) {
                         Args.push_back(Arg);
                         ArgTypes.push_back(Arg->getType());
@@ -593,22 +722,93 @@ public:
     }
 
     // Call this from setupRuntimeTypes or Constructor
+
+    // --- Value representations ---
+    // Values proven INT/FLOAT live in registers as double, BOOL as i1, and
+    // everything else as a NaN-boxed i64. Boxing only happens where a value
+    // escapes: returns, call arguments, runtime helpers and untyped phis.
+
+    static bool isNumericType(IRType type) {
+        return type == IR_TYPE_INT || type == IR_TYPE_FLOAT;
+    }
+
+    llvm::Type* typeFor(IRType type) {
+        if (isNumericType(type)) return Builder->getDoubleTy();
+        if (type == IR_TYPE_BOOL) return Builder->getInt1Ty();
+        return Builder->getInt64Ty();
+    }
+
+    llvm::Value* boxedConstant(Value value) {
+        return llvm::ConstantInt::get(*Context, llvm::APInt(64, value, false));
+    }
+
+    llvm::Value* box(llvm::Value* v) {
+        if (!v) return boxedConstant(NIL_VAL);
+        if (v->getType()->isDoubleTy()) return Builder->CreateBitCast(v, Builder->getInt64Ty(), "box");
+        if (v->getType()->isIntegerTy(1)) {
+            return Builder->CreateSelect(v, boxedConstant(BOOL_VAL(true)), boxedConstant(BOOL_VAL(false)), "boxb");
+        }
+        return v;
+    }
+
+    // Only called where type inference proved the value is a number.
+    llvm::Value* asNumber(llvm::Value* v) {
+        if (v && v->getType()->isDoubleTy()) return v;
+        return Builder->CreateBitCast(box(v), Builder->getDoubleTy(), "unbox");
+    }
+
+    llvm::Value* isNumber(llvm::Value* boxed) {
+        llvm::Value* QNan = boxedConstant(QNAN);
+        return Builder->CreateICmpNE(Builder->CreateAnd(boxed, QNan), QNan, "isnum");
+    }
+
+    // Truthiness: only null and false are falsey.
+    llvm::Value* asBool(llvm::Value* v) {
+        if (v && v->getType()->isIntegerTy(1)) return v;
+        if (v && v->getType()->isDoubleTy()) return Builder->getInt1(1);
+        v = box(v);
+        llvm::Value* notNil = Builder->CreateICmpNE(v, boxedConstant(NIL_VAL), "notnil");
+        llvm::Value* notFalse = Builder->CreateICmpNE(v, boxedConstant(BOOL_VAL(false)), "notfalse");
+        return Builder->CreateAnd(notNil, notFalse, "truthy");
+    }
+
+    llvm::Value* coerce(llvm::Value* v, IRType type) {
+        if (isNumericType(type)) return asNumber(v);
+        if (type == IR_TYPE_BOOL) return asBool(v);
+        return box(v);
+    }
+
+    // Pointer to a private global holding the string's characters.
+    llvm::Value* stringPointer(ObjString* string) {
+        llvm::Constant *StrConstant = llvm::ConstantDataArray::getString(*Context, string->chars);
+        llvm::GlobalVariable *Global = new llvm::GlobalVariable(*ModuleOb, StrConstant->getType(), true,
+            llvm::GlobalValue::PrivateLinkage, StrConstant, ".str");
+        llvm::Value* Zero = Builder->getInt32(0);
+        llvm::Value* Args[] = { Zero, Zero };
+        return Builder->CreateInBoundsGEP(StrConstant->getType(), Global, Args);
+    }
+
+    llvm::Function* runtimeFunction(const char* name, int arity) {
+        llvm::Function* F = ModuleOb->getFunction(name);
+        if (!F) {
+            std::vector<llvm::Type*> Params(arity, Builder->getInt64Ty());
+            llvm::FunctionType* FT = llvm::FunctionType::get(Builder->getInt64Ty(), Params, false);
+            F = llvm::Function::Create(FT, llvm::Function::ExternalLinkage, name, ModuleOb.get());
+        }
+        return F;
+    }
     
     llvm::Value* getOperand(IROperand& op) {
         if (op.type == OPERAND_CONST) {
-             if (IS_NUMBER(op.as.constant)) {
-                // Return int64 representation of double
-                double num = AS_NUMBER(op.as.constant);
-                uint64_t bits;
-                memcpy(&bits, &num, sizeof(double));
-                return llvm::ConstantInt::get(*Context, llvm::APInt(64, bits, false));
-            }
-            // Other constants?
-            return nullptr;
+            if (IS_OBJ(op.as.constant)) return nullptr; // Objects need a runtime allocation
+            return boxedConstant(op.as.constant);
         } else if (op.type == OPERAND_VAL) {
             if (op.as.ssaVal >= 0 && (size_t)op.as.ssaVal < ssaValues.size()) {
                 return ssaValues[op.as.ssaVal];
             }
+        } else if (op.type == OPERAND_FUNC) {
+            auto it = functionMap.find(op.as.func);
+            if (it != functionMap.end()) return it->second;
         }
         return nullptr;
     }
@@ -8,6 +8,9 @@
 #include "../../include/value.h"
 #include "../../include/object.h"
 #include "../../include/vm.h"
+#include "../../include/gc.h"
+#include "../../include/compiler.h"
+#include "../../include/escape_analysis.h"
 #include <stddef.h> 
 
 extern Value evaluateComptime(StmtList* statements);
@@ -15,8 +18,10 @@ extern Value evaluateComptime(StmtList* statements);
 // --- Compiler & Scope Types ---
 
 typedef struct {
-    const char* name;
+    const char* name; // Interned, so names compare by pointer
     int depth;
+    bool isCaptured;        // Closed over by a nested function
+    bool holdsStackClosure; // May hold a closure made by OP_STACK_CLOSURE
 } Local;
 
 typedef enum {
@@ -26,40 +31,75 @@ typedef enum {
 
 typedef struct Loop {
     struct Loop* enclosing;
-    int startIp;
-    int continueIp;
     int scopeDepth;
     int localCountAtEntry;
     int* breakJumps;
     int breakCount;
     int breakCapacity;
+    // Loops are rotated (condition at the bottom), so 'continue' jumps
+    // forward to code that has not been emitted yet
+    int* continueJumps;
+    int continueCount;
+    int continueCapacity;
 } Loop;
 
 typedef struct {
-    uint8_t index;
+    uint16_t index;
     bool isLocal;
 } Upvalue;
 
+// Locals, upvalues, constant-table indices and counts past a byte use the
+// OP_WIDE form, which gives slots and counts 16 bits and constant indices
+// (names among them) 24 bits.
+#define MAX_INDEX UINT16_MAX
+#define MAX_CONSTANT_INDEX 0xFFFFFF
+
 typedef struct Compiler {
     struct Compiler* enclosing;
     ObjFunction* function;
     CompFunctionType type;
 
-    Local locals[256];
+    Local* locals;
     int localCount;
+    int localCapacity;
     int scopeDepth;
-    
-    Upvalue upvalues[256];
-    
+
+    Upvalue* upvalues;
+    int upvalueCapacity;
+    // Captures of variables that are never reassigned, copied by value
+    // (function->captureCount of them)
+    Upvalue* captures;
+    int captureCapacity;
+
+    // Names assigned anywhere in the body, nested functions included. A
+    // captured local not in this list is flattened into a capture.
+    const char** assigned;
+    int assignedCount;
+    int assignedCapacity;
+    bool assignsUnknown; // Met a construct the scan does not model
+
+    // Constant index of each string already in the chunk, so a name that is
+    // referenced many times takes a single slot
+    Table stringConstants;
+
     Loop* loop;
 } Compiler;
 
-typedef struct {
+typedef struct BytecodeGen {
+    struct BytecodeGen* enclosing;
     Compiler* compiler;
-    Chunk* chunk; 
+    Chunk* chunk;
     bool hadError;
+    // Set when a jump does not fit in 16 bits; the module is then compiled
+    // again with every jump in its OP_WIDE form.
+    bool jumpOverflow;
+    bool wideJumps;
 } BytecodeGen;
 
+// Generator currently running, so the GC can reach the functions under
+// construction (see markBytecodeGenRoots()).
+static BytecodeGen* activeGen = NULL;
+
 // --- Forward Declarations ---
 
 static void genExpr(BytecodeGen* gen, Expr* expr);
@@ -69,22 +109,249 @@ static void emitTensorConstruction(BytecodeGen* gen, Expr* expr);
 
 // --- Helpers ---
 
-static void initCompiler(BytecodeGen* gen, Compiler* compiler, CompFunctionType type) {
-    compiler->enclosing = gen->compiler;
-    compiler->function = NULL;
+static void setupCompiler(Compiler* compiler, Compiler* enclosing, ObjFunction* function, CompFunctionType type) {
+    compiler->enclosing = enclosing;
+    compiler->function = function;
     compiler->type = type;
     compiler->localCount = 0;
     compiler->scopeDepth = 0;
-    
-    // New function object
-    compiler->function = newFunction();
-    gen->compiler = compiler;
-    gen->chunk = &compiler->function->chunk;
+    compiler->loop = NULL;
+
+    compiler->localCapacity = 8;
+    compiler->locals = (Local*)malloc(sizeof(Local) * compiler->localCapacity);
+    compiler->upvalueCapacity = 0;
+    compiler->upvalues = NULL;
+    compiler->captureCapacity = 0;
+    compiler->captures = NULL;
+    compiler->assigned = NULL;
+    compiler->assignedCount = 0;
+    compiler->assignedCapacity = 0;
+    compiler->assignsUnknown = false;
+    initTable(&compiler->stringConstants);
 
     // Reserve stack slot 0 for local use (or 'this')
     Local* local = &compiler->locals[compiler->localCount++];
     local->depth = 0;
     local->name = ""; // Internal usage
+    local->isCaptured = false;
+    local->holdsStackClosure = false;
+}
+
+static void freeCompiler(Compiler* compiler) {
+    free(compiler->locals);
+    free(compiler->upvalues);
+    free(compiler->captures);
+    free(compiler->assigned);
+    freeTable(&compiler->stringConstants);
+}
+
+// --- Assignment Scan ---
+
+static void noteAssigned(Compiler* compiler, const char* name) {
+    const char* interned = internName(name, (int)strlen(name));
+    for (int i = 0; i < compiler->assignedCount; i++) {
+        if (compiler->assigned[i] == interned) return;
+    }
+    if (compiler->assignedCount == compiler->assignedCapacity) {
+        compiler->assignedCapacity = compiler->assignedCapacity < 8 ? 8 : compiler->assignedCapacity * 2;
+        compiler->assigned = (const char**)realloc((void*)compiler->assigned,
+                                                   sizeof(const char*) * compiler->assignedCapacity);
+    }
+    compiler->assigned[compiler->assignedCount++] = interned;
+}
+
+// 'name' must be interned.
+static bool isAssigned(Compiler* compiler, const char* name) {
+    if (compiler->assignsUnknown) return true;
+    for (int i = 0; i < compiler->assignedCount; i++) {
+        if (compiler->assigned[i] == name) return true;
+    }
+    return false;
+}
+
+static void scanAssignsStmts(Compiler* compiler, StmtList* list);
+
+static void scanAssignsExprs(Compiler* compiler, ExprList* list);
+
+// Only EXPR_ASSIGN writes a variable; the rest is walked for nested ones.
+static void scanAssignsExpr(Compiler* compiler, Expr* expr) {
+    if (expr == NULL) return;
+    switch (expr->type) {
+        case EXPR_LITERAL:
+        case EXPR_THIS:
+        case EXPR_SUPER:
+        case EXPR_VARIABLE:
+            break;
+        case EXPR_ASSIGN:
+            noteAssigned(compiler, expr->as.assign.name);
+            scanAssignsExpr(compiler, expr->as.assign.value);
+            break;
+        case EXPR_GROUPING:
+            scanAssignsExpr(compiler, expr->as.grouping.expression);
+            break;
+        case EXPR_LOGICAL:
+            scanAssignsExpr(compiler, expr->as.logical.left);
+            scanAssignsExpr(compiler, expr->as.logical.right);
+            break;
+        case EXPR_TERNARY:
+            scanAssignsExpr(compiler, expr->as.ternary.condition);
+            scanAssignsExpr(compiler, expr->as.ternary.true_branch);
+            scanAssignsExpr(compiler, expr->as.ternary.false_branch);
+            break;
+        case EXPR_CALL:
+            scanAssignsExpr(compiler, expr->as.call.callee);
+            scanAssignsExprs(compiler, expr->as.call.arguments);
+            break;
+        case EXPR_BINARY:
+            scanAssignsExpr(compiler, expr->as.binary.left);
+            scanAssignsExpr(compiler, expr->as.binary.right);
+            break;
+        case EXPR_UNARY:
+            scanAssignsExpr(compiler, expr->as.unary.right);
+            break;
+        case EXPR_GET:
+            scanAssignsExpr(compiler, expr->as.get.object);
+            break;
+        case EXPR_SET:
+            scanAssignsExpr(compiler, expr->as.set.object);
+            scanAssignsExpr(compiler, expr->as.set.value);
+            break;
+        case EXPR_INDEX:
+            scanAssignsExpr(compiler, expr->as.index.target);
+            scanAssignsExpr(compiler, expr->as.index.index);
+            break;
+        case EXPR_SET_INDEX:
+            scanAssignsExpr(compiler, expr->as.set_index.target);
+            scanAssignsExpr(compiler, expr->as.set_index.index);
+            scanAssignsExpr(compiler, expr->as.set_index.value);
+            break;
+        case EXPR_LIST:
+            scanAssignsExprs(compiler, expr->as.list.elements);
+            break;
+        case EXPR_DICTIONARY:
+            if (expr->as.dictionary.pairs) {
+                for (int i = 0; i < expr->as.dictionary.pairs->count; i++) {
+                    scanAssignsExpr(compiler, expr->as.dictionary.pairs->items[i].key);
+                    scanAssignsExpr(compiler, expr->as.dictionary.pairs->items[i].value);
+                }
+            }
+            break;
+        case EXPR_TEMPLATE_LITERAL:
+            scanAssignsExprs(compiler, expr->as.template_literal.parts);
+            break;
+        case EXPR_AWAIT:
+            scanAssignsExpr(compiler, expr->as.await_expr.expression);
+            break;
+        case EXPR_NEW:
+            scanAssignsExpr(compiler, expr->as.new_expr.clazz);
+            scanAssignsExprs(compiler, expr->as.new_expr.args);
+            break;
+        case EXPR_UNWRAP:
+            scanAssignsExpr(compiler, expr->as.unwrap.expression);
+            break;
+        case EXPR_LAMBDA:
+            scanAssignsStmts(compiler, expr->as.lambda.body);
+            break;
+        default:
+            compiler->assignsUnknown = true;
+            break;
+    }
+}
+
+static void scanAssignsExprs(Compiler* compiler, ExprList* list) {
+    if (list == NULL) return;
+    for (int i = 0; i < list->count; i++) {
+        scanAssignsExpr(compiler, list->items[i]);
+    }
+}
+
+static void scanAssignsStmt(Compiler* compiler, Stmt* stmt) {
+    if (stmt == NULL) return;
+    switch (stmt->type) {
+        case STMT_EXPRESSION:
+            scanAssignsExpr(compiler, stmt->as.expression.expression);
+            break;
+        case STMT_PRINT:
+            scanAssignsExpr(compiler, stmt->as.print.expression);
+            break;
+        case STMT_RETURN:
+            scanAssignsExpr(compiler, stmt->as.return_stmt.value);
+            break;
+        case STMT_VAR_DECL:
+            scanAssignsExpr(compiler, stmt->as.var_decl.initializer);
+            break;
+        case STMT_FUNC_DECL:
+            scanAssignsStmts(compiler, stmt->as.func_decl.body);
+            break;
+        case STMT_CLASS_DECL:
+            scanAssignsExpr(compiler, stmt->as.class_decl.superclass);
+            if (stmt->as.class_decl.methods) {
+                for (int i = 0; i < stmt->as.class_decl.methods->count; i++) {
+                    scanAssignsStmt(compiler, stmt->as.class_decl.methods->items[i]);
+                }
+            }
+            break;
+        case STMT_BLOCK:
+            scanAssignsStmts(compiler, stmt->as.block.statements);
+            break;
+        case STMT_IF:
+            scanAssignsExpr(compiler, stmt->as.if_stmt.condition);
+            scanAssignsStmt(compiler, stmt->as.if_stmt.then_branch);
+            scanAssignsStmt(compiler, stmt->as.if_stmt.else_branch);
+            break;
+        case STMT_WHILE:
+            scanAssignsExpr(compiler, stmt->as.while_stmt.condition);
+            scanAssignsStmt(compiler, stmt->as.while_stmt.body);
+            break;
+        case STMT_FOR:
+            scanAssignsStmt(compiler, stmt->as.for_stmt.initializer);
+            scanAssignsExpr(compiler, stmt->as.for_stmt.condition);
+            scanAssignsExpr(compiler, stmt->as.for_stmt.increment);
+            scanAssignsStmt(compiler, stmt->as.for_stmt.body);
+            break;
+        case STMT_FOR_IN:
+            scanAssignsExpr(compiler, stmt->as.for_in.iterable);
+            scanAssignsStmt(compiler, stmt->as.for_in.body);
+            break;
+        case STMT_SWITCH:
+            scanAssignsExpr(compiler, stmt->as.switch_stmt.value);
+            if (stmt->as.switch_stmt.cases) {
+                for (int i = 0; i < stmt->as.switch_stmt.cases->count; i++) {
+                    scanAssignsExpr(compiler, stmt->as.switch_stmt.cases->items[i].value);
+                    scanAssignsStmts(compiler, stmt->as.switch_stmt.cases->items[i].statements);
+                }
+            }
+            scanAssignsStmts(compiler, stmt->as.switch_stmt.default_case);
+            break;
+        case STMT_TRY_CATCH:
+            scanAssignsStmts(compiler, stmt->as.try_catch.try_block);
+            scanAssignsStmts(compiler, stmt->as.try_catch.catch_block);
+            scanAssignsStmts(compiler, stmt->as.try_catch.finally_block);
+            break;
+        case STMT_BREAK:
+        case STMT_CONTINUE:
+        case STMT_USE_DECL:
+        case STMT_INTERFACE_DECL:
+        case STMT_EXTERN_DECL:
+            break;
+        default:
+            compiler->assignsUnknown = true;
+            break;
+    }
+}
+
+static void scanAssignsStmts(Compiler* compiler, StmtList* list) {
+    if (list == NULL) return;
+    for (int i = 0; i < list->count; i++) {
+        scanAssignsStmt(compiler, list->items[i]);
+    }
+}
+
+static void initCompiler(BytecodeGen* gen, Compiler* compiler, CompFunctionType type) {
+    // New function object
+    setupCompiler(compiler, gen->compiler, newFunction(), type);
+    gen->compiler = compiler;
+    gen->chunk = &compiler->function->chunk;
 }
 
 static ObjFunction* endCompiler(BytecodeGen* gen, bool isInit) {
@@ -114,27 +381,33 @@ static void beginScope(BytecodeGen* gen) {
     gen->compiler->scopeDepth++;
 }
 
+// Discards a local leaving scope; a captured one moves into its upvalue.
+static void emitPopLocal(BytecodeGen* gen, Local* local, int line) {
+    writeChunk(gen->chunk, local->isCaptured ? OP_CLOSE_UPVALUE : OP_POP, line);
+}
+
 static void endScope(BytecodeGen* gen) {
     gen->compiler->scopeDepth--;
     // Pop locals
     while (gen->compiler->localCount > 0 &&
            gen->compiler->locals[gen->compiler->localCount - 1].depth > gen->compiler->scopeDepth) {
-        writeChunk(gen->chunk, OP_POP, 0); 
+        emitPopLocal(gen, &gen->compiler->locals[gen->compiler->localCount - 1], 0);
         gen->compiler->localCount--;
     }
 }
 
+// 'name' must be interned; local names are interned by addLocal().
 static int resolveLocal(BytecodeGen* gen, const char* name) {
     for (int i = gen->compiler->localCount - 1; i >= 0; i--) {
         Local* local = &gen->compiler->locals[i];
-        if (strcmp(name, local->name) == 0) {
+        if (local->name == name) {
             return i;
         }
     }
     return -1;
 }
 
-static int addUpvalue(Compiler* compiler, uint8_t index, bool isLocal) {
+static int addUpvalue(Compiler* compiler, int index, bool isLocal) {
     int upvalueCount = compiler->function->upvalueCount;
     // Deduplicate shared upvalues where safe
     for (int i = 0; i < upvalueCount; i++) {
@@ -144,56 +417,155 @@ static int addUpvalue(Compiler* compiler, uint8_t index, bool isLocal) {
         }
     }
 
-    if (upvalueCount == 256) {
+    if (upvalueCount > MAX_INDEX) {
         fprintf(stderr, "Too many closure variables in function.\n");
         return 0;
     }
 
+    if (upvalueCount == compiler->upvalueCapacity) {
+        compiler->upvalueCapacity = compiler->upvalueCapacity < 8 ? 8 : compiler->upvalueCapacity * 2;
+        compiler->upvalues = (Upvalue*)realloc(compiler->upvalues, sizeof(Upvalue) * compiler->upvalueCapacity);
+    }
     compiler->upvalues[upvalueCount].isLocal = isLocal;
-    compiler->upvalues[upvalueCount].index = index;
+    compiler->upvalues[upvalueCount].index = (uint16_t)index;
     return compiler->function->upvalueCount++;
 }
 
-static int resolveUpvalue(Compiler* compiler, const char* name) {
+static int addCapture(Compiler* compiler, int index, bool isLocal) {
+    int captureCount = compiler->function->captureCount;
+    for (int i = 0; i < captureCount; i++) {
+        Upvalue* capture = &compiler->captures[i];
+        if (capture->index == index && capture->isLocal == isLocal) {
+            return i;
+        }
+    }
+
+    if (captureCount > MAX_INDEX) {
+        fprintf(stderr, "Too many closure variables in function.\n");
+        return 0;
+    }
+
+    if (captureCount == compiler->captureCapacity) {
+        compiler->captureCapacity = compiler->captureCapacity < 8 ? 8 : compiler->captureCapacity * 2;
+        compiler->captures = (Upvalue*)realloc(compiler->captures, sizeof(Upvalue) * compiler->captureCapacity);
+    }
+    compiler->captures[captureCount].isLocal = isLocal;
+    compiler->captures[captureCount].index = (uint16_t)index;
+    return compiler->function->captureCount++;
+}
+
+// Returns the upvalue index of 'name', or its capture index when '*flat'
+// is set: a variable its own function never reassigns is copied into the
+// closure instead of being shared through an ObjUpvalue.
+static int resolveUpvalue(Compiler* compiler, const char* name, bool* flat) {
+    *flat = false;
     if (compiler == NULL || compiler->enclosing == NULL) return -1;
 
-    for (int i = compiler->enclosing->localCount - 1; i >= 0; i--) {
-        if (strcmp(name, compiler->enclosing->locals[i].name) == 0) {
-            return addUpvalue(compiler, (uint8_t)i, true);
+    Compiler* enclosing = compiler->enclosing;
+    for (int i = enclosing->localCount - 1; i >= 0; i--) {
+        if (enclosing->locals[i].name == name) {
+            if (!isAssigned(enclosing, name)) {
+                *flat = true;
+                return addCapture(compiler, i, true);
+            }
+            enclosing->locals[i].isCaptured = true;
+            return addUpvalue(compiler, i, true);
         }
     }
 
-    int upvalue = resolveUpvalue(compiler->enclosing, name);
+    bool outerFlat;
+    int upvalue = resolveUpvalue(enclosing, name, &outerFlat);
     if (upvalue != -1) {
-        return addUpvalue(compiler, (uint8_t)upvalue, false);
+        *flat = outerFlat;
+        return outerFlat ? addCapture(compiler, upvalue, false) : addUpvalue(compiler, upvalue, false);
     }
 
     return -1;
 }
 
+static int makeConstant(BytecodeGen* gen, Value value) {
+    // The value is usually fresh (a name string, a finished function) and
+    // growing the constant table can collect.
+    push(&vm, value);
+    int constant;
+    Value index;
+    if (!IS_STRING(value)) {
+        constant = addConstant(gen->chunk, value);
+    } else if (tableGet(&gen->compiler->stringConstants, AS_STRING(value), &index)) {
+        constant = (int)AS_NUMBER(index);
+    } else {
+        constant = addConstant(gen->chunk, value);
+        tableSet(&gen->compiler->stringConstants, AS_STRING(value), NUMBER_VAL(constant));
+    }
+    pop(&vm);
+    return constant;
+}
+
 static void addLocal(BytecodeGen* gen, const char* name) {
     if (gen->hadError) return;
-    if (gen->compiler->localCount == 256) {
+    Compiler* compiler = gen->compiler;
+    if (compiler->localCount > MAX_INDEX) {
         fprintf(stderr, "Too many local variables.\n");
         gen->hadError = true;
         return;
     }
+    if (compiler->localCount == compiler->localCapacity) {
+        compiler->localCapacity *= 2;
+        compiler->locals = (Local*)realloc(compiler->locals, sizeof(Local) * compiler->localCapacity);
+    }
     Local* local = &gen->compiler->locals[gen->compiler->localCount++];
-    local->name = name;
+    local->name = internName(name, (int)strlen(name));
     local->depth = gen->compiler->scopeDepth; // Assuming initialized immediately
+    local->isCaptured = false;
+    local->holdsStackClosure = false;
+}
+
+// True for the opcodes whose operand is a slot or count rather than an
+// index into the constant table.
+static bool hasSlotOperand(OpCode op) {
+    switch (op) {
+        case OP_GET_LOCAL: case OP_SET_LOCAL:
+        case OP_GET_UPVALUE: case OP_SET_UPVALUE: case OP_GET_CAPTURE:
+        case OP_BUILD_LIST: case OP_BUILD_MAP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Emits 'op' with its constant index, slot or count operand. Operands that
+// do not fit in a byte use the OP_WIDE form: OP_WIDE, op, then a 16-bit
+// slot or count or a 24-bit constant index.
+static void emitIndexed(BytecodeGen* gen, OpCode op, int index, int line) {
+    bool slot = hasSlotOperand(op);
+    if (index > (slot ? MAX_INDEX : MAX_CONSTANT_INDEX)) {
+        if (slot) fprintf(stderr, "Error: Too many elements in one literal at line %d\n", line);
+        else fprintf(stderr, "Error: Too many constants in one function at line %d\n", line);
+        gen->hadError = true;
+        return;
+    }
+    if (index > UINT8_MAX) {
+        writeChunk(gen->chunk, OP_WIDE, line);
+        writeChunk(gen->chunk, op, line);
+        if (!slot) writeChunk(gen->chunk, (index >> 16) & 0xff, line);
+        writeChunk(gen->chunk, (index >> 8) & 0xff, line);
+        writeChunk(gen->chunk, index & 0xff, line);
+    } else {
+        writeChunk(gen->chunk, op, line);
+        writeChunk(gen->chunk, (uint8_t)index, line);
+    }
 }
 
 static void emitConstant(BytecodeGen* gen, Value value, int line) {
     if (gen->hadError) return;
-    int constant = addConstant(gen->chunk, value);
-    if (constant > 255) {
+    int constant = makeConstant(gen, value);
+    if (constant > MAX_INDEX) {
         writeChunk(gen->chunk, OP_CONSTANT_LONG, line);
         writeChunk(gen->chunk, constant & 0xff, line);
         writeChunk(gen->chunk, (constant >> 8) & 0xff, line);
         writeChunk(gen->chunk, (constant >> 16) & 0xff, line);
     } else {
-        writeChunk(gen->chunk, OP_CONSTANT, line);
-        writeChunk(gen->chunk, (uint8_t)constant, line);
+        emitIndexed(gen, OP_CONSTANT, constant, line);
     }
 }
 
@@ -209,6 +581,169 @@ static void emitInt(BytecodeGen* gen, int value, int line) {
     emitByte(gen, (uint8_t)((value >> 24) & 0xff), line);
 }
 
+// Jump offsets are 16 bits, or 32 bits behind OP_WIDE once the module is
+// compiled with wideJumps.
+static int jumpOperandSize(BytecodeGen* gen) {
+    return gen->wideJumps ? 4 : 2;
+}
+
+static void writeJumpOperand(BytecodeGen* gen, int at, int offset) {
+    if (!gen->wideJumps && offset > UINT16_MAX) {
+        gen->jumpOverflow = true;
+        return;
+    }
+    uint8_t* code = gen->chunk->code + at;
+    if (gen->wideJumps) {
+        *code++ = (offset >> 24) & 0xff;
+        *code++ = (offset >> 16) & 0xff;
+    }
+    code[0] = (offset >> 8) & 0xff;
+    code[1] = offset & 0xff;
+}
+
+// Emits a forward jump with a placeholder offset; returns where to patch it.
+static int emitJump(BytecodeGen* gen, OpCode op, int line) {
+    if (gen->wideJumps) writeChunk(gen->chunk, OP_WIDE, line);
+    writeChunk(gen->chunk, op, line);
+    // The operand carries the line too: OP_FOR_ITER can fail after reading it
+    for (int i = 0; i < jumpOperandSize(gen); i++) {
+        writeChunk(gen->chunk, 0xff, line);
+    }
+    return gen->chunk->count - jumpOperandSize(gen);
+}
+
+// Points a jump emitted by emitJump at the current end of the chunk.
+static void patchJump(BytecodeGen* gen, int jump) {
+    writeJumpOperand(gen, jump, gen->chunk->count - jump - jumpOperandSize(gen));
+}
+
+static void emitLoop(BytecodeGen* gen, OpCode op, int loopStart, int line) {
+    if (gen->wideJumps) writeChunk(gen->chunk, OP_WIDE, line);
+    writeChunk(gen->chunk, op, line);
+    int at = gen->chunk->count;
+    for (int i = 0; i < jumpOperandSize(gen); i++) {
+        writeChunk(gen->chunk, 0, 0);
+    }
+    writeJumpOperand(gen, at, gen->chunk->count - loopStart);
+}
+
+// OP_CLOSURE's (or OP_STACK_CLOSURE's) function constant and capture slots
+// widen together. The function constant is followed by an (isLocal, index)
+// pair per upvalue, then one per flat capture, where isLocal means a slot
+// of the current frame and otherwise an upvalue or capture of the current
+// closure.
+static void emitClosure(BytecodeGen* gen, OpCode op, int funcConst, Compiler* funcCompiler, int line) {
+    ObjFunction* function = funcCompiler->function;
+    bool wide = funcConst > UINT8_MAX;
+    for (int i = 0; i < function->upvalueCount; i++) {
+        if (funcCompiler->upvalues[i].index > UINT8_MAX) wide = true;
+    }
+    for (int i = 0; i < function->captureCount; i++) {
+        if (funcCompiler->captures[i].index > UINT8_MAX) wide = true;
+    }
+    if (funcConst > MAX_CONSTANT_INDEX) {
+        fprintf(stderr, "Error: Too many constants in one function at line %d\n", line);
+        gen->hadError = true;
+        return;
+    }
+    if (wide) {
+        writeChunk(gen->chunk, OP_WIDE, line);
+        writeChunk(gen->chunk, op, line);
+        writeChunk(gen->chunk, (funcConst >> 16) & 0xff, line);
+        writeChunk(gen->chunk, (funcConst >> 8) & 0xff, line);
+        writeChunk(gen->chunk, funcConst & 0xff, line);
+    } else {
+        writeChunk(gen->chunk, op, line);
+        writeChunk(gen->chunk, (uint8_t)funcConst, line);
+    }
+    for (int i = 0; i < function->upvalueCount + function->captureCount; i++) {
+        Upvalue* slot = i < function->upvalueCount ? &funcCompiler->upvalues[i]
+                                                   : &funcCompiler->captures[i - function->upvalueCount];
+        writeChunk(gen->chunk, slot->isLocal ? 1 : 0, line);
+        if (wide) writeChunk(gen->chunk, (slot->index >> 8) & 0xff, line);
+        writeChunk(gen->chunk, slot->index & 0xff, line);
+    }
+}
+
+// True if 'expr' may evaluate to a closure made by OP_STACK_CLOSURE, which
+// the callee may not be allowed to keep.
+static bool mayPassStackClosure(BytecodeGen* gen, Expr* expr) {
+    if (expr == NULL) return false;
+    switch (expr->type) {
+        case EXPR_VARIABLE: {
+            int slot = resolveLocal(gen, expr->as.variable.name);
+            return slot != -1 && gen->compiler->locals[slot].holdsStackClosure;
+        }
+        case EXPR_LAMBDA:
+            return isLambdaStackEligible(expr);
+        case EXPR_GROUPING:
+            return mayPassStackClosure(gen, expr->as.grouping.expression);
+        case EXPR_LOGICAL:
+            return mayPassStackClosure(gen, expr->as.logical.left) ||
+                   mayPassStackClosure(gen, expr->as.logical.right);
+        case EXPR_TERNARY:
+            return mayPassStackClosure(gen, expr->as.ternary.true_branch) ||
+                   mayPassStackClosure(gen, expr->as.ternary.false_branch);
+        default:
+            return false;
+    }
+}
+
+static void addLoopJump(int** jumps, int* count, int* capacity, int jump) {
+    if (*count == *capacity) {
+        *capacity *= 2;
+        *jumps = (int*)realloc(*jumps, sizeof(int) * *capacity);
+    }
+    (*jumps)[(*count)++] = jump;
+}
+
+static void beginLoop(BytecodeGen* gen, Loop* loop) {
+    loop->scopeDepth = gen->compiler->scopeDepth;
+    loop->localCountAtEntry = gen->compiler->localCount;
+    loop->enclosing = gen->compiler->loop;
+    loop->breakCount = 0;
+    loop->breakCapacity = 8;
+    loop->breakJumps = (int*)malloc(sizeof(int) * loop->breakCapacity);
+    loop->continueCount = 0;
+    loop->continueCapacity = 8;
+    loop->continueJumps = (int*)malloc(sizeof(int) * loop->continueCapacity);
+    gen->compiler->loop = loop;
+}
+
+static void endLoop(BytecodeGen* gen, Loop* loop) {
+    for (int i = 0; i < loop->breakCount; i++) {
+        patchJump(gen, loop->breakJumps[i]);
+    }
+    free(loop->breakJumps);
+    free(loop->continueJumps);
+    gen->compiler->loop = loop->enclosing;
+}
+
+// Bottom-of-loop test: branches back to 'bodyStart' while 'condition'
+// holds. Relational conditions use the fused compare-and-loop opcodes.
+static void emitLoopCondition(BytecodeGen* gen, Expr* condition, int bodyStart, int line) {
+    if (condition->type == EXPR_BINARY) {
+        OpCode fused = OP_NOP;
+        switch (condition->as.binary.op) {
+            case AST_OP_LESS: fused = OP_LOOP_IF_LESS; break;
+            case AST_OP_LESS_EQUAL: fused = OP_LOOP_IF_LESS_EQUAL; break;
+            case AST_OP_GREATER: fused = OP_LOOP_IF_GREATER; break;
+            case AST_OP_GREATER_EQUAL: fused = OP_LOOP_IF_GREATER_EQUAL; break;
+            default: break;
+        }
+        // The fused opcodes embed a 16-bit OP_LOOP_IF_TRUE
+        if (fused != OP_NOP && !gen->wideJumps) {
+            genExpr(gen, condition->as.binary.left);
+            genExpr(gen, condition->as.binary.right);
+            writeChunk(gen->chunk, fused, condition->line);
+            emitLoop(gen, OP_LOOP_IF_TRUE, bodyStart, line);
+            return;
+        }
+    }
+    genExpr(gen, condition);
+    emitLoop(gen, OP_LOOP_IF_TRUE, bodyStart, line);
+}
+
 static void emitTensorElements(BytecodeGen* gen, Expr* expr) {
     if (expr->type == EXPR_LIST) {
         if (expr->as.list.elements) {
@@ -274,44 +809,40 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
         }
         case EXPR_UNARY: {
             genExpr(gen, expr->as.unary.right);
-            if (strcmp(expr->as.unary.operator, "-") == 0) {
-                 writeChunk(gen->chunk, OP_NEGATE, expr->line);
-            } else if (strcmp(expr->as.unary.operator, "!") == 0) {
-                 writeChunk(gen->chunk, OP_NOT, expr->line);
-            } else if (strcmp(expr->as.unary.operator, "~") == 0) {
-                 writeChunk(gen->chunk, OP_BIT_NOT, expr->line);
+            switch (expr->as.unary.op) {
+                case AST_OP_NEGATE: writeChunk(gen->chunk, OP_NEGATE, expr->line); break;
+                case AST_OP_NOT: writeChunk(gen->chunk, OP_NOT, expr->line); break;
+                case AST_OP_BIT_NOT: writeChunk(gen->chunk, OP_BIT_NOT, expr->line); break;
+                default: break;
             }
             break;
         }
         case EXPR_BINARY: {
             genExpr(gen, expr->as.binary.left);
             genExpr(gen, expr->as.binary.right);
-            if (strcmp(expr->as.binary.operator, "+") == 0) writeChunk(gen->chunk, OP_ADD, expr->line);
-            else if (strcmp(expr->as.binary.operator, "-") == 0) writeChunk(gen->chunk, OP_SUBTRACT, expr->line);
-            else if (strcmp(expr->as.binary.operator, "*") == 0) writeChunk(gen->chunk, OP_MULTIPLY, expr->line);
-            else if (strcmp(expr->as.binary.operator, "/") == 0) writeChunk(gen->chunk, OP_DIVIDE, expr->line);
-             else if (strcmp(expr->as.binary.operator, "==") == 0) writeChunk(gen->chunk, OP_EQUAL, expr->line);
-             else if (strcmp(expr->as.binary.operator, "!=") == 0) {
-                 writeChunk(gen->chunk, OP_EQUAL, expr->line);
-                 writeChunk(gen->chunk, OP_NOT, expr->line);
-             }
-             else if (strcmp(expr->as.binary.operator, "<") == 0) writeChunk(gen->chunk, OP_LESS, expr->line);
-             else if (strcmp(expr->as.binary.operator, "<=") == 0) {
-                 writeChunk(gen->chunk, OP_GREATER, expr->line);
-                 writeChunk(gen->chunk, OP_NOT, expr->line);
-             }
-             else if (strcmp(expr->as.binary.operator, ">") == 0) writeChunk(gen->chunk, OP_GREATER, expr->line);
-             else if (strcmp(expr->as.binary.operator, ">=") == 0) {
-                 writeChunk(gen->chunk, OP_LESS, expr->line);
-                 writeChunk(gen->chunk, OP_NOT, expr->line);
-             }
-             else if (strcmp(expr->as.binary.operator, "%") == 0) writeChunk(gen->chunk, OP_MODULO, expr->line);
-             else if (strcmp(expr->as.binary.operator, "&") == 0) writeChunk(gen->chunk, OP_BIT_AND, expr->line);
-             else if (strcmp(expr->as.binary.operator, "|") == 0) writeChunk(gen->chunk, OP_BIT_OR, expr->line);
-             else if (strcmp(expr->as.binary.operator, "^") == 0) writeChunk(gen->chunk, OP_BIT_XOR, expr->line);
-             else if (strcmp(expr->as.binary.operator, "<<") == 0) writeChunk(gen->chunk, OP_LEFT_SHIFT, expr->line);
-             else if (strcmp(expr->as.binary.operator, ">>") == 0) writeChunk(gen->chunk, OP_RIGHT_SHIFT, expr->line);
-             else if (strcmp(expr->as.binary.operator, "@") == 0) writeChunk(gen->chunk, OP_MAT_MUL, expr->line);
+            switch (expr->as.binary.op) {
+                case AST_OP_ADD: writeChunk(gen->chunk, OP_ADD, expr->line); break;
+                case AST_OP_SUBTRACT: writeChunk(gen->chunk, OP_SUBTRACT, expr->line); break;
+                case AST_OP_MULTIPLY: writeChunk(gen->chunk, OP_MULTIPLY, expr->line); break;
+                case AST_OP_DIVIDE: writeChunk(gen->chunk, OP_DIVIDE, expr->line); break;
+                case AST_OP_EQUAL: writeChunk(gen->chunk, OP_EQUAL, expr->line); break;
+                case AST_OP_NOT_EQUAL:
+                    writeChunk(gen->chunk, OP_EQUAL, expr->line);
+                    writeChunk(gen->chunk, OP_NOT, expr->line);
+                    break;
+                case AST_OP_LESS: writeChunk(gen->chunk, OP_LESS, expr->line); break;
+                case AST_OP_LESS_EQUAL: writeChunk(gen->chunk, OP_LESS_EQUAL, expr->line); break;
+                case AST_OP_GREATER: writeChunk(gen->chunk, OP_GREATER, expr->line); break;
+                case AST_OP_GREATER_EQUAL: writeChunk(gen->chunk, OP_GREATER_EQUAL, expr->line); break;
+                case AST_OP_MODULO: writeChunk(gen->chunk, OP_MODULO, expr->line); break;
+                case AST_OP_BIT_AND: writeChunk(gen->chunk, OP_BIT_AND, expr->line); break;
+                case AST_OP_BIT_OR: writeChunk(gen->chunk, OP_BIT_OR, expr->line); break;
+                case AST_OP_BIT_XOR: writeChunk(gen->chunk, OP_BIT_XOR, expr->line); break;
+                case AST_OP_LEFT_SHIFT: writeChunk(gen->chunk, OP_LEFT_SHIFT, expr->line); break;
+                case AST_OP_RIGHT_SHIFT: writeChunk(gen->chunk, OP_RIGHT_SHIFT, expr->line); break;
+                case AST_OP_MAT_MUL: writeChunk(gen->chunk, OP_MAT_MUL, expr->line); break;
+                default: break;
+            }
             break;
         }
         case EXPR_GROUPING: {
@@ -319,43 +850,40 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
             break;
         }
         case EXPR_VARIABLE: {
+            bool flat;
             int arg = resolveLocal(gen, expr->as.variable.name);
             if (arg != -1) {
                 if (arg <= 3) {
                     writeChunk(gen->chunk, OP_GET_LOCAL_0 + arg, expr->line);
                 } else {
-                    writeChunk(gen->chunk, OP_GET_LOCAL, expr->line);
-                    writeChunk(gen->chunk, (uint8_t)arg, expr->line);
+                    emitIndexed(gen, OP_GET_LOCAL, arg, expr->line);
                 }
-            } else if ((arg = resolveUpvalue(gen->compiler, expr->as.variable.name)) != -1) {
-                writeChunk(gen->chunk, OP_GET_UPVALUE, expr->line);
-                writeChunk(gen->chunk, (uint8_t)arg, expr->line);
+            } else if ((arg = resolveUpvalue(gen->compiler, expr->as.variable.name, &flat)) != -1) {
+                emitIndexed(gen, flat ? OP_GET_CAPTURE : OP_GET_UPVALUE, arg, expr->line);
             } else {
                  Value nameVal = OBJ_VAL(copyString(expr->as.variable.name, strlen(expr->as.variable.name)));
-                 int nameConst = addConstant(gen->chunk, nameVal);
-                 writeChunk(gen->chunk, OP_GET_GLOBAL, expr->line);
-                 writeChunk(gen->chunk, (uint8_t)nameConst, expr->line);
+                 int nameConst = makeConstant(gen, nameVal);
+                 emitIndexed(gen, OP_GET_GLOBAL, nameConst, expr->line);
             }
             break;
         }
         case EXPR_ASSIGN: {
+            bool flat;
             genExpr(gen, expr->as.assign.value);
             int arg = resolveLocal(gen, expr->as.assign.name);
             if (arg != -1) {
                 if (arg <= 3) {
                     writeChunk(gen->chunk, OP_SET_LOCAL_0 + arg, expr->line);
                 } else {
-                    writeChunk(gen->chunk, OP_SET_LOCAL, expr->line);
-                    writeChunk(gen->chunk, (uint8_t)arg, expr->line);
+                    emitIndexed(gen, OP_SET_LOCAL, arg, expr->line);
                 }
-            } else if ((arg = resolveUpvalue(gen->compiler, expr->as.assign.name)) != -1) {
-                writeChunk(gen->chunk, OP_SET_UPVALUE, expr->line);
-                writeChunk(gen->chunk, (uint8_t)arg, expr->line);
+            } else if ((arg = resolveUpvalue(gen->compiler, expr->as.assign.name, &flat)) != -1) {
+                // Assigned names are never flattened (see isAssigned())
+                emitIndexed(gen, OP_SET_UPVALUE, arg, expr->line);
             } else {
                 Value nameVal = OBJ_VAL(copyString(expr->as.assign.name, strlen(expr->as.assign.name)));
-                int nameConst = addConstant(gen->chunk, nameVal);
-                writeChunk(gen->chunk, OP_SET_GLOBAL, expr->line);
-                writeChunk(gen->chunk, (uint8_t)nameConst, expr->line);
+                int nameConst = makeConstant(gen, nameVal);
+                emitIndexed(gen, OP_SET_GLOBAL, nameConst, expr->line);
             }
             break;
         }
@@ -364,8 +892,14 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
             int argCount = 0;
             if (expr->as.call.arguments) {
                 argCount = expr->as.call.arguments->count;
+                bool guard = false;
                 for (int i = 0; i < argCount; i++) {
                     genExpr(gen, expr->as.call.arguments->items[i]);
+                    if (mayPassStackClosure(gen, expr->as.call.arguments->items[i])) guard = true;
+                }
+                if (guard) {
+                    writeChunk(gen->chunk, OP_GUARD_ARGS, expr->line);
+                    writeChunk(gen->chunk, (uint8_t)argCount, expr->line);
                 }
             }
             writeChunk(gen->chunk, OP_CALL, expr->line);
@@ -387,41 +921,29 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
             int endJump = -1;
             int opJump = -1;
             
-            if (strcmp(expr->as.logical.operator, "&&") == 0) {
-                 writeChunk(gen->chunk, OP_JUMP_IF_FALSE, expr->line);
-                 writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                 endJump = gen->chunk->count - 2;
+            if (expr->as.logical.op == AST_OP_AND) {
+                 endJump = emitJump(gen, OP_JUMP_IF_FALSE, expr->line);
                  writeChunk(gen->chunk, OP_POP, expr->line);
                  genExpr(gen, expr->as.logical.right);
-            } else { // "||"
-                 writeChunk(gen->chunk, OP_JUMP_IF_FALSE, expr->line);
-                 writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                 opJump = gen->chunk->count - 2;
-                 
-                 writeChunk(gen->chunk, OP_JUMP, expr->line);
-                 writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                 endJump = gen->chunk->count - 2;
-                 
+            } else { // AST_OP_OR
+                 opJump = emitJump(gen, OP_JUMP_IF_FALSE, expr->line);
+                 endJump = emitJump(gen, OP_JUMP, expr->line);
+
                  // Patch opJump to here (false case)
-                 int patchOp = gen->chunk->count - opJump - 2;
-                 gen->chunk->code[opJump] = (patchOp >> 8) & 0xff;
-                 gen->chunk->code[opJump+1] = patchOp & 0xff;
-                 
+                 patchJump(gen, opJump);
+
                  writeChunk(gen->chunk, OP_POP, expr->line);
                  genExpr(gen, expr->as.logical.right);
             }
-            
-            int patchEnd = gen->chunk->count - endJump - 2;
-            gen->chunk->code[endJump] = (patchEnd >> 8) & 0xff;
-            gen->chunk->code[endJump+1] = patchEnd & 0xff;
+
+            patchJump(gen, endJump);
             break;
         }
         case EXPR_GET: {
             genExpr(gen, expr->as.get.object);
             Value nameVal = OBJ_VAL(copyString(expr->as.get.name, strlen(expr->as.get.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_GET_PROPERTY, expr->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, expr->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_GET_PROPERTY, nameConst, expr->line);
             break;
         }
         case EXPR_SET: {
@@ -431,9 +953,8 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
             // vm.c: peek(1) is instance, peek(0) is value.
             // Correct.
             Value nameVal = OBJ_VAL(copyString(expr->as.set.name, strlen(expr->as.set.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_SET_PROPERTY, expr->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, expr->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_SET_PROPERTY, nameConst, expr->line);
             break;
         }
         case EXPR_INDEX: {
@@ -478,8 +999,7 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
              }
              
              // Opcode to build list
-             writeChunk(gen->chunk, OP_BUILD_LIST, expr->line);
-             emitByte(gen, (uint8_t)count, expr->line); // Arg: number of elements
+             emitIndexed(gen, OP_BUILD_LIST, count, expr->line); // Arg: number of elements
              break;
         }
         case EXPR_DICTIONARY: {
@@ -491,32 +1011,19 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
                      genExpr(gen, expr->as.dictionary.pairs->items[i].value);
                  }
              }
-             writeChunk(gen->chunk, OP_BUILD_MAP, expr->line);
-             writeChunk(gen->chunk, (uint8_t)count, expr->line);
+             emitIndexed(gen, OP_BUILD_MAP, count, expr->line);
              break;
         }
         case EXPR_TERNARY: {
              genExpr(gen, expr->as.ternary.condition);
-             writeChunk(gen->chunk, OP_JUMP_IF_FALSE, expr->line);
-             writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-             int elseJump = gen->chunk->count - 2;
-             writeChunk(gen->chunk, OP_POP, expr->line);
+             int elseJump = emitJump(gen, OP_JUMP_IF_FALSE_POP, expr->line);
              
              genExpr(gen, expr->as.ternary.true_branch);
-             writeChunk(gen->chunk, OP_JUMP, expr->line);
-             writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-             int endJump = gen->chunk->count - 2;
-             
-             int patchElse = gen->chunk->count - elseJump - 2;
-             gen->chunk->code[elseJump] = (patchElse >> 8) & 0xff;
-             gen->chunk->code[elseJump+1] = patchElse & 0xff;
-             writeChunk(gen->chunk, OP_POP, expr->line);
+             int endJump = emitJump(gen, OP_JUMP, expr->line);
              
+             patchJump(gen, elseJump);
              genExpr(gen, expr->as.ternary.false_branch);
-             
-             int patchEnd = gen->chunk->count - endJump - 2;
-             gen->chunk->code[endJump] = (patchEnd >> 8) & 0xff;
-             gen->chunk->code[endJump+1] = patchEnd & 0xff;
+             patchJump(gen, endJump);
              break;
         }
         case EXPR_UNWRAP: {
@@ -541,11 +1048,16 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
         case EXPR_LAMBDA: {
             Compiler funcCompiler;
             initCompiler(gen, &funcCompiler, COMP_FUNCTION);
+            scanAssignsStmts(&funcCompiler, expr->as.lambda.body);
             beginScope(gen);
             if (expr->as.lambda.params) {
                 for (int i=0; i < expr->as.lambda.params->count; i++) {
                     funcCompiler.function->arity++;
                     addLocal(gen, expr->as.lambda.params->items[i]);
+                    uint32_t bit = 1u << (i < 31 ? i : 31);
+                    if (gen->compiler->localCount > 0 && !(expr->as.lambda.retainedParams & bit)) {
+                        gen->compiler->locals[gen->compiler->localCount - 1].holdsStackClosure = true;
+                    }
                 }
             }
             if (expr->as.lambda.body) {
@@ -555,13 +1067,11 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
             }
             ObjFunction* function = endCompiler(gen, false);
             Value funcVal = OBJ_VAL(function);
-            int funcConst = addConstant(gen->chunk, funcVal);
-            writeChunk(gen->chunk, OP_CLOSURE, expr->line);
-            writeChunk(gen->chunk, (uint8_t)funcConst, expr->line);
-            for (int i = 0; i < function->upvalueCount; i++) {
-                writeChunk(gen->chunk, funcCompiler.upvalues[i].isLocal ? 1 : 0, expr->line);
-                writeChunk(gen->chunk, funcCompiler.upvalues[i].index, expr->line);
-            }
+            int funcConst = makeConstant(gen, funcVal);
+            funcCompiler.function->retainedParams = expr->as.lambda.retainedParams;
+            emitClosure(gen, isLambdaStackEligible(expr) ? OP_STACK_CLOSURE : OP_CLOSURE,
+                        funcConst, &funcCompiler, expr->line);
+            freeCompiler(&funcCompiler);
             break;
         }
         case EXPR_THIS: {
@@ -579,9 +1089,8 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
                  writeChunk(gen->chunk, OP_GET_LOCAL, expr->line);
                  writeChunk(gen->chunk, 0, expr->line);
                  Value nameVal = OBJ_VAL(copyString(expr->as.super_expr.method, strlen(expr->as.super_expr.method)));
-                 int nameConst = addConstant(gen->chunk, nameVal);
-                 writeChunk(gen->chunk, OP_GET_SUPER, expr->line);
-                 writeChunk(gen->chunk, (uint8_t)nameConst, expr->line);
+                 int nameConst = makeConstant(gen, nameVal);
+                 emitIndexed(gen, OP_GET_SUPER, nameConst, expr->line);
              } else {
                  fprintf(stderr, "Cannot use 'super' outside of a method.\n");
                  gen->hadError = true;
@@ -609,9 +1118,8 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
          }
          case EXPR_COMPTIME: {
              Value result = evaluateComptime(expr->as.comptime_expr.body);
-             int constIdx = addConstant(gen->chunk, result);
-             writeChunk(gen->chunk, OP_CONSTANT, expr->line);
-             writeChunk(gen->chunk, (uint8_t)constIdx, expr->line);
+             int constIdx = makeConstant(gen, result);
+             emitIndexed(gen, OP_CONSTANT, constIdx, expr->line);
              break;
          }
          case EXPR_ACTOR_SEND:
@@ -626,6 +1134,7 @@ static void genExpr(BytecodeGen* gen, Expr* expr) {
 static void genFunction(BytecodeGen* gen, Stmt* stmt, bool defineVar) {
     Compiler funcCompiler;
     initCompiler(gen, &funcCompiler, COMP_FUNCTION);
+    scanAssignsStmts(&funcCompiler, stmt->as.func_decl.body);
     
     // Set function properties from AST
     funcCompiler.function->access = stmt->as.func_decl.access;
@@ -652,6 +1161,12 @@ static void genFunction(BytecodeGen* gen, Stmt* stmt, bool defineVar) {
                  // Error
              }
              addLocal(gen, params->items[i]);
+             // Callers only pass stack closures for parameters the body
+             // does not retain (see OP_GUARD_ARGS)
+             uint32_t bit = 1u << (i < 31 ? i : 31);
+             if (gen->compiler->localCount > 0 && !(stmt->as.func_decl.retainedParams & bit)) {
+                 gen->compiler->locals[gen->compiler->localCount - 1].holdsStackClosure = true;
+             }
          }
     }
 
@@ -667,22 +1182,22 @@ static void genFunction(BytecodeGen* gen, Stmt* stmt, bool defineVar) {
     
     // Emit Closure
     Value funcVal = OBJ_VAL(function);
-    int funcConst = addConstant(gen->chunk, funcVal);
-    writeChunk(gen->chunk, OP_CLOSURE, stmt->line);
-    writeChunk(gen->chunk, (uint8_t)funcConst, stmt->line);
-    for (int i = 0; i < function->upvalueCount; i++) {
-        writeChunk(gen->chunk, funcCompiler.upvalues[i].isLocal ? 1 : 0, stmt->line);
-        writeChunk(gen->chunk, funcCompiler.upvalues[i].index, stmt->line);
-    }
+    int funcConst = makeConstant(gen, funcVal);
+    function->retainedParams = stmt->as.func_decl.retainedParams;
+    bool onStack = defineVar && gen->compiler->scopeDepth > 0 && isClosureStackEligible(stmt);
+    emitClosure(gen, onStack ? OP_STACK_CLOSURE : OP_CLOSURE, funcConst, &funcCompiler, stmt->line);
+    freeCompiler(&funcCompiler);
     
     if (defineVar) {
         if (gen->compiler->scopeDepth > 0) {
             addLocal(gen, stmt->as.func_decl.name); 
+            if (onStack && gen->compiler->localCount > 0) {
+                gen->compiler->locals[gen->compiler->localCount - 1].holdsStackClosure = true;
+            }
         } else {
             Value nameVal = OBJ_VAL(copyString(stmt->as.func_decl.name, strlen(stmt->as.func_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
         }
     }
 }
@@ -718,9 +1233,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                 addLocal(gen, stmt->as.var_decl.name);
             } else {
                 Value nameVal = OBJ_VAL(copyString(stmt->as.var_decl.name, strlen(stmt->as.var_decl.name)));
-                int nameConst = addConstant(gen->chunk, nameVal);
-                writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                int nameConst = makeConstant(gen, nameVal);
+                emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             break;
         }
@@ -752,15 +1266,13 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
         case STMT_EXTERN_DECL: {
             // Push library path
             Value libVal = OBJ_VAL(copyString(stmt->as.extern_decl.libraryPath, strlen(stmt->as.extern_decl.libraryPath)));
-            int libConst = addConstant(gen->chunk, libVal);
-            writeChunk(gen->chunk, OP_CONSTANT, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)libConst, stmt->line);
+            int libConst = makeConstant(gen, libVal);
+            emitIndexed(gen, OP_CONSTANT, libConst, stmt->line);
             
             // Push symbol name
             Value symVal = OBJ_VAL(copyString(stmt->as.extern_decl.symbolName, strlen(stmt->as.extern_decl.symbolName)));
-            int symConst = addConstant(gen->chunk, symVal);
-            writeChunk(gen->chunk, OP_CONSTANT, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)symConst, stmt->line);
+            int symConst = makeConstant(gen, symVal);
+            emitIndexed(gen, OP_CONSTANT, symConst, stmt->line);
             
             // Make Foreign Object
             writeChunk(gen->chunk, OP_MAKE_FOREIGN, stmt->line);
@@ -770,9 +1282,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                 addLocal(gen, stmt->as.extern_decl.name);
             } else {
                 Value nameVal = OBJ_VAL(copyString(stmt->as.extern_decl.name, strlen(stmt->as.extern_decl.name)));
-                int nameConst = addConstant(gen->chunk, nameVal);
-                writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                int nameConst = makeConstant(gen, nameVal);
+                emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             break;
         }
@@ -794,160 +1305,124 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                 addLocal(gen, stmt->as.tensor_decl.name);
             } else {
                 Value nameVal = OBJ_VAL(copyString(stmt->as.tensor_decl.name, strlen(stmt->as.tensor_decl.name)));
-                int nameConst = addConstant(gen->chunk, nameVal);
-                writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                int nameConst = makeConstant(gen, nameVal);
+                emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             break;
         }
         case STMT_IF: {
             genExpr(gen, stmt->as.if_stmt.condition);
-            writeChunk(gen->chunk, OP_JUMP_IF_FALSE, stmt->line);
-            writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-            int thenJump = gen->chunk->count - 2;
-            writeChunk(gen->chunk, OP_POP, stmt->line);
+            int thenJump = emitJump(gen, OP_JUMP_IF_FALSE_POP, stmt->line);
             
             genStmt(gen, stmt->as.if_stmt.then_branch);
             
-            writeChunk(gen->chunk, OP_JUMP, 0);
-            writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-            int elseJump = gen->chunk->count - 2;
-            
-            int patchThen = gen->chunk->count - thenJump - 2;
-            gen->chunk->code[thenJump] = (patchThen >> 8) & 0xff;
-            gen->chunk->code[thenJump+1] = patchThen & 0xff;
-            
-            writeChunk(gen->chunk, OP_POP, stmt->line);
-            if (stmt->as.if_stmt.else_branch) genStmt(gen, stmt->as.if_stmt.else_branch);
-            
-            int patchElse = gen->chunk->count - elseJump - 2;
-            gen->chunk->code[elseJump] = (patchElse >> 8) & 0xff;
-            gen->chunk->code[elseJump+1] = patchElse & 0xff;
+            if (stmt->as.if_stmt.else_branch) {
+                int elseJump = emitJump(gen, OP_JUMP, 0);
+                patchJump(gen, thenJump);
+                genStmt(gen, stmt->as.if_stmt.else_branch);
+                patchJump(gen, elseJump);
+            } else {
+                patchJump(gen, thenJump);
+            }
             break;
         }
         case STMT_WHILE: {
-            int loopStart = gen->chunk->count;
-            
-            // Push loop scope
-            Loop loop;
-            loop.startIp = loopStart;
-            loop.continueIp = loopStart;
-            loop.scopeDepth = gen->compiler->scopeDepth;
-            loop.localCountAtEntry = gen->compiler->localCount;
-            loop.enclosing = gen->compiler->loop;
-            loop.breakCount = 0;
-            loop.breakCapacity = 8;
-            loop.breakJumps = (int*)malloc(sizeof(int) * loop.breakCapacity);
-            gen->compiler->loop = &loop;
-            
+            // Rotated: the condition is tested once on entry and then at the
+            // bottom, so each iteration takes a single backward branch.
+            //
+            //         cond; JUMP_IF_FALSE_POP exit
+            //   body: ...
+            //   cont: cond; LOOP_IF_TRUE body
+            //   exit:
             genExpr(gen, stmt->as.while_stmt.condition);
+            int exitJump = emitJump(gen, OP_JUMP_IF_FALSE_POP, stmt->line);
             
-            writeChunk(gen->chunk, OP_JUMP_IF_FALSE, stmt->line);
-            writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-            int exitJump = gen->chunk->count - 2;
-            writeChunk(gen->chunk, OP_POP, stmt->line);
-            
+            Loop loop;
+            beginLoop(gen, &loop);
+            int bodyStart = gen->chunk->count;
             genStmt(gen, stmt->as.while_stmt.body);
             
-            writeChunk(gen->chunk, OP_LOOP, stmt->line);
-            int offset = gen->chunk->count - loopStart + 2;
-            writeChunk(gen->chunk, (offset >> 8) & 0xff, 0);
-            writeChunk(gen->chunk, offset & 0xff, 0);
-            
-            // Patch exit
-            int patchExit = gen->chunk->count - exitJump - 2;
-            gen->chunk->code[exitJump] = (patchExit >> 8) & 0xff;
-            gen->chunk->code[exitJump+1] = patchExit & 0xff;
-            
-            writeChunk(gen->chunk, OP_POP, stmt->line);
-            
-            // Patch breaks
-            for (int i = 0; i < loop.breakCount; i++) {
-                int breakJump = loop.breakJumps[i];
-                int dist = gen->chunk->count - breakJump - 2;
-                gen->chunk->code[breakJump] = (dist >> 8) & 0xff;
-                gen->chunk->code[breakJump+1] = dist & 0xff;
+            for (int i = 0; i < loop.continueCount; i++) {
+                patchJump(gen, loop.continueJumps[i]);
             }
-            free(loop.breakJumps);
+            emitLoopCondition(gen, stmt->as.while_stmt.condition, bodyStart, stmt->line);
             
-            gen->compiler->loop = loop.enclosing; // Pop loop
+            patchJump(gen, exitJump);
+            endLoop(gen, &loop);
             break;
         }
         case STMT_FOR: {
+            // Rotated like STMT_WHILE, with the increment ahead of the
+            // bottom test:
+            //
+            //         init; [cond; JUMP_IF_FALSE_POP exit]
+            //   body: ...
+            //   cont: [increment; POP]
+            //         cond; LOOP_IF_TRUE body   (or LOOP body without a cond)
+            //   exit:
             beginScope(gen);
             if (stmt->as.for_stmt.initializer) {
                 genStmt(gen, stmt->as.for_stmt.initializer);
             }
             
-            int loopStart = gen->chunk->count;
-            
             int exitJump = -1;
             if (stmt->as.for_stmt.condition) {
                 genExpr(gen, stmt->as.for_stmt.condition);
-                writeChunk(gen->chunk, OP_JUMP_IF_FALSE, stmt->line);
-                writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                exitJump = gen->chunk->count - 2;
-                writeChunk(gen->chunk, OP_POP, stmt->line); // Pop condition
-            }
-
-            int incrementStart = loopStart;
-            if (stmt->as.for_stmt.increment) {
-                writeChunk(gen->chunk, OP_JUMP, 0);
-                writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                int bodyJump = gen->chunk->count - 2;
-                
-                incrementStart = gen->chunk->count;
-                genExpr(gen, stmt->as.for_stmt.increment);
-                writeChunk(gen->chunk, OP_POP, stmt->line);
-                
-                writeChunk(gen->chunk, OP_LOOP, stmt->line);
-                int offset = gen->chunk->count - loopStart + 2;
-                writeChunk(gen->chunk, (offset >> 8) & 0xff, 0);
-                writeChunk(gen->chunk, offset & 0xff, 0);
-                
-                loopStart = incrementStart;
-                
-                int patchBody = gen->chunk->count - bodyJump - 2;
-                gen->chunk->code[bodyJump] = (patchBody >> 8) & 0xff;
-                gen->chunk->code[bodyJump+1] = patchBody & 0xff;
+                exitJump = emitJump(gen, OP_JUMP_IF_FALSE_POP, stmt->line);
             }
             
-            // Push loop
             Loop loop;
-            loop.startIp = loopStart;
-            loop.continueIp = incrementStart;
-            loop.scopeDepth = gen->compiler->scopeDepth;
-            loop.localCountAtEntry = gen->compiler->localCount;
-            loop.enclosing = gen->compiler->loop;
-            loop.breakCount = 0;
-            loop.breakCapacity = 8;
-            loop.breakJumps = (int*)malloc(sizeof(int) * loop.breakCapacity);
-            gen->compiler->loop = &loop;
-
+            beginLoop(gen, &loop);
+            int bodyStart = gen->chunk->count;
             genStmt(gen, stmt->as.for_stmt.body);
             
-            writeChunk(gen->chunk, OP_LOOP, stmt->line);
-            int offset = gen->chunk->count - loopStart + 2;
-            writeChunk(gen->chunk, (offset >> 8) & 0xff, 0);
-            writeChunk(gen->chunk, offset & 0xff, 0);
-            
-            if (exitJump != -1) {
-                int patchExit = gen->chunk->count - exitJump - 2;
-                gen->chunk->code[exitJump] = (patchExit >> 8) & 0xff;
-                gen->chunk->code[exitJump+1] = patchExit & 0xff;
+            for (int i = 0; i < loop.continueCount; i++) {
+                patchJump(gen, loop.continueJumps[i]);
+            }
+            if (stmt->as.for_stmt.increment) {
+                genExpr(gen, stmt->as.for_stmt.increment);
                 writeChunk(gen->chunk, OP_POP, stmt->line);
             }
-            
-            // Patch breaks
-            for (int i = 0; i < loop.breakCount; i++) {
-                int breakJump = loop.breakJumps[i];
-                int dist = gen->chunk->count - breakJump - 2;
-                gen->chunk->code[breakJump] = (dist >> 8) & 0xff;
-                gen->chunk->code[breakJump+1] = dist & 0xff;
+            if (stmt->as.for_stmt.condition) {
+                emitLoopCondition(gen, stmt->as.for_stmt.condition, bodyStart, stmt->line);
+                patchJump(gen, exitJump);
+            } else {
+                emitLoop(gen, OP_LOOP, bodyStart, stmt->line);
             }
-            free(loop.breakJumps);
             
-            gen->compiler->loop = loop.enclosing;
+            endLoop(gen, &loop);
+            endScope(gen);
+            break;
+        }
+        case STMT_FOR_IN: {
+            // The iterator and the loop variable are hidden locals, so they
+            // are the top two slots whenever the head runs:
+            //
+            //         iterable; ITER; NIL
+            //   head: FOR_ITER exit     (next item into the variable)
+            //         body
+            //   cont: LOOP head
+            //   exit:
+            beginScope(gen);
+            genExpr(gen, stmt->as.for_in.iterable);
+            writeChunk(gen->chunk, OP_ITER, stmt->line);
+            addLocal(gen, "(iterator)");
+            writeChunk(gen->chunk, OP_NIL, stmt->line);
+            addLocal(gen, stmt->as.for_in.name);
+
+            Loop loop;
+            beginLoop(gen, &loop);
+            int head = gen->chunk->count;
+            int exitJump = emitJump(gen, OP_FOR_ITER, stmt->line);
+            genStmt(gen, stmt->as.for_in.body);
+
+            for (int i = 0; i < loop.continueCount; i++) {
+                patchJump(gen, loop.continueJumps[i]);
+            }
+            emitLoop(gen, OP_LOOP, head, stmt->line);
+            patchJump(gen, exitJump);
+
+            endLoop(gen, &loop);
             endScope(gen);
             break;
         }
@@ -957,17 +1432,12 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                gen->hadError = true;
             } else {
                 for (int i = gen->compiler->localCount - 1; i >= gen->compiler->loop->localCountAtEntry; i--) {
-                    writeChunk(gen->chunk, OP_POP, stmt->line);
+                    emitPopLocal(gen, &gen->compiler->locals[i], stmt->line);
                 }
                 
-                writeChunk(gen->chunk, OP_JUMP, 0);
-                writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                int jump = gen->chunk->count - 2;
-                if (gen->compiler->loop->breakCount == gen->compiler->loop->breakCapacity) {
-                    gen->compiler->loop->breakCapacity *= 2;
-                    gen->compiler->loop->breakJumps = (int*)realloc(gen->compiler->loop->breakJumps, sizeof(int) * gen->compiler->loop->breakCapacity);
-                }
-                gen->compiler->loop->breakJumps[gen->compiler->loop->breakCount++] = jump;
+                Loop* loop = gen->compiler->loop;
+                int jump = emitJump(gen, OP_JUMP, 0);
+                addLoopJump(&loop->breakJumps, &loop->breakCount, &loop->breakCapacity, jump);
             }
             break;
         }
@@ -977,12 +1447,11 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                gen->hadError = true;
             } else {
                 for (int i = gen->compiler->localCount - 1; i >= gen->compiler->loop->localCountAtEntry; i--) {
-                    writeChunk(gen->chunk, OP_POP, stmt->line);
+                    emitPopLocal(gen, &gen->compiler->locals[i], stmt->line);
                 }
-                writeChunk(gen->chunk, OP_LOOP, stmt->line);
-                int offset = gen->chunk->count - gen->compiler->loop->continueIp + 2;
-                writeChunk(gen->chunk, (offset >> 8) & 0xff, 0);
-                writeChunk(gen->chunk, offset & 0xff, 0);
+                Loop* loop = gen->compiler->loop;
+                int jump = emitJump(gen, OP_JUMP, 0);
+                addLoopJump(&loop->continueJumps, &loop->continueCount, &loop->continueCapacity, jump);
             }
             break;
         }
@@ -990,7 +1459,7 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             genExpr(gen, stmt->as.switch_stmt.value); // Push switch value
             
             SwitchCaseList* cases = stmt->as.switch_stmt.cases;
-            int endJumps[256];
+            int* endJumps = (int*)malloc(sizeof(int) * (cases ? cases->count + 1 : 1));
             int endJumpCount = 0;
             
             if (cases) {
@@ -999,11 +1468,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                     genExpr(gen, cases->items[i].value);
                     writeChunk(gen->chunk, OP_EQUAL, stmt->line);
                     
-                    writeChunk(gen->chunk, OP_JUMP_IF_FALSE, stmt->line);
-                    writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                    int nextJump = gen->chunk->count - 2;
+                    int nextJump = emitJump(gen, OP_JUMP_IF_FALSE_POP, stmt->line);
                     
-                    writeChunk(gen->chunk, OP_POP, stmt->line); // Pop bool
                     writeChunk(gen->chunk, OP_POP, stmt->line); // Pop switch value
                     
                     // Case body
@@ -1013,15 +1479,9 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                         }
                     }
                     
-                    writeChunk(gen->chunk, OP_JUMP, stmt->line);
-                    writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-                    endJumps[endJumpCount++] = gen->chunk->count - 2;
+                    endJumps[endJumpCount++] = emitJump(gen, OP_JUMP, stmt->line);
                     
-                    // Patch nextJump
-                    int patchNext = gen->chunk->count - nextJump - 2;
-                    gen->chunk->code[nextJump] = (patchNext >> 8) & 0xff;
-                    gen->chunk->code[nextJump+1] = patchNext & 0xff;
-                    writeChunk(gen->chunk, OP_POP, stmt->line); // Pop bool (from jump_if_false)
+                    patchJump(gen, nextJump);
                 }
             }
             
@@ -1035,10 +1495,9 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             
             // Patch end jumps
             for (int i=0; i < endJumpCount; i++) {
-                int patch = gen->chunk->count - endJumps[i] - 2;
-                gen->chunk->code[endJumps[i]] = (patch >> 8) & 0xff;
-                gen->chunk->code[endJumps[i]+1] = patch & 0xff;
+                patchJump(gen, endJumps[i]);
             }
+            free(endJumps);
             break;
         }
         case STMT_RESILIENT: {
@@ -1055,9 +1514,7 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             
             endScope(gen);
             
-            writeChunk(gen->chunk, OP_JUMP, stmt->line);
-            writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-            int skipRecoveryJump = gen->chunk->count - 2;
+            int skipRecoveryJump = emitJump(gen, OP_JUMP, stmt->line);
 
             int endIp = gen->chunk->count;
             int handlerIp = gen->chunk->count;
@@ -1070,17 +1527,13 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             }
             endScope(gen);
             
-            int patchSkip = gen->chunk->count - skipRecoveryJump - 2;
-            gen->chunk->code[skipRecoveryJump] = (patchSkip >> 8) & 0xff;
-            gen->chunk->code[skipRecoveryJump+1] = patchSkip & 0xff;
+            patchJump(gen, skipRecoveryJump);
 
             addExceptionHandler(gen->chunk, startIp, endIp, handlerIp);
             break;
         }
         case STMT_TRY_CATCH: {
-            writeChunk(gen->chunk, OP_TRY, stmt->line);
-            writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-            int catchJump = gen->chunk->count - 2;
+            int catchJump = emitJump(gen, OP_TRY, stmt->line);
             
             if (stmt->as.try_catch.try_block) {
                 for (int i=0; i < stmt->as.try_catch.try_block->count; i++) {
@@ -1089,13 +1542,9 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             }
             writeChunk(gen->chunk, OP_END_TRY, stmt->line);
             
-            writeChunk(gen->chunk, OP_JUMP, stmt->line);
-            writeChunk(gen->chunk, 0xff, 0); writeChunk(gen->chunk, 0xff, 0);
-            int endJump = gen->chunk->count - 2;
-            
-            int patchCatch = gen->chunk->count - catchJump - 2;
-            gen->chunk->code[catchJump] = (patchCatch >> 8) & 0xff;
-            gen->chunk->code[catchJump+1] = patchCatch & 0xff;
+            int endJump = emitJump(gen, OP_JUMP, stmt->line);
+
+            patchJump(gen, catchJump);
             
             writeChunk(gen->chunk, OP_CATCH, stmt->line);
             beginScope(gen);
@@ -1108,11 +1557,9 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                 }
             }
             endScope(gen);
-            
-            int patchEnd = gen->chunk->count - endJump - 2;
-            gen->chunk->code[endJump] = (patchEnd >> 8) & 0xff;
-            gen->chunk->code[endJump+1] = patchEnd & 0xff;
-            break; 
+
+            patchJump(gen, endJump);
+            break;  
         }
         case STMT_USE_DECL: {
              // as.use_decl.modules (StringList)
@@ -1120,36 +1567,34 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                  for (int i=0; i < stmt->as.use_decl.modules->count; i++) {
                      char* mod = stmt->as.use_decl.modules->items[i];
                      Value modVal = OBJ_VAL(copyString(mod, strlen(mod)));
-                     int modConst = addConstant(gen->chunk, modVal);
-                     writeChunk(gen->chunk, OP_USE, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)modConst, stmt->line);
+                     int modConst = makeConstant(gen, modVal);
+                     emitIndexed(gen, OP_USE, modConst, stmt->line);
+                     // OP_USE leaves the module behind; left there it
+                     // would shift every local slot declared after it
+                     writeChunk(gen->chunk, OP_POP, stmt->line);
                  }
              }
              break;
         }
         case STMT_CLASS_DECL: {
             Value nameVal = OBJ_VAL(copyString(stmt->as.class_decl.name, strlen(stmt->as.class_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_CLASS, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_CLASS, nameConst, stmt->line);
             
             // Define name
             if (gen->compiler->scopeDepth > 0) {
                  addLocal(gen, stmt->as.class_decl.name);
             } else {
-                 writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                 writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                 emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             
             // Inheritance (Placeholder: emit push null superclass if none?)
             if (stmt->as.class_decl.superclass) {
                 genExpr(gen, stmt->as.class_decl.superclass);
                 if (gen->compiler->scopeDepth > 0) {
-                     writeChunk(gen->chunk, OP_GET_LOCAL, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)(gen->compiler->localCount - 1), stmt->line);
+                     emitIndexed(gen, OP_GET_LOCAL, gen->compiler->localCount - 1, stmt->line);
                 } else {
-                    writeChunk(gen->chunk, OP_GET_GLOBAL, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                    emitIndexed(gen, OP_GET_GLOBAL, nameConst, stmt->line);
                 }
                 writeChunk(gen->chunk, OP_INHERIT, stmt->line);
             }
@@ -1158,11 +1603,9 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             if (stmt->as.class_decl.methods) {
                 // Load class for methods
                 if (gen->compiler->scopeDepth == 0) {
-                     writeChunk(gen->chunk, OP_GET_GLOBAL, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                     emitIndexed(gen, OP_GET_GLOBAL, nameConst, stmt->line);
                 } else {
-                     writeChunk(gen->chunk, OP_GET_LOCAL, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)(gen->compiler->localCount - 1), stmt->line);
+                     emitIndexed(gen, OP_GET_LOCAL, gen->compiler->localCount - 1, stmt->line);
                 }
                 
                 for (int i=0; i < stmt->as.class_decl.methods->count; i++) {
@@ -1171,9 +1614,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                      
                      Stmt* methodStmt = stmt->as.class_decl.methods->items[i];
                      Value mNameVal = OBJ_VAL(copyString(methodStmt->as.func_decl.name, strlen(methodStmt->as.func_decl.name)));
-                     int mNameConst = addConstant(gen->chunk, mNameVal);
-                     writeChunk(gen->chunk, OP_METHOD, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)mNameConst, stmt->line);
+                     int mNameConst = makeConstant(gen, mNameVal);
+                     emitIndexed(gen, OP_METHOD, mNameConst, stmt->line);
                 }
                 writeChunk(gen->chunk, OP_POP, stmt->line); // Pop class
             }
@@ -1181,42 +1623,36 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
         }
         case STMT_INTERFACE_DECL: {
             Value nameVal = OBJ_VAL(copyString(stmt->as.interface_decl.name, strlen(stmt->as.interface_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_INTERFACE, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_INTERFACE, nameConst, stmt->line);
             
              // Define
             if (gen->compiler->scopeDepth > 0) {
                  addLocal(gen, stmt->as.interface_decl.name);
             } else {
-                 writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                 writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                 emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             break;
         }
         case STMT_TRAIT_DECL: {
             Value nameVal = OBJ_VAL(copyString(stmt->as.trait_decl.name, strlen(stmt->as.trait_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_TRAIT, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_TRAIT, nameConst, stmt->line);
             
              // Define
             if (gen->compiler->scopeDepth > 0) {
                  addLocal(gen, stmt->as.trait_decl.name);
             } else {
-                 writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                 writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                 emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             
             // Methods
             if (stmt->as.trait_decl.methods) {
                 // Load trait for methods
                 if (gen->compiler->scopeDepth == 0) {
-                     writeChunk(gen->chunk, OP_GET_GLOBAL, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                     emitIndexed(gen, OP_GET_GLOBAL, nameConst, stmt->line);
                 } else {
-                     writeChunk(gen->chunk, OP_GET_LOCAL, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)(gen->compiler->localCount - 1), stmt->line);
+                     emitIndexed(gen, OP_GET_LOCAL, gen->compiler->localCount - 1, stmt->line);
                 }
                 
                 for (int i=0; i < stmt->as.trait_decl.methods->count; i++) {
@@ -1225,9 +1661,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                      
                      Stmt* methodStmt = stmt->as.trait_decl.methods->items[i];
                      Value mNameVal = OBJ_VAL(copyString(methodStmt->as.func_decl.name, strlen(methodStmt->as.func_decl.name)));
-                     int mNameConst = addConstant(gen->chunk, mNameVal);
-                     writeChunk(gen->chunk, OP_METHOD, stmt->line);
-                     writeChunk(gen->chunk, (uint8_t)mNameConst, stmt->line);
+                     int mNameConst = makeConstant(gen, mNameVal);
+                     emitIndexed(gen, OP_METHOD, mNameConst, stmt->line);
                 }
                 writeChunk(gen->chunk, OP_POP, stmt->line); // Pop trait
             }
@@ -1235,9 +1670,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
         }
         case STMT_CONTEXT_DECL: {
             Value nameVal = OBJ_VAL(copyString(stmt->as.context_decl.name, strlen(stmt->as.context_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_CONTEXT, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_CONTEXT, nameConst, stmt->line);
             
             // Generate layers
             StmtList* layers = stmt->as.context_decl.layers;
@@ -1251,16 +1685,14 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             if (gen->compiler->scopeDepth > 0) {
                 addLocal(gen, stmt->as.context_decl.name);
             } else {
-                writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             break;
         }
         case STMT_LAYER_DECL: {
             Value nameVal = OBJ_VAL(copyString(stmt->as.layer_decl.name, strlen(stmt->as.layer_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_LAYER, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_LAYER, nameConst, stmt->line);
             
             // Generate methods
             StmtList* methods = stmt->as.layer_decl.methods;
@@ -1269,9 +1701,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
                     genFunction(gen, methods->items[i], false);
                     Stmt* methodStmt = methods->items[i];
                     Value mNameVal = OBJ_VAL(copyString(methodStmt->as.func_decl.name, strlen(methodStmt->as.func_decl.name)));
-                    int mNameConst = addConstant(gen->chunk, mNameVal);
-                    writeChunk(gen->chunk, OP_METHOD, methodStmt->line);
-                    writeChunk(gen->chunk, (uint8_t)mNameConst, methodStmt->line);
+                    int mNameConst = makeConstant(gen, mNameVal);
+                    emitIndexed(gen, OP_METHOD, mNameConst, methodStmt->line);
                 }
             }
             
@@ -1295,9 +1726,8 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
 
         case STMT_INTENT_DECL: {
             Value nameVal = OBJ_VAL(copyString(stmt->as.intent_decl.name, strlen(stmt->as.intent_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
-            writeChunk(gen->chunk, OP_INTENT, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            int nameConst = makeConstant(gen, nameVal);
+            emitIndexed(gen, OP_INTENT, nameConst, stmt->line);
             
             // Param count
             int paramCount = stmt->as.intent_decl.params ? stmt->as.intent_decl.params->count : 0;
@@ -1306,22 +1736,22 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             if (gen->compiler->scopeDepth > 0) {
                  addLocal(gen, stmt->as.intent_decl.name);
             } else {
-                 writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                 writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                 emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             break;
         }
 
         case STMT_RESOLVER_DECL: {
             Value nameVal = OBJ_VAL(copyString(stmt->as.resolver_decl.name, strlen(stmt->as.resolver_decl.name)));
-            int nameConst = addConstant(gen->chunk, nameVal);
+            int nameConst = makeConstant(gen, nameVal);
             
             Value targetVal = OBJ_VAL(copyString(stmt->as.resolver_decl.targetIntent, strlen(stmt->as.resolver_decl.targetIntent)));
-            int targetConst = addConstant(gen->chunk, targetVal);
+            int targetConst = makeConstant(gen, targetVal);
             
             // Generate Closure for Resolver Body
             Compiler funcCompiler;
             initCompiler(gen, &funcCompiler, COMP_FUNCTION);
+            scanAssignsStmts(&funcCompiler, stmt->as.resolver_decl.body);
             
             push(&vm, OBJ_VAL(funcCompiler.function));
             funcCompiler.function->name = copyString(stmt->as.resolver_decl.name, strlen(stmt->as.resolver_decl.name));
@@ -1336,20 +1766,18 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
             }
             ObjFunction* function = endCompiler(gen, false);
             Value funcVal = OBJ_VAL(function);
-            int funcConst = addConstant(gen->chunk, funcVal);
-            writeChunk(gen->chunk, OP_CLOSURE, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)funcConst, stmt->line);
-            
+            int funcConst = makeConstant(gen, funcVal);
+            emitClosure(gen, OP_CLOSURE, funcConst, &funcCompiler, stmt->line);
+            freeCompiler(&funcCompiler);
+                        
             // Emit Resolver instruction
-            writeChunk(gen->chunk, OP_RESOLVER, stmt->line);
-            writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+            emitIndexed(gen, OP_RESOLVER, nameConst, stmt->line);
             emitInt(gen, targetConst, stmt->line); // Operand: targetIntent
             
             if (gen->compiler->scopeDepth > 0) {
                  addLocal(gen, stmt->as.resolver_decl.name);
             } else {
-                 writeChunk(gen->chunk, OP_DEFINE_GLOBAL, stmt->line);
-                 writeChunk(gen->chunk, (uint8_t)nameConst, stmt->line);
+                 emitIndexed(gen, OP_DEFINE_GLOBAL, nameConst, stmt->line);
             }
             break;
         }
@@ -1363,24 +1791,21 @@ static void genStmt(BytecodeGen* gen, Stmt* stmt) {
     }
 }
 
-bool generateBytecode(StmtList* statements, ObjFunction* function) {
+static bool generateModule(StmtList* statements, ObjFunction* function, bool wideJumps, bool* jumpOverflow) {
     BytecodeGen gen;
     Compiler compiler;
-    
+
+    setupCompiler(&compiler, NULL, function, COMP_SCRIPT);
+    gen.enclosing = activeGen;
     gen.compiler = &compiler;
     gen.chunk = &function->chunk;
     gen.hadError = false;
-    
-    compiler.enclosing = NULL;
-    compiler.function = function; 
-    
-    compiler.type = COMP_SCRIPT; 
-    compiler.localCount = 0;
-    compiler.scopeDepth = 0;
-    compiler.loop = NULL;
-    
-    compiler.locals[compiler.localCount++].depth = 0;
-    compiler.locals[0].name = "";
+    gen.jumpOverflow = false;
+    gen.wideJumps = wideJumps;
+
+    activeGen = &gen;
+    analyzeEscapes(statements);
+    scanAssignsStmts(&compiler, statements);
 
     if (statements) {
         for (int i = 0; i < statements->count; i++) {
@@ -1388,9 +1813,32 @@ bool generateBytecode(StmtList* statements, ObjFunction* function) {
             if (gen.hadError) break;
         }
     }
-    
+
     writeChunk(gen.chunk, OP_NIL, 0);
     writeChunk(gen.chunk, OP_RETURN, 0);
-    
+
+    activeGen = gen.enclosing;
+    freeCompiler(&compiler);
+    *jumpOverflow = gen.jumpOverflow;
     return !gen.hadError;
 }
+
+bool generateBytecode(StmtList* statements, ObjFunction* function) {
+    bool jumpOverflow;
+    if (!generateModule(statements, function, false, &jumpOverflow)) return false;
+    if (!jumpOverflow) return true;
+
+    // Some jump spans more than 64KB of code. Nested functions are
+    // regenerated too, so the first attempt is simply discarded.
+    freeChunk(&function->chunk);
+    initChunk(&function->chunk);
+    return generateModule(statements, function, true, &jumpOverflow);
+}
+
+void markBytecodeGenRoots() {
+    for (BytecodeGen* gen = activeGen; gen != NULL; gen = gen->enclosing) {
+        for (Compiler* compiler = gen->compiler; compiler != NULL; compiler = compiler->enclosing) {
+            markObject((Obj*)compiler->function);
+        }
+    }
+}
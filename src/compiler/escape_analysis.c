@@ -1,86 +1,351 @@
 #include "../include/escape_analysis.h"
+#include <stdlib.h>
 #include <string.h>
 
-static bool exprContainsVar(Expr* expr, const char* varName) {
-    if (!expr) return false;
+// A parameter or local function of the body being scanned, with the
+// furthest escape seen for any use of its name. Shadowing bindings share
+// the entry, which only makes the result more conservative.
+typedef struct {
+    const char* name;
+    EscapeState state;
+} TrackedName;
+
+typedef struct {
+    TrackedName* names;
+    int nameCount;
+    int nameCapacity;
+
+    // Functions declared directly in this body: those bound to locals, and
+    // every declaration or lambda whose own body is analyzed afterwards
+    Stmt** locals;
+    int localCount;
+    int localCapacity;
+    Stmt** decls;
+    int declCount;
+    int declCapacity;
+    Expr** lambdas;
+    int lambdaCount;
+    int lambdaCapacity;
+
+    bool opaque; // Met a construct the scan does not model
+} BodyScan;
+
+static void* growList(void* items, int count, int* capacity, size_t size) {
+    if (count < *capacity) return items;
+    *capacity = *capacity < 8 ? 8 : *capacity * 2;
+    return realloc(items, size * (size_t)*capacity);
+}
+
+static void track(BodyScan* scan, const char* name) {
+    scan->names = (TrackedName*)growList(scan->names, scan->nameCount, &scan->nameCapacity, sizeof(TrackedName));
+    scan->names[scan->nameCount].name = name;
+    scan->names[scan->nameCount].state = ESCAPE_NONE;
+    scan->nameCount++;
+}
+
+static void noteUse(BodyScan* scan, const char* name, EscapeState state) {
+    for (int i = 0; i < scan->nameCount; i++) {
+        if (scan->names[i].state < state && strcmp(scan->names[i].name, name) == 0) {
+            scan->names[i].state = state;
+        }
+    }
+}
+
+static EscapeState stateOf(BodyScan* scan, const char* name) {
+    EscapeState state = ESCAPE_NONE;
+    for (int i = 0; i < scan->nameCount; i++) {
+        if (scan->names[i].state > state && strcmp(scan->names[i].name, name) == 0) {
+            state = scan->names[i].state;
+        }
+    }
+    return state;
+}
+
+static void scanStmts(BodyScan* scan, StmtList* list, bool local, bool nested);
+
+static void scanExprs(BodyScan* scan, ExprList* list, EscapeState context, bool nested);
+
+// 'context' is how far the value of 'expr' travels from where it is used:
+// ESCAPE_NONE when it is only called, tested or discarded, ESCAPE_ARGUMENT
+// as a call argument, ESCAPE_RETURN when returned and ESCAPE_HEAP anywhere
+// else. Inside a nested function ('nested') every use is a capture.
+static void scanExpr(BodyScan* scan, Expr* expr, EscapeState context, bool nested) {
+    if (expr == NULL) return;
     switch (expr->type) {
+        case EXPR_LITERAL:
+        case EXPR_THIS:
+        case EXPR_SUPER:
+            break;
         case EXPR_VARIABLE:
-            return strcmp(expr->as.variable.name, varName) == 0;
+            noteUse(scan, expr->as.variable.name, nested ? ESCAPE_HEAP : context);
+            break;
+        case EXPR_GROUPING:
+            scanExpr(scan, expr->as.grouping.expression, context, nested);
+            break;
+        case EXPR_LOGICAL:
+            // The result is one of the operands
+            scanExpr(scan, expr->as.logical.left, context, nested);
+            scanExpr(scan, expr->as.logical.right, context, nested);
+            break;
+        case EXPR_TERNARY:
+            scanExpr(scan, expr->as.ternary.condition, ESCAPE_NONE, nested);
+            scanExpr(scan, expr->as.ternary.true_branch, context, nested);
+            scanExpr(scan, expr->as.ternary.false_branch, context, nested);
+            break;
+        case EXPR_CALL:
+            scanExpr(scan, expr->as.call.callee, ESCAPE_NONE, nested);
+            scanExprs(scan, expr->as.call.arguments, ESCAPE_ARGUMENT, nested);
+            break;
         case EXPR_BINARY:
-            return exprContainsVar(expr->as.binary.left, varName) || exprContainsVar(expr->as.binary.right, varName);
+            // List concatenation and similar operators can store an operand
+            scanExpr(scan, expr->as.binary.left, ESCAPE_HEAP, nested);
+            scanExpr(scan, expr->as.binary.right, ESCAPE_HEAP, nested);
+            break;
         case EXPR_UNARY:
-            return exprContainsVar(expr->as.unary.right, varName);
-        case EXPR_CALL: {
-            if (exprContainsVar(expr->as.call.callee, varName)) return true;
-            if (expr->as.call.arguments) {
-                for (int i = 0; i < expr->as.call.arguments->count; i++) {
-                    if (exprContainsVar(expr->as.call.arguments->items[i], varName)) return true;
-                }
-            }
-            return false;
-        }
+            scanExpr(scan, expr->as.unary.right, ESCAPE_HEAP, nested);
+            break;
+        case EXPR_ASSIGN:
+            scanExpr(scan, expr->as.assign.value, ESCAPE_HEAP, nested);
+            break;
         case EXPR_GET:
-            return exprContainsVar(expr->as.get.object, varName);
+            // A method bound to its receiver may keep it
+            scanExpr(scan, expr->as.get.object, ESCAPE_HEAP, nested);
+            break;
         case EXPR_SET:
-            return exprContainsVar(expr->as.set.object, varName) || exprContainsVar(expr->as.set.value, varName);
+            scanExpr(scan, expr->as.set.object, ESCAPE_HEAP, nested);
+            scanExpr(scan, expr->as.set.value, ESCAPE_HEAP, nested);
+            break;
         case EXPR_INDEX:
-            return exprContainsVar(expr->as.index.target, varName) || exprContainsVar(expr->as.index.index, varName);
+            scanExpr(scan, expr->as.index.target, ESCAPE_HEAP, nested);
+            scanExpr(scan, expr->as.index.index, ESCAPE_HEAP, nested);
+            break;
         case EXPR_SET_INDEX:
-            return exprContainsVar(expr->as.set_index.target, varName) ||
-                   exprContainsVar(expr->as.set_index.index, varName) ||
-                   exprContainsVar(expr->as.set_index.value, varName);
+            scanExpr(scan, expr->as.set_index.target, ESCAPE_HEAP, nested);
+            scanExpr(scan, expr->as.set_index.index, ESCAPE_HEAP, nested);
+            scanExpr(scan, expr->as.set_index.value, ESCAPE_HEAP, nested);
+            break;
         case EXPR_LIST:
-            if (expr->as.list.elements) {
-                for (int i = 0; i < expr->as.list.elements->count; i++) {
-                    if (exprContainsVar(expr->as.list.elements->items[i], varName)) return true;
-                }
-            }
-            return false;
+            scanExprs(scan, expr->as.list.elements, ESCAPE_HEAP, nested);
+            break;
         case EXPR_DICTIONARY:
             if (expr->as.dictionary.pairs) {
                 for (int i = 0; i < expr->as.dictionary.pairs->count; i++) {
-                    if (exprContainsVar(expr->as.dictionary.pairs->items[i].key, varName) ||
-                        exprContainsVar(expr->as.dictionary.pairs->items[i].value, varName)) return true;
+                    scanExpr(scan, expr->as.dictionary.pairs->items[i].key, ESCAPE_HEAP, nested);
+                    scanExpr(scan, expr->as.dictionary.pairs->items[i].value, ESCAPE_HEAP, nested);
                 }
             }
-            return false;
+            break;
         case EXPR_TEMPLATE_LITERAL:
-            if (expr->as.template_literal.parts) {
-                for (int i = 0; i < expr->as.template_literal.parts->count; i++) {
-                    if (exprContainsVar(expr->as.template_literal.parts->items[i], varName)) return true;
-                }
+            scanExprs(scan, expr->as.template_literal.parts, ESCAPE_HEAP, nested);
+            break;
+        case EXPR_AWAIT:
+            scanExpr(scan, expr->as.await_expr.expression, ESCAPE_HEAP, nested);
+            break;
+        case EXPR_NEW:
+            scanExpr(scan, expr->as.new_expr.clazz, ESCAPE_HEAP, nested);
+            scanExprs(scan, expr->as.new_expr.args, ESCAPE_HEAP, nested);
+            break;
+        case EXPR_UNWRAP:
+            scanExpr(scan, expr->as.unwrap.expression, ESCAPE_HEAP, nested);
+            break;
+        case EXPR_LAMBDA:
+            if (!nested) {
+                expr->as.lambda.escape = context;
+                scan->lambdas = (Expr**)growList(scan->lambdas, scan->lambdaCount, &scan->lambdaCapacity, sizeof(Expr*));
+                scan->lambdas[scan->lambdaCount++] = expr;
             }
-            return false;
+            scanStmts(scan, expr->as.lambda.body, true, true);
+            break;
         default:
-            return false;
+            scan->opaque = true;
+            break;
     }
 }
 
-EscapeState analyzeClosureEscape(Stmt* funcDecl) {
-    if (!funcDecl || funcDecl->type != STMT_FUNC_DECL) return ESCAPE_NONE;
+static void scanExprs(BodyScan* scan, ExprList* list, EscapeState context, bool nested) {
+    if (list == NULL) return;
+    for (int i = 0; i < list->count; i++) {
+        scanExpr(scan, list->items[i], context, nested);
+    }
+}
 
-    // By default, if the function is not static or is at top-level script scope, it's global
-    if (funcDecl->as.func_decl.isStatic) {
-        return ESCAPE_NONE;
+static void addDecl(BodyScan* scan, Stmt* decl) {
+    scan->decls = (Stmt**)growList(scan->decls, scan->declCount, &scan->declCapacity, sizeof(Stmt*));
+    scan->decls[scan->declCount++] = decl;
+}
+
+// 'local' is false only for the script's top level, whose functions are
+// globals.
+static void scanStmt(BodyScan* scan, Stmt* stmt, bool local, bool nested) {
+    if (stmt == NULL) return;
+    switch (stmt->type) {
+        case STMT_EXPRESSION:
+            scanExpr(scan, stmt->as.expression.expression, ESCAPE_NONE, nested);
+            break;
+        case STMT_PRINT:
+            scanExpr(scan, stmt->as.print.expression, ESCAPE_NONE, nested);
+            break;
+        case STMT_RETURN:
+            scanExpr(scan, stmt->as.return_stmt.value, ESCAPE_RETURN, nested);
+            break;
+        case STMT_VAR_DECL:
+            scanExpr(scan, stmt->as.var_decl.initializer, ESCAPE_HEAP, nested);
+            break;
+        case STMT_FUNC_DECL:
+            if (!nested) {
+                if (local) {
+                    scan->locals = (Stmt**)growList(scan->locals, scan->localCount, &scan->localCapacity, sizeof(Stmt*));
+                    scan->locals[scan->localCount++] = stmt;
+                    track(scan, stmt->as.func_decl.name);
+                } else {
+                    stmt->as.func_decl.escape = ESCAPE_GLOBAL;
+                }
+                addDecl(scan, stmt);
+            }
+            scanStmts(scan, stmt->as.func_decl.body, true, true);
+            break;
+        case STMT_CLASS_DECL:
+            scanExpr(scan, stmt->as.class_decl.superclass, ESCAPE_HEAP, nested);
+            if (stmt->as.class_decl.methods) {
+                for (int i = 0; i < stmt->as.class_decl.methods->count; i++) {
+                    Stmt* method = stmt->as.class_decl.methods->items[i];
+                    if (method->type != STMT_FUNC_DECL) continue;
+                    if (!nested) addDecl(scan, method);
+                    scanStmts(scan, method->as.func_decl.body, true, true);
+                }
+            }
+            break;
+        case STMT_BLOCK:
+            scanStmts(scan, stmt->as.block.statements, true, nested);
+            break;
+        case STMT_IF:
+            scanExpr(scan, stmt->as.if_stmt.condition, ESCAPE_NONE, nested);
+            scanStmt(scan, stmt->as.if_stmt.then_branch, local, nested);
+            scanStmt(scan, stmt->as.if_stmt.else_branch, local, nested);
+            break;
+        case STMT_WHILE:
+            scanExpr(scan, stmt->as.while_stmt.condition, ESCAPE_NONE, nested);
+            scanStmt(scan, stmt->as.while_stmt.body, local, nested);
+            break;
+        case STMT_FOR:
+            scanStmt(scan, stmt->as.for_stmt.initializer, true, nested);
+            scanExpr(scan, stmt->as.for_stmt.condition, ESCAPE_NONE, nested);
+            scanExpr(scan, stmt->as.for_stmt.increment, ESCAPE_NONE, nested);
+            scanStmt(scan, stmt->as.for_stmt.body, true, nested);
+            break;
+        case STMT_FOR_IN:
+            // The iterator keeps the iterable
+            scanExpr(scan, stmt->as.for_in.iterable, ESCAPE_HEAP, nested);
+            scanStmt(scan, stmt->as.for_in.body, true, nested);
+            break;
+        case STMT_SWITCH:
+            scanExpr(scan, stmt->as.switch_stmt.value, ESCAPE_NONE, nested);
+            if (stmt->as.switch_stmt.cases) {
+                for (int i = 0; i < stmt->as.switch_stmt.cases->count; i++) {
+                    scanExpr(scan, stmt->as.switch_stmt.cases->items[i].value, ESCAPE_NONE, nested);
+                    scanStmts(scan, stmt->as.switch_stmt.cases->items[i].statements, true, nested);
+                }
+            }
+            scanStmts(scan, stmt->as.switch_stmt.default_case, true, nested);
+            break;
+        case STMT_TRY_CATCH:
+            scanStmts(scan, stmt->as.try_catch.try_block, true, nested);
+            scanStmts(scan, stmt->as.try_catch.catch_block, true, nested);
+            scanStmts(scan, stmt->as.try_catch.finally_block, true, nested);
+            break;
+        case STMT_BREAK:
+        case STMT_CONTINUE:
+        case STMT_USE_DECL:
+        case STMT_INTERFACE_DECL:
+        case STMT_EXTERN_DECL:
+            break;
+        default:
+            scan->opaque = true;
+            break;
     }
+}
 
-    return ESCAPE_NONE;
+static void scanStmts(BodyScan* scan, StmtList* list, bool local, bool nested) {
+    if (list == NULL) return;
+    for (int i = 0; i < list->count; i++) {
+        scanStmt(scan, list->items[i], local, nested);
+    }
 }
 
-EscapeState analyzeLambdaEscape(Expr* lambdaExpr, StmtList* enclosingBody) {
-    if (!lambdaExpr || lambdaExpr->type != EXPR_LAMBDA || !enclosingBody) return ESCAPE_NONE;
+static uint32_t analyzeBody(StringList* params, StmtList* body, bool isScript, bool* createsClosures);
 
-    // Check statements in enclosing body for return statements returning this lambda
-    for (int i = 0; i < enclosingBody->count; i++) {
-        Stmt* stmt = enclosingBody->items[i];
-        if (stmt->type == STMT_RETURN && stmt->as.return_stmt.value == lambdaExpr) {
-            return ESCAPE_RETURN;
-        }
+static void analyzeFunction(StringList* params, StmtList* body, bool isAsync,
+                            EscapeState* escape, uint32_t* retainedParams) {
+    bool createsClosures;
+    *retainedParams = analyzeBody(params, body, false, &createsClosures);
+    // Nested closures could outlive this one while holding its upvalues
+    if (createsClosures && *escape < ESCAPE_HEAP) *escape = ESCAPE_HEAP;
+    if (isAsync) *retainedParams = UINT32_MAX;
+}
+
+// Scans one function body (or the script), records the escape of the local
+// functions it declares and the lambdas it creates, then analyzes each of
+// those bodies in turn. Returns the parameters the body may retain.
+static uint32_t analyzeBody(StringList* params, StmtList* body, bool isScript, bool* createsClosures) {
+    BodyScan scan;
+    memset(&scan, 0, sizeof(scan));
+
+    int paramCount = params ? params->count : 0;
+    for (int i = 0; i < paramCount; i++) {
+        track(&scan, params->items[i]);
     }
+    scanStmts(&scan, body, !isScript, false);
 
-    return ESCAPE_NONE;
+    if (scan.opaque) {
+        for (int i = 0; i < scan.nameCount; i++) scan.names[i].state = ESCAPE_HEAP;
+        for (int i = 0; i < scan.lambdaCount; i++) scan.lambdas[i]->as.lambda.escape = ESCAPE_HEAP;
+    }
+
+    uint32_t retained = 0;
+    for (int i = 0; i < paramCount; i++) {
+        if (stateOf(&scan, params->items[i]) > ESCAPE_ARGUMENT) retained |= 1u << (i < 31 ? i : 31);
+    }
+    for (int i = 0; i < scan.localCount; i++) {
+        Stmt* decl = scan.locals[i];
+        decl->as.func_decl.escape = stateOf(&scan, decl->as.func_decl.name);
+    }
+
+    for (int i = 0; i < scan.declCount; i++) {
+        FuncDeclStmt* decl = &scan.decls[i]->as.func_decl;
+        analyzeFunction(decl->params, decl->body, decl->isAsync, &decl->escape, &decl->retainedParams);
+    }
+    for (int i = 0; i < scan.lambdaCount; i++) {
+        LambdaExpr* lambda = &scan.lambdas[i]->as.lambda;
+        analyzeFunction(lambda->params, lambda->body, false, &lambda->escape, &lambda->retainedParams);
+    }
+
+    *createsClosures = scan.declCount > 0 || scan.lambdaCount > 0;
+    free(scan.names);
+    free(scan.locals);
+    free(scan.decls);
+    free(scan.lambdas);
+    return retained;
+}
+
+void analyzeEscapes(StmtList* program) {
+    bool createsClosures;
+    analyzeBody(NULL, program, true, &createsClosures);
+}
+
+EscapeState analyzeClosureEscape(Stmt* funcDecl) {
+    if (!funcDecl || funcDecl->type != STMT_FUNC_DECL) return ESCAPE_HEAP;
+    return funcDecl->as.func_decl.escape;
+}
+
+EscapeState analyzeLambdaEscape(Expr* lambdaExpr) {
+    if (!lambdaExpr || lambdaExpr->type != EXPR_LAMBDA) return ESCAPE_HEAP;
+    return lambdaExpr->as.lambda.escape;
 }
 
 bool isClosureStackEligible(Stmt* funcDecl) {
-    return analyzeClosureEscape(funcDecl) == ESCAPE_NONE;
+    return analyzeClosureEscape(funcDecl) <= ESCAPE_ARGUMENT;
+}
+
+bool isLambdaStackEligible(Expr* lambdaExpr) {
+    return analyzeLambdaEscape(lambdaExpr) <= ESCAPE_ARGUMENT;
 }
@@ -6,24 +6,13 @@
 
 #include "../../include/ir.h"
 #include "../../include/value.h"
+#include "../../include/arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-static void* safe_malloc(size_t size) {
-    void* ptr = malloc(size);
-    if (!ptr) { fprintf(stderr, "Out of memory\n"); exit(1); }
-    return ptr;
-}
-
-static void* safe_realloc(void* ptr, size_t size) {
-    void* new_ptr = realloc(ptr, size);
-    if (!new_ptr && size != 0) { fprintf(stderr, "Out of memory\n"); exit(1); }
-    return new_ptr;
-}
-
 IRModule* createIRModule() {
-    IRModule* module = (IRModule*)safe_malloc(sizeof(IRModule));
+    IRModule* module = COMPILER_NEW(IRModule);
     module->functions = NULL;
     module->funcCount = 0;
     module->funcCapacity = 0;
@@ -31,19 +20,22 @@ IRModule* createIRModule() {
 }
 
 IRFunction* createIRFunction(const char* name, bool isAsync) {
-    IRFunction* func = (IRFunction*)safe_malloc(sizeof(IRFunction));
-    func->name = strdup(name);
+    IRFunction* func = COMPILER_NEW(IRFunction);
+    func->name = compilerStrdup(name);
     func->entry = NULL;
     func->blocks = NULL;
     func->blockCount = 0;
     func->blockCapacity = 0;
     func->nextSsaVal = 0;
+    func->paramCount = 0;
+    func->paramTypes = NULL;
+    func->paramEscapes = NULL;
     func->isAsync = isAsync;
     return func;
 }
 
 IRBasicBlock* createIRBasicBlock(IRFunction* func) {
-    IRBasicBlock* block = (IRBasicBlock*)safe_malloc(sizeof(IRBasicBlock));
+    IRBasicBlock* block = COMPILER_NEW(IRBasicBlock);
     block->id = func->blockCount;
     block->first = NULL;
     block->last = NULL;
@@ -57,8 +49,9 @@ IRBasicBlock* createIRBasicBlock(IRFunction* func) {
 
     // Add to function
     if (func->blockCount >= func->blockCapacity) {
-        func->blockCapacity = func->blockCapacity == 0 ? 8 : func->blockCapacity * 2;
-        func->blocks = (IRBasicBlock**)safe_realloc(func->blocks, sizeof(IRBasicBlock*) * func->blockCapacity);
+        int oldCapacity = func->blockCapacity;
+        func->blockCapacity = oldCapacity == 0 ? 8 : oldCapacity * 2;
+        func->blocks = COMPILER_GROW_ARRAY(IRBasicBlock*, func->blocks, oldCapacity, func->blockCapacity);
     }
     func->blocks[func->blockCount++] = block;
 
@@ -68,23 +61,39 @@ IRBasicBlock* createIRBasicBlock(IRFunction* func) {
 }
 
 IRInstruction* createIRInstruction(IROpcode opcode, int result) {
-    IRInstruction* instr = (IRInstruction*)safe_malloc(sizeof(IRInstruction));
+    IRInstruction* instr = COMPILER_NEW(IRInstruction);
     instr->opcode = opcode;
     instr->result = result;
     instr->type = IR_TYPE_UNKNOWN;
     instr->escapes = true;
+    instr->checked = true;
     instr->operands = NULL;
     instr->operandCount = 0;
+    instr->operandCapacity = 0;
     instr->next = NULL;
     instr->prev = NULL;
     return instr;
 }
 
 void addOperand(IRInstruction* instr, IROperand op) {
-    instr->operands = (IROperand*)safe_realloc(instr->operands, sizeof(IROperand) * (instr->operandCount + 1));
+    if (instr->operandCount >= instr->operandCapacity) {
+        int oldCapacity = instr->operandCapacity;
+        instr->operandCapacity = oldCapacity == 0 ? 2 : oldCapacity * 2;
+        instr->operands = COMPILER_GROW_ARRAY(IROperand, instr->operands, oldCapacity, instr->operandCapacity);
+    }
     instr->operands[instr->operandCount++] = op;
 }
 
+static const char* irTypeName(IRType type) {
+    switch (type) {
+        case IR_TYPE_INT: return ":int";
+        case IR_TYPE_FLOAT: return ":float";
+        case IR_TYPE_BOOL: return ":bool";
+        case IR_TYPE_OBJ: return ":obj";
+        default: return "";
+    }
+}
+
 static const char* irOpName(IROpcode op) {
     switch (op) {
         case IR_OP_NOP: return "nop";
@@ -109,6 +118,10 @@ static const char* irOpName(IROpcode op) {
         case IR_OP_SET_MEMBER: return "set_member";
         case IR_OP_ALLOCA: return "alloca";
         case IR_OP_AWAIT: return "await";
+        case IR_OP_GET_INDEX: return "get_index";
+        case IR_OP_SET_INDEX: return "set_index";
+        case IR_OP_LENGTH: return "length";
+        case IR_OP_NEW_LIST: return "new_list";
         default: return "unknown";
     }
 }
@@ -126,8 +139,9 @@ static void addEdge(IRBasicBlock* from, IRBasicBlock* to) {
     }
     if (!found_succ) {
         if (from->succCount >= from->succCapacity) {
-            from->succCapacity = from->succCapacity == 0 ? 4 : from->succCapacity * 2;
-            from->successors = (IRBasicBlock**)safe_realloc(from->successors, sizeof(IRBasicBlock*) * from->succCapacity);
+            int oldCapacity = from->succCapacity;
+            from->succCapacity = oldCapacity == 0 ? 4 : oldCapacity * 2;
+            from->successors = COMPILER_GROW_ARRAY(IRBasicBlock*, from->successors, oldCapacity, from->succCapacity);
         }
         from->successors[from->succCount++] = to;
     }
@@ -142,8 +156,9 @@ static void addEdge(IRBasicBlock* from, IRBasicBlock* to) {
     }
     if (!found_pred) {
         if (to->predCount >= to->predCapacity) {
-            to->predCapacity = to->predCapacity == 0 ? 4 : to->predCapacity * 2;
-            to->predecessors = (IRBasicBlock**)safe_realloc(to->predecessors, sizeof(IRBasicBlock*) * to->predCapacity);
+            int oldCapacity = to->predCapacity;
+            to->predCapacity = oldCapacity == 0 ? 4 : oldCapacity * 2;
+            to->predecessors = COMPILER_GROW_ARRAY(IRBasicBlock*, to->predecessors, oldCapacity, to->predCapacity);
         }
         to->predecessors[to->predCount++] = from;
     }
@@ -183,8 +198,11 @@ void dumpIR(IRModule* module) {
             IRInstruction* instr = block->first;
             while (instr) {
                 printf("    ");
-                if (instr->result != -1) printf("%%v%d = ", instr->result);
+                if (instr->result != -1) printf("%%v%d%s = ", instr->result, irTypeName(instr->type));
                 printf("%s", irOpName(instr->opcode));
+                if ((instr->opcode == IR_OP_GET_INDEX || instr->opcode == IR_OP_SET_INDEX) && !instr->checked) {
+                    printf(".unchecked");
+                }
                 for (int k = 0; k < instr->operandCount; k++) {
                     if (instr->opcode == IR_OP_PHI && k % 2 == 0) printf( (k == 0) ? " " : " | ");
                     else printf(", ");
@@ -195,6 +213,7 @@ void dumpIR(IRModule* module) {
                         printValue(op->as.constant);
                     }
                     else if (op->type == OPERAND_BLOCK) printf("block%d", op->as.block->id);
+                    else if (op->type == OPERAND_FUNC) printf("@%s", op->as.func->name);
                 }
                 printf("\n");
                 instr = instr->next;
@@ -203,27 +222,3 @@ void dumpIR(IRModule* module) {
         printf("}\n");
     }
 }
-
-void freeIRModule(IRModule* module) {
-    for (int i = 0; i < module->funcCount; i++) {
-        IRFunction* func = module->functions[i];
-        for (int j = 0; j < func->blockCount; j++) {
-            IRBasicBlock* block = func->blocks[j];
-            IRInstruction* curr = block->first;
-            while (curr) {
-                IRInstruction* next = curr->next;
-                free(curr->operands);
-                free(curr);
-                curr = next;
-            }
-            free(block->predecessors);
-            free(block->successors);
-            free(block);
-        }
-        free(func->blocks);
-        free(func->name);
-        free(func);
-    }
-    free(module->functions);
-    free(module);
-}
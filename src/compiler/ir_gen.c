@@ -7,6 +7,7 @@
 #include "../../include/ir.h"
 #include "../../include/ast.h"
 #include "../../include/object.h"
+#include "../../include/arena.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -27,6 +28,15 @@ typedef struct {
     int symbolCount;
     int symbolCapacity;
 
+    // Functions declared so far, so calls by name become direct calls.
+    // Top-level declarations are entered up front for forward calls.
+    struct {
+       Stmt* decl;
+       IRFunction* func;
+    } *functions;
+    int functionCount;
+    int functionCapacity;
+
     int nextReg;
 } IRGen;
 
@@ -59,6 +69,42 @@ static void addSymbol(IRGen* gen, const char* name, int ssaVal, bool isAlloca) {
     gen->symbolCount++;
 }
 
+// Drops the symbols declared since the scope began.
+static void endScope(IRGen* gen, int savedSymbolCount) {
+    while (gen->symbolCount > savedSymbolCount) {
+        free(gen->symbols[--gen->symbolCount].name);
+    }
+}
+
+static bool isSymbol(IRGen* gen, const char* name) {
+    for (int i = gen->symbolCount - 1; i >= 0; i--) {
+        if (strcmp(gen->symbols[i].name, name) == 0) return true;
+    }
+    return false;
+}
+
+static IRFunction* declareFunction(IRGen* gen, Stmt* decl) {
+    for (int i = 0; i < gen->functionCount; i++) {
+        if (gen->functions[i].decl == decl) return gen->functions[i].func;
+    }
+    if (gen->functionCount >= gen->functionCapacity) {
+        gen->functionCapacity = gen->functionCapacity == 0 ? 16 : gen->functionCapacity * 2;
+        gen->functions = realloc(gen->functions, sizeof(*gen->functions) * gen->functionCapacity);
+    }
+    IRFunction* func = createIRFunction(decl->as.func_decl.name, decl->as.func_decl.isAsync);
+    gen->functions[gen->functionCount].decl = decl;
+    gen->functions[gen->functionCount].func = func;
+    gen->functionCount++;
+    return func;
+}
+
+static IRFunction* findFunction(IRGen* gen, const char* name) {
+    for (int i = gen->functionCount - 1; i >= 0; i--) {
+        if (strcmp(gen->functions[i].func->name, name) == 0) return gen->functions[i].func;
+    }
+    return NULL;
+}
+
 static int visitExpr(IRGen* gen, Expr* expr) {
     if (!expr) return -1;
 
@@ -80,16 +126,17 @@ static int visitExpr(IRGen* gen, Expr* expr) {
             int r = newReg(gen);
             
             IROpcode opcode;
-            if (strcmp(expr->as.binary.operator, "+") == 0) opcode = IR_OP_ADD;
-            else if (strcmp(expr->as.binary.operator, "-") == 0) opcode = IR_OP_SUB;
-            else if (strcmp(expr->as.binary.operator, "*") == 0) opcode = IR_OP_MUL;
-            else if (strcmp(expr->as.binary.operator, "/") == 0) opcode = IR_OP_DIV;
-            else if (strcmp(expr->as.binary.operator, "<") == 0) opcode = IR_OP_CMP_LT;
-            else if (strcmp(expr->as.binary.operator, ">") == 0) opcode = IR_OP_CMP_GT;
-            else if (strcmp(expr->as.binary.operator, "==") == 0) opcode = IR_OP_CMP_EQ;
-            else {
-                fprintf(stderr, "Unsupported IR operator: %s\n", expr->as.binary.operator);
-                exit(1);
+            switch (expr->as.binary.op) {
+                case AST_OP_ADD: opcode = IR_OP_ADD; break;
+                case AST_OP_SUBTRACT: opcode = IR_OP_SUB; break;
+                case AST_OP_MULTIPLY: opcode = IR_OP_MUL; break;
+                case AST_OP_DIVIDE: opcode = IR_OP_DIV; break;
+                case AST_OP_LESS: opcode = IR_OP_CMP_LT; break;
+                case AST_OP_GREATER: opcode = IR_OP_CMP_GT; break;
+                case AST_OP_EQUAL: opcode = IR_OP_CMP_EQ; break;
+                default:
+                    fprintf(stderr, "Unsupported IR operator: %s\n", astOperatorLexeme(expr->as.binary.op));
+                    exit(1);
             }
 
             IRInstruction* instr = createIRInstruction(opcode, r);
@@ -103,7 +150,8 @@ static int visitExpr(IRGen* gen, Expr* expr) {
         }
 
         case EXPR_VARIABLE: {
-            for (int i = 0; i < gen->symbolCount; i++) {
+            // Innermost declaration first
+            for (int i = gen->symbolCount - 1; i >= 0; i--) {
                 if (strcmp(gen->symbols[i].name, expr->as.variable.name) == 0) {
                     if (gen->symbols[i].isAlloca) {
                         int r = newReg(gen);
@@ -123,7 +171,7 @@ static int visitExpr(IRGen* gen, Expr* expr) {
 
         case EXPR_ASSIGN: {
              int val = visitExpr(gen, expr->as.assign.value);
-             for (int i = 0; i < gen->symbolCount; i++) {
+             for (int i = gen->symbolCount - 1; i >= 0; i--) {
                 if (strcmp(gen->symbols[i].name, expr->as.assign.name) == 0) {
                     if (gen->symbols[i].isAlloca) {
                         IRInstruction* instr = createIRInstruction(IR_OP_STORE_VAR, -1);
@@ -143,11 +191,34 @@ static int visitExpr(IRGen* gen, Expr* expr) {
         }
 
         case EXPR_CALL: {
-            int callee = visitExpr(gen, expr->as.call.callee);
+            // A name that is not a local but names a declared function is
+            // a direct call, which the optimizer can inline or specialize.
+            Expr* calleeExpr = expr->as.call.callee;
+            IROperand opCallee;
+            IRFunction* target = NULL;
+            if (calleeExpr && calleeExpr->type == EXPR_VARIABLE &&
+                !isSymbol(gen, calleeExpr->as.variable.name)) {
+                target = findFunction(gen, calleeExpr->as.variable.name);
+                // The builtin len() is an operation the loop passes reason about
+                if (!target && strcmp(calleeExpr->as.variable.name, "len") == 0 &&
+                    expr->as.call.arguments && expr->as.call.arguments->count == 1) {
+                    int value = visitExpr(gen, expr->as.call.arguments->items[0]);
+                    int r = newReg(gen);
+                    IRInstruction* instr = createIRInstruction(IR_OP_LENGTH, r);
+                    IROperand op;
+                    op.type = OPERAND_VAL; op.as.ssaVal = value;
+                    addOperand(instr, op);
+                    emit(gen, instr);
+                    return r;
+                }
+            }
+            if (target) {
+                opCallee.type = OPERAND_FUNC; opCallee.as.func = target;
+            } else {
+                opCallee.type = OPERAND_VAL; opCallee.as.ssaVal = visitExpr(gen, calleeExpr);
+            }
             int r = newReg(gen);
             IRInstruction* instr = createIRInstruction(IR_OP_CALL, r);
-            IROperand opCallee;
-            opCallee.type = OPERAND_VAL; opCallee.as.ssaVal = callee;
             addOperand(instr, opCallee);
             
             if (expr->as.call.arguments) {
@@ -162,6 +233,64 @@ static int visitExpr(IRGen* gen, Expr* expr) {
             return r;
         }
 
+        case EXPR_INDEX:
+        case EXPR_SET_INDEX: {
+            bool set = expr->type == EXPR_SET_INDEX;
+            int target = visitExpr(gen, set ? expr->as.set_index.target : expr->as.index.target);
+            int index = visitExpr(gen, set ? expr->as.set_index.index : expr->as.index.index);
+            int value = set ? visitExpr(gen, expr->as.set_index.value) : -1;
+            int r = set ? -1 : newReg(gen);
+            IRInstruction* instr = createIRInstruction(set ? IR_OP_SET_INDEX : IR_OP_GET_INDEX, r);
+            IROperand opTarget, opIndex;
+            opTarget.type = OPERAND_VAL; opTarget.as.ssaVal = target;
+            opIndex.type = OPERAND_VAL; opIndex.as.ssaVal = index;
+            addOperand(instr, opTarget);
+            addOperand(instr, opIndex);
+            if (set) {
+                IROperand opValue;
+                opValue.type = OPERAND_VAL; opValue.as.ssaVal = value;
+                addOperand(instr, opValue);
+            }
+            emit(gen, instr);
+            return set ? value : r;
+        }
+
+        case EXPR_GET:
+        case EXPR_SET: {
+            bool set = expr->type == EXPR_SET;
+            int object = visitExpr(gen, set ? expr->as.set.object : expr->as.get.object);
+            const char* name = set ? expr->as.set.name : expr->as.get.name;
+            int value = set ? visitExpr(gen, expr->as.set.value) : -1;
+            int r = set ? -1 : newReg(gen);
+            IRInstruction* instr = createIRInstruction(set ? IR_OP_SET_MEMBER : IR_OP_GET_MEMBER, r);
+            IROperand opObject, opName;
+            opObject.type = OPERAND_VAL; opObject.as.ssaVal = object;
+            opName.type = OPERAND_CONST; opName.as.constant = compilerString(name, (int)strlen(name));
+            compilerPinValue(opName.as.constant);
+            addOperand(instr, opObject);
+            addOperand(instr, opName);
+            if (set) {
+                IROperand opValue;
+                opValue.type = OPERAND_VAL; opValue.as.ssaVal = value;
+                addOperand(instr, opValue);
+            }
+            emit(gen, instr);
+            return set ? value : r;
+        }
+
+        case EXPR_LIST: {
+            int r = newReg(gen);
+            IRInstruction* instr = createIRInstruction(IR_OP_NEW_LIST, r);
+            ExprList* elements = expr->as.list.elements;
+            for (int i = 0; elements && i < elements->count; i++) {
+                IROperand opElement;
+                opElement.type = OPERAND_VAL; opElement.as.ssaVal = visitExpr(gen, elements->items[i]);
+                addOperand(instr, opElement);
+            }
+            emit(gen, instr);
+            return r;
+        }
+
         case EXPR_AWAIT: {
              int val = visitExpr(gen, expr->as.await_expr.expression);
              int r = newReg(gen);
@@ -363,13 +492,67 @@ static void visitStmt(IRGen* gen, Stmt* stmt) {
             break;
         }
 
+        case STMT_FOR: {
+            int savedSymbolCount = gen->symbolCount;
+            visitStmt(gen, stmt->as.for_stmt.initializer);
+
+            IRBasicBlock* condBlock = createIRBasicBlock(gen->currentFunc);
+            IRBasicBlock* loopBlock = createIRBasicBlock(gen->currentFunc);
+            IRBasicBlock* afterBlock = createIRBasicBlock(gen->currentFunc);
+
+            IRInstruction* jc = createIRInstruction(IR_OP_JUMP, -1);
+            IROperand opC;
+            opC.type = OPERAND_BLOCK; opC.as.block = condBlock;
+            addOperand(jc, opC);
+            emit(gen, jc);
+
+            // Condition block; a missing condition loops until a return
+            gen->currentBlock = condBlock;
+            if (stmt->as.for_stmt.condition) {
+                int condReg = visitExpr(gen, stmt->as.for_stmt.condition);
+                IRInstruction* ji = createIRInstruction(IR_OP_JUMP_IF, -1);
+                IROperand opCond, opLoop, opElse;
+                opCond.type = OPERAND_VAL; opCond.as.ssaVal = condReg;
+                opLoop.type = OPERAND_BLOCK; opLoop.as.block = loopBlock;
+                opElse.type = OPERAND_BLOCK; opElse.as.block = afterBlock;
+                addOperand(ji, opCond);
+                addOperand(ji, opLoop);
+                addOperand(ji, opElse);
+                emit(gen, ji);
+            } else {
+                IRInstruction* jl = createIRInstruction(IR_OP_JUMP, -1);
+                IROperand opLoop;
+                opLoop.type = OPERAND_BLOCK; opLoop.as.block = loopBlock;
+                addOperand(jl, opLoop);
+                emit(gen, jl);
+            }
+
+            // Body, then the increment on the way back to the condition
+            gen->currentBlock = loopBlock;
+            visitStmt(gen, stmt->as.for_stmt.body);
+            if (!gen->currentBlock->last || gen->currentBlock->last->opcode != IR_OP_RETURN) {
+                visitExpr(gen, stmt->as.for_stmt.increment);
+                IRInstruction* jl = createIRInstruction(IR_OP_JUMP, -1);
+                IROperand opBack;
+                opBack.type = OPERAND_BLOCK; opBack.as.block = condBlock;
+                addOperand(jl, opBack);
+                emit(gen, jl);
+            }
+
+            gen->currentBlock = afterBlock;
+            endScope(gen, savedSymbolCount);
+            break;
+        }
+
         case STMT_BLOCK: {
+            int savedSymbolCount = gen->symbolCount;
             StmtList* list = stmt->as.block.statements;
             if (list) {
                 for (int i = 0; i < list->count; i++) {
                     visitStmt(gen, list->items[i]);
                 }
             }
+            endScope(gen, savedSymbolCount);
             break;
         }
 
@@ -384,7 +567,7 @@ static void visitStmt(IRGen* gen, Stmt* stmt) {
             // For now, let's just clear symbols for the new function scope (simplified).
             
             // Create new function
-            IRFunction* func = createIRFunction(stmt->as.func_decl.name, stmt->as.func_decl.isAsync);
+            IRFunction* func = declareFunction(gen, stmt);
             gen->currentFunc = func;
             gen->currentBlock = createIRBasicBlock(func);
             gen->nextReg = 0;
@@ -400,16 +583,21 @@ static void visitStmt(IRGen* gen, Stmt* stmt) {
                      int r = newReg(gen);
                      addSymbol(gen, params->items[i], r, false);
                 }
+                func->paramCount = params->count;
             }
 
-            Stmt* blockStmt = createBlockStmt(stmt->as.func_decl.body, 0, 0);
-            visitStmt(gen, blockStmt); 
-            free(blockStmt);
+            StmtList* body = stmt->as.func_decl.body;
+            if (body) {
+                for (int i = 0; i < body->count; i++) {
+                    visitStmt(gen, body->items[i]);
+                }
+            }
 
             // Add to module
             if (gen->module->funcCount >= gen->module->funcCapacity) {
-                gen->module->funcCapacity = gen->module->funcCapacity == 0 ? 8 : gen->module->funcCapacity * 2;
-                gen->module->functions = (IRFunction**)realloc(gen->module->functions, sizeof(IRFunction*) * gen->module->funcCapacity);
+                int oldCapacity = gen->module->funcCapacity;
+                gen->module->funcCapacity = oldCapacity == 0 ? 8 : oldCapacity * 2;
+                gen->module->functions = COMPILER_GROW_ARRAY(IRFunction*, gen->module->functions, oldCapacity, gen->module->funcCapacity);
             }
             gen->module->functions[gen->module->funcCount++] = func;
             
@@ -420,7 +608,7 @@ static void visitStmt(IRGen* gen, Stmt* stmt) {
             gen->currentFunc = prevFunc;
             gen->currentBlock = prevBlock;
             gen->nextReg = prevNextReg;
-            gen->symbolCount = savedSymbolCount;
+            endScope(gen, savedSymbolCount);
             break;
         }
 
@@ -441,14 +629,24 @@ IRModule* generateSSA_IR(StmtList* program) {
     gen.symbols = malloc(sizeof(*gen.symbols) * 64);
     gen.symbolCapacity = 64;
 
+    gen.functions = NULL;
+    gen.functionCount = 0;
+    gen.functionCapacity = 0;
+
     // Add function to module
     if (gen.module->funcCount >= gen.module->funcCapacity) {
-        gen.module->funcCapacity = gen.module->funcCapacity == 0 ? 8 : gen.module->funcCapacity * 2;
-        gen.module->functions = (IRFunction**)realloc(gen.module->functions, sizeof(IRFunction*) * gen.module->funcCapacity);
+        int oldCapacity = gen.module->funcCapacity;
+        gen.module->funcCapacity = oldCapacity == 0 ? 8 : oldCapacity * 2;
+        gen.module->functions = COMPILER_GROW_ARRAY(IRFunction*, gen.module->functions, oldCapacity, gen.module->funcCapacity);
     }
     gen.module->functions[gen.module->funcCount++] = gen.currentFunc;
 
     if (program) {
+        for (int i = 0; i < program->count; i++) {
+            if (program->items[i]->type == STMT_FUNC_DECL) {
+                declareFunction(&gen, program->items[i]);
+            }
+        }
         for (int i = 0; i < program->count; i++) {
             visitStmt(&gen, program->items[i]);
         }
@@ -461,6 +659,7 @@ IRModule* generateSSA_IR(StmtList* program) {
         free(gen.symbols[i].name);
     }
     free(gen.symbols);
+    free(gen.functions);
 
     return gen.module;
 }
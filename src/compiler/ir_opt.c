@@ -5,6 +5,7 @@
 //   Copyright © 2025. ProXentix India Pvt. Ltd.  All rights reserved.
 
 #include "../../include/ir_opt.h"
+#include "../../include/arena.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -194,75 +195,198 @@ void constantFold(IRFunction* func) {
     Value* values = (Value*)malloc(sizeof(Value) * maxReg);
     bool* isConst = (bool*)calloc(maxReg, sizeof(bool));
 
-    for (int i = 0; i < func->blockCount; i++) {
-        IRBasicBlock* block = func->blocks[i];
-        IRInstruction* instr = block->first;
-        while (instr) {
-            if (instr->result >= maxReg) {
-                int oldMax = maxReg;
-                maxReg = instr->result + 256;
-                values = (Value*)realloc(values, sizeof(Value) * maxReg);
-                isConst = (bool*)realloc(isConst, sizeof(bool) * maxReg);
-                if (!values || !isConst) { fprintf(stderr, "OOM\n"); exit(1); }
-                memset(&isConst[oldMax], 0, sizeof(bool) * (maxReg - oldMax));
-            }
-            if (instr->opcode == IR_OP_CONST) {
-                isConst[instr->result] = true;
-                values[instr->result] = instr->operands[0].as.constant;
-            } else if (instr->opcode == IR_OP_ADD || instr->opcode == IR_OP_SUB || 
-                       instr->opcode == IR_OP_MUL || instr->opcode == IR_OP_DIV) {
-                
-                Value left = NIL_VAL, right = NIL_VAL;
-                bool c1 = false, c2 = false;
-
-                if (instr->operands[0].type == OPERAND_CONST) {
-                    left = instr->operands[0].as.constant;
-                    c1 = true;
-                } else if (instr->operands[0].type == OPERAND_VAL && instr->operands[0].as.ssaVal >= 0 && isConst[instr->operands[0].as.ssaVal]) {
-                    left = values[instr->operands[0].as.ssaVal];
-                    c1 = true;
+    // Blocks are visited in creation order, which after inlining is not
+    // dominance order, so repeat until nothing more folds
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < func->blockCount; i++) {
+            IRBasicBlock* block = func->blocks[i];
+            IRInstruction* instr = block->first;
+            while (instr) {
+                if (instr->result >= maxReg) {
+                    int oldMax = maxReg;
+                    maxReg = instr->result + 256;
+                    values = (Value*)realloc(values, sizeof(Value) * maxReg);
+                    isConst = (bool*)realloc(isConst, sizeof(bool) * maxReg);
+                    if (!values || !isConst) { fprintf(stderr, "OOM\n"); exit(1); }
+                    memset(&isConst[oldMax], 0, sizeof(bool) * (maxReg - oldMax));
                 }
+                if (instr->opcode == IR_OP_CONST) {
+                    isConst[instr->result] = true;
+                    values[instr->result] = instr->operands[0].as.constant;
+                } else if (instr->opcode == IR_OP_ADD || instr->opcode == IR_OP_SUB || 
+                           instr->opcode == IR_OP_MUL || instr->opcode == IR_OP_DIV) {
+                
+                    Value left = NIL_VAL, right = NIL_VAL;
+                    bool c1 = false, c2 = false;
 
-                if (instr->operands[1].type == OPERAND_CONST) {
-                    right = instr->operands[1].as.constant;
-                    c2 = true;
-                } else if (instr->operands[1].type == OPERAND_VAL && instr->operands[1].as.ssaVal >= 0 && isConst[instr->operands[1].as.ssaVal]) {
-                    right = values[instr->operands[1].as.ssaVal];
-                    c2 = true;
-                }
+                    if (instr->operands[0].type == OPERAND_CONST) {
+                        left = instr->operands[0].as.constant;
+                        c1 = true;
+                    } else if (instr->operands[0].type == OPERAND_VAL && instr->operands[0].as.ssaVal >= 0 && isConst[instr->operands[0].as.ssaVal]) {
+                        left = values[instr->operands[0].as.ssaVal];
+                        c1 = true;
+                    }
 
-                if (c1 && c2) {
-                    Value v_result = NIL_VAL;
-                    bool folded = false;
-                    if (IS_NUMBER(left) && IS_NUMBER(right)) {
-                        double l = AS_NUMBER(left);
-                        double r = AS_NUMBER(right);
-                        if (instr->opcode == IR_OP_ADD) v_result = NUMBER_VAL(l + r);
-                        else if (instr->opcode == IR_OP_SUB) v_result = NUMBER_VAL(l - r);
-                        else if (instr->opcode == IR_OP_MUL) v_result = NUMBER_VAL(l * r);
-                        else if (instr->opcode == IR_OP_DIV) v_result = NUMBER_VAL(l / r);
-                        folded = true;
+                    if (instr->operands[1].type == OPERAND_CONST) {
+                        right = instr->operands[1].as.constant;
+                        c2 = true;
+                    } else if (instr->operands[1].type == OPERAND_VAL && instr->operands[1].as.ssaVal >= 0 && isConst[instr->operands[1].as.ssaVal]) {
+                        right = values[instr->operands[1].as.ssaVal];
+                        c2 = true;
                     }
 
-                    if (folded) {
-                        instr->opcode = IR_OP_CONST;
-                        instr->operandCount = 1;
-                        instr->operands[0].type = OPERAND_CONST;
-                        instr->operands[0].as.constant = v_result;
-                        isConst[instr->result] = true;
-                        values[instr->result] = v_result;
+                    if (c1 && c2) {
+                        Value v_result = NIL_VAL;
+                        bool folded = false;
+                        if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                            double l = AS_NUMBER(left);
+                            double r = AS_NUMBER(right);
+                            if (instr->opcode == IR_OP_ADD) v_result = NUMBER_VAL(l + r);
+                            else if (instr->opcode == IR_OP_SUB) v_result = NUMBER_VAL(l - r);
+                            else if (instr->opcode == IR_OP_MUL) v_result = NUMBER_VAL(l * r);
+                            else if (instr->opcode == IR_OP_DIV) v_result = NUMBER_VAL(l / r);
+                            folded = true;
+                        }
+
+                        if (folded) {
+                            instr->opcode = IR_OP_CONST;
+                            instr->operandCount = 1;
+                            instr->operands[0].type = OPERAND_CONST;
+                            instr->operands[0].as.constant = v_result;
+                            isConst[instr->result] = true;
+                            values[instr->result] = v_result;
+                            changed = true;
+                        }
                     }
                 }
+                instr = instr->next;
             }
-            instr = instr->next;
         }
     }
     free(values);
     free(isConst);
 }
 
+// Number of register slots a function touches: parameters, results and
+// operands, whichever is highest.
+static int registerLimit(IRFunction* func) {
+    int limit = func->nextSsaVal > func->paramCount ? func->nextSsaVal : func->paramCount;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->result >= limit) limit = instr->result + 1;
+            for (int k = 0; k < instr->operandCount; k++) {
+                if (instr->operands[k].type == OPERAND_VAL && instr->operands[k].as.ssaVal >= limit) {
+                    limit = instr->operands[k].as.ssaVal + 1;
+                }
+            }
+        }
+    }
+    return limit;
+}
+
+static IRType constantType(Value v);
+
+// Inferred type of an operand, given each register's defining instruction.
+static IRType inferredType(IRFunction* func, IROperand* op, IRInstruction** defs) {
+    if (op->type == OPERAND_CONST) return constantType(op->as.constant);
+    if (op->type == OPERAND_VAL && op->as.ssaVal >= 0) {
+        int reg = op->as.ssaVal;
+        if (defs[reg] != NULL) return defs[reg]->type;
+        if (reg < func->paramCount && func->paramTypes != NULL) return func->paramTypes[reg];
+    }
+    return IR_TYPE_UNKNOWN;
+}
+
+static bool isNumericOperand(IRFunction* func, IROperand* op, IRInstruction** defs) {
+    IRType type = inferredType(func, op, defs);
+    return type == IR_TYPE_INT || type == IR_TYPE_FLOAT;
+}
+
+// Whether dropping an unused instruction cannot change behaviour.
+// Arithmetic and ordering comparisons on values not proven numeric can
+// reach the runtime (string concatenation, type errors), so they stay.
+static bool isPure(IRFunction* func, IRInstruction* instr, IRInstruction** defs) {
+    switch (instr->opcode) {
+        case IR_OP_CONST:
+        case IR_OP_PHI:
+        case IR_OP_NOT:
+        case IR_OP_CMP_EQ:
+        case IR_OP_LOAD_VAR:
+        case IR_OP_ALLOCA:
+        case IR_OP_LENGTH:
+        case IR_OP_NEW_LIST:
+            return true;
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_NEG:
+        case IR_OP_CMP_LT:
+        case IR_OP_CMP_GT:
+            for (int k = 0; k < instr->operandCount; k++) {
+                if (!isNumericOperand(func, &instr->operands[k], defs)) return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Use-count DCE: counts the reads of every register, then removes pure
+// instructions nobody reads, following their operands back as those lose
+// their last use. Calls, stores, member accesses, awaits and terminators
+// always stay. Removed and NOP instructions are unlinked from their blocks.
 void deadCodeElimination(IRFunction* func) {
-    // Simple DCE: Remove NOPs
+    int limit = registerLimit(func);
+    int* uses = (int*)calloc(limit + 1, sizeof(int));
+    IRInstruction** defs = (IRInstruction**)calloc(limit + 1, sizeof(IRInstruction*));
+    int worklistCap = 64;
+    int worklistCount = 0;
+    IRInstruction** worklist = (IRInstruction**)malloc(sizeof(IRInstruction*) * worklistCap);
+    if (!uses || !defs || !worklist) { fprintf(stderr, "OOM\n"); exit(1); }
+
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == IR_OP_NOP) continue;
+            if (instr->result >= 0) defs[instr->result] = instr;
+            for (int k = 0; k < instr->operandCount; k++) {
+                if (instr->operands[k].type == OPERAND_VAL && instr->operands[k].as.ssaVal >= 0) {
+                    uses[instr->operands[k].as.ssaVal]++;
+                }
+            }
+        }
+    }
+
+    for (int r = 0; r < limit; r++) {
+        if (defs[r] == NULL || uses[r] > 0) continue;
+        if (worklistCount >= worklistCap) {
+            worklistCap *= 2;
+            worklist = (IRInstruction**)realloc(worklist, sizeof(IRInstruction*) * worklistCap);
+        }
+        worklist[worklistCount++] = defs[r];
+    }
+
+    while (worklistCount > 0) {
+        IRInstruction* instr = worklist[--worklistCount];
+        if (instr->opcode == IR_OP_NOP || uses[instr->result] > 0 || !isPure(func, instr, defs)) continue;
+        for (int k = 0; k < instr->operandCount; k++) {
+            if (instr->operands[k].type != OPERAND_VAL) continue;
+            int reg = instr->operands[k].as.ssaVal;
+            if (reg < 0 || --uses[reg] > 0 || defs[reg] == NULL) continue;
+            if (worklistCount >= worklistCap) {
+                worklistCap *= 2;
+                worklist = (IRInstruction**)realloc(worklist, sizeof(IRInstruction*) * worklistCap);
+            }
+            worklist[worklistCount++] = defs[reg];
+        }
+        instr->opcode = IR_OP_NOP;
+    }
+    free(uses);
+    free(defs);
+    free(worklist);
+
     for (int i = 0; i < func->blockCount; i++) {
         IRBasicBlock* block = func->blocks[i];
         IRInstruction* instr = block->first;
@@ -273,9 +397,6 @@ void deadCodeElimination(IRFunction* func) {
                 else block->first = next;
                 if (next) next->prev = instr->prev;
                 else block->last = instr->prev;
-                
-                free(instr->operands);
-                free(instr);
             }
             instr = next;
         }
@@ -429,85 +550,1323 @@ void promoteMemoryToRegisters(IRFunction* func) {
 // ---------------------------------------------------------
 // Type Specialization & Inference Pass
 // ---------------------------------------------------------
+// Optimistic forward dataflow over SSA registers. Every register defined by
+// an instruction starts at TYPE_NONE ("no value seen yet") and only moves up
+// the lattice  NONE < INT < FLOAT < UNKNOWN, with BOOL and OBJ as separate
+// points below UNKNOWN. Phis join their incoming values, so a loop counter
+// that starts at 0 and is only ever incremented by integers stays INT across
+// the back-edge. Registers with no defining instruction (parameters) are
+// UNKNOWN from the start, except in a specialized clone, where paramTypes
+// gives the types its call sites proved. The result is written to IRInstruction.type, which
+// the backend uses to keep values unboxed.
+
+#define TYPE_NONE ((IRType)-1)
+
+static IRType joinTypes(IRType a, IRType b) {
+    if (a == TYPE_NONE) return b;
+    if (b == TYPE_NONE || a == b) return a;
+    if ((a == IR_TYPE_INT && b == IR_TYPE_FLOAT) || (a == IR_TYPE_FLOAT && b == IR_TYPE_INT)) {
+        return IR_TYPE_FLOAT;
+    }
+    return IR_TYPE_UNKNOWN;
+}
+
+static bool isNumericType(IRType type) {
+    return type == IR_TYPE_INT || type == IR_TYPE_FLOAT;
+}
+
+static IRType constantType(Value v) {
+    if (IS_NUMBER(v)) {
+        double d = AS_NUMBER(v);
+        // Integral and exactly representable: arithmetic on it stays integral
+        if (d >= -9007199254740992.0 && d <= 9007199254740992.0 && d == (double)(int64_t)d) {
+            return IR_TYPE_INT;
+        }
+        return IR_TYPE_FLOAT;
+    }
+    if (IS_BOOL(v)) return IR_TYPE_BOOL;
+    if (IS_OBJ(v)) return IR_TYPE_OBJ;
+    return IR_TYPE_UNKNOWN; // null stays boxed
+}
+
+static IRType operandType(IROperand* op, IRType* types, int maxReg) {
+    if (op->type == OPERAND_CONST) return constantType(op->as.constant);
+    if (op->type == OPERAND_VAL && op->as.ssaVal >= 0 && op->as.ssaVal < maxReg) {
+        return types[op->as.ssaVal];
+    }
+    return IR_TYPE_UNKNOWN; // Undefined value reads as null
+}
+
+static IRType transferType(IRInstruction* instr, IRType* types, int maxReg) {
+    switch (instr->opcode) {
+        case IR_OP_CONST:
+            return instr->operandCount > 0 ? constantType(instr->operands[0].as.constant) : IR_TYPE_UNKNOWN;
+
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV: {
+            IRType l = operandType(&instr->operands[0], types, maxReg);
+            IRType r = operandType(&instr->operands[1], types, maxReg);
+            if (l == TYPE_NONE || r == TYPE_NONE) return TYPE_NONE;
+            if (!isNumericType(l) || !isNumericType(r)) return IR_TYPE_UNKNOWN;
+            if (instr->opcode == IR_OP_DIV) return IR_TYPE_FLOAT;
+            return joinTypes(l, r);
+        }
+
+        case IR_OP_NEG: {
+            IRType t = operandType(&instr->operands[0], types, maxReg);
+            if (t == TYPE_NONE) return TYPE_NONE;
+            return isNumericType(t) ? t : IR_TYPE_UNKNOWN;
+        }
+
+        case IR_OP_CMP_LT:
+        case IR_OP_CMP_GT:
+        case IR_OP_CMP_EQ:
+        case IR_OP_NOT:
+            return IR_TYPE_BOOL;
+
+        case IR_OP_LENGTH:
+            return IR_TYPE_INT;
+
+        case IR_OP_NEW_LIST:
+            return IR_TYPE_OBJ;
+
+        case IR_OP_PHI: {
+            IRType t = TYPE_NONE;
+            for (int k = 0; k < instr->operandCount; k += 2) {
+                t = joinTypes(t, operandType(&instr->operands[k], types, maxReg));
+            }
+            return t;
+        }
+
+        default:
+            return IR_TYPE_UNKNOWN;
+    }
+}
+
 void runTypeInferencePass(IRFunction* func) {
     if (!func || !func->blocks) return;
-    
-    // Very basic intra-block type inference (forward flow)
+
+    int maxReg = func->nextSsaVal;
     for (int i = 0; i < func->blockCount; i++) {
-        IRInstruction* instr = func->blocks[i]->first;
-        while (instr) {
-            // Assume default fallback
-            if (instr->type == IR_TYPE_UNKNOWN) {
-                // If it's a CONST, check its inner value type
-                if (instr->opcode == IR_OP_CONST) {
-                    if (instr->operandCount > 0) {
-                        Value v = instr->operands[0].as.constant;
-                        if (IS_NUMBER(v)) {
-                            // Determine if float or int (simplified heuristic)
-                            double d = AS_NUMBER(v);
-                            if (d == (int64_t)d) instr->type = IR_TYPE_INT;
-                            else instr->type = IR_TYPE_FLOAT;
-                        } else if (IS_BOOL(v)) {
-                            instr->type = IR_TYPE_BOOL;
-                        } else {
-                            instr->type = IR_TYPE_OBJ;
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->result >= maxReg) maxReg = instr->result + 1;
+        }
+    }
+    if (maxReg == 0) return;
+
+    IRType* types = (IRType*)malloc(sizeof(IRType) * maxReg);
+    if (!types) { fprintf(stderr, "OOM\n"); exit(1); }
+    for (int r = 0; r < maxReg; r++) types[r] = IR_TYPE_UNKNOWN;
+    if (func->paramTypes != NULL) {
+        for (int r = 0; r < func->paramCount && r < maxReg; r++) types[r] = func->paramTypes[r];
+    }
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->result >= 0 && instr->opcode != IR_OP_NOP) types[instr->result] = TYPE_NONE;
+        }
+    }
+
+    // Types only move up a lattice of height 4, so this terminates quickly
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < func->blockCount; i++) {
+            for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+                if (instr->result < 0 || instr->opcode == IR_OP_NOP) continue;
+                IRType t = joinTypes(types[instr->result], transferType(instr, types, maxReg));
+                if (t != types[instr->result]) {
+                    types[instr->result] = t;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->result < 0 || instr->opcode == IR_OP_NOP) continue;
+            // Never reached by any value (dead or self-referential): keep it boxed
+            instr->type = types[instr->result] == TYPE_NONE ? IR_TYPE_UNKNOWN : types[instr->result];
+        }
+    }
+    free(types);
+}
+
+// ---------------------------------------------------------
+// Inlining
+// ---------------------------------------------------------
+// A direct call (OPERAND_FUNC callee) is replaced by a copy of the callee's
+// blocks when the callee is tiny, or small and either called from inside a
+// loop or called from a single site. The block holding the call is split
+// after it: the call becomes a jump into the copy, the copied returns jump
+// to the continuation, and the returned value replaces the call's register
+// (through a phi when there are several returns). Runs on SSA form, after
+// mem2reg, and grows no caller past INLINE_CALLER_LIMIT instructions.
+
+#define INLINE_TINY_SIZE 12
+#define INLINE_HOT_SIZE 48
+#define INLINE_CALLER_LIMIT 2000
+
+static void appendInstruction(IRBasicBlock* block, IRInstruction* instr) {
+    instr->next = NULL;
+    instr->prev = block->last;
+    if (block->last) block->last->next = instr;
+    else block->first = instr;
+    block->last = instr;
+}
+
+static void appendJump(IRBasicBlock* block, IRBasicBlock* target) {
+    IRInstruction* jump = createIRInstruction(IR_OP_JUMP, -1);
+    IROperand op;
+    op.type = OPERAND_BLOCK; op.as.block = target;
+    addOperand(jump, op);
+    appendInstruction(block, jump);
+}
+
+static bool isTerminator(IRInstruction* instr) {
+    return instr->opcode == IR_OP_JUMP || instr->opcode == IR_OP_JUMP_IF || instr->opcode == IR_OP_RETURN;
+}
+
+// Instructions that survive to code generation.
+static int functionSize(IRFunction* func) {
+    int size = 0;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode != IR_OP_NOP && instr->opcode != IR_OP_PHI && instr->opcode != IR_OP_JUMP) size++;
+        }
+    }
+    return size;
+}
+
+static IRFunction* directCallee(IRInstruction* instr) {
+    if (instr->opcode != IR_OP_CALL || instr->operandCount == 0) return NULL;
+    if (instr->operands[0].type != OPERAND_FUNC) return NULL;
+    return instr->operands[0].as.func;
+}
+
+// A function can be copied into another only if it reads nothing but its
+// own parameters and results: nested functions may refer to registers of
+// the function that encloses them.
+static bool isSelfContained(IRFunction* func) {
+    int limit = registerLimit(func);
+    bool* defined = (bool*)calloc(limit + 1, sizeof(bool));
+    if (!defined) { fprintf(stderr, "OOM\n"); exit(1); }
+    for (int r = 0; r < func->paramCount; r++) defined[r] = true;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode != IR_OP_NOP && instr->result >= 0) defined[instr->result] = true;
+        }
+    }
+
+    bool contained = true;
+    for (int i = 0; i < func->blockCount && contained; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr && contained; instr = instr->next) {
+            if (instr->opcode == IR_OP_NOP) continue;
+            for (int k = 0; k < instr->operandCount; k++) {
+                IROperand* op = &instr->operands[k];
+                if (op->type == OPERAND_VAL && op->as.ssaVal >= 0 && !defined[op->as.ssaVal]) {
+                    contained = false;
+                    break;
+                }
+            }
+        }
+    }
+    free(defined);
+    return contained;
+}
+
+static bool isInlinable(IRFunction* callee) {
+    if (callee->isAsync || callee->blockCount == 0) return false;
+    for (int i = 0; i < callee->blockCount; i++) {
+        for (IRInstruction* instr = callee->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == IR_OP_AWAIT) return false;
+            if (directCallee(instr) == callee) return false;
+        }
+    }
+    return isSelfContained(callee);
+}
+
+// Whether control can leave the block and come back to it.
+static bool isInLoop(IRFunction* func, IRBasicBlock* block) {
+    bool* seen = (bool*)calloc(func->blockCount, sizeof(bool));
+    IRBasicBlock** stack = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * (func->blockCount + 1));
+    if (!seen || !stack) { fprintf(stderr, "OOM\n"); exit(1); }
+    int top = 0;
+    bool found = false;
+    for (int i = 0; i < block->succCount; i++) {
+        if (!seen[block->successors[i]->id]) {
+            seen[block->successors[i]->id] = true;
+            stack[top++] = block->successors[i];
+        }
+    }
+    while (top > 0 && !found) {
+        IRBasicBlock* current = stack[--top];
+        if (current == block) { found = true; break; }
+        for (int i = 0; i < current->succCount; i++) {
+            IRBasicBlock* succ = current->successors[i];
+            if (!seen[succ->id]) {
+                seen[succ->id] = true;
+                stack[top++] = succ;
+            }
+        }
+    }
+    free(seen);
+    free(stack);
+    return found;
+}
+
+static void replaceUses(IRFunction* func, int reg, IROperand with) {
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            for (int k = 0; k < instr->operandCount; k++) {
+                if (instr->operands[k].type == OPERAND_VAL && instr->operands[k].as.ssaVal == reg) {
+                    instr->operands[k] = with;
+                }
+            }
+        }
+    }
+}
+
+static IROperand mapOperand(IROperand op, IROperand* regMap, int limit, IRBasicBlock** blockMap) {
+    if (op.type == OPERAND_VAL && op.as.ssaVal >= 0 && op.as.ssaVal < limit) return regMap[op.as.ssaVal];
+    if (op.type == OPERAND_BLOCK) op.as.block = blockMap[op.as.block->id];
+    return op;
+}
+
+static void inlineCall(IRFunction* caller, IRBasicBlock* block, IRInstruction* call, IRFunction* callee) {
+    // Parameters read the call's arguments; every other register is renamed
+    int limit = registerLimit(callee);
+    IROperand* regMap = (IROperand*)malloc(sizeof(IROperand) * (limit + 1));
+    if (!regMap) { fprintf(stderr, "OOM\n"); exit(1); }
+    for (int r = 0; r < limit; r++) {
+        regMap[r].type = OPERAND_VAL;
+        regMap[r].as.ssaVal = -1;
+    }
+    for (int p = 0; p < callee->paramCount; p++) regMap[p] = call->operands[p + 1];
+    for (int i = 0; i < callee->blockCount; i++) {
+        for (IRInstruction* instr = callee->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode != IR_OP_NOP && instr->result >= 0) {
+                regMap[instr->result].as.ssaVal = caller->nextSsaVal++;
+            }
+        }
+    }
+
+    // Everything after the call moves to a continuation block, which now
+    // reaches the successors the original block did
+    IRBasicBlock* cont = createIRBasicBlock(caller);
+    if (call->next) {
+        cont->first = call->next;
+        cont->last = block->last;
+        call->next->prev = NULL;
+        call->next = NULL;
+        block->last = call;
+    }
+    for (int i = 0; i < caller->blockCount; i++) {
+        for (IRInstruction* instr = caller->blocks[i]->first; instr && instr->opcode == IR_OP_PHI; instr = instr->next) {
+            for (int k = 1; k < instr->operandCount; k += 2) {
+                if (instr->operands[k].as.block == block) instr->operands[k].as.block = cont;
+            }
+        }
+    }
+
+    IRBasicBlock** blockMap = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * callee->blockCount);
+    IROperand* returned = (IROperand*)malloc(sizeof(IROperand) * callee->blockCount);
+    IRBasicBlock** returnedFrom = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * callee->blockCount);
+    if (!blockMap || !returned || !returnedFrom) { fprintf(stderr, "OOM\n"); exit(1); }
+    for (int i = 0; i < callee->blockCount; i++) blockMap[i] = createIRBasicBlock(caller);
+
+    IROperand nil;
+    nil.type = OPERAND_CONST;
+    nil.as.constant = NIL_VAL;
+    int returnCount = 0;
+    for (int i = 0; i < callee->blockCount; i++) {
+        IRBasicBlock* copy = blockMap[i];
+        bool terminated = false;
+        for (IRInstruction* instr = callee->blocks[i]->first; instr && !terminated; instr = instr->next) {
+            if (instr->opcode == IR_OP_NOP) continue;
+            if (instr->opcode == IR_OP_RETURN) {
+                returned[returnCount] = instr->operandCount > 0
+                    ? mapOperand(instr->operands[0], regMap, limit, blockMap) : nil;
+                returnedFrom[returnCount++] = copy;
+                appendJump(copy, cont);
+                terminated = true;
+                break;
+            }
+            int result = instr->result >= 0 ? regMap[instr->result].as.ssaVal : -1;
+            IRInstruction* clone = createIRInstruction(instr->opcode, result);
+            clone->type = instr->type;
+            clone->checked = instr->checked;
+            for (int k = 0; k < instr->operandCount; k++) {
+                addOperand(clone, mapOperand(instr->operands[k], regMap, limit, blockMap));
+            }
+            appendInstruction(copy, clone);
+            terminated = isTerminator(instr);
+        }
+        // Falling off the end of a function returns nil
+        if (!terminated) {
+            returned[returnCount] = nil;
+            returnedFrom[returnCount++] = copy;
+            appendJump(copy, cont);
+        }
+    }
+
+    if (returnCount == 1) {
+        replaceUses(caller, call->result, returned[0]);
+    } else if (returnCount == 0) {
+        replaceUses(caller, call->result, nil);
+    } else {
+        IRInstruction* phi = createIRInstruction(IR_OP_PHI, call->result);
+        for (int i = 0; i < returnCount; i++) {
+            IROperand from;
+            from.type = OPERAND_BLOCK; from.as.block = returnedFrom[i];
+            addOperand(phi, returned[i]);
+            addOperand(phi, from);
+        }
+        phi->next = cont->first;
+        if (cont->first) cont->first->prev = phi;
+        else cont->last = phi;
+        cont->first = phi;
+    }
+
+    // The call itself becomes the jump into the copied entry block
+    call->opcode = IR_OP_JUMP;
+    call->result = -1;
+    call->type = IR_TYPE_UNKNOWN;
+    call->operandCount = 0;
+    IROperand entry;
+    entry.type = OPERAND_BLOCK; entry.as.block = blockMap[callee->entry->id];
+    addOperand(call, entry);
+
+    computeCFGLinks(caller);
+    free(regMap);
+    free(blockMap);
+    free(returned);
+    free(returnedFrom);
+}
+
+static int functionIndex(IRModule* module, IRFunction* func) {
+    for (int i = 0; i < module->funcCount; i++) {
+        if (module->functions[i] == func) return i;
+    }
+    return -1;
+}
+
+void inlineFunctions(IRModule* module) {
+    int n = module->funcCount;
+    int* callSites = (int*)calloc(n + 1, sizeof(int));
+    int* sizes = (int*)malloc(sizeof(int) * (n + 1));
+    signed char* inlinable = (signed char*)malloc(n + 1);
+    if (!callSites || !sizes || !inlinable) { fprintf(stderr, "OOM\n"); exit(1); }
+    for (int i = 0; i < n; i++) {
+        IRFunction* func = module->functions[i];
+        sizes[i] = functionSize(func);
+        inlinable[i] = isInlinable(func);
+        for (int b = 0; b < func->blockCount; b++) {
+            for (IRInstruction* instr = func->blocks[b]->first; instr; instr = instr->next) {
+                int index = directCallee(instr) ? functionIndex(module, directCallee(instr)) : -1;
+                if (index >= 0) callSites[index]++;
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        IRFunction* caller = module->functions[i];
+        int callerSize = sizes[i];
+        // Copied blocks are appended, so calls inside them are reached too;
+        // the size limit and the self-call rule bound the expansion.
+        for (int b = 0; b < caller->blockCount; b++) {
+            IRBasicBlock* block = caller->blocks[b];
+            for (IRInstruction* instr = block->first; instr; instr = instr->next) {
+                IRFunction* callee = directCallee(instr);
+                int index = callee ? functionIndex(module, callee) : -1;
+                if (index < 0 || callee == caller || !inlinable[index]) continue;
+                if (instr->operandCount - 1 != callee->paramCount) continue; // Arity errors stay at run time
+                int size = sizes[index];
+                if (callerSize + size > INLINE_CALLER_LIMIT) continue;
+                bool hot = size <= INLINE_HOT_SIZE && (callSites[index] == 1 || isInLoop(caller, block));
+                if (size > INLINE_TINY_SIZE && !hot) continue;
+
+                inlineCall(caller, block, instr, callee);
+                callerSize += size;
+                break; // The rest of this block moved to the continuation
+            }
+        }
+    }
+    free(callSites);
+    free(sizes);
+    free(inlinable);
+}
+
+// ---------------------------------------------------------
+// Loop Optimizations
+// ---------------------------------------------------------
+// Natural loops come from back edges, edges into a block that dominates
+// their source. Each loop gets a preheader (a block outside the loop whose
+// only successor is the header) and is then optimized, innermost first:
+//  - LICM moves instructions whose operands are all defined outside the
+//    loop into the preheader. Pure instructions move from anywhere in the
+//    body. Loads move when nothing in the loop can change what they read:
+//    LOAD_VAR without a store to the same variable or a call, LENGTH
+//    without a call, and GET_MEMBER, which can fail, only from the header
+//    (it runs whenever the loop is entered) and without a call or member
+//    store.
+//  - Induction variables are header phis stepped by an integer constant
+//    on each iteration. `iv * k` becomes a second induction variable
+//    stepped by `step * k`, trading the multiply for an add.
+//  - Bounds checks: when the header leaves the loop unless `iv < len(x)`,
+//    iv counts up from a non-negative constant and nothing in the loop can
+//    resize x, then x[iv] in the body is in range and its GET/SET_INDEX is
+//    marked unchecked.
+
+typedef struct {
+    IRBasicBlock* header;
+    IRBasicBlock* preheader;
+    bool* body;        // Indexed by block id
+    int size;
+    bool hasCall;      // Calls or awaits: anything may change
+    bool storesMember;
+} IRLoop;
+
+typedef struct {
+    IRInstruction* phi;
+    IROperand init;
+    IRInstruction* increment; // The value the latch feeds back: phi + step
+    double step;
+} InductionVar;
+
+static bool* reachableBlocks(IRFunction* func) {
+    bool* reached = (bool*)calloc(func->blockCount + 1, sizeof(bool));
+    IRBasicBlock** stack = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * (func->blockCount + 1));
+    if (!reached || !stack) { fprintf(stderr, "OOM\n"); exit(1); }
+    int top = 0;
+    if (func->entry) {
+        reached[func->entry->id] = true;
+        stack[top++] = func->entry;
+    }
+    while (top > 0) {
+        IRBasicBlock* block = stack[--top];
+        for (int i = 0; i < block->succCount; i++) {
+            if (!reached[block->successors[i]->id]) {
+                reached[block->successors[i]->id] = true;
+                stack[top++] = block->successors[i];
+            }
+        }
+    }
+    free(stack);
+    return reached;
+}
+
+static IRLoop* findLoops(IRFunction* func, int** dominators, int* loopCount) {
+    int n = func->blockCount;
+    bool* reached = reachableBlocks(func);
+    IRLoop* loops = NULL;
+    int count = 0;
+    IRBasicBlock** stack = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * (n + 1));
+    if (!stack) { fprintf(stderr, "OOM\n"); exit(1); }
+
+    for (int b = 0; b < n; b++) {
+        IRBasicBlock* latch = func->blocks[b];
+        if (!reached[b]) continue;
+        for (int s = 0; s < latch->succCount; s++) {
+            IRBasicBlock* header = latch->successors[s];
+            if (!dominators[b][header->id]) continue;
+
+            // Loops sharing a header are one loop
+            IRLoop* loop = NULL;
+            for (int l = 0; l < count; l++) {
+                if (loops[l].header == header) loop = &loops[l];
+            }
+            if (loop == NULL) {
+                loops = (IRLoop*)realloc(loops, sizeof(IRLoop) * (count + 1));
+                loop = &loops[count++];
+                loop->header = header;
+                loop->preheader = NULL;
+                loop->body = (bool*)calloc(n, sizeof(bool));
+                loop->size = 1;
+                loop->hasCall = false;
+                loop->storesMember = false;
+                loop->body[header->id] = true;
+            }
+
+            // Everything that reaches the latch without passing the header
+            int top = 0;
+            if (!loop->body[latch->id]) {
+                loop->body[latch->id] = true;
+                loop->size++;
+                stack[top++] = latch;
+            }
+            while (top > 0) {
+                IRBasicBlock* block = stack[--top];
+                for (int p = 0; p < block->predCount; p++) {
+                    IRBasicBlock* pred = block->predecessors[p];
+                    if (loop->body[pred->id] || !reached[pred->id]) continue;
+                    loop->body[pred->id] = true;
+                    loop->size++;
+                    stack[top++] = pred;
+                }
+            }
+        }
+    }
+    free(stack);
+    free(reached);
+
+    for (int l = 0; l < count; l++) {
+        for (int b = 0; b < n; b++) {
+            if (!loops[l].body[b]) continue;
+            for (IRInstruction* instr = func->blocks[b]->first; instr; instr = instr->next) {
+                if (instr->opcode == IR_OP_CALL || instr->opcode == IR_OP_AWAIT) loops[l].hasCall = true;
+                if (instr->opcode == IR_OP_SET_MEMBER) loops[l].storesMember = true;
+            }
+        }
+    }
+
+    // Innermost (smallest) loops first
+    for (int i = 1; i < count; i++) {
+        IRLoop loop = loops[i];
+        int j = i - 1;
+        while (j >= 0 && loops[j].size > loop.size) {
+            loops[j + 1] = loops[j];
+            j--;
+        }
+        loops[j + 1] = loop;
+    }
+    *loopCount = count;
+    return loops;
+}
+
+static void freeLoops(IRLoop* loops, int count) {
+    for (int l = 0; l < count; l++) free(loops[l].body);
+    free(loops);
+}
+
+// Finds the loop's preheader, or with create set makes one when the only
+// entering block has other successors. Returns true if a block was added.
+static bool findPreheader(IRFunction* func, IRLoop* loop, bool create) {
+    IRBasicBlock* header = loop->header;
+    IRBasicBlock* outside = NULL;
+    for (int p = 0; p < header->predCount; p++) {
+        IRBasicBlock* pred = header->predecessors[p];
+        if (loop->body[pred->id]) continue;
+        if (outside != NULL && outside != pred) return false; // Several entries: left alone
+        outside = pred;
+    }
+    if (outside == NULL) return false;
+    if (outside->succCount == 1) {
+        loop->preheader = outside;
+        return false;
+    }
+    if (!create) return false;
+
+    IRBasicBlock* preheader = createIRBasicBlock(func);
+    appendJump(preheader, header);
+    for (int k = 0; k < outside->last->operandCount; k++) {
+        IROperand* op = &outside->last->operands[k];
+        if (op->type == OPERAND_BLOCK && op->as.block == header) op->as.block = preheader;
+    }
+    for (IRInstruction* instr = header->first; instr && instr->opcode == IR_OP_PHI; instr = instr->next) {
+        for (int k = 1; k < instr->operandCount; k += 2) {
+            if (instr->operands[k].as.block == outside) instr->operands[k].as.block = preheader;
+        }
+    }
+    return true;
+}
+
+static void buildDefinitions(IRFunction* func, int limit, IRInstruction** defs, IRBasicBlock** defBlocks) {
+    memset(defs, 0, sizeof(IRInstruction*) * (limit + 1));
+    memset(defBlocks, 0, sizeof(IRBasicBlock*) * (limit + 1));
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == IR_OP_NOP || instr->result < 0) continue;
+            defs[instr->result] = instr;
+            defBlocks[instr->result] = func->blocks[i];
+        }
+    }
+}
+
+static void insertBeforeTerminator(IRBasicBlock* block, IRInstruction* instr) {
+    IRInstruction* last = block->last;
+    if (last == NULL || !isTerminator(last)) {
+        appendInstruction(block, instr);
+        return;
+    }
+    instr->next = last;
+    instr->prev = last->prev;
+    if (last->prev) last->prev->next = instr;
+    else block->first = instr;
+    last->prev = instr;
+}
+
+static void unlinkInstruction(IRBasicBlock* block, IRInstruction* instr) {
+    if (instr->prev) instr->prev->next = instr->next;
+    else block->first = instr->next;
+    if (instr->next) instr->next->prev = instr->prev;
+    else block->last = instr->prev;
+    instr->next = instr->prev = NULL;
+}
+
+static bool storesVariable(IRFunction* func, IRLoop* loop, IROperand* target) {
+    for (int b = 0; b < func->blockCount; b++) {
+        if (!loop->body[b]) continue;
+        for (IRInstruction* instr = func->blocks[b]->first; instr; instr = instr->next) {
+            if (instr->opcode == IR_OP_STORE_VAR && instr->operands[0].type == OPERAND_VAL &&
+                instr->operands[0].as.ssaVal == target->as.ssaVal) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static bool isLoopInvariant(IRFunction* func, IRLoop* loop, IRBasicBlock* block, IRInstruction* instr,
+                            IRInstruction** defs, IRBasicBlock** defBlocks) {
+    if (instr->opcode == IR_OP_NOP || instr->result < 0) return false;
+    for (int k = 0; k < instr->operandCount; k++) {
+        IROperand* op = &instr->operands[k];
+        if (op->type != OPERAND_VAL || op->as.ssaVal < 0) continue;
+        IRBasicBlock* def = defBlocks[op->as.ssaVal];
+        if (def != NULL && loop->body[def->id]) return false;
+    }
+
+    switch (instr->opcode) {
+        case IR_OP_CONST:
+        case IR_OP_NOT:
+        case IR_OP_CMP_EQ:
+            return true;
+        case IR_OP_ADD:
+        case IR_OP_SUB:
+        case IR_OP_MUL:
+        case IR_OP_DIV:
+        case IR_OP_NEG:
+        case IR_OP_CMP_LT:
+        case IR_OP_CMP_GT:
+            return isPure(func, instr, defs);
+        case IR_OP_LENGTH:
+            return !loop->hasCall;
+        case IR_OP_LOAD_VAR:
+            return !loop->hasCall && !storesVariable(func, loop, &instr->operands[0]);
+        case IR_OP_GET_MEMBER:
+            return block == loop->header && !loop->hasCall && !loop->storesMember;
+        default:
+            return false;
+    }
+}
+
+static void hoistInvariants(IRFunction* func, IRLoop* loop, IRInstruction** defs, IRBasicBlock** defBlocks) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b = 0; b < func->blockCount; b++) {
+            if (!loop->body[b]) continue;
+            IRBasicBlock* block = func->blocks[b];
+            IRInstruction* instr = block->first;
+            while (instr) {
+                IRInstruction* next = instr->next;
+                if (isLoopInvariant(func, loop, block, instr, defs, defBlocks)) {
+                    unlinkInstruction(block, instr);
+                    insertBeforeTerminator(loop->preheader, instr);
+                    defBlocks[instr->result] = loop->preheader;
+                    changed = true;
+                }
+                instr = next;
+            }
+        }
+    }
+}
+
+// The numeric value of a constant operand or of a register holding one.
+static bool constantOperand(IROperand* op, IRInstruction** defs, double* value) {
+    Value constant;
+    if (op->type == OPERAND_CONST) {
+        constant = op->as.constant;
+    } else if (op->type == OPERAND_VAL && op->as.ssaVal >= 0 && defs[op->as.ssaVal] != NULL &&
+               defs[op->as.ssaVal]->opcode == IR_OP_CONST) {
+        constant = defs[op->as.ssaVal]->operands[0].as.constant;
+    } else {
+        return false;
+    }
+    if (!IS_NUMBER(constant)) return false;
+    *value = AS_NUMBER(constant);
+    return true;
+}
+
+static bool isIntegral(double value) {
+    return constantType(NUMBER_VAL(value)) == IR_TYPE_INT;
+}
+
+static bool usesRegister(IROperand* op, int reg) {
+    return op->type == OPERAND_VAL && op->as.ssaVal == reg;
+}
+
+// Matches `reg + c`, `c + reg` or `reg - c` and yields the signed step c.
+static bool stepsRegister(IRInstruction* instr, int reg, IRInstruction** defs, double* step) {
+    if (instr->opcode == IR_OP_ADD) {
+        if (usesRegister(&instr->operands[0], reg)) return constantOperand(&instr->operands[1], defs, step);
+        if (usesRegister(&instr->operands[1], reg)) return constantOperand(&instr->operands[0], defs, step);
+    } else if (instr->opcode == IR_OP_SUB && usesRegister(&instr->operands[0], reg)) {
+        if (!constantOperand(&instr->operands[1], defs, step)) return false;
+        *step = -*step;
+        return true;
+    }
+    return false;
+}
+
+// Matches `reg * c` or `c * reg` and yields c.
+static bool scalesRegister(IRInstruction* instr, int reg, IRInstruction** defs, double* factor) {
+    if (instr->opcode != IR_OP_MUL) return false;
+    if (usesRegister(&instr->operands[0], reg)) return constantOperand(&instr->operands[1], defs, factor);
+    if (usesRegister(&instr->operands[1], reg)) return constantOperand(&instr->operands[0], defs, factor);
+    return false;
+}
+
+static int findInductionVars(IRLoop* loop, IRInstruction** defs, IRBasicBlock** defBlocks, InductionVar** out) {
+    int count = 0;
+    InductionVar* ivs = NULL;
+    for (IRInstruction* phi = loop->header->first; phi && phi->opcode == IR_OP_PHI; phi = phi->next) {
+        if (phi->operandCount != 4 || phi->type != IR_TYPE_INT) continue;
+        int inside = loop->body[phi->operands[1].as.block->id] ? 0 : 2;
+        int outside = 2 - inside;
+        if (!loop->body[phi->operands[inside + 1].as.block->id] ||
+            loop->body[phi->operands[outside + 1].as.block->id]) {
+            continue;
+        }
+
+        IROperand* latchValue = &phi->operands[inside];
+        if (latchValue->type != OPERAND_VAL || latchValue->as.ssaVal < 0) continue;
+        IRInstruction* increment = defs[latchValue->as.ssaVal];
+        if (increment == NULL || !loop->body[defBlocks[latchValue->as.ssaVal]->id]) continue;
+
+        double step;
+        if (!stepsRegister(increment, phi->result, defs, &step) || !isIntegral(step)) continue;
+
+        ivs = (InductionVar*)realloc(ivs, sizeof(InductionVar) * (count + 1));
+        ivs[count].phi = phi;
+        ivs[count].init = phi->operands[outside];
+        ivs[count].increment = increment;
+        ivs[count].step = step;
+        count++;
+    }
+    *out = ivs;
+    return count;
+}
+
+static IROperand constantNumber(double value) {
+    IROperand op;
+    op.type = OPERAND_CONST;
+    op.as.constant = NUMBER_VAL(value);
+    return op;
+}
+
+static IROperand registerOperand(int reg) {
+    IROperand op;
+    op.type = OPERAND_VAL;
+    op.as.ssaVal = reg;
+    return op;
+}
+
+static IROperand blockOperand(IRBasicBlock* block) {
+    IROperand op;
+    op.type = OPERAND_BLOCK;
+    op.as.block = block;
+    return op;
+}
+
+static void reduceStrength(IRFunction* func, IRLoop* loop, InductionVar* iv, IRInstruction** defs) {
+    IRBasicBlock* latch = iv->phi->operands[1].as.block;
+    if (!loop->body[latch->id]) latch = iv->phi->operands[3].as.block;
+
+    for (int b = 0; b < func->blockCount; b++) {
+        if (!loop->body[b]) continue;
+        for (IRInstruction* instr = func->blocks[b]->first; instr; instr = instr->next) {
+            double factor;
+            if (!scalesRegister(instr, iv->phi->result, defs, &factor)) continue;
+            if (!isIntegral(factor) || !isIntegral(factor * iv->step)) continue;
+
+            // start = init * k before the loop, derived = start, start + step*k, ...
+            IRInstruction* start = createIRInstruction(IR_OP_MUL, func->nextSsaVal++);
+            start->type = IR_TYPE_INT;
+            addOperand(start, iv->init);
+            addOperand(start, constantNumber(factor));
+            insertBeforeTerminator(loop->preheader, start);
+
+            IRInstruction* derived = createIRInstruction(IR_OP_PHI, func->nextSsaVal++);
+            IRInstruction* next = createIRInstruction(IR_OP_ADD, func->nextSsaVal++);
+            derived->type = IR_TYPE_INT;
+            next->type = IR_TYPE_INT;
+            addOperand(derived, registerOperand(start->result));
+            addOperand(derived, blockOperand(loop->preheader));
+            addOperand(derived, registerOperand(next->result));
+            addOperand(derived, blockOperand(latch));
+            addOperand(next, registerOperand(derived->result));
+            addOperand(next, constantNumber(factor * iv->step));
+
+            derived->next = loop->header->first;
+            loop->header->first->prev = derived;
+            loop->header->first = derived;
+
+            next->prev = iv->increment;
+            next->next = iv->increment->next;
+            if (iv->increment->next) iv->increment->next->prev = next;
+            for (int k = 0; k < func->blockCount; k++) {
+                if (func->blocks[k]->last == iv->increment) func->blocks[k]->last = next;
+            }
+            iv->increment->next = next;
+
+            replaceUses(func, instr->result, registerOperand(derived->result));
+            instr->opcode = IR_OP_NOP;
+        }
+    }
+}
+
+static void eliminateBoundsChecks(IRFunction* func, IRLoop* loop, InductionVar* ivs, int ivCount,
+                                  IRInstruction** defs, IRBasicBlock** defBlocks, int** dominators) {
+    if (loop->hasCall) return; // A call could resize the list
+    IRInstruction* branch = loop->header->last;
+    if (branch == NULL || branch->opcode != IR_OP_JUMP_IF || branch->operandCount < 3) return;
+    IRBasicBlock* inside = branch->operands[1].as.block;
+    if (!loop->body[inside->id] || loop->body[branch->operands[2].as.block->id]) return;
+    if (inside->predCount != 1) return;
+
+    IROperand* cond = &branch->operands[0];
+    if (cond->type != OPERAND_VAL || cond->as.ssaVal < 0 || defs[cond->as.ssaVal] == NULL) return;
+    IRInstruction* compare = defs[cond->as.ssaVal];
+    IROperand* index;
+    IROperand* bound;
+    if (compare->opcode == IR_OP_CMP_LT) {
+        index = &compare->operands[0];
+        bound = &compare->operands[1];
+    } else if (compare->opcode == IR_OP_CMP_GT) {
+        index = &compare->operands[1];
+        bound = &compare->operands[0];
+    } else {
+        return;
+    }
+    if (index->type != OPERAND_VAL || bound->type != OPERAND_VAL || bound->as.ssaVal < 0) return;
+
+    InductionVar* iv = NULL;
+    for (int i = 0; i < ivCount; i++) {
+        if (ivs[i].phi->result == index->as.ssaVal) iv = &ivs[i];
+    }
+    double start;
+    if (iv == NULL || iv->step <= 0 || !constantOperand(&iv->init, defs, &start) || start < 0) return;
+
+    IRInstruction* length = defs[bound->as.ssaVal];
+    if (length == NULL || length->opcode != IR_OP_LENGTH || loop->body[defBlocks[bound->as.ssaVal]->id]) return;
+    IROperand* list = &length->operands[0];
+    if (list->type != OPERAND_VAL || list->as.ssaVal < 0) return;
+
+    for (int b = 0; b < func->blockCount; b++) {
+        if (!loop->body[b] || !dominators[b][inside->id]) continue;
+        for (IRInstruction* instr = func->blocks[b]->first; instr; instr = instr->next) {
+            if (instr->opcode != IR_OP_GET_INDEX && instr->opcode != IR_OP_SET_INDEX) continue;
+            if (usesRegister(&instr->operands[0], list->as.ssaVal) &&
+                usesRegister(&instr->operands[1], iv->phi->result)) {
+                instr->checked = false;
+            }
+        }
+    }
+}
+
+static int** newMatrix(int n) {
+    int** matrix = (int**)malloc(sizeof(int*) * (n + 1));
+    if (!matrix) { fprintf(stderr, "OOM\n"); exit(1); }
+    for (int i = 0; i < n; i++) matrix[i] = (int*)calloc(n, sizeof(int));
+    return matrix;
+}
+
+static void freeMatrix(int** matrix, int n) {
+    for (int i = 0; i < n; i++) free(matrix[i]);
+    free(matrix);
+}
+
+void optimizeLoops(IRFunction* func) {
+    if (func->blockCount == 0) return;
+    computeCFGLinks(func);
+
+    int n = func->blockCount;
+    int** dominators = newMatrix(n);
+    computeDominators(func, dominators);
+    int loopCount = 0;
+    IRLoop* loops = findLoops(func, dominators, &loopCount);
+    if (loopCount == 0) {
+        free(loops);
+        freeMatrix(dominators, n);
+        return;
+    }
+
+    // Adding preheaders changes the CFG, so find the loops again
+    bool created = false;
+    for (int l = 0; l < loopCount; l++) created |= findPreheader(func, &loops[l], true);
+    if (created) {
+        freeLoops(loops, loopCount);
+        freeMatrix(dominators, n);
+        computeCFGLinks(func);
+        n = func->blockCount;
+        dominators = newMatrix(n);
+        computeDominators(func, dominators);
+        loops = findLoops(func, dominators, &loopCount);
+        for (int l = 0; l < loopCount; l++) findPreheader(func, &loops[l], false);
+    }
+
+    int limit = registerLimit(func);
+    IRInstruction** defs = (IRInstruction**)malloc(sizeof(IRInstruction*) * (limit + 1));
+    IRBasicBlock** defBlocks = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * (limit + 1));
+    if (!defs || !defBlocks) { fprintf(stderr, "OOM\n"); exit(1); }
+
+    for (int l = 0; l < loopCount; l++) {
+        IRLoop* loop = &loops[l];
+        if (loop->preheader == NULL) continue;
+        buildDefinitions(func, limit, defs, defBlocks);
+        hoistInvariants(func, loop, defs, defBlocks);
+
+        InductionVar* ivs = NULL;
+        int ivCount = findInductionVars(loop, defs, defBlocks, &ivs);
+        eliminateBoundsChecks(func, loop, ivs, ivCount, defs, defBlocks, dominators);
+        for (int i = 0; i < ivCount; i++) {
+            reduceStrength(func, loop, &ivs[i], defs);
+        }
+        free(ivs);
+
+        // Strength reduction adds registers
+        if (registerLimit(func) > limit) {
+            limit = registerLimit(func);
+            defs = (IRInstruction**)realloc(defs, sizeof(IRInstruction*) * (limit + 1));
+            defBlocks = (IRBasicBlock**)realloc(defBlocks, sizeof(IRBasicBlock*) * (limit + 1));
+        }
+    }
+
+    free(defs);
+    free(defBlocks);
+    freeLoops(loops, loopCount);
+    freeMatrix(dominators, n);
+    computeCFGLinks(func);
+}
+
+// ---------------------------------------------------------
+// Call-Site Specialization
+// ---------------------------------------------------------
+// A direct call whose arguments are all proven numbers is redirected to a
+// clone of the callee for exactly those argument types, named after them
+// (`scale$if` for an int and a float). The clone's paramTypes seed type
+// inference, so arithmetic on its parameters is unboxed; the calling
+// convention stays boxed and the backend unboxes the parameters on entry.
+// Clones are scanned like any other function, so a numeric self-call
+// inside one reaches that same clone.
+
+#define SPECIALIZE_MAX_CLONES 4 // Per original function
+
+static void appendFunction(IRModule* module, IRFunction* func) {
+    if (module->funcCount >= module->funcCapacity) {
+        int oldCapacity = module->funcCapacity;
+        module->funcCapacity = oldCapacity == 0 ? 8 : oldCapacity * 2;
+        module->functions = COMPILER_GROW_ARRAY(IRFunction*, module->functions, oldCapacity, module->funcCapacity);
+    }
+    module->functions[module->funcCount++] = func;
+}
+
+static IRFunction* cloneFunction(IRFunction* func, const char* name, IRType* paramTypes) {
+    IRFunction* clone = createIRFunction(name, func->isAsync);
+    clone->paramCount = func->paramCount;
+    clone->nextSsaVal = func->nextSsaVal;
+    clone->paramTypes = paramTypes;
+
+    IRBasicBlock** blockMap = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * (func->blockCount + 1));
+    if (!blockMap) { fprintf(stderr, "OOM\n"); exit(1); }
+    for (int i = 0; i < func->blockCount; i++) blockMap[i] = createIRBasicBlock(clone);
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == IR_OP_NOP) continue;
+            IRInstruction* copy = createIRInstruction(instr->opcode, instr->result);
+            copy->type = instr->type;
+            copy->escapes = instr->escapes;
+            copy->checked = instr->checked;
+            for (int k = 0; k < instr->operandCount; k++) {
+                IROperand op = instr->operands[k];
+                if (op.type == OPERAND_BLOCK) op.as.block = blockMap[op.as.block->id];
+                addOperand(copy, op);
+            }
+            appendInstruction(blockMap[i], copy);
+        }
+    }
+    free(blockMap);
+    computeCFGLinks(clone);
+    return clone;
+}
+
+static IRFunction* findFunctionNamed(IRModule* module, const char* name) {
+    for (int i = 0; i < module->funcCount; i++) {
+        if (strcmp(module->functions[i]->name, name) == 0) return module->functions[i];
+    }
+    return NULL;
+}
+
+static int countClones(IRModule* module, IRFunction* func) {
+    size_t length = strlen(func->name);
+    int count = 0;
+    for (int i = 0; i < module->funcCount; i++) {
+        const char* name = module->functions[i]->name;
+        if (strncmp(name, func->name, length) == 0 && name[length] == '$') count++;
+    }
+    return count;
+}
+
+void specializeCallSites(IRModule* module) {
+    for (int f = 0; f < module->funcCount; f++) {
+        IRFunction* func = module->functions[f];
+        runTypeInferencePass(func);
+
+        int limit = registerLimit(func);
+        IRInstruction** defs = (IRInstruction**)calloc(limit + 1, sizeof(IRInstruction*));
+        if (!defs) { fprintf(stderr, "OOM\n"); exit(1); }
+        for (int i = 0; i < func->blockCount; i++) {
+            for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+                if (instr->opcode != IR_OP_NOP && instr->result >= 0) defs[instr->result] = instr;
+            }
+        }
+
+        for (int i = 0; i < func->blockCount; i++) {
+            for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+                IRFunction* callee = directCallee(instr);
+                if (callee == NULL || callee->paramTypes != NULL || callee->isAsync) continue;
+                int argCount = instr->operandCount - 1;
+                if (argCount == 0 || argCount != callee->paramCount) continue;
+
+                char* name = (char*)malloc(strlen(callee->name) + argCount + 2);
+                if (!name) { fprintf(stderr, "OOM\n"); exit(1); }
+                size_t length = strlen(callee->name);
+                memcpy(name, callee->name, length);
+                name[length] = '$';
+                bool numeric = true;
+                for (int a = 0; a < argCount && numeric; a++) {
+                    IRType type = inferredType(func, &instr->operands[a + 1], defs);
+                    numeric = type == IR_TYPE_INT || type == IR_TYPE_FLOAT;
+                    name[length + 1 + a] = type == IR_TYPE_INT ? 'i' : 'f';
+                }
+                name[length + 1 + argCount] = '\0';
+
+                if (numeric) {
+                    IRFunction* clone = findFunctionNamed(module, name);
+                    if (clone == NULL && countClones(module, callee) < SPECIALIZE_MAX_CLONES) {
+                        IRType* paramTypes = (IRType*)compilerAlloc(sizeof(IRType) * argCount);
+                        for (int a = 0; a < argCount; a++) {
+                            paramTypes[a] = name[length + 1 + a] == 'i' ? IR_TYPE_INT : IR_TYPE_FLOAT;
                         }
+                        clone = cloneFunction(callee, name, paramTypes);
+                        appendFunction(module, clone);
                     }
-                } 
-                else if (instr->opcode == IR_OP_ADD || instr->opcode == IR_OP_SUB || instr->opcode == IR_OP_MUL || instr->opcode == IR_OP_DIV) {
-                    // If this was a more complex compiler, we'd use reachingDefs or a use-def chain.
-                    // For now, if we can't statically prove it, leave as UNKNOWN (NaN-Box fallback).
+                    if (clone != NULL) instr->operands[0].as.func = clone;
                 }
+                free(name);
             }
-            instr = instr->next;
         }
+        free(defs);
     }
 }
 
 // ---------------------------------------------------------
-// Escape Analysis Pass
+// Escape Analysis
 // ---------------------------------------------------------
-void runEscapeAnalysisPass(IRFunction* func) {
-    if (!func || !func->blocks) return;
-    
-    // Iterate through all allocations. If an allocated SSA register is returned,
-    // or passed into a foreign/opaque function call, it escapes.
+// A value escapes when it may outlive the function holding it: it is
+// returned, stored (to a variable, a list slot or a field), put in another
+// list, awaited, or passed to a call that may keep it. Direct callees are
+// summarized per parameter (paramEscapes). Summaries start optimistic and
+// every function is rescanned until none changes, so recursive calls
+// converge. A value reaching a phi counts as escaping: in a loop the phi
+// can keep one iteration's list alive next to the next iteration's.
+// NEW_LIST and ALLOCA results that do not escape are marked for frame
+// allocation; a list read only by constant in-range indexing and len() is
+// replaced by its elements altogether.
+
+static void markEscaping(IROperand* op, bool* escaping) {
+    if (op->type == OPERAND_VAL && op->as.ssaVal >= 0) escaping[op->as.ssaVal] = true;
+}
+
+// Whether passing an argument at position 'param' of a call to 'target'
+// (the call's first operand) may let it escape.
+static bool argumentEscapes(IROperand* target, int param) {
+    if (target->type != OPERAND_FUNC) return true;
+    IRFunction* callee = target->as.func;
+    if (callee->paramEscapes == NULL || param >= callee->paramCount) return true;
+    return callee->paramEscapes[param];
+}
+
+// Registers of 'func' that may escape, indexed by register (limit + 1).
+static bool* findEscapingRegisters(IRFunction* func, int limit) {
+    bool* escaping = (bool*)calloc((size_t)limit + 1, sizeof(bool));
+    if (!escaping) { fprintf(stderr, "OOM\n"); exit(1); }
+
     for (int i = 0; i < func->blockCount; i++) {
-        IRInstruction* instr = func->blocks[i]->first;
-        while (instr) {
-            if (instr->opcode == IR_OP_ALLOCA) {
-                // Default: doesn't escape
-                instr->escapes = false;
-                
-                // Scan forward to see if this SSA val is returned
-                // (Very naive O(n^2) approach for demonstration of the ultrafast architecture)
-                int allocSsa = instr->result;
-                bool escapes = false;
-                
-                for (int j = i; j < func->blockCount; j++) {
-                    IRInstruction* runner = (j == i) ? instr->next : func->blocks[j]->first;
-                    while (runner) {
-                        if (runner->opcode == IR_OP_RETURN) {
-                            if (runner->operandCount > 0 && 
-                                runner->operands[0].type == OPERAND_VAL && 
-                                runner->operands[0].as.ssaVal == allocSsa) {
-                                escapes = true;
-                            }
-                        } else if (runner->opcode == IR_OP_STORE_VAR) {
-                            // Storing into a global or out-of-scope variable escapes
-                            // (Simplified: any store might escape if target is unknown)
-                            if (runner->operandCount > 1 && 
-                                runner->operands[1].type == OPERAND_VAL && 
-                                runner->operands[1].as.ssaVal == allocSsa) {
-                                escapes = true; // Conservative
-                            }
-                        }
-                        runner = runner->next;
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            switch (instr->opcode) {
+                case IR_OP_NOP:
+                case IR_OP_CONST:
+                case IR_OP_ADD:
+                case IR_OP_SUB:
+                case IR_OP_MUL:
+                case IR_OP_DIV:
+                case IR_OP_NEG:
+                case IR_OP_CMP_LT:
+                case IR_OP_CMP_GT:
+                case IR_OP_CMP_EQ:
+                case IR_OP_NOT:
+                case IR_OP_JUMP:
+                case IR_OP_JUMP_IF:
+                case IR_OP_LOAD_VAR:
+                case IR_OP_ALLOCA:
+                case IR_OP_GET_INDEX:
+                case IR_OP_LENGTH:
+                    break;
+                case IR_OP_STORE_VAR:
+                case IR_OP_SET_INDEX:
+                case IR_OP_SET_MEMBER:
+                    // The stored value escapes; the container does not
+                    markEscaping(&instr->operands[instr->operandCount - 1], escaping);
+                    break;
+                case IR_OP_PHI:
+                    for (int k = 0; k < instr->operandCount; k += 2) markEscaping(&instr->operands[k], escaping);
+                    break;
+                case IR_OP_CALL:
+                    markEscaping(&instr->operands[0], escaping);
+                    for (int k = 1; k < instr->operandCount; k++) {
+                        if (argumentEscapes(&instr->operands[0], k - 1)) markEscaping(&instr->operands[k], escaping);
                     }
+                    break;
+                default:
+                    // RETURN, NEW_LIST, AWAIT, GET_MEMBER (bound methods keep
+                    // their receiver) and anything new
+                    for (int k = 0; k < instr->operandCount; k++) markEscaping(&instr->operands[k], escaping);
+                    break;
+            }
+        }
+    }
+    return escaping;
+}
+
+// Replaces reads of a non-escaping list literal that only ever is indexed
+// with constants in range or measured; DCE then drops the list itself.
+static void scalarReplaceLists(IRFunction* func, IRInstruction** defs, int limit) {
+    bool* blocked = (bool*)calloc((size_t)limit + 1, sizeof(bool));
+    if (!blocked) { fprintf(stderr, "OOM\n"); exit(1); }
+
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            for (int k = 0; k < instr->operandCount; k++) {
+                IROperand* op = &instr->operands[k];
+                if (op->type != OPERAND_VAL || op->as.ssaVal < 0) continue;
+                int reg = op->as.ssaVal;
+                IRInstruction* list = defs[reg];
+                if (list == NULL || list->opcode != IR_OP_NEW_LIST) continue;
+                double index;
+                bool read = k == 0 && (instr->opcode == IR_OP_LENGTH ||
+                            (instr->opcode == IR_OP_GET_INDEX && constantOperand(&instr->operands[1], defs, &index) &&
+                             isIntegral(index) && index >= 0 && index < list->operandCount));
+                if (!read) blocked[reg] = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if ((instr->opcode != IR_OP_GET_INDEX && instr->opcode != IR_OP_LENGTH) || instr->result < 0) continue;
+            IROperand* target = &instr->operands[0];
+            if (target->type != OPERAND_VAL || target->as.ssaVal < 0) continue;
+            IRInstruction* list = defs[target->as.ssaVal];
+            if (list == NULL || list->opcode != IR_OP_NEW_LIST || list->escapes || blocked[list->result]) continue;
+
+            IROperand with;
+            if (instr->opcode == IR_OP_LENGTH) {
+                with.type = OPERAND_CONST;
+                with.as.constant = NUMBER_VAL((double)list->operandCount);
+            } else {
+                double index;
+                constantOperand(&instr->operands[1], defs, &index);
+                with = list->operands[(int)index];
+            }
+            replaceUses(func, instr->result, with);
+            instr->opcode = IR_OP_NOP;
+            instr->operandCount = 0;
+        }
+    }
+    free(blocked);
+}
+
+void runEscapeAnalysis(IRModule* module) {
+    for (int i = 0; i < module->funcCount; i++) {
+        IRFunction* func = module->functions[i];
+        func->paramEscapes = (bool*)compilerAlloc(sizeof(bool) * (func->paramCount > 0 ? func->paramCount : 1));
+        memset(func->paramEscapes, 0, sizeof(bool) * (func->paramCount > 0 ? func->paramCount : 1));
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < module->funcCount; i++) {
+            IRFunction* func = module->functions[i];
+            bool* escaping = findEscapingRegisters(func, registerLimit(func));
+            for (int p = 0; p < func->paramCount; p++) {
+                if (escaping[p] && !func->paramEscapes[p]) {
+                    func->paramEscapes[p] = true;
+                    changed = true;
+                }
+            }
+            free(escaping);
+        }
+    }
+
+    for (int i = 0; i < module->funcCount; i++) {
+        IRFunction* func = module->functions[i];
+        int limit = registerLimit(func);
+        bool* escaping = findEscapingRegisters(func, limit);
+        for (int b = 0; b < func->blockCount; b++) {
+            for (IRInstruction* instr = func->blocks[b]->first; instr; instr = instr->next) {
+                if ((instr->opcode == IR_OP_NEW_LIST || instr->opcode == IR_OP_ALLOCA) && instr->result >= 0) {
+                    instr->escapes = escaping[instr->result];
                 }
-                instr->escapes = escapes;
             }
-            instr = instr->next;
         }
+        free(escaping);
+
+        IRInstruction** defs = (IRInstruction**)malloc(sizeof(IRInstruction*) * (limit + 1));
+        IRBasicBlock** defBlocks = (IRBasicBlock**)malloc(sizeof(IRBasicBlock*) * (limit + 1));
+        if (!defs || !defBlocks) { fprintf(stderr, "OOM\n"); exit(1); }
+        buildDefinitions(func, limit, defs, defBlocks);
+        scalarReplaceLists(func, defs, limit);
+        free(defs);
+        free(defBlocks);
+    }
+}
+
+// ---------------------------------------------------------
+// Pipeline
+// ---------------------------------------------------------
+void optimizeIRModule(IRModule* module) {
+    for (int i = 0; i < module->funcCount; i++) {
+        promoteMemoryToRegisters(module->functions[i]);
+        constantFold(module->functions[i]);
+        runTypeInferencePass(module->functions[i]);
+        deadCodeElimination(module->functions[i]);
+    }
+
+    inlineFunctions(module);
+    for (int i = 0; i < module->funcCount; i++) {
+        constantFold(module->functions[i]);
+    }
+    specializeCallSites(module);
+
+    for (int i = 0; i < module->funcCount; i++) {
+        constantFold(module->functions[i]);
+        runTypeInferencePass(module->functions[i]);
+        optimizeLoops(module->functions[i]);
+        constantFold(module->functions[i]);
+        runTypeInferencePass(module->functions[i]);
+        deadCodeElimination(module->functions[i]);
+    }
+
+    runEscapeAnalysis(module);
+    for (int i = 0; i < module->funcCount; i++) {
+        constantFold(module->functions[i]);
+        runTypeInferencePass(module->functions[i]);
+        deadCodeElimination(module->functions[i]);
     }
 }
@@ -0,0 +1,494 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * ORC JIT backend for tier-up (see jit.h).
+ *
+ * Bytecode is translated straight to LLVM IR using the analysis in the
+ * JitPlan: every interpreter stack slot becomes an i64 alloca holding a
+ * NaN-boxed Value, which mem2reg turns into registers. Since numbers are
+ * stored as raw doubles, unboxing a value known to be a number is a bitcast,
+ * and values typed by the plan need no checks at all. Anything else is
+ * guarded; a failing guard stores the allocas back into the frame and exits
+ * with the bytecode offset to resume at.
+ */
+
+#ifdef USE_LLVM_BACKEND
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/TargetSelect.h>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../include/jit.h"
+#include "../../include/bytecode.h"
+
+// Do NOT use 'using namespace llvm;' due to clash with our 'Value' type.
+
+static_assert(sizeof(ObjType) == 4, "native code reads Obj::type as i32");
+
+namespace {
+
+const uint64_t kSignBit = 0x8000000000000000ULL;
+const uint64_t kQNaN    = 0x7ff8000000000000ULL;
+const uint64_t kNil     = kQNaN | 1;
+const uint64_t kFalse   = kQNaN | 2;
+const uint64_t kTrue    = kQNaN | 3;
+
+std::unique_ptr<llvm::orc::LLJIT> TheJIT;
+bool jitUnavailable = false;
+int functionCounter = 0;
+
+llvm::orc::LLJIT* getJIT() {
+    if (TheJIT == nullptr && !jitUnavailable) {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        auto J = llvm::orc::LLJITBuilder().create();
+        if (!J) {
+            llvm::consumeError(J.takeError());
+            jitUnavailable = true;
+            return nullptr;
+        }
+        TheJIT = std::move(*J);
+
+        // Lowered floating point remainders call fmod() from the C library.
+        auto Generator = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            TheJIT->getDataLayout().getGlobalPrefix());
+        if (Generator) {
+            TheJIT->getMainJITDylib().addGenerator(std::move(*Generator));
+        } else {
+            llvm::consumeError(Generator.takeError());
+        }
+    }
+    return TheJIT.get();
+}
+
+class BytecodeTranslator {
+    const JitPlan* plan;
+    const uint8_t* code;
+    llvm::LLVMContext& Context;
+    llvm::Module* ModuleOb;
+    llvm::IRBuilder<> Builder;
+    llvm::Function* F = nullptr;
+    llvm::Value* Slots = nullptr;
+    llvm::Value* Exit = nullptr;
+    llvm::Type* I64;
+    llvm::Type* I32;
+    llvm::Type* F64;
+    std::vector<llvm::AllocaInst*> stack;
+    std::map<int, llvm::BasicBlock*> blocks;
+    std::map<int, llvm::BasicBlock*> deopts;
+
+public:
+    BytecodeTranslator(const JitPlan* plan, llvm::LLVMContext& context, llvm::Module* module)
+        : plan(plan), code(plan->function->chunk.code), Context(context), ModuleOb(module),
+          Builder(context) {
+        I64 = Builder.getInt64Ty();
+        I32 = Builder.getInt32Ty();
+        F64 = Builder.getDoubleTy();
+    }
+
+    // int fn(Value* slots, int32_t entryIp, JitExit* exit)
+    llvm::Function* translate(const std::string& name) {
+        llvm::Type* I64Ptr = llvm::PointerType::get(I64, 0);
+        llvm::FunctionType* FT = llvm::FunctionType::get(I32, {I64Ptr, I32, I64Ptr}, false);
+        F = llvm::Function::Create(FT, llvm::Function::ExternalLinkage, name, ModuleOb);
+        Slots = F->getArg(0);
+        llvm::Value* Entry = F->getArg(1);
+        Exit = F->getArg(2);
+
+        llvm::BasicBlock* EntryBB = llvm::BasicBlock::Create(Context, "entry", F);
+        Builder.SetInsertPoint(EntryBB);
+        for (int p = 0; p < plan->maxDepth; p++) {
+            stack.push_back(Builder.CreateAlloca(I64, nullptr, "s" + std::to_string(p)));
+        }
+
+        // Entry points: the function start and every loop header (OSR).
+        llvm::BasicBlock* Unknown = llvm::BasicBlock::Create(Context, "unknown_entry", F);
+        llvm::SwitchInst* Switch = Builder.CreateSwitch(Entry, Unknown);
+        for (int ip = 0; ip < plan->codeLength; ip++) {
+            if (plan->depth[ip] < 0) continue;
+            if (ip == 0 || (plan->flags[ip] & JIT_FLAG_OSR)) {
+                Switch->addCase(Builder.getInt32(ip), emitEntry(ip));
+            }
+        }
+
+        Builder.SetInsertPoint(Unknown);
+        storeExit(Entry, Builder.getInt32(-1));
+        Builder.CreateRet(Builder.getInt32(0));
+
+        for (int ip = 0; ip < plan->codeLength; ip++) {
+            if (plan->depth[ip] < 0) continue;
+            if (plan->flags[ip] & JIT_FLAG_LEADER) {
+                llvm::BasicBlock* BB = blockAt(ip);
+                if (Builder.GetInsertBlock()->getTerminator() == nullptr) Builder.CreateBr(BB);
+                Builder.SetInsertPoint(BB);
+            }
+            emitInstruction(ip);
+        }
+
+        if (llvm::verifyFunction(*F)) return nullptr;
+        return F;
+    }
+
+private:
+    uint8_t typeAt(int ip, int slot) {
+        return plan->types[(size_t)ip * plan->maxDepth + slot];
+    }
+
+    llvm::BasicBlock* blockAt(int ip) {
+        auto it = blocks.find(ip);
+        if (it != blocks.end()) return it->second;
+        llvm::BasicBlock* BB = llvm::BasicBlock::Create(Context, "ip" + std::to_string(ip), F);
+        blocks[ip] = BB;
+        return BB;
+    }
+
+    llvm::Value* load(int slot) {
+        return Builder.CreateLoad(I64, stack[slot]);
+    }
+
+    void store(int slot, llvm::Value* value) {
+        Builder.CreateStore(value, stack[slot]);
+    }
+
+    llvm::Value* frameSlot(int slot) {
+        return Builder.CreateGEP(I64, Slots, Builder.getInt64(slot));
+    }
+
+    llvm::Value* constant(uint64_t bits) {
+        return Builder.getInt64(bits);
+    }
+
+    llvm::Value* asNumber(llvm::Value* v) { return Builder.CreateBitCast(v, F64); }
+    llvm::Value* box(llvm::Value* d) { return Builder.CreateBitCast(d, I64); }
+
+    llvm::Value* isNumber(llvm::Value* v) {
+        return Builder.CreateICmpNE(Builder.CreateAnd(v, constant(kQNaN)), constant(kQNaN));
+    }
+
+    llvm::Value* isObj(llvm::Value* v) {
+        uint64_t mask = kSignBit | kQNaN;
+        return Builder.CreateICmpEQ(Builder.CreateAnd(v, constant(mask)), constant(mask));
+    }
+
+    llvm::Value* isFalsey(llvm::Value* v) {
+        return Builder.CreateOr(Builder.CreateICmpEQ(v, constant(kNil)),
+                                Builder.CreateICmpEQ(v, constant(kFalse)));
+    }
+
+    llvm::Value* boolValue(llvm::Value* cond) {
+        return Builder.CreateSelect(cond, constant(kTrue), constant(kFalse));
+    }
+
+    void storeExit(llvm::Value* ip, llvm::Value* depth) {
+        llvm::Value* Fields = Builder.CreatePointerCast(Exit, llvm::PointerType::get(I32, 0));
+        Builder.CreateStore(ip, Builder.CreateGEP(I32, Fields, Builder.getInt64(2)));
+        Builder.CreateStore(depth, Builder.CreateGEP(I32, Fields, Builder.getInt64(3)));
+    }
+
+    // Writes the live slots back into the frame and leaves native code so
+    // the interpreter re-executes the instruction at 'ip'.
+    llvm::BasicBlock* deoptAt(int ip) {
+        auto it = deopts.find(ip);
+        if (it != deopts.end()) return it->second;
+        llvm::BasicBlock* BB = llvm::BasicBlock::Create(Context, "deopt" + std::to_string(ip), F);
+        llvm::IRBuilderBase::InsertPoint saved = Builder.saveIP();
+        Builder.SetInsertPoint(BB);
+        int depth = plan->depth[ip];
+        for (int p = 0; p < depth; p++) {
+            Builder.CreateStore(load(p), frameSlot(p));
+        }
+        storeExit(Builder.getInt32(ip), Builder.getInt32(depth));
+        Builder.CreateRet(Builder.getInt32(0));
+        Builder.restoreIP(saved);
+        deopts[ip] = BB;
+        return BB;
+    }
+
+    // Continues only if 'ok' holds, deoptimizing to 'ip' otherwise.
+    void guard(llvm::Value* ok, int ip) {
+        llvm::BasicBlock* Cont = llvm::BasicBlock::Create(Context, "guarded", F);
+        Builder.CreateCondBr(ok, Cont, deoptAt(ip));
+        Builder.SetInsertPoint(Cont);
+    }
+
+    void guardType(llvm::Value* v, uint8_t type, int ip) {
+        switch (type) {
+            case JIT_TYPE_NUMBER: guard(isNumber(v), ip); break;
+            case JIT_TYPE_BOOL:
+                guard(Builder.CreateICmpEQ(Builder.CreateOr(v, constant(1)), constant(kTrue)), ip);
+                break;
+            case JIT_TYPE_NIL: guard(Builder.CreateICmpEQ(v, constant(kNil)), ip); break;
+            default: break;
+        }
+    }
+
+    llvm::Value* numberOperand(int ip, int slot) {
+        llvm::Value* v = load(slot);
+        if (typeAt(ip, slot) != JIT_TYPE_NUMBER) guard(isNumber(v), ip);
+        return asNumber(v);
+    }
+
+    llvm::BasicBlock* emitEntry(int ip) {
+        llvm::BasicBlock* BB = llvm::BasicBlock::Create(Context, "enter" + std::to_string(ip), F);
+        llvm::IRBuilderBase::InsertPoint saved = Builder.saveIP();
+        Builder.SetInsertPoint(BB);
+        int depth = plan->depth[ip];
+        for (int p = 0; p < depth; p++) {
+            store(p, Builder.CreateLoad(I64, frameSlot(p)));
+        }
+        // The frame must match what the code was specialized for.
+        for (int p = 0; p < depth; p++) {
+            guardType(load(p), typeAt(ip, p), ip);
+        }
+        Builder.CreateBr(blockAt(ip));
+        Builder.restoreIP(saved);
+        return BB;
+    }
+
+    void emitArithmetic(int ip, uint8_t op, int depth) {
+        llvm::Value* A = numberOperand(ip, depth - 2);
+        llvm::Value* Bv = numberOperand(ip, depth - 1);
+        if (op == OP_DIVIDE || op == OP_MODULO) {
+            // Division by zero is reported by the interpreter.
+            guard(Builder.CreateFCmpUNE(Bv, llvm::ConstantFP::get(F64, 0.0)), ip);
+        }
+        llvm::Value* R = nullptr;
+        switch (op) {
+            case OP_ADD:      R = Builder.CreateFAdd(A, Bv); break;
+            case OP_SUBTRACT: R = Builder.CreateFSub(A, Bv); break;
+            case OP_MULTIPLY: R = Builder.CreateFMul(A, Bv); break;
+            case OP_DIVIDE:   R = Builder.CreateFDiv(A, Bv); break;
+            default:          R = Builder.CreateFRem(A, Bv); break;  // fmod
+        }
+        store(depth - 2, box(R));
+    }
+
+    void emitEqual(int ip, int depth) {
+        uint8_t ta = typeAt(ip, depth - 2);
+        uint8_t tb = typeAt(ip, depth - 1);
+        llvm::Value* A = load(depth - 2);
+        llvm::Value* Bv = load(depth - 1);
+        llvm::Value* Eq;
+        if (ta == JIT_TYPE_NUMBER && tb == JIT_TYPE_NUMBER) {
+            Eq = Builder.CreateFCmpOEQ(asNumber(A), asNumber(Bv));
+        } else if (ta != JIT_TYPE_ANY && tb != JIT_TYPE_ANY) {
+            // Mixed immediates: equal only if the bits are.
+            Eq = Builder.CreateICmpEQ(A, Bv);
+        } else {
+            llvm::FunctionType* FT = llvm::FunctionType::get(I32, {I64, I64}, false);
+            llvm::Value* Fn = Builder.CreateIntToPtr(
+                Builder.getInt64((uint64_t)(uintptr_t)&jitValuesEqual), llvm::PointerType::get(FT, 0));
+            llvm::Value* R = Builder.CreateCall(FT, Fn, {A, Bv});
+            guard(Builder.CreateICmpNE(R, Builder.getInt32(-1)), ip);
+            Eq = Builder.CreateICmpNE(R, Builder.getInt32(0));
+        }
+        store(depth - 2, boolValue(Eq));
+    }
+
+    void emitNot(int ip, int depth) {
+        llvm::Value* V = load(depth - 1);
+        if (typeAt(ip, depth - 1) == JIT_TYPE_ANY) {
+            // Instances may overload operator!
+            llvm::BasicBlock* ObjBB = llvm::BasicBlock::Create(Context, "not_obj", F);
+            llvm::BasicBlock* Cont = llvm::BasicBlock::Create(Context, "not_value", F);
+            Builder.CreateCondBr(isObj(V), ObjBB, Cont);
+            Builder.SetInsertPoint(ObjBB);
+            llvm::Value* Ptr = Builder.CreateIntToPtr(
+                Builder.CreateAnd(V, constant(~(kSignBit | kQNaN))), llvm::PointerType::get(I32, 0));
+            llvm::Value* Type = Builder.CreateLoad(I32, Ptr);
+            guard(Builder.CreateICmpNE(Type, Builder.getInt32(OBJ_INSTANCE)), ip);
+            Builder.CreateBr(Cont);
+            Builder.SetInsertPoint(Cont);
+        }
+        store(depth - 1, boolValue(isFalsey(V)));
+    }
+
+    void emitCompare(int ip, int depth, llvm::CmpInst::Predicate predicate) {
+        llvm::Value* A = numberOperand(ip, depth - 2);
+        llvm::Value* Bv = numberOperand(ip, depth - 1);
+        store(depth - 2, boolValue(Builder.CreateFCmp(predicate, A, Bv)));
+    }
+
+    // Branches on the value on top of the stack; numbers are always truthy.
+    void emitBranch(int ip, int depth, llvm::BasicBlock* IfFalse, llvm::BasicBlock* IfTrue) {
+        uint8_t type = typeAt(ip, depth - 1);
+        if (type == JIT_TYPE_NUMBER) {
+            Builder.CreateBr(IfTrue);
+            return;
+        }
+        llvm::Value* V = load(depth - 1);
+        llvm::Value* C = type == JIT_TYPE_BOOL ? Builder.CreateICmpEQ(V, constant(kFalse))
+                                               : isFalsey(V);
+        Builder.CreateCondBr(C, IfFalse, IfTrue);
+    }
+
+    void emitInstruction(int ip) {
+        uint8_t op = code[ip];
+        int depth = plan->depth[ip];
+        switch (op) {
+            case OP_NOP:
+            case OP_POP:
+                break;
+            case OP_NIL:   store(depth, constant(kNil)); break;
+            case OP_TRUE:  store(depth, constant(kTrue)); break;
+            case OP_FALSE: store(depth, constant(kFalse)); break;
+            case OP_CONSTANT:
+                store(depth, constant(plan->function->chunk.constants.values[code[ip + 1]]));
+                break;
+            case OP_DUP:   store(depth, load(depth - 1)); break;
+
+            case OP_GET_LOCAL:   store(depth, load(code[ip + 1])); break;
+            case OP_GET_LOCAL_0: store(depth, load(0)); break;
+            case OP_GET_LOCAL_1: store(depth, load(1)); break;
+            case OP_GET_LOCAL_2: store(depth, load(2)); break;
+            case OP_GET_LOCAL_3: store(depth, load(3)); break;
+            case OP_SET_LOCAL:   store(code[ip + 1], load(depth - 1)); break;
+            case OP_SET_LOCAL_0: store(0, load(depth - 1)); break;
+            case OP_SET_LOCAL_1: store(1, load(depth - 1)); break;
+            case OP_SET_LOCAL_2: store(2, load(depth - 1)); break;
+            case OP_SET_LOCAL_3: store(3, load(depth - 1)); break;
+
+            case OP_ADD:
+            case OP_SUBTRACT:
+            case OP_MULTIPLY:
+            case OP_DIVIDE:
+            case OP_MODULO:
+                emitArithmetic(ip, op, depth);
+                break;
+
+            case OP_NEGATE:
+                store(depth - 1, box(Builder.CreateFNeg(numberOperand(ip, depth - 1))));
+                break;
+
+            // The fused loop compares only produce the flag; the embedded
+            // OP_LOOP_IF_TRUE that follows does the branch.
+            case OP_LESS:
+            case OP_LOOP_IF_LESS:
+                emitCompare(ip, depth, llvm::CmpInst::FCMP_OLT);
+                break;
+            case OP_LESS_EQUAL:
+            case OP_LOOP_IF_LESS_EQUAL:
+                emitCompare(ip, depth, llvm::CmpInst::FCMP_OLE);
+                break;
+            case OP_GREATER:
+            case OP_LOOP_IF_GREATER:
+                emitCompare(ip, depth, llvm::CmpInst::FCMP_OGT);
+                break;
+            case OP_GREATER_EQUAL:
+            case OP_LOOP_IF_GREATER_EQUAL:
+                emitCompare(ip, depth, llvm::CmpInst::FCMP_OGE);
+                break;
+
+            case OP_EQUAL: emitEqual(ip, depth); break;
+            case OP_NOT:   emitNot(ip, depth); break;
+
+            case OP_JUMP: {
+                int target = ip + 3 + ((code[ip + 1] << 8) | code[ip + 2]);
+                Builder.CreateBr(blockAt(target));
+                break;
+            }
+            case OP_LOOP: {
+                int target = ip + 3 - ((code[ip + 1] << 8) | code[ip + 2]);
+                Builder.CreateBr(blockAt(target));
+                break;
+            }
+            case OP_JUMP_IF_FALSE:
+            case OP_JUMP_IF_FALSE_POP: {
+                int target = ip + 3 + ((code[ip + 1] << 8) | code[ip + 2]);
+                emitBranch(ip, depth, blockAt(target), blockAt(ip + 3));
+                break;
+            }
+            case OP_LOOP_IF_TRUE: {
+                int target = ip + 3 - ((code[ip + 1] << 8) | code[ip + 2]);
+                emitBranch(ip, depth, blockAt(ip + 3), blockAt(target));
+                break;
+            }
+
+            case OP_RETURN:
+                Builder.CreateStore(load(depth - 1), Exit);
+                Builder.CreateRet(Builder.getInt32(1));
+                break;
+        }
+    }
+};
+
+void optimize(llvm::Module& module) {
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+
+    llvm::PassBuilder PB;
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    llvm::ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+    MPM.run(module, MAM);
+}
+
+} // namespace
+
+extern "C" JitCode* jitEmitNative(const JitPlan* plan) {
+    llvm::orc::LLJIT* J = getJIT();
+    if (J == nullptr) return nullptr;
+
+    auto Context = std::make_unique<llvm::LLVMContext>();
+    auto ModuleOb = std::make_unique<llvm::Module>("proxpl_jit", *Context);
+    ModuleOb->setDataLayout(J->getDataLayout());
+
+    std::string name = "pxjit_" + std::to_string(functionCounter++);
+    BytecodeTranslator translator(plan, *Context, ModuleOb.get());
+    if (translator.translate(name) == nullptr) return nullptr;
+    optimize(*ModuleOb);
+
+    llvm::orc::ResourceTrackerSP Tracker = J->getMainJITDylib().createResourceTracker();
+    llvm::orc::ThreadSafeModule TSM(std::move(ModuleOb), std::move(Context));
+    if (llvm::Error Err = J->addIRModule(Tracker, std::move(TSM))) {
+        llvm::consumeError(std::move(Err));
+        return nullptr;
+    }
+
+    auto Symbol = J->lookup(name);
+    if (!Symbol) {
+        llvm::consumeError(Symbol.takeError());
+        llvm::consumeError(Tracker->remove());
+        return nullptr;
+    }
+
+    JitCode* code = (JitCode*)malloc(sizeof(JitCode));
+#if LLVM_VERSION_MAJOR >= 16
+    code->entry = Symbol->toPtr<JitEntry>();
+#else
+    code->entry = (JitEntry)(uintptr_t)Symbol->getAddress();
+#endif
+    code->maxDepth = plan->maxDepth;
+    code->handle = new llvm::orc::ResourceTrackerSP(Tracker);
+    return code;
+}
+
+extern "C" void jitReleaseNative(JitCode* code) {
+    auto* Tracker = (llvm::orc::ResourceTrackerSP*)code->handle;
+    llvm::consumeError((*Tracker)->remove());
+    delete Tracker;
+    free(code);
+}
+
+#endif // USE_LLVM_BACKEND
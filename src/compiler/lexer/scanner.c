@@ -5,6 +5,7 @@
 //   Copyright © 2025. ProXentix India Pvt. Ltd.  All rights reserved.
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "common.h"
@@ -825,4 +826,24 @@ Token scanToken(Scanner *scanner) {
   }
 
   return errorToken(scanner, "Unexpected character.");
-}
\ No newline at end of file
+}
+
+Token *scanAllTokens(const char *source, int *count) {
+  int capacity = 256;
+  int n = 0;
+  Token *tokens = (Token *)malloc(sizeof(Token) * capacity);
+  Scanner scanner;
+  initScanner(&scanner, source);
+  for (;;) {
+    if (n == capacity) {
+      capacity *= 2;
+      tokens = (Token *)realloc(tokens, sizeof(Token) * capacity);
+    }
+    Token token = scanToken(&scanner);
+    tokens[n++] = token;
+    if (token.type == TOKEN_EOF || token.type == TOKEN_ERROR)
+      break;
+  }
+  *count = n;
+  return tokens;
+}
@@ -0,0 +1,770 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/module_graph.h"
+#include "../../include/scanner.h"
+#include "../../include/parser.h"
+#include "../../include/optimizer.h"
+#include "../../include/type_checker.h"
+#include "../../include/file_utils.h"
+#include "../../include/object.h"
+#include "../../include/table.h"
+#include "../../include/sha256.h"
+
+#define MAX_COMPILE_WORKERS 8
+
+static char* copyPath(const char* chars, size_t length) {
+    char* copy = (char*)malloc(length + 1);
+    if (copy == NULL) {
+        fprintf(stderr, "Fatal: Out of memory in module graph.\n");
+        exit(1);
+    }
+    memcpy(copy, chars, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+static void appendIndex(int** items, int* count, int* capacity, int index) {
+    for (int i = 0; i < *count; i++) {
+        if ((*items)[i] == index) return;
+    }
+    if (*count + 1 > *capacity) {
+        *capacity = *capacity < 4 ? 4 : *capacity * 2;
+        *items = (int*)realloc(*items, sizeof(int) * *capacity);
+    }
+    (*items)[(*count)++] = index;
+}
+
+void initModuleGraph(ModuleGraph* graph, const char* entryPath) {
+    graph->units = NULL;
+    graph->count = 0;
+    graph->capacity = 0;
+    graph->roots = NULL;
+    graph->rootCount = 0;
+    graph->rootCapacity = 0;
+    pxMutexInit(&graph->lock);
+    pxCondInit(&graph->changed);
+    graph->nextUnit = 0;
+    graph->finished = 0;
+    graph->records = NULL;
+    graph->recordCount = 0;
+
+    // The entry file's directory, then the importer's search paths
+    graph->dirCount = 1 + vm.importer.pathCount;
+    graph->searchDirs = (char**)malloc(sizeof(char*) * graph->dirCount);
+    const char* slash = strrchr(entryPath, '/');
+#ifdef _WIN32
+    const char* backslash = strrchr(entryPath, '\\');
+    if (backslash != NULL && (slash == NULL || backslash > slash)) slash = backslash;
+#endif
+    graph->searchDirs[0] = slash != NULL ? copyPath(entryPath, (size_t)(slash - entryPath))
+                                         : copyPath(".", 1);
+    for (int i = 0; i < vm.importer.pathCount; i++) {
+        const char* dir = vm.importer.searchPaths[i];
+        graph->searchDirs[i + 1] = copyPath(dir, strlen(dir));
+    }
+}
+
+static ModuleUnit* newUnit(const char* name, size_t nameLength, char* path) {
+    ModuleUnit* unit = (ModuleUnit*)calloc(1, sizeof(ModuleUnit));
+    if (unit == NULL) {
+        fprintf(stderr, "Fatal: Out of memory in module graph.\n");
+        exit(1);
+    }
+    unit->name = copyPath(name, nameLength);
+    unit->path = path;
+    initArena(&unit->arena);
+    return unit;
+}
+
+// Frees a unit's AST, or unpins its cached image.
+static void releaseArena(ModuleUnit* unit) {
+    if (unit->holdsArena) {
+        enterCompilation(&unit->arena);
+        endCompilation(&unit->arena);
+        unit->holdsArena = false;
+    }
+    unit->image = NULL;
+}
+
+// Also frees the source unless the VM took ownership of it.
+static void releaseUnit(ModuleUnit* unit) {
+    releaseArena(unit);
+    free(unit->source);
+    unit->source = NULL;
+}
+
+// --- Build index ---
+
+struct ModuleRecord {
+    char* path;
+    uint8_t sourceHash[PROXC_KEY_SIZE];
+    uint8_t interfaceHash[PROXC_KEY_SIZE];
+    char* uses;
+};
+
+static const char hexDigits[] = "0123456789abcdef";
+
+static void writeHex(char* out, const uint8_t* bytes) {
+    for (int i = 0; i < PROXC_KEY_SIZE; i++) {
+        out[i * 2] = hexDigits[bytes[i] >> 4];
+        out[i * 2 + 1] = hexDigits[bytes[i] & 0x0F];
+    }
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static bool readHex(const char* in, size_t length, uint8_t* bytes) {
+    if (length != PROXC_KEY_SIZE * 2) return false;
+    for (int i = 0; i < PROXC_KEY_SIZE; i++) {
+        int high = hexValue(in[i * 2]);
+        int low = hexValue(in[i * 2 + 1]);
+        if (high < 0 || low < 0) return false;
+        bytes[i] = (uint8_t)(high << 4 | low);
+    }
+    return true;
+}
+
+static char* indexPath(void) {
+    const char* dir = proxc_cache_dir();
+    size_t length = strlen(dir) + sizeof("/modules.idx");
+    char* path = (char*)malloc(length);
+    if (path != NULL) snprintf(path, length, "%s/modules.idx", dir);
+    return path;
+}
+
+// One line per module file: path, source hash, interface hash and uses,
+// separated by tabs. Malformed lines are skipped; the index is only a
+// cache, so losing an entry costs one front-end run.
+static void loadIndex(ModuleGraph* graph) {
+    if (!proxc_cache_enabled()) return;
+    char* path = indexPath();
+    if (path == NULL) return;
+    FILE* file = fopen(path, "rb");
+    free(path);
+    if (file == NULL) return;
+
+    char line[4096];
+    int capacity = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char* fields[4];
+        int fieldCount = 0;
+        char* cursor = line;
+        line[strcspn(line, "\r\n")] = '\0';
+        while (fieldCount < 4) {
+            fields[fieldCount++] = cursor;
+            char* tab = strchr(cursor, '\t');
+            if (tab == NULL) break;
+            *tab = '\0';
+            cursor = tab + 1;
+        }
+        if (fieldCount != 4) continue;
+
+        ModuleRecord record;
+        if (!readHex(fields[1], strlen(fields[1]), record.sourceHash) ||
+            !readHex(fields[2], strlen(fields[2]), record.interfaceHash)) {
+            continue;
+        }
+        if (graph->recordCount + 1 > capacity) {
+            capacity = capacity < 16 ? 16 : capacity * 2;
+            graph->records = (ModuleRecord*)realloc(graph->records, sizeof(ModuleRecord) * capacity);
+        }
+        record.path = copyPath(fields[0], strlen(fields[0]));
+        record.uses = copyPath(fields[3], strlen(fields[3]));
+        graph->records[graph->recordCount++] = record;
+    }
+    fclose(file);
+}
+
+static ModuleRecord* findRecord(ModuleGraph* graph, const char* path) {
+    for (int i = 0; i < graph->recordCount; i++) {
+        if (strcmp(graph->records[i].path, path) == 0) return &graph->records[i];
+    }
+    return NULL;
+}
+
+typedef struct {
+    char* chars;
+    size_t length;
+    size_t capacity;
+} TextBuffer;
+
+static void appendText(TextBuffer* buffer, const char* chars, size_t length) {
+    if (buffer->length + length + 1 > buffer->capacity) {
+        buffer->capacity = (buffer->capacity + length + 1) * 2;
+        buffer->chars = (char*)realloc(buffer->chars, buffer->capacity);
+    }
+    memcpy(buffer->chars + buffer->length, chars, length);
+    buffer->length += length;
+    buffer->chars[buffer->length] = '\0';
+}
+
+static void appendRecord(TextBuffer* buffer, const char* path, const uint8_t* sourceHash,
+                         const uint8_t* interfaceHash, const char* uses) {
+    if (strpbrk(path, "\t\r\n") != NULL) return;
+    char hashes[PROXC_KEY_SIZE * 4 + 3];
+    hashes[0] = '\t';
+    writeHex(hashes + 1, sourceHash);
+    hashes[PROXC_KEY_SIZE * 2 + 1] = '\t';
+    writeHex(hashes + PROXC_KEY_SIZE * 2 + 2, interfaceHash);
+    hashes[PROXC_KEY_SIZE * 4 + 2] = '\t';
+
+    appendText(buffer, path, strlen(path));
+    appendText(buffer, hashes, sizeof(hashes));
+    appendText(buffer, uses, strlen(uses));
+    appendText(buffer, "\n", 1);
+}
+
+// Rewrites the index with this build's modules, keeping records of files
+// it did not reach (other entry points share the cache directory).
+static void saveIndex(ModuleGraph* graph) {
+    if (!proxc_cache_enabled()) return;
+    TextBuffer buffer = {NULL, 0, 0};
+
+    for (int i = 0; i < graph->recordCount; i++) {
+        ModuleRecord* record = &graph->records[i];
+        bool replaced = false;
+        for (int j = 0; j < graph->count && !replaced; j++) {
+            replaced = strcmp(graph->units[j]->path, record->path) == 0;
+        }
+        if (!replaced) {
+            appendRecord(&buffer, record->path, record->sourceHash, record->interfaceHash, record->uses);
+        }
+    }
+    for (int i = 0; i < graph->count; i++) {
+        ModuleUnit* unit = graph->units[i];
+        if (unit->failed || unit->hadErrors) continue;
+        appendRecord(&buffer, unit->path, unit->sourceHash, unit->interfaceHash, unit->uses);
+    }
+
+    char* path = indexPath();
+    if (path != NULL && buffer.chars != NULL) {
+        proxc_ensure_cache_dir();
+        proxc_write_file(path, (const uint8_t*)buffer.chars, buffer.length);
+    }
+    free(path);
+    free(buffer.chars);
+}
+
+void freeModuleGraph(ModuleGraph* graph) {
+    for (int i = 0; i < graph->count; i++) {
+        ModuleUnit* unit = graph->units[i];
+        releaseUnit(unit);
+        free(unit->name);
+        free(unit->path);
+        free(unit->uses);
+        free(unit->deps);
+        free(unit);
+    }
+    free(graph->units);
+    free(graph->roots);
+    for (int i = 0; i < graph->dirCount; i++) free(graph->searchDirs[i]);
+    free(graph->searchDirs);
+    for (int i = 0; i < graph->recordCount; i++) {
+        free(graph->records[i].path);
+        free(graph->records[i].uses);
+    }
+    free(graph->records);
+    pxCondDestroy(&graph->changed);
+    pxMutexDestroy(&graph->lock);
+}
+
+// --- Discovery ---
+
+// Maps "lib.math" to <dir>/lib/math.prox in the first search directory
+// that has it. Returns NULL when no such file exists.
+static char* resolveModule(ModuleGraph* graph, const char* name, size_t nameLength) {
+    for (int i = 0; i < graph->dirCount; i++) {
+        const char* dir = graph->searchDirs[i];
+        size_t dirLength = strlen(dir);
+        char* path = (char*)malloc(dirLength + nameLength + 7);
+        if (path == NULL) return NULL;
+        memcpy(path, dir, dirLength);
+        path[dirLength] = '/';
+        for (size_t j = 0; j < nameLength; j++) {
+            path[dirLength + 1 + j] = name[j] == '.' ? '/' : name[j];
+        }
+        memcpy(path + dirLength + 1 + nameLength, ".prox", 6);
+
+        FILE* file = fopen(path, "rb");
+        if (file != NULL) {
+            fclose(file);
+            return path;
+        }
+        free(path);
+    }
+    return NULL;
+}
+
+// Returns the index of the unit for a module, queueing it if it is new.
+static int findOrAddUnit(ModuleGraph* graph, const char* name, size_t nameLength, char* path) {
+    pxMutexLock(&graph->lock);
+    for (int i = 0; i < graph->count; i++) {
+        const char* existing = graph->units[i]->name;
+        if (strlen(existing) == nameLength && memcmp(existing, name, nameLength) == 0) {
+            pxMutexUnlock(&graph->lock);
+            free(path);
+            return i;
+        }
+    }
+    if (graph->count + 1 > graph->capacity) {
+        graph->capacity = graph->capacity < 8 ? 8 : graph->capacity * 2;
+        graph->units = (ModuleUnit**)realloc(graph->units, sizeof(ModuleUnit*) * graph->capacity);
+    }
+    int index = graph->count;
+    graph->units[graph->count++] = newUnit(name, nameLength, path);
+    pxCondBroadcast(&graph->changed);
+    pxMutexUnlock(&graph->lock);
+    return index;
+}
+
+// Every name a module uses, whether or not it resolves to a file today,
+// so a module file added later is still picked up from the index.
+static char* joinUses(StmtList* statements) {
+    TextBuffer buffer = {NULL, 0, 0};
+    appendText(&buffer, "", 0);
+    for (int i = 0; statements != NULL && i < statements->count; i++) {
+        Stmt* stmt = statements->items[i];
+        if (stmt->type != STMT_USE_DECL || stmt->as.use_decl.modules == NULL) continue;
+        StringList* modules = stmt->as.use_decl.modules;
+        for (int j = 0; j < modules->count; j++) {
+            if (buffer.length > 0) appendText(&buffer, ",", 1);
+            appendText(&buffer, modules->items[j], strlen(modules->items[j]));
+        }
+    }
+    return buffer.chars;
+}
+
+static void resolveUses(ModuleGraph* graph, const char* uses,
+                        int** deps, int* depCount, int* depCapacity) {
+    const char* name = uses;
+    while (*name != '\0') {
+        size_t length = strcspn(name, ",");
+        char* path = resolveModule(graph, name, length);
+        if (path != NULL) { // Otherwise native, or reported at run time
+            int index = findOrAddUnit(graph, name, length, path);
+            appendIndex(deps, depCount, depCapacity, index);
+        }
+        name += length;
+        if (*name == ',') name++;
+    }
+}
+
+// --- Interface fingerprints ---
+
+static int compareStrings(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+static void addSignature(char*** items, int* count, int* capacity, const char* signature) {
+    if (*count + 1 > *capacity) {
+        *capacity = *capacity < 16 ? 16 : *capacity * 2;
+        *items = (char**)realloc(*items, sizeof(char*) * *capacity);
+    }
+    (*items)[(*count)++] = copyPath(signature, strlen(signature));
+}
+
+static int arity(StringList* params) {
+    return params != NULL ? params->count : 0;
+}
+
+static void addMethods(char*** items, int* count, int* capacity,
+                       const char* owner, StmtList* methods) {
+    char signature[512];
+    for (int i = 0; methods != NULL && i < methods->count; i++) {
+        Stmt* method = methods->items[i];
+        if (method->type != STMT_FUNC_DECL) continue;
+        snprintf(signature, sizeof(signature), "method %s.%s/%d", owner,
+                 method->as.func_decl.name, arity(method->as.func_decl.params));
+        addSignature(items, count, capacity, signature);
+    }
+}
+
+// Hashes what other modules can see: top-level names, function arities
+// and class or interface methods. Bodies and initializers are left out,
+// so editing them does not invalidate dependents.
+static void fingerprintInterface(StmtList* statements, uint8_t hash[PROXC_KEY_SIZE]) {
+    char** items = NULL;
+    int count = 0;
+    int capacity = 0;
+    char signature[512];
+
+    for (int i = 0; i < statements->count; i++) {
+        Stmt* stmt = statements->items[i];
+        switch (stmt->type) {
+            case STMT_VAR_DECL:
+                snprintf(signature, sizeof(signature), "%s %s",
+                         stmt->as.var_decl.is_const ? "const" : "let", stmt->as.var_decl.name);
+                addSignature(&items, &count, &capacity, signature);
+                break;
+            case STMT_FUNC_DECL:
+                snprintf(signature, sizeof(signature), "func %s/%d",
+                         stmt->as.func_decl.name, arity(stmt->as.func_decl.params));
+                addSignature(&items, &count, &capacity, signature);
+                break;
+            case STMT_CLASS_DECL:
+                snprintf(signature, sizeof(signature), "class %s", stmt->as.class_decl.name);
+                addSignature(&items, &count, &capacity, signature);
+                addMethods(&items, &count, &capacity, stmt->as.class_decl.name,
+                           stmt->as.class_decl.methods);
+                break;
+            case STMT_INTERFACE_DECL:
+                snprintf(signature, sizeof(signature), "interface %s", stmt->as.interface_decl.name);
+                addSignature(&items, &count, &capacity, signature);
+                addMethods(&items, &count, &capacity, stmt->as.interface_decl.name,
+                           stmt->as.interface_decl.methods);
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (count > 1) qsort(items, count, sizeof(char*), compareStrings);
+    SHA256_CTX ctx;
+    sha256_init(&ctx);
+    for (int i = 0; i < count; i++) {
+        sha256_update(&ctx, (const unsigned char*)items[i], strlen(items[i]) + 1);
+        free(items[i]);
+    }
+    sha256_final(&ctx, hash);
+    free(items);
+}
+
+// --- Front-end workers ---
+
+static void runFrontEnd(ModuleGraph* graph, ModuleUnit* unit) {
+    beginCompilation(&unit->arena);
+    unit->holdsArena = true;
+    unit->compiled = true;
+
+    int tokenCount = 0;
+    Token* tokens = scanAllTokens(unit->source, &tokenCount);
+    Token last = tokens[tokenCount - 1];
+    if (last.type == TOKEN_ERROR) {
+        fprintf(stderr, "Error in module '%s' at line %d: %.*s\n",
+                unit->name, last.line, last.length, last.start);
+        unit->failed = true;
+    } else {
+        Parser parser;
+        initParser(&parser, tokens, tokenCount, unit->source);
+        unit->statements = parse(&parser);
+        unit->hadErrors = parser.hadError;
+        if (unit->statements == NULL) {
+            fprintf(stderr, "Parse error in module '%s'.\n", unit->name);
+            unit->failed = true;
+        }
+    }
+    free(tokens);
+
+    if (!unit->failed) {
+        optimizeAST(unit->statements);
+
+        TypeChecker checker;
+        initTypeChecker(&checker);
+        if (!checkTypes(&checker, unit->statements)) {
+            fprintf(stderr, "Type Checking Failed with %d errors in module '%s'.\n",
+                    checker.errorCount, unit->name);
+            unit->failed = true;
+        }
+        freeTypeChecker(&checker);
+
+        fingerprintInterface(unit->statements, unit->interfaceHash);
+        if (unit->uses == NULL) {
+            unit->uses = joinUses(unit->statements);
+            resolveUses(graph, unit->uses, &unit->deps, &unit->depCount, &unit->depCapacity);
+        }
+    }
+
+    // The AST stays alive for linking on the main thread
+    leaveCompilation(&unit->arena);
+}
+
+static void compileUnit(ModuleGraph* graph, ModuleUnit* unit) {
+    unit->source = readFile(unit->path);
+    if (unit->source == NULL) {
+        unit->failed = true;
+        return;
+    }
+
+    SHA256_CTX ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, (const unsigned char*)unit->source, strlen(unit->source));
+    sha256_final(&ctx, unit->sourceHash);
+
+    // Unchanged since the last build: reuse what the index recorded and
+    // leave the front-end for later, in case no cached image fits
+    ModuleRecord* record = findRecord(graph, unit->path);
+    if (record != NULL && memcmp(record->sourceHash, unit->sourceHash, PROXC_KEY_SIZE) == 0) {
+        unit->fresh = true;
+        memcpy(unit->interfaceHash, record->interfaceHash, PROXC_KEY_SIZE);
+        unit->uses = copyPath(record->uses, strlen(record->uses));
+        resolveUses(graph, unit->uses, &unit->deps, &unit->depCount, &unit->depCapacity);
+        return;
+    }
+
+    runFrontEnd(graph, unit);
+}
+
+static PX_THREAD_FN(compileWorker) {
+    ModuleGraph* graph = (ModuleGraph*)arg;
+    pxMutexLock(&graph->lock);
+    for (;;) {
+        while (graph->nextUnit == graph->count && graph->finished < graph->count) {
+            pxCondWait(&graph->changed, &graph->lock);
+        }
+        if (graph->nextUnit == graph->count) break; // Every unit is finished
+
+        ModuleUnit* unit = graph->units[graph->nextUnit++];
+        pxMutexUnlock(&graph->lock);
+        compileUnit(graph, unit);
+        pxMutexLock(&graph->lock);
+
+        graph->finished++;
+        pxCondBroadcast(&graph->changed);
+    }
+    pxMutexUnlock(&graph->lock);
+    return PX_THREAD_RETURN;
+}
+
+// The image depends on the module's own source and on what its
+// dependencies export, not on how they implement it.
+static void computeImageKey(ModuleGraph* graph, ModuleUnit* unit) {
+    size_t size = PROXC_KEY_SIZE * (1 + (size_t)unit->depCount);
+    uint8_t* material = (uint8_t*)malloc(size);
+    if (material == NULL) return;
+    memcpy(material, unit->sourceHash, PROXC_KEY_SIZE);
+    for (int i = 0; i < unit->depCount; i++) {
+        memcpy(material + PROXC_KEY_SIZE * (1 + i),
+               graph->units[unit->deps[i]]->interfaceHash, PROXC_KEY_SIZE);
+    }
+    proxc_cache_key((const char*)material, size, unit->imageKey);
+    free(material);
+}
+
+// Runs every unit's front-end on the worker threads, or inline when none
+// can be started. The collector is not thread-safe, so collection is
+// suspended (nextGC parked at SIZE_MAX) until the workers are joined: they
+// grow vm.strings and their arenas' root arrays concurrently, and a string
+// literal is unpinned between compilerString() and createLiteralExpr().
+// Literals are the only heap objects workers create, and each ends up
+// pinned in its unit's arena, which stays live until the graph is freed,
+// so the pass leaves nothing unrooted when collection resumes. Keep the
+// single exit so the old threshold is always restored.
+static void runFrontEnds(ModuleGraph* graph) {
+    int workerCount = pxCpuCount();
+    if (workerCount > MAX_COMPILE_WORKERS) workerCount = MAX_COMPILE_WORKERS;
+    if (workerCount < 1) workerCount = 1;
+
+    size_t oldNextGC = vm.nextGC;
+    vm.nextGC = (size_t)-1;
+    setCompilerThreaded(true);
+
+    PxThread threads[MAX_COMPILE_WORKERS];
+    int started = 0;
+    for (int i = 0; i < workerCount; i++) {
+        if (pxThreadStart(&threads[started], compileWorker, graph)) started++;
+    }
+    if (started == 0) compileWorker(graph);
+    for (int i = 0; i < started; i++) pxThreadJoin(threads[i]);
+
+    setCompilerThreaded(false);
+    vm.nextGC = oldNextGC;
+}
+
+bool buildModuleGraph(ModuleGraph* graph, StmtList* entry) {
+    char* uses = joinUses(entry);
+    resolveUses(graph, uses, &graph->roots, &graph->rootCount, &graph->rootCapacity);
+    free(uses);
+    if (graph->count == 0) return true;
+
+    loadIndex(graph);
+    runFrontEnds(graph);
+
+    // Every interface is known now. Unchanged modules take their cached
+    // image if one was built against the same dependency interfaces, and
+    // run their front-end here otherwise.
+    bool ok = true;
+    for (int i = 0; i < graph->count; i++) {
+        ModuleUnit* unit = graph->units[i];
+        if (unit->failed) {
+            ok = false;
+            continue;
+        }
+        computeImageKey(graph, unit);
+        if (!unit->fresh) continue;
+
+        ObjFunction* image = proxc_cache_load(unit->imageKey);
+        if (image != NULL) {
+            beginCompilation(&unit->arena);
+            compilerPinValue(OBJ_VAL(image));
+            leaveCompilation(&unit->arena);
+            unit->holdsArena = true;
+            unit->image = image;
+        } else {
+            runFrontEnd(graph, unit);
+            if (unit->failed) ok = false;
+        }
+    }
+
+    if (ok) saveIndex(graph);
+    return ok;
+}
+
+// --- Linking ---
+
+// Returns the unit's bytecode, generating it unless a cached image was
+// loaded. The unit's arena keeps the result alive until released.
+static ObjFunction* unitFunction(ModuleUnit* unit, VM* pvm) {
+    if (unit->image != NULL) return unit->image;
+    enterCompilation(&unit->arena);
+    ObjFunction* function = compileAST(pvm, unit->statements);
+    leaveCompilation(&unit->arena);
+    return function;
+}
+
+// Expects the unit's function on top of the stack.
+static void cacheUnit(ModuleUnit* unit, ObjFunction* function) {
+    if (unit->image == NULL && !unit->hadErrors) {
+        proxc_cache_store(unit->imageKey, function);
+    }
+    releaseArena(unit);
+}
+
+static InterpretResult linkUnit(ModuleGraph* graph, int index, VM* pvm) {
+    ModuleUnit* unit = graph->units[index];
+    if (unit->linked) return INTERPRET_OK;
+    unit->linked = true;
+
+    ObjString* name = copyString(unit->name, (int)strlen(unit->name));
+    push(pvm, OBJ_VAL(name));
+
+    // A registered native module of the same name takes precedence
+    Value existing;
+    if (tableGet(&pvm->importer.modules, name, &existing)) {
+        pop(pvm);
+        releaseUnit(unit);
+        return INTERPRET_OK;
+    }
+
+    // Registered before its dependencies run, so a module on the other side
+    // of a cycle can `use` it while its exports are still being filled in
+    ObjModule* module = newModule(name);
+    tableSet(&pvm->importer.modules, name, OBJ_VAL(module));
+    pop(pvm);
+
+    for (int i = 0; i < unit->depCount; i++) {
+        InterpretResult result = linkUnit(graph, unit->deps[i], pvm);
+        if (result != INTERPRET_OK) return result;
+    }
+
+    ObjFunction* function = unitFunction(unit, pvm);
+    if (function == NULL) return INTERPRET_COMPILE_ERROR;
+
+    push(pvm, OBJ_VAL(function));
+    cacheUnit(unit, function);
+
+    // Whatever the module's top level defines or assigns becomes its
+    // exports. Only names in its constant pool can be touched, so only
+    // those are remembered, keeping linking linear in program size.
+    ValueArray* constants = &function->chunk.constants;
+    Table before;
+    initTable(&before);
+    for (int i = 0; i < constants->count; i++) {
+        Value old;
+        if (IS_STRING(constants->values[i]) &&
+            tableGet(&pvm->globals, AS_STRING(constants->values[i]), &old)) {
+            tableSet(&before, AS_STRING(constants->values[i]), old);
+        }
+    }
+    pop(pvm);
+
+    const char* entrySource = pvm->source;
+    pvm->source = unit->source;
+    InterpretResult result = interpretFunction(pvm, function);
+    pvm->source = entrySource;
+    trackSource(pvm, unit->source);
+    unit->source = NULL;
+
+    if (result == INTERPRET_OK) {
+        for (int i = 0; i < constants->count; i++) {
+            if (!IS_STRING(constants->values[i])) continue;
+            ObjString* key = AS_STRING(constants->values[i]);
+            Value value;
+            Value old;
+            if (!tableGet(&pvm->globals, key, &value)) continue;
+            if (tableGet(&before, key, &old) && old == value) continue;
+            tableSet(&module->exports, key, value);
+        }
+    }
+    freeTable(&before);
+    return result;
+}
+
+InterpretResult linkModuleGraph(ModuleGraph* graph, VM* pvm) {
+    for (int i = 0; i < graph->rootCount; i++) {
+        InterpretResult result = linkUnit(graph, graph->roots[i], pvm);
+        if (result != INTERPRET_OK) return result;
+    }
+    return INTERPRET_OK;
+}
+
+bool compileModuleGraph(ModuleGraph* graph, VM* pvm) {
+    for (int i = 0; i < graph->count; i++) {
+        ModuleUnit* unit = graph->units[i];
+        if (unit->linked) continue;
+        unit->linked = true;
+
+        ObjFunction* function = unitFunction(unit, pvm);
+        if (function == NULL) return false;
+        push(pvm, OBJ_VAL(function));
+        cacheUnit(unit, function);
+        pop(pvm);
+    }
+    return true;
+}
+
+static bool isModulePart(const Token* token) {
+    return token->type == TOKEN_IDENTIFIER || token->type == TOKEN_NATIVE;
+}
+
+bool entryCacheable(VM* pvm, const Token* tokens, int count) {
+    char name[256];
+    for (int i = 0; i < count; i++) {
+        if (tokens[i].type == TOKEN_UI_APP) return false;
+        if (tokens[i].type != TOKEN_USE) continue;
+
+        // Same grammar as the parser: parts joined by '.' or '/', names separated by ','
+        do {
+            i++;
+            size_t length = 0;
+            while (i < count && isModulePart(&tokens[i])) {
+                if (length + (size_t)tokens[i].length + 2 > sizeof(name)) return false;
+                if (length > 0) name[length++] = '.';
+                memcpy(name + length, tokens[i].start, (size_t)tokens[i].length);
+                length += (size_t)tokens[i].length;
+                if (i + 2 < count && (tokens[i + 1].type == TOKEN_DOT || tokens[i + 1].type == TOKEN_SLASH)) {
+                    i += 2;
+                } else {
+                    i++;
+                    break;
+                }
+            }
+            if (length == 0) return false;
+
+            Value module;
+            if (!tableGet(&pvm->importer.modules, copyString(name, (int)length), &module)) return false;
+        } while (i < count && tokens[i].type == TOKEN_COMMA);
+    }
+    return true;
+}
@@ -4,8 +4,6 @@
 #include <string.h>
 #include <math.h>
 
-extern void freeExpr(Expr* expr);
-
 static Expr* foldExpr(Expr* expr);
 
 static Expr* foldBinary(Expr* expr) {
@@ -22,29 +20,26 @@ static Expr* foldBinary(Expr* expr) {
         if (IS_NUMBER(lv) && IS_NUMBER(rv)) {
             double a = AS_NUMBER(lv);
             double b = AS_NUMBER(rv);
-            const char* op = expr->as.binary.operator;
-
             Value res = NIL_VAL;
             bool folded = true;
 
-            if (strcmp(op, "+") == 0) res = NUMBER_VAL(a + b);
-            else if (strcmp(op, "-") == 0) res = NUMBER_VAL(a - b);
-            else if (strcmp(op, "*") == 0) res = NUMBER_VAL(a * b);
-            else if (strcmp(op, "/") == 0) res = NUMBER_VAL(a / b);
-            else if (strcmp(op, "<") == 0) res = BOOL_VAL(a < b);
-            else if (strcmp(op, ">") == 0) res = BOOL_VAL(a > b);
-            else if (strcmp(op, "<=") == 0) res = BOOL_VAL(a <= b);
-            else if (strcmp(op, ">=") == 0) res = BOOL_VAL(a >= b);
-            else if (strcmp(op, "==") == 0) res = BOOL_VAL(a == b);
-            else if (strcmp(op, "!=") == 0) res = BOOL_VAL(a != b);
-            else folded = false;
+            switch (expr->as.binary.op) {
+                case AST_OP_ADD: res = NUMBER_VAL(a + b); break;
+                case AST_OP_SUBTRACT: res = NUMBER_VAL(a - b); break;
+                case AST_OP_MULTIPLY: res = NUMBER_VAL(a * b); break;
+                case AST_OP_DIVIDE: res = NUMBER_VAL(a / b); break;
+                case AST_OP_LESS: res = BOOL_VAL(a < b); break;
+                case AST_OP_GREATER: res = BOOL_VAL(a > b); break;
+                case AST_OP_LESS_EQUAL: res = BOOL_VAL(a <= b); break;
+                case AST_OP_GREATER_EQUAL: res = BOOL_VAL(a >= b); break;
+                case AST_OP_EQUAL: res = BOOL_VAL(a == b); break;
+                case AST_OP_NOT_EQUAL: res = BOOL_VAL(a != b); break;
+                default: folded = false; break;
+            }
 
             if (folded) {
-                free(expr->as.binary.operator);
                 expr->type = EXPR_LITERAL;
                 expr->as.literal.value = res;
-                freeExpr(l);
-                freeExpr(r);
                 return expr;
             }
         }
@@ -59,21 +54,17 @@ static Expr* foldUnary(Expr* expr) {
 
     if (r->type == EXPR_LITERAL) {
         Value rv = r->as.literal.value;
-        const char* op = expr->as.unary.operator;
+        AstOperator op = expr->as.unary.op;
 
-        if (strcmp(op, "-") == 0 && IS_NUMBER(rv)) {
-            free(expr->as.unary.operator);
+        if (op == AST_OP_NEGATE && IS_NUMBER(rv)) {
             expr->type = EXPR_LITERAL;
             expr->as.literal.value = NUMBER_VAL(-AS_NUMBER(rv));
-            freeExpr(r);
             return expr;
-        } else if (strcmp(op, "!") == 0) {
+        } else if (op == AST_OP_NOT) {
             // isFalsey logic
             bool res = IS_NIL(rv) || (IS_BOOL(rv) && !AS_BOOL(rv));
-            free(expr->as.unary.operator);
             expr->type = EXPR_LITERAL;
             expr->as.literal.value = BOOL_VAL(res);
-            freeExpr(r);
             return expr;
         }
     }
@@ -90,9 +81,7 @@ static Expr* foldExpr(Expr* expr) {
         case EXPR_GROUPING: 
             expr->as.grouping.expression = foldExpr(expr->as.grouping.expression);
             if (expr->as.grouping.expression->type == EXPR_LITERAL) {
-                Expr* inner = expr->as.grouping.expression;
-                FREE(Expr, expr);
-                return inner;
+                return expr->as.grouping.expression;
             }
             return expr;
         case EXPR_CALL:
@@ -155,6 +144,10 @@ static void foldStmt(Stmt* stmt) {
                 foldStmt(stmt->as.while_stmt.body);
             }
             break;
+        case STMT_FOR_IN:
+            stmt->as.for_in.iterable = foldExpr(stmt->as.for_in.iterable);
+            foldStmt(stmt->as.for_in.body);
+            break;
         case STMT_BLOCK:
             if (stmt->as.block.statements) {
                 for (int i = 0; i < stmt->as.block.statements->count; i++) {
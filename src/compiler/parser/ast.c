@@ -5,14 +5,17 @@
 //   Copyright © 2025. ProXentix India Pvt. Ltd.  All rights reserved.
 
 #include "ast.h"
+#include "arena.h"
 #include "memory.h"
 #include <stdlib.h>
 #include <string.h>
 
 // --- List Management Functions ---
+// Nodes, lists and strings come from the active compiler arena (arena.h)
+// and are released together when the compilation ends.
 
 ExprList *createExprList() {
-  ExprList *list = ALLOCATE(ExprList, 1);
+  ExprList *list = COMPILER_NEW(ExprList);
   list->items = NULL;
   list->count = 0;
   list->capacity = 0;
@@ -23,22 +26,13 @@ void appendExpr(ExprList *list, Expr *expr) {
   if (list->capacity < list->count + 1) {
     int oldCap = list->capacity;
     list->capacity = GROW_CAPACITY(oldCap);
-    list->items = GROW_ARRAY(Expr *, list->items, oldCap, list->capacity);
+    list->items = COMPILER_GROW_ARRAY(Expr *, list->items, oldCap, list->capacity);
   }
   list->items[list->count++] = expr;
 }
 
-void freeExprList(ExprList *list) {
-  if (list == NULL) return;
-  for (int i = 0; i < list->count; i++) {
-    freeExpr(list->items[i]);
-  }
-  FREE_ARRAY(Expr *, list->items, list->capacity);
-  FREE(ExprList, list);
-}
-
 StmtList *createStmtList() {
-  StmtList *list = ALLOCATE(StmtList, 1);
+  StmtList *list = COMPILER_NEW(StmtList);
   list->items = NULL;
   list->count = 0;
   list->capacity = 0;
@@ -49,22 +43,13 @@ void appendStmt(StmtList *list, Stmt *stmt) {
   if (list->capacity < list->count + 1) {
     int oldCap = list->capacity;
     list->capacity = GROW_CAPACITY(oldCap);
-    list->items = GROW_ARRAY(Stmt *, list->items, oldCap, list->capacity);
+    list->items = COMPILER_GROW_ARRAY(Stmt *, list->items, oldCap, list->capacity);
   }
   list->items[list->count++] = stmt;
 }
 
-void freeStmtList(StmtList *list) {
-  if (list == NULL) return;
-  for (int i = 0; i < list->count; i++) {
-    freeStmt(list->items[i]);
-  }
-  FREE_ARRAY(Stmt *, list->items, list->capacity);
-  FREE(StmtList, list);
-}
-
 StringList *createStringList() {
-  StringList *list = ALLOCATE(StringList, 1);
+  StringList *list = COMPILER_NEW(StringList);
   list->items = NULL;
   list->count = 0;
   list->capacity = 0;
@@ -75,22 +60,13 @@ void appendString(StringList *list, const char *str) {
   if (list->capacity < list->count + 1) {
     int oldCap = list->capacity;
     list->capacity = GROW_CAPACITY(oldCap);
-    list->items = GROW_ARRAY(char *, list->items, oldCap, list->capacity);
-  }
-  list->items[list->count++] = strdup(str);
-}
-
-void freeStringList(StringList *list) {
-  if (list == NULL) return;
-  for (int i = 0; i < list->count; i++) {
-    free(list->items[i]);
+    list->items = COMPILER_GROW_ARRAY(char *, list->items, oldCap, list->capacity);
   }
-  FREE_ARRAY(char *, list->items, list->capacity);
-  FREE(StringList, list);
+  list->items[list->count++] = compilerStrdup(str);
 }
 
 DictPairList *createDictPairList() {
-  DictPairList *list = ALLOCATE(DictPairList, 1);
+  DictPairList *list = COMPILER_NEW(DictPairList);
   list->items = NULL;
   list->count = 0;
   list->capacity = 0;
@@ -101,25 +77,15 @@ void appendDictPair(DictPairList *list, Expr *key, Expr *value) {
   if (list->capacity < list->count + 1) {
     int oldCap = list->capacity;
     list->capacity = GROW_CAPACITY(oldCap);
-    list->items = GROW_ARRAY(DictPair, list->items, oldCap, list->capacity);
+    list->items = COMPILER_GROW_ARRAY(DictPair, list->items, oldCap, list->capacity);
   }
   list->items[list->count].key = key;
   list->items[list->count].value = value;
   list->count++;
 }
 
-void freeDictPairList(DictPairList *list) {
-  if (list == NULL) return;
-  for (int i = 0; i < list->count; i++) {
-    freeExpr(list->items[i].key);
-    freeExpr(list->items[i].value);
-  }
-  FREE_ARRAY(DictPair, list->items, list->capacity);
-  FREE(DictPairList, list);
-}
-
 SwitchCaseList *createSwitchCaseList() {
-  SwitchCaseList *list = ALLOCATE(SwitchCaseList, 1);
+  SwitchCaseList *list = COMPILER_NEW(SwitchCaseList);
   list->items = NULL;
   list->count = 0;
   list->capacity = 0;
@@ -130,58 +96,139 @@ void appendSwitchCase(SwitchCaseList *list, Expr *value, StmtList *statements) {
   if (list->capacity < list->count + 1) {
     int oldCap = list->capacity;
     list->capacity = GROW_CAPACITY(oldCap);
-    list->items = GROW_ARRAY(SwitchCase, list->items, oldCap, list->capacity);
+    list->items = COMPILER_GROW_ARRAY(SwitchCase, list->items, oldCap, list->capacity);
   }
   list->items[list->count].value = value;
   list->items[list->count].statements = statements;
   list->count++;
 }
 
-void freeSwitchCaseList(SwitchCaseList *list) {
-  if (list == NULL) return;
-  for (int i = 0; i < list->count; i++) {
-    freeExpr(list->items[i].value);
-    freeStmtList(list->items[i].statements);
+// --- Operators and Names ---
+
+const char *astOperatorLexeme(AstOperator op) {
+  switch (op) {
+  case AST_OP_ADD: return "+";
+  case AST_OP_SUBTRACT: return "-";
+  case AST_OP_MULTIPLY: return "*";
+  case AST_OP_DIVIDE: return "/";
+  case AST_OP_MODULO: return "%";
+  case AST_OP_POWER: return "**";
+  case AST_OP_MAT_MUL: return "@";
+  case AST_OP_EQUAL: return "==";
+  case AST_OP_NOT_EQUAL: return "!=";
+  case AST_OP_LESS: return "<";
+  case AST_OP_LESS_EQUAL: return "<=";
+  case AST_OP_GREATER: return ">";
+  case AST_OP_GREATER_EQUAL: return ">=";
+  case AST_OP_BIT_AND: return "&";
+  case AST_OP_BIT_OR: return "|";
+  case AST_OP_BIT_XOR: return "^";
+  case AST_OP_LEFT_SHIFT: return "<<";
+  case AST_OP_RIGHT_SHIFT: return ">>";
+  case AST_OP_NOT: return "!";
+  case AST_OP_NEGATE: return "-";
+  case AST_OP_BIT_NOT: return "~";
+  case AST_OP_AND: return "&&";
+  case AST_OP_OR: return "||";
+  }
+  return "?";
+}
+
+// Open-addressed set of every identifier seen by the parser. Entries are
+// never removed; identifiers repeat heavily, so the set stays small. Parsers
+// on worker threads share it under compilerLock().
+static struct {
+  const char **entries;
+  int count;
+  int capacity;
+} names;
+
+static uint32_t hashName(const char *chars, int length) {
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < length; i++) {
+    hash ^= (uint8_t)chars[i];
+    hash *= 16777619;
+  }
+  return hash;
+}
+
+static const char **findName(const char **entries, int capacity,
+                             const char *chars, int length) {
+  uint32_t index = hashName(chars, length) & (capacity - 1);
+  for (;;) {
+    const char **entry = &entries[index];
+    if (*entry == NULL ||
+        (strncmp(*entry, chars, length) == 0 && (*entry)[length] == '\0')) {
+      return entry;
+    }
+    index = (index + 1) & (capacity - 1);
   }
-  FREE_ARRAY(SwitchCase, list->items, list->capacity);
-  FREE(SwitchCaseList, list);
+}
+
+const char *internName(const char *chars, int length) {
+  compilerLock();
+  if (names.count + 1 > names.capacity * 3 / 4) {
+    int capacity = names.capacity < 256 ? 256 : names.capacity * 2;
+    const char **entries = (const char **)calloc(capacity, sizeof(const char *));
+    for (int i = 0; i < names.capacity; i++) {
+      const char *name = names.entries[i];
+      if (name == NULL) continue;
+      *findName(entries, capacity, name, (int)strlen(name)) = name;
+    }
+    free((void *)names.entries);
+    names.entries = entries;
+    names.capacity = capacity;
+  }
+
+  const char **entry = findName(names.entries, names.capacity, chars, length);
+  if (*entry == NULL) {
+    char *name = (char *)malloc(length + 1);
+    memcpy(name, chars, length);
+    name[length] = '\0';
+    *entry = name;
+    names.count++;
+  }
+  const char *name = *entry;
+  compilerUnlock();
+  return name;
 }
 
 // --- Expression Creation Functions ---
 
-Expr *createBinaryExpr(Expr *left, const char *op, Expr *right, int line,
+Expr *createBinaryExpr(Expr *left, AstOperator op, Expr *right, int line,
                        int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_BINARY;
   expr->line = line;
   expr->column = column;
   expr->as.binary.left = left;
-  expr->as.binary.operator = strdup(op);
+  expr->as.binary.op = op;
   expr->as.binary.right = right;
   return expr;
 }
 
-Expr *createUnaryExpr(const char *op, Expr *right, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+Expr *createUnaryExpr(AstOperator op, Expr *right, int line, int column) {
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_UNARY;
   expr->line = line;
   expr->column = column;
-  expr->as.unary.operator = strdup(op);
+  expr->as.unary.op = op;
   expr->as.unary.right = right;
   return expr;
 }
 
 Expr *createLiteralExpr(Value value, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_LITERAL;
   expr->line = line;
   expr->column = column;
   expr->as.literal.value = value;
+  compilerPinValue(value);
   return expr;
 }
 
 Expr *createGroupingExpr(Expr *expression, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_GROUPING;
   expr->line = line;
   expr->column = column;
@@ -190,38 +237,38 @@ Expr *createGroupingExpr(Expr *expression, int line, int column) {
 }
 
 Expr *createVariableExpr(const char *name, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_VARIABLE;
   expr->line = line;
   expr->column = column;
-  expr->as.variable.name = strdup(name);
+  expr->as.variable.name = internName(name, (int)strlen(name));
   return expr;
 }
 
 Expr *createAssignExpr(const char *name, Expr *value, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_ASSIGN;
   expr->line = line;
   expr->column = column;
-  expr->as.assign.name = strdup(name);
+  expr->as.assign.name = internName(name, (int)strlen(name));
   expr->as.assign.value = value;
   return expr;
 }
 
-Expr *createLogicalExpr(Expr *left, const char *op, Expr *right, int line,
+Expr *createLogicalExpr(Expr *left, AstOperator op, Expr *right, int line,
                         int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_LOGICAL;
   expr->line = line;
   expr->column = column;
   expr->as.logical.left = left;
-  expr->as.logical.operator = strdup(op);
+  expr->as.logical.op = op;
   expr->as.logical.right = right;
   return expr;
 }
 
 Expr *createCallExpr(Expr *callee, ExprList *arguments, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_CALL;
   expr->line = line;
   expr->column = column;
@@ -231,29 +278,29 @@ Expr *createCallExpr(Expr *callee, ExprList *arguments, int line, int column) {
 }
 
 Expr *createGetExpr(Expr *object, const char *name, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_GET;
   expr->line = line;
   expr->column = column;
   expr->as.get.object = object;
-  expr->as.get.name = strdup(name);
+  expr->as.get.name = compilerStrdup(name);
   return expr;
 }
 
 Expr *createSetExpr(Expr *object, const char *name, Expr *value, int line,
                     int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_SET;
   expr->line = line;
   expr->column = column;
   expr->as.set.object = object;
-  expr->as.set.name = strdup(name);
+  expr->as.set.name = compilerStrdup(name);
   expr->as.set.value = value;
   return expr;
 }
 
 Expr *createIndexExpr(Expr *target, Expr *index, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_INDEX;
   expr->line = line;
   expr->column = column;
@@ -263,7 +310,7 @@ Expr *createIndexExpr(Expr *target, Expr *index, int line, int column) {
 }
 
 Expr *createSetIndexExpr(Expr *target, Expr *index, Expr *value, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_SET_INDEX;
   expr->line = line;
   expr->column = column;
@@ -274,7 +321,7 @@ Expr *createSetIndexExpr(Expr *target, Expr *index, Expr *value, int line, int c
 }
 
 Expr *createListExpr(ExprList *elements, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_LIST;
   expr->line = line;
   expr->column = column;
@@ -285,7 +332,7 @@ Expr *createListExpr(ExprList *elements, int line, int column) {
 }
 
 Expr *createDictionaryExpr(DictPairList *pairs, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_DICTIONARY;
   expr->line = line;
   expr->column = column;
@@ -295,7 +342,7 @@ Expr *createDictionaryExpr(DictPairList *pairs, int line, int column) {
 
 Expr *createTernaryExpr(Expr *cond, Expr *true_br, Expr *false_br, int line,
                         int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_TERNARY;
   expr->line = line;
   expr->column = column;
@@ -307,17 +354,19 @@ Expr *createTernaryExpr(Expr *cond, Expr *true_br, Expr *false_br, int line,
 
 Expr *createLambdaExpr(StringList *params, StmtList *body, int line,
                        int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_LAMBDA;
   expr->line = line;
   expr->column = column;
   expr->as.lambda.params = params;
   expr->as.lambda.body = body;
+  expr->as.lambda.escape = ESCAPE_HEAP;
+  expr->as.lambda.retainedParams = UINT32_MAX;
   return expr;
 }
 
 Expr *createAwaitExpr(Expr *expression, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_AWAIT;
   expr->line = line;
   expr->column = column;
@@ -326,7 +375,7 @@ Expr *createAwaitExpr(Expr *expression, int line, int column) {
 }
 
 Expr *createThisExpr(int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_THIS;
   expr->line = line;
   expr->column = column;
@@ -334,16 +383,16 @@ Expr *createThisExpr(int line, int column) {
 }
 
 Expr *createSuperExpr(const char *method, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_SUPER;
   expr->line = line;
   expr->column = column;
-  expr->as.super_expr.method = method ? strdup(method) : NULL;
+  expr->as.super_expr.method = method ? compilerStrdup(method) : NULL;
   return expr;
 }
 
 Expr *createNewExpr(Expr *clazz, ExprList *args, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_NEW;
   expr->line = line;
   expr->column = column;
@@ -353,7 +402,7 @@ Expr *createNewExpr(Expr *clazz, ExprList *args, int line, int column) {
 }
 
 Expr *createSanitizeExpr(Expr *value, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_SANITIZE;
   expr->line = line;
   expr->column = column;
@@ -362,7 +411,7 @@ Expr *createSanitizeExpr(Expr *value, int line, int column) {
 }
 
 Expr *createCryptoExpr(Expr *val, bool isEncrypt, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_CRYPTO;
   expr->line = line;
   expr->column = column;
@@ -372,7 +421,7 @@ Expr *createCryptoExpr(Expr *val, bool isEncrypt, int line, int column) {
 }
 
 Expr *createUnwrapExpr(Expr *expression, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_UNWRAP;
   expr->line = line;
   expr->column = column;
@@ -381,7 +430,7 @@ Expr *createUnwrapExpr(Expr *expression, int line, int column) {
 }
 
 Expr *createTemplateLiteralExpr(ExprList *parts, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_TEMPLATE_LITERAL;
   expr->line = line;
   expr->column = column;
@@ -390,7 +439,7 @@ Expr *createTemplateLiteralExpr(ExprList *parts, int line, int column) {
 }
 
 Expr *createComptimeExpr(StmtList *body, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_COMPTIME;
   expr->line = line;
   expr->column = column;
@@ -399,7 +448,7 @@ Expr *createComptimeExpr(StmtList *body, int line, int column) {
 }
 
 Expr *createActorSendExpr(Expr *receiver, Expr *message, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_ACTOR_SEND;
   expr->line = line;
   expr->column = column;
@@ -409,7 +458,7 @@ Expr *createActorSendExpr(Expr *receiver, Expr *message, int line, int column) {
 }
 
 Expr *createActorRequestExpr(Expr *receiver, Expr *message, int line, int column) {
-  Expr *expr = ALLOCATE(Expr, 1);
+  Expr *expr = COMPILER_NEW(Expr);
   expr->type = EXPR_ACTOR_REQUEST;
   expr->line = line;
   expr->column = column;
@@ -421,7 +470,7 @@ Expr *createActorRequestExpr(Expr *receiver, Expr *message, int line, int column
 // --- Statement Creation Functions ---
 
 Stmt *createExpressionStmt(Expr *expression, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_EXPRESSION;
   stmt->line = line;
   stmt->column = column;
@@ -430,11 +479,11 @@ Stmt *createExpressionStmt(Expr *expression, int line, int column) {
 }
 
 Stmt *createVarDeclStmt(const char *name, Expr *init, bool is_const, bool isTemporal, int ttl, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_VAR_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.var_decl.name = strdup(name);
+  stmt->as.var_decl.name = compilerStrdup(name);
   stmt->as.var_decl.initializer = init;
   stmt->as.var_decl.is_const = is_const;
   stmt->as.var_decl.type = (TypeInfo){TYPE_UNKNOWN, NULL, NULL, NULL, 0, false, NULL};
@@ -444,43 +493,43 @@ Stmt *createVarDeclStmt(const char *name, Expr *init, bool is_const, bool isTemp
 }
 
 Stmt *createTypeAliasDeclStmt(const char *name, TypeInfo targetType, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_TYPE_ALIAS;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.type_alias.name = strdup(name);
+  stmt->as.type_alias.name = compilerStrdup(name);
   stmt->as.type_alias.targetType = targetType;
   return stmt;
 }
 
 Stmt *createTraitDeclStmt(const char *name, StmtList *methods, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_TRAIT_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.trait_decl.name = strdup(name);
+  stmt->as.trait_decl.name = compilerStrdup(name);
   stmt->as.trait_decl.methods = methods;
   return stmt;
 }
 
 Stmt *createActorDeclStmt(const char *name, StmtList *fields, StmtList *receives, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_ACTOR_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.actor_decl.name = strdup(name);
+  stmt->as.actor_decl.name = compilerStrdup(name);
   stmt->as.actor_decl.fields = fields;
   stmt->as.actor_decl.receives = receives;
   return stmt;
 }
 
 Stmt *createReceiveStmt(const char *messageType, const char *messageVar, StmtList *body, TypeInfo returnType, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_RECEIVE;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.receive_stmt.messageType = strdup(messageType);
-  stmt->as.receive_stmt.messageVar = messageVar ? strdup(messageVar) : NULL;
+  stmt->as.receive_stmt.messageType = compilerStrdup(messageType);
+  stmt->as.receive_stmt.messageVar = messageVar ? compilerStrdup(messageVar) : NULL;
   stmt->as.receive_stmt.body = body;
   stmt->as.receive_stmt.returnType = returnType;
   return stmt;
@@ -488,11 +537,11 @@ Stmt *createReceiveStmt(const char *messageType, const char *messageVar, StmtLis
 
 Stmt *createFuncDeclStmt(const char *name, StringList *params, StmtList *body,
                          bool isAsync, AccessLevel access, bool isStatic, bool isAbstract, Expr *contextCondition, StringList *genericParams, StringList *genericBounds, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_FUNC_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.func_decl.name = strdup(name);
+  stmt->as.func_decl.name = compilerStrdup(name);
   stmt->as.func_decl.params = params;
   stmt->as.func_decl.body = body;
   stmt->as.func_decl.isAsync = isAsync; 
@@ -502,16 +551,19 @@ Stmt *createFuncDeclStmt(const char *name, StringList *params, StmtList *body,
   stmt->as.func_decl.contextCondition = contextCondition;
   stmt->as.func_decl.genericParams = genericParams;
   stmt->as.func_decl.genericBounds = genericBounds;
+  stmt->as.func_decl.returnType = (TypeInfo){TYPE_UNKNOWN, NULL, NULL, NULL, 0, false, NULL};
+  stmt->as.func_decl.escape = ESCAPE_HEAP;
+  stmt->as.func_decl.retainedParams = UINT32_MAX;
   return stmt;
 }
 
 Stmt *createClassDeclStmt(const char *name, Expr *super,
                           StringList *interfaces, StmtList *methods, StringList *genericParams, StringList *genericBounds, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_CLASS_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.class_decl.name = strdup(name);
+  stmt->as.class_decl.name = compilerStrdup(name);
   stmt->as.class_decl.superclass = super;
   stmt->as.class_decl.interfaces = interfaces;
   stmt->as.class_decl.methods = methods;
@@ -521,17 +573,17 @@ Stmt *createClassDeclStmt(const char *name, Expr *super,
 }
 
 Stmt *createInterfaceDeclStmt(const char *name, StmtList *methods, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_INTERFACE_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.interface_decl.name = strdup(name);
+  stmt->as.interface_decl.name = compilerStrdup(name);
   stmt->as.interface_decl.methods = methods;
   return stmt;
 }
 
 Stmt *createUseDeclStmt(StringList *modules, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_USE_DECL;
   stmt->line = line;
   stmt->column = column;
@@ -541,7 +593,7 @@ Stmt *createUseDeclStmt(StringList *modules, int line, int column) {
 
 Stmt *createIfStmt(Expr *cond, Stmt *then_br, Stmt *else_br, int line,
                    int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_IF;
   stmt->line = line;
   stmt->column = column;
@@ -552,7 +604,7 @@ Stmt *createIfStmt(Expr *cond, Stmt *then_br, Stmt *else_br, int line,
 }
 
 Stmt *createWhileStmt(Expr *cond, Stmt *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_WHILE;
   stmt->line = line;
   stmt->column = column;
@@ -563,7 +615,7 @@ Stmt *createWhileStmt(Expr *cond, Stmt *body, int line, int column) {
 
 Stmt *createForStmt(Stmt *init, Expr *cond, Expr *incr, Stmt *body, int line,
                     int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_FOR;
   stmt->line = line;
   stmt->column = column;
@@ -574,8 +626,20 @@ Stmt *createForStmt(Stmt *init, Expr *cond, Expr *incr, Stmt *body, int line,
   return stmt;
 }
 
+Stmt *createForInStmt(const char *name, Expr *iterable, Stmt *body, int line,
+                      int column) {
+  Stmt *stmt = COMPILER_NEW(Stmt);
+  stmt->type = STMT_FOR_IN;
+  stmt->line = line;
+  stmt->column = column;
+  stmt->as.for_in.name = compilerStrdup(name);
+  stmt->as.for_in.iterable = iterable;
+  stmt->as.for_in.body = body;
+  return stmt;
+}
+
 Stmt *createReturnStmt(Expr *value, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_RETURN;
   stmt->line = line;
   stmt->column = column;
@@ -584,7 +648,7 @@ Stmt *createReturnStmt(Expr *value, int line, int column) {
 }
 
 Stmt *createBlockStmt(StmtList *statements, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_BLOCK;
   stmt->line = line;
   stmt->column = column;
@@ -593,7 +657,7 @@ Stmt *createBlockStmt(StmtList *statements, int line, int column) {
 }
 
 Stmt *createBreakStmt(int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_BREAK;
   stmt->line = line;
   stmt->column = column;
@@ -601,7 +665,7 @@ Stmt *createBreakStmt(int line, int column) {
 }
 
 Stmt *createContinueStmt(int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_CONTINUE;
   stmt->line = line;
   stmt->column = column;
@@ -610,7 +674,7 @@ Stmt *createContinueStmt(int line, int column) {
 
 Stmt *createSwitchStmt(Expr *value, SwitchCaseList *cases, StmtList *def,
                        int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_SWITCH;
   stmt->line = line;
   stmt->column = column;
@@ -623,19 +687,19 @@ Stmt *createSwitchStmt(Expr *value, SwitchCaseList *cases, StmtList *def,
 Stmt *createTryCatchStmt(StmtList *try_blk, const char *catch_var,
                          StmtList *catch_blk, StmtList *finally_blk, int line,
                          int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_TRY_CATCH;
   stmt->line = line;
   stmt->column = column;
   stmt->as.try_catch.try_block = try_blk;
-  stmt->as.try_catch.catch_var = strdup(catch_var);
+  stmt->as.try_catch.catch_var = compilerStrdup(catch_var);
   stmt->as.try_catch.catch_block = catch_blk;
   stmt->as.try_catch.finally_block = finally_blk;
   return stmt;
 }
 
 Stmt *createPrintStmt(Expr *expression, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_PRINT;
   stmt->line = line;
   stmt->column = column;
@@ -644,96 +708,96 @@ Stmt *createPrintStmt(Expr *expression, int line, int column) {
 }
 
 Stmt *createExternDeclStmt(const char *libPath, const char *symName, const char *name, StringList *params, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_EXTERN_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.extern_decl.libraryPath = strdup(libPath);
-  stmt->as.extern_decl.symbolName = strdup(symName);
-  stmt->as.extern_decl.name = strdup(name);
+  stmt->as.extern_decl.libraryPath = compilerStrdup(libPath);
+  stmt->as.extern_decl.symbolName = compilerStrdup(symName);
+  stmt->as.extern_decl.name = compilerStrdup(name);
   stmt->as.extern_decl.params = params;
   return stmt;
 }
 
 Stmt *createIntentDeclStmt(const char *name, StringList *params, TypeInfo returnType, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_INTENT_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.intent_decl.name = strdup(name);
+  stmt->as.intent_decl.name = compilerStrdup(name);
   stmt->as.intent_decl.params = params;
   stmt->as.intent_decl.returnType = returnType;
   return stmt;
 }
 
 Stmt *createResolverDeclStmt(const char *name, const char *targetIntent, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_RESOLVER_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.resolver_decl.name = strdup(name);
-  stmt->as.resolver_decl.targetIntent = strdup(targetIntent);
+  stmt->as.resolver_decl.name = compilerStrdup(name);
+  stmt->as.resolver_decl.targetIntent = compilerStrdup(targetIntent);
   stmt->as.resolver_decl.body = body;
   return stmt;
 }
 
 Stmt *createResilientStmt(StmtList *body, const char *strategy, int retryCount, StmtList *recoveryBody, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_RESILIENT;
   stmt->line = line;
   stmt->column = column;
   stmt->as.resilient.body = body;
-  stmt->as.resilient.strategy = strategy ? strdup(strategy) : NULL;
+  stmt->as.resilient.strategy = strategy ? compilerStrdup(strategy) : NULL;
   stmt->as.resilient.retryCount = retryCount;
   stmt->as.resilient.recoveryBody = recoveryBody;
   return stmt;
 }
 
 Stmt *createPolicyDeclStmt(const char *policyName, const char *target, StmtList *rules, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_POLICY_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.policy_decl.policyName = strdup(policyName);
-  stmt->as.policy_decl.target = strdup(target);
+  stmt->as.policy_decl.policyName = compilerStrdup(policyName);
+  stmt->as.policy_decl.target = compilerStrdup(target);
   stmt->as.policy_decl.rules = rules;
   return stmt;
 }
 
 Stmt *createNodeDeclStmt(const char *name, StringList *capabilities, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_NODE_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.node_decl.name = strdup(name);
+  stmt->as.node_decl.name = compilerStrdup(name);
   stmt->as.node_decl.capabilities = capabilities;
   return stmt;
 }
 
 Stmt *createDistributedDeclStmt(const char *name, StmtList *fields, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_DISTRIBUTED_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.distributed_decl.name = strdup(name);
+  stmt->as.distributed_decl.name = compilerStrdup(name);
   stmt->as.distributed_decl.fields = fields;
   return stmt;
 }
 
 Stmt *createModelDeclStmt(const char *name, const char *architecture, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_MODEL_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.model_decl.name = strdup(name);
-  if(architecture) stmt->as.model_decl.architecture = strdup(architecture);
+  stmt->as.model_decl.name = compilerStrdup(name);
+  if(architecture) stmt->as.model_decl.architecture = compilerStrdup(architecture);
   else stmt->as.model_decl.architecture = NULL;
   stmt->as.model_decl.body = body;
   return stmt;
 }
 
 Stmt *createQuantumBlockStmt(StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_QUANTUM_BLOCK;
   stmt->line = line;
   stmt->column = column;
@@ -742,60 +806,60 @@ Stmt *createQuantumBlockStmt(StmtList *body, int line, int column) {
 }
 
 Stmt *createGPUBlockStmt(const char *kernelName, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_GPU_BLOCK;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.gpu_block.kernelName = kernelName ? strdup(kernelName) : NULL;
+  stmt->as.gpu_block.kernelName = kernelName ? compilerStrdup(kernelName) : NULL;
   stmt->as.gpu_block.body = body;
   return stmt;
 }
 
 Stmt *createVerifyStmt(const char *identityName, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_VERIFY;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.verify_stmt.identityName = strdup(identityName);
+  stmt->as.verify_stmt.identityName = compilerStrdup(identityName);
   stmt->as.verify_stmt.body = body;
   return stmt;
 }
 Stmt *createTensorDeclStmt(const char *name, const char *dataType, int *dims, int dimCount, Expr *initializer, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_TENSOR_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.tensor_decl.name = strdup(name);
-  stmt->as.tensor_decl.dataType = strdup(dataType);
+  stmt->as.tensor_decl.name = compilerStrdup(name);
+  stmt->as.tensor_decl.dataType = compilerStrdup(dataType);
   stmt->as.tensor_decl.dimCount = dimCount;
-  stmt->as.tensor_decl.dims = ALLOCATE(int, dimCount);
+  stmt->as.tensor_decl.dims = (int *)compilerAlloc(sizeof(int) * dimCount);
   memcpy(stmt->as.tensor_decl.dims, dims, sizeof(int) * dimCount);
   stmt->as.tensor_decl.initializer = initializer;
   return stmt;
 }
 
 Stmt *createContextDeclStmt(const char *name, StmtList *layers, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_CONTEXT_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.context_decl.name = strdup(name);
+  stmt->as.context_decl.name = compilerStrdup(name);
   stmt->as.context_decl.layers = layers;
   return stmt;
 }
 
 Stmt *createLayerDeclStmt(const char *name, StmtList *methods, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_LAYER_DECL;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.layer_decl.name = strdup(name);
+  stmt->as.layer_decl.name = compilerStrdup(name);
   stmt->as.layer_decl.methods = methods;
   return stmt;
 }
 
 Stmt *createActivateStmt(Expr *contextExpr, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_ACTIVATE;
   stmt->line = line;
   stmt->column = column;
@@ -805,348 +869,52 @@ Stmt *createActivateStmt(Expr *contextExpr, StmtList *body, int line, int column
 }
 
 Stmt *createUIAppStmt(const char *name, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_UI_APP;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.ui_app.name = strdup(name);
+  stmt->as.ui_app.name = compilerStrdup(name);
   stmt->as.ui_app.body = body;
   return stmt;
 }
 
 Stmt *createUIWindowStmt(const char *name, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_UI_WINDOW;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.ui_window.name = strdup(name);
+  stmt->as.ui_window.name = compilerStrdup(name);
   stmt->as.ui_window.body = body;
   return stmt;
 }
 
 Stmt *createUIComponentStmt(const char *tag, DictPairList *props, StmtList *children, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_UI_COMPONENT;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.ui_component.tag = strdup(tag);
+  stmt->as.ui_component.tag = compilerStrdup(tag);
   stmt->as.ui_component.props = props;
   stmt->as.ui_component.children = children;
   return stmt;
 }
 
 Stmt *createUIStateStmt(const char *name, Expr *initializer, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_UI_STATE;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.ui_state.name = strdup(name);
+  stmt->as.ui_state.name = compilerStrdup(name);
   stmt->as.ui_state.initializer = initializer;
   return stmt;
 }
 
 Stmt *createUIActionStmt(const char *name, StmtList *body, int line, int column) {
-  Stmt *stmt = ALLOCATE(Stmt, 1);
+  Stmt *stmt = COMPILER_NEW(Stmt);
   stmt->type = STMT_UI_ACTION;
   stmt->line = line;
   stmt->column = column;
-  stmt->as.ui_action.name = strdup(name);
+  stmt->as.ui_action.name = compilerStrdup(name);
   stmt->as.ui_action.body = body;
   return stmt;
 }
-
-// --- Free Functions ---
-
-void freeExpr(Expr *expr) {
-  if (!expr)
-    return;
-
-  switch (expr->type) {
-  case EXPR_BINARY:
-    freeExpr(expr->as.binary.left);
-    free(expr->as.binary.operator);
-    freeExpr(expr->as.binary.right);
-    break;
-  case EXPR_UNARY:
-    free(expr->as.unary.operator);
-    freeExpr(expr->as.unary.right);
-    break;
-  case EXPR_LITERAL:
-    // Value is managed separately
-    break;
-  case EXPR_GROUPING:
-    freeExpr(expr->as.grouping.expression);
-    break;
-  case EXPR_VARIABLE:
-    free(expr->as.variable.name);
-    break;
-  case EXPR_ASSIGN:
-    free(expr->as.assign.name);
-    freeExpr(expr->as.assign.value);
-    break;
-  case EXPR_LOGICAL:
-    freeExpr(expr->as.logical.left);
-    free(expr->as.logical.operator);
-    freeExpr(expr->as.logical.right);
-    break;
-  case EXPR_CALL:
-    freeExpr(expr->as.call.callee);
-    freeExprList(expr->as.call.arguments);
-    break;
-  case EXPR_GET:
-    freeExpr(expr->as.get.object);
-    free(expr->as.get.name);
-    break;
-  case EXPR_SET:
-    freeExpr(expr->as.set.object);
-    free(expr->as.set.name);
-    freeExpr(expr->as.set.value);
-    break;
-  case EXPR_INDEX:
-    freeExpr(expr->as.index.target);
-    freeExpr(expr->as.index.index);
-    break;
-  case EXPR_SET_INDEX:
-    freeExpr(expr->as.set_index.target);
-    freeExpr(expr->as.set_index.index);
-    freeExpr(expr->as.set_index.value);
-    break;
-  case EXPR_LIST:
-    freeExprList(expr->as.list.elements);
-    break;
-  case EXPR_DICTIONARY:
-    freeDictPairList(expr->as.dictionary.pairs);
-    break;
-  case EXPR_TERNARY:
-    freeExpr(expr->as.ternary.condition);
-    freeExpr(expr->as.ternary.true_branch);
-    freeExpr(expr->as.ternary.false_branch);
-    break;
-  case EXPR_LAMBDA:
-    freeStringList(expr->as.lambda.params);
-    freeStmtList(expr->as.lambda.body);
-    break;
-  case EXPR_AWAIT:
-    freeExpr(expr->as.await_expr.expression);
-    break;
-  case EXPR_THIS:
-    // Nothing to free
-    break;
-  case EXPR_SUPER:
-    if (expr->as.super_expr.method) free(expr->as.super_expr.method);
-    break;
-  case EXPR_NEW:
-    freeExpr(expr->as.new_expr.clazz);
-    if(expr->as.new_expr.args) freeExprList(expr->as.new_expr.args);
-    break;
-  case EXPR_SANITIZE:
-    freeExpr(expr->as.sanitize.value);
-    break;
-  case EXPR_CRYPTO:
-    freeExpr(expr->as.crypto.value);
-    break;
-  case EXPR_UNWRAP:
-    freeExpr(expr->as.unwrap.expression);
-    break;
-  case EXPR_TEMPLATE_LITERAL:
-    if (expr->as.template_literal.parts) freeExprList(expr->as.template_literal.parts);
-    break;
-  case EXPR_COMPTIME:
-    if (expr->as.comptime_expr.body) freeStmtList(expr->as.comptime_expr.body);
-    break;
-  case EXPR_ACTOR_SEND:
-    freeExpr(expr->as.actor_send.receiver);
-    freeExpr(expr->as.actor_send.message);
-    break;
-  case EXPR_ACTOR_REQUEST:
-    freeExpr(expr->as.actor_request.receiver);
-    freeExpr(expr->as.actor_request.message);
-    break;
-  }
-
-  FREE(Expr, expr);
-}
-
-void freeStmt(Stmt *stmt) {
-  if (!stmt)
-    return;
-
-  switch (stmt->type) {
-  case STMT_TYPE_ALIAS:
-    free(stmt->as.type_alias.name);
-    if (stmt->as.type_alias.targetType.name) free(stmt->as.type_alias.targetType.name);
-    break;
-  case STMT_TRAIT_DECL:
-    free(stmt->as.trait_decl.name);
-    freeStmtList(stmt->as.trait_decl.methods);
-    break;
-  case STMT_ACTOR_DECL:
-    free(stmt->as.actor_decl.name);
-    if(stmt->as.actor_decl.fields) freeStmtList(stmt->as.actor_decl.fields);
-    if(stmt->as.actor_decl.receives) freeStmtList(stmt->as.actor_decl.receives);
-    break;
-  case STMT_RECEIVE:
-    free(stmt->as.receive_stmt.messageType);
-    if(stmt->as.receive_stmt.messageVar) free(stmt->as.receive_stmt.messageVar);
-    if(stmt->as.receive_stmt.body) freeStmtList(stmt->as.receive_stmt.body);
-    if(stmt->as.receive_stmt.returnType.name) free(stmt->as.receive_stmt.returnType.name);
-    break;
-  case STMT_EXPRESSION:
-    freeExpr(stmt->as.expression.expression);
-    break;
-  case STMT_VAR_DECL:
-    free(stmt->as.var_decl.name);
-    freeExpr(stmt->as.var_decl.initializer);
-    break;
-  case STMT_FUNC_DECL:
-    free(stmt->as.func_decl.name);
-    freeStringList(stmt->as.func_decl.params);
-    freeStmtList(stmt->as.func_decl.body);
-    break;
-  case STMT_CLASS_DECL:
-    free(stmt->as.class_decl.name);
-    if (stmt->as.class_decl.superclass) freeExpr(stmt->as.class_decl.superclass);
-    freeStringList(stmt->as.class_decl.interfaces);
-    freeStmtList(stmt->as.class_decl.methods);
-    break;
-  case STMT_INTERFACE_DECL:
-    free(stmt->as.interface_decl.name);
-    freeStmtList(stmt->as.interface_decl.methods);
-    break;
-  case STMT_USE_DECL:
-    freeStringList(stmt->as.use_decl.modules);
-    break;
-  case STMT_IF:
-    freeExpr(stmt->as.if_stmt.condition);
-    freeStmt(stmt->as.if_stmt.then_branch);
-    freeStmt(stmt->as.if_stmt.else_branch);
-    break;
-  case STMT_WHILE:
-    freeExpr(stmt->as.while_stmt.condition);
-    freeStmt(stmt->as.while_stmt.body);
-    break;
-  case STMT_FOR:
-    freeStmt(stmt->as.for_stmt.initializer);
-    freeExpr(stmt->as.for_stmt.condition);
-    freeExpr(stmt->as.for_stmt.increment);
-    freeStmt(stmt->as.for_stmt.body);
-    break;
-  case STMT_RETURN:
-    freeExpr(stmt->as.return_stmt.value);
-    break;
-  case STMT_BLOCK:
-    freeStmtList(stmt->as.block.statements);
-    break;
-  case STMT_BREAK:
-  case STMT_CONTINUE:
-    // No fields to free
-    break;
-  case STMT_SWITCH:
-    freeExpr(stmt->as.switch_stmt.value);
-    freeSwitchCaseList(stmt->as.switch_stmt.cases);
-    freeStmtList(stmt->as.switch_stmt.default_case);
-    break;
-  case STMT_TRY_CATCH:
-    freeStmtList(stmt->as.try_catch.try_block);
-    free(stmt->as.try_catch.catch_var);
-    freeStmtList(stmt->as.try_catch.catch_block);
-    freeStmtList(stmt->as.try_catch.finally_block);
-    break;
-  case STMT_PRINT:
-    freeExpr(stmt->as.print.expression);
-    break;
-  case STMT_EXTERN_DECL:
-    free(stmt->as.extern_decl.libraryPath);
-    free(stmt->as.extern_decl.symbolName);
-    free(stmt->as.extern_decl.name);
-    freeStringList(stmt->as.extern_decl.params);
-    break;
-  case STMT_INTENT_DECL:
-    free(stmt->as.intent_decl.name);
-    freeStringList(stmt->as.intent_decl.params);
-    // free returnType if it has allocated name? TypeInfo struct has char* name.
-    if (stmt->as.intent_decl.returnType.name) free(stmt->as.intent_decl.returnType.name);
-    break;
-  case STMT_RESOLVER_DECL:
-    free(stmt->as.resolver_decl.name);
-    free(stmt->as.resolver_decl.targetIntent);
-    freeStmtList(stmt->as.resolver_decl.body);
-    break;
-  case STMT_RESILIENT:
-    freeStmtList(stmt->as.resilient.body);
-    if(stmt->as.resilient.strategy) free(stmt->as.resilient.strategy);
-    if(stmt->as.resilient.recoveryBody) freeStmtList(stmt->as.resilient.recoveryBody);
-    break;
-  case STMT_POLICY_DECL:
-    free(stmt->as.policy_decl.policyName);
-    free(stmt->as.policy_decl.target);
-    freeStmtList(stmt->as.policy_decl.rules);
-    break;
-  case STMT_NODE_DECL:
-    free(stmt->as.node_decl.name);
-    if(stmt->as.node_decl.capabilities) freeStringList(stmt->as.node_decl.capabilities);
-    break;
-  case STMT_DISTRIBUTED_DECL:
-    free(stmt->as.distributed_decl.name);
-    freeStmtList(stmt->as.distributed_decl.fields);
-    break;
-  case STMT_MODEL_DECL:
-    free(stmt->as.model_decl.name);
-    if(stmt->as.model_decl.architecture) free(stmt->as.model_decl.architecture);
-    if(stmt->as.model_decl.body) freeStmtList(stmt->as.model_decl.body);
-    break;
-  case STMT_QUANTUM_BLOCK:
-    if(stmt->as.quantum_block.body) freeStmtList(stmt->as.quantum_block.body);
-    break;
-  case STMT_GPU_BLOCK:
-    if(stmt->as.gpu_block.kernelName) free(stmt->as.gpu_block.kernelName);
-    if(stmt->as.gpu_block.body) freeStmtList(stmt->as.gpu_block.body);
-    break;
-  case STMT_VERIFY:
-    free(stmt->as.verify_stmt.identityName);
-    if(stmt->as.verify_stmt.body) freeStmtList(stmt->as.verify_stmt.body);
-    break;
-  case STMT_TENSOR_DECL:
-    free(stmt->as.tensor_decl.name);
-    free(stmt->as.tensor_decl.dataType);
-    if(stmt->as.tensor_decl.dims) free(stmt->as.tensor_decl.dims);
-    freeExpr(stmt->as.tensor_decl.initializer);
-    break;
-  case STMT_CONTEXT_DECL:
-    free(stmt->as.context_decl.name);
-    if(stmt->as.context_decl.layers) freeStmtList(stmt->as.context_decl.layers);
-    break;
-  case STMT_LAYER_DECL:
-    free(stmt->as.layer_decl.name);
-    if(stmt->as.layer_decl.methods) freeStmtList(stmt->as.layer_decl.methods);
-    break;
-  case STMT_ACTIVATE:
-    freeExpr(stmt->as.activate_stmt.contextExpr);
-    if(stmt->as.activate_stmt.body) freeStmtList(stmt->as.activate_stmt.body);
-    break;
-  case STMT_UI_APP:
-    free(stmt->as.ui_app.name);
-    freeStmtList(stmt->as.ui_app.body);
-    break;
-  case STMT_UI_WINDOW:
-    free(stmt->as.ui_window.name);
-    freeStmtList(stmt->as.ui_window.body);
-    break;
-  case STMT_UI_COMPONENT:
-    free(stmt->as.ui_component.tag);
-    freeDictPairList(stmt->as.ui_component.props);
-    freeStmtList(stmt->as.ui_component.children);
-    break;
-  case STMT_UI_STATE:
-    free(stmt->as.ui_state.name);
-    freeExpr(stmt->as.ui_state.initializer);
-    break;
-  case STMT_UI_ACTION:
-    free(stmt->as.ui_action.name);
-    freeStmtList(stmt->as.ui_action.body);
-    break;
-  }
-
-  FREE(Stmt, stmt);
-}
-
@@ -5,6 +5,7 @@
 //   Copyright © 2025. ProXentix India Pvt. Ltd.  All rights reserved.
 
 #include "parser.h"
+#include "arena.h"
 #include "memory.h"
 #include "../include/object.h"
 #include <stdarg.h>
@@ -221,14 +222,36 @@ static Token consume(Parser *p, PxTokenType type, const char *message) {
 }
 
 
-// Helper to extract token value as string
+// Helper to extract token value as string. The copy lives in the
+// compiler arena, so it may be stored in the AST and is never freed.
 static char *tokenToString(Token token) {
-  int len = token.length;
-  char *str = (char *)malloc(len + 1);
-  if (!str) { fprintf(stderr, "Fatal: OOM in tokenToString\n"); exit(1); }
-  memcpy(str, token.start, len);
-  str[len] = '\0';
-  return str;
+  return compilerCopyString(token.start, token.length);
+}
+
+static AstOperator binaryOperator(PxTokenType type) {
+  switch (type) {
+  case TOKEN_PLUS: return AST_OP_ADD;
+  case TOKEN_MINUS: return AST_OP_SUBTRACT;
+  case TOKEN_STAR: return AST_OP_MULTIPLY;
+  case TOKEN_SLASH: return AST_OP_DIVIDE;
+  case TOKEN_PERCENT: return AST_OP_MODULO;
+  case TOKEN_STAR_STAR: return AST_OP_POWER;
+  case TOKEN_AT: return AST_OP_MAT_MUL;
+  case TOKEN_EQUAL_EQUAL: return AST_OP_EQUAL;
+  case TOKEN_BANG_EQUAL: return AST_OP_NOT_EQUAL;
+  case TOKEN_LESS: return AST_OP_LESS;
+  case TOKEN_LESS_EQUAL: return AST_OP_LESS_EQUAL;
+  case TOKEN_GREATER: return AST_OP_GREATER;
+  case TOKEN_GREATER_EQUAL: return AST_OP_GREATER_EQUAL;
+  case TOKEN_AMPERSAND: return AST_OP_BIT_AND;
+  case TOKEN_PIPE: return AST_OP_BIT_OR;
+  case TOKEN_CARET: return AST_OP_BIT_XOR;
+  case TOKEN_LESS_LESS: return AST_OP_LEFT_SHIFT;
+  case TOKEN_GREATER_GREATER: return AST_OP_RIGHT_SHIFT;
+  case TOKEN_AMPERSAND_AMPERSAND:
+  case TOKEN_AND: return AST_OP_AND;
+  default: return AST_OP_OR; // || and 'or'
+  }
 }
 
 // === Tensor Literal Detection Helpers ===
@@ -379,7 +402,6 @@ static Stmt *declaration(Parser *p) {
           return funcDecl(p, "function", true, ACCESS_PUBLIC, false, false, contextCondition);
       // TODO: Handle async arrow functions if supported later
       parserError(p, "Expect 'func' after 'async'.");
-      if (contextCondition) freeExpr(contextCondition);
       return NULL;
   }
   if (match(p, 1, TOKEN_FUNC))
@@ -387,7 +409,6 @@ static Stmt *declaration(Parser *p) {
     
   if (contextCondition) {
       parserError(p, "Decorator must precede function declaration.");
-      freeExpr(contextCondition);
   }
 
   if (match(p, 1, TOKEN_CLASS))
@@ -494,7 +515,6 @@ static Stmt *operatorDecl(Parser *p, AccessLevel access, bool isStatic, bool isA
       Token param = consume(p, TOKEN_IDENTIFIER, "Expect parameter name.");
       char *paramName = tokenToString(param);
       appendString(params, paramName);
-      free(paramName);
       if (match(p, 1, TOKEN_COLON)) {
         if (check(p, TOKEN_IDENTIFIER) || check(p, TOKEN_VOID)) {
           advance(p);
@@ -535,7 +555,10 @@ static Stmt *operatorDecl(Parser *p, AccessLevel access, bool isStatic, bool isA
 
 static Stmt *funcDecl(Parser *p, const char *kind, bool isAsync, AccessLevel access, bool isStatic, bool isAbstract, Expr *contextCondition) {
   (void)kind;
-  Token nameToken = consume(p, TOKEN_IDENTIFIER, "Expect function name.");
+  // 'match' is a keyword only at the start of a statement, so it can still
+  // name a method (e.g. Regex.match)
+  Token nameToken = check(p, TOKEN_MATCH) ? advance(p)
+                                          : consume(p, TOKEN_IDENTIFIER, "Expect function name.");
   char *name = tokenToString(nameToken);
 
   StringList *genericParams = NULL;
@@ -548,12 +571,10 @@ static Stmt *funcDecl(Parser *p, const char *kind, bool isAsync, AccessLevel acc
               Token typeVar = consume(p, TOKEN_IDENTIFIER, "Expect generic parameter name.");
               char *tvName = tokenToString(typeVar);
               appendString(genericParams, tvName);
-              free(tvName);
               if (match(p, 1, TOKEN_COLON)) {
                   Token boundToken = consume(p, TOKEN_IDENTIFIER, "Expect trait bound.");
                   char *bName = tokenToString(boundToken);
                   appendString(genericBounds, bName);
-                  free(bName);
               } else {
                   appendString(genericBounds, ""); // Empty string for no bound
               }
@@ -570,7 +591,6 @@ static Stmt *funcDecl(Parser *p, const char *kind, bool isAsync, AccessLevel acc
       Token param = consume(p, TOKEN_IDENTIFIER, "Expect parameter name.");
       char *paramName = tokenToString(param);
       appendString(params, paramName);
-      free(paramName);
       if (match(p, 1, TOKEN_COLON)) {
         if (check(p, TOKEN_IDENTIFIER) || check(p, TOKEN_VOID)) {
           advance(p);
@@ -605,7 +625,6 @@ static Stmt *funcDecl(Parser *p, const char *kind, bool isAsync, AccessLevel acc
   }
 
   Stmt *stmt = createFuncDeclStmt(name, params, body, isAsync, access, isStatic, isAbstract, contextCondition, genericParams, genericBounds, nameToken.line, 0);
-  free(name);
   return stmt;
 }
 
@@ -623,12 +642,10 @@ static Stmt *classDecl(Parser *p) {
               Token typeVar = consume(p, TOKEN_IDENTIFIER, "Expect generic parameter name.");
               char *tvName = tokenToString(typeVar);
               appendString(genericParams, tvName);
-              free(tvName);
               if (match(p, 1, TOKEN_COLON)) {
                   Token boundToken = consume(p, TOKEN_IDENTIFIER, "Expect trait bound.");
                   char *bName = tokenToString(boundToken);
                   appendString(genericBounds, bName);
-                  free(bName);
               } else {
                   appendString(genericBounds, ""); // Empty string for no bound
               }
@@ -642,7 +659,6 @@ static Stmt *classDecl(Parser *p) {
     Token superToken = consume(p, TOKEN_IDENTIFIER, "Expect superclass name.");
     char *superName = tokenToString(superToken);
     superclass = createVariableExpr(superName, superToken.line, 0);
-    free(superName);
   }
   
   StringList *interfaces = NULL;
@@ -652,7 +668,6 @@ static Stmt *classDecl(Parser *p) {
           Token interfaceName = consume(p, TOKEN_IDENTIFIER, "Expect interface name.");
           char *iName = tokenToString(interfaceName);
           appendString(interfaces, iName);
-          free(iName);
       } while (match(p, 1, TOKEN_COMMA));
   }
 
@@ -680,7 +695,6 @@ static Stmt *classDecl(Parser *p) {
       match(p, 1, TOKEN_SEMICOLON);
       Stmt *fieldStmt = createVarDeclStmt(fieldName, initializer, false, false, 0, fieldToken.line, 0);
       appendStmt(methods, fieldStmt);
-      free(fieldName);
       continue;
     }
 
@@ -727,7 +741,6 @@ static Stmt *classDecl(Parser *p) {
 
   Stmt *stmt =
       createClassDeclStmt(name, superclass, interfaces, methods, genericParams, genericBounds, nameToken.line, 0);
-  free(name);
   return stmt;
 }
 
@@ -751,7 +764,6 @@ static Stmt *interfaceDecl(Parser *p) {
     consume(p, TOKEN_RIGHT_BRACE, "Expect '}'.");
     
     Stmt *stmt = createInterfaceDeclStmt(name, methods, nameToken.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -781,7 +793,6 @@ static Stmt *traitDecl(Parser *p) {
     consume(p, TOKEN_RIGHT_BRACE, "Expect '}'.");
     
     Stmt *stmt = createTraitDeclStmt(name, methods, nameToken.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -798,7 +809,6 @@ static Stmt *typeAliasDecl(Parser *p) {
     consume(p, TOKEN_SEMICOLON, "Expect ';' after type alias declaration.");
 
     Stmt *stmt = createTypeAliasDeclStmt(name, targetType, nameToken.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -831,7 +841,6 @@ static Stmt *actorDecl(Parser *p) {
             match(p, 1, TOKEN_SEMICOLON);
             Stmt *fieldStmt = createVarDeclStmt(fieldName, initializer, false, false, 0, fieldToken.line, 0);
             appendStmt(fields, fieldStmt);
-            free(fieldName);
         } else if (match(p, 1, TOKEN_RECEIVE)) {
             appendStmt(receives, receiveStmt(p));
         } else {
@@ -842,7 +851,6 @@ static Stmt *actorDecl(Parser *p) {
     
     consume(p, TOKEN_RIGHT_BRACE, "Expect '}'.");
     Stmt *stmt = createActorDeclStmt(name, fields, receives, nameToken.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -882,7 +890,6 @@ static Stmt *varDecl(Parser *p) {
 
   consume(p, TOKEN_SEMICOLON, "Expect ';' after variable declaration.");
   Stmt *stmt = createVarDeclStmt(name, initializer, is_const, isTemporal, ttl, nameToken.line, 0);
-  free(name);
   return stmt;
 }
 
@@ -901,7 +908,6 @@ static Stmt *useDecl(Parser *p) {
     Token part = advance(p);
     char *partStr = tokenToString(part);
     strcat(path, partStr);
-    free(partStr);
 
     while (match(p, 1, TOKEN_SLASH) || match(p, 1, TOKEN_DOT)) {
       if (check(p, TOKEN_IDENTIFIER) || check(p, TOKEN_NATIVE)) {
@@ -921,7 +927,6 @@ static Stmt *useDecl(Parser *p) {
       // Actually `stdlib_core.c` uses dots. So let's normalize to dots.
       partStr = tokenToString(part);
       strcat(path, partStr);
-      free(partStr);
     }
 
     appendString(modules, path);
@@ -952,7 +957,6 @@ static Stmt *externDecl(Parser *p) {
             Token param = consume(p, TOKEN_IDENTIFIER, "Expect parameter name.");
             char *paramName = tokenToString(param);
             appendString(params, paramName);
-            free(paramName);
         } while (match(p, 1, TOKEN_COMMA));
     }
     
@@ -960,9 +964,6 @@ static Stmt *externDecl(Parser *p) {
     consume(p, TOKEN_SEMICOLON, "Expect ';' after extern declaration.");
     
     Stmt *stmt = createExternDeclStmt(libPath, symName, name, params, libToken.line, 0);
-    free(libPath);
-    free(symName);
-    free(name);
     return stmt;
 }
 
@@ -977,7 +978,6 @@ static Stmt *intentDecl(Parser *p) {
             Token param = consume(p, TOKEN_IDENTIFIER, "Expect parameter name.");
             char *paramStr = tokenToString(param);
             appendString(params, paramStr);
-            free(paramStr);
         } while (match(p, 1, TOKEN_COMMA));
     }
     consume(p, TOKEN_RIGHT_PAREN, "Expect ')'.");
@@ -991,7 +991,6 @@ static Stmt *intentDecl(Parser *p) {
 
     consume(p, TOKEN_SEMICOLON, "Expect ';'.");
     Stmt *stmt = createIntentDeclStmt(name, params, returnType, nameToken.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -1005,7 +1004,6 @@ static Stmt *resolverDecl(Parser *p) {
     if (strcmp(matchesStr, "matches") != 0) {
         parserError(p, "Expect 'matches' after resolver name.");
     }
-    free(matchesStr);
     
     Token intentTok = consume(p, TOKEN_IDENTIFIER, "Expect target intent name.");
     char *intentName = tokenToString(intentTok);
@@ -1014,8 +1012,6 @@ static Stmt *resolverDecl(Parser *p) {
     StmtList *body = block(p); 
     
     Stmt *stmt = createResolverDeclStmt(name, intentName, body, nameToken.line, 0);
-    free(name);
-    free(intentName);
     return stmt;
 }
 
@@ -1081,9 +1077,29 @@ static Stmt *statement(Parser *p) {
   return exprStmt(p);
 }
 
+// After the '(' of a for: 'let x in', 'const x in' or 'x in' starts a
+// for-in loop rather than a C-style one
+static bool isForIn(Parser *p) {
+  int i = p->current;
+  if (p->tokens[i].type == TOKEN_LET || p->tokens[i].type == TOKEN_CONST) i++;
+  if (p->tokens[i].type != TOKEN_IDENTIFIER) return false;
+  return p->tokens[i + 1].type == TOKEN_IN;
+}
+
 static Stmt *forStmt(Parser *p) {
   consume(p, TOKEN_LEFT_PAREN, "Expect '('.");
 
+  if (isForIn(p)) {
+    match(p, 2, TOKEN_LET, TOKEN_CONST);
+    Token nameToken = consume(p, TOKEN_IDENTIFIER, "Expect loop variable name.");
+    char *name = tokenToString(nameToken);
+    consume(p, TOKEN_IN, "Expect 'in'.");
+    Expr *iterable = expression(p);
+    consume(p, TOKEN_RIGHT_PAREN, "Expect ')'.");
+    Stmt *body = statement(p);
+    return createForInStmt(name, iterable, body, nameToken.line, 0);
+  }
+
   Stmt *initializer = NULL;
   if (match(p, 1, TOKEN_SEMICOLON)) {
     // No initializer
@@ -1176,14 +1192,13 @@ static Stmt *tryStmt(Parser *p) {
   StmtList *tryBlock = block(p);
 
   StmtList *catchBlock = createStmtList();
-  char *catchVar = strdup("err");
+  char *catchVar = compilerStrdup("err");
   StmtList *finallyBlock = NULL;
 
   if (match(p, 1, TOKEN_CATCH)) {
     if (match(p, 1, TOKEN_LEFT_PAREN)) {
       Token varToken =
           consume(p, TOKEN_IDENTIFIER, "Expect error variable name.");
-      free(catchVar);
       catchVar = tokenToString(varToken);
       consume(p, TOKEN_RIGHT_PAREN, "Expect ')'.");
     }
@@ -1198,7 +1213,6 @@ static Stmt *tryStmt(Parser *p) {
 
   Stmt *stmt = createTryCatchStmt(tryBlock, catchVar, catchBlock, finallyBlock,
                                   previous(p).line, 0);
-  free(catchVar);
   return stmt;
 }
 
@@ -1240,7 +1254,7 @@ static Stmt *receiveStmt(Parser *p) {
             Token typeTok = consume(p, TOKEN_IDENTIFIER, "Expect message type.");
             msgType = tokenToString(typeTok);
         } else {
-            msgType = strdup("any");
+            msgType = compilerStrdup("any");
         }
         consume(p, TOKEN_RIGHT_PAREN, "Expect ')' after receive arguments.");
         
@@ -1265,8 +1279,6 @@ static Stmt *receiveStmt(Parser *p) {
     StmtList *body = block(p);
     
     Stmt *stmt = createReceiveStmt(msgType, msgVar, body, returnType, keyword.line, 0);
-    free(msgType);
-    if(msgVar) free(msgVar);
     return stmt;
 }
 
@@ -1369,10 +1381,8 @@ static Expr *orExpr(Parser *p) {
 
   while (match(p, 2, TOKEN_PIPE_PIPE, TOKEN_OR)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = andExpr(p);
-    expr = createLogicalExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createLogicalExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
 
   return expr;
@@ -1383,10 +1393,8 @@ static Expr *andExpr(Parser *p) {
 
   while (match(p, 2, TOKEN_AMPERSAND_AMPERSAND, TOKEN_AND)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = bitwiseOr(p);
-    expr = createLogicalExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createLogicalExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
 
   return expr;
@@ -1396,10 +1404,8 @@ static Expr *bitwiseOr(Parser *p) {
   Expr *expr = bitwiseXor(p);
   while (match(p, 1, TOKEN_PIPE)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = bitwiseXor(p);
-    expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
   return expr;
 }
@@ -1408,10 +1414,8 @@ static Expr *bitwiseXor(Parser *p) {
   Expr *expr = bitwiseAnd(p);
   while (match(p, 1, TOKEN_CARET)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = bitwiseAnd(p);
-    expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
   return expr;
 }
@@ -1420,10 +1424,8 @@ static Expr *bitwiseAnd(Parser *p) {
   Expr *expr = equality(p);
   while (match(p, 1, TOKEN_AMPERSAND)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = equality(p);
-    expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
   return expr;
 }
@@ -1433,10 +1435,8 @@ static Expr *equality(Parser *p) {
 
   while (match(p, 2, TOKEN_EQUAL_EQUAL, TOKEN_BANG_EQUAL)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = comparison(p);
-    expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
 
   return expr;
@@ -1448,10 +1448,8 @@ static Expr *comparison(Parser *p) {
   while (match(p, 4, TOKEN_GREATER, TOKEN_GREATER_EQUAL, TOKEN_LESS,
                TOKEN_LESS_EQUAL)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = bitwiseShift(p);
-    expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
 
   return expr;
@@ -1461,10 +1459,8 @@ static Expr *bitwiseShift(Parser *p) {
   Expr *expr = term(p);
   while (match(p, 2, TOKEN_LESS_LESS, TOKEN_GREATER_GREATER)) {
      Token op = previous(p);
-     char *opStr = tokenToString(op);
      Expr *right = term(p);
-     expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-     free(opStr);
+     expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
   return expr;
 }
@@ -1474,10 +1470,8 @@ static Expr *term(Parser *p) {
 
   while (match(p, 2, TOKEN_PLUS, TOKEN_MINUS)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = factor(p);
-    expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
 
   return expr;
@@ -1488,10 +1482,8 @@ static Expr *factor(Parser *p) {
 
   while (match(p, 5, TOKEN_SLASH, TOKEN_STAR, TOKEN_PERCENT, TOKEN_STAR_STAR, TOKEN_AT)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
     Expr *right = unary(p);
-    expr = createBinaryExpr(expr, opStr, right, op.line, 0);
-    free(opStr);
+    expr = createBinaryExpr(expr, binaryOperator(op.type), right, op.line, 0);
   }
 
   return expr;
@@ -1505,11 +1497,10 @@ static Expr *unary(Parser *p) {
   }
   if (match(p, 3, TOKEN_BANG, TOKEN_MINUS, TOKEN_TILDE)) {
     Token op = previous(p);
-    char *opStr = tokenToString(op);
+    AstOperator unaryOp = op.type == TOKEN_BANG ? AST_OP_NOT
+                        : op.type == TOKEN_MINUS ? AST_OP_NEGATE : AST_OP_BIT_NOT;
     Expr *right = unary(p);
-    Expr *expr = createUnaryExpr(opStr, right, op.line, 0);
-    free(opStr);
-    return expr;
+    return createUnaryExpr(unaryOp, right, op.line, 0);
   }
 
   return call(p);
@@ -1548,7 +1539,8 @@ static Expr *call(Parser *p) {
                  check(p, TOKEN_TRY) || check(p, TOKEN_CATCH) ||
                  check(p, TOKEN_FINALLY) || check(p, TOKEN_THROW) ||
                  check(p, TOKEN_SWITCH) || check(p, TOKEN_CASE) ||
-                 check(p, TOKEN_DEFAULT) || check(p, TOKEN_EXTENDS)) {
+                 check(p, TOKEN_DEFAULT) || check(p, TOKEN_EXTENDS) ||
+                 check(p, TOKEN_MATCH)) {
           // It's a keyword, but we want to use it as an identifier here.
           name = advance(p);
       } else {
@@ -1558,7 +1550,6 @@ static Expr *call(Parser *p) {
       
       char *nameStr = tokenToString(name);
       expr = createGetExpr(expr, nameStr, name.line, 0);
-      free(nameStr);
     } else if (match(p, 1, TOKEN_LEFT_BRACKET)) {
       Expr *index = expression(p);
       consume(p, TOKEN_RIGHT_BRACKET, "Expect ']'.");
@@ -1651,7 +1642,6 @@ static Expr *primary(Parser *p) {
     Token token = previous(p);
     char *numStr = tokenToString(token);
     double value = strtod(numStr, NULL);
-    free(numStr);
     return createLiteralExpr(NUMBER_VAL(value), token.line, 0);
   }
 
@@ -1663,7 +1653,7 @@ static Expr *primary(Parser *p) {
     memcpy(str, token.start + 1, len);
     str[len] = '\0';
     Expr *expr =
-        createLiteralExpr(OBJ_VAL(copyString(str, len)), token.line, 0);
+        createLiteralExpr(compilerString(str, len), token.line, 0);
     free(str);
     return expr;
   }
@@ -1711,7 +1701,7 @@ static Expr *primary(Parser *p) {
       if (*current == '$' && current + 1 < end && *(current + 1) == '{') {
         if (bufLen > 0) {
           buffer[bufLen] = '\0';
-          appendExpr(parts, createLiteralExpr(OBJ_VAL(copyString(buffer, bufLen)), token.line, 0));
+          appendExpr(parts, createLiteralExpr(compilerString(buffer, bufLen), token.line, 0));
           bufLen = 0;
         }
         current += 2; // Skip ${
@@ -1765,7 +1755,7 @@ static Expr *primary(Parser *p) {
 
     if (bufLen > 0 || parts->count == 0) {
       buffer[bufLen] = '\0';
-      appendExpr(parts, createLiteralExpr(OBJ_VAL(copyString(buffer, bufLen)), token.line, 0));
+      appendExpr(parts, createLiteralExpr(compilerString(buffer, bufLen), token.line, 0));
     }
 
     return createTemplateLiteralExpr(parts, token.line, token.column);
@@ -1783,7 +1773,6 @@ static Expr *primary(Parser *p) {
       Token method = consume(p, TOKEN_IDENTIFIER, "Expect superclass method name.");
       char *methodName = tokenToString(method);
       Expr *expr = createSuperExpr(methodName, keyword.line, 0);
-      free(methodName);
       return expr;
   }
 
@@ -1813,10 +1802,7 @@ static Expr *primary(Parser *p) {
 
   if (match(p, 1, TOKEN_IDENTIFIER)) {
     Token token = previous(p);
-    char *name = tokenToString(token);
-    Expr *expr = createVariableExpr(name, token.line, 0);
-    free(name);
-    return expr;
+    return createVariableExpr(internName(token.start, token.length), token.line, 0);
   }
 
   if (match(p, 1, TOKEN_LEFT_PAREN)) {
@@ -1848,7 +1834,7 @@ static Expr *primary(Parser *p) {
             listExpr->inferredType.kind = TYPE_UNKNOWN;  // We don't have TYPE_TENSOR in TypeKind
             char tensorMarker[256];
             snprintf(tensorMarker, sizeof(tensorMarker), "__TENSOR__%d", dimCount);
-            listExpr->inferredType.name = strdup(tensorMarker);
+            listExpr->inferredType.name = compilerStrdup(tensorMarker);
             listExpr->inferredType.paramCount = dimCount;
             listExpr->inferredType.paramCount = dimCount;
             
@@ -1887,7 +1873,6 @@ static Expr *primary(Parser *p) {
         Token paramTok = consume(p, TOKEN_IDENTIFIER, "Expect parameter name.");
         char *paramName = tokenToString(paramTok);
         appendString(parameters, paramName);
-        free(paramName);
         if (match(p, 1, TOKEN_COLON)) {
           advance(p);
         }
@@ -1919,8 +1904,6 @@ static Stmt *policyDecl(Parser *p) {
     StmtList *rules = block(p); 
     
     Stmt *stmt = createPolicyDeclStmt(name, target, rules, keyword.line, 0);
-    free(name);
-    free(target);
     return stmt;
 }
 
@@ -1938,7 +1921,6 @@ static Stmt *nodeDecl(Parser *p) {
     consume(p, TOKEN_RIGHT_BRACE, "Expect '}'.");
 
     Stmt *stmt = createNodeDeclStmt(name, caps, nameTok.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -1952,7 +1934,6 @@ static Stmt *distributedDecl(Parser *p) {
     StmtList *fields = block(p); // Reusing block parsing for fields/methods
     
     Stmt *stmt = createDistributedDeclStmt(name, fields, nameTok.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -1966,7 +1947,6 @@ static Stmt *modelDecl(Parser *p) {
     StmtList *body = block(p);
     
     Stmt *stmt = createModelDeclStmt(name, arch, body, nameTok.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -1990,7 +1970,6 @@ static Stmt *gpuStmt(Parser *p) {
     StmtList *body = block(p);
     
     Stmt *stmt = createGPUBlockStmt(kernelName, body, keyword.line, 0);
-    if(kernelName) free(kernelName);
     return stmt;
 }
 
@@ -2003,7 +1982,6 @@ static Stmt *verifyStmt(Parser *p) {
     StmtList *body = block(p);
     
     Stmt *stmt = createVerifyStmt(identityName, body, keyword.line, 0);
-    free(identityName);
     return stmt;
 }
 
@@ -2024,12 +2002,11 @@ static Stmt *tensorDecl(Parser *p) {
         Token numTok = consume(p, TOKEN_NUMBER, "Expect dimension size.");
         char *numStr = tokenToString(numTok);
         int dim = atoi(numStr);
-        free(numStr);
         
         if (dimCount + 1 > dimCap) {
             int oldCap = dimCap;
             dimCap = GROW_CAPACITY(oldCap);
-            dims = GROW_ARRAY(int, dims, oldCap, dimCap);
+            dims = COMPILER_GROW_ARRAY(int, dims, oldCap, dimCap);
         }
         dims[dimCount++] = dim;
         
@@ -2055,8 +2032,6 @@ static Stmt *tensorDecl(Parser *p) {
     consume(p, TOKEN_SEMICOLON, "Expect ';'.");
     
     Stmt *stmt = createTensorDeclStmt(name, dataType, dims, dimCount, initializer, line, 0);
-    free(dataType);
-    free(name);
     return stmt;
 }
 
@@ -2079,7 +2054,6 @@ static Stmt *contextDecl(Parser *p) {
     
     consume(p, TOKEN_RIGHT_BRACE, "Expect '}' after context body.");
     Stmt *stmt = createContextDeclStmt(name, layers, keyword.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -2105,7 +2079,6 @@ static Stmt *layerDecl(Parser *p) {
     
     consume(p, TOKEN_RIGHT_BRACE, "Expect '}' after layer body.");
     Stmt *stmt = createLayerDeclStmt(name, methods, keyword.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -2126,7 +2099,6 @@ static Stmt *activateStmt(Parser *p) {
     StmtList *body = block(p);
     
     Stmt *stmt = createActivateStmt(contextExpr, body, keyword.line, 0);
-    free(contextName);
     return stmt;
 }
 
@@ -2137,7 +2109,6 @@ static Stmt *uiAppDecl(Parser *p) {
     consume(p, TOKEN_LEFT_BRACE, "Expect '{' before App body.");
     StmtList *body = block(p);
     Stmt *stmt = createUIAppStmt(name, body, keyword.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -2148,7 +2119,6 @@ static Stmt *uiWindowDecl(Parser *p) {
     consume(p, TOKEN_LEFT_BRACE, "Expect '{' before Window body.");
     StmtList *body = block(p);
     Stmt *stmt = createUIWindowStmt(name, body, keyword.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -2162,7 +2132,6 @@ static Stmt *uiStateDecl(Parser *p) {
     }
     consume(p, TOKEN_SEMICOLON, "Expect ';' after state declaration.");
     Stmt *stmt = createUIStateStmt(name, initializer, keyword.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -2173,7 +2142,6 @@ static Stmt *uiActionDecl(Parser *p) {
     consume(p, TOKEN_LEFT_BRACE, "Expect '{' before action body.");
     StmtList *body = block(p);
     Stmt *stmt = createUIActionStmt(name, body, keyword.line, 0);
-    free(name);
     return stmt;
 }
 
@@ -2202,7 +2170,6 @@ static Stmt *uiComponentDecl(Parser *p) {
     }
 
     Stmt *stmt = createUIComponentStmt(tag, props, children, tagTok.line, 0);
-    free(tag);
     return stmt;
 }
 
@@ -365,7 +365,7 @@ static void transpileExpr(Expr *expr, FILE *out, bool isJS) {
 
         case EXPR_BINARY:
             transpileExpr(expr->as.binary.left, out, isJS);
-            fprintf(out, " %s ", expr->as.binary.operator);
+            fprintf(out, " %s ", astOperatorLexeme(expr->as.binary.op));
             transpileExpr(expr->as.binary.right, out, isJS);
             break;
 
@@ -5,6 +5,7 @@
 //   Copyright © 2025. ProXentix India Pvt. Ltd.  All rights reserved.
 
 #include "type_checker.h"
+#include "arena.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -33,13 +34,13 @@ static bool isTypesEqual(TypeInfo t1, TypeInfo t2) {
 
 static TypeInfo duplicateType(TypeInfo type) {
     TypeInfo copy = type;
-    if (type.name) copy.name = strdup(type.name);
+    if (type.name) copy.name = compilerStrdup(type.name);
     if (type.returnType) {
-        copy.returnType = (TypeInfo*)malloc(sizeof(TypeInfo));
+        copy.returnType = COMPILER_NEW(TypeInfo);
         *copy.returnType = duplicateType(*type.returnType);
     }
     if (type.paramTypes) {
-        copy.paramTypes = (TypeInfo*)malloc(sizeof(TypeInfo) * type.paramCount);
+        copy.paramTypes = (TypeInfo*)compilerAlloc(sizeof(TypeInfo) * type.paramCount);
         for (int i = 0; i < type.paramCount; i++) {
             copy.paramTypes[i] = duplicateType(type.paramTypes[i]);
         }
@@ -49,50 +50,27 @@ static TypeInfo duplicateType(TypeInfo type) {
 
 
 // --- Symbol Table Helpers ---
+// Symbols and types live in the compiler arena. Scope tables are large, so
+// closed scopes are kept on a free list and reused.
 
 static Scope* beginScope(TypeChecker* checker) {
-    Scope* scope = (Scope*)malloc(sizeof(Scope));
-    if (!scope) {
-        fprintf(stderr, "Fatal: Out of memory for scope.\n");
-        exit(1);
+    Scope* scope = checker->freeScopes;
+    if (scope != NULL) {
+        checker->freeScopes = scope->parent;
+        memset(scope->table, 0, sizeof(scope->table));
+    } else {
+        scope = COMPILER_NEW(Scope);
     }
-    memset(scope->table, 0, sizeof(scope->table));
     scope->parent = checker->currentScope;
     checker->currentScope = scope;
     return scope;
 }
 
-static void freeTypeInfoMembers(TypeInfo type) {
-    if (type.name) free(type.name);
-    if (type.returnType) {
-        freeTypeInfoMembers(*type.returnType);
-        free(type.returnType);
-    }
-    if (type.paramTypes) {
-        for (int i = 0; i < type.paramCount; i++) {
-            freeTypeInfoMembers(type.paramTypes[i]);
-        }
-        free(type.paramTypes);
-    }
-}
-
 static void endScope(TypeChecker* checker) {
     Scope* scope = checker->currentScope;
     checker->currentScope = scope->parent;
-    
-    // Free symbols in this scope
-    for (int i = 0; i < TABLE_SIZE; i++) {
-        Symbol* sym = scope->table[i];
-        while (sym) {
-            Symbol* next = sym->next;
-            // Free members of TypeInfo recursively
-            freeTypeInfoMembers(sym->type);
-            free(sym->name);
-            free(sym);
-            sym = next;
-        }
-    }
-    free(scope);
+    scope->parent = checker->freeScopes;
+    checker->freeScopes = scope;
 }
 
 static unsigned int hash(const char* name) {
@@ -108,8 +86,8 @@ static void defineSymbol(TypeChecker* checker, const char* name, TypeInfo type)
     Scope* scope = checker->currentScope;
     unsigned int idx = hash(name);
     
-    Symbol* sym = (Symbol*)malloc(sizeof(Symbol));
-    sym->name = strdup(name);
+    Symbol* sym = COMPILER_NEW(Symbol);
+    sym->name = compilerStrdup(name);
     sym->type = duplicateType(type);
     sym->next = scope->table[idx];
     scope->table[idx] = sym;
@@ -124,18 +102,6 @@ static void updateSymbol(TypeChecker* checker, const char* name, TypeInfo type)
         Symbol* sym = scope->table[idx];
         while (sym) {
             if (strcmp(sym->name, name) == 0) {
-                if (sym->type.name) free(sym->type.name);
-                if (sym->type.paramTypes) {
-                    for(int j=0; j<sym->type.paramCount; j++) {
-                        freeTypeInfoMembers(sym->type.paramTypes[j]);
-                    }
-                    free(sym->type.paramTypes);
-                }
-                if (sym->type.returnType) {
-                    freeTypeInfoMembers(*sym->type.returnType);
-                    free(sym->type.returnType);
-                }
-
                 // Update the type (including taint status)
                 sym->type = duplicateType(type);
                 return;
@@ -182,7 +148,7 @@ static TypeInfo checkBinary(TypeChecker* checker, Expr* expr) {
     TypeInfo l = checkExpr(checker, expr->as.binary.left);
     TypeInfo r = checkExpr(checker, expr->as.binary.right);
 
-    const char* op = expr->as.binary.operator;
+    AstOperator op = expr->as.binary.op;
     
     // If operands are unknown, we can't strict check, so we propagate unknown or assume valid?
     // Let's be safe: if unknown, we can't guarantee safety, but usually in static analysis we warn.
@@ -198,8 +164,8 @@ static TypeInfo checkBinary(TypeChecker* checker, Expr* expr) {
     }
 
     // Arithmetic: +, -, *, /, %
-    if (strcmp(op, "+") == 0 || strcmp(op, "-") == 0 || 
-        strcmp(op, "*") == 0 || strcmp(op, "/") == 0) {
+    if (op == AST_OP_ADD || op == AST_OP_SUBTRACT ||
+        op == AST_OP_MULTIPLY || op == AST_OP_DIVIDE) {
         
         TypeInfo result;
         
@@ -211,7 +177,7 @@ static TypeInfo checkBinary(TypeChecker* checker, Expr* expr) {
                    (l.kind == TYPE_FLOAT && r.kind == TYPE_INT)) {
             // Promotion
             result = createType(TYPE_FLOAT);
-        } else if (strcmp(op, "+") == 0) {
+        } else if (op == AST_OP_ADD) {
             // String Concatenation
             if (l.kind == TYPE_STRING && r.kind == TYPE_STRING) {
                 result = l;
@@ -233,8 +199,8 @@ static TypeInfo checkBinary(TypeChecker* checker, Expr* expr) {
     }
     
     // Comparisons: <, >, <=, >=
-    if (strcmp(op, "<") == 0 || strcmp(op, ">") == 0 || 
-        strcmp(op, "<=") == 0 || strcmp(op, ">=") == 0) {
+    if (op == AST_OP_LESS || op == AST_OP_GREATER ||
+        op == AST_OP_LESS_EQUAL || op == AST_OP_GREATER_EQUAL) {
         
         if (l.kind == TYPE_INT || l.kind == TYPE_FLOAT || l.kind == TYPE_UNKNOWN || l.kind == TYPE_CLASS) {
             if (r.kind == TYPE_INT || r.kind == TYPE_FLOAT || r.kind == TYPE_UNKNOWN || r.kind == TYPE_CLASS) {
@@ -251,7 +217,7 @@ static TypeInfo checkBinary(TypeChecker* checker, Expr* expr) {
     }
 
     // Equality: ==, !=
-    if (strcmp(op, "==") == 0 || strcmp(op, "!=") == 0) {
+    if (op == AST_OP_EQUAL || op == AST_OP_NOT_EQUAL) {
         if (!isTypesEqual(l, r)) {
             // "1" == 1 is often false in static strict
              // error(checker, expr->line, "Types must match for equality."); 
@@ -271,15 +237,15 @@ static TypeInfo checkBinary(TypeChecker* checker, Expr* expr) {
 
 static TypeInfo checkUnary(TypeChecker* checker, Expr* expr) {
     TypeInfo r = checkExpr(checker, expr->as.unary.right);
-    const char* op = expr->as.unary.operator;
+    AstOperator op = expr->as.unary.op;
 
-    if (strcmp(op, "!") == 0) {
+    if (op == AST_OP_NOT) {
         if (r.kind != TYPE_BOOL && r.kind != TYPE_UNKNOWN && r.kind != TYPE_CLASS) {
             error(checker, expr->line, "Example error: '!' requires boolean operand.");
         }
         return createType(TYPE_BOOL);
     }
-    if (strcmp(op, "-") == 0) {
+    if (op == AST_OP_NEGATE) {
         if (r.kind != TYPE_INT && r.kind != TYPE_FLOAT && r.kind != TYPE_UNKNOWN && r.kind != TYPE_CLASS) {
             error(checker, expr->line, "Negation requires numeric operand.");
         }
@@ -451,7 +417,7 @@ static TypeInfo checkExpr(TypeChecker* checker, Expr* expr) {
         case EXPR_LIST: {
              // Preserve existing type info if set (e.g. Tensor tag from Parser)
              if (expr->inferredType.name && strncmp(expr->inferredType.name, "__TENSOR__", 10) == 0) {
-                 result.name = strdup(expr->inferredType.name); 
+                 result.name = compilerStrdup(expr->inferredType.name); 
              }
              
              // Check elements
@@ -539,7 +505,7 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
              
              // We need to capture return type if specified or inferred
              if (stmt->as.func_decl.returnType.kind != TYPE_UNKNOWN) {
-                 funcType.returnType = (TypeInfo*)malloc(sizeof(TypeInfo));
+                 funcType.returnType = COMPILER_NEW(TypeInfo);
                  *funcType.returnType = stmt->as.func_decl.returnType;
              } else {
                  // Will try to infer from body later?
@@ -598,7 +564,7 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
         case STMT_CLASS_DECL: {
             TypeInfo classType = createType(TYPE_CLASS);
             if (stmt->as.class_decl.name) {
-                classType.name = strdup(stmt->as.class_decl.name);
+                classType.name = compilerStrdup(stmt->as.class_decl.name);
                 classType.methods = stmt->as.class_decl.methods;
                 defineSymbol(checker, stmt->as.class_decl.name, classType);
             }
@@ -675,7 +641,7 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
         case STMT_TRAIT_DECL: {
             TypeInfo traitType = createType(TYPE_INTERFACE); // Treat Trait as Interface for now
             if (stmt->as.trait_decl.name) {
-                traitType.name = strdup(stmt->as.trait_decl.name);
+                traitType.name = compilerStrdup(stmt->as.trait_decl.name);
                 traitType.methods = stmt->as.trait_decl.methods;
                 defineSymbol(checker, stmt->as.trait_decl.name, traitType);
             }
@@ -731,6 +697,14 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
             if (stmt->as.for_stmt.increment) checkExpr(checker, stmt->as.for_stmt.increment);
             checkStmt(checker, stmt->as.for_stmt.body);
             break;
+
+        case STMT_FOR_IN:
+            checkExpr(checker, stmt->as.for_in.iterable);
+            beginScope(checker);
+            defineSymbol(checker, stmt->as.for_in.name, createType(TYPE_UNKNOWN));
+            checkStmt(checker, stmt->as.for_in.body);
+            endScope(checker);
+            break;
             
         case STMT_PRINT:
             checkExpr(checker, stmt->as.print.expression);
@@ -751,7 +725,7 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
         case STMT_INTENT_DECL: {
             TypeInfo intentType = createType(TYPE_FUNCTION);
             if (stmt->as.intent_decl.returnType.kind != TYPE_UNKNOWN) {
-                intentType.returnType = (TypeInfo*)malloc(sizeof(TypeInfo));
+                intentType.returnType = COMPILER_NEW(TypeInfo);
                 *intentType.returnType = stmt->as.intent_decl.returnType;
             }
             // Define intent as a function-like symbol so calls work
@@ -814,14 +788,14 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
 
         case STMT_NODE_DECL: {
             TypeInfo nodeType = createType(TYPE_CLASS); // Treat as class
-            nodeType.name = strdup(stmt->as.node_decl.name);
+            nodeType.name = compilerStrdup(stmt->as.node_decl.name);
             defineSymbol(checker, stmt->as.node_decl.name, nodeType);
             break;
         }
 
         case STMT_DISTRIBUTED_DECL: {
             TypeInfo distType = createType(TYPE_CLASS); // Treat as struct/class
-            distType.name = strdup(stmt->as.distributed_decl.name);
+            distType.name = compilerStrdup(stmt->as.distributed_decl.name);
             
             defineSymbol(checker, stmt->as.distributed_decl.name, distType);
             
@@ -839,7 +813,7 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
 
         case STMT_MODEL_DECL: {
             TypeInfo modelType = createType(TYPE_CLASS); // Treat as class
-            modelType.name = strdup(stmt->as.model_decl.name);
+            modelType.name = compilerStrdup(stmt->as.model_decl.name);
             defineSymbol(checker, stmt->as.model_decl.name, modelType);
             
             beginScope(checker);
@@ -891,7 +865,7 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
 
         case STMT_CONTEXT_DECL: {
             TypeInfo contextType = createType(TYPE_CONTEXT);
-            contextType.name = strdup(stmt->as.context_decl.name);
+            contextType.name = compilerStrdup(stmt->as.context_decl.name);
             defineSymbol(checker, stmt->as.context_decl.name, contextType);
             
             beginScope(checker);
@@ -907,7 +881,7 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
 
         case STMT_LAYER_DECL: {
             TypeInfo layerType = createType(TYPE_LAYER);
-            layerType.name = strdup(stmt->as.layer_decl.name);
+            layerType.name = compilerStrdup(stmt->as.layer_decl.name);
             defineSymbol(checker, stmt->as.layer_decl.name, layerType);
 
             beginScope(checker);
@@ -931,19 +905,20 @@ static void checkStmt(TypeChecker* checker, Stmt* stmt) {
 void initTypeChecker(TypeChecker *checker) {
     checker->errorCount = 0;
     checker->currentScope = NULL;
+    checker->freeScopes = NULL;
     beginScope(checker); // Global Scope
     
     // Define Builtins
     
     // clock() -> Float
     TypeInfo clockType = createType(TYPE_FUNCTION);
-    clockType.returnType = (TypeInfo*)malloc(sizeof(TypeInfo));
+    clockType.returnType = COMPILER_NEW(TypeInfo);
     *clockType.returnType = createType(TYPE_FLOAT);
     defineSymbol(checker, "clock", clockType);
 
     // len(str) -> Float
     TypeInfo lenType = createType(TYPE_FUNCTION);
-    lenType.returnType = (TypeInfo*)malloc(sizeof(TypeInfo));
+    lenType.returnType = COMPILER_NEW(TypeInfo);
     *lenType.returnType = createType(TYPE_INT);
     defineSymbol(checker, "len", lenType);
 }
@@ -959,7 +934,7 @@ bool checkTypes(TypeChecker *checker, StmtList *statements) {
 }
 
 void freeTypeChecker(TypeChecker *checker) {
-    while (checker->currentScope) {
-        endScope(checker);
-    }
+    // Scopes and symbols belong to the compiler arena.
+    checker->currentScope = NULL;
+    checker->freeScopes = NULL;
 }
@@ -108,27 +108,30 @@ static void compileExprToWasm(Expr* expr, ByteBuffer* code, uint32_t* stringOffs
         case EXPR_BINARY: {
             compileExprToWasm(expr->as.binary.left, code, stringOffset, dataContent);
             compileExprToWasm(expr->as.binary.right, code, stringOffset, dataContent);
-            if (strcmp(expr->as.binary.operator, "+") == 0) writeByte(code, 0x6A); // i32.add
-            else if (strcmp(expr->as.binary.operator, "-") == 0) writeByte(code, 0x6B); // i32.sub
-            else if (strcmp(expr->as.binary.operator, "*") == 0) writeByte(code, 0x6C); // i32.mul
-            else if (strcmp(expr->as.binary.operator, "/") == 0) writeByte(code, 0x6D); // i32.div_s
-            else if (strcmp(expr->as.binary.operator, "%") == 0) writeByte(code, 0x6F); // i32.rem_s
-            else if (strcmp(expr->as.binary.operator, "==") == 0) writeByte(code, 0x46); // i32.eq
-            else if (strcmp(expr->as.binary.operator, "!=") == 0) writeByte(code, 0x47); // i32.ne
-            else if (strcmp(expr->as.binary.operator, "<") == 0) writeByte(code, 0x48); // i32.lt_s
-            else if (strcmp(expr->as.binary.operator, "<=") == 0) writeByte(code, 0x4C); // i32.le_s
-            else if (strcmp(expr->as.binary.operator, ">") == 0) writeByte(code, 0x4E); // i32.gt_s
-            else if (strcmp(expr->as.binary.operator, ">=") == 0) writeByte(code, 0x4E); // i32.ge_s
+            switch (expr->as.binary.op) {
+                case AST_OP_ADD: writeByte(code, 0x6A); break; // i32.add
+                case AST_OP_SUBTRACT: writeByte(code, 0x6B); break; // i32.sub
+                case AST_OP_MULTIPLY: writeByte(code, 0x6C); break; // i32.mul
+                case AST_OP_DIVIDE: writeByte(code, 0x6D); break; // i32.div_s
+                case AST_OP_MODULO: writeByte(code, 0x6F); break; // i32.rem_s
+                case AST_OP_EQUAL: writeByte(code, 0x46); break; // i32.eq
+                case AST_OP_NOT_EQUAL: writeByte(code, 0x47); break; // i32.ne
+                case AST_OP_LESS: writeByte(code, 0x48); break; // i32.lt_s
+                case AST_OP_LESS_EQUAL: writeByte(code, 0x4C); break; // i32.le_s
+                case AST_OP_GREATER: writeByte(code, 0x4A); break; // i32.gt_s
+                case AST_OP_GREATER_EQUAL: writeByte(code, 0x4E); break; // i32.ge_s
+                default: break;
+            }
             break;
         }
         case EXPR_UNARY: {
             compileExprToWasm(expr->as.unary.right, code, stringOffset, dataContent);
-            if (strcmp(expr->as.unary.operator, "-") == 0) {
+            if (expr->as.unary.op == AST_OP_NEGATE) {
                 // Negate: 0 - val
                 writeByte(code, 0x41); writeI32Leb128(code, 0); // i32.const 0
                 compileExprToWasm(expr->as.unary.right, code, stringOffset, dataContent);
                 writeByte(code, 0x6B); // i32.sub
-            } else if (strcmp(expr->as.unary.operator, "!") == 0) {
+            } else if (expr->as.unary.op == AST_OP_NOT) {
                 writeByte(code, 0x45); // i32.eqz
             }
             break;
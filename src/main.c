@@ -21,6 +21,8 @@
 #endif
 
 #include "bytecode.h"
+#include "bytecode_image.h"
+#include "snapshot.h"
 #include "common.h"
 #include "compiler.h"
 #include "debug.h"
@@ -36,7 +38,9 @@
 #include "prm/prm.h"
 #include "formatter.h"
 #include "wasm_gen.h"
+#include "module_graph.h"
 #include "error_report.h"
+#include "arena.h"
 
 void registerStdLib(VM* vm);
 
@@ -170,13 +174,15 @@ static void repl() {
     }
 
     // Parse
+    Arena arena;
+    beginCompilation(&arena);
     Parser parser;
     initParser(&parser, tokens, tokenCount, line);
     StmtList *statements = parse(&parser);
 
     if (statements == NULL || statements->count == 0) {
       fprintf(stderr, "Parse error\n");
-      if (statements != NULL) freeStmtList(statements);
+      endCompilation(&arena);
       continue;
     }
 
@@ -186,7 +192,7 @@ static void repl() {
     ObjFunction* function = newFunction();
     if (function == NULL) {
         fprintf(stderr, "Out of memory\n");
-        freeStmtList(statements);
+        endCompilation(&arena);
         continue;
     }
     push(&vm, OBJ_VAL(function));
@@ -194,14 +200,14 @@ static void repl() {
     if (!generateBytecode(statements, function)) {
         fprintf(stderr, "Compilation error\n");
         pop(&vm);
-        freeStmtList(statements);
+        endCompilation(&arena);
         continue;
     }
     pop(&vm);
     
     interpretChunk(&vm, &function->chunk);
 
-    freeStmtList(statements);
+    endCompilation(&arena);
   }
 }
 
@@ -215,45 +221,50 @@ static void runFile(const char *path) {
   }
 
   // Tokenize
-  Scanner scanner;
-  initScanner(&scanner, source);
-
-  Token tokens[4096];
   int tokenCount = 0;
+  Token *tokens = scanAllTokens(source, &tokenCount);
 
-  bool scanError = false;
-  for (;;) {
-    Token token = scanToken(&scanner);
-    if (tokenCount >= 4096) {
-      fprintf(stderr, "Error: Too many tokens\n");
-      scanError = true;
-      break;
-    }
-    tokens[tokenCount++] = token;
-
-    if (token.type == TOKEN_ERROR) {
-      scanError = true;
-      break;
-    }
-
-    if (token.type == TOKEN_EOF)
-      break;
-  }
-
-  if (scanError) {
+  if (tokens[tokenCount - 1].type == TOKEN_ERROR) {
+    free(tokens);
     trackSource(&vm, source);
     freeVM(&vm);
     exit(65);
   }
 
+  // --- Warm start: reuse the cached image when the source is unchanged ---
+  // Only for programs whose image cannot go stale while their source stays
+  // the same, which is decided before looking anything up.
+  uint8_t cacheKey[PROXC_KEY_SIZE];
+  bool cacheable = entryCacheable(&vm, tokens, tokenCount);
+  if (cacheable) {
+    proxc_cache_key(source, strlen(source), cacheKey);
+    ObjFunction *cached = proxc_cache_load(cacheKey);
+    if (cached != NULL) {
+      free(tokens);
+      InterpretResult result = interpretFunction(&vm, cached);
+      trackSource(&vm, source);
+      if (result != INTERPRET_OK) {
+        freeVM(&vm);
+        exit(70);
+      }
+      return;
+    }
+  }
+
+  // Front-end memory (AST, types) is released in one go once the bytecode
+  // has been generated.
+  Arena arena;
+  beginCompilation(&arena);
+
   // Parse
   Parser parser;
   initParser(&parser, tokens, tokenCount, source);
   StmtList *statements = parse(&parser);
+  free(tokens);
 
   if (statements == NULL || statements->count == 0) {
     fprintf(stderr, "Parse error\n");
-    if (statements != NULL) freeStmtList(statements);
+    endCompilation(&arena);
     trackSource(&vm, source);
     freeVM(&vm);
     exit(65);
@@ -269,12 +280,37 @@ static void runFile(const char *path) {
   if (!checkTypes(&checker, statements)) {
       fprintf(stderr, "Type Checking Failed with %d errors.\n", checker.errorCount);
       freeTypeChecker(&checker);
-      freeStmtList(statements);
+      endCompilation(&arena);
       trackSource(&vm, source);
       freeVM(&vm);
       exit(65);
   }
+
+  // Source modules reached through `use` get their front-ends run in
+  // parallel, then are linked in dependency order before the entry file.
+  ModuleGraph graph;
+  initModuleGraph(&graph, path);
+  if (!buildModuleGraph(&graph, statements)) {
+      freeTypeChecker(&checker);
+      endCompilation(&arena);
+      freeModuleGraph(&graph);
+      trackSource(&vm, source);
+      freeVM(&vm);
+      exit(65);
+  }
+  if (linkModuleGraph(&graph, &vm) != INTERPRET_OK) {
+      freeTypeChecker(&checker);
+      endCompilation(&arena);
+      freeModuleGraph(&graph);
+      trackSource(&vm, source);
+      freeVM(&vm);
+      exit(70);
+  }
+
   // --- Pipeline Step 3: UI Transpilation (if applicable) ---
+  // Recovered parse errors must be reported on every run, so they are not
+  // cached either.
+  cacheable = cacheable && !parser.hadError && graph.count == 0;
   for (int i = 0; i < statements->count; i++) {
       if (statements->items[i]->type == STMT_UI_APP) {
           const char* appName = statements->items[i]->as.ui_app.name;
@@ -292,17 +328,21 @@ static void runFile(const char *path) {
   }
 
   // --- Pipeline Step 4: Bytecode Gen & Execution ---
-  InterpretResult result = interpretAST(&vm, statements);
+  InterpretResult result = INTERPRET_COMPILE_ERROR;
+  ObjFunction *function = compileAST(&vm, statements);
   freeTypeChecker(&checker);
+  endCompilation(&arena);
+  if (function != NULL) {
+      if (cacheable) proxc_cache_store(cacheKey, function);
+      result = interpretFunction(&vm, function);
+  }
 
   trackSource(&vm, source);
+  freeModuleGraph(&graph);
   if (result != INTERPRET_OK) {
-      freeStmtList(statements);
       freeVM(&vm);
       exit(70);
   }
-
-  freeStmtList(statements);
 }
 
 
@@ -545,8 +585,14 @@ int main(int argc, const char *argv[]) {
   // Initialize VM
   initVM(&vm);
 
-  // Register standard library
-  registerStdLib(&vm);
+  // Register standard library, restoring the prebuilt heap from a snapshot
+  // in the per-user cache when this exact binary has written one before
+  char *snapshot = heapSnapshotPath();
+  if (snapshot == NULL || !loadHeapSnapshot(&vm, snapshot)) {
+    registerStdLib(&vm);
+    if (snapshot != NULL) saveHeapSnapshot(&vm, snapshot);
+  }
+  free(snapshot);
   
   // Populate CLI args
   vm.cliArgs = newList();
@@ -594,18 +640,14 @@ int main(int argc, const char *argv[]) {
           freeVM(&vm);
           return 1;
         }
-        Scanner scanner;
-        initScanner(&scanner, source);
-        Token tokens[4096];
+        Arena arena;
+        beginCompilation(&arena);
         int tokenCount = 0;
-        while (tokenCount < 4095) {
-          Token t = scanToken(&scanner);
-          tokens[tokenCount++] = t;
-          if (t.type == TOKEN_EOF) break;
-        }
+        Token* tokens = scanAllTokens(source, &tokenCount);
         Parser parser;
         initParser(&parser, tokens, tokenCount, source);
         StmtList* program = parse(&parser);
+        free(tokens);
 
         char outWasm[512];
         char outPrefix[512];
@@ -629,6 +671,7 @@ int main(int argc, const char *argv[]) {
         } else {
           fprintf(stderr, "[WASM] Failed to compile to WebAssembly.\n");
         }
+        endCompilation(&arena);
         free(source);
         freeVM(&vm);
         return 0;
@@ -5,13 +5,26 @@
 #include "transpiler_ui.h"
 #include "scanner.h"
 #include "parser.h"
+#include "arena.h"
+#include "vm.h"
+#include "optimizer.h"
+#include "type_checker.h"
+#include "module_graph.h"
+#include "bytecode_image.h"
 
 #ifdef _WIN32
 #include <process.h>
+#include <windows.h>
 #else
 #include <unistd.h>
 #include <sys/wait.h>
 #endif
+#include <sys/stat.h>
+#include <time.h>
+
+#define WATCH_POLL_MS 300
+
+void registerStdLib(VM* vm);
 
 // Helper to read file content for parsing
 static char* read_file_prm(const char* path) {
@@ -28,20 +41,11 @@ static char* read_file_prm(const char* path) {
     return buffer;
 }
 
-// Invoke the ProXPL interpreter/compiler
-static void invoke_compiler(const char* file, bool run) {
-    char command[MAX_PATH_LEN + 32];
-    
+// Invoke the ProXPL interpreter
+static void invoke_compiler(const char* file) {
     // Assumption: 'proxpl' is in PATH or current dir
     const char* exe = "proxpl";
     
-    if (run) {
-        snprintf(command, sizeof(command), "%s \"%s\"", exe, file);
-    } else {
-        printf("Compile-only mode not fully supported yet, running instead...\n");
-        snprintf(command, sizeof(command), "%s \"%s\"", exe, file);
-    }
-    
     // Simple validation
     const char* p = file;
     bool safe = true;
@@ -55,6 +59,7 @@ static void invoke_compiler(const char* file, bool run) {
     }
     
     printf("[PRM] Executing: %s \"%s\"\n", exe, file);
+    fflush(stdout); // Keep our lines ahead of the child's output
     
     int code = -1;
     #ifdef _WIN32
@@ -76,15 +81,165 @@ static void invoke_compiler(const char* file, bool run) {
     }
 }
 
+// Waits between polls of the watched files
+static void sleep_ms(int ms) {
+    #ifdef _WIN32
+    Sleep(ms);
+    #else
+    usleep((useconds_t)ms * 1000);
+    #endif
+}
+
+typedef struct {
+    char** paths;
+    time_t* mtimes;
+    long long* sizes;
+    int count;
+} WatchList;
+
+static void watch_add(WatchList* list, const char* path) {
+    list->paths = realloc(list->paths, sizeof(char*) * (list->count + 1));
+    list->mtimes = realloc(list->mtimes, sizeof(time_t) * (list->count + 1));
+    list->sizes = realloc(list->sizes, sizeof(long long) * (list->count + 1));
+    list->paths[list->count] = malloc(strlen(path) + 1);
+    strcpy(list->paths[list->count], path);
+
+    struct stat st;
+    bool exists = stat(path, &st) == 0;
+    list->mtimes[list->count] = exists ? st.st_mtime : 0;
+    list->sizes[list->count] = exists ? (long long)st.st_size : -1;
+    list->count++;
+}
+
+static void watch_free(WatchList* list) {
+    for (int i = 0; i < list->count; i++) free(list->paths[i]);
+    free(list->paths);
+    free(list->mtimes);
+    free(list->sizes);
+    memset(list, 0, sizeof(*list));
+}
+
+static bool watch_changed(const WatchList* list) {
+    for (int i = 0; i < list->count; i++) {
+        struct stat st;
+        bool exists = stat(list->paths[i], &st) == 0;
+        time_t mtime = exists ? st.st_mtime : 0;
+        long long size = exists ? (long long)st.st_size : -1;
+        if (mtime != list->mtimes[i] || size != list->sizes[i]) return true;
+    }
+    return false;
+}
+
+// Compile the entry point and every module it uses without running them.
+// The entry point and modules whose source and dependency interfaces are
+// unchanged since the last build are served from the bytecode cache. When
+// 'watched' is given, it receives every file the build read, including the
+// modules a failing build resolved. 'report' may be NULL.
+static bool compile_project(const char* entryPoint, WatchList* watched, BuildReport* report) {
+    if (watched) watch_add(watched, entryPoint);
+    if (report) report->modules = report->compiled = 0;
+
+    char* source = read_file_prm(entryPoint);
+    if (!source) {
+        fprintf(stderr, "[PRM] Error: Could not read entry point '%s'\n", entryPoint);
+        return false;
+    }
+
+    // Native modules are registered so the cache decision matches 'proxpl <file>'
+    initVM(&vm);
+    registerStdLib(&vm);
+    Arena arena;
+    beginCompilation(&arena);
+
+    int tokenCount = 0;
+    Token* tokens = scanAllTokens(source, &tokenCount);
+    StmtList* statements = NULL;
+    ObjFunction* cached = NULL;
+    bool hadError = true;
+    bool cacheable = false;
+    uint8_t key[PROXC_KEY_SIZE];
+    if (tokens[tokenCount - 1].type != TOKEN_ERROR) {
+        cacheable = entryCacheable(&vm, tokens, tokenCount);
+        if (cacheable) {
+            proxc_cache_key(source, strlen(source), key);
+            cached = proxc_cache_load(key);
+        }
+        if (cached == NULL) {
+            Parser parser;
+            initParser(&parser, tokens, tokenCount, source);
+            statements = parse(&parser);
+            hadError = parser.hadError;
+        }
+    }
+    free(tokens);
+
+    // A cached entry point only uses native modules, so its graph is empty
+    bool ok = cached != NULL || statements != NULL;
+    bool entryCompiled = false;
+    ModuleGraph graph;
+    initModuleGraph(&graph, entryPoint);
+    if (cached == NULL && ok) {
+        optimizeAST(statements);
+        TypeChecker checker;
+        initTypeChecker(&checker);
+        ok = checkTypes(&checker, statements);
+        if (!ok) fprintf(stderr, "Type Checking Failed with %d errors.\n", checker.errorCount);
+        freeTypeChecker(&checker);
+
+        // Watch mode resolves the modules even when the entry point failed,
+        // so fixing one of them triggers the next pass
+        bool built = (ok || watched != NULL) && buildModuleGraph(&graph, statements);
+        ok = ok && built && compileModuleGraph(&graph, &vm);
+        if (ok) {
+            ObjFunction* function = compileAST(&vm, statements);
+            ok = entryCompiled = function != NULL;
+            // Matches what 'proxpl <file>' caches, so the next run starts warm
+            if (ok && cacheable && !hadError && graph.count == 0) proxc_cache_store(key, function);
+        }
+    }
+
+    int compiled = entryCompiled ? 1 : 0;
+    for (int i = 0; i < graph.count; i++) {
+        if (graph.units[i]->compiled) compiled++;
+    }
+    if (report) {
+        report->modules = graph.count + 1;
+        report->compiled = compiled;
+    }
+    if (ok) {
+        printf("[PRM] %d module(s): %d compiled, %d up to date.\n",
+               graph.count + 1, compiled, graph.count + 1 - compiled);
+    }
+
+    for (int i = 0; watched && i < graph.count; i++) {
+        watch_add(watched, graph.units[i]->path);
+    }
+    freeModuleGraph(&graph);
+    endCompilation(&arena);
+    freeVM(&vm);
+    free(source);
+    return ok;
+}
+
+bool prm_compile(const char* entryPoint, bool watching, BuildReport* report) {
+    WatchList watched = {0};
+    bool ok = compile_project(entryPoint, watching ? &watched : NULL, report);
+    report->watched = watched.count;
+    watch_free(&watched);
+    return ok;
+}
+
 void prm_build(const Manifest* manifest, bool releaseMode) {
     (void)releaseMode;
     printf("[PRM] Building project: %s v%s\n", manifest->name, manifest->version);
     
     prm_init_cache();
     prm_save_lockfile(manifest);
-    // In the future, check if build is needed
-    
-    invoke_compiler(manifest->entryPoint, false);
+
+    if (!compile_project(manifest->entryPoint, NULL, NULL)) {
+        fprintf(stderr, "[PRM] Build failed.\n");
+        exit(65);
+    }
 }
 
 void prm_build_web(const Manifest* manifest, const char* outputDir) {
@@ -97,23 +252,19 @@ void prm_build_web(const Manifest* manifest, const char* outputDir) {
     }
 
     // Pipeline: Scanner -> Parser
-    Scanner scanner;
-    initScanner(&scanner, source);
-
-    Token tokens[4096];
+    Arena arena;
+    beginCompilation(&arena);
     int tokenCount = 0;
-    for (;;) {
-        Token token = scanToken(&scanner);
-        tokens[tokenCount++] = token;
-        if (token.type == TOKEN_EOF || tokenCount >= 4096) break;
-    }
+    Token* tokens = scanAllTokens(source, &tokenCount);
 
     Parser parser;
     initParser(&parser, tokens, tokenCount, source);
     StmtList* statements = parse(&parser);
+    free(tokens);
 
     if (!statements) {
         fprintf(stderr, "[PRM] Error: Parse failed for '%s'\n", manifest->entryPoint);
+        endCompilation(&arena);
         free(source);
         return;
     }
@@ -141,12 +292,32 @@ void prm_build_web(const Manifest* manifest, const char* outputDir) {
         printf("[PRM] Error: No 'App' definition found in '%s'. 'prm build web' requires a UI App.\n", manifest->entryPoint);
     }
 
-    freeStmtList(statements);
+    endCompilation(&arena);
     free(source);
 }
 
 void prm_run(const Manifest* manifest) {
     printf("[PRM] Running project: %s v%s\n", manifest->name, manifest->version);
     prm_save_lockfile(manifest);
-    invoke_compiler(manifest->entryPoint, true);
+    invoke_compiler(manifest->entryPoint);
+}
+
+void prm_watch(const Manifest* manifest) {
+    printf("Starting watch mode for %s...\n", manifest->name);
+    prm_init_cache();
+
+    for (;;) {
+        // Each pass rebuilds incrementally, so only edited modules and
+        // users of a changed interface go through the front-end again.
+        WatchList watched = {0};
+        if (compile_project(manifest->entryPoint, &watched, NULL)) {
+            invoke_compiler(manifest->entryPoint);
+        }
+        printf("[PRM] Watching %d file(s) for changes...\n", watched.count);
+        fflush(stdout);
+
+        while (!watch_changed(&watched)) sleep_ms(WATCH_POLL_MS);
+        watch_free(&watched);
+        printf("[PRM] Change detected, rebuilding...\n");
+    }
 }
@@ -108,12 +108,6 @@ void prm_clean() {
     printf("Clean complete.\n");
 }
 
-void prm_watch(const Manifest* manifest) {
-    printf("Starting watch mode for %s...\n", manifest->name);
-    printf("Watching for file changes...\n");
-    // TODO: File watcher loop
-}
-
 void prm_create(const char* templateName, const char* projectName) {
     printf("Creating project '%s' from template '%s'...\n", projectName, templateName);
     prm_init(projectName);
@@ -32,6 +32,18 @@ bool prm_load_manifest(Manifest* manifest);
 // Build the project
 void prm_build(const Manifest* manifest, bool releaseMode);
 
+// What one compile pass did; 'prm build' prints it, 'prm watch' polls the files
+typedef struct {
+    int modules;     // Entry point plus the source modules it uses
+    int compiled;    // Of those, how many went through the front-end
+    int watched;     // Files the pass read
+} BuildReport;
+
+// Compile the entry point and every module it uses without running them.
+// With 'watching' set, a failed entry point still resolves its modules, as
+// in 'prm watch'.
+bool prm_compile(const char* entryPoint, bool watching, BuildReport* report);
+
 // Build the project for web (UI App)
 void prm_build_web(const Manifest* manifest, const char* outputDir);
 
@@ -15,6 +15,7 @@
 #include "../include/proxpl_api.h"
 #include "../include/vm.h"
 #include "../include/bytecode.h"
+#include "../include/bytecode_image.h"
 #include "../include/common.h"
 #include "../include/file_utils.h"
 
@@ -49,17 +50,27 @@ InterpretResult proxpl_interpret_file(VM *pvm, const char *path) {
     return result;
 }
 
-// These functions are STUBBED because bytecode.c was deleted.
-// You must re-implement binary serialization later if you need it.
 int proxpl_write_chunk_to_file(const char *path, const Chunk *chunk) {
-    (void)path; (void)chunk;
-    fprintf(stderr, "Feature 'write_chunk_to_file' is temporarily disabled.\n");
-    return -1;
+    if (path == NULL || chunk == NULL) return -1;
+    return write_chunk_to_file(path, chunk);
 }
 
 int proxpl_read_chunk_from_file(const char *path, Chunk *out) {
-    (void)path; (void)out;
-    fprintf(stderr, "Feature 'read_chunk_from_file' is temporarily disabled.\n");
-    return -1;
+    if (path == NULL || out == NULL) return -1;
+    return read_chunk_from_file(path, out);
 }
 
+int proxpl_write_image(const char *path, ObjFunction *function) {
+    if (path == NULL || function == NULL) return -1;
+    return write_function_image(path, function);
+}
+
+InterpretResult proxpl_interpret_image(VM *pvm, const char *path) {
+    if (pvm == NULL || path == NULL) return INTERPRET_RUNTIME_ERROR;
+    ObjFunction *function = read_function_image(path);
+    if (function == NULL) {
+        fprintf(stderr, "API Error: '%s' is not a valid bytecode image.\n", path);
+        return INTERPRET_COMPILE_ERROR;
+    }
+    return interpretFunction(pvm, function);
+}
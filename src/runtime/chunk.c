@@ -18,11 +18,14 @@ void initChunk(Chunk *chunk) {
   chunk->exceptionHandlers.handlers = NULL;
   chunk->exceptionHandlers.count = 0;
   chunk->exceptionHandlers.capacity = 0;
+  chunk->borrowed = false;
 }
 
 void freeChunk(Chunk *chunk) {
-  FREE_ARRAY(u8, chunk->code, chunk->capacity);
-  FREE_ARRAY(int, chunk->lines, chunk->capacity);
+  if (!chunk->borrowed) {
+    FREE_ARRAY(u8, chunk->code, chunk->capacity);
+    FREE_ARRAY(int, chunk->lines, chunk->capacity);
+  }
   freeValueArray(&chunk->constants);
   FREE_ARRAY(ExceptionHandler, chunk->exceptionHandlers.handlers, chunk->exceptionHandlers.capacity);
   initChunk(chunk);
@@ -10,9 +10,11 @@
 #include "../include/gc.h"
 #include "../include/object.h"
 #include "../include/compiler.h"
+#include "../include/arena.h"
 #include "../include/table.h"
 #include "../include/memory.h"
 #include "../include/vm.h"
+#include "../include/jit.h"
 
 #ifdef DEBUG_LOG_GC
 #include "../include/debug.h"
@@ -99,7 +101,8 @@ void* reallocate(void* pointer, size_t oldSize, size_t newSize) {
     
     if (newSize > oldSize) {
 #ifdef DEBUG_STRESS_GC
-        collectGarbage(&vm);
+        // nextGC is parked at SIZE_MAX while collection must not run
+        if (vm.nextGC != (size_t)-1) collectGarbage(&vm);
 #endif
         if (vm.bytesAllocated > vm.nextGC) {
             collectGarbage(&vm);
@@ -199,6 +202,7 @@ static void blackenObject(Obj* object) {
         case OBJ_FUNCTION: {
             ObjFunction* function = (ObjFunction*)object;
             markObject((Obj*)function->name);
+            markObject((Obj*)function->sharedClosure);
             markArray(&function->chunk.constants);
             break;
         }
@@ -213,12 +217,26 @@ static void blackenObject(Obj* object) {
             markObject((Obj*)foreign->name);
             break;
         }
+        case OBJ_BUFFER:
+            markObject((Obj*)((ObjBuffer*)object)->owner);
+            break;
+        case OBJ_ITERATOR: {
+            ObjIterator* iterator = (ObjIterator*)object;
+            markValue(iterator->source);
+            markValue(iterator->other);
+            markValue(iterator->fn);
+            break;
+        }
         case OBJ_CLOSURE: {
             ObjClosure* closure = (ObjClosure*)object;
             markObject((Obj*)closure->function);
             for (int i = 0; i < closure->upvalueCount; i++) {
                 markObject((Obj*)closure->upvalues[i]);
             }
+            for (int i = 0; i < closure->captureCount; i++) {
+                markValue(closure->captures[i]);
+            }
+            markObject((Obj*)closure->promoted);
             break;
         }
         case OBJ_UPVALUE:
@@ -281,6 +299,7 @@ static void blackenObject(Obj* object) {
             break;
         }
         case OBJ_TENSOR:
+        case OBJ_TYPED_ARRAY:
             break;
         case OBJ_ACTOR: {
             ObjActor* actor = (ObjActor*)object;
@@ -316,8 +335,8 @@ static void markRoots() {
     for (int i = 0; i < vm.frameCount; i++) {
         markObject((Obj*)vm.frames[i].closure);
     }
-    for (ObjUpvalue* upvalue = vm.openUpvalues; upvalue != NULL; upvalue = upvalue->next) {
-        markObject((Obj*)upvalue);
+    for (int i = 0; i < vm.openUpvalueTop; i++) {
+        markObject((Obj*)vm.openUpvalues[i]);
     }
     markTable(&vm.globals);
     markObject((Obj*)vm.initString);
@@ -327,6 +346,8 @@ static void markRoots() {
         markObject((Obj*)vm.activeContextStack[i]);
     }
     markCompilerRoots();
+    markBytecodeGenRoots();
+    markCompilerArenas();
 }
 
 static void traceReferences() {
@@ -336,7 +357,40 @@ static void traceReferences() {
     }
 }
 
+// Buffer storage lives outside the heap (possibly as a file mapping), so it
+// is released even when the header itself is in the nursery
+static void releaseBufferStorage(ObjBuffer* buffer) {
+    if (buffer->owner != NULL) return;
+    if (buffer->release != NULL) {
+        buffer->release(buffer);
+    } else {
+        FREE_ARRAY(uint8_t, buffer->data, buffer->capacity);
+    }
+    buffer->data = NULL;
+    buffer->capacity = 0;
+}
+
+// Likewise for typed array storage: large arrays live on the heap even
+// when their header is in the nursery
+static void releaseTypedArrayStorage(ObjTypedArray* array) {
+    if (array->kind == TYPED_FLOAT64) {
+        FREE_ARRAY(double, array->as.f64, array->count);
+    } else {
+        FREE_ARRAY(int32_t, array->as.i32, array->count);
+    }
+    array->count = 0;
+}
+
+// Likewise for native handles such as open files and hasher state
+static void finalizeForeign(ObjForeign* foreign) {
+    if (foreign->finalize != NULL && foreign->library != NULL) foreign->finalize(foreign);
+    foreign->library = NULL;
+}
+
 static void freeObject(Obj* object) {
+    if (object->type == OBJ_BUFFER) releaseBufferStorage((ObjBuffer*)object);
+    if (object->type == OBJ_TYPED_ARRAY) releaseTypedArrayStorage((ObjTypedArray*)object);
+    if (object->type == OBJ_FOREIGN) finalizeForeign((ObjForeign*)object);
     if (is_in_nursery(object)) return; // Don't free nursery objects individually
 
 #ifdef DEBUG_LOG_GC
@@ -355,6 +409,7 @@ static void freeObject(Obj* object) {
             if (function->cache != NULL) {
                 reallocate(function->cache, sizeof(GICEntry) * function->chunk.count, 0);
             }
+            jitRelease(function);
             freeChunk(&function->chunk);
             FREE(ObjFunction, object);
             break;
@@ -367,6 +422,18 @@ static void freeObject(Obj* object) {
             FREE(ObjForeign, object);
             break;
         }
+        case OBJ_BUFFER: {
+            FREE(ObjBuffer, object);
+            break;
+        }
+        case OBJ_ITERATOR: {
+            FREE(ObjIterator, object);
+            break;
+        }
+        case OBJ_TYPED_ARRAY: {
+            FREE(ObjTypedArray, object);
+            break;
+        }
         case OBJ_MODULE: {
             ObjModule* module = (ObjModule*)object;
             freeTable(&module->exports);
@@ -376,6 +443,7 @@ static void freeObject(Obj* object) {
         case OBJ_CLOSURE: {
             ObjClosure* closure = (ObjClosure*)object;
             FREE_ARRAY(ObjUpvalue*, closure->upvalues, closure->upvalueCount);
+            FREE_ARRAY(Value, closure->captures, closure->captureCount);
             FREE(ObjClosure, object);
             break;
         }
@@ -508,6 +576,8 @@ void collectGarbage(VM* vm_ptr) {
     tableRemoveWhite(&vm.strings);
     
     sweep();
+    // Stack closures are not on the object list, so sweep() missed them
+    unmarkStackClosures(&vm);
     
     // reset_nursery(); // Dangerous without evacuation
     
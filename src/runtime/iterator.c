@@ -0,0 +1,193 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+/*
+ * Lazy iterator stages (see iterator.h). Each kind advances by pulling
+ * from its upstream stage through iteratorNext(), so a pipeline is a walk
+ * down a short chain of objects per item rather than a pass per stage.
+ */
+
+#include "../../include/iterator.h"
+#include "../../include/vm.h"
+
+// Marks the iterator exhausted and lets go of its upstream stages, which
+// may be long-lived sources the GC can then reclaim
+static bool finish(ObjIterator *iterator) {
+  iterator->done = true;
+  iterator->source = NIL_VAL;
+  iterator->other = NIL_VAL;
+  iterator->fn = NIL_VAL;
+  return false;
+}
+
+// Length of the UTF-8 sequence starting with 'lead', so strings iterate by
+// character rather than byte
+static int utf8Length(uint8_t lead) {
+  if (lead >= 0xF0) return 4;
+  if (lead >= 0xE0) return 3;
+  if (lead >= 0xC0) return 2;
+  return 1;
+}
+
+static bool sequenceNext(ObjIterator *iterator, Value *out) {
+  Value sequence = iterator->source;
+  int64_t i = iterator->position;
+  if (IS_LIST(sequence)) {
+    // Checked every step: the list may change while it is iterated
+    ObjList *list = AS_LIST(sequence);
+    if (i >= list->count) return finish(iterator);
+    *out = list->items[i];
+    iterator->position++;
+    return true;
+  }
+  if (IS_TENSOR(sequence)) {
+    ObjTensor *tensor = AS_TENSOR(sequence);
+    if (i >= tensor->size) return finish(iterator);
+    *out = NUMBER_VAL(tensor->data[i]);
+    iterator->position++;
+    return true;
+  }
+  if (IS_TYPED_ARRAY(sequence)) {
+    ObjTypedArray *array = AS_TYPED_ARRAY(sequence);
+    if (i >= array->count) return finish(iterator);
+    *out = NUMBER_VAL(typedArrayGet(array, (int)i));
+    iterator->position++;
+    return true;
+  }
+  ObjString *string = AS_STRING(sequence);
+  if (i >= string->length) return finish(iterator);
+  int length = utf8Length((uint8_t)string->chars[i]);
+  if (length > string->length - i) length = (int)(string->length - i);
+  iterator->position += length;
+  *out = OBJ_VAL(copyString(string->chars + i, length));
+  return true;
+}
+
+// [a, b], for zip and enumerate. Both values are kept on the stack while
+// the list is allocated.
+static Value makePair(Value a, Value b) {
+  push(&vm, a);
+  push(&vm, b);
+  ObjList *pair = newList();
+  push(&vm, OBJ_VAL(pair));
+  appendToList(pair, a);
+  appendToList(pair, b);
+  pop(&vm);
+  pop(&vm);
+  pop(&vm);
+  return OBJ_VAL(pair);
+}
+
+ObjIterator *iteratorOf(Value value) {
+  if (IS_ITERATOR(value)) return AS_ITERATOR(value);
+  if (IS_LIST(value) || IS_TENSOR(value) || IS_TYPED_ARRAY(value) || IS_STRING(value)) {
+    return newIterator(ITER_SEQUENCE, value);
+  }
+  return NULL;
+}
+
+bool iteratorNext(ObjIterator *iterator, Value *out) {
+  if (iterator->done) return false;
+
+  switch (iterator->kind) {
+    case ITER_RANGE: {
+      // Computed from the position rather than accumulated, so long ranges
+      // with fractional steps do not drift
+      double value = iterator->start + (double)iterator->position * iterator->step;
+      if (iterator->step > 0 ? value >= iterator->stop : value <= iterator->stop) {
+        return finish(iterator);
+      }
+      iterator->position++;
+      *out = NUMBER_VAL(value);
+      return true;
+    }
+
+    case ITER_SEQUENCE:
+      return sequenceNext(iterator, out);
+
+    case ITER_MAP: {
+      Value item;
+      if (!iteratorNext(AS_ITERATOR(iterator->source), &item)) {
+        return vm.nativeErrorPending ? false : finish(iterator);
+      }
+      return vmCallValue(&vm, iterator->fn, 1, &item, out);
+    }
+
+    case ITER_FILTER: {
+      Value item;
+      for (;;) {
+        if (!iteratorNext(AS_ITERATOR(iterator->source), &item)) {
+          return vm.nativeErrorPending ? false : finish(iterator);
+        }
+        Value keep;
+        if (!vmCallValue(&vm, iterator->fn, 1, &item, &keep)) return false;
+        if (!isFalsey(keep)) {
+          *out = item;
+          return true;
+        }
+      }
+    }
+
+    case ITER_TAKE:
+      // Stops without touching the source again, so taking from an
+      // unbounded stage terminates
+      if (iterator->position >= iterator->limit) return finish(iterator);
+      if (!iteratorNext(AS_ITERATOR(iterator->source), out)) {
+        return vm.nativeErrorPending ? false : finish(iterator);
+      }
+      iterator->position++;
+      return true;
+
+    case ITER_SKIP:
+      while (iterator->position < iterator->limit) {
+        Value skipped;
+        if (!iteratorNext(AS_ITERATOR(iterator->source), &skipped)) {
+          return vm.nativeErrorPending ? false : finish(iterator);
+        }
+        iterator->position++;
+      }
+      if (!iteratorNext(AS_ITERATOR(iterator->source), out)) {
+        return vm.nativeErrorPending ? false : finish(iterator);
+      }
+      return true;
+
+    case ITER_ZIP: {
+      Value a, b;
+      if (!iteratorNext(AS_ITERATOR(iterator->source), &a)) {
+        return vm.nativeErrorPending ? false : finish(iterator);
+      }
+      // Advancing the second side may allocate
+      push(&vm, a);
+      bool more = iteratorNext(AS_ITERATOR(iterator->other), &b);
+      pop(&vm);
+      if (!more) return vm.nativeErrorPending ? false : finish(iterator);
+      *out = makePair(a, b);
+      return true;
+    }
+
+    case ITER_CHAIN:
+      if (iterator->position == 0) {
+        if (iteratorNext(AS_ITERATOR(iterator->source), out)) return true;
+        if (vm.nativeErrorPending) return false;
+        iterator->position = 1;
+      }
+      if (!iteratorNext(AS_ITERATOR(iterator->other), out)) {
+        return vm.nativeErrorPending ? false : finish(iterator);
+      }
+      return true;
+
+    case ITER_ENUMERATE: {
+      Value item;
+      if (!iteratorNext(AS_ITERATOR(iterator->source), &item)) {
+        return vm.nativeErrorPending ? false : finish(iterator);
+      }
+      *out = makePair(NUMBER_VAL((double)iterator->position++), item);
+      return true;
+    }
+  }
+  return false;
+}
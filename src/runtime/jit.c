@@ -0,0 +1,374 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Tiering policy and bytecode analysis for the JIT (see jit.h).
+ * Code generation lives in src/compiler/jit_llvm.cpp.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/jit.h"
+#include "../include/bytecode.h"
+#include "../include/object.h"
+#include "../include/vm.h"
+
+/* --- Analysis --- */
+
+// Length of a supported instruction including operands, 0 if the JIT
+// cannot compile it.
+static int instructionLength(uint8_t op) {
+    switch (op) {
+        case OP_NOP: case OP_NIL: case OP_TRUE: case OP_FALSE:
+        case OP_POP: case OP_DUP:
+        case OP_GET_LOCAL_0: case OP_GET_LOCAL_1: case OP_GET_LOCAL_2: case OP_GET_LOCAL_3:
+        case OP_SET_LOCAL_0: case OP_SET_LOCAL_1: case OP_SET_LOCAL_2: case OP_SET_LOCAL_3:
+        case OP_EQUAL: case OP_GREATER: case OP_LESS:
+        case OP_GREATER_EQUAL: case OP_LESS_EQUAL:
+        case OP_LOOP_IF_LESS: case OP_LOOP_IF_LESS_EQUAL:
+        case OP_LOOP_IF_GREATER: case OP_LOOP_IF_GREATER_EQUAL:
+        case OP_ADD: case OP_SUBTRACT: case OP_MULTIPLY: case OP_DIVIDE: case OP_MODULO:
+        case OP_NOT: case OP_NEGATE:
+        case OP_RETURN:
+            return 1;
+        case OP_CONSTANT: case OP_GET_LOCAL: case OP_SET_LOCAL:
+            return 2;
+        case OP_JUMP: case OP_JUMP_IF_FALSE: case OP_LOOP:
+        case OP_JUMP_IF_FALSE_POP: case OP_LOOP_IF_TRUE:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+static int jumpOffset(const uint8_t* code, int ip) {
+    return (code[ip + 1] << 8) | code[ip + 2];
+}
+
+// Successors of the instruction at 'ip'; returns how many were written.
+static int successors(const uint8_t* code, int ip, int out[2]) {
+    switch (code[ip]) {
+        case OP_RETURN:        return 0;
+        case OP_JUMP:          out[0] = ip + 3 + jumpOffset(code, ip); return 1;
+        case OP_LOOP:          out[0] = ip + 3 - jumpOffset(code, ip); return 1;
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_FALSE_POP:
+            out[0] = ip + 3;
+            out[1] = ip + 3 + jumpOffset(code, ip);
+            return 2;
+        case OP_LOOP_IF_TRUE:
+            out[0] = ip + 3;
+            out[1] = ip + 3 - jumpOffset(code, ip);
+            return 2;
+        default:
+            out[0] = ip + instructionLength(code[ip]);
+            return 1;
+    }
+}
+
+// Local slot read or written by the instruction, -1 if none.
+static int localSlot(const uint8_t* code, int ip) {
+    switch (code[ip]) {
+        case OP_GET_LOCAL: case OP_SET_LOCAL: return code[ip + 1];
+        case OP_GET_LOCAL_0: case OP_SET_LOCAL_0: return 0;
+        case OP_GET_LOCAL_1: case OP_SET_LOCAL_1: return 1;
+        case OP_GET_LOCAL_2: case OP_SET_LOCAL_2: return 2;
+        case OP_GET_LOCAL_3: case OP_SET_LOCAL_3: return 3;
+        default: return -1;
+    }
+}
+
+static bool isGetLocal(uint8_t op) {
+    return op == OP_GET_LOCAL || (op >= OP_GET_LOCAL_0 && op <= OP_GET_LOCAL_3);
+}
+
+static bool isSetLocal(uint8_t op) {
+    return op == OP_SET_LOCAL || (op >= OP_SET_LOCAL_0 && op <= OP_SET_LOCAL_3);
+}
+
+// Net stack effect, given that the instruction needs 'pops' values.
+static int stackEffect(uint8_t op, int* pops) {
+    switch (op) {
+        case OP_NIL: case OP_TRUE: case OP_FALSE: case OP_CONSTANT:
+        case OP_GET_LOCAL: case OP_GET_LOCAL_0: case OP_GET_LOCAL_1:
+        case OP_GET_LOCAL_2: case OP_GET_LOCAL_3:
+            *pops = 0; return 1;
+        case OP_DUP:
+            *pops = 1; return 1;
+        case OP_POP: case OP_RETURN:
+        case OP_JUMP_IF_FALSE_POP: case OP_LOOP_IF_TRUE:
+            *pops = 1; return -1;
+        case OP_EQUAL: case OP_GREATER: case OP_LESS:
+        case OP_GREATER_EQUAL: case OP_LESS_EQUAL:
+        case OP_LOOP_IF_LESS: case OP_LOOP_IF_LESS_EQUAL:
+        case OP_LOOP_IF_GREATER: case OP_LOOP_IF_GREATER_EQUAL:
+        case OP_ADD: case OP_SUBTRACT: case OP_MULTIPLY: case OP_DIVIDE: case OP_MODULO:
+            *pops = 2; return -1;
+        case OP_SET_LOCAL: case OP_SET_LOCAL_0: case OP_SET_LOCAL_1:
+        case OP_SET_LOCAL_2: case OP_SET_LOCAL_3:
+        case OP_NOT: case OP_NEGATE: case OP_JUMP_IF_FALSE:
+            *pops = 1; return 0;
+        default:
+            *pops = 0; return 0;
+    }
+}
+
+static uint8_t constantType(Value value) {
+    if (IS_NUMBER(value)) return JIT_TYPE_NUMBER;
+    if (IS_BOOL(value)) return JIT_TYPE_BOOL;
+    if (IS_NIL(value)) return JIT_TYPE_NIL;
+    return JIT_TYPE_ANY;
+}
+
+// Applies the instruction at 'ip' to the slot types in 'state'.
+static void transfer(const ObjFunction* function, int ip, uint8_t* state, int depth) {
+    const uint8_t* code = function->chunk.code;
+    uint8_t op = code[ip];
+    switch (op) {
+        case OP_NIL:      state[depth] = JIT_TYPE_NIL; break;
+        case OP_TRUE:
+        case OP_FALSE:    state[depth] = JIT_TYPE_BOOL; break;
+        case OP_CONSTANT:
+            state[depth] = constantType(function->chunk.constants.values[code[ip + 1]]);
+            break;
+        case OP_DUP:      state[depth] = state[depth - 1]; break;
+        case OP_EQUAL: case OP_GREATER: case OP_LESS:
+        case OP_GREATER_EQUAL: case OP_LESS_EQUAL:
+        case OP_LOOP_IF_LESS: case OP_LOOP_IF_LESS_EQUAL:
+        case OP_LOOP_IF_GREATER: case OP_LOOP_IF_GREATER_EQUAL:
+            state[depth - 2] = JIT_TYPE_BOOL;
+            break;
+        case OP_ADD: case OP_SUBTRACT: case OP_MULTIPLY: case OP_DIVIDE: case OP_MODULO:
+            state[depth - 2] = JIT_TYPE_NUMBER;
+            break;
+        case OP_NOT:      state[depth - 1] = JIT_TYPE_BOOL; break;
+        case OP_NEGATE:   state[depth - 1] = JIT_TYPE_NUMBER; break;
+        default:
+            if (isGetLocal(op)) state[depth] = state[localSlot(code, ip)];
+            else if (isSetLocal(op)) state[localSlot(code, ip)] = state[depth - 1];
+            break;
+    }
+}
+
+void jitFreePlan(JitPlan* plan) {
+    free(plan->depth);
+    free(plan->types);
+    free(plan->flags);
+    plan->depth = NULL;
+    plan->types = NULL;
+    plan->flags = NULL;
+}
+
+bool jitAnalyze(ObjFunction* function, JitPlan* plan) {
+    const uint8_t* code = function->chunk.code;
+    int length = function->chunk.count;
+
+    memset(plan, 0, sizeof(JitPlan));
+    plan->function = function;
+    plan->codeLength = length;
+    if (length == 0 || length > INT16_MAX) return false;
+
+    plan->depth = (int16_t*)malloc(sizeof(int16_t) * (size_t)length);
+    plan->flags = (uint8_t*)calloc((size_t)length, 1);
+    int* worklist = (int*)malloc(sizeof(int) * (size_t)length);
+    bool* queued = (bool*)calloc((size_t)length, sizeof(bool));
+    uint8_t* state = NULL;
+    bool ok = false;
+
+    for (int i = 0; i < length; i++) plan->depth[i] = -1;
+
+    // Pass 1: stack depths, instruction boundaries and block leaders.
+    int count = 0;
+    int maxDepth = function->arity + 1;
+    plan->depth[0] = (int16_t)maxDepth;
+    plan->flags[0] |= JIT_FLAG_LEADER;
+    worklist[count++] = 0;
+    while (count > 0) {
+        int ip = worklist[--count];
+        int depth = plan->depth[ip];
+        int size = instructionLength(code[ip]);
+        if (size == 0 || ip + size > length) goto done;
+
+        uint8_t op = code[ip];
+        int pops;
+        int next = depth + stackEffect(op, &pops);
+        if (depth < pops || localSlot(code, ip) >= depth) goto done;
+        if (next > maxDepth) maxDepth = next;
+        if (maxDepth > INT16_MAX) goto done;
+
+        bool branch = op == OP_JUMP || op == OP_JUMP_IF_FALSE || op == OP_LOOP ||
+                      op == OP_JUMP_IF_FALSE_POP || op == OP_LOOP_IF_TRUE;
+        bool backward = op == OP_LOOP || op == OP_LOOP_IF_TRUE;
+        int succ[2];
+        int n = successors(code, ip, succ);
+        for (int s = 0; s < n; s++) {
+            int target = succ[s];
+            if (target < 0 || target >= length) goto done;
+            if (branch) plan->flags[target] |= JIT_FLAG_LEADER;
+            if (backward && target < ip) plan->flags[target] |= JIT_FLAG_OSR;
+            if (plan->depth[target] < 0) {
+                plan->depth[target] = (int16_t)next;
+                worklist[count++] = target;
+            } else if (plan->depth[target] != next) {
+                goto done;
+            }
+        }
+    }
+
+    // Jumps must land on instruction boundaries.
+    for (int ip = 0; ip < length; ip++) {
+        if (plan->depth[ip] < 0) continue;
+        for (int k = 1; k < instructionLength(code[ip]); k++) {
+            if (plan->depth[ip + k] >= 0) goto done;
+        }
+    }
+
+    // Pass 2: value types, iterated to a fixed point. Parameters start out
+    // as numbers when every recorded call passed a number.
+    if ((size_t)length * (size_t)maxDepth > ((size_t)1 << 22)) goto done;
+    plan->maxDepth = maxDepth;
+    plan->types = (uint8_t*)calloc((size_t)length * (size_t)maxDepth, 1);
+    state = (uint8_t*)malloc((size_t)maxDepth);
+    memset(queued, 0, sizeof(bool) * (size_t)length);
+    bool* seen = (bool*)calloc((size_t)length, sizeof(bool));
+
+    uint8_t* entry = plan->types;
+    entry[0] = JIT_TYPE_ANY;
+    for (int i = 1; i <= function->arity; i++) {
+        bool numeric = (function->paramFeedback & JIT_FEEDBACK_SEEN) &&
+                       i - 1 < JIT_FEEDBACK_PARAMS &&
+                       !(function->paramFeedback & ((uint32_t)1 << (i - 1)));
+        entry[i] = numeric ? JIT_TYPE_NUMBER : JIT_TYPE_ANY;
+    }
+    seen[0] = true;
+    queued[0] = true;
+    count = 0;
+    worklist[count++] = 0;
+    while (count > 0) {
+        int ip = worklist[--count];
+        queued[ip] = false;
+        int depth = plan->depth[ip];
+        memcpy(state, plan->types + (size_t)ip * maxDepth, (size_t)depth);
+        transfer(function, ip, state, depth);
+
+        int pops;
+        int next = depth + stackEffect(code[ip], &pops);
+        int succ[2];
+        int n = successors(code, ip, succ);
+        for (int s = 0; s < n; s++) {
+            int target = succ[s];
+            uint8_t* types = plan->types + (size_t)target * maxDepth;
+            bool changed = false;
+            if (!seen[target]) {
+                memcpy(types, state, (size_t)next);
+                seen[target] = true;
+                changed = true;
+            } else {
+                for (int p = 0; p < next; p++) {
+                    if (types[p] != state[p] && types[p] != JIT_TYPE_ANY) {
+                        types[p] = JIT_TYPE_ANY;
+                        changed = true;
+                    }
+                }
+            }
+            if (changed && !queued[target]) {
+                queued[target] = true;
+                worklist[count++] = target;
+            }
+        }
+    }
+    free(seen);
+    ok = true;
+
+done:
+    free(worklist);
+    free(queued);
+    free(state);
+    if (!ok) jitFreePlan(plan);
+    return ok;
+}
+
+int jitValuesEqual(Value a, Value b) {
+    if (IS_INSTANCE(a)) return -1;
+    if (IS_NUMBER(a) && IS_NUMBER(b)) return AS_NUMBER(a) == AS_NUMBER(b);
+    if (IS_STRING(a) && IS_STRING(b)) {
+        ObjString* s1 = AS_STRING(a);
+        ObjString* s2 = AS_STRING(b);
+        return s1 == s2 || (s1->length == s2->length && memcmp(s1->chars, s2->chars, s1->length) == 0);
+    }
+    return a == b;
+}
+
+/* --- Tiering --- */
+
+static bool jitEnabled(void) {
+    const char* off = getenv("PROXPL_NO_JIT");
+    return off == NULL || off[0] == '\0' || strcmp(off, "0") == 0;
+}
+
+void jitCompile(ObjFunction* function) {
+    if (function->jitRecompiles >= JIT_MAX_RECOMPILES || !jitEnabled()) {
+        function->jitState = JIT_FAILED;
+        return;
+    }
+    function->jitRecompiles++;
+
+    JitCode* code = NULL;
+    JitPlan plan;
+    if (jitAnalyze(function, &plan)) {
+        code = jitEmitNative(&plan);
+        jitFreePlan(&plan);
+    }
+    if (code == NULL) {
+        function->jitState = JIT_FAILED;
+        return;
+    }
+    function->jitCode = code;
+    function->jitDeopts = 0;
+    function->jitState = JIT_COMPILED;
+}
+
+bool jitEnter(VM* pvm, CallFrame* frame, int entryIp, JitExit* exit) {
+    ObjFunction* function = frame->closure->function;
+    JitCode* code = function->jitCode;
+
+    // Leave it to the interpreter to report a stack overflow.
+    if (frame->slots + code->maxDepth > pvm->stack + STACK_MAX) {
+        exit->ip = entryIp;
+        exit->depth = -1;
+        return false;
+    }
+
+    if (code->entry(frame->slots, entryIp, exit)) return true;
+
+    // Speculation that keeps failing is thrown away; the function goes back
+    // to collecting feedback and may be compiled again with wider types.
+    if (++function->jitDeopts >= JIT_MAX_DEOPTS) {
+        jitRelease(function);
+        function->hotness = 0;
+        function->jitState = JIT_COLD;
+    }
+    return false;
+}
+
+void jitRelease(ObjFunction* function) {
+    if (function->jitCode != NULL) {
+        jitReleaseNative(function->jitCode);
+        function->jitCode = NULL;
+    }
+}
+
+#ifndef USE_LLVM_BACKEND
+JitCode* jitEmitNative(const JitPlan* plan) {
+    (void)plan;
+    return NULL;
+}
+
+void jitReleaseNative(JitCode* code) {
+    (void)code;
+}
+#endif
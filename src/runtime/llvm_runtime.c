@@ -11,6 +11,7 @@
 #include "../include/vm.h" // For globals/strings table access if needed
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // Helper to wrap allocating a string from a constant C-string
 Value prox_rt_const_string(const char* chars, int length) {
@@ -41,6 +42,193 @@ Value prox_rt_add(Value a, Value b) {
     return NIL_VAL;
 }
 
+// Fallbacks for operands the type inference pass could not prove numeric.
+// Compiled code only calls these on boxed values; proven numbers use native
+// floating-point instructions instead.
+
+static bool prox_rt_check_numbers(Value a, Value b, const char* op) {
+    if (IS_NUMBER(a) && IS_NUMBER(b)) return true;
+    printf("Runtime Error: Operands of %s must be numbers\n", op);
+    return false;
+}
+
+Value prox_rt_sub(Value a, Value b) {
+    if (!prox_rt_check_numbers(a, b, "-")) return NIL_VAL;
+    return NUMBER_VAL(AS_NUMBER(a) - AS_NUMBER(b));
+}
+
+Value prox_rt_mul(Value a, Value b) {
+    if (!prox_rt_check_numbers(a, b, "*")) return NIL_VAL;
+    return NUMBER_VAL(AS_NUMBER(a) * AS_NUMBER(b));
+}
+
+Value prox_rt_div(Value a, Value b) {
+    if (!prox_rt_check_numbers(a, b, "/")) return NIL_VAL;
+    return NUMBER_VAL(AS_NUMBER(a) / AS_NUMBER(b));
+}
+
+Value prox_rt_neg(Value a) {
+    if (!IS_NUMBER(a)) {
+        printf("Runtime Error: Operand of - must be a number\n");
+        return NIL_VAL;
+    }
+    return NUMBER_VAL(-AS_NUMBER(a));
+}
+
+Value prox_rt_less(Value a, Value b) {
+    if (!prox_rt_check_numbers(a, b, "<")) return BOOL_VAL(false);
+    return BOOL_VAL(AS_NUMBER(a) < AS_NUMBER(b));
+}
+
+Value prox_rt_greater(Value a, Value b) {
+    if (!prox_rt_check_numbers(a, b, ">")) return BOOL_VAL(false);
+    return BOOL_VAL(AS_NUMBER(a) > AS_NUMBER(b));
+}
+
+Value prox_rt_equal(Value a, Value b) {
+    if (IS_NUMBER(a) && IS_NUMBER(b)) return BOOL_VAL(AS_NUMBER(a) == AS_NUMBER(b));
+    if (IS_STRING(a) && IS_STRING(b)) {
+        ObjString* sA = AS_STRING(a);
+        ObjString* sB = AS_STRING(b);
+        return BOOL_VAL(sA == sB || (sA->length == sB->length && memcmp(sA->chars, sB->chars, sA->length) == 0));
+    }
+    return BOOL_VAL(a == b);
+}
+
+// Indexing for compiled code, matching OP_GET_INDEX/OP_SET_INDEX. The
+// unchecked forms are only emitted where the loop optimizer proved the
+// index is within the list; other targets still take the checked path.
+
+static bool prox_rt_list_index(Value target, Value index, int* out) {
+    if (!IS_NUMBER(index)) {
+        printf("Runtime Error: List index must be a number\n");
+        return false;
+    }
+    int i = (int)AS_NUMBER(index);
+    if (i < 0 || i >= AS_LIST(target)->count) {
+        printf("Runtime Error: List index out of bounds\n");
+        return false;
+    }
+    *out = i;
+    return true;
+}
+
+static bool prox_rt_typed_index(Value target, Value index, int* out) {
+    if (!IS_NUMBER(index)) {
+        printf("Runtime Error: Typed array index must be a number\n");
+        return false;
+    }
+    int i = (int)AS_NUMBER(index);
+    if (i < 0 || i >= AS_TYPED_ARRAY(target)->count) {
+        printf("Runtime Error: Typed array index out of bounds\n");
+        return false;
+    }
+    *out = i;
+    return true;
+}
+
+Value prox_rt_get_index(Value target, Value index) {
+    if (IS_LIST(target)) {
+        int i;
+        return prox_rt_list_index(target, index, &i) ? AS_LIST(target)->items[i] : NIL_VAL;
+    }
+    if (IS_TYPED_ARRAY(target)) {
+        int i;
+        return prox_rt_typed_index(target, index, &i)
+            ? NUMBER_VAL(typedArrayGet(AS_TYPED_ARRAY(target), i)) : NIL_VAL;
+    }
+    if (IS_DICTIONARY(target) && IS_STRING(index)) {
+        Value value;
+        return tableGet(&AS_DICTIONARY(target)->items, AS_STRING(index), &value) ? value : NIL_VAL;
+    }
+    printf("Runtime Error: Can only index lists, typed arrays and dictionaries\n");
+    return NIL_VAL;
+}
+
+Value prox_rt_get_index_unchecked(Value target, Value index) {
+    if (IS_LIST(target)) return AS_LIST(target)->items[(int)AS_NUMBER(index)];
+    return prox_rt_get_index(target, index);
+}
+
+Value prox_rt_set_index(Value target, Value index, Value value) {
+    if (IS_LIST(target)) {
+        int i;
+        if (prox_rt_list_index(target, index, &i)) AS_LIST(target)->items[i] = value;
+    } else if (IS_TYPED_ARRAY(target)) {
+        int i;
+        if (!IS_NUMBER(value)) {
+            printf("Runtime Error: Typed array elements must be numbers\n");
+        } else if (prox_rt_typed_index(target, index, &i)) {
+            typedArraySet(AS_TYPED_ARRAY(target), i, AS_NUMBER(value));
+        }
+    } else if (IS_DICTIONARY(target) && IS_STRING(index)) {
+        tableSet(&AS_DICTIONARY(target)->items, AS_STRING(index), value);
+    } else {
+        printf("Runtime Error: Can only index lists, typed arrays and dictionaries\n");
+    }
+    return value;
+}
+
+Value prox_rt_set_index_unchecked(Value target, Value index, Value value) {
+    if (!IS_LIST(target)) return prox_rt_set_index(target, index, value);
+    AS_LIST(target)->items[(int)AS_NUMBER(index)] = value;
+    return value;
+}
+
+// List literals. The optimizer gives a list that never leaves its function
+// a header in the caller's frame ('storage', sizeof(ObjList) bytes) over
+// an items array that also lives there; such a list is not on the object
+// list and is never collected or freed.
+
+Value prox_rt_new_list(const Value* items, int count) {
+    ObjList* list = newList();
+    if (count > 0) {
+        push(&vm, OBJ_VAL(list));
+        list->items = ALLOCATE(Value, count);
+        memcpy(list->items, items, sizeof(Value) * (size_t)count);
+        list->count = list->capacity = count;
+        pop(&vm);
+    }
+    return OBJ_VAL(list);
+}
+
+Value prox_rt_stack_list(void* storage, Value* items, int count) {
+    ObjList* list = (ObjList*)storage;
+    list->obj.type = OBJ_LIST;
+    list->obj.isMarked = false;
+    list->obj.next = NULL;
+    list->count = list->capacity = count;
+    list->items = items;
+    return OBJ_VAL(list);
+}
+
+Value prox_rt_length(Value v) {
+    if (IS_STRING(v)) return NUMBER_VAL((double)AS_STRING(v)->length);
+    if (IS_LIST(v)) return NUMBER_VAL((double)AS_LIST(v)->count);
+    if (IS_TYPED_ARRAY(v)) return NUMBER_VAL((double)AS_TYPED_ARRAY(v)->count);
+    if (IS_DICTIONARY(v)) return NUMBER_VAL((double)AS_DICTIONARY(v)->items.count);
+    return NUMBER_VAL(0);
+}
+
+Value prox_rt_get_member(Value object, const char* name, int length) {
+    Value value;
+    if (IS_INSTANCE(object) &&
+        tableGet(&AS_INSTANCE(object)->fields, copyString(name, length), &value)) {
+        return value;
+    }
+    printf("Runtime Error: Undefined property '%.*s'\n", length, name);
+    return NIL_VAL;
+}
+
+Value prox_rt_set_member(Value object, const char* name, int length, Value value) {
+    if (!IS_INSTANCE(object)) {
+        printf("Runtime Error: Only instances have fields\n");
+        return value;
+    }
+    tableSet(&AS_INSTANCE(object)->fields, copyString(name, length), value);
+    return value;
+}
+
 void prox_rt_print(Value v) {
     printValue(v);
     printf("\n");
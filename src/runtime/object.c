@@ -7,12 +7,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 #include "../include/memory.h"
 #include "../include/object.h"
 #include "../include/value.h"
 #include "../include/vm.h"
 #include "../include/bytecode.h" 
+#include "../include/jit.h"
 
 // This is the critical fix for the "vm undeclared" error:
 extern VM vm; 
@@ -33,11 +35,20 @@ ObjFunction *newFunction() {
   ObjFunction *function = ALLOCATE_OBJ(ObjFunction, OBJ_FUNCTION);
   function->arity = 0;
   function->upvalueCount = 0;
+  function->captureCount = 0;
   function->name = NULL;
   function->access = ACCESS_PUBLIC;
   function->isStatic = false;
   function->isAbstract = false;
   function->cache = NULL;
+  function->retainedParams = UINT32_MAX;
+  function->sharedClosure = NULL;
+  function->hotness = 0;
+  function->paramFeedback = 0;
+  function->jitState = JIT_COLD;
+  function->jitDeopts = 0;
+  function->jitRecompiles = 0;
+  function->jitCode = NULL;
   initChunk(&function->chunk); // Requires chunk.h
   return function;
 }
@@ -53,6 +64,7 @@ ObjForeign *newForeign(ObjString* name, void* library, void* function) {
   foreign->name = name;
   foreign->library = library;
   foreign->function = function;
+  foreign->finalize = NULL;
   return foreign;
 }
 
@@ -103,6 +115,31 @@ ObjString *takeString(char *chars, int length) {
   return string;
 }
 
+// Allocates an unfinished string of 'length' bytes for the caller to fill in
+// place (e.g. straight from a file), avoiding a temporary copy. It must be
+// passed to internRawString() before it is used as a value.
+ObjString *allocateRawString(int length) {
+  ObjString *string = (ObjString *)allocateObject(sizeof(ObjString) + length + 1, OBJ_STRING);
+  string->length = length;
+  string->hash = 0;
+  string->chars[length] = '\0';
+  return string;
+}
+
+// Hashes and interns a string from allocateRawString(). If an equal string
+// is already interned that one is returned and 'string' is left for the GC.
+ObjString *internRawString(ObjString *string) {
+  string->chars[string->length] = '\0';
+  string->hash = hashString(string->chars, string->length);
+  ObjString *interned = tableFindString(&vm.strings, string->chars, string->length, string->hash);
+  if (interned != NULL) return interned;
+
+  push(&vm, OBJ_VAL(string));
+  tableSet(&vm.strings, string, NIL_VAL);
+  pop(&vm);
+  return string;
+}
+
 ObjString *copyString(const char *chars, int length) {
   uint32_t hash = hashString(chars, length);
   
@@ -154,6 +191,16 @@ void printObject(Value value) {
   case OBJ_FOREIGN:
     printf("<foreign fn %s>", ((ObjForeign*)AS_OBJ(value))->name->chars);
     break;
+  case OBJ_BUFFER:
+    printf("<buffer %d bytes>", bufferLength(AS_BUFFER(value)));
+    break;
+  case OBJ_ITERATOR:
+    printf("<iterator>");
+    break;
+  case OBJ_TYPED_ARRAY:
+    printf("<%s %d>", AS_TYPED_ARRAY(value)->kind == TYPED_FLOAT64 ? "Float64Array" : "Int32Array",
+           AS_TYPED_ARRAY(value)->count);
+    break;
   case OBJ_LIST:
     printf("[list]");
     break;
@@ -206,11 +253,19 @@ ObjClosure *newClosure(ObjFunction *function) {
   for (int i = 0; i < function->upvalueCount; i++) {
     upvalues[i] = NULL;
   }
+  Value *captures = ALLOCATE(Value, function->captureCount);
+  for (int i = 0; i < function->captureCount; i++) {
+    captures[i] = NIL_VAL;
+  }
 
   ObjClosure *closure = ALLOCATE_OBJ(ObjClosure, OBJ_CLOSURE);
   closure->function = function;
   closure->upvalues = upvalues;
   closure->upvalueCount = function->upvalueCount;
+  closure->captures = captures;
+  closure->captureCount = function->captureCount;
+  closure->onStack = false;
+  closure->promoted = NULL;
   return closure;
 }
 
@@ -218,7 +273,6 @@ ObjUpvalue *newUpvalue(Value *slot) {
   ObjUpvalue *upvalue = ALLOCATE_OBJ(ObjUpvalue, OBJ_UPVALUE);
   upvalue->closed = NIL_VAL;
   upvalue->location = slot;
-  upvalue->next = NULL;
   return upvalue;
 }
 
@@ -266,27 +320,117 @@ struct ObjDictionary *newDictionary() {
   return dict;
 }
 
+ObjBuffer *newBuffer(int capacity) {
+  // Storage first: it is not yet reachable if allocating the header collects
+  uint8_t *data = capacity > 0 ? ALLOCATE(uint8_t, capacity) : NULL;
+  if (data) memset(data, 0, capacity);
+  ObjBuffer *buffer = ALLOCATE_OBJ(ObjBuffer, OBJ_BUFFER);
+  buffer->owner = NULL;
+  buffer->data = data;
+  buffer->offset = 0;
+  buffer->size = 0;
+  buffer->capacity = capacity > 0 ? capacity : 0;
+  buffer->readOnly = false;
+  buffer->release = NULL;
+  buffer->mapping = NULL;
+  return buffer;
+}
+
+// 'buffer' must be reachable while this allocates. The caller has checked
+// that offset + size lies within bufferLength(buffer).
+ObjBuffer *newBufferSlice(ObjBuffer *buffer, int offset, int size) {
+  ObjBuffer *slice = ALLOCATE_OBJ(ObjBuffer, OBJ_BUFFER);
+  slice->owner = buffer->owner ? buffer->owner : buffer;
+  slice->data = NULL;
+  slice->offset = buffer->offset + offset;
+  slice->size = size;
+  slice->capacity = size;
+  slice->readOnly = buffer->readOnly;
+  slice->release = NULL;
+  slice->mapping = NULL;
+  return slice;
+}
+
+// Grows owned storage to at least 'capacity' bytes. Slices cannot grow past
+// their window and read-only views cannot grow at all.
+bool bufferReserve(ObjBuffer *buffer, int capacity) {
+  if (buffer->readOnly) return false;
+  if (buffer->owner) return capacity <= bufferLength(buffer);
+  if (capacity <= buffer->capacity) return true;
+  int grown = buffer->capacity < 64 ? 64 : buffer->capacity;
+  while (grown < capacity) grown = grown > INT_MAX / 2 ? capacity : grown * 2;
+  buffer->data = GROW_ARRAY(uint8_t, buffer->data, buffer->capacity, grown);
+  memset(buffer->data + buffer->capacity, 0, grown - buffer->capacity);
+  buffer->capacity = grown;
+  return true;
+}
+
+// 'source' must be reachable while this allocates
+ObjIterator *newIterator(IteratorKind kind, Value source) {
+  ObjIterator *iterator = ALLOCATE_OBJ(ObjIterator, OBJ_ITERATOR);
+  iterator->kind = kind;
+  iterator->done = false;
+  iterator->source = source;
+  iterator->other = NIL_VAL;
+  iterator->fn = NIL_VAL;
+  iterator->start = 0;
+  iterator->stop = 0;
+  iterator->step = 1;
+  iterator->position = 0;
+  iterator->limit = 0;
+  return iterator;
+}
+
+// Zero-filled. The caller has checked that 'count' elements fit in an int
+// of bytes.
+ObjTypedArray *newTypedArray(TypedArrayKind kind, int count) {
+  // Storage first, as in newBuffer()
+  size_t width = kind == TYPED_FLOAT64 ? sizeof(double) : sizeof(int32_t);
+  void *data = count > 0 ? reallocate(NULL, 0, width * count) : NULL;
+  if (data) memset(data, 0, width * count);
+  ObjTypedArray *array = ALLOCATE_OBJ(ObjTypedArray, OBJ_TYPED_ARRAY);
+  array->kind = kind;
+  array->count = count > 0 ? count : 0;
+  if (kind == TYPED_FLOAT64) {
+    array->as.f64 = (double *)data;
+  } else {
+    array->as.i32 = (int32_t *)data;
+  }
+  return array;
+}
+
 ObjTensor *newTensor(int dimCount, int *dims, double *data) {
     ObjTensor *tensor = ALLOCATE_OBJ(ObjTensor, OBJ_TENSOR);
-    tensor->dimCount = dimCount;
+    // Empty until both arrays exist, and protected while they are
+    // allocated, so a collection in between neither frees it nor its
+    // half-set fields
+    tensor->dimCount = 0;
+    tensor->dims = NULL;
+    tensor->size = 0;
+    tensor->data = NULL;
+    push(&vm, OBJ_VAL(tensor));
     
     // Copy dimensions
-    tensor->dims = ALLOCATE(int, dimCount);
-    memcpy(tensor->dims, dims, sizeof(int) * dimCount);
+    int* tensorDims = ALLOCATE(int, dimCount);
+    memcpy(tensorDims, dims, sizeof(int) * dimCount);
+    tensor->dims = tensorDims;
+    tensor->dimCount = dimCount;
     
     // Calculate size
     int size = 1;
     for(int i=0; i<dimCount; i++) size *= dims[i];
-    tensor->size = size;
     
     // Copy data if provided, else zero init
-    tensor->data = ALLOCATE(double, size);
+    double* tensorData = ALLOCATE(double, size);
     if(data) {
-        memcpy(tensor->data, data, sizeof(double) * size);
+        memcpy(tensorData, data, sizeof(double) * size);
     } else {
-        memset(tensor->data, 0, sizeof(double) * size);
+        memset(tensorData, 0, sizeof(double) * size);
     }
+    tensor->data = tensorData;
+    tensor->size = size;
     
+    pop(&vm);
     return tensor;
 }
 
@@ -6,26 +6,33 @@
 
 #include "../../include/object.h"
 #include "../../include/value.h"
+#include "../../include/scheduler.h"
+#include "../../include/threading.h"
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #ifdef _MSC_VER
 #include <intrin.h>
-#define atomic_size_t size_t
-#define atomic_int int
-#define _Atomic(X) X
+#define atomic_size_t volatile size_t
+#define atomic_int volatile int
+#define _Atomic(X) X volatile
 #define atomic_init(A, V) (*(A) = (V))
 #define atomic_load(A) (*(A))
 #define atomic_load_explicit(A, M) (*(A))
 #define atomic_store_explicit(A, V, M) (*(A) = (V))
-#define atomic_thread_fence(M)
+#define atomic_thread_fence(M) MemoryBarrier()
+#define atomic_fetch_add(A, V) ((size_t)_InterlockedExchangeAdd64((volatile __int64*)(A), (__int64)(V)))
+#define atomic_fetch_sub(A, V) ((size_t)_InterlockedExchangeAdd64((volatile __int64*)(A), -(__int64)(V)))
 #define memory_order_relaxed 0
 #define memory_order_acquire 0
 #define memory_order_release 0
 #define memory_order_seq_cst 0
-// Mock compare_exchange for single thread (common in dev/CLI)
 static inline bool atomic_compare_exchange_strong_explicit(size_t volatile* a, size_t* e, size_t d, int m1, int m2) {
-    if (*a == *e) { *a = d; return true; }
-    *e = *a; return false;
+    size_t seen = (size_t)_InterlockedCompareExchange64((volatile __int64*)a, (__int64)d, (__int64)*e);
+    if (seen == *e) return true;
+    *e = seen;
+    return false;
 }
 #else
 #include <stdatomic.h>
@@ -38,10 +45,11 @@ static inline bool atomic_compare_exchange_strong_explicit(size_t volatile* a, s
 #define DEQUE_CAPACITY 1024
 #define MAX_WORKERS 8
 
+// Holds tasks for the coroutine scheduler and chunk ranges for parallel loops
 typedef struct {
     atomic_size_t top;
     atomic_size_t bottom;
-    _Atomic(ObjTask*) buffer[DEQUE_CAPACITY];
+    _Atomic(void*) buffer[DEQUE_CAPACITY];
 } WorkerDeque;
 
 // Global set of deques, one per worker (thread)
@@ -67,7 +75,7 @@ void scheduler_init(int worker_id) {
     atomic_init(&workers[worker_id].bottom, 0);
 }
 
-static void deque_push_bottom(WorkerDeque* deque, ObjTask* task) {
+static void deque_push_bottom(WorkerDeque* deque, void* task) {
     size_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
     size_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
     
@@ -80,23 +88,24 @@ static void deque_push_bottom(WorkerDeque* deque, ObjTask* task) {
     
     atomic_store_explicit(&deque->buffer[b % DEQUE_CAPACITY], task, memory_order_relaxed);
     atomic_thread_fence(memory_order_release);
-    atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_release);
 }
 
-static ObjTask* deque_take_bottom(WorkerDeque* deque) {
+static void* deque_take_bottom(WorkerDeque* deque) {
     size_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
     atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
     atomic_thread_fence(memory_order_seq_cst);
     
     size_t t = atomic_load_explicit(&deque->top, memory_order_relaxed);
     
-    if (t > b) {
+    // Signed, since b wraps below zero when the deque was empty at 0
+    if ((ptrdiff_t)(b - t) < 0) {
         // Empty
         atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
         return NULL;
     }
     
-    ObjTask* task = atomic_load_explicit(&deque->buffer[b % DEQUE_CAPACITY], memory_order_relaxed);
+    void* task = atomic_load_explicit(&deque->buffer[b % DEQUE_CAPACITY], memory_order_relaxed);
     
     if (t == b) {
         // Single item, race against steal
@@ -112,14 +121,14 @@ static ObjTask* deque_take_bottom(WorkerDeque* deque) {
     return task;
 }
 
-static ObjTask* deque_steal(WorkerDeque* deque) {
+static void* deque_steal(WorkerDeque* deque) {
     size_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
     atomic_thread_fence(memory_order_seq_cst);
     size_t b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
     
-    if (t >= b) return NULL;
+    if ((ptrdiff_t)(b - t) <= 0) return NULL;
     
-    ObjTask* task = atomic_load_explicit(&deque->buffer[t % DEQUE_CAPACITY], memory_order_relaxed);
+    void* task = atomic_load_explicit(&deque->buffer[t % DEQUE_CAPACITY], memory_order_relaxed);
     
     if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
                                                  memory_order_seq_cst, memory_order_relaxed)) {
@@ -354,3 +363,189 @@ Value actor_receive(ObjActor* actor) {
     return payload;
 }
 
+
+// ----------------------------------------------------------------------------
+// PARALLEL LOOPS (Data Parallelism)
+// ----------------------------------------------------------------------------
+
+#define MAX_PARALLEL_WORKERS 64
+#define PARALLEL_TARGET_CHUNKS 256
+#define PARALLEL_MAX_CHUNKS 65536
+#define MAX_PARALLEL_SAFE 64
+
+// A run of chunks [first, last) waiting in a deque
+typedef struct {
+    size_t first;
+    size_t last;
+} ParallelRange;
+
+typedef struct {
+    ParallelBody body;
+    void* context;
+    size_t count;
+    size_t grain;
+    ParallelRange* ranges;   // One per chunk, handed out as ranges split
+    atomic_size_t nextRange;
+    atomic_size_t chunksLeft;
+} ParallelJob;
+
+static WorkerDeque rangeDeques[MAX_PARALLEL_WORKERS];
+static PxThread poolThreads[MAX_PARALLEL_WORKERS];
+static int poolHelpers = -1; // Helper threads; -1 until the pool starts
+static PxMutex poolLock = PX_MUTEX_INITIALIZER;
+static PxCond poolWake;
+static PxCond poolIdle;
+static ParallelJob* poolJob = NULL;
+static unsigned long poolGeneration = 0;
+static int poolBusy = 0;
+static atomic_int jobRunning;
+
+static NativeFn parallelSafe[MAX_PARALLEL_SAFE];
+static int parallelSafeCount = 0;
+
+int scheduler_parallelism(void) {
+    const char* env = getenv("PROXPL_THREADS");
+    int threads = env ? atoi(env) : pxCpuCount();
+    if (threads < 1) threads = 1;
+    if (threads > MAX_PARALLEL_WORKERS) threads = MAX_PARALLEL_WORKERS;
+    return threads;
+}
+
+size_t scheduler_grain(size_t count, size_t minGrain) {
+    size_t grain = (count + PARALLEL_TARGET_CHUNKS - 1) / PARALLEL_TARGET_CHUNKS;
+    if (grain < minGrain) grain = minGrain;
+    return grain > 0 ? grain : 1;
+}
+
+void scheduler_mark_parallel_safe(NativeFn function) {
+    if (scheduler_parallel_safe(function) || parallelSafeCount == MAX_PARALLEL_SAFE) return;
+    parallelSafe[parallelSafeCount++] = function;
+}
+
+bool scheduler_parallel_safe(NativeFn function) {
+    for (int i = 0; i < parallelSafeCount; i++) {
+        if (parallelSafe[i] == function) return true;
+    }
+    return false;
+}
+
+static void run_chunk(ParallelJob* job, size_t chunk) {
+    size_t begin = chunk * job->grain;
+    size_t end = begin + job->grain < job->count ? begin + job->grain : job->count;
+    job->body(begin, end, job->context);
+}
+
+// Works on the job until every chunk has run: split the local range in
+// halves (keeping the left one and publishing the right), run single
+// chunks, and steal from other workers when the local deque is empty
+static void run_job(ParallelJob* job, int slot, int workerCount) {
+    WorkerDeque* own = &rangeDeques[slot];
+    while (atomic_load(&job->chunksLeft) > 0) {
+        ParallelRange* range = (ParallelRange*)deque_take_bottom(own);
+        for (int i = 1; range == NULL && i < workerCount; i++) {
+            range = (ParallelRange*)deque_steal(&rangeDeques[(slot + i) % workerCount]);
+        }
+        if (range == NULL) {
+            pxThreadYield();
+            continue;
+        }
+
+        size_t first = range->first;
+        size_t last = range->last;
+        while (last - first > 1) {
+            size_t mid = first + (last - first) / 2;
+            ParallelRange* right = &job->ranges[atomic_fetch_add(&job->nextRange, 1)];
+            right->first = mid;
+            right->last = last;
+            deque_push_bottom(own, right);
+            last = mid;
+        }
+        run_chunk(job, first);
+        atomic_fetch_sub(&job->chunksLeft, 1);
+    }
+}
+
+static PX_THREAD_FN(parallel_worker) {
+    int slot = (int)(intptr_t)arg;
+    unsigned long seen = 0;
+    pxMutexLock(&poolLock);
+    for (;;) {
+        while (poolGeneration == seen) pxCondWait(&poolWake, &poolLock);
+        seen = poolGeneration;
+        ParallelJob* job = poolJob;
+        if (job == NULL) continue; // Finished before this thread woke up
+
+        poolBusy++;
+        pxMutexUnlock(&poolLock);
+        run_job(job, slot, poolHelpers + 1);
+        pxMutexLock(&poolLock);
+        if (--poolBusy == 0) pxCondBroadcast(&poolIdle);
+    }
+    return PX_THREAD_RETURN;
+}
+
+// Starts the helpers once; returns the number running
+static int start_pool(void) {
+    if (poolHelpers >= 0) return poolHelpers;
+    pxCondInit(&poolWake);
+    pxCondInit(&poolIdle);
+    int wanted = scheduler_parallelism() - 1;
+    poolHelpers = 0;
+    for (int i = 0; i < wanted; i++) {
+        if (!pxThreadStart(&poolThreads[poolHelpers], parallel_worker,
+                           (void*)(intptr_t)(poolHelpers + 1))) {
+            break;
+        }
+        poolHelpers++;
+    }
+    return poolHelpers;
+}
+
+void scheduler_parallel_for(size_t count, size_t grain, ParallelBody body, void* context) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if ((count + grain - 1) / grain > PARALLEL_MAX_CHUNKS) {
+        grain = (count + PARALLEL_MAX_CHUNKS - 1) / PARALLEL_MAX_CHUNKS;
+    }
+
+    ParallelJob job;
+    job.body = body;
+    job.context = context;
+    job.count = count;
+    job.grain = grain;
+    size_t chunks = (count + grain - 1) / grain;
+
+    // One chunk, a nested loop, or no helpers: run in order here
+    if (chunks < 2 || atomic_load(&jobRunning) || start_pool() == 0) {
+        for (size_t chunk = 0; chunk < chunks; chunk++) run_chunk(&job, chunk);
+        return;
+    }
+    job.ranges = (ParallelRange*)malloc(sizeof(ParallelRange) * chunks);
+    if (job.ranges == NULL) {
+        for (size_t chunk = 0; chunk < chunks; chunk++) run_chunk(&job, chunk);
+        return;
+    }
+    atomic_store_explicit(&jobRunning, 1, memory_order_relaxed);
+    atomic_init(&job.nextRange, 1);
+    atomic_init(&job.chunksLeft, chunks);
+    job.ranges[0].first = 0;
+    job.ranges[0].last = chunks;
+    deque_push_bottom(&rangeDeques[0], &job.ranges[0]);
+
+    pxMutexLock(&poolLock);
+    poolJob = &job;
+    poolGeneration++;
+    pxCondBroadcast(&poolWake);
+    pxMutexUnlock(&poolLock);
+
+    run_job(&job, 0, poolHelpers + 1);
+
+    // Helpers may still be between their last chunk and leaving the job
+    pxMutexLock(&poolLock);
+    poolJob = NULL;
+    while (poolBusy > 0) pxCondWait(&poolIdle, &poolLock);
+    pxMutexUnlock(&poolLock);
+
+    free(job.ranges);
+    atomic_store_explicit(&jobRunning, 0, memory_order_relaxed);
+}
@@ -0,0 +1,564 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+ * Heap snapshots.
+ *
+ * Layout (native byte order and struct layout, like .proxc images):
+ *
+ *   SnapshotHeader
+ *   string records   preformed, pre-marked ObjString objects (16-byte aligned)
+ *   string table     u32 offset per string record
+ *   entries          SnapEntry / SnapValue arrays for tables and lists
+ *   object table     SnapObject per native, module, list or dictionary;
+ *                    natives are indices into the stdlib native table
+ *
+ * String records, their table and the interning pass are the bytecode
+ * image's own (proxc_put_strings / proxc_intern_strings). Every other object is rebuilt on the heap and all references
+ * are indices, so restoring is one pass over the objects with no parsing,
+ * hashing or string copies.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "../../include/snapshot.h"
+#include "../../include/bytecode_image.h"
+#include "../../include/object.h"
+#include "../../include/memory.h"
+#include "../../include/table.h"
+#include "../../include/sha256.h"
+
+#ifdef __linux__
+#include <sys/stat.h>
+#include <sys/types.h>
+#define SNAPSHOT_SUPPORTED 1
+#endif
+
+#define SNAPSHOT_MAGIC "PXSN"
+#define FINGERPRINT_SIZE 32
+
+#define VALUE_RAW    0
+#define VALUE_STRING 1
+#define VALUE_OBJECT 2
+
+typedef struct {
+  char magic[4];
+  uint16_t version;
+  uint8_t pointerSize;
+  uint8_t reserved;
+  uint32_t byteOrder;
+  uint32_t stringHeaderSize;
+  uint8_t fingerprint[FINGERPRINT_SIZE];
+  uint32_t imageSize;
+  uint32_t stringCount;
+  uint32_t stringTable;
+  uint32_t objectCount;
+  uint32_t objectTable;
+  uint32_t globals;
+  uint32_t globalCount;
+  uint32_t modules;
+  uint32_t moduleCount;
+  uint32_t initString;
+  uint32_t nativeCount;
+  uint64_t nativeAbi;
+} SnapshotHeader;
+
+typedef struct {
+  uint32_t kind;
+  uint32_t index;
+  uint64_t bits;
+} SnapValue;
+
+typedef struct {
+  uint32_t key; // string index
+  uint32_t reserved;
+  SnapValue value;
+} SnapEntry;
+
+typedef struct {
+  uint32_t type;
+  uint32_t name;    // module name (string index)
+  uint32_t entries; // SnapEntry[] for modules and dictionaries, SnapValue[] for lists
+  uint32_t count;
+  uint32_t native;   // index into the stdlib native table
+  uint32_t reserved;
+} SnapObject;
+
+static bool fingerprint(uint8_t out[FINGERPRINT_SIZE]) {
+#ifdef SNAPSHOT_SUPPORTED
+  struct stat st;
+  if (stat("/proc/self/exe", &st) != 0) return false;
+
+  uint64_t identity[6] = {
+    (uint64_t)st.st_dev, (uint64_t)st.st_ino, (uint64_t)st.st_size,
+    (uint64_t)st.st_mtim.tv_sec, (uint64_t)st.st_mtim.tv_nsec,
+    (uint64_t)PROX_SNAPSHOT_VERSION
+  };
+  static const char version[] = PROXPL_VERSION_STRING;
+
+  SHA256_CTX ctx;
+  sha256_init(&ctx);
+  sha256_update(&ctx, (const unsigned char*)version, sizeof(version));
+  sha256_update(&ctx, (const unsigned char*)identity, sizeof(identity));
+  sha256_final(&ctx, out);
+  return true;
+#else
+  (void)out;
+  return false;
+#endif
+}
+
+// Snapshots are per user, not per project: PROXPL_CACHE_DIR when set, else
+// $XDG_CACHE_HOME/proxpl or ~/.cache/proxpl. NULL when there is no home.
+static char* snapshotDir(void) {
+  const char* dir = getenv("PROXPL_CACHE_DIR");
+  if (dir != NULL && dir[0] != '\0') return strdup(dir);
+
+  const char* base = getenv("XDG_CACHE_HOME");
+  const char* suffix = "/proxpl";
+  if (base == NULL || base[0] == '\0') {
+    base = getenv("HOME");
+    suffix = "/.cache/proxpl";
+  }
+  if (base == NULL || base[0] == '\0') return NULL;
+
+  size_t len = strlen(base) + strlen(suffix) + 1;
+  char* out = (char*)malloc(len);
+  if (out != NULL) snprintf(out, len, "%s%s", base, suffix);
+  return out;
+}
+
+char* heapSnapshotPath(void) {
+  static const char hex[] = "0123456789abcdef";
+  uint8_t id[FINGERPRINT_SIZE];
+  if (!proxc_cache_enabled() || !fingerprint(id)) return NULL;
+
+  char* dir = snapshotDir();
+  if (dir == NULL) return NULL;
+  size_t len = strlen(dir) + sizeof("/stdlib-") + 16 + sizeof(".pxsnap");
+  char* path = (char*)malloc(len);
+  if (path == NULL) {
+    free(dir);
+    return NULL;
+  }
+
+  int n = snprintf(path, len, "%s/stdlib-", dir);
+  for (int i = 0; i < 8; i++) {
+    path[n++] = hex[id[i] >> 4];
+    path[n++] = hex[id[i] & 0x0F];
+  }
+  strcpy(path + n, ".pxsnap");
+  free(dir);
+  return path;
+}
+
+// Creates every missing directory above 'path'
+static void makeParents(const char* path) {
+#ifdef SNAPSHOT_SUPPORTED
+  char* copy = strdup(path);
+  if (copy == NULL) return;
+  for (char* slash = strchr(copy + 1, '/'); slash != NULL; slash = strchr(slash + 1, '/')) {
+    *slash = '\0';
+    mkdir(copy, 0755);
+    *slash = '/';
+  }
+  free(copy);
+#else
+  (void)path;
+#endif
+}
+
+/* --- Writer --- */
+
+// Open-addressed pointer -> index map for the objects being written.
+typedef struct {
+  Obj** keys;
+  uint32_t* ids;
+  uint32_t capacity;
+} ObjIds;
+
+static uint32_t slotFor(ObjIds* ids, Obj* object) {
+  uint32_t mask = ids->capacity - 1;
+  uint32_t slot = (uint32_t)(((uintptr_t)object >> 4) * 2654435761u) & mask;
+  while (ids->keys[slot] != NULL && ids->keys[slot] != object) slot = (slot + 1) & mask;
+  return slot;
+}
+
+typedef struct {
+  Obj** items;
+  uint32_t count;
+  uint32_t capacity;
+  ObjIds ids;
+  bool failed;
+} ObjSet;
+
+static void growIds(ObjSet* set) {
+  ObjIds old = set->ids;
+  uint32_t capacity = old.capacity < 64 ? 64 : old.capacity * 2;
+  set->ids.keys = (Obj**)calloc(capacity, sizeof(Obj*));
+  set->ids.ids = (uint32_t*)malloc(sizeof(uint32_t) * capacity);
+  set->ids.capacity = capacity;
+  if (set->ids.keys == NULL || set->ids.ids == NULL) {
+    free(set->ids.keys);
+    free(set->ids.ids);
+    set->failed = true;
+    set->ids = old;
+    return;
+  }
+  for (uint32_t i = 0; i < old.capacity; i++) {
+    if (old.keys[i] == NULL) continue;
+    uint32_t slot = slotFor(&set->ids, old.keys[i]);
+    set->ids.keys[slot] = old.keys[i];
+    set->ids.ids[slot] = old.ids[i];
+  }
+  free(old.keys);
+  free(old.ids);
+}
+
+// Returns the object's index, adding it on first sight.
+static uint32_t objectId(ObjSet* set, Obj* object) {
+  if ((set->count + 1) * 2 > set->ids.capacity) growIds(set);
+  if (set->failed) return 0;
+
+  uint32_t slot = slotFor(&set->ids, object);
+  if (set->ids.keys[slot] != NULL) return set->ids.ids[slot];
+
+  if (set->count == set->capacity) {
+    uint32_t capacity = set->capacity < 64 ? 64 : set->capacity * 2;
+    Obj** grown = (Obj**)realloc(set->items, sizeof(Obj*) * capacity);
+    if (grown == NULL) {
+      set->failed = true;
+      return 0;
+    }
+    set->items = grown;
+    set->capacity = capacity;
+  }
+  set->ids.keys[slot] = object;
+  set->ids.ids[slot] = set->count;
+  set->items[set->count] = object;
+  return set->count++;
+}
+
+static void freeObjSet(ObjSet* set) {
+  free(set->items);
+  free(set->ids.keys);
+  free(set->ids.ids);
+}
+
+static bool snapshotable(Obj* object) {
+  switch (object->type) {
+    case OBJ_STRING:
+    case OBJ_NATIVE:
+    case OBJ_MODULE:
+    case OBJ_LIST:
+    case OBJ_DICTIONARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static SnapValue encodeValue(ObjSet* strings, ObjSet* objects, Value value) {
+  SnapValue out = { VALUE_RAW, 0, (uint64_t)value };
+  if (!IS_OBJ(value)) return out;
+
+  Obj* object = AS_OBJ(value);
+  if (!snapshotable(object)) {
+    objects->failed = true;
+    return out;
+  }
+  out.bits = 0;
+  if (object->type == OBJ_STRING) {
+    out.kind = VALUE_STRING;
+    out.index = objectId(strings, object);
+  } else {
+    out.kind = VALUE_OBJECT;
+    out.index = objectId(objects, object);
+  }
+  return out;
+}
+
+// Writes a table's live entries; keys and values join the string/object sets.
+static uint32_t putTable(ImageWriter* b, ObjSet* strings, ObjSet* objects, Table* table, uint32_t* count) {
+  uint32_t offset = proxc_align(b, sizeof(uint64_t));
+  *count = 0;
+  for (int i = 0; i < table->capacity; i++) {
+    Entry* entry = &table->entries[i];
+    if (entry->key == NULL) continue;
+    SnapEntry out;
+    out.key = objectId(strings, (Obj*)entry->key);
+    out.reserved = 0;
+    out.value = encodeValue(strings, objects, entry->value);
+    proxc_put(b, &out, sizeof(out));
+    (*count)++;
+  }
+  return offset;
+}
+
+bool saveHeapSnapshot(VM* pvm, const char* path) {
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  if (!fingerprint(header.fingerprint)) return false;
+
+  ImageWriter b = { NULL, 0, 0, false };
+  ObjSet strings;
+  ObjSet objects;
+  memset(&strings, 0, sizeof(strings));
+  memset(&objects, 0, sizeof(objects));
+  SnapObject* records = NULL;
+
+  // Entry arrays come first; walking them discovers the objects, and the
+  // object table (written last) describes everything that was discovered.
+  proxc_put(&b, &header, sizeof(header));
+  header.globals = putTable(&b, &strings, &objects, &pvm->globals, &header.globalCount);
+  header.modules = putTable(&b, &strings, &objects, &pvm->importer.modules, &header.moduleCount);
+  header.initString = objectId(&strings, (Obj*)pvm->initString);
+
+  uint32_t recordCapacity = 0;
+  for (uint32_t i = 0; i < objects.count && !objects.failed; i++) {
+    Obj* object = objects.items[i];
+    if (i >= recordCapacity) {
+      SnapObject* grown = (SnapObject*)realloc(records, sizeof(SnapObject) * objects.capacity);
+      if (grown == NULL) {
+        objects.failed = true;
+        break;
+      }
+      records = grown;
+      recordCapacity = objects.capacity;
+    }
+    SnapObject* record = &records[i];
+    memset(record, 0, sizeof(*record));
+    record->type = (uint32_t)object->type;
+
+    switch (object->type) {
+      case OBJ_NATIVE:
+        // Natives the stdlib does not list have no index to write
+        if (!stdlibNativeIndex(((ObjNative*)object)->function, &record->native)) objects.failed = true;
+        break;
+      case OBJ_MODULE: {
+        ObjModule* module = (ObjModule*)object;
+        if (module->name == NULL) {
+          objects.failed = true;
+          break;
+        }
+        record->name = objectId(&strings, (Obj*)module->name);
+        record->entries = putTable(&b, &strings, &objects, &module->exports, &record->count);
+        break;
+      }
+      case OBJ_DICTIONARY:
+        record->entries = putTable(&b, &strings, &objects, &((ObjDictionary*)object)->items, &record->count);
+        break;
+      case OBJ_LIST: {
+        ObjList* list = (ObjList*)object;
+        record->entries = proxc_align(&b, sizeof(uint64_t));
+        record->count = (uint32_t)list->count;
+        for (int k = 0; k < list->count; k++) {
+          SnapValue value = encodeValue(&strings, &objects, list->items[k]);
+          proxc_put(&b, &value, sizeof(value));
+        }
+        break;
+      }
+      default:
+        objects.failed = true;
+        break;
+    }
+  }
+
+  bool ok = !objects.failed && !strings.failed && !b.failed;
+  if (ok) {
+    header.stringCount = strings.count;
+    header.stringTable = proxc_put_strings(&b, (ObjString* const*)strings.items, strings.count);
+    header.objectCount = objects.count;
+    header.objectTable = proxc_align(&b, sizeof(uint64_t));
+    if (objects.count > 0) proxc_put(&b, records, sizeof(SnapObject) * objects.count);
+    ok = !b.failed && b.count <= 0xFFFFFFFFu;
+  }
+
+  if (ok) {
+    memcpy(header.magic, SNAPSHOT_MAGIC, 4);
+    header.version = PROX_SNAPSHOT_VERSION;
+    header.pointerSize = (uint8_t)sizeof(void*);
+    header.byteOrder = PROXC_BYTE_ORDER_MARK;
+    header.stringHeaderSize = (uint32_t)offsetof(ObjString, chars);
+    header.imageSize = (uint32_t)b.count;
+    header.nativeCount = stdlibNativeCount();
+    header.nativeAbi = stdlibNativeAbi();
+    memcpy(b.data, &header, sizeof(header));
+
+    makeParents(path);
+    ok = proxc_write_file(path, b.data, b.count) == 0;
+  }
+
+  free(records);
+  freeObjSet(&strings);
+  freeObjSet(&objects);
+  free(b.data);
+  return ok;
+}
+
+/* --- Loader --- */
+
+static bool validValue(const SnapValue* value, const SnapshotHeader* header) {
+  switch (value->kind) {
+    case VALUE_RAW: return !IS_OBJ((Value)value->bits);
+    case VALUE_STRING: return value->index < header->stringCount;
+    case VALUE_OBJECT: return value->index < header->objectCount;
+    default: return false;
+  }
+}
+
+static bool validEntries(const uint8_t* image, size_t size, uint32_t offset, uint32_t count,
+                         const SnapshotHeader* header) {
+  if (!proxc_in_bounds(size, offset, (uint64_t)count * sizeof(SnapEntry), sizeof(uint64_t))) return false;
+  const SnapEntry* entries = (const SnapEntry*)(image + offset);
+  for (uint32_t i = 0; i < count; i++) {
+    if (entries[i].key >= header->stringCount || !validValue(&entries[i].value, header)) return false;
+  }
+  return true;
+}
+
+static bool validObject(const uint8_t* image, size_t size, const SnapObject* record,
+                        const SnapshotHeader* header) {
+  switch (record->type) {
+    case OBJ_NATIVE:
+      return record->native < header->nativeCount;
+    case OBJ_MODULE:
+      if (record->name >= header->stringCount) return false;
+      return validEntries(image, size, record->entries, record->count, header);
+    case OBJ_DICTIONARY:
+      return validEntries(image, size, record->entries, record->count, header);
+    case OBJ_LIST: {
+      if (record->count > 0x7FFFFFFF) return false;
+      if (!proxc_in_bounds(size, record->entries, (uint64_t)record->count * sizeof(SnapValue), sizeof(uint64_t))) return false;
+      const SnapValue* values = (const SnapValue*)(image + record->entries);
+      for (uint32_t i = 0; i < record->count; i++) {
+        if (!validValue(&values[i], header)) return false;
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+static Value decodeValue(const SnapValue* value, ObjString** strings, Obj** objects) {
+  switch (value->kind) {
+    case VALUE_STRING: return OBJ_VAL(strings[value->index]);
+    case VALUE_OBJECT: return OBJ_VAL(objects[value->index]);
+    default: return (Value)value->bits;
+  }
+}
+
+static void fillTable(Table* table, const uint8_t* image, uint32_t offset, uint32_t count,
+                      ObjString** strings, Obj** objects) {
+  const SnapEntry* entries = (const SnapEntry*)(image + offset);
+  for (uint32_t i = 0; i < count; i++) {
+    tableSet(table, strings[entries[i].key], decodeValue(&entries[i].value, strings, objects));
+  }
+}
+
+bool loadHeapSnapshot(VM* pvm, const char* path) {
+  uint8_t id[FINGERPRINT_SIZE];
+  if (path == NULL || !fingerprint(id)) return false;
+
+  size_t size;
+  uint8_t* image = proxc_map_file(path, &size);
+  if (image == NULL) return false;
+
+  SnapshotHeader header;
+  bool ok = size >= sizeof(header);
+  if (ok) {
+    memcpy(&header, image, sizeof(header));
+    ok = memcmp(header.magic, SNAPSHOT_MAGIC, 4) == 0 &&
+         header.version == PROX_SNAPSHOT_VERSION &&
+         header.pointerSize == sizeof(void*) &&
+         header.byteOrder == PROXC_BYTE_ORDER_MARK &&
+         header.stringHeaderSize == offsetof(ObjString, chars) &&
+         header.imageSize == size &&
+         memcmp(header.fingerprint, id, FINGERPRINT_SIZE) == 0 &&
+         header.initString < header.stringCount &&
+         header.nativeCount == stdlibNativeCount() &&
+         header.nativeAbi == stdlibNativeAbi() &&
+         proxc_in_bounds(size, header.objectTable, (uint64_t)header.objectCount * sizeof(SnapObject), sizeof(uint64_t)) &&
+         validEntries(image, size, header.globals, header.globalCount, &header) &&
+         validEntries(image, size, header.modules, header.moduleCount, &header);
+  }
+
+  ok = ok && proxc_valid_strings(image, size, header.stringTable, header.stringCount);
+  const SnapObject* records = ok ? (const SnapObject*)(image + header.objectTable) : NULL;
+  for (uint32_t i = 0; ok && i < header.objectCount; i++) {
+    ok = validObject(image, size, &records[i], &header);
+  }
+
+  ObjString** strings = NULL;
+  Obj** objects = NULL;
+  if (ok) {
+    strings = (ObjString**)malloc(sizeof(ObjString*) * header.stringCount);
+    objects = (Obj**)malloc(sizeof(Obj*) * (header.objectCount + 1));
+    ok = strings != NULL && objects != NULL;
+  }
+  if (!ok) {
+    free(strings);
+    free(objects);
+    proxc_unmap_file(image, size);
+    return false;
+  }
+
+  // Nothing below is rooted until the final tables are filled in.
+  size_t oldNextGC = pvm->nextGC;
+  pvm->nextGC = (size_t)-1;
+
+  proxc_intern_strings(&pvm->strings, image, header.stringTable, header.stringCount, strings);
+
+  for (uint32_t i = 0; i < header.objectCount; i++) {
+    const SnapObject* record = &records[i];
+    switch (record->type) {
+      case OBJ_NATIVE:
+        objects[i] = (Obj*)newNative(stdlibNative(record->native));
+        break;
+      case OBJ_MODULE:
+        objects[i] = (Obj*)newModule(strings[record->name]);
+        break;
+      case OBJ_DICTIONARY:
+        objects[i] = (Obj*)newDictionary();
+        break;
+      default:
+        objects[i] = (Obj*)newList();
+        break;
+    }
+  }
+
+  for (uint32_t i = 0; i < header.objectCount; i++) {
+    const SnapObject* record = &records[i];
+    if (record->type == OBJ_MODULE) {
+      fillTable(&((ObjModule*)objects[i])->exports, image, record->entries, record->count, strings, objects);
+    } else if (record->type == OBJ_DICTIONARY) {
+      fillTable(&((ObjDictionary*)objects[i])->items, image, record->entries, record->count, strings, objects);
+    } else if (record->type == OBJ_LIST && record->count > 0) {
+      ObjList* list = (ObjList*)objects[i];
+      const SnapValue* values = (const SnapValue*)(image + record->entries);
+      list->items = ALLOCATE(Value, record->count);
+      list->capacity = (int)record->count;
+      for (uint32_t k = 0; k < record->count; k++) {
+        list->items[k] = decodeValue(&values[k], strings, objects);
+      }
+      list->count = (int)record->count;
+    }
+  }
+
+  fillTable(&pvm->globals, image, header.globals, header.globalCount, strings, objects);
+  fillTable(&pvm->importer.modules, image, header.modules, header.moduleCount, strings, objects);
+  pvm->initString = strings[header.initString];
+
+  pvm->nextGC = oldNextGC;
+  free(strings);
+  free(objects);
+  initStdLibState(pvm);
+  // The mapping stays for the life of the process: interned strings live in it.
+  return true;
+}
@@ -22,22 +22,38 @@
 #include "../include/vm.h"
 #include "../include/error_report.h"
 #include "../include/ffi_bridge.h"
+#include "../include/jit.h"
+#include "../include/scheduler.h"
+#include "../include/iterator.h"
 
 
 VM vm;
 
 static void resetStack(VM *pvm) {
+  closeUpvalues(pvm, pvm->stack);
   pvm->stackTop = pvm->stack;
   pvm->frameCount = 0;
-  // CRITICAL FIX: Initialize stack to prevent reading uninitialized memory
-  // Without this, NaN-boxed Values can have corrupted type tags from random bits
-  for (int i = 0; i < STACK_MAX; i++) {
-    pvm->stack[i] = NIL_VAL;
-  }
 }
 
 void initVM(VM *pvm) { 
+    if (pvm != &vm) {
+      memset(pvm->openUpvalues, 0, sizeof(pvm->openUpvalues));
+    }
+    pvm->openUpvalueTop = 0;
+    pvm->stackClosures = NULL;
+    pvm->stackClosureLimit = 0;
     resetStack(pvm);
+    // CRITICAL FIX: Initialize stack to prevent reading uninitialized memory
+    // Without this, NaN-boxed Values can have corrupted type tags from random bits.
+    // The global VM lives in zero-filled static storage, where every slot
+    // already reads as the number 0; filling it would fault in the whole
+    // 2MB stack on every launch. Slots only ever hold valid Values once
+    // written, so resetting after an error needs no fill either.
+    if (pvm != &vm) {
+      for (int i = 0; i < STACK_MAX; i++) {
+        pvm->stack[i] = NIL_VAL;
+      }
+    }
     pvm->objects = NULL;
     initGC(pvm); // CRITICAL: Initialize GC state
     initTable(&pvm->globals);
@@ -50,6 +66,9 @@ void initVM(VM *pvm) {
     pvm->initString = copyString("init", 4);
     pvm->cliArgs = newList(); 
     pvm->activeContextCount = 0;
+    pvm->frameBase = 0;
+    pvm->nativeCallDepth = 0;
+    pvm->nativeErrorPending = false;
 }
 
 void freeVM(VM *pvm) {
@@ -57,7 +76,13 @@ void freeVM(VM *pvm) {
   freeTable(&pvm->strings);
   freeImporter(&pvm->importer);
   pvm->initString = NULL; // CRITICAL: Prevent use-after-free
+  pvm->cliArgs = NULL;
+  for (int i = 0; i < pvm->openUpvalueTop; i++) {
+    pvm->openUpvalues[i] = NULL;
+  }
+  pvm->openUpvalueTop = 0;
   freeObjects(pvm);
+  freeStackClosures(pvm);
   
   if (pvm->sourceFiles != NULL) {
       for (int i = 0; i < pvm->sourceCount; i++) {
@@ -88,7 +113,7 @@ void runtimeError(VM* pvm, const char* format, ...) {
   va_end(args);
 
   // Search for an exception handler in the call stack
-  for (int i = pvm->frameCount - 1; i >= 0; i--) {
+  for (int i = pvm->frameCount - 1; i >= pvm->frameBase; i--) {
       CallFrame* frame = &pvm->frames[i];
       ObjFunction* function = frame->closure->function;
       size_t instruction = frame->ip - function->chunk.code - 1;
@@ -100,6 +125,7 @@ void runtimeError(VM* pvm, const char* format, ...) {
               // Found a handler! Unwind stack to this frame.
               pvm->frameCount = i + 1;
               pvm->stackTop = frame->slots + function->arity; // Approximate stack reset
+              closeUpvalues(pvm, pvm->stackTop);
               
               // Set IP to handler
               frame->ip = function->chunk.code + handler->handler_ip;
@@ -112,6 +138,14 @@ void runtimeError(VM* pvm, const char* format, ...) {
       }
   }
 
+  // Inside vmCallValue: leave the frames to the nested call to unwind and
+  // raise the error again in the native's caller
+  if (pvm->nativeCallDepth > 0) {
+    memcpy(pvm->nativeError, message, sizeof(message));
+    pvm->nativeErrorPending = true;
+    return;
+  }
+
   // No handler found, print trace
   if (pvm->frameCount == 0) {
     fprintf(stderr, "%s\n", message);
@@ -141,6 +175,11 @@ void runtimeError(VM* pvm, const char* format, ...) {
   resetStack(pvm);
 }
 
+void raiseNativeError(VM* pvm) {
+  pvm->nativeErrorPending = false;
+  runtimeError(pvm, "%s", pvm->nativeError);
+}
+
 void push(VM* pvm, Value value) {
   if (pvm->stackTop >= pvm->stack + STACK_MAX) {
       // NOTE: Most stack checks now happen via the PUSH macro in run()
@@ -169,6 +208,30 @@ bool isFalsey(Value value) {
   return IS_NULL(value) || (IS_BOOL(value) && !AS_BOOL(value));
 }
 
+// Rows of a matrix product are independent, so '@' hands them out across
+// the scheduler's workers in chunks of about MATMUL_CHUNK_WORK multiply-adds
+#define MATMUL_CHUNK_WORK 65536
+
+typedef struct {
+    const ObjTensor* a;
+    const ObjTensor* b;
+    ObjTensor* res;
+} MatmulJob;
+
+static void matmulRows(size_t begin, size_t end, void* context) {
+    MatmulJob* job = (MatmulJob*)context;
+    int inner = job->a->dims[1];
+    int cols = job->b->dims[1];
+    for (size_t i = begin; i < end; i++) {
+        double* row = job->res->data + i * cols;
+        for (int k = 0; k < inner; k++) {
+            double val_a = job->a->data[i * inner + k];
+            const double* bRow = job->b->data + (size_t)k * cols;
+            for (int j = 0; j < cols; j++) row[j] += val_a * bRow[j];
+        }
+    }
+}
+
 static bool performTensorArithmetic(VM* pvm, char op) {
     Value bVal = peek(pvm, 0);
     Value aVal = peek(pvm, 1);
@@ -349,6 +412,15 @@ static Value valueToObjString(Value val) {
 
 // Helper functions moved to vm_helpers.c to avoid duplication
 
+// A function that captures nothing needs one closure, however many times
+// its declaration runs.
+static ObjClosure* sharedClosure(ObjFunction* function) {
+  if (function->sharedClosure == NULL) {
+    function->sharedClosure = newClosure(function);
+  }
+  return function->sharedClosure;
+}
+
 static InterpretResult run(VM* pvm) {
   CallFrame* frame = &pvm->frames[pvm->frameCount - 1];
   
@@ -357,11 +429,33 @@ static InterpretResult run(VM* pvm) {
    * and frame->ip for every single push/pop/read operation. */
   register uint8_t* ip = frame->ip;
   register Value* stackTop = pvm->stackTop;
+  /* Index operand of the current instruction, for handlers OP_WIDE can enter */
+  uint32_t operand;
+  bool wideClosure = false;
 
 #define READ_BYTE() (*ip++)
 #define READ_SHORT() (ip += 2, (uint16_t)((ip[-2] << 8) | ip[-1]))
+#define READ_TRIPLE() (ip += 3, ((uint32_t)ip[-3] << 16) | ((uint32_t)ip[-2] << 8) | (uint32_t)ip[-1])
+#define READ_LONG() (ip += 4, ((uint32_t)ip[-4] << 24) | ((uint32_t)ip[-3] << 16) | \
+                              ((uint32_t)ip[-2] << 8) | (uint32_t)ip[-1])
 #define READ_CONSTANT() (frame->closure->function->chunk.constants.values[READ_BYTE()])
 #define READ_STRING() AS_STRING(READ_CONSTANT())
+#define OPERAND_CONSTANT() (frame->closure->function->chunk.constants.values[operand])
+#define OPERAND_STRING() AS_STRING(OPERAND_CONSTANT())
+
+/* Reads the one-byte index operand. OP_WIDE enters below it, at
+ * WIDE_<opcode>, with its wider operand already read. */
+#define INDEX_OPERAND(name) operand = READ_BYTE(); WIDE_##name
+
+/* Reads OP_CLOSURE's capture pairs, which follow its upvalue pairs, and
+ * copies each value into the new closure. */
+#define READ_CAPTURES(closure) \
+    for (int _i = 0; _i < (closure)->captureCount; _i++) { \
+        uint8_t _isLocal = READ_BYTE(); \
+        uint16_t _index = wideClosure ? READ_SHORT() : READ_BYTE(); \
+        (closure)->captures[_i] = _isLocal ? frame->slots[_index] \
+                                           : frame->closure->captures[_index]; \
+    }
 
 #define PUSH(value) \
     do { \
@@ -380,6 +474,80 @@ static InterpretResult run(VM* pvm) {
 #define LOAD_FRAME()  (frame = &pvm->frames[pvm->frameCount - 1], \
                        ip = frame->ip, stackTop = pvm->stackTop)
 
+/* Run native code for the current frame from bytecode offset 'entry'. A
+ * return pops the frame like OP_RETURN; a deopt resumes interpreting at the
+ * point native code left off, with the frame slots it wrote back. */
+#define JIT_ENTER(entry) \
+    do { \
+        JitExit _exit; \
+        if (jitEnter(pvm, frame, (entry), &_exit)) { \
+            pvm->frameCount--; \
+            if (pvm->frameCount == pvm->frameBase) { \
+                pvm->stackTop = frame->slots; \
+                *pvm->stackTop = _exit.result; \
+                return INTERPRET_OK; \
+            } \
+            stackTop = frame->slots; \
+            PUSH(_exit.result); \
+            frame = &pvm->frames[pvm->frameCount - 1]; \
+            ip = frame->ip; \
+        } else if (_exit.depth >= 0) { \
+            ip = frame->closure->function->chunk.code + _exit.ip; \
+            stackTop = frame->slots + _exit.depth; \
+        } \
+    } while (false)
+
+/* Taken loop back-edge: count it and switch to native code once hot. 'ip'
+ * already points at the loop header. */
+#define LOOP_BACK_EDGE() \
+    do { \
+        ObjFunction* _function = frame->closure->function; \
+        if (_function->jitState == JIT_COLD && ++_function->hotness >= JIT_HOT_THRESHOLD) { \
+            jitCompile(_function); \
+        } \
+        if (_function->jitState == JIT_COMPILED) { \
+            STORE_FRAME(); \
+            JIT_ENTER((int)(ip - _function->chunk.code)); \
+        } \
+    } while (false)
+
+/* Relational operator on anything but two numbers: instances may overload
+ * it, everything else is an error. */
+#define COMPARE_SLOW(opName) \
+    do { \
+        if (IS_INSTANCE(stackTop[-2]) && checkInstanceOperator(pvm, stackTop[-2], opName)) { \
+            STORE_FRAME(); \
+            ObjString* _opStr = copyString(opName, (int)strlen(opName)); \
+            if (!invoke(_opStr, 1, pvm)) { \
+                return INTERPRET_RUNTIME_ERROR; \
+            } \
+            LOAD_FRAME(); \
+        } else { \
+            STORE_FRAME(); \
+            runtimeError(pvm, "Operands must be numbers."); \
+            return INTERPRET_RUNTIME_ERROR; \
+        } \
+    } while (false)
+
+/* Fused compare-and-loop: compares two numbers and takes the embedded
+ * OP_LOOP_IF_TRUE's branch directly; anything else compares the slow way and
+ * leaves the result for that OP_LOOP_IF_TRUE. */
+#define FUSED_LOOP_COMPARE(cmp, opName) \
+    do { \
+        if (IS_NUMBER(stackTop[-1]) && IS_NUMBER(stackTop[-2])) { \
+            bool _taken = AS_NUMBER(stackTop[-2]) cmp AS_NUMBER(stackTop[-1]); \
+            stackTop -= 2; \
+            ip++; \
+            uint16_t _offset = READ_SHORT(); \
+            if (_taken) { \
+                ip -= _offset; \
+                LOOP_BACK_EDGE(); \
+            } \
+        } else { \
+            COMPARE_SLOW(opName); \
+        } \
+    } while (false)
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4611)
@@ -473,7 +641,22 @@ static InterpretResult run(VM* pvm) {
       [OP_CONTEXT] = &&DO_OP_CONTEXT,
       [OP_LAYER] = &&DO_OP_LAYER,
       [OP_ACTIVATE] = &&DO_OP_ACTIVATE,
-      [OP_END_ACTIVATE] = &&DO_OP_END_ACTIVATE
+      [OP_END_ACTIVATE] = &&DO_OP_END_ACTIVATE,
+      [OP_LESS_EQUAL] = &&DO_OP_LESS_EQUAL,
+      [OP_GREATER_EQUAL] = &&DO_OP_GREATER_EQUAL,
+      [OP_JUMP_IF_FALSE_POP] = &&DO_OP_JUMP_IF_FALSE_POP,
+      [OP_LOOP_IF_TRUE] = &&DO_OP_LOOP_IF_TRUE,
+      [OP_LOOP_IF_LESS] = &&DO_OP_LOOP_IF_LESS,
+      [OP_LOOP_IF_LESS_EQUAL] = &&DO_OP_LOOP_IF_LESS_EQUAL,
+      [OP_LOOP_IF_GREATER] = &&DO_OP_LOOP_IF_GREATER,
+      [OP_LOOP_IF_GREATER_EQUAL] = &&DO_OP_LOOP_IF_GREATER_EQUAL,
+      [OP_STACK_CLOSURE] = &&DO_OP_STACK_CLOSURE,
+      [OP_GUARD_ARGS] = &&DO_OP_GUARD_ARGS,
+      [OP_GET_CAPTURE] = &&DO_OP_GET_CAPTURE,
+      [OP_ITER] = &&DO_OP_ITER,
+      [OP_FOR_ITER] = &&DO_OP_FOR_ITER,
+      [OP_WIDE] = &&DO_OP_WIDE,
+      [OP_CONSTANT_LONG] = &&DO_OP_CONSTANT_LONG
   };
   #pragma GCC diagnostic pop
 
@@ -488,7 +671,15 @@ static InterpretResult run(VM* pvm) {
 #endif
 
   CASE_OP(OP_CONSTANT) {
-      PUSH(READ_CONSTANT());
+      INDEX_OPERAND(OP_CONSTANT): ;
+      PUSH(OPERAND_CONSTANT());
+      DISPATCH();
+  }
+
+  CASE_OP(OP_CONSTANT_LONG) {
+      operand = (uint32_t)ip[0] | ((uint32_t)ip[1] << 8) | ((uint32_t)ip[2] << 16);
+      ip += 3;
+      PUSH(OPERAND_CONSTANT());
       DISPATCH();
   }
   
@@ -522,7 +713,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_BUILD_LIST) {
-      int count = READ_BYTE();
+      INDEX_OPERAND(OP_BUILD_LIST): ;
+      int count = (int)operand;
       STORE_FRAME();         /* sync stackTop so GC sees live values during allocation */
       ObjList* list = newList();
       LOAD_FRAME();
@@ -553,7 +745,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_BUILD_MAP) {
-      int count = READ_BYTE();
+      INDEX_OPERAND(OP_BUILD_MAP): ;
+      int count = (int)operand;
       STORE_FRAME();          /* sync stackTop so GC is safe during dictionary allocation */
       ObjDictionary* dict = newDictionary();
       LOAD_FRAME();
@@ -592,6 +785,20 @@ static InterpretResult run(VM* pvm) {
               return INTERPRET_RUNTIME_ERROR;
           }
           PUSH(list->items[index]);
+      } else if (IS_TYPED_ARRAY(targetVal)) {
+          ObjTypedArray* array = AS_TYPED_ARRAY(targetVal);
+          if (!IS_NUMBER(indexVal)) {
+              STORE_FRAME();
+              runtimeError(pvm, "Typed array index must be a number.");
+              return INTERPRET_RUNTIME_ERROR;
+          }
+          int index = (int)AS_NUMBER(indexVal);
+          if (index < 0 || index >= array->count) {
+              STORE_FRAME();
+              runtimeError(pvm, "Typed array index out of bounds.");
+              return INTERPRET_RUNTIME_ERROR;
+          }
+          PUSH(NUMBER_VAL(typedArrayGet(array, index)));
       } else if (IS_DICTIONARY(targetVal)) {
           if (!IS_STRING(indexVal)) {
               STORE_FRAME();
@@ -616,7 +823,7 @@ static InterpretResult run(VM* pvm) {
           LOAD_FRAME();
       } else {
           STORE_FRAME();
-          runtimeError(pvm, "Can only index lists and dictionaries.");
+          runtimeError(pvm, "Can only index lists, typed arrays and dictionaries.");
           return INTERPRET_RUNTIME_ERROR;
       }
       DISPATCH();
@@ -642,6 +849,27 @@ static InterpretResult run(VM* pvm) {
           list->items[index] = value;
           stackTop -= 3;
           PUSH(value);
+      } else if (IS_TYPED_ARRAY(targetVal)) {
+          ObjTypedArray* array = AS_TYPED_ARRAY(targetVal);
+          if (!IS_NUMBER(indexVal)) {
+              STORE_FRAME();
+              runtimeError(pvm, "Typed array index must be a number.");
+              return INTERPRET_RUNTIME_ERROR;
+          }
+          int index = (int)AS_NUMBER(indexVal);
+          if (index < 0 || index >= array->count) {
+              STORE_FRAME();
+              runtimeError(pvm, "Typed array index out of bounds.");
+              return INTERPRET_RUNTIME_ERROR;
+          }
+          if (!IS_NUMBER(value)) {
+              STORE_FRAME();
+              runtimeError(pvm, "Typed array elements must be numbers.");
+              return INTERPRET_RUNTIME_ERROR;
+          }
+          typedArraySet(array, index, AS_NUMBER(value));
+          stackTop -= 3;
+          PUSH(value);
       } else if (IS_DICTIONARY(targetVal)) {
           if (!IS_STRING(indexVal)) {
               STORE_FRAME();
@@ -662,7 +890,7 @@ static InterpretResult run(VM* pvm) {
           LOAD_FRAME();
       } else {
           STORE_FRAME();
-          runtimeError(pvm, "Can only index lists and dictionaries.");
+          runtimeError(pvm, "Can only index lists, typed arrays and dictionaries.");
           return INTERPRET_RUNTIME_ERROR;
       }
       DISPATCH();
@@ -692,7 +920,8 @@ static InterpretResult run(VM* pvm) {
 
   
   CASE_OP(OP_GET_GLOBAL) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_GET_GLOBAL): ;
+      ObjString* name = OPERAND_STRING();
       ObjFunction* func = frame->closure->function;
 
       /* GIC FAST PATH: If we have a valid entry cached for this table state, use it. */
@@ -736,7 +965,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_DEFINE_GLOBAL) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_DEFINE_GLOBAL): ;
+      ObjString* name = OPERAND_STRING();
       STORE_FRAME();
       tableSet(&pvm->globals, name, stackTop[-1]);
       stackTop--;
@@ -744,7 +974,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_SET_GLOBAL) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_SET_GLOBAL): ;
+      ObjString* name = OPERAND_STRING();
       STORE_FRAME();
       if (tableSet(&pvm->globals, name, stackTop[-1])) {
         tableDelete(&pvm->globals, name);
@@ -760,6 +991,12 @@ static InterpretResult run(VM* pvm) {
       DISPATCH();
   }
   
+  CASE_OP(OP_GET_CAPTURE) {
+      uint8_t slot = READ_BYTE();
+      PUSH(frame->closure->captures[slot]);
+      DISPATCH();
+  }
+  
   CASE_OP(OP_SET_UPVALUE) {
       uint8_t slot = READ_BYTE();
       *frame->closure->upvalues[slot]->location = stackTop[-1];
@@ -767,7 +1004,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_GET_PROPERTY) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_GET_PROPERTY): ;
+      ObjString* name = OPERAND_STRING();
       Value target = stackTop[-1];
       if (IS_INSTANCE(target)) {
           ObjInstance* instance = AS_INSTANCE(target);
@@ -800,7 +1038,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_SET_PROPERTY) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_SET_PROPERTY): ;
+      ObjString* name = OPERAND_STRING();
       if (!IS_INSTANCE(stackTop[-2])) {
         STORE_FRAME();
         runtimeError(pvm, "Only instances have fields.");
@@ -815,7 +1054,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_GET_SUPER) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_GET_SUPER): ;
+      ObjString* name = OPERAND_STRING();
       ObjClass* superclass = AS_CLASS(*(--stackTop));
       STORE_FRAME();
       if (!bindMethod(superclass, name, pvm)) {
@@ -893,6 +1133,30 @@ static InterpretResult run(VM* pvm) {
       DISPATCH();
   }
   
+  CASE_OP(OP_LESS_EQUAL) {
+      Value b = stackTop[-1];
+      Value a = stackTop[-2];
+      if (IS_NUMBER(a) && IS_NUMBER(b)) {
+          stackTop -= 2;
+          PUSH(BOOL_VAL(AS_NUMBER(a) <= AS_NUMBER(b)));
+      } else {
+          COMPARE_SLOW("operator<=");
+      }
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_GREATER_EQUAL) {
+      Value b = stackTop[-1];
+      Value a = stackTop[-2];
+      if (IS_NUMBER(a) && IS_NUMBER(b)) {
+          stackTop -= 2;
+          PUSH(BOOL_VAL(AS_NUMBER(a) >= AS_NUMBER(b)));
+      } else {
+          COMPARE_SLOW("operator>=");
+      }
+      DISPATCH();
+  }
+  
   CASE_OP(OP_ADD) {
       if (IS_NUMBER(stackTop[-1]) && IS_NUMBER(stackTop[-2])) {
           double b = AS_NUMBER(*(--stackTop));
@@ -1057,9 +1321,162 @@ static InterpretResult run(VM* pvm) {
       DISPATCH();
   }
   
+  CASE_OP(OP_JUMP_IF_FALSE_POP) {
+      uint16_t offset = READ_SHORT();
+      if (isFalsey(*--stackTop)) ip += offset;
+      DISPATCH();
+  }
+  
   CASE_OP(OP_LOOP) {
       uint16_t offset = READ_SHORT();
       ip -= offset;
+      LOOP_BACK_EDGE();
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_LOOP_IF_TRUE) {
+      uint16_t offset = READ_SHORT();
+      if (!isFalsey(*--stackTop)) {
+          ip -= offset;
+          LOOP_BACK_EDGE();
+      }
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_LOOP_IF_LESS) {
+      FUSED_LOOP_COMPARE(<, "operator<");
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_LOOP_IF_LESS_EQUAL) {
+      FUSED_LOOP_COMPARE(<=, "operator<=");
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_LOOP_IF_GREATER) {
+      FUSED_LOOP_COMPARE(>, "operator>");
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_LOOP_IF_GREATER_EQUAL) {
+      FUSED_LOOP_COMPARE(>=, "operator>=");
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_ITER) {
+      if (!IS_ITERATOR(stackTop[-1])) {
+          STORE_FRAME();
+          ObjIterator* iterator = iteratorOf(stackTop[-1]);
+          if (iterator == NULL) {
+              runtimeError(pvm, "Only lists, tensors, typed arrays, strings and iterators can be iterated.");
+              return INTERPRET_RUNTIME_ERROR;
+          }
+          stackTop[-1] = OBJ_VAL(iterator);
+      }
+      DISPATCH();
+  }
+
+  CASE_OP(OP_FOR_ITER) {
+      operand = READ_SHORT();
+  WIDE_OP_FOR_ITER: ;
+      ObjIterator* iterator = AS_ITERATOR(stackTop[-2]);
+      /* Ranges and lists step here; every other stage, and the end of
+       * these, goes through iteratorNext() */
+      if (iterator->kind == ITER_RANGE && !iterator->done) {
+          double value = iterator->start + (double)iterator->position * iterator->step;
+          if (iterator->step > 0 ? value < iterator->stop : value > iterator->stop) {
+              iterator->position++;
+              stackTop[-1] = NUMBER_VAL(value);
+              DISPATCH();
+          }
+      } else if (iterator->kind == ITER_SEQUENCE && !iterator->done && IS_LIST(iterator->source)) {
+          ObjList* list = AS_LIST(iterator->source);
+          if (iterator->position < list->count) {
+              stackTop[-1] = list->items[iterator->position++];
+              DISPATCH();
+          }
+      }
+      STORE_FRAME();
+      Value item;
+      if (iteratorNext(iterator, &item)) {
+          stackTop[-1] = item;
+      } else if (pvm->nativeErrorPending) {
+          raiseNativeError(pvm);
+          return INTERPRET_RUNTIME_ERROR;
+      } else {
+          ip += operand;
+      }
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_WIDE) {
+      /* The next instruction with its operand widened: 24-bit constant
+       * indices, 16-bit slots and counts, 32-bit jump offsets. */
+      uint8_t op = READ_BYTE();
+      switch (op) {
+          case OP_JUMP:
+              operand = READ_LONG();
+              ip += operand;
+              break;
+          case OP_JUMP_IF_FALSE:
+              operand = READ_LONG();
+              if (isFalsey(stackTop[-1])) ip += operand;
+              break;
+          case OP_JUMP_IF_FALSE_POP:
+              operand = READ_LONG();
+              if (isFalsey(*--stackTop)) ip += operand;
+              break;
+          case OP_LOOP:
+              operand = READ_LONG();
+              ip -= operand;
+              LOOP_BACK_EDGE();
+              break;
+          case OP_LOOP_IF_TRUE:
+              operand = READ_LONG();
+              if (!isFalsey(*--stackTop)) {
+                  ip -= operand;
+                  LOOP_BACK_EDGE();
+              }
+              break;
+          case OP_FOR_ITER:      operand = READ_LONG(); goto WIDE_OP_FOR_ITER;
+          case OP_GET_LOCAL:     PUSH(frame->slots[READ_SHORT()]); break;
+          case OP_SET_LOCAL:     frame->slots[READ_SHORT()] = stackTop[-1]; break;
+          case OP_GET_UPVALUE:   PUSH(*frame->closure->upvalues[READ_SHORT()]->location); break;
+          case OP_SET_UPVALUE:   *frame->closure->upvalues[READ_SHORT()]->location = stackTop[-1]; break;
+          case OP_GET_CAPTURE:   PUSH(frame->closure->captures[READ_SHORT()]); break;
+          case OP_CONSTANT:      operand = READ_TRIPLE(); goto WIDE_OP_CONSTANT;
+          case OP_BUILD_LIST:    operand = READ_SHORT(); goto WIDE_OP_BUILD_LIST;
+          case OP_BUILD_MAP:     operand = READ_SHORT(); goto WIDE_OP_BUILD_MAP;
+          case OP_GET_GLOBAL:    operand = READ_TRIPLE(); goto WIDE_OP_GET_GLOBAL;
+          case OP_DEFINE_GLOBAL: operand = READ_TRIPLE(); goto WIDE_OP_DEFINE_GLOBAL;
+          case OP_SET_GLOBAL:    operand = READ_TRIPLE(); goto WIDE_OP_SET_GLOBAL;
+          case OP_GET_PROPERTY:  operand = READ_TRIPLE(); goto WIDE_OP_GET_PROPERTY;
+          case OP_SET_PROPERTY:  operand = READ_TRIPLE(); goto WIDE_OP_SET_PROPERTY;
+          case OP_GET_SUPER:     operand = READ_TRIPLE(); goto WIDE_OP_GET_SUPER;
+          case OP_INVOKE:        operand = READ_TRIPLE(); goto WIDE_OP_INVOKE;
+          case OP_SUPER_INVOKE:  operand = READ_TRIPLE(); goto WIDE_OP_SUPER_INVOKE;
+          case OP_CLOSURE:
+              operand = READ_TRIPLE();
+              wideClosure = true;
+              goto WIDE_OP_CLOSURE;
+          case OP_STACK_CLOSURE:
+              operand = READ_TRIPLE();
+              wideClosure = true;
+              goto WIDE_OP_STACK_CLOSURE;
+          case OP_CLASS:         operand = READ_TRIPLE(); goto WIDE_OP_CLASS;
+          case OP_METHOD:        operand = READ_TRIPLE(); goto WIDE_OP_METHOD;
+          case OP_USE:           operand = READ_TRIPLE(); goto WIDE_OP_USE;
+          case OP_INTERFACE:     operand = READ_TRIPLE(); goto WIDE_OP_INTERFACE;
+          case OP_TRAIT:         operand = READ_TRIPLE(); goto WIDE_OP_TRAIT;
+          case OP_CONTEXT:       operand = READ_TRIPLE(); goto WIDE_OP_CONTEXT;
+          case OP_LAYER:         operand = READ_TRIPLE(); goto WIDE_OP_LAYER;
+          case OP_INTENT:        operand = READ_TRIPLE(); goto WIDE_OP_INTENT;
+          case OP_RESOLVER:      operand = READ_TRIPLE(); goto WIDE_OP_RESOLVER;
+          default:
+              STORE_FRAME();
+              runtimeError(pvm, "Opcode %d has no wide form.", op);
+              return INTERPRET_RUNTIME_ERROR;
+      }
       DISPATCH();
   }
   
@@ -1078,17 +1495,31 @@ static InterpretResult run(VM* pvm) {
               runtimeError(pvm, "Stack overflow.");
               return INTERPRET_RUNTIME_ERROR;
           }
+          ObjFunction* function = closure->function;
+          if (function->jitState == JIT_COLD) {
+              jitRecordCall(function, stackTop - argCount, argCount);
+              if (function->hotness >= JIT_HOT_THRESHOLD) jitCompile(function);
+          }
           frame->ip = ip; // Save current IP before frame switch
           frame = &pvm->frames[pvm->frameCount++];
           frame->closure = closure;
-          frame->ip = closure->function->chunk.code;
+          frame->ip = function->chunk.code;
           frame->slots = stackTop - argCount - 1;
           ip = frame->ip; // Load new IP
+          if (function->jitState == JIT_COMPILED) {
+              STORE_FRAME();
+              JIT_ENTER(0);
+          }
           DISPATCH();
       } else if (IS_NATIVE(callee)) {
           NativeFn native = AS_NATIVE(callee);
           pvm->stackTop = stackTop;  /* sync so GC inside native sees live roots */
           Value result = native(argCount, stackTop - argCount);
+          if (pvm->nativeErrorPending) {
+              STORE_FRAME();
+              raiseNativeError(pvm);
+              return INTERPRET_RUNTIME_ERROR;
+          }
           stackTop -= argCount + 1;
           PUSH(result);
           DISPATCH();
@@ -1161,7 +1592,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_INVOKE) {
-      ObjString* method = READ_STRING();
+      INDEX_OPERAND(OP_INVOKE): ;
+      ObjString* method = OPERAND_STRING();
       int argCount = READ_BYTE();
       STORE_FRAME();
       if (!invoke(method, argCount, pvm)) {
@@ -1172,7 +1604,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_SUPER_INVOKE) {
-      ObjString* method = READ_STRING();
+      INDEX_OPERAND(OP_SUPER_INVOKE): ;
+      ObjString* method = OPERAND_STRING();
       int argCount = READ_BYTE();
       Value superVal = *(--stackTop);
       ObjClass* superclass = AS_CLASS(superVal);
@@ -1185,13 +1618,19 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_CLOSURE) {
-      ObjFunction* function = AS_FUNCTION(READ_CONSTANT());
+      wideClosure = false;
+      INDEX_OPERAND(OP_CLOSURE): ;
+      ObjFunction* function = AS_FUNCTION(OPERAND_CONSTANT());
       STORE_FRAME();
+      if (function->upvalueCount == 0 && function->captureCount == 0) {
+          PUSH(OBJ_VAL(sharedClosure(function)));
+          DISPATCH();
+      }
       ObjClosure* closure = newClosure(function);
       PUSH(OBJ_VAL(closure));
       for (int i = 0; i < closure->upvalueCount; i++) {
           uint8_t isLocal = READ_BYTE();
-          uint8_t index = READ_BYTE();
+          uint16_t index = wideClosure ? READ_SHORT() : READ_BYTE();
           if (isLocal) {
               STORE_FRAME();
               closure->upvalues[i] = captureUpvalue(frame->slots + index, pvm);
@@ -1200,6 +1639,45 @@ static InterpretResult run(VM* pvm) {
               closure->upvalues[i] = frame->closure->upvalues[index];
           }
       }
+      READ_CAPTURES(closure);
+      DISPATCH();
+  }
+  
+  CASE_OP(OP_STACK_CLOSURE) {
+      wideClosure = false;
+      INDEX_OPERAND(OP_STACK_CLOSURE): ;
+      ObjFunction* function = AS_FUNCTION(OPERAND_CONSTANT());
+      // Escape analysis proved the closure dies with this slot, so it takes
+      // the slot's block instead of a heap allocation
+      STORE_FRAME();
+      if (function->upvalueCount == 0 && function->captureCount == 0) {
+          PUSH(OBJ_VAL(sharedClosure(function)));
+          DISPATCH();
+      }
+      ObjClosure* closure = newStackClosure(pvm, function, stackTop);
+      PUSH(OBJ_VAL(closure));
+      for (int i = 0; i < closure->upvalueCount; i++) {
+          uint8_t isLocal = READ_BYTE();
+          uint16_t index = wideClosure ? READ_SHORT() : READ_BYTE();
+          if (!isLocal) {
+              closure->upvalues[i] = frame->closure->upvalues[index];
+          } else if (closure->onStack) {
+              stackUpvalue(closure, i, frame->slots + index);
+          } else {
+              STORE_FRAME();
+              closure->upvalues[i] = captureUpvalue(frame->slots + index, pvm);
+              LOAD_FRAME();
+          }
+      }
+      READ_CAPTURES(closure);
+      DISPATCH();
+  }
+
+  CASE_OP(OP_GUARD_ARGS) {
+      int argCount = READ_BYTE();
+      STORE_FRAME();
+      guardStackArgs(pvm, argCount);
+      LOAD_FRAME();
       DISPATCH();
   }
   
@@ -1212,9 +1690,13 @@ static InterpretResult run(VM* pvm) {
   
   CASE_OP(OP_RETURN) {
       Value result = *(--stackTop);
+      if (pvm->openUpvalueTop > frame->slots - pvm->stack) closeUpvalues(pvm, frame->slots);
       pvm->frameCount--;
-      if (pvm->frameCount == 0) {
-        pvm->stackTop = stackTop;
+      if (pvm->frameCount == pvm->frameBase) {
+        // Drop the script's slots so the next script starts clean. A call
+        // from vmCallValue reads its result from the first free slot.
+        pvm->stackTop = frame->slots;
+        *pvm->stackTop = result;
         return INTERPRET_OK;
       }
       stackTop = frame->slots;
@@ -1225,7 +1707,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_CLASS) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_CLASS): ;
+      ObjString* name = OPERAND_STRING();
       STORE_FRAME();
       PUSH(OBJ_VAL(newClass(name)));
       DISPATCH();
@@ -1245,7 +1728,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_METHOD) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_METHOD): ;
+      ObjString* name = OPERAND_STRING();
       STORE_FRAME();
       defineMethod(name, pvm);
       LOAD_FRAME();
@@ -1253,7 +1737,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_USE) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_USE): ;
+      ObjString* name = OPERAND_STRING();
       STORE_FRAME();
       Value moduleVal;
       if (!tableGet(&pvm->importer.modules, name, &moduleVal)) {
@@ -1265,14 +1750,16 @@ static InterpretResult run(VM* pvm) {
   }
   
     CASE_OP(OP_INTERFACE) {
-        ObjString* name = AS_STRING(READ_CONSTANT());
+        INDEX_OPERAND(OP_INTERFACE): ;
+        ObjString* name = OPERAND_STRING();
         STORE_FRAME();
         PUSH(OBJ_VAL(newInterface(name)));
         DISPATCH();
     }
     
     CASE_OP(OP_TRAIT) {
-        ObjString* name = AS_STRING(READ_CONSTANT());
+        INDEX_OPERAND(OP_TRAIT): ;
+        ObjString* name = OPERAND_STRING();
         STORE_FRAME();
         PUSH(OBJ_VAL(newInterface(name)));
         DISPATCH();
@@ -1465,14 +1952,10 @@ static InterpretResult run(VM* pvm) {
       STORE_FRAME();
       ObjTensor *res = newTensor(2, outDims, NULL);
       PUSH(OBJ_VAL(res));
-      for (int i = 0; i < a->dims[0]; i++) {
-          for (int k = 0; k < a->dims[1]; k++) {
-              double val_a = a->data[i * a->dims[1] + k];
-              for (int j = 0; j < b->dims[1]; j++) {
-                  res->data[i * b->dims[1] + j] += val_a * b->data[k * b->dims[1] + j];
-              }
-          }
-      }
+      MatmulJob job = { a, b, res };
+      size_t rowWork = (size_t)a->dims[1] * (size_t)b->dims[1];
+      size_t rowsPerChunk = rowWork >= MATMUL_CHUNK_WORK ? 1 : MATMUL_CHUNK_WORK / (rowWork > 0 ? rowWork : 1);
+      scheduler_parallel_for((size_t)a->dims[0], rowsPerChunk, matmulRows, &job);
       Value resVal = *(--stackTop);
       stackTop -= 2;
       PUSH(resVal);
@@ -1593,14 +2076,16 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_CONTEXT) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_CONTEXT): ;
+      ObjString* name = OPERAND_STRING();
       STORE_FRAME();
       PUSH(OBJ_VAL(newContext(name)));
       DISPATCH();
   }
   
   CASE_OP(OP_LAYER) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_LAYER): ;
+      ObjString* name = OPERAND_STRING();
       STORE_FRAME();
       ObjLayer* layer = newLayer(name);
       PUSH(OBJ_VAL(layer));
@@ -1634,7 +2119,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_INTENT) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_INTENT): ;
+      ObjString* name = OPERAND_STRING();
       uint32_t pCount = 0;
       pCount |= ((uint32_t)*ip++);
       pCount |= ((uint32_t)*ip++ << 8);
@@ -1646,7 +2132,8 @@ static InterpretResult run(VM* pvm) {
   }
   
   CASE_OP(OP_RESOLVER) {
-      ObjString* name = READ_STRING();
+      INDEX_OPERAND(OP_RESOLVER): ;
+      ObjString* name = OPERAND_STRING();
       uint32_t targetConst = 0;
       targetConst |= ((uint32_t)*ip++);
       targetConst |= ((uint32_t)*ip++ << 8);
@@ -1696,6 +2183,7 @@ static InterpretResult run(VM* pvm) {
 
 #undef READ_BYTE
 #undef READ_SHORT
+#undef READ_TRIPLE
 #undef READ_CONSTANT
 #undef READ_STRING
 #undef PUSH
@@ -1703,48 +2191,89 @@ static InterpretResult run(VM* pvm) {
 #undef CASE_OP
 }
 
-InterpretResult interpretAST(VM* pvm, StmtList* statements) {
-  // Disable GC during compilation to prevent freeing unrooted function/constants
-  size_t oldNextGC = pvm->nextGC;
-  pvm->nextGC = (size_t)-1; // SIZE_MAX
-
+ObjFunction* compileAST(VM* pvm, StmtList* statements) {
+  (void)pvm;
+  // The generator roots the functions it is building and the arena roots
+  // the AST's literals, so collections may run while compiling.
   ObjFunction* function = newFunction();
   
   // Connect the AST-based bytecode generator
   if (!generateBytecode(statements, function)) {
-      pvm->nextGC = oldNextGC;
-      return INTERPRET_COMPILE_ERROR;
+      return NULL;
   }
   
-  // printf("DEBUG: Generated bytecode. Function: %p\n", function);
   if (function->chunk.code == NULL) {
       fprintf(stderr, "Fatal Error: Bytecode generation produced NULL chunk code.\n");
-      pvm->nextGC = oldNextGC;
-      return INTERPRET_COMPILE_ERROR;
-  } else {
-      // printf("DEBUG: Chunk code size: %d\n", function->chunk.count);
+      return NULL;
   }
+  return function;
+}
 
-  
+InterpretResult interpretFunction(VM* pvm, ObjFunction* function) {
   // Setup for execution
   push(pvm, OBJ_VAL(function));
   ObjClosure* closure = newClosure(function);
   pop(pvm);
   push(pvm, OBJ_VAL(closure));
   
-  // Restore GC
-  pvm->nextGC = oldNextGC;
-  
   CallFrame* frame = &pvm->frames[pvm->frameCount++];
   frame->closure = closure;
   frame->ip = function->chunk.code;
-  frame->slots = pvm->stack;
+  // Slot 0 is the closure itself; earlier scripts may still have values
+  // on the stack below it.
+  frame->slots = pvm->stackTop - 1;
 
-  // printf("DEBUG: Starting execution...\n");
-  InterpretResult result = run(pvm);
-  // printf("DEBUG: Execution finished with result: %d\n", result);
+  return run(pvm);
+}
 
-  return result;
+bool vmCallValue(VM* pvm, Value callee, int argCount, Value* args, Value* result) {
+  Value* base = pvm->stackTop;
+  int frameCount = pvm->frameCount;
+  int frameBase = pvm->frameBase;
+  if (base + argCount + 1 > pvm->stack + STACK_MAX) {
+    pvm->nativeCallDepth++;
+    runtimeError(pvm, "Stack overflow.");
+    pvm->nativeCallDepth--;
+    return false;
+  }
+
+  // 'args' may point into the stack or a list the callee changes, so copy
+  // them into the callee's slots before anything runs
+  base[0] = callee;
+  for (int i = 0; i < argCount; i++) base[i + 1] = args[i];
+  pvm->stackTop = base + argCount + 1;
+
+  // The nested run() installs its own handler target; the caller's must be
+  // back in place before control returns to it
+  jmp_buf outerJump;
+  memcpy(outerJump, pvm->exceptionJump, sizeof(jmp_buf));
+  pvm->nativeCallDepth++;
+  pvm->frameBase = frameCount;
+
+  bool ok = callValue(callee, argCount, pvm);
+  if (ok && pvm->frameCount > frameCount) {
+    ok = run(pvm) == INTERPRET_OK;
+    if (ok) *result = *pvm->stackTop;
+  } else if (ok) {
+    *result = pvm->stackTop[-1];
+  }
+
+  pvm->frameBase = frameBase;
+  pvm->nativeCallDepth--;
+  memcpy(pvm->exceptionJump, outerJump, sizeof(jmp_buf));
+  if (!ok) {
+    // Frames the error abandoned may still have captured slots open
+    closeUpvalues(pvm, base);
+    pvm->frameCount = frameCount;
+  }
+  pvm->stackTop = base;
+  return ok;
+}
+
+InterpretResult interpretAST(VM* pvm, StmtList* statements) {
+  ObjFunction* function = compileAST(pvm, statements);
+  if (function == NULL) return INTERPRET_COMPILE_ERROR;
+  return interpretFunction(pvm, function);
 }
 
 InterpretResult interpret(VM* pvm, const char* source) {
@@ -1775,6 +2304,22 @@ void defineNative(VM* pvm, const char* name, NativeFn function) {
   pop(pvm);
 }
 
+void defineNatives(VM* pvm, const NativeDef* natives) {
+  for (const NativeDef* native = natives; native->name != NULL; native++) {
+    defineNative(pvm, native->name, native->function);
+  }
+}
+
+void defineModuleNatives(VM* pvm, ObjModule* module, const NativeDef* natives) {
+  for (const NativeDef* native = natives; native->name != NULL; native++) {
+    push(pvm, OBJ_VAL(copyString(native->name, (int)strlen(native->name))));
+    push(pvm, OBJ_VAL(newNative(native->function)));
+    tableSet(&module->exports, AS_STRING(pvm->stackTop[-2]), pvm->stackTop[-1]);
+    pop(pvm);
+    pop(pvm);
+  }
+}
+
 InterpretResult interpretChunk(VM* pvm, Chunk* chunk) {
     // Wrap the raw chunk into a function/closure
     ObjFunction* function = newFunction();
@@ -5,6 +5,7 @@
 //   Copyright © 2025. ProXentix India Pvt. Ltd.  All rights reserved.
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 
@@ -17,37 +18,161 @@
 
 
 void closeUpvalues(VM *pVM, Value *last) {
-  while (pVM->openUpvalues != NULL &&
-         pVM->openUpvalues->location >= last) {
-    ObjUpvalue *upvalue = pVM->openUpvalues;
+  int from = (int)(last - pVM->stack);
+  for (int i = from; i < pVM->openUpvalueTop; i++) {
+    ObjUpvalue *upvalue = pVM->openUpvalues[i];
+    if (upvalue == NULL) continue;
     upvalue->closed = *upvalue->location;
     upvalue->location = &upvalue->closed;
-    pVM->openUpvalues = upvalue->next;
+    pVM->openUpvalues[i] = NULL;
   }
+  if (from < pVM->openUpvalueTop) pVM->openUpvalueTop = from;
 }
 
 ObjUpvalue *captureUpvalue(Value *local, VM *pVM) {
-  ObjUpvalue *prevUpvalue = NULL;
-  ObjUpvalue *upvalue = pVM->openUpvalues;
-  while (upvalue != NULL && upvalue->location > local) {
-    prevUpvalue = upvalue;
-    upvalue = upvalue->next;
+  int slot = (int)(local - pVM->stack);
+  if (pVM->openUpvalues[slot] != NULL) {
+    return pVM->openUpvalues[slot];
   }
 
-  if (upvalue != NULL && upvalue->location == local) {
-    return upvalue;
+  ObjUpvalue *createdUpvalue = newUpvalue(local);
+  pVM->openUpvalues[slot] = createdUpvalue;
+  if (slot >= pVM->openUpvalueTop) pVM->openUpvalueTop = slot + 1;
+  return createdUpvalue;
+}
+
+// Storage for the closure created in one stack slot. Its upvalue cells are
+// never in the open-upvalue table: they point straight at slots of the
+// creating frame, which outlives the closure.
+typedef struct StackClosure {
+  ObjClosure closure;
+  int capacity;
+  ObjUpvalue *cells;
+  int captureCapacity;
+} StackClosure;
+
+ObjClosure *newStackClosure(VM *pVM, ObjFunction *function, Value *slot) {
+  if (pVM->stackClosures == NULL) {
+    pVM->stackClosures = (StackClosure **)calloc(STACK_MAX, sizeof(StackClosure *));
+    if (pVM->stackClosures == NULL) return newClosure(function);
+  }
+  int index = (int)(slot - pVM->stack);
+  StackClosure *block = pVM->stackClosures[index];
+  if (block == NULL) {
+    block = (StackClosure *)calloc(1, sizeof(StackClosure));
+    if (block == NULL) return newClosure(function);
+    pVM->stackClosures[index] = block;
+    if (index >= pVM->stackClosureLimit) pVM->stackClosureLimit = index + 1;
+  }
+  if (block->capacity < function->upvalueCount) {
+    int capacity = function->upvalueCount;
+    ObjUpvalue **upvalues = (ObjUpvalue **)realloc(block->closure.upvalues, sizeof(ObjUpvalue *) * capacity);
+    if (upvalues == NULL) return newClosure(function);
+    block->closure.upvalues = upvalues;
+    ObjUpvalue *cells = (ObjUpvalue *)realloc(block->cells, sizeof(ObjUpvalue) * capacity);
+    if (cells == NULL) return newClosure(function);
+    block->cells = cells;
+    block->capacity = capacity;
+  }
+  if (block->captureCapacity < function->captureCount) {
+    int capacity = function->captureCount;
+    Value *captures = (Value *)realloc(block->closure.captures, sizeof(Value) * capacity);
+    if (captures == NULL) return newClosure(function);
+    block->closure.captures = captures;
+    block->captureCapacity = capacity;
   }
 
-  ObjUpvalue *createdUpvalue = newUpvalue(local);
-  createdUpvalue->next = upvalue;
+  ObjClosure *closure = &block->closure;
+  closure->obj.type = OBJ_CLOSURE;
+  closure->obj.isMarked = false;
+  closure->obj.next = NULL;
+  closure->function = function;
+  closure->upvalueCount = function->upvalueCount;
+  closure->onStack = true;
+  closure->promoted = NULL;
+  closure->captureCount = function->captureCount;
+  for (int i = 0; i < closure->upvalueCount; i++) {
+    closure->upvalues[i] = NULL;
+  }
+  for (int i = 0; i < closure->captureCount; i++) {
+    closure->captures[i] = NIL_VAL;
+  }
+  return closure;
+}
 
-  if (prevUpvalue == NULL) {
-    pVM->openUpvalues = createdUpvalue;
-  } else {
-    prevUpvalue->next = createdUpvalue;
+void stackUpvalue(ObjClosure *closure, int index, Value *location) {
+  ObjUpvalue *cell = &((StackClosure *)closure)->cells[index];
+  cell->obj.type = OBJ_UPVALUE;
+  cell->obj.isMarked = false;
+  cell->obj.next = NULL;
+  cell->location = location;
+  cell->closed = NIL_VAL;
+  closure->upvalues[index] = cell;
+}
+
+ObjClosure *promoteClosure(VM *pVM, ObjClosure *closure) {
+  if (!closure->onStack) return closure;
+  if (closure->promoted != NULL) return closure->promoted;
+
+  // The stack closure is still reachable from its slot and keeps the copy
+  // alive (see blackenObject()) while its upvalues are captured
+  ObjClosure *copy = newClosure(closure->function);
+  closure->promoted = copy;
+  StackClosure *block = (StackClosure *)closure;
+  for (int i = 0; i < closure->upvalueCount; i++) {
+    ObjUpvalue *upvalue = closure->upvalues[i];
+    if (upvalue == &block->cells[i]) {
+      copy->upvalues[i] = captureUpvalue(upvalue->location, pVM);
+    } else {
+      copy->upvalues[i] = upvalue; // Shared with the enclosing closure
+    }
   }
+  for (int i = 0; i < closure->captureCount; i++) {
+    copy->captures[i] = closure->captures[i];
+  }
+  return copy;
+}
 
-  return createdUpvalue;
+void guardStackArgs(VM *pVM, int argCount) {
+  Value callee = pVM->stackTop[-argCount - 1];
+  uint32_t retained = UINT32_MAX; // Natives, classes: assume they keep everything
+  if (IS_CLOSURE(callee)) {
+    retained = AS_CLOSURE(callee)->function->retainedParams;
+  } else if (IS_BOUND_METHOD(callee)) {
+    retained = AS_BOUND_METHOD(callee)->method->function->retainedParams;
+  }
+
+  for (int i = 0; i < argCount; i++) {
+    Value *arg = &pVM->stackTop[i - argCount];
+    if (!IS_CLOSURE(*arg) || !AS_CLOSURE(*arg)->onStack) continue;
+    if (!(retained & (1u << (i < 31 ? i : 31)))) continue;
+    *arg = OBJ_VAL(promoteClosure(pVM, AS_CLOSURE(*arg)));
+  }
+}
+
+void unmarkStackClosures(VM *pVM) {
+  for (int i = 0; i < pVM->stackClosureLimit; i++) {
+    StackClosure *block = pVM->stackClosures[i];
+    if (block == NULL) continue;
+    block->closure.obj.isMarked = false;
+    for (int c = 0; c < block->capacity; c++) {
+      block->cells[c].obj.isMarked = false;
+    }
+  }
+}
+
+void freeStackClosures(VM *pVM) {
+  for (int i = 0; i < pVM->stackClosureLimit; i++) {
+    StackClosure *block = pVM->stackClosures[i];
+    if (block == NULL) continue;
+    free(block->closure.upvalues);
+    free(block->cells);
+    free(block->closure.captures);
+    free(block);
+  }
+  free(pVM->stackClosures);
+  pVM->stackClosures = NULL;
+  pVM->stackClosureLimit = 0;
 }
 
 void defineMethod(ObjString *name, VM *pVM) {
@@ -118,6 +243,10 @@ bool callValue(Value callee, int argCount, VM *pVM) {
       NativeFn native = AS_NATIVE(callee);
       Value result = native(argCount, pVM->stackTop - argCount);
       pVM->stackTop -= argCount + 1;
+      if (pVM->nativeErrorPending) {
+        raiseNativeError(pVM);
+        return false;
+      }
       push(pVM, result);
       return true;
     }
@@ -7,12 +7,15 @@
 
 /*
  * ProXPL Standard Library - Buffer Module
- * Binary buffer: alloc, read/write bytes, hex dump.
+ * Binary buffer: alloc, read/write bytes and typed values, zero-copy
+ * slices, bulk copy/fill/find, hex dump.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <math.h>
 
 #include "../../include/common.h"
 #include "../../include/vm.h"
@@ -21,117 +24,134 @@
 
 extern VM vm;
 
-// Internal buffer structure stored inside ObjForeign->library pointer
-typedef struct {
-    uint8_t* data;
-    int      size;
-    int      capacity;
-} ProxBuffer;
-
-// Helper: create / resize
-static ProxBuffer* buf_new(int capacity) {
-    ProxBuffer* b = (ProxBuffer*)malloc(sizeof(ProxBuffer));
-    if (!b) return NULL;
-    b->data = (uint8_t*)calloc(capacity, 1);
-    b->size = 0;
-    b->capacity = capacity;
-    return b;
+static ObjBuffer* bufferArg(int argCount, Value* args, int index) {
+    if (argCount <= index || !IS_BUFFER(args[index])) return NULL;
+    return AS_BUFFER(args[index]);
 }
 
-#if 0
-static void buf_free_cb(void* ptr) {
-    if (!ptr) return;
-    ProxBuffer* b = (ProxBuffer*)ptr;
-    free(b->data);
-    free(b);
+// Optional integer argument; false if present but not a number
+static bool intArg(int argCount, Value* args, int index, int fallback, int* out) {
+    if (argCount <= index || IS_NIL(args[index])) {
+        *out = fallback;
+        return true;
+    }
+    if (!IS_NUMBER(args[index])) return false;
+    double value = AS_NUMBER(args[index]);
+    if (!(value >= INT_MIN && value <= INT_MAX)) return false;
+    *out = (int)value;
+    return true;
 }
-#endif
 
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn fn) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(fn)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
+// Bytes [offset, offset + length) for writing. A write may start anywhere
+// up to the current size; running past the end grows an owned buffer.
+static uint8_t* writableRange(ObjBuffer* b, int offset, int length) {
+    if (b->readOnly || offset < 0 || length < 0 || offset > bufferLength(b)) return NULL;
+    if (length > INT_MAX - offset) return NULL;
+    int end = offset + length;
+    if (end > bufferLength(b)) {
+        if (!bufferReserve(b, end)) return NULL;
+        b->size = end;
+    }
+    return bufferBytes(b) + offset;
 }
 
-// buffer.alloc(size) -> Buffer
+static Value stringOf(const uint8_t* bytes, int length) {
+    if (length <= 0) return OBJ_VAL(copyString("", 0));
+    return OBJ_VAL(copyString((const char*)bytes, length));
+}
+
+// buffer.alloc(capacity) -> Buffer (empty, with room for 'capacity' bytes)
 static Value native_buf_alloc(int argCount, Value* args) {
     int sz = (argCount >= 1 && IS_NUMBER(args[0])) ? (int)AS_NUMBER(args[0]) : 64;
     if (sz <= 0) sz = 64;
-    ProxBuffer* b = buf_new(sz);
-    if (!b) return NIL_VAL;
-    ObjString* tag = copyString("Buffer", 6);
-    push(&vm, OBJ_VAL(tag));
-    ObjForeign* f = newForeign(tag, (void*)b, NULL);
-    pop(&vm);
-    return OBJ_VAL(f);
+    return OBJ_VAL(newBuffer(sz));
 }
 
-// buffer.write_byte(buf, byte) -> nil
+// buffer.from_string(str) -> Buffer holding the string's bytes
+static Value native_buf_from_string(int argCount, Value* args) {
+    if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
+    ObjString* s = AS_STRING(args[0]);
+    ObjBuffer* b = newBuffer(s->length);
+    if (s->length > 0) memcpy(b->data, s->chars, s->length);
+    b->size = s->length;
+    return OBJ_VAL(b);
+}
+
+// buffer.write_byte(buf, byte) -> nil (appends)
 static Value native_buf_write_byte(int argCount, Value* args) {
-    if (argCount < 2 || !IS_FOREIGN(args[0]) || !IS_NUMBER(args[1])) return NIL_VAL;
-    ProxBuffer* b = (ProxBuffer*)AS_FOREIGN(args[0])->library;
-    uint8_t byte = (uint8_t)((int)AS_NUMBER(args[1]) & 0xFF);
-    if (b->size >= b->capacity) {
-        b->capacity *= 2;
-        b->data = (uint8_t*)realloc(b->data, b->capacity);
-    }
-    b->data[b->size++] = byte;
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b || argCount < 2 || !IS_NUMBER(args[1])) return NIL_VAL;
+    uint8_t* at = writableRange(b, bufferLength(b), 1);
+    if (at) *at = (uint8_t)((int)AS_NUMBER(args[1]) & 0xFF);
     return NIL_VAL;
 }
 
-// buffer.read_byte(buf, index) -> number
+// buffer.read_byte(buf, index) -> number, or -1 out of range
 static Value native_buf_read_byte(int argCount, Value* args) {
-    if (argCount < 2 || !IS_FOREIGN(args[0]) || !IS_NUMBER(args[1])) return NUMBER_VAL(-1);
-    ProxBuffer* b = (ProxBuffer*)AS_FOREIGN(args[0])->library;
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b || argCount < 2 || !IS_NUMBER(args[1])) return NUMBER_VAL(-1);
     int idx = (int)AS_NUMBER(args[1]);
-    if (idx < 0 || idx >= b->size) return NUMBER_VAL(-1);
-    return NUMBER_VAL((double)b->data[idx]);
+    if (idx < 0 || idx >= bufferLength(b)) return NUMBER_VAL(-1);
+    return NUMBER_VAL((double)bufferBytes(b)[idx]);
 }
 
 // buffer.size(buf) -> number
 static Value native_buf_size(int argCount, Value* args) {
-    if (argCount < 1 || !IS_FOREIGN(args[0])) return NUMBER_VAL(0);
-    ProxBuffer* b = (ProxBuffer*)AS_FOREIGN(args[0])->library;
-    return NUMBER_VAL((double)b->size);
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b) return NUMBER_VAL(0);
+    return NUMBER_VAL((double)bufferLength(b));
 }
 
-// buffer.write_string(buf, str) -> nil
+// buffer.write_string(buf, str | buf) -> nil (appends)
 static Value native_buf_write_str(int argCount, Value* args) {
-    if (argCount < 2 || !IS_FOREIGN(args[0]) || !IS_STRING(args[1])) return NIL_VAL;
-    ProxBuffer* b  = (ProxBuffer*)AS_FOREIGN(args[0])->library;
-    ObjString*  s  = AS_STRING(args[1]);
-    int needed = b->size + s->length;
-    while (b->capacity < needed) {
-        b->capacity *= 2;
-        b->data = (uint8_t*)realloc(b->data, b->capacity);
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b || argCount < 2) return NIL_VAL;
+    if (IS_STRING(args[1])) {
+        ObjString* s = AS_STRING(args[1]);
+        uint8_t* at = writableRange(b, bufferLength(b), s->length);
+        if (at) memcpy(at, s->chars, s->length);
+    } else if (IS_BUFFER(args[1])) {
+        ObjBuffer* src = AS_BUFFER(args[1]);
+        int length = bufferLength(src);
+        // Growing 'b' may move the storage 'src' shares, so find it after
+        uint8_t* at = writableRange(b, bufferLength(b), length);
+        if (at) memmove(at, bufferBytes(src), length);
     }
-    memcpy(b->data + b->size, s->chars, s->length);
-    b->size += s->length;
     return NIL_VAL;
 }
 
-// buffer.to_string(buf) -> string
+// buffer.to_string(buf, start?, length?) -> string
 static Value native_buf_to_string(int argCount, Value* args) {
-    if (argCount < 1 || !IS_FOREIGN(args[0])) return OBJ_VAL(copyString("", 0));
-    ProxBuffer* b = (ProxBuffer*)AS_FOREIGN(args[0])->library;
-    return OBJ_VAL(copyString((const char*)b->data, b->size));
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b) return OBJ_VAL(copyString("", 0));
+    int size = bufferLength(b);
+    int start, length;
+    if (!intArg(argCount, args, 1, 0, &start) || !intArg(argCount, args, 2, size, &length)) {
+        return OBJ_VAL(copyString("", 0));
+    }
+    if (start < 0) start = 0;
+    if (start >= size) return OBJ_VAL(copyString("", 0));
+    if (length > size - start) length = size - start;
+    return stringOf(bufferBytes(b) + start, length);
 }
 
 // buffer.hex_dump(buf) -> string  (like "48 65 6c 6c 6f")
 static Value native_buf_hex_dump(int argCount, Value* args) {
-    if (argCount < 1 || !IS_FOREIGN(args[0])) return OBJ_VAL(copyString("", 0));
-    ProxBuffer* b = (ProxBuffer*)AS_FOREIGN(args[0])->library;
-    if (b->size == 0) return OBJ_VAL(copyString("", 0));
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b) return OBJ_VAL(copyString("", 0));
+    int size = bufferLength(b);
+    if (size == 0) return OBJ_VAL(copyString("", 0));
 
     // Each byte: "XX " = 3 chars, last has no space
-    int outLen = b->size * 3;
+    static const char digits[] = "0123456789abcdef";
+    const uint8_t* bytes = bufferBytes(b);
+    int outLen = size * 3 - 1;
     char* out = (char*)malloc(outLen + 1);
-    for (int i = 0; i < b->size; i++) {
-        sprintf(out + i * 3, "%02x", b->data[i]);
-        if (i < b->size - 1) out[i * 3 + 2] = ' ';
+    if (!out) return NIL_VAL;
+    for (int i = 0; i < size; i++) {
+        out[i * 3] = digits[bytes[i] >> 4];
+        out[i * 3 + 1] = digits[bytes[i] & 0xF];
+        if (i < size - 1) out[i * 3 + 2] = ' ';
     }
     out[outLen] = '\0';
     Value result = OBJ_VAL(copyString(out, outLen));
@@ -139,45 +159,241 @@ static Value native_buf_hex_dump(int argCount, Value* args) {
     return result;
 }
 
-// buffer.clear(buf) -> nil
+// buffer.clear(buf) -> nil. Empties the buffer and keeps its storage.
 static Value native_buf_clear(int argCount, Value* args) {
-    if (argCount < 1 || !IS_FOREIGN(args[0])) return NIL_VAL;
-    ProxBuffer* b = (ProxBuffer*)AS_FOREIGN(args[0])->library;
-    memset(b->data, 0, b->capacity);
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b || b->readOnly || b->owner) return NIL_VAL;
     b->size = 0;
     return NIL_VAL;
 }
 
-// buffer.slice(buf, start, length) -> string
+// buffer.slice(buf, start, length?) -> Buffer sharing buf's storage.
+// Writes through either one are visible in both; nothing is copied.
 static Value native_buf_slice(int argCount, Value* args) {
-    if (argCount < 3 || !IS_FOREIGN(args[0]) || !IS_NUMBER(args[1]) || !IS_NUMBER(args[2])) {
-        return OBJ_VAL(copyString("", 0));
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b) return NIL_VAL;
+    int size = bufferLength(b);
+    int start, length;
+    if (!intArg(argCount, args, 1, 0, &start) || !intArg(argCount, args, 2, size, &length)) return NIL_VAL;
+    if (start < 0) start = 0;
+    if (start > size) start = size;
+    if (length < 0) length = 0;
+    if (length > size - start) length = size - start;
+    return OBJ_VAL(newBufferSlice(b, start, length));
+}
+
+// buffer.copy(dst, dstOffset, src, srcStart?, length?) -> bytes copied, or
+// nil. Overlapping ranges (e.g. within one buffer or its slices) are safe.
+static Value native_buf_copy(int argCount, Value* args) {
+    ObjBuffer* dst = bufferArg(argCount, args, 0);
+    ObjBuffer* src = bufferArg(argCount, args, 2);
+    if (!dst || !src) return NIL_VAL;
+    int srcSize = bufferLength(src);
+    int dstOffset, start, length;
+    if (!intArg(argCount, args, 1, 0, &dstOffset) || !intArg(argCount, args, 3, 0, &start) ||
+        !intArg(argCount, args, 4, srcSize, &length)) {
+        return NIL_VAL;
     }
-    ProxBuffer* b   = (ProxBuffer*)AS_FOREIGN(args[0])->library;
-    int start  = (int)AS_NUMBER(args[1]);
-    int length = (int)AS_NUMBER(args[2]);
+    if (start < 0 || start > srcSize) return NIL_VAL;
+    if (length < 0) length = 0;
+    if (length > srcSize - start) length = srcSize - start;
+
+    uint8_t* to = writableRange(dst, dstOffset, length);
+    if (!to) return NIL_VAL;
+    memmove(to, bufferBytes(src) + start, length);
+    return NUMBER_VAL((double)length);
+}
+
+// buffer.fill(buf, byte, start?, end?) -> nil
+static Value native_buf_fill(int argCount, Value* args) {
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b || b->readOnly || argCount < 2 || !IS_NUMBER(args[1])) return NIL_VAL;
+    int size = bufferLength(b);
+    int start, end;
+    if (!intArg(argCount, args, 2, 0, &start) || !intArg(argCount, args, 3, size, &end)) return NIL_VAL;
     if (start < 0) start = 0;
-    if (start >= b->size) return OBJ_VAL(copyString("", 0));
-    if (start + length > b->size) length = b->size - start;
-    if (length <= 0) return OBJ_VAL(copyString("", 0));
-    return OBJ_VAL(copyString((const char*)(b->data + start), length));
+    if (end > size) end = size;
+    if (start < end) memset(bufferBytes(b) + start, (int)AS_NUMBER(args[1]) & 0xFF, end - start);
+    return NIL_VAL;
 }
 
+// buffer.find(buf, needle, from?) -> index or -1. The needle is a byte
+// value, a string or another buffer.
+static Value native_buf_find(int argCount, Value* args) {
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    if (!b || argCount < 2) return NUMBER_VAL(-1);
+    int size = bufferLength(b);
+    int from;
+    if (!intArg(argCount, args, 2, 0, &from)) return NUMBER_VAL(-1);
+    if (from < 0) from = 0;
+
+    uint8_t byte;
+    const uint8_t* needle;
+    int needleLength;
+    if (IS_NUMBER(args[1])) {
+        byte = (uint8_t)((int)AS_NUMBER(args[1]) & 0xFF);
+        needle = &byte;
+        needleLength = 1;
+    } else if (IS_STRING(args[1])) {
+        needle = (const uint8_t*)AS_CSTRING(args[1]);
+        needleLength = AS_STRING(args[1])->length;
+    } else if (IS_BUFFER(args[1])) {
+        needle = bufferBytes(AS_BUFFER(args[1]));
+        needleLength = bufferLength(AS_BUFFER(args[1]));
+    } else {
+        return NUMBER_VAL(-1);
+    }
+    if (from > size || needleLength > size - from) return NUMBER_VAL(-1);
+    if (needleLength == 0) return NUMBER_VAL((double)from);
+
+    // memchr for the first byte, then confirm the rest
+    const uint8_t* bytes = bufferBytes(b);
+    const uint8_t* at = bytes + from;
+    const uint8_t* last = bytes + size - needleLength;
+    while (at <= last) {
+        at = (const uint8_t*)memchr(at, needle[0], (size_t)(last - at) + 1);
+        if (at == NULL) break;
+        if (memcmp(at + 1, needle + 1, needleLength - 1) == 0) return NUMBER_VAL((double)(at - bytes));
+        at++;
+    }
+    return NUMBER_VAL(-1);
+}
+
+// --------------------------------------------------
+// Typed access: read_<type>(buf, offset, bigEndian?) -> number or nil, and
+// write_<type>(buf, offset, value, bigEndian?) -> bool. Little-endian unless
+// bigEndian is true. Integers written out of range wrap, like write_byte.
+// --------------------------------------------------
+
+typedef enum {
+    BUF_U8, BUF_I8, BUF_U16, BUF_I16, BUF_U32, BUF_I32, BUF_F32, BUF_F64
+} BufferType;
+
+static const int typeWidth[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+
+static bool bigEndianArg(int argCount, Value* args, int index) {
+    return argCount > index && IS_BOOL(args[index]) && AS_BOOL(args[index]);
+}
+
+static Value readTyped(int argCount, Value* args, BufferType type) {
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    int offset;
+    if (!b || argCount < 2 || !intArg(argCount, args, 1, 0, &offset)) return NIL_VAL;
+    int width = typeWidth[type];
+    if (offset < 0 || offset > bufferLength(b) - width) return NIL_VAL;
+
+    const uint8_t* p = bufferBytes(b) + offset;
+    uint64_t bits = 0;
+    if (bigEndianArg(argCount, args, 2)) {
+        for (int i = 0; i < width; i++) bits = (bits << 8) | p[i];
+    } else {
+        for (int i = width - 1; i >= 0; i--) bits = (bits << 8) | p[i];
+    }
+
+    switch (type) {
+        case BUF_U8: case BUF_U16: case BUF_U32: return NUMBER_VAL((double)bits);
+        case BUF_I8:  return NUMBER_VAL((double)(int8_t)bits);
+        case BUF_I16: return NUMBER_VAL((double)(int16_t)bits);
+        case BUF_I32: return NUMBER_VAL((double)(int32_t)bits);
+        case BUF_F32: {
+            uint32_t word = (uint32_t)bits;
+            float f;
+            memcpy(&f, &word, sizeof(f));
+            return NUMBER_VAL((double)f);
+        }
+        case BUF_F64: {
+            double d;
+            memcpy(&d, &bits, sizeof(d));
+            return NUMBER_VAL(d);
+        }
+    }
+    return NIL_VAL;
+}
+
+static Value writeTyped(int argCount, Value* args, BufferType type) {
+    ObjBuffer* b = bufferArg(argCount, args, 0);
+    int offset;
+    if (!b || argCount < 3 || !intArg(argCount, args, 1, 0, &offset) || !IS_NUMBER(args[2])) {
+        return BOOL_VAL(false);
+    }
+    double value = AS_NUMBER(args[2]);
+    int width = typeWidth[type];
+
+    uint64_t bits;
+    if (type == BUF_F32) {
+        float f = (float)value;
+        uint32_t word;
+        memcpy(&word, &f, sizeof(word));
+        bits = word;
+    } else if (type == BUF_F64) {
+        memcpy(&bits, &value, sizeof(bits));
+    } else {
+        bits = value > -9.2e18 && value < 9.2e18 ? (uint64_t)(int64_t)value : 0;
+    }
+
+    uint8_t* p = writableRange(b, offset, width);
+    if (!p) return BOOL_VAL(false);
+    if (bigEndianArg(argCount, args, 3)) {
+        for (int i = width - 1; i >= 0; i--, bits >>= 8) p[i] = (uint8_t)bits;
+    } else {
+        for (int i = 0; i < width; i++, bits >>= 8) p[i] = (uint8_t)bits;
+    }
+    return BOOL_VAL(true);
+}
+
+#define TYPED_ACCESSORS(name, type) \
+    static Value native_buf_read_##name(int argCount, Value* args) { return readTyped(argCount, args, type); } \
+    static Value native_buf_write_##name(int argCount, Value* args) { return writeTyped(argCount, args, type); }
+
+TYPED_ACCESSORS(u8, BUF_U8)
+TYPED_ACCESSORS(i8, BUF_I8)
+TYPED_ACCESSORS(u16, BUF_U16)
+TYPED_ACCESSORS(i16, BUF_I16)
+TYPED_ACCESSORS(u32, BUF_U32)
+TYPED_ACCESSORS(i32, BUF_I32)
+TYPED_ACCESSORS(f32, BUF_F32)
+TYPED_ACCESSORS(f64, BUF_F64)
+
+const NativeDef std_buffer_natives[] = {
+    {"alloc", native_buf_alloc},
+    {"from_string", native_buf_from_string},
+    {"write_byte", native_buf_write_byte},
+    {"read_byte", native_buf_read_byte},
+    {"size", native_buf_size},
+    {"write_string", native_buf_write_str},
+    {"to_string", native_buf_to_string},
+    {"hex_dump", native_buf_hex_dump},
+    {"clear", native_buf_clear},
+    {"slice", native_buf_slice},
+    {"copy", native_buf_copy},
+    {"fill", native_buf_fill},
+    {"find", native_buf_find},
+    {"read_u8", native_buf_read_u8},
+    {"read_i8", native_buf_read_i8},
+    {"read_u16", native_buf_read_u16},
+    {"read_i16", native_buf_read_i16},
+    {"read_u32", native_buf_read_u32},
+    {"read_i32", native_buf_read_i32},
+    {"read_f32", native_buf_read_f32},
+    {"read_f64", native_buf_read_f64},
+    {"write_u8", native_buf_write_u8},
+    {"write_i8", native_buf_write_i8},
+    {"write_u16", native_buf_write_u16},
+    {"write_i16", native_buf_write_i16},
+    {"write_u32", native_buf_write_u32},
+    {"write_i32", native_buf_write_i32},
+    {"write_f32", native_buf_write_f32},
+    {"write_f64", native_buf_write_f64},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_buffer_module() {
     ObjString* name = copyString("std.native.buffer", 17);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
 
-    defineModuleFn(module, "alloc",        native_buf_alloc);
-    defineModuleFn(module, "write_byte",   native_buf_write_byte);
-    defineModuleFn(module, "read_byte",    native_buf_read_byte);
-    defineModuleFn(module, "size",         native_buf_size);
-    defineModuleFn(module, "write_string", native_buf_write_str);
-    defineModuleFn(module, "to_string",    native_buf_to_string);
-    defineModuleFn(module, "hex_dump",     native_buf_hex_dump);
-    defineModuleFn(module, "clear",        native_buf_clear);
-    defineModuleFn(module, "slice",        native_buf_slice);
+    defineModuleNatives(&vm, module, std_buffer_natives);
 
     pop(&vm); // module
     pop(&vm); // name
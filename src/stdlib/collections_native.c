@@ -14,18 +14,11 @@
 #include "../../include/value.h"
 #include "../../include/object.h"
 #include "../../include/memory.h"
+#include "../../include/scheduler.h"
+#include "../../include/sort.h"
 
 extern VM vm;
 
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn fn) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(fn)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // Helper: push list item (avoids GC race)
 static void list_append(ObjList* list, Value val) {
     if (list->capacity < list->count + 1) {
@@ -36,34 +29,59 @@ static void list_append(ObjList* list, Value val) {
     list->items[list->count++] = val;
 }
 
+// Grows a list's storage to hold at least 'capacity' items, so results of
+// known size are allocated once
+static void list_reserve(ObjList* list, int capacity) {
+    if (list->capacity >= capacity) return;
+    int old = list->capacity;
+    list->items = GROW_ARRAY(Value, list->items, old, capacity);
+    list->capacity = capacity;
+}
+
+// A literal made only of numbers, like [3, 1, 2], arrives as a tensor; the
+// functional natives read its elements as numbers
+static bool seq_arg(int argCount, Value* args) {
+    return argCount >= 1 && (IS_LIST(args[0]) || IS_TENSOR(args[0]));
+}
+
+static int seq_count(Value seq) {
+    return IS_LIST(seq) ? AS_LIST(seq)->count : AS_TENSOR(seq)->size;
+}
+
+static Value seq_at(Value seq, int i) {
+    return IS_LIST(seq) ? AS_LIST(seq)->items[i] : NUMBER_VAL(AS_TENSOR(seq)->data[i]);
+}
+
+// Callbacks run through vmCallValue, so closures, bound methods and natives
+// all work. The source list is re-read on every step because a callback may
+// change it. When a callback fails the error is already pending and these
+// return nil for the VM to report.
+
+static bool call1(Value fn, Value a, Value* out) {
+    return vmCallValue(&vm, fn, 1, &a, out);
+}
+
+static bool call2(Value fn, Value a, Value b, Value* out) {
+    Value args[2] = { a, b };
+    return vmCallValue(&vm, fn, 2, args, out);
+}
+
 // ---------- map(list, fn) ----------
 static Value native_col_map(int argCount, Value* args) {
-    if (argCount < 2 || !IS_LIST(args[0])) return NIL_VAL;
-    ObjList* src = AS_LIST(args[0]);
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    Value src = args[0];
     Value fn = args[1];
 
     ObjList* result = newList();
     push(&vm, OBJ_VAL(result));
+    list_reserve(result, seq_count(src));
 
-    for (int i = 0; i < src->count; i++) {
-        Value item = src->items[i];
+    for (int i = 0; i < seq_count(src); i++) {
         Value mapped;
-
-        if (IS_NATIVE(fn)) {
-            mapped = AS_NATIVE(fn)(1, &item);
-        } else {
-            // ProXPL closure – call via stack (simplified)
-            // Push fn, then arg, then call
-            push(&vm, fn);
-            push(&vm, item);
-            // We can't invoke ProXPL closures easily from native without
-            // the interpreter loop, so we store the raw value for now.
-            // A full callValue() integration would require vm loop re-entry.
-            pop(&vm); // item
-            pop(&vm); // fn
-            mapped = item;
+        if (!call1(fn, seq_at(src, i), &mapped)) {
+            pop(&vm);
+            return NIL_VAL;
         }
-
         list_append(result, mapped);
     }
 
@@ -72,46 +90,324 @@ static Value native_col_map(int argCount, Value* args) {
 
 // ---------- filter(list, fn) ----------
 static Value native_col_filter(int argCount, Value* args) {
-    if (argCount < 2 || !IS_LIST(args[0])) return NIL_VAL;
-    ObjList* src = AS_LIST(args[0]);
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    Value src = args[0];
     Value fn = args[1];
 
     ObjList* result = newList();
     push(&vm, OBJ_VAL(result));
 
-    for (int i = 0; i < src->count; i++) {
-        Value item = src->items[i];
-        bool keep = false;
-
-        if (IS_NATIVE(fn)) {
-            Value r = AS_NATIVE(fn)(1, &item);
-            keep = IS_BOOL(r) ? AS_BOOL(r) : !IS_NIL(r);
-        } else {
-            keep = true; // passthrough (ProXPL closure called at higher level)
+    for (int i = 0; i < seq_count(src); i++) {
+        Value item = seq_at(src, i);
+        Value keep;
+        if (!call1(fn, item, &keep)) {
+            pop(&vm);
+            return NIL_VAL;
         }
-
-        if (keep) list_append(result, item);
+        if (!isFalsey(keep)) list_append(result, item);
     }
 
     return pop(&vm);
 }
 
-// ---------- reduce(list, fn, initial) ----------
+// ---------- reduce(list, fn, initial?) ----------
+// Without an initial value the first item starts the accumulator.
 static Value native_col_reduce(int argCount, Value* args) {
-    if (argCount < 3 || !IS_LIST(args[0])) return NIL_VAL;
-    ObjList* src = AS_LIST(args[0]);
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    Value src = args[0];
     Value fn  = args[1];
-    Value acc = args[2];
+    int i = 0;
+    Value acc;
+    if (argCount >= 3) {
+        acc = args[2];
+    } else {
+        if (seq_count(src) == 0) return NIL_VAL;
+        acc = seq_at(src, i++);
+    }
 
-    for (int i = 0; i < src->count; i++) {
-        if (IS_NATIVE(fn)) {
-            Value pair[2] = { acc, src->items[i] };
-            acc = AS_NATIVE(fn)(2, pair);
+    // The accumulator lives in a stack slot so a collection inside the
+    // callback cannot free it
+    push(&vm, acc);
+    for (; i < seq_count(src); i++) {
+        if (!call2(fn, vm.stackTop[-1], seq_at(src, i), &acc)) {
+            pop(&vm);
+            return NIL_VAL;
+        }
+        vm.stackTop[-1] = acc;
+    }
+
+    return pop(&vm);
+}
+
+// ---------- sort(list, cmp?, stable?) / sort_by(list, key) ----------
+// Without a comparator a list of numbers is radix sorted on unboxed doubles
+// and a list of strings is sorted bytewise on cached 8-byte prefixes, so no
+// interpreted code runs however long the list is. A comparator cmp(a, b)
+// returns a negative number (or true) when a goes before b; such sorts are
+// stable by default, which also needs the fewest comparator calls on
+// partly sorted input, and pass stable = false for pdqsort. Items are
+// copied into the result list first and only reordered at the end, so the
+// GC sees every item while a comparator runs.
+
+typedef struct {
+    Value cmp;
+    bool failed;
+} SortCallback;
+
+static bool callback_less(const SortItem* a, const SortItem* b, void* context) {
+    SortCallback* callback = (SortCallback*)context;
+    if (callback->failed) return false;
+    Value r;
+    if (!call2(callback->cmp, a->value, b->value, &r)) {
+        callback->failed = true;
+        return false;
+    }
+    return IS_NUMBER(r) ? AS_NUMBER(r) < 0 : !isFalsey(r);
+}
+
+// Bytewise order with the original position breaking ties, which makes the
+// unstable pdqsort stable for decorated keys
+static bool string_less(const SortItem* a, const SortItem* b, void* context) {
+    (void)context;
+    if (a->key != b->key) return a->key < b->key;
+    if (a->value != b->value) {
+        ObjString* x = AS_STRING(a->value);
+        ObjString* y = AS_STRING(b->value);
+        int n = x->length < y->length ? x->length : y->length;
+        int c = n > 8 ? memcmp(x->chars + 8, y->chars + 8, n - 8) : 0;
+        if (c != 0) return c < 0;
+        if (x->length != y->length) return x->length < y->length;
+    }
+    return a->index < b->index;
+}
+
+static bool all_numbers(Value seq) {
+    if (IS_TENSOR(seq)) return true;
+    ObjList* list = AS_LIST(seq);
+    for (int i = 0; i < list->count; i++) {
+        if (!IS_NUMBER(list->items[i])) return false;
+    }
+    return true;
+}
+
+static bool all_strings(ObjList* list) {
+    for (int i = 0; i < list->count; i++) {
+        if (!IS_STRING(list->items[i])) return false;
+    }
+    return true;
+}
+
+// New list holding the items of a list or tensor, on the VM stack
+static ObjList* sort_copy(Value seq) {
+    int n = seq_count(seq);
+    ObjList* copy = newList();
+    push(&vm, OBJ_VAL(copy));
+    list_reserve(copy, n);
+    for (int i = 0; i < n; i++) copy->items[i] = seq_at(seq, i);
+    copy->count = n;
+    return copy;
+}
+
+// Sorts numbers (or, with indices, the items they key) by radix sort.
+// Returns false when out of memory.
+static bool sort_number_keys(ObjList* keys, uint64_t* sorted, uint32_t* indices) {
+    int n = keys->count;
+    uint64_t* keyScratch = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)n);
+    uint32_t* indexScratch = indices ? (uint32_t*)malloc(sizeof(uint32_t) * (size_t)n) : NULL;
+    if (!keyScratch || (indices && !indexScratch)) {
+        free(keyScratch);
+        free(indexScratch);
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        sorted[i] = sortNumberKey(AS_NUMBER(keys->items[i]));
+        if (indices) indices[i] = (uint32_t)i;
+    }
+    sortRadix(sorted, indices, keyScratch, indexScratch, (size_t)n);
+    free(keyScratch);
+    free(indexScratch);
+    return true;
+}
+
+// Decorates each string with its prefix and position and sorts them
+static SortItem* sort_string_keys(ObjList* keys) {
+    int n = keys->count;
+    SortItem* items = (SortItem*)malloc(sizeof(SortItem) * (size_t)(n > 0 ? n : 1));
+    if (!items) return NULL;
+    for (int i = 0; i < n; i++) {
+        ObjString* s = AS_STRING(keys->items[i]);
+        items[i].key = sortStringPrefix(s->chars, s->length);
+        items[i].value = keys->items[i];
+        items[i].index = (uint32_t)i;
+    }
+    sortPdq(items, (size_t)n, string_less, NULL);
+    return items;
+}
+
+static Value sort_default(ObjList* result) {
+    int n = result->count;
+    if (all_numbers(OBJ_VAL(result))) {
+        uint64_t* sorted = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)(n > 0 ? n : 1));
+        if (!sorted || !sort_number_keys(result, sorted, NULL)) {
+            free(sorted);
+            return NIL_VAL;
+        }
+        for (int i = 0; i < n; i++) result->items[i] = NUMBER_VAL(sortNumberFromKey(sorted[i]));
+        free(sorted);
+        return OBJ_VAL(result);
+    }
+    if (all_strings(result)) {
+        SortItem* items = sort_string_keys(result);
+        if (!items) return NIL_VAL;
+        for (int i = 0; i < n; i++) result->items[i] = items[i].value;
+        free(items);
+        return OBJ_VAL(result);
+    }
+    // Mixed or other values have no default order
+    return NIL_VAL;
+}
+
+static Value sort_with(ObjList* result, Value cmp, bool stable) {
+    size_t n = (size_t)result->count;
+    SortItem* items = (SortItem*)malloc(sizeof(SortItem) * (n > 0 ? n : 1));
+    SortItem* scratch = stable ? (SortItem*)malloc(sizeof(SortItem) * (n / 2 + 1)) : NULL;
+    if (!items || (stable && !scratch)) {
+        free(items);
+        free(scratch);
+        return NIL_VAL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        items[i].key = 0;
+        items[i].value = result->items[i];
+        items[i].index = (uint32_t)i;
+    }
+
+    SortCallback callback = { cmp, false };
+    if (stable) sortTim(items, scratch, n, callback_less, &callback);
+    else sortPdq(items, n, callback_less, &callback);
+
+    if (!callback.failed) {
+        for (size_t i = 0; i < n; i++) result->items[i] = items[i].value;
+    }
+    free(items);
+    free(scratch);
+    return callback.failed ? NIL_VAL : OBJ_VAL(result);
+}
+
+static Value native_col_sort(int argCount, Value* args) {
+    if (!seq_arg(argCount, args)) return NIL_VAL;
+    Value cmp = argCount >= 2 ? args[1] : NIL_VAL;
+    bool stable = argCount < 3 || !isFalsey(args[2]);
+
+    ObjList* result = sort_copy(args[0]);
+    Value sorted = IS_NIL(cmp) ? sort_default(result) : sort_with(result, cmp, stable);
+    pop(&vm);
+    return sorted;
+}
+
+// Calls key once per item (decorate), sorts the keys natively and reorders
+// the items to match (undecorate). The order is stable; keys must be all
+// numbers or all strings.
+static Value native_col_sort_by(int argCount, Value* args) {
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    Value fn = args[1];
+
+    ObjList* result = sort_copy(args[0]);
+    ObjList* keys = newList();
+    push(&vm, OBJ_VAL(keys));
+    list_reserve(keys, result->count);
+    for (int i = 0; i < result->count; i++) {
+        Value key;
+        if (!call1(fn, result->items[i], &key)) {
+            pop(&vm);
+            pop(&vm);
+            return NIL_VAL;
         }
-        // ProXPL closures: high-level wrapper in .prox handles it
+        keys->items[keys->count++] = key;
+    }
+
+    int n = result->count;
+    Value* original = (Value*)malloc(sizeof(Value) * (size_t)(n > 0 ? n : 1));
+    uint32_t* order = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)(n > 0 ? n : 1));
+    bool ok = original && order;
+    if (ok && all_numbers(OBJ_VAL(keys))) {
+        uint64_t* sorted = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)(n > 0 ? n : 1));
+        ok = sorted && sort_number_keys(keys, sorted, order);
+        free(sorted);
+    } else if (ok && all_strings(keys)) {
+        SortItem* items = sort_string_keys(keys);
+        ok = items != NULL;
+        for (int i = 0; ok && i < n; i++) order[i] = items[i].index;
+        free(items);
+    } else {
+        ok = false;
     }
 
-    return acc;
+    if (ok) {
+        memcpy(original, result->items, sizeof(Value) * (size_t)n);
+        for (int i = 0; i < n; i++) result->items[i] = original[order[i]];
+    }
+    free(original);
+    free(order);
+
+    pop(&vm); // keys
+    pop(&vm); // result
+    return ok ? OBJ_VAL(result) : NIL_VAL;
+}
+
+// ---------- group_by(list, fn) -> dictionary of key -> list ----------
+// Keys are strings; numbers and booleans are converted to their text.
+static ObjString* group_key(Value key) {
+    char text[64];
+    if (IS_STRING(key)) return AS_STRING(key);
+    if (IS_NUMBER(key)) {
+        double n = AS_NUMBER(key);
+        if (n == (double)(long long)n) snprintf(text, sizeof(text), "%lld", (long long)n);
+        else snprintf(text, sizeof(text), "%.15g", n);
+    } else if (IS_BOOL(key)) {
+        snprintf(text, sizeof(text), "%s", AS_BOOL(key) ? "true" : "false");
+    } else {
+        return NULL;
+    }
+    return copyString(text, (int)strlen(text));
+}
+
+static Value native_col_group_by(int argCount, Value* args) {
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    Value src = args[0];
+    Value fn = args[1];
+
+    ObjDictionary* groups = newDictionary();
+    push(&vm, OBJ_VAL(groups));
+
+    for (int i = 0; i < seq_count(src); i++) {
+        Value item = seq_at(src, i);
+        Value keyValue;
+        if (!call1(fn, item, &keyValue)) {
+            pop(&vm);
+            return NIL_VAL;
+        }
+        push(&vm, keyValue);
+        ObjString* key = group_key(keyValue);
+        if (key == NULL) {
+            pop(&vm);
+            pop(&vm);
+            return NIL_VAL;
+        }
+        push(&vm, OBJ_VAL(key));
+        Value bucket;
+        if (!tableGet(&groups->items, key, &bucket)) {
+            bucket = OBJ_VAL(newList());
+            push(&vm, bucket);
+            tableSet(&groups->items, key, bucket);
+            pop(&vm);
+        }
+        list_append(AS_LIST(bucket), item);
+        pop(&vm); // key
+        pop(&vm); // key value
+    }
+
+    return pop(&vm);
 }
 
 // ---------- flatten(list) ----------
@@ -214,9 +510,14 @@ static Value native_col_concat(int argCount, Value* args) {
 
 // ---------- sum(list) ----------
 static Value native_col_sum(int argCount, Value* args) {
-    if (argCount < 1 || !IS_LIST(args[0])) return NUMBER_VAL(0);
-    ObjList* list = AS_LIST(args[0]);
+    if (!seq_arg(argCount, args)) return NUMBER_VAL(0);
     double total = 0;
+    if (IS_TENSOR(args[0])) {
+        ObjTensor* tensor = AS_TENSOR(args[0]);
+        for (int i = 0; i < tensor->size; i++) total += tensor->data[i];
+        return NUMBER_VAL(total);
+    }
+    ObjList* list = AS_LIST(args[0]);
     for (int i = 0; i < list->count; i++) {
         if (IS_NUMBER(list->items[i])) total += AS_NUMBER(list->items[i]);
     }
@@ -225,28 +526,26 @@ static Value native_col_sum(int argCount, Value* args) {
 
 // ---------- any(list, fn) ----------
 static Value native_col_any(int argCount, Value* args) {
-    if (argCount < 2 || !IS_LIST(args[0])) return BOOL_VAL(false);
-    ObjList* list = AS_LIST(args[0]);
+    if (argCount < 2 || !seq_arg(argCount, args)) return BOOL_VAL(false);
+    Value list = args[0];
     Value fn = args[1];
-    for (int i = 0; i < list->count; i++) {
-        if (IS_NATIVE(fn)) {
-            Value r = AS_NATIVE(fn)(1, &list->items[i]);
-            if (IS_BOOL(r) && AS_BOOL(r)) return BOOL_VAL(true);
-        }
+    for (int i = 0; i < seq_count(list); i++) {
+        Value r;
+        if (!call1(fn, seq_at(list, i), &r)) return NIL_VAL;
+        if (!isFalsey(r)) return BOOL_VAL(true);
     }
     return BOOL_VAL(false);
 }
 
 // ---------- all(list, fn) ----------
 static Value native_col_all(int argCount, Value* args) {
-    if (argCount < 2 || !IS_LIST(args[0])) return BOOL_VAL(false);
-    ObjList* list = AS_LIST(args[0]);
+    if (argCount < 2 || !seq_arg(argCount, args)) return BOOL_VAL(false);
+    Value list = args[0];
     Value fn = args[1];
-    for (int i = 0; i < list->count; i++) {
-        if (IS_NATIVE(fn)) {
-            Value r = AS_NATIVE(fn)(1, &list->items[i]);
-            if (!IS_BOOL(r) || !AS_BOOL(r)) return BOOL_VAL(false);
-        }
+    for (int i = 0; i < seq_count(list); i++) {
+        Value r;
+        if (!call1(fn, seq_at(list, i), &r)) return NIL_VAL;
+        if (isFalsey(r)) return BOOL_VAL(false);
     }
     return BOOL_VAL(true);
 }
@@ -283,26 +582,225 @@ static Value native_col_count(int argCount, Value* args) {
     return NUMBER_VAL((double)count);
 }
 
+// ---------- par_map / par_filter / par_reduce / par_sum / par_sort ----------
+// Parallel forms of the natives above, with the same results. Work runs on
+// the scheduler's worker threads when it is pure: a callback that is a
+// native marked parallel-safe (the math kernels) over a list of numbers, or
+// numbers and strings with no callback at all. Script callbacks cannot
+// leave the VM thread yet, so they run in order exactly as map/filter/
+// reduce/sort do. Chunk boundaries depend only on the list length, so
+// par_reduce and par_sum give the same result on any number of threads.
+
+#define PAR_CALL_GRAIN 2048
+#define PAR_SUM_GRAIN 16384
+
+typedef struct {
+    Value seq;
+    NativeFn fn;
+    Value initial;
+    Value* out;       // par_map results, par_reduce chunk results
+    bool* keep;       // par_filter flags
+    double* partials; // par_sum chunk totals
+    size_t grain;
+} ParJob;
+
+static bool par_callback(Value fn, Value seq) {
+    return IS_NATIVE(fn) && scheduler_parallel_safe(AS_NATIVE(fn)) && all_numbers(seq);
+}
+
+static void par_map_chunk(size_t begin, size_t end, void* context) {
+    ParJob* job = (ParJob*)context;
+    for (size_t i = begin; i < end; i++) {
+        Value item = seq_at(job->seq, (int)i);
+        job->out[i] = job->fn(1, &item);
+    }
+}
+
+static Value native_col_par_map(int argCount, Value* args) {
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    if (!par_callback(args[1], args[0])) return native_col_map(argCount, args);
+
+    int n = seq_count(args[0]);
+    ObjList* result = newList();
+    push(&vm, OBJ_VAL(result));
+    list_reserve(result, n);
+
+    ParJob job = { args[0], AS_NATIVE(args[1]), NIL_VAL, result->items, NULL, NULL, 0 };
+    scheduler_parallel_for((size_t)n, scheduler_grain((size_t)n, PAR_CALL_GRAIN), par_map_chunk, &job);
+    result->count = n;
+    return pop(&vm);
+}
+
+static void par_filter_chunk(size_t begin, size_t end, void* context) {
+    ParJob* job = (ParJob*)context;
+    for (size_t i = begin; i < end; i++) {
+        Value item = seq_at(job->seq, (int)i);
+        job->keep[i] = !isFalsey(job->fn(1, &item));
+    }
+}
+
+static Value native_col_par_filter(int argCount, Value* args) {
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    if (!par_callback(args[1], args[0])) return native_col_filter(argCount, args);
+
+    int n = seq_count(args[0]);
+    bool* keep = (bool*)malloc(sizeof(bool) * (size_t)(n > 0 ? n : 1));
+    if (keep == NULL) return NIL_VAL;
+    ParJob job = { args[0], AS_NATIVE(args[1]), NIL_VAL, NULL, keep, NULL, 0 };
+    scheduler_parallel_for((size_t)n, scheduler_grain((size_t)n, PAR_CALL_GRAIN), par_filter_chunk, &job);
+
+    ObjList* result = newList();
+    push(&vm, OBJ_VAL(result));
+    for (int i = 0; i < n; i++) {
+        if (keep[i]) list_append(result, seq_at(args[0], i));
+    }
+    free(keep);
+    return pop(&vm);
+}
+
+static void par_reduce_chunk(size_t begin, size_t end, void* context) {
+    ParJob* job = (ParJob*)context;
+    Value pair[2];
+    pair[0] = seq_at(job->seq, (int)begin);
+    for (size_t i = begin + 1; i < end; i++) {
+        pair[1] = seq_at(job->seq, (int)i);
+        pair[0] = job->fn(2, pair);
+    }
+    job->out[begin / job->grain] = pair[0];
+}
+
+// fn must be associative: chunks are reduced on their own and the chunk
+// results are then combined in order
+static Value native_col_par_reduce(int argCount, Value* args) {
+    if (argCount < 2 || !seq_arg(argCount, args)) return NIL_VAL;
+    int n = seq_count(args[0]);
+    if (n == 0 || !par_callback(args[1], args[0])) return native_col_reduce(argCount, args);
+
+    size_t grain = scheduler_grain((size_t)n, PAR_CALL_GRAIN);
+    size_t chunks = ((size_t)n + grain - 1) / grain;
+    Value* partials = (Value*)malloc(sizeof(Value) * chunks);
+    if (partials == NULL) return NIL_VAL;
+    NativeFn fn = AS_NATIVE(args[1]);
+    ParJob job = { args[0], fn, NIL_VAL, partials, NULL, NULL, grain };
+    scheduler_parallel_for((size_t)n, grain, par_reduce_chunk, &job);
+
+    Value pair[2];
+    size_t next = 0;
+    pair[0] = argCount >= 3 ? args[2] : partials[next++];
+    for (; next < chunks; next++) {
+        pair[1] = partials[next];
+        pair[0] = fn(2, pair);
+    }
+    free(partials);
+    return pair[0];
+}
+
+static void par_sum_chunk(size_t begin, size_t end, void* context) {
+    ParJob* job = (ParJob*)context;
+    double total = 0;
+    if (IS_TENSOR(job->seq)) {
+        const double* data = AS_TENSOR(job->seq)->data;
+        for (size_t i = begin; i < end; i++) total += data[i];
+    } else {
+        const Value* items = AS_LIST(job->seq)->items;
+        for (size_t i = begin; i < end; i++) {
+            if (IS_NUMBER(items[i])) total += AS_NUMBER(items[i]);
+        }
+    }
+    job->partials[begin / job->grain] = total;
+}
+
+static Value native_col_par_sum(int argCount, Value* args) {
+    if (!seq_arg(argCount, args)) return NUMBER_VAL(0);
+    size_t n = (size_t)seq_count(args[0]);
+    size_t grain = scheduler_grain(n, PAR_SUM_GRAIN);
+    size_t chunks = (n + grain - 1) / grain;
+    double* partials = (double*)malloc(sizeof(double) * (chunks > 0 ? chunks : 1));
+    if (partials == NULL) return native_col_sum(argCount, args);
+
+    ParJob job = { args[0], NULL, NIL_VAL, NULL, NULL, partials, grain };
+    scheduler_parallel_for(n, grain, par_sum_chunk, &job);
+    double total = 0;
+    for (size_t i = 0; i < chunks; i++) total += partials[i];
+    free(partials);
+    return NUMBER_VAL(total);
+}
+
+// Numbers: parallel radix sort. Strings: chunks sorted in parallel, then
+// merged. With a comparator this is sort().
+static Value native_col_par_sort(int argCount, Value* args) {
+    if (!seq_arg(argCount, args)) return NIL_VAL;
+    if (argCount >= 2 && !IS_NIL(args[1])) return native_col_sort(argCount, args);
+
+    ObjList* result = sort_copy(args[0]);
+    size_t n = (size_t)result->count;
+    bool ok = false;
+    if (all_numbers(OBJ_VAL(result))) {
+        uint64_t* keys = (uint64_t*)malloc(sizeof(uint64_t) * (n > 0 ? n : 1));
+        uint64_t* scratch = (uint64_t*)malloc(sizeof(uint64_t) * (n > 0 ? n : 1));
+        ok = keys && scratch;
+        if (ok) {
+            for (size_t i = 0; i < n; i++) keys[i] = sortNumberKey(AS_NUMBER(result->items[i]));
+            sortRadixParallel(keys, scratch, n);
+            for (size_t i = 0; i < n; i++) result->items[i] = NUMBER_VAL(sortNumberFromKey(keys[i]));
+        }
+        free(keys);
+        free(scratch);
+    } else if (all_strings(result)) {
+        SortItem* items = (SortItem*)malloc(sizeof(SortItem) * (n > 0 ? n : 1));
+        SortItem* scratch = (SortItem*)malloc(sizeof(SortItem) * (n > 0 ? n : 1));
+        ok = items && scratch;
+        if (ok) {
+            for (size_t i = 0; i < n; i++) {
+                ObjString* s = AS_STRING(result->items[i]);
+                items[i].key = sortStringPrefix(s->chars, s->length);
+                items[i].value = result->items[i];
+                items[i].index = (uint32_t)i;
+            }
+            sortParallel(items, scratch, n, string_less, NULL);
+            for (size_t i = 0; i < n; i++) result->items[i] = items[i].value;
+        }
+        free(items);
+        free(scratch);
+    }
+
+    pop(&vm);
+    return ok ? OBJ_VAL(result) : NIL_VAL;
+}
+
+const NativeDef std_collections_natives[] = {
+    {"map", native_col_map},
+    {"filter", native_col_filter},
+    {"reduce", native_col_reduce},
+    {"sort", native_col_sort},
+    {"sort_by", native_col_sort_by},
+    {"group_by", native_col_group_by},
+    {"flatten", native_col_flatten},
+    {"zip", native_col_zip},
+    {"range", native_col_range},
+    {"slice", native_col_slice},
+    {"concat", native_col_concat},
+    {"sum", native_col_sum},
+    {"any", native_col_any},
+    {"all", native_col_all},
+    {"first", native_col_first},
+    {"last", native_col_last},
+    {"count", native_col_count},
+    {"par_map", native_col_par_map},
+    {"par_filter", native_col_par_filter},
+    {"par_reduce", native_col_par_reduce},
+    {"par_sum", native_col_par_sum},
+    {"par_sort", native_col_par_sort},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_collections_module() {
     ObjString* name = copyString("std.native.collections", 22);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
 
-    defineModuleFn(module, "map",     native_col_map);
-    defineModuleFn(module, "filter",  native_col_filter);
-    defineModuleFn(module, "reduce",  native_col_reduce);
-    defineModuleFn(module, "flatten", native_col_flatten);
-    defineModuleFn(module, "zip",     native_col_zip);
-    defineModuleFn(module, "range",   native_col_range);
-    defineModuleFn(module, "slice",   native_col_slice);
-    defineModuleFn(module, "concat",  native_col_concat);
-    defineModuleFn(module, "sum",     native_col_sum);
-    defineModuleFn(module, "any",     native_col_any);
-    defineModuleFn(module, "all",     native_col_all);
-    defineModuleFn(module, "first",   native_col_first);
-    defineModuleFn(module, "last",    native_col_last);
-    defineModuleFn(module, "count",   native_col_count);
+    defineModuleNatives(&vm, module, std_collections_natives);
 
     pop(&vm); // module
     pop(&vm); // name
@@ -176,15 +176,20 @@ static Value native_char_at(int argCount, Value* args) {
 // len(value) - Get length of string or collection
 // len(value) moved to stdlib_core.c
 
+const NativeDef std_convert_natives[] = {
+    {"to_int", native_to_int},
+    {"to_float", native_to_float},
+    {"to_string", native_to_string},
+    {"to_bool", native_to_bool},
+    {"to_hex", native_to_hex},
+    {"to_bin", native_to_bin},
+    {"char_at", native_char_at},
+    {NULL, NULL}
+};
+
 // Register all conversion functions with the VM
 void register_convert_natives(VM* pVM) {
-    defineNative(pVM, "to_int", native_to_int);
-    defineNative(pVM, "to_float", native_to_float);
-    defineNative(pVM, "to_string", native_to_string);
-    defineNative(pVM, "to_bool", native_to_bool);
-    defineNative(pVM, "to_hex", native_to_hex);
-    defineNative(pVM, "to_bin", native_to_bin);
-    defineNative(pVM, "char_at", native_char_at);
+    defineNatives(pVM, std_convert_natives);
     // defineNative(pVM, "len", native_len); // Moved to stdlib_core.c
 }
 
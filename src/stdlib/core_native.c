@@ -16,16 +16,6 @@
 
 extern VM vm;
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // --------------------------------------------------
 // std.core Implementation
 // --------------------------------------------------
@@ -91,15 +81,20 @@ static Value core_unwrap(int argCount, Value* args) {
     return args[0];
 }
 
+const NativeDef std_core_natives[] = {
+    {"assert", core_assert},
+    {"typeOf", core_typeOf},
+    {"unwrap", core_unwrap},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_core_module() {
     ObjString* name = copyString("std.core", 8);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "assert", core_assert);
-    defineModuleFn(module, "typeOf", core_typeOf);
-    defineModuleFn(module, "unwrap", core_unwrap);
+    defineModuleNatives(&vm, module, std_core_natives);
     
     pop(&vm);
     pop(&vm);
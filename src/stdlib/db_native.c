@@ -4,11 +4,14 @@
 // --------------------------------------------------
 
 #include "../../include/object.h"
+#include "../../include/vm.h"
 #include "../../include/value.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+extern VM vm;
+
 static Value native_db_connect(int argCount, Value* args) {
     if (argCount != 1 || !IS_STRING(args[0])) {
         return NULL_VAL;
@@ -25,16 +28,19 @@ static Value native_db_query(int argCount, Value* args) {
     return NULL_VAL; // Dummy result
 }
 
+const NativeDef std_db_natives[] = {
+    {"connect", native_db_connect},
+    {"query", native_db_query},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_db_module() {
     ObjString* name = copyString("std.native.db", 13);
     ObjModule* module = newModule(name);
     
-    // Register native functions
-    ObjString* connectName = copyString("connect", 7);
-    tableSet(&module->exports, connectName, OBJ_VAL(newNative(native_db_connect)));
-    
-    ObjString* queryName = copyString("query", 5);
-    tableSet(&module->exports, queryName, OBJ_VAL(newNative(native_db_query)));
+    push(&vm, OBJ_VAL(module));
+    defineModuleNatives(&vm, module, std_db_natives);
+    pop(&vm);
     
     return module;
 }
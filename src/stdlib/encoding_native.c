@@ -4,34 +4,44 @@
 // --------------------------------------------------
 
 #include "../../include/object.h"
+#include "../../include/vm.h"
 #include "../../include/value.h"
+#include "../../include/json.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+extern VM vm;
+
 static Value native_encoding_jsonEncode(int argCount, Value* args) {
-    // Stub implementation
     if (argCount < 1) return NULL_VAL;
-    ObjString* result = copyString("{}", 2);
-    return OBJ_VAL(result);
+    JsonError error;
+    ObjString* result = jsonStringify(args[0], &error);
+    return result != NULL ? OBJ_VAL(result) : NULL_VAL;
 }
 
 static Value native_encoding_jsonDecode(int argCount, Value* args) {
-    // Stub implementation
     if (argCount < 1 || !IS_STRING(args[0])) return NULL_VAL;
-    return NULL_VAL;
+    ObjString* text = AS_STRING(args[0]);
+    Value result;
+    JsonError error;
+    if (!jsonParse(text->chars, (size_t)text->length, &result, &error)) return NULL_VAL;
+    return result;
 }
 
+const NativeDef std_encoding_natives[] = {
+    {"jsonEncode", native_encoding_jsonEncode},
+    {"jsonDecode", native_encoding_jsonDecode},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_encoding_module() {
     ObjString* name = copyString("std.native.encoding", 19);
     ObjModule* module = newModule(name);
     
-    // Register native functions
-    ObjString* encodeName = copyString("jsonEncode", 10);
-    tableSet(&module->exports, encodeName, OBJ_VAL(newNative(native_encoding_jsonEncode)));
-    
-    ObjString* decodeName = copyString("jsonDecode", 10);
-    tableSet(&module->exports, decodeName, OBJ_VAL(newNative(native_encoding_jsonDecode)));
+    push(&vm, OBJ_VAL(module));
+    defineModuleNatives(&vm, module, std_encoding_natives);
+    pop(&vm);
     
     return module;
 }
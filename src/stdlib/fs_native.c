@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <sys/stat.h>
 #ifdef _WIN32
 #include <direct.h>
@@ -23,6 +24,8 @@
 #else
 #include <unistd.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #ifndef S_ISREG
 #define S_ISREG(m) (((m) & S_IFMT) == S_IFREG)
 #endif
@@ -40,21 +43,13 @@
 // Access VM
 extern VM vm;
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // --------------------------------------------------
 // std.native.fs Implementation
 // --------------------------------------------------
 
 // read_file(path) -> String or Null
+// Reads straight into the string object so a file is held in memory once.
+// Files of 2GB or more do not fit in a string; use open/read_chunk or map.
 static Value fs_read_file(int argCount, Value* args) {
     if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
     
@@ -62,21 +57,19 @@ static Value fs_read_file(int argCount, Value* args) {
     FILE* file = fopen(path, "rb");
     if (!file) return NIL_VAL;
     
-    fseek(file, 0L, SEEK_END);
-    size_t fileSize = ftell(file);
-    rewind(file);
-    
-    char* buffer = (char*)malloc(fileSize + 1);
-    if (!buffer) {
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0 || st.st_size >= INT_MAX) {
         fclose(file);
         return NIL_VAL;
     }
     
-    size_t bytesRead = fread(buffer, 1, fileSize, file);
-    buffer[bytesRead] = '\0';
+    ObjString* string = allocateRawString((int)st.st_size);
+    size_t bytesRead = fread(string->chars, 1, (size_t)st.st_size, file);
     fclose(file);
     
-    return OBJ_VAL(takeString(buffer, (int)bytesRead));
+    // The file may have shrunk since fstat; only what was read counts
+    string->length = (int)bytesRead;
+    return OBJ_VAL(internRawString(string));
 }
 
 // write_file(path, content) -> Bool
@@ -279,28 +272,347 @@ static Value fs_abspath(int argCount, Value* args) {
     return NIL_VAL;
 }
 
+// --------------------------------------------------
+// Streaming file handles
+// --------------------------------------------------
+
+// Size of the read buffer behind read_line/read_chunk and of the stdio
+// buffer that batches writes
+#define FS_STREAM_BUFFER (64 * 1024)
+
+// An open file, stored in ObjForeign->library under the tag "File". Reads
+// go through our own buffer so lines can be found with memchr; writes go
+// through a large stdio buffer so many small writes cost one system call.
+typedef struct {
+    FILE* file;
+    bool writable;
+    char* data;     // Read buffer
+    int start;      // Unconsumed bytes are data[start..end)
+    int end;
+    char* line;     // Holds lines and chunks that span buffer refills
+    int lineLength;
+    int lineCapacity;
+} ProxFile;
+
+static ProxFile* fileArg(Value value) {
+    if (!IS_FOREIGN(value)) return NULL;
+    ObjForeign* f = AS_FOREIGN(value);
+    if (f->name == NULL || f->name->length != 4 || memcmp(f->name->chars, "File", 4) != 0) return NULL;
+    return (ProxFile*)f->library;
+}
+
+static bool refill(ProxFile* file) {
+    file->start = 0;
+    file->end = (int)fread(file->data, 1, FS_STREAM_BUFFER, file->file);
+    return file->end > 0;
+}
+
+static bool appendLine(ProxFile* file, const char* bytes, int length) {
+    if (file->lineLength + length > file->lineCapacity) {
+        int capacity = file->lineCapacity < 256 ? 256 : file->lineCapacity;
+        while (capacity < file->lineLength + length) capacity *= 2;
+        char* line = (char*)realloc(file->line, capacity);
+        if (!line) return false;
+        file->line = line;
+        file->lineCapacity = capacity;
+    }
+    memcpy(file->line + file->lineLength, bytes, length);
+    file->lineLength += length;
+    return true;
+}
+
+static Value lineValue(const char* bytes, int length) {
+    if (length > 0 && bytes[length - 1] == '\r') length--;
+    return OBJ_VAL(copyString(bytes, length));
+}
+
+static bool closeFile(ProxFile* file) {
+    bool ok = fclose(file->file) == 0;
+    free(file->data);
+    free(file->line);
+    free(file);
+    return ok;
+}
+
+// Closes handles that were dropped without fs.close, flushing pending writes
+static void finalizeFile(ObjForeign* foreign) {
+    closeFile((ProxFile*)foreign->library);
+}
+
+// open(path, mode) -> File or Null. Mode is "r" (default), "w" or "a".
+static Value fs_open(int argCount, Value* args) {
+    if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
+    const char* mode = "rb";
+    if (argCount >= 2 && IS_STRING(args[1])) {
+        const char* requested = AS_CSTRING(args[1]);
+        if (strcmp(requested, "w") == 0) mode = "wb";
+        else if (strcmp(requested, "a") == 0) mode = "ab";
+        else if (strcmp(requested, "r") != 0) return NIL_VAL;
+    }
+
+    FILE* handle = fopen(AS_CSTRING(args[0]), mode);
+    if (!handle) return NIL_VAL;
+
+    ProxFile* file = (ProxFile*)calloc(1, sizeof(ProxFile));
+    if (!file) {
+        fclose(handle);
+        return NIL_VAL;
+    }
+    file->file = handle;
+    file->writable = mode[0] != 'r';
+    if (file->writable) {
+        setvbuf(handle, NULL, _IOFBF, FS_STREAM_BUFFER);
+    } else {
+        file->data = (char*)malloc(FS_STREAM_BUFFER);
+        if (!file->data) {
+            fclose(handle);
+            free(file);
+            return NIL_VAL;
+        }
+    }
+
+    ObjString* tag = copyString("File", 4);
+    push(&vm, OBJ_VAL(tag));
+    ObjForeign* foreign = newForeign(tag, (void*)file, NULL);
+    foreign->finalize = finalizeFile;
+    pop(&vm);
+    return OBJ_VAL(foreign);
+}
+
+// read_line(file) -> String without its line ending, or Null at end of file
+static Value fs_read_line(int argCount, Value* args) {
+    ProxFile* file = argCount >= 1 ? fileArg(args[0]) : NULL;
+    if (!file || file->writable) return NIL_VAL;
+
+    file->lineLength = 0;
+    bool any = false;
+    for (;;) {
+        if (file->start == file->end && !refill(file)) break;
+        any = true;
+        char* from = file->data + file->start;
+        int available = file->end - file->start;
+        char* newline = (char*)memchr(from, '\n', available);
+        if (newline == NULL) {
+            if (!appendLine(file, from, available)) return NIL_VAL;
+            file->start = file->end;
+            continue;
+        }
+        int length = (int)(newline - from);
+        file->start += length + 1;
+        // Common case: the whole line is already in the read buffer
+        if (file->lineLength == 0) return lineValue(from, length);
+        if (!appendLine(file, from, length)) return NIL_VAL;
+        break;
+    }
+    if (!any) return NIL_VAL;
+    return lineValue(file->line, file->lineLength);
+}
+
+// read_chunk(file, size, buffer?) -> Number or String
+// With a buffer, replaces its contents with up to 'size' bytes and returns
+// how many were read (0 at end of file), reusing the buffer's storage.
+// Without one, returns the bytes as a string, or Null at end of file.
+static Value fs_read_chunk(int argCount, Value* args) {
+    ProxFile* file = argCount >= 2 ? fileArg(args[0]) : NULL;
+    if (!file || file->writable || !IS_NUMBER(args[1])) return NIL_VAL;
+    double requested = AS_NUMBER(args[1]);
+    if (requested < 1 || requested >= INT_MAX) return NIL_VAL;
+    int size = (int)requested;
+
+    ObjBuffer* buffer = NULL;
+    char* out;
+    if (argCount >= 3) {
+        if (!IS_BUFFER(args[2])) return NIL_VAL;
+        buffer = AS_BUFFER(args[2]);
+        if (!bufferReserve(buffer, size)) return NIL_VAL;
+        out = (char*)bufferBytes(buffer);
+    } else {
+        if (size > file->lineCapacity) {
+            char* line = (char*)realloc(file->line, size);
+            if (!line) return NIL_VAL;
+            file->line = line;
+            file->lineCapacity = size;
+        }
+        out = file->line;
+    }
+
+    // Drain what is already buffered, then read the rest directly
+    int count = file->end - file->start;
+    if (count > size) count = size;
+    memcpy(out, file->data + file->start, count);
+    file->start += count;
+    if (count < size) count += (int)fread(out + count, 1, size - count, file->file);
+
+    if (buffer) {
+        buffer->size = count;
+        return NUMBER_VAL((double)count);
+    }
+    if (count == 0) return NIL_VAL;
+    return OBJ_VAL(copyString(out, count));
+}
+
+// write(file, data) -> Bool. Data is a string or a Buffer.
+static Value fs_write(int argCount, Value* args) {
+    ProxFile* file = argCount >= 2 ? fileArg(args[0]) : NULL;
+    if (!file || !file->writable) return BOOL_VAL(false);
+
+    const void* bytes;
+    size_t length;
+    if (IS_BUFFER(args[1])) {
+        bytes = bufferBytes(AS_BUFFER(args[1]));
+        length = (size_t)bufferLength(AS_BUFFER(args[1]));
+    } else if (IS_STRING(args[1])) {
+        bytes = AS_CSTRING(args[1]);
+        length = (size_t)AS_STRING(args[1])->length;
+    } else {
+        return BOOL_VAL(false);
+    }
+    return BOOL_VAL(fwrite(bytes, 1, length, file->file) == length);
+}
+
+// flush(file) -> Bool
+static Value fs_flush(int argCount, Value* args) {
+    ProxFile* file = argCount >= 1 ? fileArg(args[0]) : NULL;
+    if (!file) return BOOL_VAL(false);
+    return BOOL_VAL(fflush(file->file) == 0);
+}
+
+// close(file) -> Bool. Flushes pending writes; the handle is dead afterwards.
+static Value fs_close(int argCount, Value* args) {
+    ProxFile* file = argCount >= 1 ? fileArg(args[0]) : NULL;
+    if (!file) return BOOL_VAL(false);
+    bool ok = closeFile(file);
+    AS_FOREIGN(args[0])->library = NULL;
+    return BOOL_VAL(ok);
+}
+
+// --------------------------------------------------
+// Memory-mapped views
+// --------------------------------------------------
+
+#ifdef _WIN32
+typedef struct {
+    HANDLE file;
+    HANDLE mapping;
+} WinMapping;
+#endif
+
+// Release hook for mapped views, run by fs.unmap or when the GC frees them
+static void releaseMapping(ObjBuffer* view) {
+#ifdef _WIN32
+    WinMapping* handles = (WinMapping*)view->mapping;
+    UnmapViewOfFile(view->data);
+    CloseHandle(handles->mapping);
+    CloseHandle(handles->file);
+    free(handles);
+#else
+    munmap(view->data, (size_t)view->capacity);
+#endif
+    view->mapping = NULL;
+}
+
+// map(path) -> Buffer or Null
+// Maps the file read-only; pages are loaded on first access, so large files
+// can be scanned with buffer.slice/find/read_* without reading them up
+// front. Views are limited to 2GB, like other buffers.
+static Value fs_map(int argCount, Value* args) {
+    if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
+    const char* path = AS_CSTRING(args[0]);
+
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size >= INT_MAX) return NIL_VAL;
+    if (st.st_size == 0) {
+        ObjBuffer* empty = newBuffer(0);
+        empty->readOnly = true;
+        return OBJ_VAL(empty);
+    }
+
+#ifdef _WIN32
+    WinMapping* handles = (WinMapping*)malloc(sizeof(WinMapping));
+    if (!handles) return NIL_VAL;
+    handles->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handles->file == INVALID_HANDLE_VALUE) {
+        free(handles);
+        return NIL_VAL;
+    }
+    handles->mapping = CreateFileMappingA(handles->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* data = handles->mapping ? MapViewOfFile(handles->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (data == NULL) {
+        if (handles->mapping) CloseHandle(handles->mapping);
+        CloseHandle(handles->file);
+        free(handles);
+        return NIL_VAL;
+    }
+    void* mapping = handles;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NIL_VAL;
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NIL_VAL;
+    void* mapping = data;
+#endif
+
+    ObjBuffer* view = newBuffer(0);
+    view->data = (uint8_t*)data;
+    view->size = (int)st.st_size;
+    view->capacity = view->size;
+    view->readOnly = true;
+    view->release = releaseMapping;
+    view->mapping = mapping;
+    return OBJ_VAL(view);
+}
+
+// unmap(view) -> Bool. The view and slices taken from it are empty
+// afterwards. Views the script drops are unmapped by the GC instead.
+static Value fs_unmap(int argCount, Value* args) {
+    if (argCount < 1 || !IS_BUFFER(args[0])) return BOOL_VAL(false);
+    ObjBuffer* view = AS_BUFFER(args[0]);
+    if (!view->readOnly || view->owner != NULL) return BOOL_VAL(false);
+    if (view->release) view->release(view);
+    view->release = NULL;
+    view->data = NULL;
+    view->size = 0;
+    view->capacity = 0;
+    return BOOL_VAL(true);
+}
+
+const NativeDef std_fs_natives[] = {
+    {"read_file", fs_read_file},
+    {"write_file", fs_write_file},
+    {"append_file", fs_append_file},
+    {"exists", fs_exists},
+    {"remove", fs_remove},
+    {"metadata", fs_metadata},
+    {"mkdir", fs_mkdir},
+    {"rmdir", fs_rmdir},
+    {"listdir", fs_listdir},
+    {"is_file", fs_is_file},
+    {"is_dir", fs_is_dir},
+    {"copy", fs_copy},
+    // New Functions
+    {"move", fs_move},
+    {"abspath", fs_abspath},
+    // Streaming handles and mapped views
+    {"open", fs_open},
+    {"read_line", fs_read_line},
+    {"read_chunk", fs_read_chunk},
+    {"write", fs_write},
+    {"flush", fs_flush},
+    {"close", fs_close},
+    {"map", fs_map},
+    {"unmap", fs_unmap},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_fs_module() {
     ObjString* name = copyString("std.native.fs", 13);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "read_file", fs_read_file);
-    defineModuleFn(module, "write_file", fs_write_file);
-    defineModuleFn(module, "append_file", fs_append_file);
-    defineModuleFn(module, "exists", fs_exists);
-    defineModuleFn(module, "remove", fs_remove);
-    defineModuleFn(module, "metadata", fs_metadata); 
-    defineModuleFn(module, "mkdir", fs_mkdir);
-    defineModuleFn(module, "rmdir", fs_rmdir);
-    defineModuleFn(module, "listdir", fs_listdir);
-    defineModuleFn(module, "is_file", fs_is_file);
-    defineModuleFn(module, "is_dir", fs_is_dir);
-    defineModuleFn(module, "copy", fs_copy);
-    
-    // New Functions
-    defineModuleFn(module, "move", fs_move);
-    defineModuleFn(module, "abspath", fs_abspath);
+    defineModuleNatives(&vm, module, std_fs_natives);
     
     pop(&vm);
     pop(&vm);
@@ -17,16 +17,6 @@
 
 extern VM vm;
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // gc.collect() -> Number (bytes collected)
 static Value native_gc_collect(int argCount, Value* args) {
     (void)argCount; (void)args;
@@ -81,15 +71,20 @@ static Value native_gc_usage(int argCount, Value* args) {
     return NUMBER_VAL((double)vm.bytesAllocated);
 }
 
+const NativeDef std_gc_natives[] = {
+    {"collect", native_gc_collect},
+    {"stats", native_gc_stats}, // Returns List: [bytes, next_gc]
+    {"usage", native_gc_usage},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_gc_module() {
     ObjString* name = copyString("std.native.gc", 13);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "collect", native_gc_collect);
-    defineModuleFn(module, "stats", native_gc_stats); // Returns List: [bytes, next_gc]
-    defineModuleFn(module, "usage", native_gc_usage);
+    defineModuleNatives(&vm, module, std_gc_natives);
 
     pop(&vm);
     pop(&vm);
@@ -5,6 +5,7 @@
 //   Copyright © 2025. ProXentix India Pvt. Ltd.  All rights reserved.
 // --------------------------------------------------
 
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,67 +16,311 @@
 #include "../../include/object.h"
 #include "../../include/md5.h"
 #include "../../include/sha256.h"
+#include "../../include/checksum.h"
 
 extern VM vm;
 
-// Helper
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
+// Chunk size used when hashing a file
+#define HASH_FILE_CHUNK (64 * 1024)
+
+typedef enum {
+    HASH_SHA256,
+    HASH_MD5,
+    HASH_XXH64,
+    HASH_CRC32C
+} HashAlgorithm;
+
+// Incremental hash state, stored in ObjForeign->library under the tag
+// "Hasher". Digests are taken from a copy, so a hasher can keep accepting
+// data after one has been read.
+typedef struct {
+    HashAlgorithm algorithm;
+    uint64_t seed;
+    union {
+        SHA256_CTX sha256;
+        MD5_CTX md5;
+        XXH64_CTX xxh64;
+        uint32_t crc32c;
+    } ctx;
+} Hasher;
+
+static void hasherReset(Hasher* hasher) {
+    switch (hasher->algorithm) {
+        case HASH_SHA256: sha256_init(&hasher->ctx.sha256); break;
+        case HASH_MD5:    MD5_Init(&hasher->ctx.md5); break;
+        case HASH_XXH64:  xxh64_init(&hasher->ctx.xxh64, hasher->seed); break;
+        case HASH_CRC32C: hasher->ctx.crc32c = 0; break;
+    }
 }
 
-// md5(str) -> String
-static Value native_md5(int argCount, Value* args) {
-    if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
-    
-    const char *str = AS_CSTRING(args[0]);
-    unsigned char digest[16];
-    MD5_CTX ctx;
-    MD5_Init(&ctx);
-    MD5_Update(&ctx, (const unsigned char*)str, strlen(str));
-    MD5_Final(digest, &ctx);
-
-    char buffer[33];
-    for(int i = 0; i < 16; i++) {
-        sprintf(&buffer[i*2], "%02x", digest[i]);
+static void hasherUpdate(Hasher* hasher, const uint8_t* data, size_t length) {
+    switch (hasher->algorithm) {
+        case HASH_SHA256: sha256_update(&hasher->ctx.sha256, data, length); break;
+        case HASH_MD5:    MD5_Update(&hasher->ctx.md5, data, length); break;
+        case HASH_XXH64:  xxh64_update(&hasher->ctx.xxh64, data, length); break;
+        case HASH_CRC32C: hasher->ctx.crc32c = crc32c_update(hasher->ctx.crc32c, data, length); break;
     }
-    buffer[32] = '\0';
-    
-    return OBJ_VAL(copyString(buffer, 32));
 }
 
-// sha256(str) -> String
+// Writes the digest bytes and returns how many there are. The integer
+// hashes are written big-endian, matching their usual hex form.
+static int hasherDigest(const Hasher* hasher, uint8_t digest[SHA256_BLOCK_SIZE]) {
+    Hasher copy = *hasher;
+    switch (copy.algorithm) {
+        case HASH_SHA256:
+            sha256_final(&copy.ctx.sha256, digest);
+            return 32;
+        case HASH_MD5:
+            MD5_Final(digest, &copy.ctx.md5);
+            return 16;
+        case HASH_XXH64: {
+            uint64_t value = xxh64_final(&copy.ctx.xxh64);
+            for (int i = 0; i < 8; i++) digest[i] = (uint8_t)(value >> (56 - i * 8));
+            return 8;
+        }
+        case HASH_CRC32C:
+            for (int i = 0; i < 4; i++) digest[i] = (uint8_t)(copy.ctx.crc32c >> (24 - i * 8));
+            return 4;
+    }
+    return 0;
+}
+
+// Strings and buffers are hashed over their full length, NUL bytes included
+static bool bytesArg(Value value, const uint8_t** data, size_t* length) {
+    if (IS_STRING(value)) {
+        *data = (const uint8_t*)AS_STRING(value)->chars;
+        *length = (size_t)AS_STRING(value)->length;
+        return true;
+    }
+    if (IS_BUFFER(value)) {
+        *data = bufferBytes(AS_BUFFER(value));
+        *length = (size_t)bufferLength(AS_BUFFER(value));
+        return true;
+    }
+    return false;
+}
+
+// Algorithm name, defaulting to SHA-256 when absent
+static bool algorithmArg(int argCount, Value* args, int index, HashAlgorithm* out) {
+    if (argCount <= index || IS_NIL(args[index])) {
+        *out = HASH_SHA256;
+        return true;
+    }
+    if (!IS_STRING(args[index])) return false;
+    const char* name = AS_CSTRING(args[index]);
+    if (strcmp(name, "sha256") == 0) *out = HASH_SHA256;
+    else if (strcmp(name, "md5") == 0) *out = HASH_MD5;
+    else if (strcmp(name, "xxh64") == 0) *out = HASH_XXH64;
+    else if (strcmp(name, "crc32c") == 0) *out = HASH_CRC32C;
+    else return false;
+    return true;
+}
+
+static uint64_t seedArg(int argCount, Value* args, int index) {
+    if (argCount <= index || !IS_NUMBER(args[index]) || AS_NUMBER(args[index]) < 0) return 0;
+    return (uint64_t)AS_NUMBER(args[index]);
+}
+
+static Value hexValue(const uint8_t* digest, int length) {
+    static const char digits[] = "0123456789abcdef";
+    char hex[SHA256_BLOCK_SIZE * 2];
+    for (int i = 0; i < length; i++) {
+        hex[i * 2] = digits[digest[i] >> 4];
+        hex[i * 2 + 1] = digits[digest[i] & 0x0F];
+    }
+    return OBJ_VAL(copyString(hex, length * 2));
+}
+
+static Value hashOnce(HashAlgorithm algorithm, uint64_t seed, Value data) {
+    const uint8_t* bytes;
+    size_t length;
+    if (!bytesArg(data, &bytes, &length)) return NIL_VAL;
+    Hasher hasher;
+    hasher.algorithm = algorithm;
+    hasher.seed = seed;
+    hasherReset(&hasher);
+    hasherUpdate(&hasher, bytes, length);
+    uint8_t digest[SHA256_BLOCK_SIZE];
+    return hexValue(digest, hasherDigest(&hasher, digest));
+}
+
+// md5(data) -> String
+static Value native_md5(int argCount, Value* args) {
+    if (argCount < 1) return NIL_VAL;
+    return hashOnce(HASH_MD5, 0, args[0]);
+}
+
+// sha256(data) -> String
 static Value native_sha256(int argCount, Value* args) {
-    if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
-    
-    const char *str = AS_CSTRING(args[0]);
-    unsigned char digest[32];
-    SHA256_CTX ctx;
-    sha256_init(&ctx);
-    sha256_update(&ctx, (const unsigned char*)str, strlen(str));
-    sha256_final(&ctx, digest);
-
-    char buffer[65];
-    for(int i = 0; i < 32; i++) {
-        sprintf(&buffer[i*2], "%02x", digest[i]);
+    if (argCount < 1) return NIL_VAL;
+    return hashOnce(HASH_SHA256, 0, args[0]);
+}
+
+// xxh64(data, seed?) -> 16 hex digits
+static Value native_xxh64(int argCount, Value* args) {
+    if (argCount < 1) return NIL_VAL;
+    return hashOnce(HASH_XXH64, seedArg(argCount, args, 1), args[0]);
+}
+
+// crc32c(data, crc?) -> Number. Pass the previous result to continue a stream.
+static Value native_crc32c(int argCount, Value* args) {
+    const uint8_t* bytes;
+    size_t length;
+    if (argCount < 1 || !bytesArg(args[0], &bytes, &length)) return NIL_VAL;
+    uint32_t crc = argCount >= 2 && IS_NUMBER(args[1]) ? (uint32_t)AS_NUMBER(args[1]) : 0;
+    return NUMBER_VAL((double)crc32c_update(crc, bytes, length));
+}
+
+// sha256_many(list) -> list of SHA-256 digests, one per string or buffer.
+// Independent inputs are hashed side by side where the CPU allows.
+static Value native_sha256_many(int argCount, Value* args) {
+    if (argCount < 1 || !IS_LIST(args[0])) return NIL_VAL;
+    ObjList* inputs = AS_LIST(args[0]);
+    int count = inputs->count;
+
+    const unsigned char** data = (const unsigned char**)malloc(sizeof(unsigned char*) * (count + 1));
+    size_t* lengths = (size_t*)malloc(sizeof(size_t) * (count + 1));
+    unsigned char (*digests)[SHA256_BLOCK_SIZE] = malloc(SHA256_BLOCK_SIZE * (size_t)(count + 1));
+    bool ok = data != NULL && lengths != NULL && digests != NULL;
+    for (int i = 0; ok && i < count; i++) {
+        ok = bytesArg(inputs->items[i], &data[i], &lengths[i]);
     }
-    buffer[64] = '\0';
-    
-    return OBJ_VAL(copyString(buffer, 64));
+
+    Value result = NIL_VAL;
+    if (ok) {
+        sha256_many(data, lengths, count, digests);
+        ObjList* list = newList();
+        push(&vm, OBJ_VAL(list));
+        for (int i = 0; i < count; i++) {
+            Value hex = hexValue(digests[i], SHA256_BLOCK_SIZE);
+            push(&vm, hex);
+            appendToList(list, hex);
+            pop(&vm);
+        }
+        result = pop(&vm);
+    }
+    free(data);
+    free(lengths);
+    free(digests);
+    return result;
+}
+
+// file(path, algorithm?) -> digest of the file's contents, read in chunks
+static Value native_file(int argCount, Value* args) {
+    HashAlgorithm algorithm;
+    if (argCount < 1 || !IS_STRING(args[0]) || !algorithmArg(argCount, args, 1, &algorithm)) return NIL_VAL;
+    FILE* file = fopen(AS_CSTRING(args[0]), "rb");
+    if (!file) return NIL_VAL;
+    uint8_t* chunk = (uint8_t*)malloc(HASH_FILE_CHUNK);
+    if (!chunk) {
+        fclose(file);
+        return NIL_VAL;
+    }
+
+    Hasher hasher;
+    hasher.algorithm = algorithm;
+    hasher.seed = 0;
+    hasherReset(&hasher);
+    size_t n;
+    while ((n = fread(chunk, 1, HASH_FILE_CHUNK, file)) > 0) hasherUpdate(&hasher, chunk, n);
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    free(chunk);
+    if (failed) return NIL_VAL;
+
+    uint8_t digest[SHA256_BLOCK_SIZE];
+    return hexValue(digest, hasherDigest(&hasher, digest));
+}
+
+// --------------------------------------------------
+// Incremental hashers
+// --------------------------------------------------
+
+static Hasher* hasherArg(int argCount, Value* args) {
+    if (argCount < 1 || !IS_FOREIGN(args[0])) return NULL;
+    ObjForeign* f = AS_FOREIGN(args[0]);
+    if (f->name == NULL || f->name->length != 6 || memcmp(f->name->chars, "Hasher", 6) != 0) return NULL;
+    return (Hasher*)f->library;
+}
+
+static void finalizeHasher(ObjForeign* foreign) {
+    free(foreign->library);
+}
+
+// hasher(algorithm?, seed?) -> Hasher. Algorithm is "sha256" (default),
+// "md5", "xxh64" or "crc32c"; the seed applies to xxh64.
+static Value native_hasher(int argCount, Value* args) {
+    HashAlgorithm algorithm;
+    if (!algorithmArg(argCount, args, 0, &algorithm)) return NIL_VAL;
+    Hasher* hasher = (Hasher*)malloc(sizeof(Hasher));
+    if (!hasher) return NIL_VAL;
+    hasher->algorithm = algorithm;
+    hasher->seed = seedArg(argCount, args, 1);
+    hasherReset(hasher);
+
+    ObjString* tag = copyString("Hasher", 6);
+    push(&vm, OBJ_VAL(tag));
+    ObjForeign* foreign = newForeign(tag, (void*)hasher, NULL);
+    foreign->finalize = finalizeHasher;
+    pop(&vm);
+    return OBJ_VAL(foreign);
 }
 
+// update(hasher, data) -> hasher, so calls can be chained
+static Value native_update(int argCount, Value* args) {
+    Hasher* hasher = hasherArg(argCount, args);
+    const uint8_t* bytes;
+    size_t length;
+    if (!hasher || argCount < 2 || !bytesArg(args[1], &bytes, &length)) return NIL_VAL;
+    hasherUpdate(hasher, bytes, length);
+    return args[0];
+}
+
+// digest(hasher, raw?) -> hex String, or a Buffer of the digest bytes when
+// raw is true. The hasher is left as it was.
+static Value native_digest(int argCount, Value* args) {
+    Hasher* hasher = hasherArg(argCount, args);
+    if (!hasher) return NIL_VAL;
+    uint8_t digest[SHA256_BLOCK_SIZE];
+    int length = hasherDigest(hasher, digest);
+    if (argCount >= 2 && IS_BOOL(args[1]) && AS_BOOL(args[1])) {
+        ObjBuffer* buffer = newBuffer(length);
+        memcpy(buffer->data, digest, length);
+        buffer->size = length;
+        return OBJ_VAL(buffer);
+    }
+    return hexValue(digest, length);
+}
+
+// reset(hasher) -> hasher, emptied for reuse with the same algorithm and seed
+static Value native_reset(int argCount, Value* args) {
+    Hasher* hasher = hasherArg(argCount, args);
+    if (!hasher) return NIL_VAL;
+    hasherReset(hasher);
+    return args[0];
+}
+
+const NativeDef std_hash_natives[] = {
+    {"md5", native_md5},
+    {"sha256", native_sha256},
+    {"xxh64", native_xxh64},
+    {"crc32c", native_crc32c},
+    {"sha256_many", native_sha256_many},
+    {"file", native_file},
+    {"hasher", native_hasher},
+    {"update", native_update},
+    {"digest", native_digest},
+    {"reset", native_reset},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_hash_module() {
     ObjString* name = copyString("std.native.hash", 15);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "md5", native_md5);
-    defineModuleFn(module, "sha256", native_sha256);
+    defineModuleNatives(&vm, module, std_hash_natives);
 
     pop(&vm);
     pop(&vm);
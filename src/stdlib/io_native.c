@@ -22,16 +22,6 @@
 
 extern VM vm;
 
-// Helper
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // print_raw(str) - Print string to stdout without newline
 static Value native_print_raw(int argCount, Value* args) {
     if (argCount > 0) {
@@ -126,6 +116,19 @@ static Value native_set_color_raw(int argCount, Value* args) {
     return NIL_VAL;
 }
 
+const NativeDef std_io_natives[] = {
+    {"print_raw", native_print_raw},
+    {"print", native_print_raw},
+    {"write", native_print_raw},
+    {"println", native_println},
+    {"eprint_raw", native_eprint_raw},
+    {"input_raw", native_input_raw},
+    {"input", native_input},
+    {"flush_raw", native_flush_raw},
+    {"set_color_raw", native_set_color_raw},
+    {NULL, NULL}
+};
+
 // Register all I/O functions with the VM
 ObjModule* create_std_io_module() {
     ObjString* name = copyString("std.native.io", 13);
@@ -133,24 +136,21 @@ ObjModule* create_std_io_module() {
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "print_raw", native_print_raw);
-    defineModuleFn(module, "print", native_print_raw);
-    defineModuleFn(module, "write", native_print_raw);
-    defineModuleFn(module, "println", native_println);
-    defineModuleFn(module, "eprint_raw", native_eprint_raw);
-    defineModuleFn(module, "input_raw", native_input_raw);
-    defineModuleFn(module, "input", native_input);
-    defineModuleFn(module, "flush_raw", native_flush_raw);
-    defineModuleFn(module, "set_color_raw", native_set_color_raw);
+    defineModuleNatives(&vm, module, std_io_natives);
 
     pop(&vm); // module
     pop(&vm); // name
     return module;
 }
 
+const NativeDef std_io_globals[] = {
+    {"print", native_print_raw},
+    {"println", native_println},
+    {"input", native_input},
+    {NULL, NULL}
+};
+
 // Register I/O functions as globals (for convenience)
 void register_io_globals(VM* pVM) {
-    defineNative(pVM, "print", native_print_raw);
-    defineNative(pVM, "println", native_println);
-    defineNative(pVM, "input", native_input);
+    defineNatives(pVM, std_io_globals);
 }
@@ -0,0 +1,247 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+/*
+ * ProXPL Standard Library - Iter Module
+ * Lazy pipelines: range, map, filter, take, skip, zip, chain and enumerate
+ * build iterator stages without running anything; next, collect, reduce,
+ * sum and count pull items through them one at a time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/common.h"
+#include "../../include/vm.h"
+#include "../../include/value.h"
+#include "../../include/object.h"
+#include "../../include/iterator.h"
+
+extern VM vm;
+
+// Iterator over 'value', pushed so it stays reachable while the stage that
+// wraps it is allocated; the caller pops it. NULL, with nothing pushed, if
+// 'value' cannot be iterated.
+static ObjIterator* pushIterator(Value value) {
+    ObjIterator* iterator = iteratorOf(value);
+    if (iterator != NULL) push(&vm, OBJ_VAL(iterator));
+    return iterator;
+}
+
+// A stage over args[0] with a callback (map, filter) or count (take, skip)
+static Value wrapSource(int argCount, Value* args, IteratorKind kind) {
+    if (argCount < 2) return NIL_VAL;
+    bool counted = kind == ITER_TAKE || kind == ITER_SKIP;
+    if (counted && (!IS_NUMBER(args[1]) || AS_NUMBER(args[1]) < 0)) return NIL_VAL;
+
+    ObjIterator* source = pushIterator(args[0]);
+    if (source == NULL) return NIL_VAL;
+    ObjIterator* stage = newIterator(kind, OBJ_VAL(source));
+    if (counted) {
+        stage->limit = (int64_t)AS_NUMBER(args[1]);
+    } else {
+        stage->fn = args[1];
+    }
+    pop(&vm);
+    return OBJ_VAL(stage);
+}
+
+// A stage over args[0] and args[1] (zip, chain)
+static Value joinSources(int argCount, Value* args, IteratorKind kind) {
+    if (argCount < 2) return NIL_VAL;
+    ObjIterator* source = pushIterator(args[0]);
+    if (source == NULL) return NIL_VAL;
+    ObjIterator* other = pushIterator(args[1]);
+    if (other == NULL) {
+        pop(&vm);
+        return NIL_VAL;
+    }
+    ObjIterator* stage = newIterator(kind, OBJ_VAL(source));
+    stage->other = OBJ_VAL(other);
+    pop(&vm);
+    pop(&vm);
+    return OBJ_VAL(stage);
+}
+
+// ---------- iter(value) ----------
+static Value native_iter_iter(int argCount, Value* args) {
+    if (argCount < 1) return NIL_VAL;
+    ObjIterator* iterator = iteratorOf(args[0]);
+    return iterator ? OBJ_VAL(iterator) : NIL_VAL;
+}
+
+// ---------- next(iterator, default?) ----------
+static Value native_iter_next(int argCount, Value* args) {
+    if (argCount < 1 || !IS_ITERATOR(args[0])) return NIL_VAL;
+    Value item;
+    if (iteratorNext(AS_ITERATOR(args[0]), &item)) return item;
+    return argCount >= 2 ? args[1] : NIL_VAL;
+}
+
+// ---------- range(stop) / range(start, stop, step?) ----------
+static Value native_iter_range(int argCount, Value* args) {
+    // Trailing nulls count as omitted, as when std.iter's Iter.range(10)
+    // passes its unused parameters along
+    while (argCount > 0 && IS_NIL(args[argCount - 1])) argCount--;
+    double start = 0, stop = 0, step = 1;
+    if (argCount == 1 && IS_NUMBER(args[0])) {
+        stop = AS_NUMBER(args[0]);
+    } else if (argCount >= 2 && IS_NUMBER(args[0]) && IS_NUMBER(args[1])) {
+        start = AS_NUMBER(args[0]);
+        stop  = AS_NUMBER(args[1]);
+        if (argCount >= 3 && IS_NUMBER(args[2])) step = AS_NUMBER(args[2]);
+    } else {
+        return NIL_VAL;
+    }
+    if (step == 0) step = 1;
+
+    ObjIterator* range = newIterator(ITER_RANGE, NIL_VAL);
+    range->start = start;
+    range->stop = stop;
+    range->step = step;
+    return OBJ_VAL(range);
+}
+
+static Value native_iter_map(int argCount, Value* args) {
+    return wrapSource(argCount, args, ITER_MAP);
+}
+
+static Value native_iter_filter(int argCount, Value* args) {
+    return wrapSource(argCount, args, ITER_FILTER);
+}
+
+static Value native_iter_take(int argCount, Value* args) {
+    return wrapSource(argCount, args, ITER_TAKE);
+}
+
+static Value native_iter_skip(int argCount, Value* args) {
+    return wrapSource(argCount, args, ITER_SKIP);
+}
+
+static Value native_iter_zip(int argCount, Value* args) {
+    return joinSources(argCount, args, ITER_ZIP);
+}
+
+static Value native_iter_chain(int argCount, Value* args) {
+    return joinSources(argCount, args, ITER_CHAIN);
+}
+
+// ---------- enumerate(source) ----------
+static Value native_iter_enumerate(int argCount, Value* args) {
+    if (argCount < 1) return NIL_VAL;
+    ObjIterator* source = pushIterator(args[0]);
+    if (source == NULL) return NIL_VAL;
+    ObjIterator* stage = newIterator(ITER_ENUMERATE, OBJ_VAL(source));
+    pop(&vm);
+    return OBJ_VAL(stage);
+}
+
+// ---------- collect(source) ----------
+static Value native_iter_collect(int argCount, Value* args) {
+    if (argCount < 1) return NIL_VAL;
+    ObjIterator* source = pushIterator(args[0]);
+    if (source == NULL) return NIL_VAL;
+    ObjList* result = newList();
+    push(&vm, OBJ_VAL(result));
+
+    Value item;
+    while (iteratorNext(source, &item)) {
+        push(&vm, item);
+        appendToList(result, item);
+        pop(&vm);
+    }
+
+    pop(&vm);
+    pop(&vm);
+    return vm.nativeErrorPending ? NIL_VAL : OBJ_VAL(result);
+}
+
+// ---------- reduce(source, fn, initial) ----------
+static Value native_iter_reduce(int argCount, Value* args) {
+    if (argCount < 3) return NIL_VAL;
+    ObjIterator* source = pushIterator(args[0]);
+    if (source == NULL) return NIL_VAL;
+    // The accumulator lives in a stack slot: advancing the source may
+    // allocate
+    Value* acc = vm.stackTop;
+    push(&vm, args[2]);
+
+    Value item;
+    while (iteratorNext(source, &item)) {
+        Value pair[2] = { *acc, item };
+        if (!vmCallValue(&vm, args[1], 2, pair, acc)) break;
+    }
+
+    Value result = *acc;
+    pop(&vm);
+    pop(&vm);
+    return vm.nativeErrorPending ? NIL_VAL : result;
+}
+
+// ---------- sum(source) ----------
+static Value native_iter_sum(int argCount, Value* args) {
+    if (argCount < 1) return NIL_VAL;
+    ObjIterator* source = pushIterator(args[0]);
+    if (source == NULL) return NIL_VAL;
+
+    double total = 0;
+    bool numeric = true;
+    Value item;
+    while (numeric && iteratorNext(source, &item)) {
+        if (IS_NUMBER(item)) total += AS_NUMBER(item);
+        else numeric = false;
+    }
+
+    pop(&vm);
+    return numeric && !vm.nativeErrorPending ? NUMBER_VAL(total) : NIL_VAL;
+}
+
+// ---------- count(source) ----------
+static Value native_iter_count(int argCount, Value* args) {
+    if (argCount < 1) return NIL_VAL;
+    ObjIterator* source = pushIterator(args[0]);
+    if (source == NULL) return NIL_VAL;
+
+    double count = 0;
+    Value item;
+    while (iteratorNext(source, &item)) count++;
+
+    pop(&vm);
+    return vm.nativeErrorPending ? NIL_VAL : NUMBER_VAL(count);
+}
+
+const NativeDef std_iter_natives[] = {
+    {"iter", native_iter_iter},
+    {"next", native_iter_next},
+    {"range", native_iter_range},
+    {"map", native_iter_map},
+    {"filter", native_iter_filter},
+    {"take", native_iter_take},
+    {"skip", native_iter_skip},
+    {"zip", native_iter_zip},
+    {"chain", native_iter_chain},
+    {"enumerate", native_iter_enumerate},
+    {"collect", native_iter_collect},
+    {"reduce", native_iter_reduce},
+    {"sum", native_iter_sum},
+    {"count", native_iter_count},
+    {NULL, NULL}
+};
+
+ObjModule* create_std_iter_module() {
+    ObjString* name = copyString("std.native.iter", 15);
+    push(&vm, OBJ_VAL(name));
+    ObjModule* module = newModule(name);
+    push(&vm, OBJ_VAL(module));
+
+    defineModuleNatives(&vm, module, std_iter_natives);
+
+    pop(&vm); // module
+    pop(&vm); // name
+    return module;
+}
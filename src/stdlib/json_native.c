@@ -13,69 +13,111 @@
 #include "../../include/vm.h"
 #include "../../include/value.h"
 #include "../../include/object.h"
+#include "../../include/json.h"
 
 extern VM vm;
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
-// parse(str) -> Object (Map/List)
-// Limitation: Missing List/Map native creation API. 
-// Returning dummy or Null for now until Object API is ready.
+// parse(str) -> dictionary, list, string, number, bool or nil
+// Malformed JSON also yields nil.
 static Value native_json_parse(int argCount, Value* args) {
     if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
-    // TODO: Implement JSON parser
-    printf("[WARN] std.native.json.parse is not fully implemented yet.\n");
-    return NIL_VAL; 
+    ObjString* text = AS_STRING(args[0]);
+    Value result;
+    JsonError error;
+    if (!jsonParse(text->chars, (size_t)text->length, &result, &error)) return NIL_VAL;
+    return result;
 }
 
-// stringify(val) -> String
-static Value native_json_stringify(int argCount, Value* args) {
-    if (argCount < 1) return OBJ_VAL(copyString("", 0));
-    
-    // Basic implementation for primitives
-    Value v = args[0];
-    if (IS_NULL(v)) return OBJ_VAL(copyString("null", 4));
-    if (IS_BOOL(v)) {
-        return AS_BOOL(v) ? OBJ_VAL(copyString("true", 4)) : OBJ_VAL(copyString("false", 5));
-    }
-    if (IS_NUMBER(v)) {
-        char buffer[32];
-        snprintf(buffer, 32, "%.14g", AS_NUMBER(v));
-        return OBJ_VAL(copyString(buffer, (int)strlen(buffer)));
-    }
-    if (IS_STRING(v)) {
-        // TODO: Escape string
-        ObjString* s = AS_STRING(v);
-        // Simple wrap in quotes for now
-        int len = s->length + 2;
-        char* buffer = (char*)malloc(len + 1);
-        buffer[0] = '"';
-        memcpy(buffer + 1, s->chars, s->length);
-        buffer[len-1] = '"';
-        buffer[len] = '\0';
-        Value res = OBJ_VAL(takeString(buffer, len));
-        return res;
+// get(str, path) -> the value at 'path' without building the rest of the
+// document. 'path' is "key.0.name" or a list of keys and indices; nil when
+// the path does not exist.
+static Value native_json_get(int argCount, Value* args) {
+    if (argCount < 2 || !IS_STRING(args[0])) return NIL_VAL;
+    ObjString* text = AS_STRING(args[0]);
+
+    int count = 0;
+    JsonPathSegment* path = NULL;
+    char (*numbers)[24] = NULL;
+    if (IS_STRING(args[1])) {
+        ObjString* dotted = AS_STRING(args[1]);
+        if (dotted->length > 0) {
+            count = 1;
+            for (int i = 0; i < dotted->length; i++) {
+                if (dotted->chars[i] == '.') count++;
+            }
+            path = (JsonPathSegment*)malloc(sizeof(JsonPathSegment) * count);
+            if (path == NULL) return NIL_VAL;
+            int segment = 0;
+            int from = 0;
+            for (int i = 0; i <= dotted->length; i++) {
+                if (i == dotted->length || dotted->chars[i] == '.') {
+                    path[segment].chars = dotted->chars + from;
+                    path[segment].length = (size_t)(i - from);
+                    segment++;
+                    from = i + 1;
+                }
+            }
+        }
+    } else if (IS_LIST(args[1]) || IS_TENSOR(args[1])) {
+        // A literal made only of indices, like [1, 0], arrives as a tensor
+        bool isList = IS_LIST(args[1]);
+        count = isList ? AS_LIST(args[1])->count : AS_TENSOR(args[1])->size;
+        path = (JsonPathSegment*)malloc(sizeof(JsonPathSegment) * (count > 0 ? count : 1));
+        numbers = (char (*)[24])malloc(sizeof(*numbers) * (count > 0 ? count : 1));
+        if (path == NULL || numbers == NULL) {
+            free(path);
+            free(numbers);
+            return NIL_VAL;
+        }
+        for (int i = 0; i < count; i++) {
+            Value step = isList ? AS_LIST(args[1])->items[i] : NUMBER_VAL(AS_TENSOR(args[1])->data[i]);
+            if (IS_STRING(step)) {
+                path[i].chars = AS_CSTRING(step);
+                path[i].length = (size_t)AS_STRING(step)->length;
+            } else if (IS_NUMBER(step) && AS_NUMBER(step) >= 0) {
+                int length = snprintf(numbers[i], sizeof(numbers[i]), "%.0f", AS_NUMBER(step));
+                path[i].chars = numbers[i];
+                path[i].length = (size_t)length;
+            } else {
+                free(path);
+                free(numbers);
+                return NIL_VAL;
+            }
+        }
+    } else {
+        return NIL_VAL;
     }
 
-    return OBJ_VAL(copyString("[Object]", 8));
+    Value result;
+    JsonError error;
+    if (!jsonGet(text->chars, (size_t)text->length, path, count, &result, &error)) result = NIL_VAL;
+    free(path);
+    free(numbers);
+    return result;
 }
 
+// stringify(val) -> String, or nil for values nested too deeply (cycles)
+static Value native_json_stringify(int argCount, Value* args) {
+    if (argCount < 1) return OBJ_VAL(copyString("", 0));
+    JsonError error;
+    ObjString* result = jsonStringify(args[0], &error);
+    return result != NULL ? OBJ_VAL(result) : NIL_VAL;
+}
+
+const NativeDef std_json_natives[] = {
+    {"parse", native_json_parse},
+    {"stringify", native_json_stringify},
+    {"get", native_json_get},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_json_module() {
     ObjString* name = copyString("std.native.json", 15);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "parse", native_json_parse);
-    defineModuleFn(module, "stringify", native_json_stringify);
+    defineModuleNatives(&vm, module, std_json_natives);
 
     pop(&vm);
     pop(&vm);
@@ -17,6 +17,7 @@
 #include "vm.h"
 #include "value.h"
 #include "object.h"
+#include "scheduler.h"
 #include <math.h>
 #include <stdlib.h>
 #include <time.h>
@@ -24,16 +25,6 @@
 
 extern VM vm;
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // abs(x) - Absolute value
 static Value native_abs(int argCount, Value* args) {
     if (argCount < 1) return NUMBER_VAL(0);
@@ -168,8 +159,20 @@ static Value native_exp(int argCount, Value* args) {
     return NUMBER_VAL(exp(AS_NUMBER(args[0])));
 }
 
+// The generator is seeded on first use rather than at module creation, so
+// it is still seeded when the module comes from a heap snapshot.
+static bool seeded = false;
+
+static void ensureSeeded() {
+    if (!seeded) {
+        srand((unsigned int)time(NULL));
+        seeded = true;
+    }
+}
+
 // random() - Random number [0, 1)
 static Value native_random(int argCount, Value* args) {
+    ensureSeeded();
     // If no arguments, return float [0.0, 1.0) - Standard behavior
     if (argCount == 0) {
         double random_part = (double)rand() / ((double)RAND_MAX + 1.0);
@@ -211,6 +214,7 @@ static Value native_random(int argCount, Value* args) {
 
 // randint(min, max) - Random integer in [min, max]
 static Value native_randint(int argCount, Value* args) {
+    ensureSeeded();
     if (argCount < 2 || !IS_NUMBER(args[0]) || !IS_NUMBER(args[1])) {
         return NUMBER_VAL(0);
     }
@@ -235,6 +239,7 @@ static Value native_seed(int argCount, Value* args) {
     } else {
         srand((unsigned int)time(NULL));
     }
+    seeded = true;
     return NIL_VAL;
 }
 
@@ -242,6 +247,35 @@ static Value native_seed(int argCount, Value* args) {
 // Tensor Functions (Activation & Utilities)
 // --------------------------------------------------
 
+// Elementwise kernels run in chunks across the scheduler's workers once
+// the tensor is large enough to pay for it
+#define TENSOR_MAP_GRAIN 16384
+
+typedef struct {
+    const double* in;
+    double* out;
+    double (*kernel)(double);
+} TensorMap;
+
+static void tensor_map_chunk(size_t begin, size_t end, void* context) {
+    TensorMap* map = (TensorMap*)context;
+    for (size_t i = begin; i < end; i++) map->out[i] = map->kernel(map->in[i]);
+}
+
+static void tensor_map(ObjTensor* t, ObjTensor* res, double (*kernel)(double)) {
+    TensorMap map = { t->data, res->data, kernel };
+    size_t size = (size_t)t->size;
+    scheduler_parallel_for(size, scheduler_grain(size, TENSOR_MAP_GRAIN), tensor_map_chunk, &map);
+}
+
+static double sigmoid_kernel(double x) {
+    return 1.0 / (1.0 + exp(-x));
+}
+
+static double relu_kernel(double x) {
+    return x > 0 ? x : 0;
+}
+
 // sigmoid(tensor)
 static Value native_sigmoid(int argCount, Value* args) {
     if (argCount < 1 || !IS_TENSOR(args[0])) {
@@ -254,11 +288,7 @@ static Value native_sigmoid(int argCount, Value* args) {
     ObjTensor* t = AS_TENSOR(args[0]);
     ObjTensor* res = newTensor(t->dimCount, t->dims, NULL);
     push(&vm, OBJ_VAL(res));
-    
-    for(int i=0; i<t->size; i++) {
-        res->data[i] = 1.0 / (1.0 + exp(-t->data[i]));
-    }
-    
+    tensor_map(t, res, sigmoid_kernel);
     return pop(&vm);
 }
 
@@ -269,12 +299,7 @@ static Value native_relu(int argCount, Value* args) {
     ObjTensor* t = AS_TENSOR(args[0]);
     ObjTensor* res = newTensor(t->dimCount, t->dims, NULL);
     push(&vm, OBJ_VAL(res));
-    
-    for(int i=0; i<t->size; i++) {
-        double val = t->data[i];
-        res->data[i] = (val > 0) ? val : 0;
-    }
-    
+    tensor_map(t, res, relu_kernel);
     return pop(&vm);
 }
 
@@ -292,11 +317,7 @@ static Value native_tanh(int argCount, Value* args) {
     ObjTensor* t = AS_TENSOR(args[0]);
     ObjTensor* res = newTensor(t->dimCount, t->dims, NULL);
     push(&vm, OBJ_VAL(res));
-    
-    for(int i=0; i<t->size; i++) {
-        res->data[i] = tanh(t->data[i]);
-    }
-    
+    tensor_map(t, res, tanh);
     return pop(&vm);
 }
 
@@ -339,73 +360,89 @@ static Value native_transpose(int argCount, Value* args) {
      return pop(&vm);
 }
 
-// Create std.native.math module
-ObjModule* create_std_math_module() {
-    // Initialize random seed once if needed, or rely on user seeding.
-    // We can seed on module creation.
-    static int seeded = 0;
-    if (!seeded) {
-        srand((unsigned int)time(NULL));
-        seeded = 1;
+// Kernels that only compute on their number arguments, so parallel
+// collection natives may call them from worker threads. The registry lives
+// outside the heap, so initStdLibState runs this again after a restore.
+void register_math_kernels(void) {
+    NativeFn kernels[] = {
+        native_abs, native_ceil, native_floor, native_round, native_max, native_min,
+        native_pow, native_sqrt, native_sin, native_cos, native_tan, native_asin,
+        native_acos, native_atan, native_log, native_exp, native_tanh,
+    };
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        scheduler_mark_parallel_safe(kernels[i]);
     }
+}
 
+const NativeDef std_math_natives[] = {
+    {"abs", native_abs},
+    {"ceil", native_ceil},
+    {"floor", native_floor},
+    {"round", native_round},
+    {"max", native_max},
+    {"min", native_min},
+    {"pow", native_pow},
+    {"sqrt", native_sqrt},
+    {"sin", native_sin},
+    {"cos", native_cos},
+    {"tan", native_tan},
+    {"asin", native_asin},
+    {"acos", native_acos},
+    {"atan", native_atan},
+    {"log", native_log},
+    {"exp", native_exp},
+    {"random", native_random},
+    {"randint", native_randint},
+    {"seed", native_seed},
+    {"sigmoid", native_sigmoid},
+    {"relu", native_relu},
+    {"tanh", native_tanh},
+    {"transpose", native_transpose},
+    {NULL, NULL}
+};
+
+// Create std.native.math module
+ObjModule* create_std_math_module() {
     ObjString* name = copyString("std.native.math", 15);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "abs", native_abs);
-    defineModuleFn(module, "ceil", native_ceil);
-    defineModuleFn(module, "floor", native_floor);
-    defineModuleFn(module, "round", native_round);
-    defineModuleFn(module, "max", native_max);
-    defineModuleFn(module, "min", native_min);
-    defineModuleFn(module, "pow", native_pow);
-    defineModuleFn(module, "sqrt", native_sqrt);
-    defineModuleFn(module, "sin", native_sin);
-    defineModuleFn(module, "cos", native_cos);
-    defineModuleFn(module, "tan", native_tan);
-    defineModuleFn(module, "asin", native_asin);
-    defineModuleFn(module, "acos", native_acos);
-    defineModuleFn(module, "atan", native_atan);
-    defineModuleFn(module, "log", native_log);
-    defineModuleFn(module, "exp", native_exp);
-    defineModuleFn(module, "random", native_random);
-    defineModuleFn(module, "randint", native_randint);
-    defineModuleFn(module, "seed", native_seed);
-    defineModuleFn(module, "sigmoid", native_sigmoid);
-    defineModuleFn(module, "relu", native_relu);
-    defineModuleFn(module, "tanh", native_tanh);
-    defineModuleFn(module, "transpose", native_transpose);
+    defineModuleNatives(&vm, module, std_math_natives);
 
     pop(&vm); // module
     pop(&vm); // name
     return module;
 }
 
+const NativeDef std_math_globals[] = {
+    {"abs", native_abs},
+    {"ceil", native_ceil},
+    {"floor", native_floor},
+    {"round", native_round},
+    {"max", native_max},
+    {"min", native_min},
+    {"pow", native_pow},
+    {"sqrt", native_sqrt},
+    {"sin", native_sin},
+    {"cos", native_cos},
+    {"tan", native_tan},
+    {"asin", native_asin},
+    {"acos", native_acos},
+    {"atan", native_atan},
+    {"log", native_log},
+    {"exp", native_exp},
+    {"random", native_random},
+    {"randint", native_randint},
+    {"seed", native_seed},
+    {"sigmoid", native_sigmoid},
+    {"relu", native_relu},
+    {"tanh", native_tanh},
+    {"transpose", native_transpose},
+    {NULL, NULL}
+};
+
 // Register math functions as globals (for benchmarks/ease of use)
 void register_math_globals(VM* pVM) {
-    defineNative(pVM, "abs", native_abs);
-    defineNative(pVM, "ceil", native_ceil);
-    defineNative(pVM, "floor", native_floor);
-    defineNative(pVM, "round", native_round);
-    defineNative(pVM, "max", native_max);
-    defineNative(pVM, "min", native_min);
-    defineNative(pVM, "pow", native_pow);
-    defineNative(pVM, "sqrt", native_sqrt);
-    defineNative(pVM, "sin", native_sin);
-    defineNative(pVM, "cos", native_cos);
-    defineNative(pVM, "tan", native_tan);
-    defineNative(pVM, "asin", native_asin);
-    defineNative(pVM, "acos", native_acos);
-    defineNative(pVM, "atan", native_atan);
-    defineNative(pVM, "log", native_log);
-    defineNative(pVM, "exp", native_exp);
-    defineNative(pVM, "random", native_random);
-    defineNative(pVM, "randint", native_randint);
-    defineNative(pVM, "seed", native_seed);
-    defineNative(pVM, "sigmoid", native_sigmoid);
-    defineNative(pVM, "relu", native_relu);
-    defineNative(pVM, "tanh", native_tanh);
-    defineNative(pVM, "transpose", native_transpose);
+    defineNatives(pVM, std_math_globals);
 }
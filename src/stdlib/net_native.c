@@ -27,16 +27,6 @@ typedef struct {
 
 static int socket_counter = 1;
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // In a real implementation, these would interact with the OS and the Scheduler.
 // Since we don't have the full Event Loop in this MVP, we simulate "Async" behavior
 // by returning a completed Task or a mock "Promise".
@@ -77,16 +67,30 @@ static Value native_accept(int argCount, Value* args) {
     return OBJ_VAL(task);
 }
 
-// net.read(socket) -> Task<String>
+// net.read(socket, buffer?) -> Task<String>, or Task<Number> when reading
+// into a Buffer, which receives the bytes in place of its contents
 static Value native_read(int argCount, Value* args) {
     // printf("[Net] Async Read...\n");
+    static const char request[] = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    int length = (int)sizeof(request) - 1;
+    Value result;
+    if (argCount >= 2 && IS_BUFFER(args[1])) {
+        ObjBuffer* buffer = AS_BUFFER(args[1]);
+        if (!bufferReserve(buffer, length)) return NIL_VAL;
+        memcpy(bufferBytes(buffer), request, length);
+        buffer->size = length;
+        result = NUMBER_VAL((double)length);
+    } else {
+        result = OBJ_VAL(copyString(request, length));
+    }
+    push(&vm, result);
     ObjTask* task = newTask(NULL, NULL);
     task->completed = true;
-    task->result = OBJ_VAL(copyString("GET / HTTP/1.1\r\nHost: localhost\r\n\r\n", 36));
+    task->result = pop(&vm);
     return OBJ_VAL(task);
 }
 
-// net.write(socket, data) -> Task<Void>
+// net.write(socket, data) -> Task<Void>. Data is a string or a Buffer.
 static Value native_write(int argCount, Value* args) {
     if (argCount < 2) return NIL_VAL;
     // printf("[Net] Async Write: %s\n", AS_CSTRING(args[1]));
@@ -97,16 +101,21 @@ static Value native_write(int argCount, Value* args) {
     return OBJ_VAL(task);
 }
 
+const NativeDef std_net_natives[] = {
+    {"tcp_listener", native_tcp_listener},
+    {"accept", native_accept},
+    {"read", native_read},
+    {"write", native_write},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_net_module() {
     ObjString* name = copyString("std.native.net", 14);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "tcp_listener", native_tcp_listener);
-    defineModuleFn(module, "accept", native_accept);
-    defineModuleFn(module, "read", native_read);
-    defineModuleFn(module, "write", native_write);
+    defineModuleNatives(&vm, module, std_net_natives);
 
     pop(&vm);
     pop(&vm);
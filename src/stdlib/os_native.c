@@ -29,16 +29,6 @@
 
 extern VM vm;
 
-// Helper
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 static void defineModuleConst(ObjModule* module, const char* name, Value value) {
     ObjString* nameObj = copyString(name, (int)strlen(name));
     push(&vm, OBJ_VAL(nameObj));
@@ -97,15 +87,20 @@ static Value native_exec(int argCount, Value* args) {
     return OBJ_VAL(copyString(result, (int)currentLen));
 }
 
+const NativeDef std_os_natives[] = {
+    {"platform", native_platform},
+    {"cpu_count", native_cpu_count},
+    {"exec", native_exec},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_os_module() {
     ObjString* name = copyString("std.native.os", 14);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "platform", native_platform);
-    defineModuleFn(module, "cpu_count", native_cpu_count);
-    defineModuleFn(module, "exec", native_exec);
+    defineModuleNatives(&vm, module, std_os_natives);
     
     defineModuleConst(module, "PLATFORM", OBJ_VAL(copyString(PLATFORM_NAME, strlen(PLATFORM_NAME))));
 
@@ -32,15 +32,6 @@
 
 extern VM vm;
 
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn fn) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(fn)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // Determine if char is a path separator (handle both / and \ on Windows)
 static bool is_sep(char c) {
 #ifdef _WIN32
@@ -249,21 +240,26 @@ static Value native_path_normalize(int argCount, Value* args) {
     return OBJ_VAL(copyString(out, pos));
 }
 
+const NativeDef std_path_natives[] = {
+    {"join", native_path_join},
+    {"dirname", native_path_dirname},
+    {"basename", native_path_basename},
+    {"extname", native_path_extname},
+    {"is_absolute", native_path_is_absolute},
+    {"exists", native_path_exists},
+    {"is_file", native_path_is_file},
+    {"is_dir", native_path_is_dir},
+    {"normalize", native_path_normalize},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_path_module() {
     ObjString* name = copyString("std.native.path", 15);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
 
-    defineModuleFn(module, "join",        native_path_join);
-    defineModuleFn(module, "dirname",     native_path_dirname);
-    defineModuleFn(module, "basename",    native_path_basename);
-    defineModuleFn(module, "extname",     native_path_extname);
-    defineModuleFn(module, "is_absolute", native_path_is_absolute);
-    defineModuleFn(module, "exists",      native_path_exists);
-    defineModuleFn(module, "is_file",     native_path_is_file);
-    defineModuleFn(module, "is_dir",      native_path_is_dir);
-    defineModuleFn(module, "normalize",   native_path_normalize);
+    defineModuleNatives(&vm, module, std_path_natives);
 
     pop(&vm); // module
     pop(&vm); // name
@@ -31,15 +31,6 @@
 
 extern VM vm;
 
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn fn) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(fn)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // process.env_get(name) -> string | nil
 static Value native_env_get(int argCount, Value* args) {
     if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
@@ -118,19 +109,24 @@ static Value native_process_exit(int argCount, Value* args) {
     exit(code);
 }
 
+const NativeDef std_process_natives[] = {
+    {"env_get", native_env_get},
+    {"env_set", native_env_set},
+    {"cwd", native_cwd},
+    {"pid", native_pid},
+    {"cpu_count", native_cpu_count},
+    {"memory_usage", native_memory_usage},
+    {"exit", native_process_exit},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_process_module() {
     ObjString* name = copyString("std.native.process", 18);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
 
-    defineModuleFn(module, "env_get",      native_env_get);
-    defineModuleFn(module, "env_set",      native_env_set);
-    defineModuleFn(module, "cwd",          native_cwd);
-    defineModuleFn(module, "pid",          native_pid);
-    defineModuleFn(module, "cpu_count",    native_cpu_count);
-    defineModuleFn(module, "memory_usage", native_memory_usage);
-    defineModuleFn(module, "exit",         native_process_exit);
+    defineModuleNatives(&vm, module, std_process_natives);
 
     pop(&vm); // module
     pop(&vm); // name
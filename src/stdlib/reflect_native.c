@@ -16,16 +16,6 @@
 
 extern VM vm;
 
-// Helper
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // type_of(val) -> String
 static Value native_type_of(int argCount, Value* args) {
     if (argCount < 1) return NIL_VAL;
@@ -54,13 +44,18 @@ static Value native_type_of(int argCount, Value* args) {
     return OBJ_VAL(copyString("unknown", 7));
 }
 
+const NativeDef std_reflect_natives[] = {
+    {"type_of", native_type_of},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_reflect_module() {
     ObjString* name = copyString("std.native.reflect", 18);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "type_of", native_type_of);
+    defineModuleNatives(&vm, module, std_reflect_natives);
 
     pop(&vm);
     pop(&vm);
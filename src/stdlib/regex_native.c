@@ -0,0 +1,338 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+/*
+ * ProXPL Standard Library - Regex Module
+ * Pattern matching on top of the engine in src/utils/regex_engine.c.
+ * Every function takes the pattern as a string plus an optional flags
+ * string ("i", "m", "s"); an invalid pattern or flag yields nil.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/common.h"
+#include "../../include/vm.h"
+#include "../../include/value.h"
+#include "../../include/object.h"
+#include "../../include/regex_engine.h"
+
+extern VM vm;
+
+// Compiled patterns, keyed by pattern text and flags. Direct-mapped: a
+// pattern that collides with another replaces it.
+#define REGEX_CACHE_SIZE 64
+
+typedef struct {
+    char* pattern;
+    int length;
+    int flags;
+    Regex* regex;
+} CachedRegex;
+
+static CachedRegex regexCache[REGEX_CACHE_SIZE];
+
+static int parseFlags(Value value) {
+    if (IS_NIL(value)) return 0;
+    if (!IS_STRING(value)) return -1;
+    int flags = 0;
+    ObjString* text = AS_STRING(value);
+    for (int i = 0; i < text->length; i++) {
+        switch (text->chars[i]) {
+            case 'i': flags |= REGEX_ICASE; break;
+            case 'm': flags |= REGEX_MULTILINE; break;
+            case 's': flags |= REGEX_DOTALL; break;
+            case 'g': break; // Global is chosen by the function instead
+            default: return -1;
+        }
+    }
+    return flags;
+}
+
+// Returns the compiled form of args[0] with the flags in args[flagsIndex],
+// compiling it on a cache miss; NULL if either is invalid.
+static Regex* lookupRegex(int argCount, Value* args, int flagsIndex) {
+    if (argCount < 1 || !IS_STRING(args[0])) return NULL;
+    int flags = parseFlags(argCount > flagsIndex ? args[flagsIndex] : NIL_VAL);
+    if (flags < 0) return NULL;
+
+    ObjString* pattern = AS_STRING(args[0]);
+    CachedRegex* entry = &regexCache[(pattern->hash ^ ((uint32_t)flags * 2654435761u)) & (REGEX_CACHE_SIZE - 1)];
+    if (entry->regex != NULL && entry->flags == flags && entry->length == pattern->length &&
+        memcmp(entry->pattern, pattern->chars, pattern->length) == 0) {
+        return entry->regex;
+    }
+
+    const char* error;
+    Regex* regex = regexCompile(pattern->chars, pattern->length, flags, &error);
+    if (regex == NULL) return NULL;
+    char* copy = (char*)malloc(pattern->length + 1);
+    if (copy == NULL) {
+        regexFree(regex);
+        return NULL;
+    }
+    memcpy(copy, pattern->chars, pattern->length);
+    regexFree(entry->regex);
+    free(entry->pattern);
+    entry->pattern = copy;
+    entry->length = pattern->length;
+    entry->flags = flags;
+    entry->regex = regex;
+    return regex;
+}
+
+// Capture offsets for a match; small patterns use the caller's buffer
+static int* captureBuffer(Regex* regex, int* local, int localSize) {
+    int slots = (regexGroupCount(regex) + 1) * 2;
+    return slots <= localSize ? local : (int*)malloc(sizeof(int) * slots);
+}
+
+static void freeCaptureBuffer(int* captures, int* local) {
+    if (captures != local) free(captures);
+}
+
+// Offset to search from after a match, stepping past empty matches
+static int nextSearchStart(const int* captures) {
+    return captures[1] > captures[0] ? captures[1] : captures[1] + 1;
+}
+
+typedef struct {
+    char* chars;
+    int length;
+    int capacity;
+} TextBuffer;
+
+static bool appendText(TextBuffer* buffer, const char* chars, int length) {
+    if (buffer->length + length + 1 > buffer->capacity) {
+        int capacity = buffer->capacity < 64 ? 64 : buffer->capacity;
+        while (capacity < buffer->length + length + 1) capacity *= 2;
+        char* grown = (char*)realloc(buffer->chars, capacity);
+        if (grown == NULL) return false;
+        buffer->chars = grown;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->chars + buffer->length, chars, length);
+    buffer->length += length;
+    return true;
+}
+
+// Expands $0-$9 (groups), $& (whole match) and $$ in a replacement
+static bool appendReplacement(TextBuffer* buffer, ObjString* replacement, const char* text,
+                              const int* captures, int groupCount) {
+    const char* chars = replacement->chars;
+    int length = replacement->length;
+    int start = 0;
+    for (int i = 0; i + 1 < length; i++) {
+        if (chars[i] != '$') continue;
+        char c = chars[i + 1];
+        int group = -1;
+        if (c >= '0' && c <= '9' && c - '0' <= groupCount) {
+            group = c - '0';
+        } else if (c == '&') {
+            group = 0;
+        } else if (c != '$') {
+            continue;
+        }
+        if (!appendText(buffer, chars + start, i - start)) return false;
+        if (group < 0) {
+            if (!appendText(buffer, "$", 1)) return false;
+        } else if (captures[group * 2] >= 0) {
+            int from = captures[group * 2];
+            if (!appendText(buffer, text + from, captures[group * 2 + 1] - from)) return false;
+        }
+        i++;
+        start = i + 1;
+    }
+    return appendText(buffer, chars + start, length - start);
+}
+
+// test(pattern, str, flags?) -> bool
+static Value native_regex_test(int argCount, Value* args) {
+    if (argCount < 2 || !IS_STRING(args[1])) return NIL_VAL;
+    Regex* regex = lookupRegex(argCount, args, 2);
+    if (regex == NULL) return NIL_VAL;
+    ObjString* text = AS_STRING(args[1]);
+    return BOOL_VAL(regexTest(regex, text->chars, text->length, 0));
+}
+
+// search(pattern, str, flags?) -> index of the first match, or -1
+static Value native_regex_search(int argCount, Value* args) {
+    if (argCount < 2 || !IS_STRING(args[1])) return NIL_VAL;
+    Regex* regex = lookupRegex(argCount, args, 2);
+    if (regex == NULL) return NIL_VAL;
+    ObjString* text = AS_STRING(args[1]);
+    int local[32];
+    int* captures = captureBuffer(regex, local, 32);
+    if (captures == NULL) return NIL_VAL;
+    int at = regexSearch(regex, text->chars, text->length, 0, captures) ? captures[0] : -1;
+    freeCaptureBuffer(captures, local);
+    return NUMBER_VAL(at);
+}
+
+// match(pattern, str, flags?) -> [whole, group1, ...] for the first match,
+// with nil for groups that did not take part; nil when nothing matches
+static Value native_regex_match(int argCount, Value* args) {
+    if (argCount < 2 || !IS_STRING(args[1])) return NIL_VAL;
+    Regex* regex = lookupRegex(argCount, args, 2);
+    if (regex == NULL) return NIL_VAL;
+    ObjString* text = AS_STRING(args[1]);
+    int local[32];
+    int* captures = captureBuffer(regex, local, 32);
+    if (captures == NULL) return NIL_VAL;
+    if (!regexSearch(regex, text->chars, text->length, 0, captures)) {
+        freeCaptureBuffer(captures, local);
+        return NIL_VAL;
+    }
+
+    ObjList* list = newList();
+    push(&vm, OBJ_VAL(list));
+    for (int group = 0; group <= regexGroupCount(regex); group++) {
+        int from = captures[group * 2];
+        Value part = from < 0 ? NIL_VAL : OBJ_VAL(copyString(text->chars + from, captures[group * 2 + 1] - from));
+        push(&vm, part);
+        appendToList(list, part);
+        pop(&vm);
+    }
+    freeCaptureBuffer(captures, local);
+    return pop(&vm);
+}
+
+// findAll(pattern, str, flags?) -> list of every non-overlapping match
+static Value native_regex_find_all(int argCount, Value* args) {
+    if (argCount < 2 || !IS_STRING(args[1])) return NIL_VAL;
+    Regex* regex = lookupRegex(argCount, args, 2);
+    if (regex == NULL) return NIL_VAL;
+    ObjString* text = AS_STRING(args[1]);
+    int local[32];
+    int* captures = captureBuffer(regex, local, 32);
+    if (captures == NULL) return NIL_VAL;
+
+    ObjList* list = newList();
+    push(&vm, OBJ_VAL(list));
+    int pos = 0;
+    while (pos <= text->length && regexSearch(regex, text->chars, text->length, pos, captures)) {
+        Value part = OBJ_VAL(copyString(text->chars + captures[0], captures[1] - captures[0]));
+        push(&vm, part);
+        appendToList(list, part);
+        pop(&vm);
+        pos = nextSearchStart(captures);
+    }
+    freeCaptureBuffer(captures, local);
+    return pop(&vm);
+}
+
+static Value replaceMatches(int argCount, Value* args, bool all) {
+    if (argCount < 3 || !IS_STRING(args[1]) || !IS_STRING(args[2])) return NIL_VAL;
+    Regex* regex = lookupRegex(argCount, args, 3);
+    if (regex == NULL) return NIL_VAL;
+    ObjString* text = AS_STRING(args[1]);
+    ObjString* replacement = AS_STRING(args[2]);
+    int local[32];
+    int* captures = captureBuffer(regex, local, 32);
+    if (captures == NULL) return NIL_VAL;
+
+    TextBuffer buffer = { NULL, 0, 0 };
+    bool ok = true;
+    int copied = 0;
+    int pos = 0;
+    while (ok && pos <= text->length && regexSearch(regex, text->chars, text->length, pos, captures)) {
+        ok = appendText(&buffer, text->chars + copied, captures[0] - copied) &&
+             appendReplacement(&buffer, replacement, text->chars, captures, regexGroupCount(regex));
+        copied = captures[1];
+        pos = nextSearchStart(captures);
+        if (!all) break;
+    }
+    freeCaptureBuffer(captures, local);
+    ok = ok && appendText(&buffer, text->chars + copied, text->length - copied);
+    if (!ok) {
+        free(buffer.chars);
+        return NIL_VAL;
+    }
+    Value result = OBJ_VAL(copyString(buffer.chars, buffer.length));
+    free(buffer.chars);
+    return result;
+}
+
+// replace(pattern, str, replacement, flags?) -> str with the first match
+// replaced; the replacement may use $0-$9, $& and $$
+static Value native_regex_replace(int argCount, Value* args) {
+    return replaceMatches(argCount, args, false);
+}
+
+// replaceAll(pattern, str, replacement, flags?) -> every match replaced
+static Value native_regex_replace_all(int argCount, Value* args) {
+    return replaceMatches(argCount, args, true);
+}
+
+// split(pattern, str, flags?) -> the pieces between matches
+static Value native_regex_split(int argCount, Value* args) {
+    if (argCount < 2 || !IS_STRING(args[1])) return NIL_VAL;
+    Regex* regex = lookupRegex(argCount, args, 2);
+    if (regex == NULL) return NIL_VAL;
+    ObjString* text = AS_STRING(args[1]);
+    int local[32];
+    int* captures = captureBuffer(regex, local, 32);
+    if (captures == NULL) return NIL_VAL;
+
+    ObjList* list = newList();
+    push(&vm, OBJ_VAL(list));
+    int last = 0;
+    int pos = 0;
+    while (pos < text->length && regexSearch(regex, text->chars, text->length, pos, captures)) {
+        if (captures[1] == captures[0]) {
+            // An empty match splits between characters, never at the ends
+            if (captures[0] >= text->length) break;
+            if (captures[0] == last) {
+                pos = captures[0] + 1;
+                continue;
+            }
+        }
+        Value part = OBJ_VAL(copyString(text->chars + last, captures[0] - last));
+        push(&vm, part);
+        appendToList(list, part);
+        pop(&vm);
+        last = captures[1];
+        pos = nextSearchStart(captures);
+    }
+    Value rest = OBJ_VAL(copyString(text->chars + last, text->length - last));
+    push(&vm, rest);
+    appendToList(list, rest);
+    pop(&vm);
+    freeCaptureBuffer(captures, local);
+    return pop(&vm);
+}
+
+// isValid(pattern, flags?) -> whether the pattern compiles
+static Value native_regex_is_valid(int argCount, Value* args) {
+    return BOOL_VAL(lookupRegex(argCount, args, 1) != NULL);
+}
+
+const NativeDef std_regex_natives[] = {
+    {"test", native_regex_test},
+    {"search", native_regex_search},
+    {"match", native_regex_match},
+    {"findAll", native_regex_find_all},
+    {"replace", native_regex_replace},
+    {"replaceAll", native_regex_replace_all},
+    {"split", native_regex_split},
+    {"isValid", native_regex_is_valid},
+    {NULL, NULL}
+};
+
+ObjModule* create_std_regex_module() {
+    ObjString* name = copyString("std.native.regex", 16);
+    push(&vm, OBJ_VAL(name));
+    ObjModule* module = newModule(name);
+    push(&vm, OBJ_VAL(module));
+
+    defineModuleNatives(&vm, module, std_regex_natives);
+
+    pop(&vm);
+    pop(&vm);
+    return module;
+}
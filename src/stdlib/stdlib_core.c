@@ -14,6 +14,9 @@
 #include "../include/vm.h"
 #include "../include/object.h"
 #include "../include/memory.h"
+#include "../include/snapshot.h"
+
+#include <stdlib.h>
 
 // Forward declarations for module creators
 extern ObjModule* create_std_io_module();
@@ -35,16 +38,49 @@ extern ObjModule* create_std_process_module();
 extern ObjModule* create_std_path_module();
 extern ObjModule* create_std_db_module();
 extern ObjModule* create_std_encoding_module();
+extern ObjModule* create_std_regex_module();
+extern ObjModule* create_std_iter_module();
+extern ObjModule* create_std_typed_module();
 
 // Legacy
 extern void register_math_natives(VM* vm);
 extern void register_math_globals(VM* vm);
+extern void register_math_kernels(void);
 extern void register_string_natives(VM* vm);
 extern void register_string_globals(VM* vm);
 extern void register_convert_natives(VM* vm);
 extern void register_system_natives(VM* vm);
 extern void register_io_globals(VM* vm);
 
+// Native lists, defined next to their natives
+extern const NativeDef std_io_natives[];
+extern const NativeDef std_fs_natives[];
+extern const NativeDef std_sys_natives[];
+extern const NativeDef std_math_natives[];
+extern const NativeDef std_str_natives[];
+extern const NativeDef std_time_natives[];
+extern const NativeDef std_json_natives[];
+extern const NativeDef std_os_natives[];
+extern const NativeDef std_hash_natives[];
+extern const NativeDef std_net_natives[];
+extern const NativeDef std_collections_natives[];
+extern const NativeDef std_reflect_natives[];
+extern const NativeDef std_buffer_natives[];
+extern const NativeDef std_process_natives[];
+extern const NativeDef std_path_natives[];
+extern const NativeDef std_db_natives[];
+extern const NativeDef std_encoding_natives[];
+extern const NativeDef std_regex_natives[];
+extern const NativeDef std_iter_natives[];
+extern const NativeDef std_typed_natives[];
+extern const NativeDef std_core_natives[];
+extern const NativeDef std_gc_natives[];
+extern const NativeDef std_convert_natives[];
+extern const NativeDef std_math_globals[];
+extern const NativeDef std_string_globals[];
+extern const NativeDef std_io_globals[];
+extern const NativeDef std_system_natives[];
+
 // Exposed natives
 extern Value native_clock(int argCount, Value* args);
 extern Value nativeLoadConfig(int argCount, Value *args);
@@ -56,6 +92,7 @@ static Value native_len(int argCount, Value* args) {
     if (IS_LIST(args[0])) {
          return NUMBER_VAL((double)AS_LIST(args[0])->count);
     }
+    if (IS_TYPED_ARRAY(args[0])) return NUMBER_VAL((double)AS_TYPED_ARRAY(args[0])->count);
     if (IS_DICTIONARY(args[0])) return NUMBER_VAL((double)AS_DICTIONARY(args[0])->items.count);
     return NUMBER_VAL(0);
 }
@@ -119,11 +156,127 @@ static Value native_substr(int argCount, Value* args) {
     return OBJ_VAL(result);
 }
 
+static const NativeDef coreGlobals[] = {
+    {"clock", native_clock},
+    {"len", native_len},
+    {"list_push", native_push},
+    {"push", native_push},
+    {"limit_pop", native_pop},
+    {"list_pop", native_pop},
+    {"pop", native_pop},
+    {"substr", native_substr},
+    {"loadConfig", nativeLoadConfig},
+    {NULL, NULL}
+};
+
+// Every native list, coreGlobals included. Heap snapshots store a native
+// as its index in the table built from these, so new lists go at the end.
+static const NativeDef* const nativeLists[] = {
+    std_io_natives,
+    std_fs_natives,
+    std_sys_natives,
+    std_math_natives,
+    std_str_natives,
+    std_time_natives,
+    std_json_natives,
+    std_os_natives,
+    std_hash_natives,
+    std_net_natives,
+    std_collections_natives,
+    std_reflect_natives,
+    std_buffer_natives,
+    std_process_natives,
+    std_path_natives,
+    std_db_natives,
+    std_encoding_natives,
+    std_regex_natives,
+    std_iter_natives,
+    std_typed_natives,
+    std_core_natives,
+    std_gc_natives,
+    std_convert_natives,
+    std_math_globals,
+    std_string_globals,
+    std_io_globals,
+    std_system_natives,
+    coreGlobals,
+};
+
+static NativeFn* nativeTable = NULL;
+static uint32_t nativeCount = 0;
+static uint64_t nativeAbi = 0;
+
+// Flattens the lists once; the hash covers every name in table order
+static void fillNativeTable(void) {
+    if (nativeTable != NULL) return;
+    size_t listCount = sizeof(nativeLists) / sizeof(nativeLists[0]);
+    uint32_t count = 0;
+    for (size_t i = 0; i < listCount; i++) {
+        for (const NativeDef* native = nativeLists[i]; native->name != NULL; native++) count++;
+    }
+    NativeFn* table = (NativeFn*)malloc(sizeof(NativeFn) * count);
+    if (table == NULL) return;
+
+    uint64_t hash = 14695981039346656037ull; // FNV-1a
+    count = 0;
+    for (size_t i = 0; i < listCount; i++) {
+        for (const NativeDef* native = nativeLists[i]; native->name != NULL; native++) {
+            table[count++] = native->function;
+            for (const char* c = native->name; ; c++) {
+                hash = (hash ^ (uint8_t)*c) * 1099511628211ull;
+                if (*c == '\0') break;
+            }
+        }
+        hash = (hash ^ 0xFF) * 1099511628211ull;
+    }
+    nativeAbi = hash;
+    nativeCount = count;
+    nativeTable = table;
+}
+
+uint32_t stdlibNativeCount(void) {
+    fillNativeTable();
+    return nativeCount;
+}
+
+uint64_t stdlibNativeAbi(void) {
+    fillNativeTable();
+    return nativeAbi;
+}
+
+NativeFn stdlibNative(uint32_t index) {
+    fillNativeTable();
+    return index < nativeCount ? nativeTable[index] : NULL;
+}
+
+bool stdlibNativeIndex(NativeFn function, uint32_t* index) {
+    fillNativeTable();
+    for (uint32_t i = 0; i < nativeCount; i++) {
+        if (nativeTable[i] == function) {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Re-create stdlib state kept outside the heap
+ * Called by registerStdLib and after a heap snapshot is restored
+ */
+void initStdLibState(VM* pVM) {
+    (void)pVM;
+    register_math_kernels();
+}
+
 /*
  * Register all standard library modules
  * Called during VM initialization
  */
 void registerStdLib(VM* pVM) {
+    fillNativeTable();
+    initStdLibState(pVM);
+
     // New Module System + Aliases
     ObjModule* ioMod = create_std_io_module();
     registerModule(pVM, "std.native.io", ioMod);
@@ -193,6 +346,18 @@ void registerStdLib(VM* pVM) {
     registerModule(pVM, "std.native.encoding", encodingMod);
     registerModule(pVM, "std.encoding", encodingMod);
 
+    ObjModule* regexMod = create_std_regex_module();
+    registerModule(pVM, "std.native.regex", regexMod);
+    registerModule(pVM, "std.regex", regexMod);
+
+    ObjModule* iterMod = create_std_iter_module();
+    registerModule(pVM, "std.native.iter", iterMod);
+    registerModule(pVM, "std.iter", iterMod);
+
+    ObjModule* typedMod = create_std_typed_module();
+    registerModule(pVM, "std.native.typed", typedMod);
+    registerModule(pVM, "std.typed", typedMod);
+
     registerModule(pVM, "std.core", create_std_core_module());
     
     ObjModule* uiMod = create_empty_module(pVM, "UI");
@@ -267,7 +432,73 @@ void registerStdLib(VM* pVM) {
         pop(pVM);
     }
     pop(pVM);
-    
+
+    Value jsonVal;
+    ObjString* jsonKey = copyString("std.native.json", 15);
+    push(pVM, OBJ_VAL(jsonKey));
+    if (tableGet(&pVM->importer.modules, jsonKey, &jsonVal)) {
+        ObjString* field = copyString("json", 4);
+        push(pVM, OBJ_VAL(field));
+        tableSet(&stdMod->exports, field, jsonVal);
+        pop(pVM);
+    }
+    pop(pVM);
+
+    Value regexVal;
+    ObjString* regexKey = copyString("std.native.regex", 16);
+    push(pVM, OBJ_VAL(regexKey));
+    if (tableGet(&pVM->importer.modules, regexKey, &regexVal)) {
+        ObjString* field = copyString("regex", 5);
+        push(pVM, OBJ_VAL(field));
+        tableSet(&stdMod->exports, field, regexVal);
+        pop(pVM);
+    }
+    pop(pVM);
+
+    Value bufVal;
+    ObjString* bufKey = copyString("std.native.buffer", 17);
+    push(pVM, OBJ_VAL(bufKey));
+    if (tableGet(&pVM->importer.modules, bufKey, &bufVal)) {
+        ObjString* field = copyString("buffer", 6);
+        push(pVM, OBJ_VAL(field));
+        tableSet(&stdMod->exports, field, bufVal);
+        pop(pVM);
+    }
+    pop(pVM);
+
+    Value colVal;
+    ObjString* colKey = copyString("std.native.collections", 22);
+    push(pVM, OBJ_VAL(colKey));
+    if (tableGet(&pVM->importer.modules, colKey, &colVal)) {
+        ObjString* field = copyString("collections", 11);
+        push(pVM, OBJ_VAL(field));
+        tableSet(&stdMod->exports, field, colVal);
+        pop(pVM);
+    }
+    pop(pVM);
+
+    Value iterVal;
+    ObjString* iterKey = copyString("std.native.iter", 15);
+    push(pVM, OBJ_VAL(iterKey));
+    if (tableGet(&pVM->importer.modules, iterKey, &iterVal)) {
+        ObjString* field = copyString("iter", 4);
+        push(pVM, OBJ_VAL(field));
+        tableSet(&stdMod->exports, field, iterVal);
+        pop(pVM);
+    }
+    pop(pVM);
+
+    Value typedVal;
+    ObjString* typedKey = copyString("std.native.typed", 16);
+    push(pVM, OBJ_VAL(typedKey));
+    if (tableGet(&pVM->importer.modules, typedKey, &typedVal)) {
+        ObjString* field = copyString("typed", 5);
+        push(pVM, OBJ_VAL(field));
+        tableSet(&stdMod->exports, field, typedVal);
+        pop(pVM);
+    }
+    pop(pVM);
+
     Value coreVal;
     ObjString* coreKey = copyString("std.core", 8);
     push(pVM, OBJ_VAL(coreKey));
@@ -305,16 +536,7 @@ void registerStdLib(VM* pVM) {
     pop(pVM);
     pop(pVM);
 
-    defineNative(pVM, "clock", native_clock);
-    defineNative(pVM, "len", native_len);
-    defineNative(pVM, "list_push", native_push);
-    defineNative(pVM, "push", native_push); 
-    defineNative(pVM, "limit_pop", native_pop); 
-    defineNative(pVM, "list_pop", native_pop);
-    defineNative(pVM, "pop", native_pop);   
-    defineNative(pVM, "substr", native_substr);
-    
-    defineNative(pVM, "loadConfig", nativeLoadConfig);
+    defineNatives(pVM, coreGlobals);
 
     register_math_globals(pVM);
     register_string_globals(pVM);
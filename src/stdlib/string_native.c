@@ -85,16 +85,6 @@ static int find_char_simd(const char* str, int len, char target) {
 #endif
 }
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // upper(str) - Convert to uppercase
 static Value native_upper(int argCount, Value* args) {
     if (argCount < 1 || !IS_STRING(args[0])) return NIL_VAL;
@@ -427,51 +417,61 @@ static Value native_trim_right(int argCount, Value* args) {
     return OBJ_VAL(copyString(str, end + 1));
 }
 
+const NativeDef std_str_natives[] = {
+    {"upper", native_upper},
+    {"lower", native_lower},
+    {"trim", native_trim},
+    {"split", native_split},
+    {"replace", native_replace},
+    {"contains", native_contains},
+    {"startswith", native_startswith},
+    {"endswith", native_endswith},
+    {"substr", native_substr},
+    {"repeat", native_repeat},
+    {"pad_left", native_pad_left},
+    {"pad_right", native_pad_right},
+    {"count_occurrences", native_count_occurrences},
+    {"reverse", native_str_reverse},
+    {"index_of", native_index_of},
+    {"trim_left", native_trim_left},
+    {"trim_right", native_trim_right},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_str_module() {
     ObjString* name = copyString("std.native.str", 14);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "upper", native_upper);
-    defineModuleFn(module, "lower", native_lower);
-    defineModuleFn(module, "trim", native_trim);
-    defineModuleFn(module, "split", native_split);
-    defineModuleFn(module, "replace", native_replace);
-    defineModuleFn(module, "contains", native_contains);
-    defineModuleFn(module, "startswith", native_startswith);
-    defineModuleFn(module, "endswith", native_endswith);
-    defineModuleFn(module, "substr",             native_substr);
-    defineModuleFn(module, "repeat",             native_repeat);
-    defineModuleFn(module, "pad_left",           native_pad_left);
-    defineModuleFn(module, "pad_right",          native_pad_right);
-    defineModuleFn(module, "count_occurrences",  native_count_occurrences);
-    defineModuleFn(module, "reverse",            native_str_reverse);
-    defineModuleFn(module, "index_of",           native_index_of);
-    defineModuleFn(module, "trim_left",          native_trim_left);
-    defineModuleFn(module, "trim_right",         native_trim_right);
+    defineModuleNatives(&vm, module, std_str_natives);
 
     pop(&vm);
     pop(&vm);
     return module;
 }
 
+const NativeDef std_string_globals[] = {
+    {"upper", native_upper},
+    {"lower", native_lower},
+    {"trim", native_trim},
+    {"trim_left", native_trim_left},
+    {"trim_right", native_trim_right},
+    {"split", native_split},
+    {"replace", native_replace},
+    {"contains", native_contains},
+    {"startswith", native_startswith},
+    {"endswith", native_endswith},
+    {"repeat", native_repeat},
+    {"pad_left", native_pad_left},
+    {"pad_right", native_pad_right},
+    {"count_occurrences", native_count_occurrences},
+    {"str_reverse", native_str_reverse},
+    {"index_of", native_index_of},
+    {NULL, NULL}
+};
+
 // Register string functions as globals
 void register_string_globals(VM* pVM) {
-    defineNative(pVM, "upper",            native_upper);
-    defineNative(pVM, "lower",            native_lower);
-    defineNative(pVM, "trim",             native_trim);
-    defineNative(pVM, "trim_left",        native_trim_left);
-    defineNative(pVM, "trim_right",       native_trim_right);
-    defineNative(pVM, "split",            native_split);
-    defineNative(pVM, "replace",          native_replace);
-    defineNative(pVM, "contains",         native_contains);
-    defineNative(pVM, "startswith",       native_startswith);
-    defineNative(pVM, "endswith",         native_endswith);
-    defineNative(pVM, "repeat",           native_repeat);
-    defineNative(pVM, "pad_left",         native_pad_left);
-    defineNative(pVM, "pad_right",        native_pad_right);
-    defineNative(pVM, "count_occurrences",native_count_occurrences);
-    defineNative(pVM, "str_reverse",      native_str_reverse);
-    defineNative(pVM, "index_of",         native_index_of);
+    defineNatives(pVM, std_string_globals);
 }
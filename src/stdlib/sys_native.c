@@ -38,16 +38,6 @@
 
 extern VM vm;
 
-// Helper to define native function/constants in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 static void defineModuleConst(ObjModule* module, const char* name, Value value) {
     ObjString* nameObj = copyString(name, (int)strlen(name));
     push(&vm, OBJ_VAL(nameObj));
@@ -117,18 +107,23 @@ static Value sys_exec(int argCount, Value* args) {
     return NUMBER_VAL((double)result);
 }
 
+const NativeDef std_sys_natives[] = {
+    {"exit", sys_exit},
+    {"env", sys_env},
+    {"set_env", sys_set_env},
+    {"cwd", sys_cwd},
+    {"args", sys_args},
+    {"exec", sys_exec},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_sys_module() {
     ObjString* name = copyString("std.native.sys", 14);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "exit", sys_exit);
-    defineModuleFn(module, "env", sys_env);
-    defineModuleFn(module, "set_env", sys_set_env);
-    defineModuleFn(module, "cwd", sys_cwd);
-    defineModuleFn(module, "args", sys_args);
-    defineModuleFn(module, "exec", sys_exec);
+    defineModuleNatives(&vm, module, std_sys_natives);
     
     defineModuleConst(module, "OS_NAME", OBJ_VAL(copyString(OS_NAME_STR, strlen(OS_NAME_STR))));
     defineModuleConst(module, "ARCH", OBJ_VAL(copyString(ARCH_STR, strlen(ARCH_STR))));
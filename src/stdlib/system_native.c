@@ -137,14 +137,19 @@ static Value native_sleep(int argCount, Value* args) {
     return NIL_VAL;
 }
 
+const NativeDef std_system_natives[] = {
+    {"exit", native_exit},
+    {"env", native_env},
+    {"platform", native_platform},
+    {"version", native_version},
+    {"exec", native_exec},
+    {"time", native_time},
+    {"sleep", native_sleep},
+    {NULL, NULL}
+};
+
 // Register all system functions with the VM
 void register_system_natives(VM* pVM) {
-    defineNative(pVM, "exit", native_exit);
-    defineNative(pVM, "env", native_env);
-    defineNative(pVM, "platform", native_platform);
-    defineNative(pVM, "version", native_version);
-    defineNative(pVM, "exec", native_exec);
-    defineNative(pVM, "time", native_time);
-    defineNative(pVM, "sleep", native_sleep);
+    defineNatives(pVM, std_system_natives);
 }
 
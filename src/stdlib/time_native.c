@@ -23,16 +23,6 @@
 
 extern VM vm;
 
-// Helper to define native function in a module
-static void defineModuleFn(ObjModule* module, const char* name, NativeFn function) {
-    ObjString* nameObj = copyString(name, (int)strlen(name));
-    push(&vm, OBJ_VAL(nameObj));
-    push(&vm, OBJ_VAL(newNative(function)));
-    tableSet(&module->exports, nameObj, peek(&vm, 0));
-    pop(&vm);
-    pop(&vm);
-}
-
 // now() -> Number (timestamp in seconds)
 static Value native_now(int argCount, Value* args) {
     (void)argCount; (void)args;
@@ -96,19 +86,23 @@ static Value native_timestamp(int argCount, Value* args) {
     return NUMBER_VAL((double)raw_time);
 }
 
+const NativeDef std_time_natives[] = {
+    {"now", native_now},
+    {"clock", native_clock},
+    {"sleep", native_sleep},
+    // New functions
+    {"strftime", native_strftime},
+    {"timestamp", native_timestamp},
+    {NULL, NULL}
+};
+
 ObjModule* create_std_time_module() {
     ObjString* name = copyString("std.native.time", 15);
     push(&vm, OBJ_VAL(name));
     ObjModule* module = newModule(name);
     push(&vm, OBJ_VAL(module));
     
-    defineModuleFn(module, "now", native_now);
-    defineModuleFn(module, "clock", native_clock);
-    defineModuleFn(module, "sleep", native_sleep);
-    
-    // New functions
-    defineModuleFn(module, "strftime", native_strftime);
-    defineModuleFn(module, "timestamp", native_timestamp);
+    defineModuleNatives(&vm, module, std_time_natives);
 
     pop(&vm);
     pop(&vm);
@@ -0,0 +1,436 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+/*
+ * ProXPL Standard Library - Typed Module
+ * Float64Array and Int32Array: fixed-length arrays of unboxed numbers.
+ * Indexing goes through the VM's fast path; sum, min, max, dot, scale and
+ * index_of run over the raw storage, with AVX2 kernels where available.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#include "../../include/common.h"
+#include "../../include/vm.h"
+#include "../../include/value.h"
+#include "../../include/object.h"
+#include "../../include/memory.h"
+
+// SIMD Includes
+#if defined(_MSC_VER)
+  #if defined(_M_AMD64) || defined(_M_IX86)
+    #include <intrin.h>
+    #if defined(__AVX2__)
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#elif defined(__GNUC__) || defined(__clang__)
+  #if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #ifdef __AVX2__
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#endif
+
+extern VM vm;
+
+// Largest element count: the storage size must fit in an int
+#define TYPED_MAX_COUNT (INT_MAX / (int)sizeof(double))
+
+static ObjTypedArray* typedArg(int argCount, Value* args, int index) {
+    if (argCount <= index || !IS_TYPED_ARRAY(args[index])) return NULL;
+    return AS_TYPED_ARRAY(args[index]);
+}
+
+static size_t elementWidth(TypedArrayKind kind) {
+    return kind == TYPED_FLOAT64 ? sizeof(double) : sizeof(int32_t);
+}
+
+static uint8_t* rawBytes(ObjTypedArray* array) {
+    return array->kind == TYPED_FLOAT64 ? (uint8_t*)array->as.f64 : (uint8_t*)array->as.i32;
+}
+
+static inline int trailingZeros32(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Kernels. Each has an AVX2 body for the bulk of the array and a scalar
+// loop for the tail (or everything, without AVX2).
+// ----------------------------------------------------------------------------
+
+static double sumF64(const double* data, int count) {
+    int i = 0;
+    double total = 0;
+#ifdef PROX_SIMD_AVX2
+    // Two accumulators hide the latency of the adds
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(data + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(data + i + 4));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < count; i++) total += data[i];
+    return total;
+}
+
+// Summed in 64 bits, so no int32 total can overflow
+static int64_t sumI32(const int32_t* data, int count) {
+    int i = 0;
+    int64_t total = 0;
+#ifdef PROX_SIMD_AVX2
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(chunk));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < count; i++) total += data[i];
+    return total;
+}
+
+// Smallest or largest of count >= 1 doubles. A NaN is skipped unless it is
+// the first element, the same in both paths.
+static double extremeF64(const double* data, int count, bool largest) {
+    int i = 1;
+    double best = data[0];
+#ifdef PROX_SIMD_AVX2
+    if (count >= 5) {
+        __m256d acc = _mm256_set1_pd(best);
+        for (; i + 4 <= count; i += 4) {
+            // min/max return their second operand when either is NaN
+            __m256d chunk = _mm256_loadu_pd(data + i);
+            acc = largest ? _mm256_max_pd(chunk, acc) : _mm256_min_pd(chunk, acc);
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, acc);
+        for (int lane = 0; lane < 4; lane++) {
+            if (largest ? lanes[lane] > best : lanes[lane] < best) best = lanes[lane];
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (largest ? data[i] > best : data[i] < best) best = data[i];
+    }
+    return best;
+}
+
+static int32_t extremeI32(const int32_t* data, int count, bool largest) {
+    int i = 1;
+    int32_t best = data[0];
+#ifdef PROX_SIMD_AVX2
+    if (count >= 9) {
+        __m256i acc = _mm256_set1_epi32(best);
+        for (; i + 8 <= count; i += 8) {
+            __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+            acc = largest ? _mm256_max_epi32(acc, chunk) : _mm256_min_epi32(acc, chunk);
+        }
+        int32_t lanes[8];
+        _mm256_storeu_si256((__m256i*)lanes, acc);
+        for (int lane = 0; lane < 8; lane++) {
+            if (largest ? lanes[lane] > best : lanes[lane] < best) best = lanes[lane];
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (largest ? data[i] > best : data[i] < best) best = data[i];
+    }
+    return best;
+}
+
+static double dotF64(const double* a, const double* b, int count) {
+    int i = 0;
+    double total = 0;
+#ifdef PROX_SIMD_AVX2
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < count; i++) total += a[i] * b[i];
+    return total;
+}
+
+static void scaleF64(double* data, int count, double factor) {
+    int i = 0;
+#ifdef PROX_SIMD_AVX2
+    __m256d f = _mm256_set1_pd(factor);
+    for (; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), f));
+    }
+#endif
+    for (; i < count; i++) data[i] *= factor;
+}
+
+static int findF64(const double* data, int count, int from, double needle) {
+    int i = from;
+#ifdef PROX_SIMD_AVX2
+    __m256d target = _mm256_set1_pd(needle);
+    for (; i + 4 <= count; i += 4) {
+        __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(data + i), target, _CMP_EQ_OQ);
+        int mask = _mm256_movemask_pd(eq);
+        if (mask != 0) return i + trailingZeros32((uint32_t)mask);
+    }
+#endif
+    for (; i < count; i++) {
+        if (data[i] == needle) return i;
+    }
+    return -1;
+}
+
+static int findI32(const int32_t* data, int count, int from, int32_t needle) {
+    int i = from;
+#ifdef PROX_SIMD_AVX2
+    __m256i target = _mm256_set1_epi32(needle);
+    for (; i + 8 <= count; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), target);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (mask != 0) return i + trailingZeros32((uint32_t)mask);
+    }
+#endif
+    for (; i < count; i++) {
+        if (data[i] == needle) return i;
+    }
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// Natives
+// ----------------------------------------------------------------------------
+
+// New array of 'kind' from a length, or from the numbers of a list, tensor
+// or typed array. Nil for a negative or oversized length, or a list with a
+// non-number in it.
+static Value makeTypedArray(int argCount, Value* args, TypedArrayKind kind) {
+    if (argCount < 1) return NIL_VAL;
+    Value source = args[0];
+
+    if (IS_NUMBER(source)) {
+        double length = AS_NUMBER(source);
+        if (!(length >= 0 && length <= TYPED_MAX_COUNT)) return NIL_VAL;
+        return OBJ_VAL(newTypedArray(kind, (int)length));
+    }
+
+    if (IS_LIST(source)) {
+        ObjList* list = AS_LIST(source);
+        for (int i = 0; i < list->count; i++) {
+            if (!IS_NUMBER(list->items[i])) return NIL_VAL;
+        }
+        // The list is an argument, so it stays reachable while this allocates
+        ObjTypedArray* array = newTypedArray(kind, list->count);
+        for (int i = 0; i < array->count; i++) typedArraySet(array, i, AS_NUMBER(list->items[i]));
+        return OBJ_VAL(array);
+    }
+    if (IS_TENSOR(source)) {
+        ObjTensor* tensor = AS_TENSOR(source);
+        ObjTypedArray* array = newTypedArray(kind, tensor->size);
+        if (kind == TYPED_FLOAT64) {
+            if (array->count > 0) memcpy(array->as.f64, tensor->data, sizeof(double) * array->count);
+        } else {
+            for (int i = 0; i < array->count; i++) array->as.i32[i] = toInt32(tensor->data[i]);
+        }
+        return OBJ_VAL(array);
+    }
+    if (IS_TYPED_ARRAY(source)) {
+        ObjTypedArray* from = AS_TYPED_ARRAY(source);
+        ObjTypedArray* array = newTypedArray(kind, from->count);
+        if (from->kind == kind) {
+            if (array->count > 0) memcpy(rawBytes(array), rawBytes(from), elementWidth(kind) * array->count);
+        } else {
+            for (int i = 0; i < array->count; i++) typedArraySet(array, i, typedArrayGet(from, i));
+        }
+        return OBJ_VAL(array);
+    }
+    return NIL_VAL;
+}
+
+// ---------- float64(lengthOrSource) ----------
+static Value native_typed_float64(int argCount, Value* args) {
+    return makeTypedArray(argCount, args, TYPED_FLOAT64);
+}
+
+// ---------- int32(lengthOrSource) ----------
+static Value native_typed_int32(int argCount, Value* args) {
+    return makeTypedArray(argCount, args, TYPED_INT32);
+}
+
+// ---------- kind(array) ----------
+static Value native_typed_kind(int argCount, Value* args) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL) return NIL_VAL;
+    return array->kind == TYPED_FLOAT64 ? OBJ_VAL(copyString("float64", 7))
+                                        : OBJ_VAL(copyString("int32", 5));
+}
+
+// ---------- to_list(array) ----------
+static Value native_typed_to_list(int argCount, Value* args) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL) return NIL_VAL;
+    ObjList* list = newList();
+    push(&vm, OBJ_VAL(list));
+    if (array->count > 0) {
+        list->items = GROW_ARRAY(Value, list->items, 0, array->count);
+        list->capacity = array->count;
+        for (int i = 0; i < array->count; i++) list->items[i] = NUMBER_VAL(typedArrayGet(array, i));
+        list->count = array->count;
+    }
+    return pop(&vm);
+}
+
+// ---------- slice(array, start, end?) ----------
+// A copy of [start, end), clamped to the array
+static Value native_typed_slice(int argCount, Value* args) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL || argCount < 2 || !IS_NUMBER(args[1])) return NIL_VAL;
+    double start = AS_NUMBER(args[1]);
+    double end = argCount >= 3 && IS_NUMBER(args[2]) ? AS_NUMBER(args[2]) : array->count;
+    if (!(start >= 0)) start = 0;
+    if (!(end <= array->count)) end = array->count;
+    int from = (int)start;
+    int length = end > start ? (int)end - from : 0;
+
+    ObjTypedArray* slice = newTypedArray(array->kind, length);
+    size_t width = elementWidth(array->kind);
+    if (length > 0) memcpy(rawBytes(slice), rawBytes(array) + width * from, width * length);
+    return OBJ_VAL(slice);
+}
+
+// ---------- fill(array, value) ----------
+static Value native_typed_fill(int argCount, Value* args) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL || argCount < 2 || !IS_NUMBER(args[1])) return NIL_VAL;
+    double number = AS_NUMBER(args[1]);
+    if (array->kind == TYPED_FLOAT64) {
+        for (int i = 0; i < array->count; i++) array->as.f64[i] = number;
+    } else {
+        int32_t word = toInt32(number);
+        for (int i = 0; i < array->count; i++) array->as.i32[i] = word;
+    }
+    return args[0];
+}
+
+// ---------- sum(array) ----------
+static Value native_typed_sum(int argCount, Value* args) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL) return NIL_VAL;
+    if (array->kind == TYPED_FLOAT64) return NUMBER_VAL(sumF64(array->as.f64, array->count));
+    return NUMBER_VAL((double)sumI32(array->as.i32, array->count));
+}
+
+static Value extreme(int argCount, Value* args, bool largest) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL || array->count == 0) return NIL_VAL;
+    if (array->kind == TYPED_FLOAT64) return NUMBER_VAL(extremeF64(array->as.f64, array->count, largest));
+    return NUMBER_VAL((double)extremeI32(array->as.i32, array->count, largest));
+}
+
+// ---------- min(array) ----------
+static Value native_typed_min(int argCount, Value* args) {
+    return extreme(argCount, args, false);
+}
+
+// ---------- max(array) ----------
+static Value native_typed_max(int argCount, Value* args) {
+    return extreme(argCount, args, true);
+}
+
+// ---------- dot(a, b) ----------
+static Value native_typed_dot(int argCount, Value* args) {
+    ObjTypedArray* a = typedArg(argCount, args, 0);
+    ObjTypedArray* b = typedArg(argCount, args, 1);
+    if (a == NULL || b == NULL || a->count != b->count) return NIL_VAL;
+    if (a->kind == TYPED_FLOAT64 && b->kind == TYPED_FLOAT64) {
+        return NUMBER_VAL(dotF64(a->as.f64, b->as.f64, a->count));
+    }
+    double total = 0;
+    for (int i = 0; i < a->count; i++) total += typedArrayGet(a, i) * typedArrayGet(b, i);
+    return NUMBER_VAL(total);
+}
+
+// ---------- scale(array, factor) ----------
+// Multiplies every element in place and returns the array
+static Value native_typed_scale(int argCount, Value* args) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL || argCount < 2 || !IS_NUMBER(args[1])) return NIL_VAL;
+    double factor = AS_NUMBER(args[1]);
+    if (array->kind == TYPED_FLOAT64) {
+        scaleF64(array->as.f64, array->count, factor);
+    } else {
+        for (int i = 0; i < array->count; i++) array->as.i32[i] = toInt32(array->as.i32[i] * factor);
+    }
+    return args[0];
+}
+
+// ---------- index_of(array, value, from?) ----------
+static Value native_typed_index_of(int argCount, Value* args) {
+    ObjTypedArray* array = typedArg(argCount, args, 0);
+    if (array == NULL || argCount < 2 || !IS_NUMBER(args[1])) return NUMBER_VAL(-1);
+    int from = 0;
+    if (argCount >= 3 && IS_NUMBER(args[2]) && AS_NUMBER(args[2]) > 0) {
+        if (AS_NUMBER(args[2]) >= array->count) return NUMBER_VAL(-1);
+        from = (int)AS_NUMBER(args[2]);
+    }
+    double needle = AS_NUMBER(args[1]);
+    if (array->kind == TYPED_FLOAT64) return NUMBER_VAL(findF64(array->as.f64, array->count, from, needle));
+    // Only a whole number in range can equal an int32 element
+    if (!(needle >= INT32_MIN && needle <= INT32_MAX) || needle != (double)(int32_t)needle) {
+        return NUMBER_VAL(-1);
+    }
+    return NUMBER_VAL(findI32(array->as.i32, array->count, from, (int32_t)needle));
+}
+
+const NativeDef std_typed_natives[] = {
+    {"float64", native_typed_float64},
+    {"int32", native_typed_int32},
+    {"kind", native_typed_kind},
+    {"to_list", native_typed_to_list},
+    {"slice", native_typed_slice},
+    {"fill", native_typed_fill},
+    {"sum", native_typed_sum},
+    {"min", native_typed_min},
+    {"max", native_typed_max},
+    {"dot", native_typed_dot},
+    {"scale", native_typed_scale},
+    {"index_of", native_typed_index_of},
+    {NULL, NULL}
+};
+
+ObjModule* create_std_typed_module() {
+    ObjString* name = copyString("std.native.typed", 16);
+    push(&vm, OBJ_VAL(name));
+    ObjModule* module = newModule(name);
+    push(&vm, OBJ_VAL(module));
+
+    defineModuleNatives(&vm, module, std_typed_natives);
+
+    pop(&vm); // module
+    pop(&vm); // name
+    return module;
+}
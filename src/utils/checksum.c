@@ -0,0 +1,221 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "../../include/checksum.h"
+
+// SIMD Includes
+#if defined(_MSC_VER)
+  #if defined(_M_AMD64) || defined(_M_IX86)
+    #include <intrin.h>
+    #if defined(__AVX__)
+      #define PROX_SIMD_CRC32C
+    #endif
+  #endif
+#elif defined(__GNUC__) || defined(__clang__)
+  #if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #ifdef __SSE4_2__
+      #define PROX_SIMD_CRC32C
+    #endif
+  #endif
+#endif
+
+static uint64_t readLE64(const unsigned char* p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+           ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+static uint32_t readLE32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// --------------------------------------------------
+// XXH64
+// --------------------------------------------------
+
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+
+static uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t xxhRound(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static uint64_t xxhMerge(uint64_t acc, uint64_t value) {
+    acc ^= xxhRound(0, value);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+static const unsigned char* xxhStripes(uint64_t v[4], const unsigned char* p, size_t stripes) {
+    uint64_t v1 = v[0], v2 = v[1], v3 = v[2], v4 = v[3];
+    for (; stripes > 0; stripes--, p += 32) {
+        v1 = xxhRound(v1, readLE64(p));
+        v2 = xxhRound(v2, readLE64(p + 8));
+        v3 = xxhRound(v3, readLE64(p + 16));
+        v4 = xxhRound(v4, readLE64(p + 24));
+    }
+    v[0] = v1;
+    v[1] = v2;
+    v[2] = v3;
+    v[3] = v4;
+    return p;
+}
+
+void xxh64_init(XXH64_CTX* ctx, uint64_t seed) {
+    memset(ctx, 0, sizeof(XXH64_CTX));
+    ctx->seed = seed;
+    ctx->v[0] = seed + PRIME64_1 + PRIME64_2;
+    ctx->v[1] = seed + PRIME64_2;
+    ctx->v[2] = seed;
+    ctx->v[3] = seed - PRIME64_1;
+}
+
+void xxh64_update(XXH64_CTX* ctx, const void* data, size_t len) {
+    const unsigned char* p = (const unsigned char*)data;
+    ctx->totalLength += len;
+
+    if (ctx->bufferLength > 0) {
+        size_t fill = 32 - ctx->bufferLength;
+        if (fill > len) fill = len;
+        memcpy(ctx->buffer + ctx->bufferLength, p, fill);
+        ctx->bufferLength += (uint32_t)fill;
+        p += fill;
+        len -= fill;
+        if (ctx->bufferLength < 32) return;
+        xxhStripes(ctx->v, ctx->buffer, 1);
+        ctx->bufferLength = 0;
+    }
+
+    p = xxhStripes(ctx->v, p, len / 32);
+    len %= 32;
+    if (len > 0) {
+        memcpy(ctx->buffer, p, len);
+        ctx->bufferLength = (uint32_t)len;
+    }
+}
+
+uint64_t xxh64_final(const XXH64_CTX* ctx) {
+    uint64_t h;
+    if (ctx->totalLength >= 32) {
+        h = rotl64(ctx->v[0], 1) + rotl64(ctx->v[1], 7) + rotl64(ctx->v[2], 12) + rotl64(ctx->v[3], 18);
+        for (int i = 0; i < 4; i++) h = xxhMerge(h, ctx->v[i]);
+    } else {
+        h = ctx->seed + PRIME64_5;
+    }
+    h += ctx->totalLength;
+
+    const unsigned char* p = ctx->buffer;
+    size_t len = ctx->bufferLength;
+    for (; len >= 8; len -= 8, p += 8) {
+        h ^= xxhRound(0, readLE64(p));
+        h = rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (len >= 4) {
+        h ^= (uint64_t)readLE32(p) * PRIME64_1;
+        h = rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+        len -= 4;
+    }
+    for (; len > 0; len--, p++) {
+        h ^= *p * PRIME64_5;
+        h = rotl64(h, 11) * PRIME64_1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t xxh64(const void* data, size_t len, uint64_t seed) {
+    XXH64_CTX ctx;
+    xxh64_init(&ctx, seed);
+    xxh64_update(&ctx, data, len);
+    return xxh64_final(&ctx);
+}
+
+// --------------------------------------------------
+// CRC32C
+// --------------------------------------------------
+
+#ifdef PROX_SIMD_CRC32C
+
+uint32_t crc32c_update(uint32_t crc, const void* data, size_t len) {
+    const unsigned char* p = (const unsigned char*)data;
+    crc = ~crc;
+#if defined(__x86_64__) || defined(_M_AMD64)
+    uint64_t wide = crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        wide = _mm_crc32_u64(wide, word);
+    }
+    crc = (uint32_t)wide;
+#endif
+    for (; len >= 4; len -= 4, p += 4) {
+        uint32_t word;
+        memcpy(&word, p, 4);
+        crc = _mm_crc32_u32(crc, word);
+    }
+    for (; len > 0; len--, p++) crc = _mm_crc32_u8(crc, *p);
+    return ~crc;
+}
+
+#else
+
+#define CRC32C_POLY 0x82F63B78u
+
+// Slicing-by-8: table[k][b] is the CRC of byte b followed by k zero bytes,
+// so eight input bytes fold in with eight lookups
+static uint32_t crcTable[8][256];
+static bool crcTableReady = false;
+
+static void buildCrcTable(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int bit = 0; bit < 8; bit++) c = (c & 1) ? (c >> 1) ^ CRC32C_POLY : c >> 1;
+        crcTable[0][i] = c;
+    }
+    for (int i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) {
+            uint32_t prev = crcTable[k - 1][i];
+            crcTable[k][i] = (prev >> 8) ^ crcTable[0][prev & 0xFF];
+        }
+    }
+    crcTableReady = true;
+}
+
+uint32_t crc32c_update(uint32_t crc, const void* data, size_t len) {
+    if (!crcTableReady) buildCrcTable();
+    const unsigned char* p = (const unsigned char*)data;
+    crc = ~crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint32_t lo = readLE32(p) ^ crc;
+        uint32_t hi = readLE32(p + 4);
+        crc = crcTable[7][lo & 0xFF] ^ crcTable[6][(lo >> 8) & 0xFF] ^
+              crcTable[5][(lo >> 16) & 0xFF] ^ crcTable[4][lo >> 24] ^
+              crcTable[3][hi & 0xFF] ^ crcTable[2][(hi >> 8) & 0xFF] ^
+              crcTable[1][(hi >> 16) & 0xFF] ^ crcTable[0][hi >> 24];
+    }
+    for (; len > 0; len--, p++) crc = (crc >> 8) ^ crcTable[0][(crc ^ *p) & 0xFF];
+    return ~crc;
+}
+
+#endif
@@ -0,0 +1,879 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../../include/json.h"
+#include "../../include/common.h"
+#include "../../include/vm.h"
+#include "../../include/object.h"
+#include "../../include/table.h"
+
+// SIMD Includes
+#if defined(_MSC_VER)
+  #if defined(_M_AMD64) || defined(_M_IX86)
+    #include <intrin.h>
+    #if defined(__AVX2__)
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#elif defined(__GNUC__) || defined(__clang__)
+  #if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #ifdef __AVX2__
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#endif
+
+extern VM vm;
+
+static inline int trailingZeros64(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Character classes
+// ----------------------------------------------------------------------------
+
+#define CLASS_QUOTE     0x01
+#define CLASS_BACKSLASH 0x02
+#define CLASS_OP        0x04 // { } [ ] : ,
+#define CLASS_SPACE     0x08
+#define CLASS_ESCAPE    0x10 // Must be escaped inside a string
+
+static uint8_t charClass[256];
+static bool charClassReady = false;
+
+static void initCharClass(void) {
+    if (charClassReady) return;
+    for (int c = 0; c < 0x20; c++) charClass[c] = CLASS_ESCAPE;
+    charClass['"'] = CLASS_QUOTE | CLASS_ESCAPE;
+    charClass['\\'] = CLASS_BACKSLASH | CLASS_ESCAPE;
+    charClass['{'] = charClass['}'] = charClass['['] = charClass[']'] = CLASS_OP;
+    charClass[':'] = charClass[','] = CLASS_OP;
+    charClass[' '] = CLASS_SPACE;
+    charClass['\t'] |= CLASS_SPACE;
+    charClass['\n'] |= CLASS_SPACE;
+    charClass['\r'] |= CLASS_SPACE;
+    charClassReady = true;
+}
+
+// Length of the prefix of 's' that can be copied into a JSON string as is:
+// no quote, backslash or control character. Shared by the parser (string
+// contents) and the serializer.
+static size_t plainPrefix(const char* s, size_t length) {
+    size_t i = 0;
+#ifdef PROX_SIMD_AVX2
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    for (; i + 32 <= length; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(s + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                                          _mm256_cmpeq_epi8(chunk, backslash));
+        // Unsigned chunk <= 0x1F
+        special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(special);
+        if (mask != 0) return i + (size_t)trailingZeros64(mask);
+    }
+#else
+    // Eight bytes at a time: a byte of 'word' is flagged when it is below
+    // 0x20 or equals '"' or '\\' (later bytes may be flagged spuriously)
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, s + i, 8);
+        uint64_t q = word ^ (ones * '"');
+        uint64_t b = word ^ (ones * '\\');
+        uint64_t flagged = ((q - ones) & ~q) | ((b - ones) & ~b) | ((word - ones * 0x20) & ~word);
+        if ((flagged & highs) != 0) break;
+    }
+#endif
+    while (i < length && !(charClass[(uint8_t)s[i]] & CLASS_ESCAPE)) i++;
+    return i;
+}
+
+// ----------------------------------------------------------------------------
+// Stage 1: structural index
+// ----------------------------------------------------------------------------
+
+typedef struct {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;
+    uint64_t space;
+} BlockMasks;
+
+static void classifyBlock(const uint8_t* block, BlockMasks* masks) {
+#ifdef PROX_SIMD_AVX2
+    uint64_t quote = 0, backslash = 0, op = 0, space = 0;
+    for (int half = 0; half < 2; half++) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(block + half * 32));
+        __m256i ops = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('{')),
+                            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('}'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('[')),
+                            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(']'))));
+        ops = _mm256_or_si256(ops, _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':')),
+                                                   _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(','))));
+        __m256i spaces = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+                            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')),
+                            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r'))));
+        int shift = half * 32;
+        quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"'))) << shift;
+        backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))) << shift;
+        op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ops) << shift;
+        space |= (uint64_t)(uint32_t)_mm256_movemask_epi8(spaces) << shift;
+    }
+    masks->quote = quote;
+    masks->backslash = backslash;
+    masks->op = op;
+    masks->space = space;
+#else
+    uint64_t quote = 0, backslash = 0, op = 0, space = 0;
+    for (int i = 0; i < 64; i++) {
+        uint8_t cls = charClass[block[i]];
+        uint64_t bit = 1ULL << i;
+        if (cls & CLASS_QUOTE) quote |= bit;
+        if (cls & CLASS_BACKSLASH) backslash |= bit;
+        if (cls & CLASS_OP) op |= bit;
+        if (cls & CLASS_SPACE) space |= bit;
+    }
+    masks->quote = quote;
+    masks->backslash = backslash;
+    masks->op = op;
+    masks->space = space;
+#endif
+}
+
+// Characters preceded by an odd run of backslashes. 'carry' is set when the
+// previous block ended in such a run.
+static uint64_t findEscaped(uint64_t backslash, uint64_t* carry) {
+    const uint64_t evenBits = 0x5555555555555555ULL;
+    backslash &= ~*carry;
+    uint64_t followsEscape = (backslash << 1) | *carry;
+    uint64_t oddStarts = backslash & ~evenBits & ~followsEscape;
+    uint64_t evenStartSums = oddStarts + backslash;
+    *carry = evenStartSums < oddStarts;
+    uint64_t invert = evenStartSums << 1;
+    return (evenBits ^ invert) & followsEscape;
+}
+
+// Bit i is the parity of the bits 0..i of 'x'.
+static uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+typedef struct {
+    uint32_t* offsets;
+    size_t count;
+    size_t capacity;
+} StructuralIndex;
+
+// Records the offset of every structural character outside strings, every
+// unescaped quote (so a string's closing quote follows its opening one) and
+// the first character of every number and literal.
+static bool buildIndex(const char* text, size_t length, StructuralIndex* index, JsonError* error) {
+    index->count = 0;
+    index->capacity = length / 4 + 64;
+    index->offsets = (uint32_t*)malloc(sizeof(uint32_t) * index->capacity);
+    if (index->offsets == NULL) {
+        error->message = "Out of memory.";
+        error->offset = 0;
+        return false;
+    }
+
+    uint64_t escapeCarry = 0;
+    uint64_t inStringCarry = 0; // All ones while a string is open
+    uint64_t scalarCarry = 0;
+    uint8_t padded[64];
+
+    for (size_t base = 0; base < length; base += 64) {
+        const uint8_t* block = (const uint8_t*)text + base;
+        if (length - base < 64) {
+            memset(padded, ' ', sizeof(padded));
+            memcpy(padded, block, length - base);
+            block = padded;
+        }
+
+        BlockMasks masks;
+        classifyBlock(block, &masks);
+        uint64_t escaped = findEscaped(masks.backslash, &escapeCarry);
+        uint64_t quote = masks.quote & ~escaped;
+        // Set from each opening quote up to its closing quote (exclusive)
+        uint64_t inString = prefixXor(quote) ^ inStringCarry;
+        inStringCarry = (uint64_t)((int64_t)inString >> 63);
+
+        uint64_t scalar = ~(masks.op | masks.space | quote | inString);
+        uint64_t scalarStart = scalar & ~((scalar << 1) | scalarCarry);
+        scalarCarry = scalar >> 63;
+
+        uint64_t structural = (masks.op & ~inString) | quote | scalarStart;
+
+        if (index->count + 64 > index->capacity) {
+            size_t capacity = index->capacity * 2 + 64;
+            uint32_t* offsets = (uint32_t*)realloc(index->offsets, sizeof(uint32_t) * capacity);
+            if (offsets == NULL) {
+                error->message = "Out of memory.";
+                error->offset = base;
+                return false;
+            }
+            index->offsets = offsets;
+            index->capacity = capacity;
+        }
+        while (structural != 0) {
+            index->offsets[index->count++] = (uint32_t)(base + (size_t)trailingZeros64(structural));
+            structural &= structural - 1;
+        }
+    }
+
+    if (inStringCarry != 0) {
+        error->message = "Unterminated string.";
+        error->offset = length;
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Stage 2: building values
+// ----------------------------------------------------------------------------
+
+typedef struct {
+    const char* text;
+    size_t length;
+    StructuralIndex index;
+    size_t next; // Next entry of the index to read
+    int depth;
+    char* scratch; // Decoded strings with escapes
+    size_t scratchCapacity;
+    JsonError* error;
+} JsonParser;
+
+static bool fail(JsonParser* parser, const char* message, size_t offset) {
+    if (parser->error->message == NULL) {
+        parser->error->message = message;
+        parser->error->offset = offset;
+    }
+    return false;
+}
+
+static bool atEnd(JsonParser* parser) {
+    return parser->next >= parser->index.count;
+}
+
+static size_t peekOffset(JsonParser* parser) {
+    return atEnd(parser) ? parser->length : parser->index.offsets[parser->next];
+}
+
+static char peekChar(JsonParser* parser) {
+    return atEnd(parser) ? '\0' : parser->text[parser->index.offsets[parser->next]];
+}
+
+static bool expect(JsonParser* parser, char c, const char* message) {
+    if (peekChar(parser) != c) return fail(parser, message, peekOffset(parser));
+    parser->next++;
+    return true;
+}
+
+// True if the scalar ending at 'offset' is properly delimited.
+static bool scalarEnds(JsonParser* parser, size_t offset) {
+    return offset >= parser->length ||
+           (charClass[(uint8_t)parser->text[offset]] & (CLASS_OP | CLASS_SPACE)) != 0;
+}
+
+static bool reserveScratch(JsonParser* parser, size_t size) {
+    if (size <= parser->scratchCapacity) return true;
+    size_t capacity = parser->scratchCapacity < 64 ? 64 : parser->scratchCapacity;
+    while (capacity < size) capacity *= 2;
+    char* scratch = (char*)realloc(parser->scratch, capacity);
+    if (scratch == NULL) return false;
+    parser->scratch = scratch;
+    parser->scratchCapacity = capacity;
+    return true;
+}
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool readHex4(const char* s, const char* end, uint32_t* out) {
+    if (end - s < 4) return false;
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        int digit = hexDigit(s[i]);
+        if (digit < 0) return false;
+        value = (value << 4) | (uint32_t)digit;
+    }
+    *out = value;
+    return true;
+}
+
+static size_t encodeUtf8(uint32_t cp, char* out) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// Decodes the string between the quotes at 'open' and 'close'. Strings
+// without escapes are interned straight from the input. The result points
+// at the input or at parser->scratch.
+static bool decodeString(JsonParser* parser, size_t open, size_t close, const char** chars, size_t* length) {
+    const char* s = parser->text + open + 1;
+    size_t n = close - open - 1;
+    size_t plain = plainPrefix(s, n);
+    if (plain == n) {
+        *chars = s;
+        *length = n;
+        return true;
+    }
+
+    // Escapes only shrink the text
+    if (!reserveScratch(parser, n)) return fail(parser, "Out of memory.", open);
+    char* out = parser->scratch;
+    size_t written = 0;
+    size_t i = 0;
+    const char* end = s + n;
+    while (i < n) {
+        size_t run = plainPrefix(s + i, n - i);
+        memcpy(out + written, s + i, run);
+        written += run;
+        i += run;
+        if (i >= n) break;
+
+        char c = s[i];
+        if (c != '\\') return fail(parser, "Control character in string.", open + 1 + i);
+        if (i + 1 >= n) return fail(parser, "Invalid escape in string.", open + 1 + i);
+        char e = s[i + 1];
+        i += 2;
+        switch (e) {
+            case '"': out[written++] = '"'; break;
+            case '\\': out[written++] = '\\'; break;
+            case '/': out[written++] = '/'; break;
+            case 'b': out[written++] = '\b'; break;
+            case 'f': out[written++] = '\f'; break;
+            case 'n': out[written++] = '\n'; break;
+            case 'r': out[written++] = '\r'; break;
+            case 't': out[written++] = '\t'; break;
+            case 'u': {
+                uint32_t cp;
+                if (!readHex4(s + i, end, &cp)) return fail(parser, "Invalid unicode escape.", open + i);
+                i += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    uint32_t low;
+                    if (i + 2 > n || s[i] != '\\' || s[i + 1] != 'u' || !readHex4(s + i + 2, end, &low) ||
+                        low < 0xDC00 || low > 0xDFFF) {
+                        return fail(parser, "Invalid unicode escape.", open + i);
+                    }
+                    i += 6;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    return fail(parser, "Invalid unicode escape.", open + i);
+                }
+                // A 6 or 12 byte escape never encodes to more bytes than it takes
+                written += encodeUtf8(cp, out + written);
+                break;
+            }
+            default:
+                return fail(parser, "Invalid escape in string.", open + i - 1);
+        }
+    }
+    *chars = out;
+    *length = written;
+    return true;
+}
+
+static bool parseString(JsonParser* parser, size_t open, Value* out) {
+    if (atEnd(parser)) return fail(parser, "Unterminated string.", open);
+    size_t close = parser->index.offsets[parser->next++];
+    const char* chars;
+    size_t length;
+    if (!decodeString(parser, open, close, &chars, &length)) return false;
+    *out = OBJ_VAL(copyString(chars, (int)length));
+    return true;
+}
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool parseNumber(JsonParser* parser, size_t start, Value* out) {
+    const char* s = parser->text + start;
+    const char* end = parser->text + parser->length;
+    const char* c = s;
+    bool negative = *c == '-';
+    if (negative) c++;
+    if (c >= end || !isDigit(*c)) return fail(parser, "Invalid number.", start);
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    if (*c == '0') {
+        c++;
+    } else {
+        while (c < end && isDigit(*c)) {
+            mantissa = mantissa * 10 + (uint64_t)(*c - '0');
+            digits++;
+            c++;
+        }
+    }
+    bool integral = true;
+    if (c < end && *c == '.') {
+        integral = false;
+        c++;
+        if (c >= end || !isDigit(*c)) return fail(parser, "Invalid number.", start);
+        while (c < end && isDigit(*c)) c++;
+    }
+    if (c < end && (*c == 'e' || *c == 'E')) {
+        integral = false;
+        c++;
+        if (c < end && (*c == '+' || *c == '-')) c++;
+        if (c >= end || !isDigit(*c)) return fail(parser, "Invalid number.", start);
+        while (c < end && isDigit(*c)) c++;
+    }
+    if (!scalarEnds(parser, (size_t)(c - parser->text))) return fail(parser, "Invalid number.", start);
+
+    // Up to 15 digits convert exactly
+    if (integral && digits <= 15) {
+        double value = (double)mantissa;
+        *out = NUMBER_VAL(negative ? -value : value);
+        return true;
+    }
+    size_t length = (size_t)(c - s);
+    char local[64];
+    char* copy = length < sizeof(local) ? local : (char*)malloc(length + 1);
+    if (copy == NULL) return fail(parser, "Out of memory.", start);
+    memcpy(copy, s, length);
+    copy[length] = '\0';
+    *out = NUMBER_VAL(strtod(copy, NULL));
+    if (copy != local) free(copy);
+    return true;
+}
+
+static bool parseLiteral(JsonParser* parser, size_t start, const char* word, Value value, Value* out) {
+    size_t length = strlen(word);
+    if (parser->length - start < length || memcmp(parser->text + start, word, length) != 0 ||
+        !scalarEnds(parser, start + length)) {
+        return fail(parser, "Invalid literal.", start);
+    }
+    *out = value;
+    return true;
+}
+
+static bool parseValue(JsonParser* parser, Value* out);
+
+// Containers stay on the VM stack while they fill, and each element while
+// it is stored, so collections triggered by the allocations keep them.
+static bool parseArray(JsonParser* parser, Value* out) {
+    ObjList* list = newList();
+    push(&vm, OBJ_VAL(list));
+    if (peekChar(parser) == ']') {
+        parser->next++;
+    } else {
+        for (;;) {
+            Value element;
+            if (!parseValue(parser, &element)) return false;
+            push(&vm, element);
+            appendToList(list, element);
+            pop(&vm);
+            char c = peekChar(parser);
+            if (c == ']') {
+                parser->next++;
+                break;
+            }
+            if (!expect(parser, ',', "Expected ',' or ']' in array.")) return false;
+        }
+    }
+    *out = pop(&vm);
+    return true;
+}
+
+static bool parseObject(JsonParser* parser, Value* out) {
+    ObjDictionary* dict = newDictionary();
+    push(&vm, OBJ_VAL(dict));
+    if (peekChar(parser) == '}') {
+        parser->next++;
+    } else {
+        for (;;) {
+            size_t keyOffset = peekOffset(parser);
+            if (!expect(parser, '"', "Expected string key in object.")) return false;
+            Value key;
+            if (!parseString(parser, keyOffset, &key)) return false;
+            push(&vm, key);
+            if (!expect(parser, ':', "Expected ':' after object key.")) return false;
+            Value value;
+            if (!parseValue(parser, &value)) return false;
+            push(&vm, value);
+            tableSet(&dict->items, AS_STRING(key), value);
+            pop(&vm);
+            pop(&vm);
+            char c = peekChar(parser);
+            if (c == '}') {
+                parser->next++;
+                break;
+            }
+            if (!expect(parser, ',', "Expected ',' or '}' in object.")) return false;
+        }
+    }
+    *out = pop(&vm);
+    return true;
+}
+
+static bool parseValue(JsonParser* parser, Value* out) {
+    if (atEnd(parser)) return fail(parser, "Unexpected end of input.", parser->length);
+    size_t offset = parser->index.offsets[parser->next++];
+    switch (parser->text[offset]) {
+        case '{':
+        case '[': {
+            if (parser->depth >= JSON_MAX_DEPTH) return fail(parser, "Nesting too deep.", offset);
+            parser->depth++;
+            bool ok = parser->text[offset] == '{' ? parseObject(parser, out) : parseArray(parser, out);
+            parser->depth--;
+            return ok;
+        }
+        case '"':
+            return parseString(parser, offset, out);
+        case 't':
+            return parseLiteral(parser, offset, "true", BOOL_VAL(true), out);
+        case 'f':
+            return parseLiteral(parser, offset, "false", BOOL_VAL(false), out);
+        case 'n':
+            return parseLiteral(parser, offset, "null", NIL_VAL, out);
+        default:
+            if (parser->text[offset] == '-' || isDigit(parser->text[offset])) {
+                return parseNumber(parser, offset, out);
+            }
+            return fail(parser, "Unexpected character.", offset);
+    }
+}
+
+static bool initJsonParser(JsonParser* parser, const char* text, size_t length, JsonError* error) {
+    initCharClass();
+    error->message = NULL;
+    error->offset = 0;
+    parser->text = text;
+    parser->length = length;
+    parser->next = 0;
+    parser->depth = 0;
+    parser->scratch = NULL;
+    parser->scratchCapacity = 0;
+    parser->error = error;
+    parser->index.offsets = NULL;
+    if (length > UINT32_MAX) {
+        error->message = "Input too large.";
+        return false;
+    }
+    return buildIndex(text, length, &parser->index, error);
+}
+
+static void freeJsonParser(JsonParser* parser) {
+    free(parser->index.offsets);
+    free(parser->scratch);
+}
+
+bool jsonParse(const char* text, size_t length, Value* out, JsonError* error) {
+    JsonParser parser;
+    Value* stackTop = vm.stackTop;
+    bool ok = initJsonParser(&parser, text, length, error) && parseValue(&parser, out);
+    if (ok && !atEnd(&parser)) ok = fail(&parser, "Unexpected data after JSON value.", peekOffset(&parser));
+    freeJsonParser(&parser);
+    vm.stackTop = stackTop;
+    if (!ok) *out = NIL_VAL;
+    return ok;
+}
+
+// ----------------------------------------------------------------------------
+// On-demand access
+// ----------------------------------------------------------------------------
+
+// Steps over the value at the cursor using the index alone.
+static bool skipValue(JsonParser* parser) {
+    if (atEnd(parser)) return fail(parser, "Unexpected end of input.", parser->length);
+    char c = parser->text[parser->index.offsets[parser->next++]];
+    if (c == '"') {
+        parser->next++; // Closing quote
+    } else if (c == '{' || c == '[') {
+        int depth = 1;
+        while (depth > 0) {
+            if (atEnd(parser)) return fail(parser, "Unexpected end of input.", parser->length);
+            char inner = parser->text[parser->index.offsets[parser->next++]];
+            if (inner == '{' || inner == '[') {
+                depth++;
+            } else if (inner == '}' || inner == ']') {
+                depth--;
+            } else if (inner == '"') {
+                parser->next++;
+            }
+        }
+    }
+    return true;
+}
+
+static bool parseIndex(const JsonPathSegment* segment, size_t* index) {
+    if (segment->length == 0 || segment->length > 9) return false;
+    size_t value = 0;
+    for (size_t i = 0; i < segment->length; i++) {
+        if (!isDigit(segment->chars[i])) return false;
+        value = value * 10 + (size_t)(segment->chars[i] - '0');
+    }
+    *index = value;
+    return true;
+}
+
+// Moves the cursor onto the member or element 'segment' of the container at
+// the cursor; '*found' is false when there is none.
+static bool descend(JsonParser* parser, const JsonPathSegment* segment, bool* found) {
+    *found = false;
+    char c = peekChar(parser);
+    if (c == '[') {
+        size_t wanted;
+        if (!parseIndex(segment, &wanted)) return true;
+        parser->next++;
+        if (peekChar(parser) == ']') return true;
+        for (size_t i = 0; i < wanted; i++) {
+            if (!skipValue(parser)) return false;
+            if (peekChar(parser) != ',') return true;
+            parser->next++;
+        }
+        *found = true;
+        return true;
+    }
+    if (c != '{') return true;
+
+    parser->next++;
+    if (peekChar(parser) == '}') return true;
+    for (;;) {
+        size_t open = peekOffset(parser);
+        if (!expect(parser, '"', "Expected string key in object.")) return false;
+        if (atEnd(parser)) return fail(parser, "Unterminated string.", open);
+        size_t close = parser->index.offsets[parser->next++];
+        const char* key;
+        size_t length;
+        if (!decodeString(parser, open, close, &key, &length)) return false;
+        if (!expect(parser, ':', "Expected ':' after object key.")) return false;
+        if (length == segment->length && memcmp(key, segment->chars, length) == 0) {
+            *found = true;
+            return true;
+        }
+        if (!skipValue(parser)) return false;
+        if (peekChar(parser) != ',') return true;
+        parser->next++;
+    }
+}
+
+bool jsonGet(const char* text, size_t length, const JsonPathSegment* path, int pathLength,
+             Value* out, JsonError* error) {
+    JsonParser parser;
+    Value* stackTop = vm.stackTop;
+    *out = NIL_VAL;
+    bool ok = initJsonParser(&parser, text, length, error);
+    bool found = true;
+    for (int i = 0; ok && found && i < pathLength; i++) {
+        ok = descend(&parser, &path[i], &found);
+    }
+    if (ok && found) ok = parseValue(&parser, out);
+    freeJsonParser(&parser);
+    vm.stackTop = stackTop;
+    if (!ok) *out = NIL_VAL;
+    return ok;
+}
+
+// ----------------------------------------------------------------------------
+// Serializer
+// ----------------------------------------------------------------------------
+
+typedef struct {
+    char* chars;
+    size_t length;
+    size_t capacity;
+    bool failed;
+    JsonError* error;
+} JsonWriter;
+
+static bool reserveOutput(JsonWriter* writer, size_t extra) {
+    if (writer->length + extra <= writer->capacity) return true;
+    size_t capacity = writer->capacity < 256 ? 256 : writer->capacity;
+    while (capacity < writer->length + extra) capacity *= 2;
+    char* chars = (char*)realloc(writer->chars, capacity);
+    if (chars == NULL) {
+        writer->failed = true;
+        writer->error->message = "Out of memory.";
+        return false;
+    }
+    writer->chars = chars;
+    writer->capacity = capacity;
+    return true;
+}
+
+static void writeBytes(JsonWriter* writer, const char* bytes, size_t length) {
+    if (!reserveOutput(writer, length)) return;
+    memcpy(writer->chars + writer->length, bytes, length);
+    writer->length += length;
+}
+
+static void writeChar(JsonWriter* writer, char c) {
+    if (!reserveOutput(writer, 1)) return;
+    writer->chars[writer->length++] = c;
+}
+
+static void writeNumber(JsonWriter* writer, double number) {
+    if (number != number || number - number != 0) {
+        writeBytes(writer, "null", 4);
+        return;
+    }
+    // Integers below 2^53 skip printf
+    if (number > -9007199254740992.0 && number < 9007199254740992.0 && number == (double)(int64_t)number) {
+        int64_t value = (int64_t)number;
+        char digits[24];
+        int at = (int)sizeof(digits);
+        uint64_t magnitude = value < 0 ? (uint64_t)(-value) : (uint64_t)value;
+        do {
+            digits[--at] = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) digits[--at] = '-';
+        writeBytes(writer, digits + at, sizeof(digits) - (size_t)at);
+        return;
+    }
+    // Shortest of 15 or 17 significant digits that reads back exactly
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "%.15g", number);
+    if (strtod(buffer, NULL) != number) length = snprintf(buffer, sizeof(buffer), "%.17g", number);
+    writeBytes(writer, buffer, (size_t)length);
+}
+
+static void writeString(JsonWriter* writer, const char* s, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    writeChar(writer, '"');
+    size_t i = 0;
+    while (i < length && !writer->failed) {
+        size_t run = plainPrefix(s + i, length - i);
+        writeBytes(writer, s + i, run);
+        i += run;
+        if (i >= length) break;
+        char c = s[i++];
+        switch (c) {
+            case '"': writeBytes(writer, "\\\"", 2); break;
+            case '\\': writeBytes(writer, "\\\\", 2); break;
+            case '\b': writeBytes(writer, "\\b", 2); break;
+            case '\f': writeBytes(writer, "\\f", 2); break;
+            case '\n': writeBytes(writer, "\\n", 2); break;
+            case '\r': writeBytes(writer, "\\r", 2); break;
+            case '\t': writeBytes(writer, "\\t", 2); break;
+            default: {
+                char escape[6] = { '\\', 'u', '0', '0', hex[(c >> 4) & 0xF], hex[c & 0xF] };
+                writeBytes(writer, escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    writeChar(writer, '"');
+}
+
+static void writeValue(JsonWriter* writer, Value value, int depth);
+
+static void writeTable(JsonWriter* writer, Table* table, int depth) {
+    writeChar(writer, '{');
+    bool first = true;
+    for (int i = 0; i < table->capacity && !writer->failed; i++) {
+        Entry* entry = &table->entries[i];
+        if (entry->key == NULL) continue;
+        if (!first) writeChar(writer, ',');
+        first = false;
+        writeString(writer, entry->key->chars, (size_t)entry->key->length);
+        writeChar(writer, ':');
+        writeValue(writer, entry->value, depth + 1);
+    }
+    writeChar(writer, '}');
+}
+
+static void writeValue(JsonWriter* writer, Value value, int depth) {
+    if (writer->failed) return;
+    if (depth > JSON_MAX_DEPTH) {
+        writer->failed = true;
+        writer->error->message = "Nesting too deep (cyclic value?).";
+        return;
+    }
+    if (IS_BOOL(value)) {
+        if (AS_BOOL(value)) writeBytes(writer, "true", 4);
+        else writeBytes(writer, "false", 5);
+    } else if (IS_NUMBER(value)) {
+        writeNumber(writer, AS_NUMBER(value));
+    } else if (IS_STRING(value)) {
+        writeString(writer, AS_CSTRING(value), (size_t)AS_STRING(value)->length);
+    } else if (IS_LIST(value)) {
+        ObjList* list = AS_LIST(value);
+        writeChar(writer, '[');
+        for (int i = 0; i < list->count && !writer->failed; i++) {
+            if (i > 0) writeChar(writer, ',');
+            writeValue(writer, list->items[i], depth + 1);
+        }
+        writeChar(writer, ']');
+    } else if (IS_DICTIONARY(value)) {
+        writeTable(writer, &AS_DICTIONARY(value)->items, depth);
+    } else if (IS_INSTANCE(value)) {
+        writeTable(writer, &AS_INSTANCE(value)->fields, depth);
+    } else {
+        writeBytes(writer, "null", 4);
+    }
+}
+
+ObjString* jsonStringify(Value value, JsonError* error) {
+    initCharClass();
+    error->message = NULL;
+    error->offset = 0;
+    JsonWriter writer = { NULL, 0, 0, false, error };
+    writeValue(&writer, value, 0);
+    ObjString* result = NULL;
+    if (!writer.failed) {
+        if (writer.length > INT32_MAX) {
+            error->message = "Output too large.";
+        } else {
+            result = copyString(writer.chars, (int)writer.length);
+        }
+    }
+    free(writer.chars);
+    return result;
+}
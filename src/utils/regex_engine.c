@@ -0,0 +1,1381 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../../include/regex_engine.h"
+
+// SIMD Includes
+#if defined(_MSC_VER)
+  #if defined(_M_AMD64) || defined(_M_IX86)
+    #include <intrin.h>
+    #if defined(__AVX2__)
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#elif defined(__GNUC__) || defined(__clang__)
+  #if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #ifdef __AVX2__
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#endif
+
+#define REGEX_MAX_PROGRAM 20000 // Instructions, after expanding {n,m}
+#define REGEX_MAX_REPEAT  1000
+#define REGEX_MAX_DEPTH   256   // Nested groups
+#define DFA_MAX_STATES    512   // Cached states before the cache is flushed
+#define DFA_MAX_FLUSHES   8     // Per search, before giving up on the DFA
+#define DFA_EOT           256   // Pseudo-byte for the end of the text
+
+static inline int trailingZeros32(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Byte sets
+// ----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t bits[8];
+} ByteSet;
+
+static inline bool setHas(const ByteSet* set, int c) {
+    return (set->bits[c >> 5] >> (c & 31)) & 1;
+}
+
+static inline void setAdd(ByteSet* set, int c) {
+    set->bits[c >> 5] |= 1u << (c & 31);
+}
+
+static void setAddRange(ByteSet* set, int lo, int hi) {
+    for (int c = lo; c <= hi; c++) setAdd(set, c);
+}
+
+static void setAddSet(ByteSet* set, const ByteSet* other) {
+    for (int i = 0; i < 8; i++) set->bits[i] |= other->bits[i];
+}
+
+static void setNegate(ByteSet* set) {
+    for (int i = 0; i < 8; i++) set->bits[i] = ~set->bits[i];
+}
+
+static int setCount(const ByteSet* set) {
+    int count = 0;
+    for (int i = 0; i < 8; i++) {
+        uint32_t word = set->bits[i];
+        while (word) {
+            word &= word - 1;
+            count++;
+        }
+    }
+    return count;
+}
+
+static void setFoldCase(ByteSet* set) {
+    for (int c = 'a'; c <= 'z'; c++) {
+        if (setHas(set, c) || setHas(set, c - 32)) {
+            setAdd(set, c);
+            setAdd(set, c - 32);
+        }
+    }
+}
+
+static inline bool isWordByte(int c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// \d \w \s and their negations
+static bool classEscape(char c, ByteSet* set) {
+    ByteSet base;
+    memset(&base, 0, sizeof(base));
+    switch (c) {
+        case 'd': case 'D':
+            setAddRange(&base, '0', '9');
+            break;
+        case 'w': case 'W':
+            setAddRange(&base, 'a', 'z');
+            setAddRange(&base, 'A', 'Z');
+            setAddRange(&base, '0', '9');
+            setAdd(&base, '_');
+            break;
+        case 's': case 'S':
+            setAdd(&base, ' ');
+            setAddRange(&base, '\t', '\r');
+            break;
+        default:
+            return false;
+    }
+    if (c == 'D' || c == 'W' || c == 'S') setNegate(&base);
+    setAddSet(set, &base);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Parser: pattern text to syntax tree
+// ----------------------------------------------------------------------------
+
+typedef enum {
+    NODE_EMPTY,
+    NODE_SET,     // value: set index
+    NODE_ASSERT,  // value: RegexAssert
+    NODE_CAT,     // left, right
+    NODE_ALT,     // left, right
+    NODE_REPEAT,  // left: body; min, max (-1 unbounded), greedy
+    NODE_GROUP,   // left: body; value: group number
+} NodeType;
+
+typedef enum {
+    ASSERT_BOT,      // Start of text
+    ASSERT_EOT,      // End of text
+    ASSERT_BOL,      // Start of a line
+    ASSERT_EOL,      // End of a line
+    ASSERT_WORD,     // \b
+    ASSERT_NOT_WORD, // \B
+} RegexAssert;
+
+typedef struct {
+    NodeType type;
+    int left, right;
+    int value;
+    int min, max;
+    bool greedy;
+} Node;
+
+typedef struct {
+    const char* pattern;
+    int length;
+    int pos;
+    int flags;
+    Node* nodes;
+    int nodeCount;
+    int nodeCapacity;
+    ByteSet* sets;
+    int setCount;
+    int setCapacity;
+    int groupCount;
+    int depth;
+    const char* error;
+} RegexParser;
+
+static int addNode(RegexParser* parser, NodeType type, int left, int right, int value) {
+    if (parser->error != NULL) return -1;
+    if (parser->nodeCount == parser->nodeCapacity) {
+        int capacity = parser->nodeCapacity < 16 ? 16 : parser->nodeCapacity * 2;
+        Node* nodes = (Node*)realloc(parser->nodes, sizeof(Node) * capacity);
+        if (nodes == NULL) {
+            parser->error = "Out of memory.";
+            return -1;
+        }
+        parser->nodes = nodes;
+        parser->nodeCapacity = capacity;
+    }
+    Node* node = &parser->nodes[parser->nodeCount];
+    node->type = type;
+    node->left = left;
+    node->right = right;
+    node->value = value;
+    node->min = node->max = 0;
+    node->greedy = true;
+    return parser->nodeCount++;
+}
+
+static int addSetNode(RegexParser* parser, ByteSet* set) {
+    if (parser->error != NULL) return -1;
+    if (parser->flags & REGEX_ICASE) setFoldCase(set);
+    if (parser->setCount == parser->setCapacity) {
+        int capacity = parser->setCapacity < 8 ? 8 : parser->setCapacity * 2;
+        ByteSet* sets = (ByteSet*)realloc(parser->sets, sizeof(ByteSet) * capacity);
+        if (sets == NULL) {
+            parser->error = "Out of memory.";
+            return -1;
+        }
+        parser->sets = sets;
+        parser->setCapacity = capacity;
+    }
+    parser->sets[parser->setCount] = *set;
+    return addNode(parser, NODE_SET, -1, -1, parser->setCount++);
+}
+
+static int literalNode(RegexParser* parser, int c) {
+    ByteSet set;
+    memset(&set, 0, sizeof(set));
+    setAdd(&set, c);
+    return addSetNode(parser, &set);
+}
+
+static bool atPatternEnd(RegexParser* parser) {
+    return parser->pos >= parser->length;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Reads the byte an escape stands for, after the backslash. Returns -1 and
+// sets the error when it is not a single-byte escape.
+static int escapedByte(RegexParser* parser, bool inClass) {
+    char c = parser->pattern[parser->pos++];
+    switch (c) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case 'f': return '\f';
+        case 'v': return '\v';
+        case 'a': return '\a';
+        case 'e': return 0x1b;
+        case '0': return 0;
+        case 'x': {
+            if (parser->pos + 2 > parser->length) break;
+            int hi = hexValue(parser->pattern[parser->pos]);
+            int lo = hexValue(parser->pattern[parser->pos + 1]);
+            if (hi < 0 || lo < 0) break;
+            parser->pos += 2;
+            return hi * 16 + lo;
+        }
+        case 'b':
+            if (inClass) return '\b';
+            break;
+        default:
+            if (c >= '1' && c <= '9') {
+                parser->error = "Back-references are not supported.";
+                return -1;
+            }
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) return (unsigned char)c;
+            break;
+    }
+    parser->error = "Unknown escape sequence.";
+    return -1;
+}
+
+static int parseClass(RegexParser* parser) {
+    ByteSet set;
+    memset(&set, 0, sizeof(set));
+    bool negate = false;
+    if (!atPatternEnd(parser) && parser->pattern[parser->pos] == '^') {
+        negate = true;
+        parser->pos++;
+    }
+    bool first = true;
+    for (;;) {
+        if (atPatternEnd(parser)) {
+            parser->error = "Missing ']'.";
+            return -1;
+        }
+        char c = parser->pattern[parser->pos];
+        if (c == ']' && !first) {
+            parser->pos++;
+            break;
+        }
+        first = false;
+        parser->pos++;
+
+        int lo;
+        if (c == '\\') {
+            if (atPatternEnd(parser)) {
+                parser->error = "Trailing backslash.";
+                return -1;
+            }
+            if (classEscape(parser->pattern[parser->pos], &set)) {
+                parser->pos++;
+                continue;
+            }
+            lo = escapedByte(parser, true);
+            if (lo < 0) return -1;
+        } else {
+            lo = (unsigned char)c;
+        }
+
+        // A range, unless the '-' is the last character of the class
+        if (parser->pos + 1 < parser->length && parser->pattern[parser->pos] == '-' &&
+            parser->pattern[parser->pos + 1] != ']') {
+            parser->pos++;
+            char d = parser->pattern[parser->pos++];
+            int hi;
+            if (d == '\\') {
+                if (atPatternEnd(parser)) {
+                    parser->error = "Trailing backslash.";
+                    return -1;
+                }
+                hi = escapedByte(parser, true);
+                if (hi < 0) return -1;
+            } else {
+                hi = (unsigned char)d;
+            }
+            if (hi < lo) {
+                parser->error = "Character range is out of order.";
+                return -1;
+            }
+            setAddRange(&set, lo, hi);
+        } else {
+            setAdd(&set, lo);
+        }
+    }
+    if (negate) {
+        // Fold before negating so [^a] with 'i' excludes 'A' as well
+        if (parser->flags & REGEX_ICASE) setFoldCase(&set);
+        setNegate(&set);
+    }
+    return addSetNode(parser, &set);
+}
+
+static int parseAlternation(RegexParser* parser);
+
+static int parseAtom(RegexParser* parser) {
+    char c = parser->pattern[parser->pos++];
+    switch (c) {
+        case '(': {
+            if (++parser->depth > REGEX_MAX_DEPTH) {
+                parser->error = "Groups are nested too deeply.";
+                return -1;
+            }
+            int group = -1;
+            if (parser->pos < parser->length && parser->pattern[parser->pos] == '?') {
+                if (parser->pos + 1 < parser->length && parser->pattern[parser->pos + 1] == ':') {
+                    parser->pos += 2;
+                } else {
+                    parser->error = "Lookaround and named groups are not supported.";
+                    return -1;
+                }
+            } else {
+                group = ++parser->groupCount;
+            }
+            int body = parseAlternation(parser);
+            if (parser->error != NULL) return -1;
+            if (atPatternEnd(parser) || parser->pattern[parser->pos] != ')') {
+                parser->error = "Missing ')'.";
+                return -1;
+            }
+            parser->pos++;
+            parser->depth--;
+            return group < 0 ? body : addNode(parser, NODE_GROUP, body, -1, group);
+        }
+        case '[':
+            return parseClass(parser);
+        case '.': {
+            ByteSet set;
+            memset(&set, 0xff, sizeof(set));
+            if (!(parser->flags & REGEX_DOTALL)) set.bits['\n' >> 5] &= ~(1u << ('\n' & 31));
+            return addSetNode(parser, &set);
+        }
+        case '^':
+            return addNode(parser, NODE_ASSERT, -1, -1,
+                           (parser->flags & REGEX_MULTILINE) ? ASSERT_BOL : ASSERT_BOT);
+        case '$':
+            return addNode(parser, NODE_ASSERT, -1, -1,
+                           (parser->flags & REGEX_MULTILINE) ? ASSERT_EOL : ASSERT_EOT);
+        case '*': case '+': case '?':
+            parser->error = "Nothing to repeat.";
+            return -1;
+        case '\\': {
+            if (atPatternEnd(parser)) {
+                parser->error = "Trailing backslash.";
+                return -1;
+            }
+            char e = parser->pattern[parser->pos];
+            ByteSet set;
+            memset(&set, 0, sizeof(set));
+            if (classEscape(e, &set)) {
+                parser->pos++;
+                return addSetNode(parser, &set);
+            }
+            switch (e) {
+                case 'b': parser->pos++; return addNode(parser, NODE_ASSERT, -1, -1, ASSERT_WORD);
+                case 'B': parser->pos++; return addNode(parser, NODE_ASSERT, -1, -1, ASSERT_NOT_WORD);
+                case 'A': parser->pos++; return addNode(parser, NODE_ASSERT, -1, -1, ASSERT_BOT);
+                case 'z': parser->pos++; return addNode(parser, NODE_ASSERT, -1, -1, ASSERT_EOT);
+                default: break;
+            }
+            int byte = escapedByte(parser, false);
+            if (byte < 0) return -1;
+            return literalNode(parser, byte);
+        }
+        default:
+            return literalNode(parser, (unsigned char)c);
+    }
+}
+
+static bool readCount(RegexParser* parser, int* out) {
+    int start = parser->pos;
+    int value = 0;
+    while (parser->pos < parser->length && parser->pattern[parser->pos] >= '0' &&
+           parser->pattern[parser->pos] <= '9') {
+        value = value * 10 + (parser->pattern[parser->pos] - '0');
+        if (value > REGEX_MAX_REPEAT) value = REGEX_MAX_REPEAT + 1;
+        parser->pos++;
+    }
+    *out = value;
+    return parser->pos > start;
+}
+
+// Parses {n}, {n,} or {n,m}. A '{' that does not start one of these is left
+// alone and later read as a literal.
+static bool parseBraces(RegexParser* parser, int* min, int* max) {
+    int start = parser->pos;
+    parser->pos++;
+    if (!readCount(parser, min)) {
+        parser->pos = start;
+        return false;
+    }
+    *max = *min;
+    if (parser->pos < parser->length && parser->pattern[parser->pos] == ',') {
+        parser->pos++;
+        if (!readCount(parser, max)) *max = -1;
+    }
+    if (parser->pos >= parser->length || parser->pattern[parser->pos] != '}') {
+        parser->pos = start;
+        return false;
+    }
+    parser->pos++;
+    return true;
+}
+
+static int parseRepeat(RegexParser* parser) {
+    int atom = parseAtom(parser);
+    if (parser->error != NULL) return -1;
+    bool repeated = false;
+    while (!atPatternEnd(parser)) {
+        char c = parser->pattern[parser->pos];
+        int min, max;
+        if (c == '*') {
+            min = 0;
+            max = -1;
+            parser->pos++;
+        } else if (c == '+') {
+            min = 1;
+            max = -1;
+            parser->pos++;
+        } else if (c == '?') {
+            min = 0;
+            max = 1;
+            parser->pos++;
+        } else if (c == '{' && parseBraces(parser, &min, &max)) {
+            if (min > REGEX_MAX_REPEAT || max > REGEX_MAX_REPEAT) {
+                parser->error = "Repetition count is too large.";
+                return -1;
+            }
+            if (max != -1 && max < min) {
+                parser->error = "Repetition range is out of order.";
+                return -1;
+            }
+        } else {
+            break;
+        }
+        if (repeated) {
+            parser->error = "Nothing to repeat.";
+            return -1;
+        }
+        repeated = true;
+        bool greedy = true;
+        if (!atPatternEnd(parser) && parser->pattern[parser->pos] == '?') {
+            greedy = false;
+            parser->pos++;
+        }
+        int node = addNode(parser, NODE_REPEAT, atom, -1, 0);
+        if (node < 0) return -1;
+        parser->nodes[node].min = min;
+        parser->nodes[node].max = max;
+        parser->nodes[node].greedy = greedy;
+        atom = node;
+    }
+    return atom;
+}
+
+// Sequences and alternatives are built leaning right so that the compiler
+// walks them in a loop rather than recursing once per element.
+static int parseConcat(RegexParser* parser) {
+    int head = -1;
+    int tail = -1;
+    while (!atPatternEnd(parser) && parser->pattern[parser->pos] != '|' &&
+           parser->pattern[parser->pos] != ')') {
+        int item = parseRepeat(parser);
+        if (parser->error != NULL) return -1;
+        if (head < 0) {
+            head = item;
+        } else if (tail < 0) {
+            head = tail = addNode(parser, NODE_CAT, head, item, 0);
+        } else {
+            int cat = addNode(parser, NODE_CAT, parser->nodes[tail].right, item, 0);
+            if (cat < 0) return -1;
+            parser->nodes[tail].right = cat;
+            tail = cat;
+        }
+    }
+    return head >= 0 ? head : addNode(parser, NODE_EMPTY, -1, -1, 0);
+}
+
+static int parseAlternation(RegexParser* parser) {
+    int head = parseConcat(parser);
+    int tail = -1;
+    while (parser->error == NULL && !atPatternEnd(parser) && parser->pattern[parser->pos] == '|') {
+        parser->pos++;
+        int item = parseConcat(parser);
+        if (parser->error != NULL) return -1;
+        if (tail < 0) {
+            head = tail = addNode(parser, NODE_ALT, head, item, 0);
+        } else {
+            int alt = addNode(parser, NODE_ALT, parser->nodes[tail].right, item, 0);
+            if (alt < 0) return -1;
+            parser->nodes[tail].right = alt;
+            tail = alt;
+        }
+    }
+    return head;
+}
+
+// ----------------------------------------------------------------------------
+// Compiler: syntax tree to NFA program
+// ----------------------------------------------------------------------------
+
+typedef enum {
+    RX_SET,    // Consume a byte in sets[x]
+    RX_SPLIT,  // Continue at x, or at y with lower priority
+    RX_JMP,    // Continue at x
+    RX_SAVE,   // Record the position in capture slot x
+    RX_ASSERT, // Continue only if assertion x holds here
+    RX_MATCH,
+} RegexOp;
+
+typedef struct {
+    uint8_t op;
+    int x, y;
+} RegexInst;
+
+typedef struct {
+    int* trans;         // 257 per state: (next state << 1) | match-before-byte, -1 if not built
+    int* setStart;      // Each state's NFA positions, as a slice of 'pcs'
+    int* setLength;
+    uint8_t* context;
+    int stateCount;
+    int stateCapacity;
+    int* pcs;
+    int pcsCount;
+    int pcsCapacity;
+    int* table;         // Open-addressed: state index + 1, 0 when free
+    int tableCapacity;
+    int startStates[4];
+} Dfa;
+
+typedef struct {
+    int* dense;
+    int* sparse;
+    int count;
+    int* captures;      // slotCount per program position
+} ThreadList;
+
+typedef struct {
+    int pc;
+    int slot;           // >= 0 for a frame that restores a capture slot
+    int value;
+} PikeFrame;
+
+struct Regex {
+    RegexInst* program;
+    int programLength;
+    ByteSet* sets;
+    int groupCount;
+    int slotCount;
+
+    bool hasAssertions;
+    bool anchoredStart; // Begins with ^ (not multiline): only position 0 can match
+    bool nullable;      // Can match the empty string
+    bool isLiteral;     // The whole pattern is 'prefix'
+    char* prefix;       // Every match starts with these bytes
+    int prefixLength;
+    uint8_t firstBytes[3]; // Every match starts with one of these, when firstByteCount > 0
+    int firstByteCount;
+
+    // Scratch for closures, shared by the DFA builder and the Pike VM
+    uint32_t* marks;
+    uint32_t generation;
+    int* stack;
+    int* scratchA;
+    int* scratchB;
+
+    Dfa dfa;
+
+    ThreadList threads[2];
+    PikeFrame* frames;
+    int* work;
+};
+
+typedef struct {
+    RegexParser* parser;
+    RegexInst* program;
+    int length;
+    int capacity;
+    const char* error;
+} RegexCompiler;
+
+static int emit(RegexCompiler* compiler, RegexOp op, int x, int y) {
+    if (compiler->error != NULL) return -1;
+    if (compiler->length >= REGEX_MAX_PROGRAM) {
+        compiler->error = "Pattern is too large.";
+        return -1;
+    }
+    if (compiler->length == compiler->capacity) {
+        int capacity = compiler->capacity < 32 ? 32 : compiler->capacity * 2;
+        RegexInst* program = (RegexInst*)realloc(compiler->program, sizeof(RegexInst) * capacity);
+        if (program == NULL) {
+            compiler->error = "Out of memory.";
+            return -1;
+        }
+        compiler->program = program;
+        compiler->capacity = capacity;
+    }
+    RegexInst* inst = &compiler->program[compiler->length];
+    inst->op = (uint8_t)op;
+    inst->x = x;
+    inst->y = y;
+    return compiler->length++;
+}
+
+static void emitNode(RegexCompiler* compiler, int index) {
+    while (compiler->error == NULL) {
+        Node node = compiler->parser->nodes[index];
+        switch (node.type) {
+            case NODE_EMPTY:
+                return;
+            case NODE_SET:
+                emit(compiler, RX_SET, node.value, 0);
+                return;
+            case NODE_ASSERT:
+                emit(compiler, RX_ASSERT, node.value, 0);
+                return;
+            case NODE_CAT:
+                emitNode(compiler, node.left);
+                index = node.right;
+                continue;
+            case NODE_ALT: {
+                // Chain the exit jumps through their x fields, patch at the end
+                int exits = -1;
+                for (;;) {
+                    int split = emit(compiler, RX_SPLIT, 0, 0);
+                    if (split < 0) return;
+                    compiler->program[split].x = compiler->length;
+                    emitNode(compiler, node.left);
+                    int jump = emit(compiler, RX_JMP, exits, 0);
+                    if (jump < 0) return;
+                    exits = jump;
+                    compiler->program[split].y = compiler->length;
+                    if (compiler->parser->nodes[node.right].type != NODE_ALT) break;
+                    node = compiler->parser->nodes[node.right];
+                }
+                emitNode(compiler, node.right);
+                while (exits >= 0) {
+                    int next = compiler->program[exits].x;
+                    compiler->program[exits].x = compiler->length;
+                    exits = next;
+                }
+                return;
+            }
+            case NODE_GROUP:
+                emit(compiler, RX_SAVE, node.value * 2, 0);
+                emitNode(compiler, node.left);
+                emit(compiler, RX_SAVE, node.value * 2 + 1, 0);
+                return;
+            case NODE_REPEAT: {
+                if (node.max == -1 && node.min > 0) {
+                    // x{n,}: n - 1 copies, then a last copy that loops back
+                    for (int i = 0; i < node.min - 1 && compiler->error == NULL; i++) {
+                        emitNode(compiler, node.left);
+                    }
+                    int start = compiler->length;
+                    emitNode(compiler, node.left);
+                    int split = emit(compiler, RX_SPLIT, start, compiler->length + 1);
+                    if (split >= 0 && !node.greedy) {
+                        compiler->program[split].x = compiler->length;
+                        compiler->program[split].y = start;
+                    }
+                    return;
+                }
+                for (int i = 0; i < node.min && compiler->error == NULL; i++) {
+                    emitNode(compiler, node.left);
+                }
+                if (node.max == -1) {
+                    int split = emit(compiler, RX_SPLIT, 0, 0);
+                    if (split < 0) return;
+                    emitNode(compiler, node.left);
+                    emit(compiler, RX_JMP, split, 0);
+                    int body = split + 1;
+                    int exit = compiler->length;
+                    compiler->program[split].x = node.greedy ? body : exit;
+                    compiler->program[split].y = node.greedy ? exit : body;
+                    return;
+                }
+                // Optional copies, nested: x{0,2} is (x(x)?)?
+                int exits = -1;
+                for (int i = node.min; i < node.max && compiler->error == NULL; i++) {
+                    int split = emit(compiler, RX_SPLIT, 0, exits);
+                    if (split < 0) return;
+                    compiler->program[split].x = compiler->length;
+                    exits = split;
+                    emitNode(compiler, node.left);
+                }
+                while (exits >= 0 && compiler->error == NULL) {
+                    int next = compiler->program[exits].y;
+                    int body = exits + 1;
+                    compiler->program[exits].x = node.greedy ? body : compiler->length;
+                    compiler->program[exits].y = node.greedy ? compiler->length : body;
+                    exits = next;
+                }
+                return;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Assertions and closures
+// ----------------------------------------------------------------------------
+
+// What precedes a position, which is all an assertion needs to know about
+// the past
+enum { CONTEXT_START, CONTEXT_NEWLINE, CONTEXT_WORD, CONTEXT_OTHER };
+
+static inline int contextOf(int c) {
+    if (c == '\n') return CONTEXT_NEWLINE;
+    return isWordByte(c) ? CONTEXT_WORD : CONTEXT_OTHER;
+}
+
+static inline int contextAt(const char* text, int pos) {
+    return pos == 0 ? CONTEXT_START : contextOf((unsigned char)text[pos - 1]);
+}
+
+// 'next' is the following byte, or DFA_EOT at the end of the text
+static bool assertionHolds(int kind, int context, int next) {
+    switch (kind) {
+        case ASSERT_BOT: return context == CONTEXT_START;
+        case ASSERT_EOT: return next == DFA_EOT;
+        case ASSERT_BOL: return context == CONTEXT_START || context == CONTEXT_NEWLINE;
+        case ASSERT_EOL: return next == DFA_EOT || next == '\n';
+        case ASSERT_WORD:
+        case ASSERT_NOT_WORD: {
+            bool before = context == CONTEXT_WORD;
+            bool after = next != DFA_EOT && isWordByte(next);
+            return (before != after) == (kind == ASSERT_WORD);
+        }
+    }
+    return false;
+}
+
+static inline void nextGeneration(Regex* regex) {
+    if (++regex->generation == 0) {
+        memset(regex->marks, 0, sizeof(uint32_t) * regex->programLength);
+        regex->generation = 1;
+    }
+}
+
+// Follows empty transitions from 'in', writing the positions that consume
+// a byte or match to 'out'. With 'resolve' false assertions are kept in the
+// set unevaluated; with it true they are checked against (context, next).
+static int closure(Regex* regex, const int* in, int inCount, int* out, bool resolve, int context, int next) {
+    nextGeneration(regex);
+    int count = 0;
+    int top = 0;
+    for (int i = inCount - 1; i >= 0; i--) regex->stack[top++] = in[i];
+    while (top > 0) {
+        int pc = regex->stack[--top];
+        if (regex->marks[pc] == regex->generation) continue;
+        regex->marks[pc] = regex->generation;
+        RegexInst* inst = &regex->program[pc];
+        switch (inst->op) {
+            case RX_JMP:
+                regex->stack[top++] = inst->x;
+                break;
+            case RX_SPLIT:
+                regex->stack[top++] = inst->y;
+                regex->stack[top++] = inst->x;
+                break;
+            case RX_SAVE:
+                regex->stack[top++] = pc + 1;
+                break;
+            case RX_ASSERT:
+                if (!resolve) {
+                    out[count++] = pc;
+                } else if (assertionHolds(inst->x, context, next)) {
+                    regex->stack[top++] = pc + 1;
+                }
+                break;
+            default:
+                out[count++] = pc;
+                break;
+        }
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// Prefilters
+// ----------------------------------------------------------------------------
+
+// Position of the first occurrence of 'literal' in text[from..length), or -1
+static int findLiteral(const char* text, int length, int from, const char* literal, int literalLength) {
+    if (literalLength == 0) return from <= length ? from : -1;
+    int i = from;
+#ifdef PROX_SIMD_AVX2
+    // Compare the first and last byte of the literal at 32 positions at
+    // once and only check the rest where both agree
+    if (literalLength > 1) {
+        __m256i first = _mm256_set1_epi8(literal[0]);
+        __m256i last = _mm256_set1_epi8(literal[literalLength - 1]);
+        for (; i + literalLength - 1 + 32 <= length; i += 32) {
+            __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(text + i));
+            __m256i blockLast = _mm256_loadu_si256((const __m256i*)(text + i + literalLength - 1));
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+            while (mask != 0) {
+                int bit = trailingZeros32(mask);
+                if (memcmp(text + i + bit + 1, literal + 1, literalLength - 2) == 0) return i + bit;
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+    while (i + literalLength <= length) {
+        const char* hit = (const char*)memchr(text + i, literal[0], length - literalLength + 1 - i);
+        if (hit == NULL) return -1;
+        int at = (int)(hit - text);
+        if (memcmp(hit + 1, literal + 1, literalLength - 1) == 0) return at;
+        i = at + 1;
+    }
+    return -1;
+}
+
+// Position of the first byte in text[from..length) that is one of 'bytes'
+static int findAnyByte(const char* text, int length, int from, const uint8_t* bytes, int count) {
+    if (count == 1) {
+        const char* hit = (const char*)memchr(text + from, bytes[0], length - from);
+        return hit != NULL ? (int)(hit - text) : -1;
+    }
+    int i = from;
+#ifdef PROX_SIMD_AVX2
+    __m256i b0 = _mm256_set1_epi8((char)bytes[0]);
+    __m256i b1 = _mm256_set1_epi8((char)bytes[1]);
+    __m256i b2 = _mm256_set1_epi8((char)bytes[count > 2 ? 2 : 1]);
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(text + i));
+        __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, b0), _mm256_cmpeq_epi8(block, b1)),
+                                       _mm256_cmpeq_epi8(block, b2));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+        if (mask != 0) return i + trailingZeros32(mask);
+    }
+#endif
+    for (; i < length; i++) {
+        uint8_t c = (uint8_t)text[i];
+        if (c == bytes[0] || c == bytes[1] || (count > 2 && c == bytes[2])) return i;
+    }
+    return -1;
+}
+
+static bool hasPrefilter(const Regex* regex) {
+    return regex->prefixLength > 0 || regex->firstByteCount > 0;
+}
+
+// First position at or after 'from' where a match could start
+static int nextCandidate(const Regex* regex, const char* text, int length, int from) {
+    if (regex->prefixLength > 0) return findLiteral(text, length, from, regex->prefix, regex->prefixLength);
+    return findAnyByte(text, length, from, regex->firstBytes, regex->firstByteCount);
+}
+
+static void analyze(Regex* regex) {
+    for (int pc = 0; pc < regex->programLength; pc++) {
+        if (regex->program[pc].op == RX_ASSERT) regex->hasAssertions = true;
+    }
+
+    int pc = 0;
+    while (regex->program[pc].op == RX_SAVE) pc++;
+    regex->anchoredStart = regex->program[pc].op == RX_ASSERT && regex->program[pc].x == ASSERT_BOT;
+
+    // Literal prefix: the straight run of single-byte sets at the start
+    int prefixStart = pc;
+    while (regex->program[pc].op == RX_SET && setCount(&regex->sets[regex->program[pc].x]) == 1) pc++;
+    regex->prefixLength = pc - prefixStart;
+    if (regex->prefixLength > 0) {
+        regex->prefix = (char*)malloc(regex->prefixLength);
+        if (regex->prefix == NULL) {
+            regex->prefixLength = 0;
+        } else {
+            for (int i = 0; i < regex->prefixLength; i++) {
+                const ByteSet* set = &regex->sets[regex->program[prefixStart + i].x];
+                for (int c = 0; c < 256; c++) {
+                    if (setHas(set, c)) {
+                        regex->prefix[i] = (char)c;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    regex->isLiteral = regex->groupCount == 0 && regex->prefixLength == pc - prefixStart &&
+                       regex->program[pc].op == RX_SAVE && regex->program[pc + 1].op == RX_MATCH;
+
+    // First bytes: everything a match can begin with, if it cannot be empty.
+    // Assertions are treated as passable so the answer holds everywhere.
+    ByteSet first;
+    memset(&first, 0, sizeof(first));
+    nextGeneration(regex);
+    int top = 0;
+    regex->stack[top++] = 0;
+    while (top > 0) {
+        int at = regex->stack[--top];
+        if (regex->marks[at] == regex->generation) continue;
+        regex->marks[at] = regex->generation;
+        RegexInst* inst = &regex->program[at];
+        switch (inst->op) {
+            case RX_JMP: regex->stack[top++] = inst->x; break;
+            case RX_SPLIT: regex->stack[top++] = inst->y; regex->stack[top++] = inst->x; break;
+            case RX_SAVE:
+            case RX_ASSERT: regex->stack[top++] = at + 1; break;
+            case RX_SET: setAddSet(&first, &regex->sets[inst->x]); break;
+            case RX_MATCH: regex->nullable = true; break;
+        }
+    }
+    if (!regex->nullable && regex->prefixLength == 0 && setCount(&first) <= 3) {
+        for (int c = 0; c < 256; c++) {
+            if (setHas(&first, c)) regex->firstBytes[regex->firstByteCount++] = (uint8_t)c;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Compilation
+// ----------------------------------------------------------------------------
+
+Regex* regexCompile(const char* pattern, int length, int flags, const char** error) {
+    RegexParser parser;
+    memset(&parser, 0, sizeof(parser));
+    parser.pattern = pattern;
+    parser.length = length;
+    parser.flags = flags;
+
+    int root = parseAlternation(&parser);
+    if (parser.error == NULL && !atPatternEnd(&parser)) parser.error = "Unmatched ')'.";
+
+    RegexCompiler compiler;
+    memset(&compiler, 0, sizeof(compiler));
+    compiler.parser = &parser;
+    compiler.error = parser.error;
+    emit(&compiler, RX_SAVE, 0, 0);
+    if (compiler.error == NULL) emitNode(&compiler, root);
+    emit(&compiler, RX_SAVE, 1, 0);
+    emit(&compiler, RX_MATCH, 0, 0);
+    free(parser.nodes);
+
+    Regex* regex = compiler.error == NULL ? (Regex*)calloc(1, sizeof(Regex)) : NULL;
+    if (regex == NULL) {
+        *error = compiler.error != NULL ? compiler.error : "Out of memory.";
+        free(compiler.program);
+        free(parser.sets);
+        return NULL;
+    }
+    regex->program = compiler.program;
+    regex->programLength = compiler.length;
+    regex->sets = parser.sets;
+    regex->groupCount = parser.groupCount;
+    regex->slotCount = (parser.groupCount + 1) * 2;
+    regex->marks = (uint32_t*)calloc(regex->programLength, sizeof(uint32_t));
+    regex->stack = (int*)malloc(sizeof(int) * (regex->programLength * 3 + 1));
+    regex->scratchA = (int*)malloc(sizeof(int) * regex->programLength);
+    regex->scratchB = (int*)malloc(sizeof(int) * regex->programLength);
+    for (int i = 0; i < 4; i++) regex->dfa.startStates[i] = -1;
+    if (regex->marks == NULL || regex->stack == NULL || regex->scratchA == NULL || regex->scratchB == NULL) {
+        regexFree(regex);
+        *error = "Out of memory.";
+        return NULL;
+    }
+    analyze(regex);
+    *error = NULL;
+    return regex;
+}
+
+static void freeDfa(Dfa* dfa) {
+    free(dfa->trans);
+    free(dfa->setStart);
+    free(dfa->setLength);
+    free(dfa->context);
+    free(dfa->pcs);
+    free(dfa->table);
+    memset(dfa, 0, sizeof(*dfa));
+}
+
+void regexFree(Regex* regex) {
+    if (regex == NULL) return;
+    free(regex->program);
+    free(regex->sets);
+    free(regex->prefix);
+    free(regex->marks);
+    free(regex->stack);
+    free(regex->scratchA);
+    free(regex->scratchB);
+    freeDfa(&regex->dfa);
+    for (int i = 0; i < 2; i++) {
+        free(regex->threads[i].dense);
+        free(regex->threads[i].sparse);
+        free(regex->threads[i].captures);
+    }
+    free(regex->frames);
+    free(regex->work);
+    free(regex);
+}
+
+int regexGroupCount(const Regex* regex) {
+    return regex->groupCount;
+}
+
+// ----------------------------------------------------------------------------
+// Lazy DFA
+// ----------------------------------------------------------------------------
+
+#define DFA_GIVE_UP (-2)
+
+static int compareInts(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t hashState(const int* pcs, int count, int context) {
+    uint32_t hash = 2166136261u ^ (uint32_t)context;
+    for (int i = 0; i < count; i++) {
+        hash ^= (uint32_t)pcs[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void flushDfa(Dfa* dfa) {
+    dfa->stateCount = 0;
+    dfa->pcsCount = 0;
+    if (dfa->table != NULL) memset(dfa->table, 0, sizeof(int) * dfa->tableCapacity);
+    for (int i = 0; i < 4; i++) dfa->startStates[i] = -1;
+}
+
+static bool growDfa(Dfa* dfa) {
+    int capacity = dfa->stateCapacity < 16 ? 16 : dfa->stateCapacity * 2;
+    if (capacity > DFA_MAX_STATES) capacity = DFA_MAX_STATES;
+    int* trans = (int*)realloc(dfa->trans, sizeof(int) * 257 * capacity);
+    if (trans == NULL) return false;
+    dfa->trans = trans;
+    int* setStart = (int*)realloc(dfa->setStart, sizeof(int) * capacity);
+    if (setStart == NULL) return false;
+    dfa->setStart = setStart;
+    int* setLength = (int*)realloc(dfa->setLength, sizeof(int) * capacity);
+    if (setLength == NULL) return false;
+    dfa->setLength = setLength;
+    uint8_t* context = (uint8_t*)realloc(dfa->context, capacity);
+    if (context == NULL) return false;
+    dfa->context = context;
+    dfa->stateCapacity = capacity;
+
+    // Keep the table at most half full
+    int* table = (int*)calloc(capacity * 2, sizeof(int));
+    if (table == NULL) return false;
+    free(dfa->table);
+    dfa->table = table;
+    dfa->tableCapacity = capacity * 2;
+    for (int s = 0; s < dfa->stateCount; s++) {
+        uint32_t slot = hashState(dfa->pcs + dfa->setStart[s], dfa->setLength[s], dfa->context[s]) &
+                        (dfa->tableCapacity - 1);
+        while (dfa->table[slot] != 0) slot = (slot + 1) & (dfa->tableCapacity - 1);
+        dfa->table[slot] = s + 1;
+    }
+    return true;
+}
+
+// Finds or adds the state for a sorted set of positions. Sets 'flushed' when
+// the cache was full and had to be emptied first, which invalidates every
+// state index the caller holds.
+static int dfaState(Regex* regex, const int* pcs, int count, int context, bool* flushed) {
+    Dfa* dfa = &regex->dfa;
+    uint32_t hash = hashState(pcs, count, context);
+    if (dfa->tableCapacity > 0) {
+        uint32_t slot = hash & (dfa->tableCapacity - 1);
+        while (dfa->table[slot] != 0) {
+            int s = dfa->table[slot] - 1;
+            if (dfa->context[s] == context && dfa->setLength[s] == count &&
+                memcmp(dfa->pcs + dfa->setStart[s], pcs, sizeof(int) * count) == 0) {
+                return s;
+            }
+            slot = (slot + 1) & (dfa->tableCapacity - 1);
+        }
+    }
+
+    if (dfa->stateCount == dfa->stateCapacity) {
+        if (dfa->stateCapacity >= DFA_MAX_STATES) {
+            flushDfa(dfa);
+            *flushed = true;
+        } else if (!growDfa(dfa)) {
+            return DFA_GIVE_UP;
+        }
+    }
+    if (dfa->pcsCount + count > dfa->pcsCapacity) {
+        int capacity = dfa->pcsCapacity < 256 ? 256 : dfa->pcsCapacity;
+        while (capacity < dfa->pcsCount + count) capacity *= 2;
+        int* grown = (int*)realloc(dfa->pcs, sizeof(int) * capacity);
+        if (grown == NULL) return DFA_GIVE_UP;
+        dfa->pcs = grown;
+        dfa->pcsCapacity = capacity;
+    }
+
+    int s = dfa->stateCount++;
+    dfa->setStart[s] = dfa->pcsCount;
+    dfa->setLength[s] = count;
+    dfa->context[s] = (uint8_t)context;
+    memcpy(dfa->pcs + dfa->pcsCount, pcs, sizeof(int) * count);
+    dfa->pcsCount += count;
+    memset(dfa->trans + (size_t)s * 257, 0xff, sizeof(int) * 257);
+
+    uint32_t slot = hash & (dfa->tableCapacity - 1);
+    while (dfa->table[slot] != 0) slot = (slot + 1) & (dfa->tableCapacity - 1);
+    dfa->table[slot] = s + 1;
+    return s;
+}
+
+static int dfaStartState(Regex* regex, int context, bool* flushed) {
+    if (!regex->hasAssertions) context = 0;
+    if (regex->dfa.startStates[context] >= 0) return regex->dfa.startStates[context];
+    int start = 0;
+    int count = closure(regex, &start, 1, regex->scratchA, false, 0, 0);
+    qsort(regex->scratchA, count, sizeof(int), compareInts);
+    int s = dfaState(regex, regex->scratchA, count, context, flushed);
+    if (s >= 0) regex->dfa.startStates[context] = s;
+    return s;
+}
+
+// Builds the transition of state 's' on byte 'c' (or DFA_EOT) and returns
+// it encoded as (next << 1) | matched, where 'matched' says a match ends
+// just before 'c'.
+static int dfaTransition(Regex* regex, int s, int c, bool* flushed) {
+    Dfa* dfa = &regex->dfa;
+    int context = dfa->context[s];
+    int* current = regex->scratchA;
+    int count = dfa->setLength[s];
+    if (regex->hasAssertions) {
+        count = closure(regex, dfa->pcs + dfa->setStart[s], count, current, true, context, c);
+    } else {
+        memcpy(current, dfa->pcs + dfa->setStart[s], sizeof(int) * count);
+    }
+
+    bool matched = false;
+    int stepped = 0;
+    int* next = regex->scratchB;
+    for (int i = 0; i < count; i++) {
+        RegexInst* inst = &regex->program[current[i]];
+        if (inst->op == RX_MATCH) {
+            matched = true;
+        } else if (inst->op == RX_SET && c != DFA_EOT && setHas(&regex->sets[inst->x], c)) {
+            next[stepped++] = current[i] + 1;
+        }
+    }
+    if (c == DFA_EOT) {
+        int result = matched ? 1 : 0;
+        dfa->trans[(size_t)s * 257 + c] = result;
+        return result;
+    }
+    // Unanchored search: a new attempt starts after every byte
+    if (!regex->anchoredStart) next[stepped++] = 0;
+
+    int closed = closure(regex, next, stepped, current, false, 0, 0);
+    qsort(current, closed, sizeof(int), compareInts);
+    int target = dfaState(regex, current, closed, regex->hasAssertions ? contextOf(c) : 0, flushed);
+    if (target < 0) return target;
+    int result = (target << 1) | (matched ? 1 : 0);
+    if (!*flushed) dfa->trans[(size_t)s * 257 + c] = result;
+    return result;
+}
+
+// Returns 1 if a match ends somewhere in text[from..length], 0 if none
+// does, or DFA_GIVE_UP when the state cache keeps overflowing.
+static int dfaSearch(Regex* regex, const char* text, int length, int from) {
+    Dfa* dfa = &regex->dfa;
+    int flushes = 0;
+    bool flushed = false;
+    int s = dfaStartState(regex, contextAt(text, from), &flushed);
+    if (s < 0) return DFA_GIVE_UP;
+    bool skip = !regex->hasAssertions && !regex->nullable && hasPrefilter(regex);
+
+    int i = from;
+    for (;;) {
+        if (skip && s == dfa->startStates[0]) {
+            i = nextCandidate(regex, text, length, i);
+            if (i < 0) return 0;
+        }
+        int c = i < length ? (unsigned char)text[i] : DFA_EOT;
+        int t = dfa->trans[(size_t)s * 257 + c];
+        if (t < 0) {
+            flushed = false;
+            t = dfaTransition(regex, s, c, &flushed);
+            if (t == DFA_GIVE_UP) return DFA_GIVE_UP;
+            if (flushed && ++flushes > DFA_MAX_FLUSHES) return DFA_GIVE_UP;
+        }
+        if (t & 1) return 1;
+        if (c == DFA_EOT) return 0;
+        s = t >> 1;
+        if (regex->anchoredStart && dfa->setLength[s] == 0) return 0;
+        i++;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Pike VM
+// ----------------------------------------------------------------------------
+
+static bool initThreads(Regex* regex) {
+    if (regex->frames != NULL) return true;
+    int n = regex->programLength;
+    for (int i = 0; i < 2; i++) {
+        regex->threads[i].dense = (int*)malloc(sizeof(int) * n);
+        regex->threads[i].sparse = (int*)calloc(n, sizeof(int));
+        regex->threads[i].captures = (int*)malloc(sizeof(int) * n * regex->slotCount);
+        if (regex->threads[i].dense == NULL || regex->threads[i].sparse == NULL ||
+            regex->threads[i].captures == NULL) {
+            return false;
+        }
+    }
+    regex->work = (int*)malloc(sizeof(int) * regex->slotCount);
+    regex->frames = (PikeFrame*)malloc(sizeof(PikeFrame) * (n * 3 + 1));
+    return regex->work != NULL && regex->frames != NULL;
+}
+
+static inline bool threadListHas(const ThreadList* list, int pc) {
+    int index = list->sparse[pc];
+    return index < list->count && list->dense[index] == pc;
+}
+
+// Adds the thread at 'pc', and everything reachable from it without
+// consuming input, in priority order. 'captures' is updated in place while
+// walking and restored before returning.
+static void addThread(Regex* regex, ThreadList* list, int pc, int* captures, int pos, int context, int next) {
+    PikeFrame* frames = regex->frames;
+    int top = 0;
+    frames[top++] = (PikeFrame){ pc, -1, 0 };
+    while (top > 0) {
+        PikeFrame frame = frames[--top];
+        if (frame.slot >= 0) {
+            captures[frame.slot] = frame.value;
+            continue;
+        }
+        pc = frame.pc;
+        if (threadListHas(list, pc)) continue;
+        list->sparse[pc] = list->count;
+        list->dense[list->count++] = pc;
+        RegexInst* inst = &regex->program[pc];
+        switch (inst->op) {
+            case RX_JMP:
+                frames[top++] = (PikeFrame){ inst->x, -1, 0 };
+                break;
+            case RX_SPLIT:
+                frames[top++] = (PikeFrame){ inst->y, -1, 0 };
+                frames[top++] = (PikeFrame){ inst->x, -1, 0 };
+                break;
+            case RX_SAVE:
+                frames[top++] = (PikeFrame){ 0, inst->x, captures[inst->x] };
+                captures[inst->x] = pos;
+                frames[top++] = (PikeFrame){ pc + 1, -1, 0 };
+                break;
+            case RX_ASSERT:
+                if (assertionHolds(inst->x, context, next)) frames[top++] = (PikeFrame){ pc + 1, -1, 0 };
+                break;
+            default:
+                memcpy(list->captures + (size_t)pc * regex->slotCount, captures, sizeof(int) * regex->slotCount);
+                break;
+        }
+    }
+}
+
+static bool pikeSearch(Regex* regex, const char* text, int length, int from, int* captures) {
+    if (!initThreads(regex)) return false;
+    ThreadList* current = &regex->threads[0];
+    ThreadList* next = &regex->threads[1];
+    current->count = 0;
+    bool matched = false;
+    bool skip = !regex->nullable && hasPrefilter(regex);
+    int slots = regex->slotCount;
+
+    for (int pos = from;; pos++) {
+        if (!matched) {
+            if (current->count == 0 && skip) {
+                pos = nextCandidate(regex, text, length, pos);
+                if (pos < 0) break;
+            }
+            if (!regex->anchoredStart || pos == 0) {
+                for (int i = 0; i < slots; i++) regex->work[i] = -1;
+                addThread(regex, current, 0, regex->work, pos, contextAt(text, pos),
+                          pos < length ? (unsigned char)text[pos] : DFA_EOT);
+            }
+        }
+        if (current->count == 0) break;
+
+        int c = pos < length ? (unsigned char)text[pos] : DFA_EOT;
+        int afterContext = c == DFA_EOT ? CONTEXT_OTHER : contextOf(c);
+        int afterNext = pos + 1 < length ? (unsigned char)text[pos + 1] : DFA_EOT;
+        next->count = 0;
+        for (int i = 0; i < current->count; i++) {
+            int pc = current->dense[i];
+            RegexInst* inst = &regex->program[pc];
+            int* threadCaptures = current->captures + (size_t)pc * slots;
+            if (inst->op == RX_MATCH) {
+                memcpy(captures, threadCaptures, sizeof(int) * slots);
+                matched = true;
+                break; // Lower-priority threads can no longer win
+            }
+            if (inst->op == RX_SET && c != DFA_EOT && setHas(&regex->sets[inst->x], c)) {
+                memcpy(regex->work, threadCaptures, sizeof(int) * slots);
+                addThread(regex, next, pc + 1, regex->work, pos + 1, afterContext, afterNext);
+            }
+        }
+        ThreadList* swap = current;
+        current = next;
+        next = swap;
+        if (pos >= length) break;
+    }
+    return matched;
+}
+
+// ----------------------------------------------------------------------------
+// Entry points
+// ----------------------------------------------------------------------------
+
+bool regexTest(Regex* regex, const char* text, int length, int from) {
+    if (from < 0 || from > length) return false;
+    if (regex->isLiteral) return findLiteral(text, length, from, regex->prefix, regex->prefixLength) >= 0;
+    int found = dfaSearch(regex, text, length, from);
+    if (found != DFA_GIVE_UP) return found == 1;
+    int* captures = (int*)malloc(sizeof(int) * regex->slotCount);
+    if (captures == NULL) return false;
+    bool matched = pikeSearch(regex, text, length, from, captures);
+    free(captures);
+    return matched;
+}
+
+bool regexSearch(Regex* regex, const char* text, int length, int from, int* captures) {
+    if (from < 0 || from > length) return false;
+    if (regex->isLiteral) {
+        int at = findLiteral(text, length, from, regex->prefix, regex->prefixLength);
+        if (at < 0) return false;
+        captures[0] = at;
+        captures[1] = at + regex->prefixLength;
+        return true;
+    }
+    // The DFA rules out non-matching input cheaply; only then pay for the
+    // Pike VM to locate the match and its groups
+    if (dfaSearch(regex, text, length, from) == 0) return false;
+    return pikeSearch(regex, text, length, from, captures);
+}
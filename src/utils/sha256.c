@@ -2,6 +2,26 @@
 #include <memory.h>
 #include "../../include/sha256.h"
 
+// SIMD Includes
+#if defined(_MSC_VER)
+  #if defined(_M_AMD64) || defined(_M_IX86)
+    #include <intrin.h>
+    #if defined(__AVX2__)
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#elif defined(__GNUC__) || defined(__clang__)
+  #if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #if defined(__SHA__) && defined(__SSE4_1__)
+      #define PROX_SIMD_SHA
+    #endif
+    #ifdef __AVX2__
+      #define PROX_SIMD_AVX2
+    #endif
+  #endif
+#endif
+
 /*********************************************************************
 * Filename:   sha256.c
 * Author:     Brad Conte (brad AT bradconte.com)
@@ -31,23 +51,90 @@ static const uint32_t k[64] = {
 	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
 };
 
-void sha256_transform(SHA256_CTX *ctx, const unsigned char data[])
+static const uint32_t initial_state[8] = {
+	0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19
+};
+
+#ifndef PROX_SIMD_SHA
+static uint32_t load_be32(const unsigned char *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+#endif
+
+static void store_be32(unsigned char *p, uint32_t v)
+{
+	p[0] = (unsigned char)(v >> 24);
+	p[1] = (unsigned char)(v >> 16);
+	p[2] = (unsigned char)(v >> 8);
+	p[3] = (unsigned char)v;
+}
+
+#ifdef PROX_SIMD_SHA
+// SHA-NI: four rounds per pair of sha256rnds2, with the message schedule
+// computed by sha256msg1/sha256msg2 four words at a time
+static void sha256_blocks(uint32_t state[8], const unsigned char data[], size_t blocks)
+{
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i state0, state1, msg, tmp, abef, cdgh;
+	__m128i m[4];
+	int g;
+
+	tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+	state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+	tmp = _mm_shuffle_epi32(tmp, 0xB1);             // CDAB
+	state1 = _mm_shuffle_epi32(state1, 0x1B);       // EFGH
+	state0 = _mm_alignr_epi8(tmp, state1, 8);       // ABEF
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);    // CDGH
+
+	for (; blocks > 0; --blocks, data += 64) {
+		abef = state0;
+		cdgh = state1;
+		for (g = 0; g < 4; ++g)
+			m[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + g * 16)), mask);
+
+		for (g = 0; g < 16; ++g) {
+			msg = _mm_add_epi32(m[g & 3], _mm_loadu_si128((const __m128i *)&k[g * 4]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			if (g >= 3 && g < 15) {
+				tmp = _mm_alignr_epi8(m[g & 3], m[(g + 3) & 3], 4);
+				m[(g + 1) & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(m[(g + 1) & 3], tmp), m[g & 3]);
+			}
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+			if (g >= 1 && g < 13)
+				m[(g + 3) & 3] = _mm_sha256msg1_epu32(m[(g + 3) & 3], m[g & 3]);
+		}
+
+		state0 = _mm_add_epi32(state0, abef);
+		state1 = _mm_add_epi32(state1, cdgh);
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B);          // FEBA
+	state1 = _mm_shuffle_epi32(state1, 0xB1);       // DCHG
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);    // DCBA
+	state1 = _mm_alignr_epi8(state1, tmp, 8);       // ABEF
+	_mm_storeu_si128((__m128i *)&state[0], state0);
+	_mm_storeu_si128((__m128i *)&state[4], state1);
+}
+#else
+static void sha256_compress(uint32_t state[8], const unsigned char data[])
 {
-	uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+	uint32_t a, b, c, d, e, f, g, h, i, t1, t2, m[64];
 
-	for (i = 0, j = 0; i < 16; ++i, j += 4)
-		m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+	for (i = 0; i < 16; ++i)
+		m[i] = load_be32(data + i * 4);
 	for ( ; i < 64; ++i)
 		m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
 
-	a = ctx->state[0];
-	b = ctx->state[1];
-	c = ctx->state[2];
-	d = ctx->state[3];
-	e = ctx->state[4];
-	f = ctx->state[5];
-	g = ctx->state[6];
-	h = ctx->state[7];
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
 
 	for (i = 0; i < 64; ++i) {
 		t1 = h + EP1(e) + CH(e, f, g) + k[i] + m[i];
@@ -62,42 +149,62 @@ void sha256_transform(SHA256_CTX *ctx, const unsigned char data[])
 		a = t1 + t2;
 	}
 
-	ctx->state[0] += a;
-	ctx->state[1] += b;
-	ctx->state[2] += c;
-	ctx->state[3] += d;
-	ctx->state[4] += e;
-	ctx->state[5] += f;
-	ctx->state[6] += g;
-	ctx->state[7] += h;
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
 }
 
+static void sha256_blocks(uint32_t state[8], const unsigned char data[], size_t blocks)
+{
+	for (; blocks > 0; --blocks, data += 64)
+		sha256_compress(state, data);
+}
+#endif
+
 void sha256_init(SHA256_CTX *ctx)
 {
 	ctx->datalen = 0;
 	ctx->bitlen = 0;
-	ctx->state[0] = 0x6a09e667;
-	ctx->state[1] = 0xbb67ae85;
-	ctx->state[2] = 0x3c6ef372;
-	ctx->state[3] = 0xa54ff53a;
-	ctx->state[4] = 0x510e527f;
-	ctx->state[5] = 0x9b05688c;
-	ctx->state[6] = 0x1f83d9ab;
-	ctx->state[7] = 0x5be0cd19;
+	memcpy(ctx->state, initial_state, sizeof(initial_state));
 }
 
 void sha256_update(SHA256_CTX *ctx, const unsigned char data[], size_t len)
 {
-	uint32_t i;
+	size_t blocks;
 
-	for (i = 0; i < len; ++i) {
-		ctx->data[ctx->datalen] = data[i];
-		ctx->datalen++;
-		if (ctx->datalen == 64) {
-			sha256_transform(ctx, ctx->data);
-			ctx->bitlen += 512;
-			ctx->datalen = 0;
-		}
+	// Top up a partial block first, then compress whole blocks straight
+	// from the input and keep only the remainder
+	if (ctx->datalen > 0) {
+		size_t fill = 64 - ctx->datalen;
+		if (fill > len)
+			fill = len;
+		memcpy(ctx->data + ctx->datalen, data, fill);
+		ctx->datalen += (uint32_t)fill;
+		data += fill;
+		len -= fill;
+		if (ctx->datalen < 64)
+			return;
+		sha256_blocks(ctx->state, ctx->data, 1);
+		ctx->bitlen += 512;
+		ctx->datalen = 0;
+	}
+
+	blocks = len / 64;
+	if (blocks > 0) {
+		sha256_blocks(ctx->state, data, blocks);
+		ctx->bitlen += (uint64_t)blocks * 512;
+		data += blocks * 64;
+		len -= blocks * 64;
+	}
+
+	if (len > 0) {
+		memcpy(ctx->data, data, len);
+		ctx->datalen = (uint32_t)len;
 	}
 }
 
@@ -117,12 +224,12 @@ void sha256_final(SHA256_CTX *ctx, unsigned char hash[])
 		ctx->data[i++] = 0x80;
 		while (i < 64)
 			ctx->data[i++] = 0x00;
-		sha256_transform(ctx, ctx->data);
+		sha256_blocks(ctx->state, ctx->data, 1);
 		memset(ctx->data, 0, 56);
 	}
 
 	// Append number of bits
-	ctx->bitlen += ctx->datalen * 8;
+	ctx->bitlen += (uint64_t)ctx->datalen * 8;
 	ctx->data[63] = ctx->bitlen;
 	ctx->data[62] = ctx->bitlen >> 8;
 	ctx->data[61] = ctx->bitlen >> 16;
@@ -131,18 +238,176 @@ void sha256_final(SHA256_CTX *ctx, unsigned char hash[])
 	ctx->data[58] = ctx->bitlen >> 40;
 	ctx->data[57] = ctx->bitlen >> 48;
 	ctx->data[56] = ctx->bitlen >> 56;
-	sha256_transform(ctx, ctx->data);
+	sha256_blocks(ctx->state, ctx->data, 1);
 
 	// Since this implementation produces result in big-endian, and we usually want bytes...
-	
-	for (i = 0; i < 4; ++i) {
-		hash[i]      = (ctx->state[0] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 4]  = (ctx->state[1] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 8]  = (ctx->state[2] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 12] = (ctx->state[3] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 16] = (ctx->state[4] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 20] = (ctx->state[5] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 24] = (ctx->state[6] >> (24 - i * 8)) & 0x000000ff;
-		hash[i + 28] = (ctx->state[7] >> (24 - i * 8)) & 0x000000ff;
+	for (i = 0; i < 8; ++i)
+		store_be32(hash + i * 4, ctx->state[i]);
+}
+
+#if defined(PROX_SIMD_AVX2) && !defined(PROX_SIMD_SHA)
+// Eight-lane multi-buffer SHA-256. Each 32-bit lane of an __m256i carries
+// one message, so a single pass of the round function advances eight
+// independent hashes. When SHA-NI is available a single stream is faster,
+// so this path is only used without it.
+
+#define ROTR8(x,n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define EP0_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,2), ROTR8(x,13)), ROTR8(x,22))
+#define EP1_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,6), ROTR8(x,11)), ROTR8(x,25))
+#define SIG0_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,7), ROTR8(x,18)), _mm256_srli_epi32((x), 3))
+#define SIG1_8(x) _mm256_xor_si256(_mm256_xor_si256(ROTR8(x,17), ROTR8(x,19)), _mm256_srli_epi32((x), 10))
+
+typedef struct {
+	const unsigned char *data;
+	size_t len;
+	size_t block;       // Next block to compress
+	size_t blocks;      // Block count after padding
+	int index;          // Message being hashed, or -1 when the lane is idle
+} sha256_lane;
+
+// Block `block` of the padded message. Whole input blocks are read in
+// place; only the tail is assembled in scratch.
+static const unsigned char *sha256_padded_block(const sha256_lane *lane, unsigned char scratch[64])
+{
+	size_t offset = lane->block * 64;
+	int i;
+
+	if (offset + 64 <= lane->len)
+		return lane->data + offset;
+	memset(scratch, 0, 64);
+	if (offset < lane->len)
+		memcpy(scratch, lane->data + offset, lane->len - offset);
+	if (lane->len >= offset)
+		scratch[lane->len - offset] = 0x80;
+	if (lane->block == lane->blocks - 1) {
+		uint64_t bits = (uint64_t)lane->len * 8;
+		for (i = 0; i < 8; ++i)
+			scratch[63 - i] = (unsigned char)(bits >> (i * 8));
+	}
+	return scratch;
+}
+
+static void sha256_lane_start(sha256_lane *lane, uint32_t words[8][8], int slot,
+                              const unsigned char *data, size_t len, int index)
+{
+	int n;
+
+	lane->data = data;
+	lane->len = len;
+	lane->block = 0;
+	lane->blocks = (len + 8) / 64 + 1;
+	lane->index = index;
+	for (n = 0; n < 8; ++n)
+		words[n][slot] = initial_state[n];
+}
+
+static void sha256_transform8(__m256i state[8], const unsigned char *const blocks[8])
+{
+	__m256i w[64], a, b, c, d, e, f, g, h, t1, t2;
+	int i;
+
+	for (i = 0; i < 16; ++i)
+		w[i] = _mm256_setr_epi32((int)load_be32(blocks[0] + i * 4), (int)load_be32(blocks[1] + i * 4),
+		                         (int)load_be32(blocks[2] + i * 4), (int)load_be32(blocks[3] + i * 4),
+		                         (int)load_be32(blocks[4] + i * 4), (int)load_be32(blocks[5] + i * 4),
+		                         (int)load_be32(blocks[6] + i * 4), (int)load_be32(blocks[7] + i * 4));
+	for ( ; i < 64; ++i)
+		w[i] = _mm256_add_epi32(_mm256_add_epi32(SIG1_8(w[i - 2]), w[i - 7]),
+		                        _mm256_add_epi32(SIG0_8(w[i - 15]), w[i - 16]));
+
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
+
+	for (i = 0; i < 64; ++i) {
+		t1 = _mm256_add_epi32(_mm256_add_epi32(h, EP1_8(e)),
+		                      _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)));
+		t1 = _mm256_add_epi32(t1, _mm256_add_epi32(_mm256_set1_epi32((int)k[i]), w[i]));
+		t2 = _mm256_add_epi32(EP0_8(a), _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b),
+		                      _mm256_and_si256(a, c)), _mm256_and_si256(b, c)));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, t2);
+	}
+
+	state[0] = _mm256_add_epi32(state[0], a);
+	state[1] = _mm256_add_epi32(state[1], b);
+	state[2] = _mm256_add_epi32(state[2], c);
+	state[3] = _mm256_add_epi32(state[3], d);
+	state[4] = _mm256_add_epi32(state[4], e);
+	state[5] = _mm256_add_epi32(state[5], f);
+	state[6] = _mm256_add_epi32(state[6], g);
+	state[7] = _mm256_add_epi32(state[7], h);
+}
+
+void sha256_many(const unsigned char *const data[], const size_t lens[], int count,
+                 unsigned char hashes[][SHA256_BLOCK_SIZE])
+{
+	static const unsigned char idle[64] = {0};
+	unsigned char scratch[8][64];
+	uint32_t words[8][8];       // words[n][lane]
+	const unsigned char *blocks[8];
+	sha256_lane lanes[8];
+	__m256i state[8];
+	int next = 0, active = 0, lane, n;
+
+	// A lane that finishes takes the next waiting message, so short
+	// messages do not hold the other seven lanes back
+	for (lane = 0; lane < 8; ++lane) {
+		lanes[lane].index = -1;
+		if (next < count) {
+			sha256_lane_start(&lanes[lane], words, lane, data[next], lens[next], next);
+			next++;
+			active++;
+		}
+	}
+
+	while (active > 0) {
+		for (lane = 0; lane < 8; ++lane)
+			blocks[lane] = lanes[lane].index < 0 ? idle : sha256_padded_block(&lanes[lane], scratch[lane]);
+		for (n = 0; n < 8; ++n)
+			state[n] = _mm256_loadu_si256((const __m256i *)words[n]);
+		sha256_transform8(state, blocks);
+		for (n = 0; n < 8; ++n)
+			_mm256_storeu_si256((__m256i *)words[n], state[n]);
+
+		for (lane = 0; lane < 8; ++lane) {
+			sha256_lane *current = &lanes[lane];
+			if (current->index < 0 || ++current->block < current->blocks)
+				continue;
+			for (n = 0; n < 8; ++n)
+				store_be32(hashes[current->index] + n * 4, words[n][lane]);
+			current->index = -1;
+			active--;
+			if (next < count) {
+				sha256_lane_start(current, words, lane, data[next], lens[next], next);
+				next++;
+				active++;
+			}
+		}
+	}
+}
+#else
+void sha256_many(const unsigned char *const data[], const size_t lens[], int count,
+                 unsigned char hashes[][SHA256_BLOCK_SIZE])
+{
+	SHA256_CTX ctx;
+	int i;
+
+	for (i = 0; i < count; ++i) {
+		sha256_init(&ctx);
+		sha256_update(&ctx, data[i], lens[i]);
+		sha256_final(&ctx, hashes[i]);
 	}
 }
+#endif
@@ -0,0 +1,533 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+// --------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/scheduler.h"
+#include "../../include/sort.h"
+
+#define INSERTION_THRESHOLD 24
+#define NINTHER_THRESHOLD 128
+#define PARTIAL_INSERTION_LIMIT 8
+#define MAX_RUNS 85
+#define PARALLEL_RADIX_GRAIN 65536
+#define PARALLEL_SORT_GRAIN 8192
+
+uint64_t sortNumberKey(double number) {
+    uint64_t bits;
+    memcpy(&bits, &number, sizeof(bits));
+    // Negative numbers order backwards, so flip all their bits; positive
+    // ones only need to move above them
+    return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+}
+
+double sortNumberFromKey(uint64_t key) {
+    uint64_t bits = (key & SIGN_BIT) ? (key & ~SIGN_BIT) : ~key;
+    double number;
+    memcpy(&number, &bits, sizeof(number));
+    return number;
+}
+
+uint64_t sortStringPrefix(const char* chars, int length) {
+    uint64_t prefix = 0;
+    for (int i = 0; i < 8; i++) {
+        prefix <<= 8;
+        if (i < length) prefix |= (unsigned char)chars[i];
+    }
+    return prefix;
+}
+
+// --- Radix sort ---
+
+void sortRadix(uint64_t* keys, uint32_t* indices, uint64_t* keyScratch,
+               uint32_t* indexScratch, size_t count) {
+    if (count < 2) return;
+
+    // All eight digit histograms in one pass
+    size_t histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = keys[i];
+        for (int digit = 0; digit < 8; digit++) {
+            histograms[digit][(key >> (digit * 8)) & 0xff]++;
+        }
+    }
+
+    uint64_t* keysFrom = keys;
+    uint64_t* keysTo = keyScratch;
+    uint32_t* indicesFrom = indices;
+    uint32_t* indicesTo = indexScratch;
+
+    for (int digit = 0; digit < 8; digit++) {
+        int shift = digit * 8;
+        size_t* counts = histograms[digit];
+        // Every key shares this digit (common for small integers): skip it
+        if (counts[(keysFrom[0] >> shift) & 0xff] == count) continue;
+
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            size_t n = counts[bucket];
+            counts[bucket] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; i++) {
+            size_t slot = counts[(keysFrom[i] >> shift) & 0xff]++;
+            keysTo[slot] = keysFrom[i];
+            if (indices) indicesTo[slot] = indicesFrom[i];
+        }
+
+        uint64_t* keySwap = keysFrom;
+        keysFrom = keysTo;
+        keysTo = keySwap;
+        uint32_t* indexSwap = indicesFrom;
+        indicesFrom = indicesTo;
+        indicesTo = indexSwap;
+    }
+
+    if (keysFrom != keys) {
+        memcpy(keys, keysFrom, count * sizeof(uint64_t));
+        if (indices) memcpy(indices, indicesFrom, count * sizeof(uint32_t));
+    }
+}
+
+// --- Pattern-defeating quicksort ---
+
+static void swapItems(SortItem* a, SortItem* b) {
+    SortItem tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+static void insertionSort(SortItem* items, size_t count, SortLess less, void* context) {
+    for (size_t i = 1; i < count; i++) {
+        SortItem item = items[i];
+        size_t j = i;
+        while (j > 0 && less(&item, &items[j - 1], context)) {
+            items[j] = items[j - 1];
+            j--;
+        }
+        items[j] = item;
+    }
+}
+
+// Insertion sort that gives up once it has moved too many items, to
+// finish off partitions that look sorted already
+static bool partialInsertionSort(SortItem* items, size_t count, SortLess less, void* context) {
+    size_t moves = 0;
+    for (size_t i = 1; i < count; i++) {
+        SortItem item = items[i];
+        size_t j = i;
+        while (j > 0 && less(&item, &items[j - 1], context)) {
+            items[j] = items[j - 1];
+            j--;
+        }
+        items[j] = item;
+        moves += i - j;
+        if (moves > PARTIAL_INSERTION_LIMIT) return false;
+    }
+    return true;
+}
+
+static void sort2(SortItem* items, size_t a, size_t b, SortLess less, void* context) {
+    if (less(&items[b], &items[a], context)) swapItems(&items[a], &items[b]);
+}
+
+static void sort3(SortItem* items, size_t a, size_t b, size_t c, SortLess less, void* context) {
+    sort2(items, a, b, less, context);
+    sort2(items, b, c, less, context);
+    sort2(items, a, b, less, context);
+}
+
+static void siftDown(SortItem* items, size_t root, size_t count, SortLess less, void* context) {
+    for (;;) {
+        size_t child = root * 2 + 1;
+        if (child >= count) return;
+        if (child + 1 < count && less(&items[child], &items[child + 1], context)) child++;
+        if (!less(&items[root], &items[child], context)) return;
+        swapItems(&items[root], &items[child]);
+        root = child;
+    }
+}
+
+static void heapSort(SortItem* items, size_t count, SortLess less, void* context) {
+    for (size_t i = count / 2; i-- > 0;) siftDown(items, i, count, less, context);
+    for (size_t end = count; end-- > 1;) {
+        swapItems(&items[0], &items[end]);
+        siftDown(items, 0, end, less, context);
+    }
+}
+
+// Partitions around the pivot in items[0]: smaller items to its left, the
+// rest to its right. Every scan is bounded, so an inconsistent comparison
+// can misorder items but never step outside the range.
+static size_t partitionRight(SortItem* items, size_t count, bool* alreadyPartitioned,
+                             SortLess less, void* context) {
+    SortItem pivot = items[0];
+    size_t i = 1;
+    size_t j = count - 1;
+
+    while (i <= j && less(&items[i], &pivot, context)) i++;
+    while (j >= i && !less(&items[j], &pivot, context)) j--;
+    *alreadyPartitioned = i > j;
+
+    while (i < j) {
+        swapItems(&items[i], &items[j]);
+        i++;
+        j--;
+        while (i <= j && less(&items[i], &pivot, context)) i++;
+        while (j >= i && !less(&items[j], &pivot, context)) j--;
+    }
+
+    size_t pivotPos = i - 1;
+    items[0] = items[pivotPos];
+    items[pivotPos] = pivot;
+    return pivotPos;
+}
+
+// Like partitionRight, but keeps items equal to the pivot on its left.
+// Used when the pivot equals the item before the range, so everything
+// on the left is equal and needs no further sorting.
+static size_t partitionLeft(SortItem* items, size_t count, SortLess less, void* context) {
+    SortItem pivot = items[0];
+    size_t i = 1;
+    size_t j = count - 1;
+
+    while (j >= i && less(&pivot, &items[j], context)) j--;
+    while (i <= j && !less(&pivot, &items[i], context)) i++;
+
+    while (i < j) {
+        swapItems(&items[i], &items[j]);
+        i++;
+        j--;
+        while (j >= i && less(&pivot, &items[j], context)) j--;
+        while (i <= j && !less(&pivot, &items[i], context)) i++;
+    }
+
+    size_t pivotPos = i - 1;
+    items[0] = items[pivotPos];
+    items[pivotPos] = pivot;
+    return pivotPos;
+}
+
+static void pdqLoop(SortItem* items, size_t count, SortLess less, void* context,
+                    int badAllowed, bool leftmost) {
+    for (;;) {
+        if (count < INSERTION_THRESHOLD) {
+            insertionSort(items, count, less, context);
+            return;
+        }
+
+        // Move the median of three (or the pseudomedian of nine) to the front
+        size_t half = count / 2;
+        if (count > NINTHER_THRESHOLD) {
+            sort3(items, 0, half, count - 1, less, context);
+            sort3(items, 1, half - 1, count - 2, less, context);
+            sort3(items, 2, half + 1, count - 3, less, context);
+            sort3(items, half - 1, half, half + 1, less, context);
+            swapItems(&items[0], &items[half]);
+        } else {
+            sort3(items, half, 0, count - 1, less, context);
+        }
+
+        if (!leftmost && !less(&items[-1], &items[0], context)) {
+            size_t pivotPos = partitionLeft(items, count, less, context);
+            items += pivotPos + 1;
+            count -= pivotPos + 1;
+            continue;
+        }
+
+        bool alreadyPartitioned;
+        size_t pivotPos = partitionRight(items, count, &alreadyPartitioned, less, context);
+        size_t leftCount = pivotPos;
+        size_t rightCount = count - pivotPos - 1;
+
+        if (leftCount < count / 8 || rightCount < count / 8) {
+            // Too many bad pivots means an adversarial pattern: stop at
+            // O(n log n) with heapsort
+            if (--badAllowed == 0) {
+                heapSort(items, count, less, context);
+                return;
+            }
+            // Otherwise shuffle a few items to break the pattern up
+            if (leftCount >= INSERTION_THRESHOLD) {
+                swapItems(&items[0], &items[leftCount / 4]);
+                swapItems(&items[pivotPos - 1], &items[pivotPos - leftCount / 4]);
+            }
+            if (rightCount >= INSERTION_THRESHOLD) {
+                swapItems(&items[pivotPos + 1], &items[pivotPos + 1 + rightCount / 4]);
+                swapItems(&items[count - 1], &items[count - rightCount / 4]);
+            }
+        } else if (alreadyPartitioned &&
+                   partialInsertionSort(items, leftCount, less, context) &&
+                   partialInsertionSort(items + pivotPos + 1, rightCount, less, context)) {
+            return;
+        }
+
+        // Recurse into the smaller side and loop on the larger one, which
+        // bounds the stack depth by log2(count)
+        if (leftCount < rightCount) {
+            pdqLoop(items, leftCount, less, context, badAllowed, leftmost);
+            items += pivotPos + 1;
+            count = rightCount;
+            leftmost = false;
+        } else {
+            pdqLoop(items + pivotPos + 1, rightCount, less, context, badAllowed, false);
+            count = leftCount;
+        }
+    }
+}
+
+void sortPdq(SortItem* items, size_t count, SortLess less, void* context) {
+    if (count < 2) return;
+    int badAllowed = 1;
+    for (size_t n = count; n > 1; n >>= 1) badAllowed++;
+    pdqLoop(items, count, less, context, badAllowed, true);
+}
+
+// --- Stable natural merge sort ---
+
+typedef struct {
+    size_t base;
+    size_t length;
+} SortRun;
+
+static size_t minRunLength(size_t count) {
+    size_t extra = 0;
+    while (count >= 64) {
+        extra |= count & 1;
+        count >>= 1;
+    }
+    return count + extra;
+}
+
+static void reverseItems(SortItem* items, size_t count) {
+    for (size_t i = 0, j = count - 1; i < j; i++, j--) swapItems(&items[i], &items[j]);
+}
+
+// Length of the run at the start of items. A strictly descending run is
+// reversed in place, which keeps the sort stable.
+static size_t countRun(SortItem* items, size_t count, SortLess less, void* context) {
+    if (count < 2) return count;
+    size_t run = 2;
+    if (less(&items[1], &items[0], context)) {
+        while (run < count && less(&items[run], &items[run - 1], context)) run++;
+        reverseItems(items, run);
+    } else {
+        while (run < count && !less(&items[run], &items[run - 1], context)) run++;
+    }
+    return run;
+}
+
+// Extends the sorted prefix items[0, sorted) to the whole range, inserting
+// after equal items
+static void binaryInsertionSort(SortItem* items, size_t count, size_t sorted,
+                                SortLess less, void* context) {
+    for (size_t i = sorted; i < count; i++) {
+        SortItem item = items[i];
+        size_t lo = 0;
+        size_t hi = i;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (less(&item, &items[mid], context)) hi = mid;
+            else lo = mid + 1;
+        }
+        memmove(&items[lo + 1], &items[lo], (i - lo) * sizeof(SortItem));
+        items[lo] = item;
+    }
+}
+
+// Merges the adjacent sorted ranges items[0, leftCount) and
+// items[leftCount, leftCount + rightCount), copying the smaller one out
+static void mergeRuns(SortItem* items, size_t leftCount, size_t rightCount,
+                      SortItem* scratch, SortLess less, void* context) {
+    SortItem* right = items + leftCount;
+    if (!less(&right[0], &right[-1], context)) return;
+
+    if (leftCount <= rightCount) {
+        memcpy(scratch, items, leftCount * sizeof(SortItem));
+        size_t i = 0, j = 0, k = 0;
+        while (i < leftCount && j < rightCount) {
+            if (less(&right[j], &scratch[i], context)) items[k++] = right[j++];
+            else items[k++] = scratch[i++];
+        }
+        memcpy(&items[k], &scratch[i], (leftCount - i) * sizeof(SortItem));
+    } else {
+        memcpy(scratch, right, rightCount * sizeof(SortItem));
+        size_t i = leftCount, j = rightCount, k = leftCount + rightCount;
+        while (i > 0 && j > 0) {
+            if (less(&scratch[j - 1], &items[i - 1], context)) items[--k] = items[--i];
+            else items[--k] = scratch[--j];
+        }
+        memcpy(items, scratch, j * sizeof(SortItem));
+    }
+}
+
+static void mergeAt(SortItem* items, SortRun* runs, int* runCount, int at,
+                    SortItem* scratch, SortLess less, void* context) {
+    SortRun* left = &runs[at];
+    SortRun* right = &runs[at + 1];
+    mergeRuns(items + left->base, left->length, right->length, scratch, less, context);
+    left->length += right->length;
+    if (at + 2 < *runCount) runs[at + 1] = runs[at + 2];
+    (*runCount)--;
+}
+
+void sortTim(SortItem* items, SortItem* scratch, size_t count, SortLess less, void* context) {
+    if (count < 2) return;
+
+    SortRun runs[MAX_RUNS];
+    int runCount = 0;
+    size_t minRun = minRunLength(count);
+    size_t base = 0;
+
+    while (base < count) {
+        size_t remaining = count - base;
+        size_t run = countRun(items + base, remaining, less, context);
+        if (run < minRun) {
+            size_t forced = remaining < minRun ? remaining : minRun;
+            binaryInsertionSort(items + base, forced, run, less, context);
+            run = forced;
+        }
+        runs[runCount].base = base;
+        runs[runCount].length = run;
+        runCount++;
+        base += run;
+
+        // Keep run lengths decreasing faster than the Fibonacci numbers, so
+        // merges stay balanced and the stack stays short
+        while (runCount > 1) {
+            int n = runCount - 2;
+            if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+                (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+                if (runs[n - 1].length < runs[n + 1].length) n--;
+            } else if (runs[n].length > runs[n + 1].length) {
+                break;
+            }
+            mergeAt(items, runs, &runCount, n, scratch, less, context);
+        }
+    }
+
+    while (runCount > 1) {
+        int n = runCount - 2;
+        if (n > 0 && runs[n - 1].length < runs[n + 1].length) n--;
+        mergeAt(items, runs, &runCount, n, scratch, less, context);
+    }
+}
+
+// --- Parallel sorts ---
+
+typedef struct {
+    uint64_t* from;
+    uint64_t* to;
+    size_t grain;
+    int shift;
+    size_t (*counts)[256]; // Per chunk: digit histogram, then scatter offsets
+} RadixPass;
+
+static void radixCountChunk(size_t begin, size_t end, void* context) {
+    RadixPass* pass = (RadixPass*)context;
+    size_t* counts = pass->counts[begin / pass->grain];
+    memset(counts, 0, sizeof(size_t) * 256);
+    for (size_t i = begin; i < end; i++) counts[(pass->from[i] >> pass->shift) & 0xff]++;
+}
+
+static void radixScatterChunk(size_t begin, size_t end, void* context) {
+    RadixPass* pass = (RadixPass*)context;
+    size_t* offsets = pass->counts[begin / pass->grain];
+    for (size_t i = begin; i < end; i++) {
+        uint64_t key = pass->from[i];
+        pass->to[offsets[(key >> pass->shift) & 0xff]++] = key;
+    }
+}
+
+void sortRadixParallel(uint64_t* keys, uint64_t* keyScratch, size_t count) {
+    size_t grain = scheduler_grain(count, PARALLEL_RADIX_GRAIN);
+    size_t chunks = (count + grain - 1) / grain;
+    size_t (*counts)[256] = chunks > 1 ? (size_t(*)[256])malloc(sizeof(size_t) * 256 * chunks) : NULL;
+    if (counts == NULL) {
+        sortRadix(keys, NULL, keyScratch, NULL, count);
+        return;
+    }
+
+    RadixPass pass = { keys, keyScratch, grain, 0, counts };
+    for (int digit = 0; digit < 8; digit++) {
+        pass.shift = digit * 8;
+        scheduler_parallel_for(count, grain, radixCountChunk, &pass);
+
+        size_t first = (pass.from[0] >> pass.shift) & 0xff;
+        size_t shared = 0;
+        for (size_t chunk = 0; chunk < chunks; chunk++) shared += counts[chunk][first];
+        if (shared == count) continue;
+
+        // Bucket by bucket, chunk by chunk, so equal digits keep their order
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                size_t n = counts[chunk][bucket];
+                counts[chunk][bucket] = offset;
+                offset += n;
+            }
+        }
+        scheduler_parallel_for(count, grain, radixScatterChunk, &pass);
+
+        uint64_t* swap = pass.from;
+        pass.from = pass.to;
+        pass.to = swap;
+    }
+
+    if (pass.from != keys) memcpy(keys, pass.from, count * sizeof(uint64_t));
+    free(counts);
+}
+
+typedef struct {
+    SortItem* from;
+    SortItem* to;
+    size_t count;
+    size_t width;
+    SortLess less;
+    void* context;
+} MergePass;
+
+static void sortChunk(size_t begin, size_t end, void* context) {
+    MergePass* pass = (MergePass*)context;
+    sortPdq(pass->from + begin, end - begin, pass->less, pass->context);
+}
+
+// Merges pairs of adjacent sorted runs of 'width' items into 'to'
+static void mergePairs(size_t begin, size_t end, void* context) {
+    MergePass* pass = (MergePass*)context;
+    for (size_t pair = begin; pair < end; pair++) {
+        size_t lo = pair * 2 * pass->width;
+        size_t mid = lo + pass->width < pass->count ? lo + pass->width : pass->count;
+        size_t hi = mid + pass->width < pass->count ? mid + pass->width : pass->count;
+        size_t i = lo, j = mid, k = lo;
+        while (i < mid && j < hi) {
+            if (pass->less(&pass->from[j], &pass->from[i], pass->context)) pass->to[k++] = pass->from[j++];
+            else pass->to[k++] = pass->from[i++];
+        }
+        memcpy(&pass->to[k], &pass->from[i], (mid - i) * sizeof(SortItem));
+        k += mid - i;
+        memcpy(&pass->to[k], &pass->from[j], (hi - j) * sizeof(SortItem));
+    }
+}
+
+void sortParallel(SortItem* items, SortItem* scratch, size_t count, SortLess less, void* context) {
+    size_t grain = scheduler_grain(count, PARALLEL_SORT_GRAIN);
+    MergePass pass = { items, scratch, count, grain, less, context };
+    scheduler_parallel_for(count, grain, sortChunk, &pass);
+
+    for (; pass.width < count; pass.width *= 2) {
+        size_t pairs = (count + 2 * pass.width - 1) / (2 * pass.width);
+        scheduler_parallel_for(pairs, 1, mergePairs, &pass);
+        SortItem* swap = pass.from;
+        pass.from = pass.to;
+        pass.to = swap;
+    }
+
+    if (pass.from != items) memcpy(items, pass.from, count * sizeof(SortItem));
+}
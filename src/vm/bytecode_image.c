@@ -0,0 +1,954 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/*
+  Versioned bytecode image format (.proxc) and the compile cache built on it.
+
+  Images are laid out to be mmap'ed and used in place. Everything is in the
+  writer's native byte order and struct layout; the header records the
+  pointer size, byte order and string header size, and images built for a
+  different ABI are rejected (the cache then simply recompiles).
+
+    ImageHeader
+    string records   preformed ObjString objects (16-byte aligned)
+    string table     u32 offset per string record
+    code             raw bytecode per function
+    lines            int32 line per code byte (4-byte aligned)
+    constants        ImageConstant per constant (8-byte aligned)
+    handlers         u32 (start, end, handler) triples
+    function table   ImageFunction per function, index 0 is the script
+
+  Code and line tables are referenced directly by the loaded chunks.
+  String records carry their precomputed hash and are pre-marked, so they
+  can join the intern table without copying or rehashing and the collector
+  never writes to (or frees) them. Nested functions are referenced by index,
+  so the function table needs no relocation; only constant pools are built
+  on the heap, at O(1) per constant.
+
+  Loading validates before it publishes anything. Every offset and length
+  is bounds-checked, and every instruction's operands are checked against
+  its function: constant indices against the pool, upvalue and capture
+  indices against the counts, closure descriptors against the enclosing
+  function, and jump and handler targets against instruction boundaries.
+  Local slots have no static bound, so everything after the string table
+  is also covered by a CRC32C. String pages are never read in full; each
+  record is checked only for its header and terminator.
+*/
+
+#include "../../include/bytecode_image.h"
+#include "../../include/bytecode.h"
+#include "../../include/object.h"
+#include "../../include/memory.h"
+#include "../../include/table.h"
+#include "../../include/vm.h"
+#include "../../include/sha256.h"
+#include "../../include/checksum.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define MKDIR(d) _mkdir(d)
+#define GETPID() _getpid()
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MKDIR(d) mkdir(d, 0777)
+#define GETPID() getpid()
+#endif
+
+#define CONST_VALUE    1 // nil, bool or number: raw Value bits
+#define CONST_STRING   2
+#define CONST_FUNCTION 3
+
+#define FLAG_STATIC   1
+#define FLAG_ABSTRACT 2
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint8_t pointerSize;
+    uint8_t reserved;
+    uint32_t byteOrder;
+    uint32_t stringHeaderSize;
+    uint8_t key[PROXC_KEY_SIZE];
+    uint32_t imageSize;
+    uint32_t stringCount;
+    uint32_t stringTable;
+    uint32_t functionCount;
+    uint32_t functionTable;
+    uint32_t checksum; // CRC32C of everything after the string table
+} ImageHeader;
+
+typedef struct {
+    int32_t arity;
+    int32_t upvalueCount;
+    uint8_t access;
+    uint8_t flags;
+    uint16_t captureCount; // Flat captures (see OP_GET_CAPTURE)
+    int32_t name; // string index, -1 when anonymous
+    uint32_t code;
+    uint32_t codeLength;
+    uint32_t lines;
+    uint32_t constants;
+    uint32_t constantCount;
+    uint32_t handlers;
+    uint32_t handlerCount;
+    uint32_t retainedParams; // Parameters the function may keep (escape analysis)
+} ImageFunction;
+
+typedef struct {
+    uint32_t tag;
+    uint32_t index;
+    uint64_t bits;
+} ImageConstant;
+
+/* --- Writer --- */
+
+void proxc_put(ImageWriter *w, const void *bytes, size_t len) {
+    if (w->failed) return;
+    if (w->count + len > w->capacity) {
+        size_t capacity = w->capacity < 256 ? 256 : w->capacity;
+        while (capacity < w->count + len) capacity *= 2;
+        uint8_t *grown = (uint8_t *)realloc(w->data, capacity);
+        if (grown == NULL) {
+            w->failed = true;
+            return;
+        }
+        w->data = grown;
+        w->capacity = capacity;
+    }
+    if (bytes != NULL) {
+        memcpy(w->data + w->count, bytes, len);
+    } else {
+        memset(w->data + w->count, 0, len);
+    }
+    w->count += len;
+}
+
+uint32_t proxc_align(ImageWriter *w, size_t alignment) {
+    size_t pad = (alignment - (w->count % alignment)) % alignment;
+    proxc_put(w, NULL, pad);
+    return (uint32_t)w->count;
+}
+
+uint32_t proxc_put_strings(ImageWriter *w, ObjString *const *strings, uint32_t count) {
+    uint32_t *offsets = NULL;
+    if (count > 0) {
+        offsets = (uint32_t *)malloc(sizeof(uint32_t) * count);
+        if (offsets == NULL) {
+            w->failed = true;
+            return 0;
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        ObjString *s = strings[i];
+        offsets[i] = proxc_align(w, PROXC_STRING_ALIGN);
+
+        ObjString record;
+        memset(&record, 0, sizeof(record));
+        record.obj.type = OBJ_STRING;
+        record.obj.isMarked = true; // permanently black: never traced, never swept
+        record.obj.next = NULL;
+        record.length = s->length;
+        record.hash = s->hash;
+        proxc_put(w, &record, offsetof(ObjString, chars));
+        proxc_put(w, s->chars, (size_t)s->length);
+        proxc_put(w, "", 1);
+    }
+
+    uint32_t table = proxc_align(w, sizeof(uint32_t));
+    if (count > 0) proxc_put(w, offsets, sizeof(uint32_t) * count);
+    free(offsets);
+    return table;
+}
+
+typedef struct {
+    ObjFunction **items;
+    int count;
+    int capacity;
+} FunctionList;
+
+static bool add_function(FunctionList *list, ObjFunction *function) {
+    if (list->count == list->capacity) {
+        int capacity = list->capacity < 8 ? 8 : list->capacity * 2;
+        ObjFunction **grown = (ObjFunction **)realloc(list->items, sizeof(ObjFunction *) * capacity);
+        if (grown == NULL) return false;
+        list->items = grown;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = function;
+    return true;
+}
+
+static int32_t string_index(Table *ids, ObjString *string, ObjString ***strings, int *count, int *capacity) {
+    Value id;
+    if (tableGet(ids, string, &id)) return (int32_t)AS_NUMBER(id);
+
+    if (*count == *capacity) {
+        int grown_capacity = *capacity < 16 ? 16 : *capacity * 2;
+        ObjString **grown = (ObjString **)realloc(*strings, sizeof(ObjString *) * grown_capacity);
+        if (grown == NULL) return -2;
+        *strings = grown;
+        *capacity = grown_capacity;
+    }
+    (*strings)[*count] = string;
+    tableSet(ids, string, NUMBER_VAL(*count));
+    return (int32_t)(*count)++;
+}
+
+bool proxc_serialize(ObjFunction *function, const uint8_t key[PROXC_KEY_SIZE],
+                     uint8_t **out_buf, size_t *out_len) {
+    // The function being written may not be rooted yet (the cache stores it
+    // straight out of the code generator), and the id table allocates.
+    size_t oldNextGC = vm.nextGC;
+    vm.nextGC = (size_t)-1;
+
+    bool ok = true;
+    FunctionList functions = { NULL, 0, 0 };
+    int *firstChild = NULL;
+    ObjString **strings = NULL;
+    int stringCount = 0;
+    int stringCapacity = 0;
+    Table ids;
+    initTable(&ids);
+    ImageWriter w = { NULL, 0, 0, false };
+
+    // Breadth-first walk: the children of function i are appended together,
+    // so its k-th function constant is function firstChild[i] + k.
+    ok = add_function(&functions, function);
+    for (int i = 0; ok && i < functions.count; i++) {
+        Chunk *chunk = &functions.items[i]->chunk;
+        for (int c = 0; ok && c < chunk->constants.count; c++) {
+            Value value = chunk->constants.values[c];
+            if (IS_FUNCTION(value)) {
+                ok = add_function(&functions, AS_FUNCTION(value));
+            } else if (!(IS_NIL(value) || IS_BOOL(value) || IS_NUMBER(value) || IS_STRING(value))) {
+                // Comptime results can be lists, instances, etc. Those have
+                // no stable on-disk form, so the program is simply not cached.
+                ok = false;
+            }
+        }
+    }
+    if (ok) {
+        firstChild = (int *)malloc(sizeof(int) * (size_t)functions.count);
+        ok = firstChild != NULL;
+    }
+    if (ok) {
+        int next = 1;
+        for (int i = 0; i < functions.count; i++) {
+            firstChild[i] = next;
+            Chunk *chunk = &functions.items[i]->chunk;
+            for (int c = 0; c < chunk->constants.count; c++) {
+                if (IS_FUNCTION(chunk->constants.values[c])) next++;
+            }
+        }
+    }
+
+    ImageHeader header;
+    memset(&header, 0, sizeof(header));
+    proxc_put(&w, &header, sizeof(header));
+
+    // Assign string ids in first-use order: function names, then constants.
+    ImageFunction *records = NULL;
+    if (ok) {
+        records = (ImageFunction *)calloc((size_t)functions.count, sizeof(ImageFunction));
+        ok = records != NULL;
+    }
+    for (int i = 0; ok && i < functions.count; i++) {
+        ObjFunction *f = functions.items[i];
+        records[i].name = -1;
+        if (f->name != NULL) {
+            records[i].name = string_index(&ids, f->name, &strings, &stringCount, &stringCapacity);
+            ok = records[i].name >= 0;
+        }
+        Chunk *chunk = &f->chunk;
+        for (int c = 0; ok && c < chunk->constants.count; c++) {
+            if (IS_STRING(chunk->constants.values[c])) {
+                ok = string_index(&ids, AS_STRING(chunk->constants.values[c]),
+                                  &strings, &stringCount, &stringCapacity) >= 0;
+            }
+        }
+    }
+
+    if (ok) {
+        header.stringCount = (uint32_t)stringCount;
+        header.stringTable = proxc_put_strings(&w, strings, (uint32_t)stringCount);
+    }
+
+    for (int i = 0; ok && i < functions.count; i++) {
+        Chunk *chunk = &functions.items[i]->chunk;
+        records[i].code = (uint32_t)w.count;
+        records[i].codeLength = (uint32_t)chunk->count;
+        if (chunk->count > 0) proxc_put(&w, chunk->code, (size_t)chunk->count);
+    }
+
+    for (int i = 0; ok && i < functions.count; i++) {
+        Chunk *chunk = &functions.items[i]->chunk;
+        records[i].lines = proxc_align(&w, sizeof(int32_t));
+        for (int b = 0; b < chunk->count; b++) {
+            int32_t line = (int32_t)chunk->lines[b];
+            proxc_put(&w, &line, sizeof(line));
+        }
+    }
+
+    for (int i = 0; ok && i < functions.count; i++) {
+        Chunk *chunk = &functions.items[i]->chunk;
+        int child = firstChild[i];
+        records[i].constants = proxc_align(&w, sizeof(uint64_t));
+        records[i].constantCount = (uint32_t)chunk->constants.count;
+        for (int c = 0; c < chunk->constants.count; c++) {
+            Value value = chunk->constants.values[c];
+            ImageConstant constant = { CONST_VALUE, 0, (uint64_t)value };
+            if (IS_STRING(value)) {
+                Value id;
+                tableGet(&ids, AS_STRING(value), &id);
+                constant.tag = CONST_STRING;
+                constant.index = (uint32_t)AS_NUMBER(id);
+                constant.bits = 0;
+            } else if (IS_FUNCTION(value)) {
+                constant.tag = CONST_FUNCTION;
+                constant.index = (uint32_t)child++;
+                constant.bits = 0;
+            }
+            proxc_put(&w, &constant, sizeof(constant));
+        }
+    }
+
+    for (int i = 0; ok && i < functions.count; i++) {
+        ExceptionHandlerTable *handlers = &functions.items[i]->chunk.exceptionHandlers;
+        records[i].handlers = proxc_align(&w, sizeof(uint32_t));
+        records[i].handlerCount = (uint32_t)handlers->count;
+        for (int h = 0; h < handlers->count; h++) {
+            uint32_t triple[3] = {
+                (uint32_t)handlers->handlers[h].start_ip,
+                (uint32_t)handlers->handlers[h].end_ip,
+                (uint32_t)handlers->handlers[h].handler_ip
+            };
+            proxc_put(&w, triple, sizeof(triple));
+        }
+    }
+
+    if (ok) {
+        for (int i = 0; i < functions.count; i++) {
+            ObjFunction *f = functions.items[i];
+            records[i].arity = f->arity;
+            records[i].upvalueCount = f->upvalueCount;
+            records[i].captureCount = (uint16_t)f->captureCount;
+            records[i].access = (uint8_t)f->access;
+            records[i].flags = (f->isStatic ? FLAG_STATIC : 0) | (f->isAbstract ? FLAG_ABSTRACT : 0);
+            records[i].retainedParams = f->retainedParams;
+        }
+        header.functionCount = (uint32_t)functions.count;
+        header.functionTable = proxc_align(&w, sizeof(uint32_t));
+        proxc_put(&w, records, sizeof(ImageFunction) * (size_t)functions.count);
+    }
+
+    ok = ok && !w.failed && w.count <= 0xFFFFFFFFu;
+    if (ok) {
+        static const uint8_t zero_key[PROXC_KEY_SIZE] = {0};
+        memcpy(header.magic, PROXC_MAGIC, 4);
+        header.version = PROXC_FORMAT_VERSION;
+        header.pointerSize = (uint8_t)sizeof(void *);
+        header.byteOrder = PROXC_BYTE_ORDER_MARK;
+        header.stringHeaderSize = (uint32_t)offsetof(ObjString, chars);
+        memcpy(header.key, key != NULL ? key : zero_key, PROXC_KEY_SIZE);
+        header.imageSize = (uint32_t)w.count;
+        uint32_t checked = header.stringTable + header.stringCount * (uint32_t)sizeof(uint32_t);
+        header.checksum = crc32c_update(0, w.data + checked, w.count - checked);
+        memcpy(w.data, &header, sizeof(header));
+        *out_buf = w.data;
+        *out_len = w.count;
+    } else {
+        free(w.data);
+    }
+
+    free(records);
+    free(strings);
+    free(firstChild);
+    free(functions.items);
+    freeTable(&ids);
+    vm.nextGC = oldNextGC;
+    return ok;
+}
+
+/* --- Loader --- */
+
+bool proxc_in_bounds(size_t size, uint32_t offset, uint64_t length, size_t alignment) {
+    if (offset % alignment != 0) return false;
+    return (uint64_t)offset <= size && length <= (uint64_t)size - offset;
+}
+
+static bool valid_string(const uint8_t *image, size_t size, uint32_t offset) {
+    size_t headerSize = offsetof(ObjString, chars);
+    if (!proxc_in_bounds(size, offset, headerSize, PROXC_STRING_ALIGN)) return false;
+    const ObjString *record = (const ObjString *)(image + offset);
+    if (record->obj.type != OBJ_STRING || !record->obj.isMarked || record->length < 0) return false;
+    if (!proxc_in_bounds(size, offset, headerSize + (uint64_t)record->length + 1, PROXC_STRING_ALIGN)) return false;
+    return record->chars[record->length] == '\0';
+}
+
+bool proxc_valid_strings(const uint8_t *image, size_t size, uint32_t table, uint32_t count) {
+    if (!proxc_in_bounds(size, table, (uint64_t)count * sizeof(uint32_t), sizeof(uint32_t))) return false;
+    const uint32_t *offsets = (const uint32_t *)(image + table);
+    for (uint32_t i = 0; i < count; i++) {
+        if (!valid_string(image, size, offsets[i])) return false;
+    }
+    return true;
+}
+
+// An existing string with the same contents wins; otherwise the record
+// itself is interned.
+void proxc_intern_strings(Table *interned, const uint8_t *image, uint32_t table, uint32_t count,
+                          ObjString **out) {
+    const uint32_t *offsets = (const uint32_t *)(image + table);
+    for (uint32_t i = 0; i < count; i++) {
+        ObjString *record = (ObjString *)(uintptr_t)(image + offsets[i]);
+        ObjString *existing = tableFindString(interned, record->chars, record->length, record->hash);
+        if (existing == NULL) {
+            tableSet(interned, record, NIL_VAL);
+            existing = record;
+        }
+        out[i] = existing;
+    }
+}
+
+static bool valid_code(const uint8_t *image, const ImageFunction *record,
+                       const ImageFunction *records);
+
+static bool valid_function(const uint8_t *image, size_t size, const ImageFunction *record,
+                           const ImageFunction *records, uint32_t stringCount, uint32_t functionCount) {
+    if (record->name >= 0 && (uint32_t)record->name >= stringCount) return false;
+    if (record->arity < 0 || record->upvalueCount < 0) return false;
+    if (record->codeLength > 0x7FFFFFFF || record->constantCount > 0x7FFFFFFF) return false;
+    if (!proxc_in_bounds(size, record->code, record->codeLength, 1)) return false;
+    if (!proxc_in_bounds(size, record->lines, (uint64_t)record->codeLength * sizeof(int32_t), sizeof(int32_t))) return false;
+    if (!proxc_in_bounds(size, record->constants, (uint64_t)record->constantCount * sizeof(ImageConstant), sizeof(uint64_t))) return false;
+    if (!proxc_in_bounds(size, record->handlers, (uint64_t)record->handlerCount * 3 * sizeof(uint32_t), sizeof(uint32_t))) return false;
+
+    const ImageConstant *constants = (const ImageConstant *)(image + record->constants);
+    for (uint32_t i = 0; i < record->constantCount; i++) {
+        const ImageConstant *c = &constants[i];
+        if (c->tag == CONST_VALUE) {
+            if (IS_OBJ((Value)c->bits)) return false;
+        } else if (c->tag == CONST_STRING) {
+            if (c->index >= stringCount) return false;
+        } else if (c->tag == CONST_FUNCTION) {
+            if (c->index == 0 || c->index >= functionCount) return false;
+        } else {
+            return false;
+        }
+    }
+
+    const uint32_t *handlers = (const uint32_t *)(image + record->handlers);
+    for (uint32_t i = 0; i < record->handlerCount * 3; i++) {
+        if (handlers[i] > record->codeLength) return false;
+    }
+    return valid_code(image, record, records);
+}
+
+static bool has_wide_form(uint8_t op) {
+    switch (op) {
+        case OP_JUMP: case OP_JUMP_IF_FALSE: case OP_JUMP_IF_FALSE_POP:
+        case OP_LOOP: case OP_LOOP_IF_TRUE: case OP_FOR_ITER:
+        case OP_GET_LOCAL: case OP_SET_LOCAL:
+        case OP_GET_UPVALUE: case OP_SET_UPVALUE: case OP_GET_CAPTURE:
+        case OP_CONSTANT: case OP_BUILD_LIST: case OP_BUILD_MAP:
+        case OP_GET_GLOBAL: case OP_DEFINE_GLOBAL: case OP_SET_GLOBAL:
+        case OP_GET_PROPERTY: case OP_SET_PROPERTY: case OP_GET_SUPER:
+        case OP_INVOKE: case OP_SUPER_INVOKE:
+        case OP_CLOSURE: case OP_STACK_CLOSURE:
+        case OP_CLASS: case OP_METHOD: case OP_USE: case OP_INTERFACE: case OP_TRAIT:
+        case OP_CONTEXT: case OP_LAYER: case OP_INTENT: case OP_RESOLVER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Operand readers for the code walk. Index and jump operands are
+// big-endian; the intent, resolver, tensor and long-constant operands are
+// little-endian.
+static uint32_t read_be(const uint8_t *code, uint32_t at, int width) {
+    uint32_t value = 0;
+    for (int i = 0; i < width; i++) value = (value << 8) | code[at + i];
+    return value;
+}
+
+static uint32_t read_le(const uint8_t *code, uint32_t at, int width) {
+    uint32_t value = 0;
+    for (int i = width - 1; i >= 0; i--) value = (value << 8) | code[at + i];
+    return value;
+}
+
+static bool is_string_constant(const uint8_t *image, const ImageFunction *record, uint32_t index) {
+    const ImageConstant *constants = (const ImageConstant *)(image + record->constants);
+    return index < record->constantCount && constants[index].tag == CONST_STRING;
+}
+
+// Walks the code of one function and checks every operand (see the top of
+// this file). Forward jump targets are collected and checked once every
+// instruction boundary is known.
+static bool valid_code(const uint8_t *image, const ImageFunction *record,
+                       const ImageFunction *records) {
+    uint32_t length = record->codeLength;
+    if (length == 0) return true;
+
+    const uint8_t *code = image + record->code;
+    const ImageConstant *constants = (const ImageConstant *)(image + record->constants);
+    uint8_t *starts = (uint8_t *)calloc(length, 1);
+    uint32_t *forward = (uint32_t *)malloc(sizeof(uint32_t) * length);
+    if (starts == NULL || forward == NULL) {
+        free(starts);
+        free(forward);
+        return false;
+    }
+
+    // Fails the instruction (breaking out of the innermost switch or loop)
+    // unless n more operand bytes fit in the code.
+#define NEED(n) if ((uint64_t)at + (n) > length) { ok = false; break; }
+
+    bool ok = true;
+    uint32_t forwardCount = 0;
+    uint32_t ip = 0;
+    uint8_t last = OP_NOP;
+    while (ok && ip < length) {
+        starts[ip] = 1;
+        uint32_t at = ip + 1;
+        uint8_t op = code[ip];
+        bool wide = op == OP_WIDE;
+        if (wide) {
+            NEED(1);
+            op = code[at++];
+            if (!has_wide_form(op)) {
+                ok = false;
+                break;
+            }
+        }
+        // Widths of a constant index, a slot or count, and a jump offset
+        int constant = wide ? 3 : 1;
+        int index = wide ? 2 : 1;
+        int offset = wide ? 4 : 2;
+
+        switch (op) {
+            case OP_NOP: case OP_NIL: case OP_TRUE: case OP_FALSE: case OP_POP: case OP_DUP:
+            case OP_GET_INDEX: case OP_SET_INDEX:
+            case OP_GET_LOCAL_0: case OP_GET_LOCAL_1: case OP_GET_LOCAL_2: case OP_GET_LOCAL_3:
+            case OP_SET_LOCAL_0: case OP_SET_LOCAL_1: case OP_SET_LOCAL_2: case OP_SET_LOCAL_3:
+            case OP_EQUAL: case OP_GREATER: case OP_LESS: case OP_LESS_EQUAL: case OP_GREATER_EQUAL:
+            case OP_ADD: case OP_SUBTRACT: case OP_MULTIPLY: case OP_DIVIDE: case OP_MODULO:
+            case OP_NOT: case OP_NEGATE: case OP_PRINT:
+            case OP_BIT_AND: case OP_BIT_OR: case OP_BIT_XOR: case OP_BIT_NOT:
+            case OP_LEFT_SHIFT: case OP_RIGHT_SHIFT: case OP_MAT_MUL: case OP_UNWRAP:
+            case OP_CLOSE_UPVALUE: case OP_RETURN: case OP_INHERIT: case OP_IMPLEMENT:
+            case OP_TRY: case OP_CATCH: case OP_END_TRY: case OP_MAKE_FOREIGN:
+            case OP_ACTIVATE: case OP_END_ACTIVATE: case OP_ITER:
+                break;
+            case OP_LOOP_IF_LESS: case OP_LOOP_IF_LESS_EQUAL:
+            case OP_LOOP_IF_GREATER: case OP_LOOP_IF_GREATER_EQUAL:
+                // Branches with the offset of the OP_LOOP_IF_TRUE that
+                // follows, which is checked as its own instruction.
+                NEED(3);
+                ok = code[at] == OP_LOOP_IF_TRUE;
+                break;
+            case OP_CONSTANT:
+                NEED(constant);
+                ok = read_be(code, at, constant) < record->constantCount;
+                at += constant;
+                break;
+            case OP_CONSTANT_LONG:
+                NEED(3);
+                ok = read_le(code, at, 3) < record->constantCount;
+                at += 3;
+                break;
+            case OP_GET_GLOBAL: case OP_DEFINE_GLOBAL: case OP_SET_GLOBAL:
+            case OP_GET_PROPERTY: case OP_SET_PROPERTY: case OP_GET_SUPER:
+            case OP_CLASS: case OP_METHOD: case OP_USE: case OP_INTERFACE: case OP_TRAIT:
+            case OP_CONTEXT: case OP_LAYER:
+                NEED(constant);
+                ok = is_string_constant(image, record, read_be(code, at, constant));
+                at += constant;
+                break;
+            case OP_INVOKE: case OP_SUPER_INVOKE:
+                NEED(constant + 1);
+                ok = is_string_constant(image, record, read_be(code, at, constant));
+                at += constant + 1;
+                break;
+            case OP_INTENT:
+                NEED(constant + 4);
+                ok = is_string_constant(image, record, read_be(code, at, constant));
+                at += constant + 4;
+                break;
+            case OP_RESOLVER:
+                NEED(constant + 4);
+                ok = is_string_constant(image, record, read_be(code, at, constant)) &&
+                     is_string_constant(image, record, read_le(code, at + constant, 4));
+                at += constant + 4;
+                break;
+            case OP_GET_LOCAL: case OP_SET_LOCAL:
+            case OP_BUILD_LIST: case OP_BUILD_MAP:
+                NEED(index);
+                at += index;
+                break;
+            case OP_GET_UPVALUE: case OP_SET_UPVALUE:
+                NEED(index);
+                ok = read_be(code, at, index) < (uint32_t)record->upvalueCount;
+                at += index;
+                break;
+            case OP_GET_CAPTURE:
+                NEED(index);
+                ok = read_be(code, at, index) < record->captureCount;
+                at += index;
+                break;
+            case OP_CALL: case OP_GUARD_ARGS:
+                NEED(1);
+                at += 1;
+                break;
+            case OP_MAKE_TENSOR: {
+                NEED(5);
+                uint32_t dims = code[at];
+                at += 5;
+                NEED(dims * 4);
+                at += dims * 4;
+                break;
+            }
+            case OP_JUMP: case OP_JUMP_IF_FALSE: case OP_JUMP_IF_FALSE_POP: case OP_FOR_ITER: {
+                NEED(offset);
+                uint64_t target = (uint64_t)at + offset + read_be(code, at, offset);
+                at += offset;
+                ok = target < length;
+                if (ok) forward[forwardCount++] = (uint32_t)target;
+                break;
+            }
+            case OP_LOOP: case OP_LOOP_IF_TRUE: {
+                NEED(offset);
+                uint32_t distance = read_be(code, at, offset);
+                at += offset;
+                ok = distance <= at && starts[at - distance];
+                break;
+            }
+            case OP_CLOSURE: case OP_STACK_CLOSURE: {
+                NEED(constant);
+                uint32_t c = read_be(code, at, constant);
+                at += constant;
+                if (c >= record->constantCount || constants[c].tag != CONST_FUNCTION) {
+                    ok = false;
+                    break;
+                }
+                // Upvalue pairs, then capture pairs: (isLocal, index). A
+                // non-local index refers to the enclosing function's own
+                // upvalues or captures.
+                const ImageFunction *child = &records[constants[c].index];
+                uint32_t pairs = (uint32_t)child->upvalueCount + child->captureCount;
+                for (uint32_t i = 0; ok && i < pairs; i++) {
+                    NEED(1 + index);
+                    uint8_t isLocal = code[at];
+                    uint32_t slot = read_be(code, at + 1, index);
+                    uint32_t limit = i < (uint32_t)child->upvalueCount
+                        ? (uint32_t)record->upvalueCount : record->captureCount;
+                    ok = isLocal == 1 || (isLocal == 0 && slot < limit);
+                    at += 1 + index;
+                }
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+        last = op;
+        ip = at;
+    }
+
+#undef NEED
+
+    // Execution must not run off the end of the code
+    ok = ok && ip == length && (last == OP_RETURN || last == OP_JUMP || last == OP_LOOP);
+    for (uint32_t i = 0; ok && i < forwardCount; i++) {
+        ok = starts[forward[i]] != 0;
+    }
+    const uint32_t *handlers = (const uint32_t *)(image + record->handlers);
+    for (uint32_t i = 0; ok && i < record->handlerCount; i++) {
+        ok = handlers[i * 3 + 2] < length && starts[handlers[i * 3 + 2]] != 0;
+    }
+
+    free(starts);
+    free(forward);
+    return ok;
+}
+
+static void load_function(const uint8_t *image, const ImageFunction *record, ObjFunction *function,
+                          ObjString **strings, ObjFunction **functions) {
+    function->arity = record->arity;
+    function->upvalueCount = record->upvalueCount;
+    function->captureCount = record->captureCount;
+    function->access = (AccessLevel)record->access;
+    function->isStatic = (record->flags & FLAG_STATIC) != 0;
+    function->isAbstract = (record->flags & FLAG_ABSTRACT) != 0;
+    function->retainedParams = record->retainedParams;
+    function->name = record->name >= 0 ? strings[record->name] : NULL;
+    function->ownerClass = NULL;
+
+    Chunk *chunk = &function->chunk;
+    if (record->codeLength > 0) {
+        chunk->code = (uint8_t *)(image + record->code);
+        chunk->lines = (int *)(image + record->lines);
+        chunk->count = (int)record->codeLength;
+        chunk->capacity = (int)record->codeLength;
+        chunk->borrowed = true;
+    }
+
+    const ImageConstant *constants = (const ImageConstant *)(image + record->constants);
+    if (record->constantCount > 0) {
+        chunk->constants.values = ALLOCATE(Value, record->constantCount);
+        chunk->constants.capacity = (int)record->constantCount;
+        chunk->constants.count = (int)record->constantCount;
+    }
+    for (uint32_t i = 0; i < record->constantCount; i++) {
+        const ImageConstant *c = &constants[i];
+        Value value = (Value)c->bits;
+        if (c->tag == CONST_STRING) value = OBJ_VAL(strings[c->index]);
+        else if (c->tag == CONST_FUNCTION) value = OBJ_VAL(functions[c->index]);
+        chunk->constants.values[i] = value;
+    }
+
+    const uint32_t *handlers = (const uint32_t *)(image + record->handlers);
+    for (uint32_t i = 0; i < record->handlerCount; i++) {
+        addExceptionHandler(chunk, handlers[i * 3], handlers[i * 3 + 1], handlers[i * 3 + 2]);
+    }
+}
+
+ObjFunction *proxc_load(const uint8_t *image, size_t size,
+                        const uint8_t key[PROXC_KEY_SIZE]) {
+    if (image == NULL || size < sizeof(ImageHeader) || ((uintptr_t)image % PROXC_STRING_ALIGN) != 0) return NULL;
+
+    ImageHeader header;
+    memcpy(&header, image, sizeof(header));
+    if (memcmp(header.magic, PROXC_MAGIC, 4) != 0) return NULL;
+    if (header.version != PROXC_FORMAT_VERSION) return NULL;
+    if (header.pointerSize != sizeof(void *) || header.byteOrder != PROXC_BYTE_ORDER_MARK) return NULL;
+    if (header.stringHeaderSize != offsetof(ObjString, chars)) return NULL;
+    if (header.imageSize != size) return NULL;
+    if (key != NULL && memcmp(header.key, key, PROXC_KEY_SIZE) != 0) return NULL;
+    if (header.functionCount == 0) return NULL;
+    if (!proxc_in_bounds(size, header.stringTable, (uint64_t)header.stringCount * sizeof(uint32_t), sizeof(uint32_t))) return NULL;
+    uint32_t checked = header.stringTable + header.stringCount * (uint32_t)sizeof(uint32_t);
+    if (crc32c_update(0, image + checked, size - checked) != header.checksum) return NULL;
+    if (!proxc_in_bounds(size, header.functionTable, (uint64_t)header.functionCount * sizeof(ImageFunction), sizeof(uint32_t))) return NULL;
+
+    // Validate everything before publishing anything: once a record has been
+    // interned, the image can no longer be released.
+    const ImageFunction *records = (const ImageFunction *)(image + header.functionTable);
+    if (!proxc_valid_strings(image, size, header.stringTable, header.stringCount)) return NULL;
+    for (uint32_t i = 0; i < header.functionCount; i++) {
+        if (!valid_function(image, size, &records[i], records, header.stringCount, header.functionCount)) return NULL;
+    }
+
+    ObjString **strings = (ObjString **)malloc(sizeof(ObjString *) * (header.stringCount + 1));
+    ObjFunction **functions = (ObjFunction **)malloc(sizeof(ObjFunction *) * header.functionCount);
+    if (strings == NULL || functions == NULL) {
+        free(strings);
+        free(functions);
+        return NULL;
+    }
+
+    // Partially built functions are not rooted anywhere, so keep the
+    // collector out of the way until the whole tree is linked together.
+    size_t oldNextGC = vm.nextGC;
+    vm.nextGC = (size_t)-1;
+
+    proxc_intern_strings(&vm.strings, image, header.stringTable, header.stringCount, strings);
+    for (uint32_t i = 0; i < header.functionCount; i++) {
+        functions[i] = newFunction();
+    }
+    for (uint32_t i = 0; i < header.functionCount; i++) {
+        load_function(image, &records[i], functions[i], strings, functions);
+    }
+    ObjFunction *result = functions[0];
+
+    vm.nextGC = oldNextGC;
+    free(strings);
+    free(functions);
+    return result;
+}
+
+/* --- Files --- */
+
+// Maps an image read-only. Nothing writes to a loaded image (string records
+// are pre-marked, so even the collector leaves them alone), so its pages
+// stay shared with every other process running the same image. Mappings are
+// kept for the life of the process because loaded chunks and interned
+// strings point into them.
+uint8_t *proxc_map_file(const char *path, size_t *out_len) {
+#ifdef _WIN32
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return NULL;
+    if (fseek(f, 0L, SEEK_END) != 0) {
+        fclose(f);
+        return NULL;
+    }
+    long size = ftell(f);
+    rewind(f);
+    if (size <= 0) {
+        fclose(f);
+        return NULL;
+    }
+    uint8_t *buf = (uint8_t *)_aligned_malloc((size_t)size, PROXC_STRING_ALIGN);
+    if (buf == NULL || fread(buf, 1, (size_t)size, f) != (size_t)size) {
+        if (buf != NULL) _aligned_free(buf);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *out_len = (size_t)size;
+    return buf;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+    *out_len = (size_t)st.st_size;
+    return (uint8_t *)map;
+#endif
+}
+
+void proxc_unmap_file(uint8_t *image, size_t len) {
+#ifdef _WIN32
+    (void)len;
+    _aligned_free(image);
+#else
+    munmap(image, len);
+#endif
+}
+
+static ObjFunction *load_image_file(const char *path, const uint8_t key[PROXC_KEY_SIZE]) {
+    size_t len;
+    uint8_t *image = proxc_map_file(path, &len);
+    if (image == NULL) return NULL;
+
+    ObjFunction *function = proxc_load(image, len, key);
+    if (function == NULL) proxc_unmap_file(image, len);
+    return function;
+}
+
+int proxc_write_file(const char *path, const uint8_t *buf, size_t len) {
+    // Write to a private temp file and rename it into place, so concurrent
+    // runs never observe a half-written image.
+    size_t tmp_len = strlen(path) + 32;
+    char *tmp = (char *)malloc(tmp_len);
+    if (tmp == NULL) return -1;
+    snprintf(tmp, tmp_len, "%s.%ld.tmp", path, (long)GETPID());
+
+    FILE *f = fopen(tmp, "wb");
+    int status = -1;
+    if (f != NULL) {
+        size_t written = fwrite(buf, 1, len, f);
+        if (fclose(f) == 0 && written == len) {
+#ifdef _WIN32
+            remove(path);
+#endif
+            if (rename(tmp, path) == 0) status = 0;
+        }
+        if (status != 0) remove(tmp);
+    }
+
+    free(tmp);
+    return status;
+}
+
+static int write_image(const char *path, ObjFunction *function, const uint8_t key[PROXC_KEY_SIZE]) {
+    uint8_t *buf;
+    size_t len;
+    if (!proxc_serialize(function, key, &buf, &len)) return -1;
+    int status = proxc_write_file(path, buf, len);
+    free(buf);
+    return status;
+}
+
+int write_function_image(const char *path, ObjFunction *function) {
+    return write_image(path, function, NULL);
+}
+
+ObjFunction *read_function_image(const char *path) {
+    return load_image_file(path, NULL);
+}
+
+/* --- Compile cache --- */
+
+bool proxc_cache_enabled(void) {
+    const char *off = getenv("PROXPL_NO_CACHE");
+    return off == NULL || off[0] == '\0' || strcmp(off, "0") == 0;
+}
+
+const char *proxc_cache_dir(void) {
+    const char *dir = getenv("PROXPL_CACHE_DIR");
+    return (dir != NULL && dir[0] != '\0') ? dir : PROXC_DEFAULT_CACHE_DIR;
+}
+
+void proxc_ensure_cache_dir(void) {
+    MKDIR(proxc_cache_dir());
+}
+
+static char *cache_path(const uint8_t key[PROXC_KEY_SIZE]) {
+    static const char hex[] = "0123456789abcdef";
+    const char *dir = proxc_cache_dir();
+    size_t len = strlen(dir) + 1 + PROXC_KEY_SIZE * 2 + sizeof(".proxc");
+    char *path = (char *)malloc(len);
+    if (path == NULL) return NULL;
+
+    int n = snprintf(path, len, "%s/", dir);
+    for (int i = 0; i < PROXC_KEY_SIZE; i++) {
+        path[n++] = hex[key[i] >> 4];
+        path[n++] = hex[key[i] & 0x0F];
+    }
+    strcpy(path + n, ".proxc");
+    return path;
+}
+
+void proxc_cache_key(const char *source, size_t length, uint8_t key[PROXC_KEY_SIZE]) {
+    static const char version[] = PROXPL_VERSION_STRING;
+    uint8_t format[2] = { PROXC_FORMAT_VERSION & 0xFF, (PROXC_FORMAT_VERSION >> 8) & 0xFF };
+
+    SHA256_CTX ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, (const unsigned char *)version, sizeof(version));
+    sha256_update(&ctx, format, sizeof(format));
+    sha256_update(&ctx, (const unsigned char *)source, length);
+    sha256_final(&ctx, key);
+}
+
+ObjFunction *proxc_cache_load(const uint8_t key[PROXC_KEY_SIZE]) {
+    if (!proxc_cache_enabled()) return NULL;
+
+    char *path = cache_path(key);
+    if (path == NULL) return NULL;
+    ObjFunction *function = load_image_file(path, key);
+    free(path);
+    return function;
+}
+
+bool proxc_cache_store(const uint8_t key[PROXC_KEY_SIZE], ObjFunction *function) {
+    if (!proxc_cache_enabled()) return false;
+
+    char *path = cache_path(key);
+    if (path == NULL) return false;
+
+    // A failed store only costs the next run a cold start.
+    proxc_ensure_cache_dir();
+    bool stored = write_image(path, function, key) == 0;
+    free(path);
+    return stored;
+}
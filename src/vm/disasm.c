@@ -61,6 +61,36 @@ static size_t jump_instruction(const char* name, int sign, const Chunk* chunk, s
     return offset + 3;
 }
 
+// OP_WIDE prefix: 16-bit index operand, or 32-bit offset for jumps.
+static size_t wide_instruction(const Chunk* chunk, size_t offset) {
+    uint8_t op = chunk->code[offset + 1];
+    const uint8_t* operand = chunk->code + offset + 2;
+    switch (op) {
+        case OP_JUMP: case OP_JUMP_IF_FALSE: case OP_JUMP_IF_FALSE_POP:
+        case OP_LOOP: case OP_LOOP_IF_TRUE: case OP_TRY: case OP_FOR_ITER: {
+            uint32_t jump = ((uint32_t)operand[0] << 24) | ((uint32_t)operand[1] << 16) |
+                            ((uint32_t)operand[2] << 8) | operand[3];
+            int sign = (op == OP_LOOP || op == OP_LOOP_IF_TRUE) ? -1 : 1;
+            printf("%-16s %4d %4zu -> %zu\n", "OP_WIDE", op, offset,
+                   offset + 6 + sign * (size_t)jump);
+            return offset + 6;
+        }
+        case OP_GET_LOCAL: case OP_SET_LOCAL: case OP_GET_UPVALUE:
+        case OP_SET_UPVALUE: case OP_GET_CAPTURE: case OP_BUILD_LIST: case OP_BUILD_MAP: {
+            uint16_t slot = (uint16_t)((operand[0] << 8) | operand[1]);
+            printf("%-16s %4d %5d\n", "OP_WIDE", op, slot);
+            return offset + 4;
+        }
+        default: {
+            uint32_t index = ((uint32_t)operand[0] << 16) | ((uint32_t)operand[1] << 8) | operand[2];
+            printf("%-16s %4d %8u\n", "OP_WIDE", op, index);
+            // Invokes carry their argument count after the name
+            if (op == OP_INVOKE || op == OP_SUPER_INVOKE) return offset + 6;
+            return offset + 5;
+        }
+    }
+}
+
 void disasm_chunk(const Chunk *chunk) {
     printf("== Disassembly ==\n");
     for (size_t offset = 0; offset < (size_t)chunk->count;) {
@@ -78,6 +108,18 @@ void disasm_chunk(const Chunk *chunk) {
             case OP_CONSTANT:
                 offset = constant_instruction("OP_CONSTANT", chunk, offset);
                 break;
+            case OP_CONSTANT_LONG: {
+                uint32_t constant = chunk->code[offset + 1] | (chunk->code[offset + 2] << 8) |
+                                    ((uint32_t)chunk->code[offset + 3] << 16);
+                printf("%-16s %4u '", "OP_CONSTANT_LONG", constant);
+                print_value(consttable_get(chunk, constant));
+                printf("'\n");
+                offset += 4;
+                break;
+            }
+            case OP_WIDE:
+                offset = wide_instruction(chunk, offset);
+                break;
             case OP_NOP:
                 offset = simple_instruction("OP_NOP", offset);
                 break;
@@ -126,6 +168,9 @@ void disasm_chunk(const Chunk *chunk) {
             case OP_GET_UPVALUE:
                 offset = byte_instruction("OP_GET_UPVALUE", chunk, offset);
                 break;
+            case OP_GET_CAPTURE:
+                offset = byte_instruction("OP_GET_CAPTURE", chunk, offset);
+                break;
             case OP_SET_UPVALUE:
                 offset = byte_instruction("OP_SET_UPVALUE", chunk, offset);
                 break;
@@ -147,6 +192,12 @@ void disasm_chunk(const Chunk *chunk) {
             case OP_LESS:
                 offset = simple_instruction("OP_LESS", offset);
                 break;
+            case OP_LESS_EQUAL:
+                offset = simple_instruction("OP_LESS_EQUAL", offset);
+                break;
+            case OP_GREATER_EQUAL:
+                offset = simple_instruction("OP_GREATER_EQUAL", offset);
+                break;
             case OP_ADD:
                 offset = simple_instruction("OP_ADD", offset);
                 break;
@@ -180,6 +231,30 @@ void disasm_chunk(const Chunk *chunk) {
             case OP_LOOP:
                 offset = jump_instruction("OP_LOOP", -1, chunk, offset);
                 break;
+            case OP_JUMP_IF_FALSE_POP:
+                offset = jump_instruction("OP_JUMP_IF_FALSE_POP", 1, chunk, offset);
+                break;
+            case OP_LOOP_IF_TRUE:
+                offset = jump_instruction("OP_LOOP_IF_TRUE", -1, chunk, offset);
+                break;
+            case OP_ITER:
+                offset = simple_instruction("OP_ITER", offset);
+                break;
+            case OP_FOR_ITER:
+                offset = jump_instruction("OP_FOR_ITER", 1, chunk, offset);
+                break;
+            case OP_LOOP_IF_LESS:
+                offset = simple_instruction("OP_LOOP_IF_LESS", offset);
+                break;
+            case OP_LOOP_IF_LESS_EQUAL:
+                offset = simple_instruction("OP_LOOP_IF_LESS_EQUAL", offset);
+                break;
+            case OP_LOOP_IF_GREATER:
+                offset = simple_instruction("OP_LOOP_IF_GREATER", offset);
+                break;
+            case OP_LOOP_IF_GREATER_EQUAL:
+                offset = simple_instruction("OP_LOOP_IF_GREATER_EQUAL", offset);
+                break;
             case OP_CALL:
                 offset = byte_instruction("OP_CALL", chunk, offset);
                 break;
@@ -197,6 +272,17 @@ void disasm_chunk(const Chunk *chunk) {
                 printf("\n");
                 break;
             }
+            case OP_STACK_CLOSURE: {
+                offset++;
+                uint8_t constant = chunk->code[offset++];
+                printf("%-16s %4d ", "OP_STACK_CLOSURE", constant);
+                print_value(consttable_get(chunk, constant));
+                printf("\n");
+                break;
+            }
+            case OP_GUARD_ARGS:
+                offset = byte_instruction("OP_GUARD_ARGS", chunk, offset);
+                break;
             case OP_CLOSE_UPVALUE:
                 offset = simple_instruction("OP_CLOSE_UPVALUE", offset);
                 break;
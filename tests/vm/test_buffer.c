@@ -0,0 +1,119 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_buffer.c
+ * Verifies std.buffer: typed reads and writes in both byte orders, slices
+ * that share storage with their owner (including after the owner grows and
+ * after only the slice stays reachable across a collection), and the bulk
+ * copy/fill/find operations.
+ */
+
+#include "test_support.h"
+#include "gc.h"
+
+static void testTypedAccess(void) {
+    run("use std.buffer;\n"
+        "let b = std.buffer.alloc(4);\n"
+        "std.buffer.write_u32(b, 0, 16909060, true);\n"
+        "let hexBE = std.buffer.hex_dump(b);\n"
+        "std.buffer.write_u16(b, 4, 65534);\n"
+        "let hexAll = std.buffer.hex_dump(b);\n"
+        "let u32le = std.buffer.read_u32(b, 0);\n"
+        "let i16 = std.buffer.read_i16(b, 4);\n"
+        "let u16be = std.buffer.read_u16(b, 4, true);\n"
+        "let past = std.buffer.read_u32(b, 3);\n"
+        "std.buffer.write_f64(b, 6, 3.5, true);\n"
+        "let f64 = std.buffer.read_f64(b, 6, true);\n"
+        "std.buffer.write_f32(b, 14, 0.25);\n"
+        "let f32 = std.buffer.read_f32(b, 14);\n"
+        "std.buffer.write_i8(b, 18, -1);\n"
+        "let i8 = std.buffer.read_i8(b, 18);\n"
+        "let u8 = std.buffer.read_u8(b, 18);\n"
+        "let gap = std.buffer.write_u8(b, 40, 1);\n"
+        "let size = std.buffer.size(b);\n");
+
+    CHECK(isString(global("hexBE"), "01 02 03 04"), "big-endian u32 layout");
+    CHECK(isString(global("hexAll"), "01 02 03 04 fe ff"), "write at the end grows the buffer");
+    CHECK(isNumber(global("u32le"), 67305985), "little-endian u32 read");
+    CHECK(isNumber(global("i16"), -2), "signed i16 read");
+    CHECK(isNumber(global("u16be"), 65279), "big-endian u16 read");
+    CHECK(IS_NIL(global("past")), "read past the end");
+    CHECK(isNumber(global("f64"), 3.5), "f64 round trip");
+    CHECK(isNumber(global("f32"), 0.25), "f32 round trip");
+    CHECK(isNumber(global("i8"), -1), "i8 read");
+    CHECK(isNumber(global("u8"), 255), "u8 of a negative byte");
+    CHECK(isBool(global("gap"), false), "write leaving a gap is rejected");
+    CHECK(isNumber(global("size"), 19), "size after typed writes");
+}
+
+static void testSlices(void) {
+    run("use std.buffer;\n"
+        "let s = std.buffer.from_string(\"hello world\");\n"
+        "let w = std.buffer.slice(s, 6, 5);\n"
+        "std.buffer.write_u8(w, 0, 87);\n"
+        "let shared = std.buffer.to_string(s);\n"
+        "let sub = std.buffer.slice(w, 1, 3);\n"
+        "let subText = std.buffer.to_string(sub);\n"
+        "let k = 0;\n"
+        "while (k < 100) { std.buffer.write_string(s, \"!!!!!!!!!!\"); k = k + 1; }\n"
+        "let afterGrow = std.buffer.to_string(w);\n"
+        "let sliceGrow = std.buffer.write_u8(w, 5, 1);\n"
+        "let ownerSize = std.buffer.size(s);\n");
+
+    CHECK(isString(global("shared"), "hello World"), "write through a slice reaches the owner");
+    CHECK(isString(global("subText"), "orl"), "slice of a slice");
+    CHECK(isString(global("afterGrow"), "World"), "slice survives the owner growing");
+    CHECK(isBool(global("sliceGrow"), false), "slices cannot grow");
+    CHECK(isNumber(global("ownerSize"), 1011), "owner size");
+
+    // Only the slices keep the owner's storage alive now
+    run("s = null;\n");
+    collectGarbage(&vm);
+    run("use std.buffer;\n"
+        "let afterGc = std.buffer.to_string(w);\n"
+        "let subAfterGc = std.buffer.to_string(sub);\n");
+    CHECK(isString(global("afterGc"), "World"), "slice keeps its owner alive");
+    CHECK(isString(global("subAfterGc"), "orl"), "nested slice keeps its owner alive");
+}
+
+static void testBulk(void) {
+    run("use std.buffer;\n"
+        "let c = std.buffer.from_string(\"abcdef\");\n"
+        "let count = std.buffer.copy(c, 2, c, 0, 4);\n"
+        "let copied = std.buffer.to_string(c);\n"
+        "std.buffer.fill(c, 120, 1, 3);\n"
+        "let filled = std.buffer.to_string(c);\n"
+        "let t = std.buffer.from_string(\"hello World!\");\n"
+        "let needle = std.buffer.slice(t, 6, 5);\n"
+        "let findStr = std.buffer.find(t, \"World\");\n"
+        "let findByte = std.buffer.find(t, 33);\n"
+        "let findBuf = std.buffer.find(t, needle);\n"
+        "let findFrom = std.buffer.find(t, \"o\", 5);\n"
+        "let findNone = std.buffer.find(t, \"zzz\");\n"
+        "let part = std.buffer.to_string(t, 6, 3);\n");
+
+    CHECK(isNumber(global("count"), 4), "copy count");
+    CHECK(isString(global("copied"), "ababcd"), "overlapping copy");
+    CHECK(isString(global("filled"), "axxbcd"), "fill range");
+    CHECK(isNumber(global("findStr"), 6), "find a string");
+    CHECK(isNumber(global("findByte"), 11), "find a byte");
+    CHECK(isNumber(global("findBuf"), 6), "find a buffer");
+    CHECK(isNumber(global("findFrom"), 7), "find from an offset");
+    CHECK(isNumber(global("findNone"), -1), "find without a match");
+    CHECK(isString(global("part"), "Wor"), "to_string range");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testTypedAccess();
+    testSlices();
+    testBulk();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All buffer tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_bytecode_image.c
+ * Verifies that a function tree (nested function constants, line tables,
+ * exception handlers) round-trips through the .proxc image format, that
+ * loaded chunks and new strings are used in place, and that corrupt or
+ * mismatched images are rejected instead of loaded.
+ */
+
+#include "test_support.h"
+#include "bytecode.h"
+#include "bytecode_image.h"
+
+static bool same_chunk(const Chunk *a, const Chunk *b) {
+    if (a->count != b->count) return false;
+    if (memcmp(a->code, b->code, (size_t)a->count) != 0) return false;
+    if (memcmp(a->lines, b->lines, sizeof(int) * (size_t)a->count) != 0) return false;
+    if (a->constants.count != b->constants.count) return false;
+    if (a->exceptionHandlers.count != b->exceptionHandlers.count) return false;
+    for (int i = 0; i < a->exceptionHandlers.count; i++) {
+        ExceptionHandler *x = &a->exceptionHandlers.handlers[i];
+        ExceptionHandler *y = &b->exceptionHandlers.handlers[i];
+        if (x->start_ip != y->start_ip || x->end_ip != y->end_ip || x->handler_ip != y->handler_ip) return false;
+    }
+    return true;
+}
+
+int main(void) {
+    initVM(&vm);
+    vm.nextGC = (size_t)-1;
+
+    /* inner(a, b) { return a; } capturing one upvalue */
+    ObjFunction *inner = newFunction();
+    inner->name = copyString("inner", 5);
+    inner->arity = 2;
+    inner->upvalueCount = 1;
+    inner->isStatic = true;
+    writeChunk(&inner->chunk, OP_GET_LOCAL, 7);
+    writeChunk(&inner->chunk, 1, 7);
+    writeChunk(&inner->chunk, OP_RETURN, 8);
+
+    /* top level: constants of every serializable kind, two line runs, one handler */
+    ObjFunction *script = newFunction();
+    addConstant(&script->chunk, NUMBER_VAL(-2.5));
+    addConstant(&script->chunk, OBJ_VAL(copyString("hello", 5)));
+    addConstant(&script->chunk, BOOL_VAL(true));
+    addConstant(&script->chunk, NIL_VAL);
+    addConstant(&script->chunk, OBJ_VAL(inner));
+    addConstant(&script->chunk, OBJ_VAL(copyString("only-in-image", 13)));
+    writeChunk(&script->chunk, OP_CONSTANT, 1);
+    writeChunk(&script->chunk, 0, 1);
+    writeChunk(&script->chunk, OP_CLOSURE, 3);
+    writeChunk(&script->chunk, 4, 3);
+    writeChunk(&script->chunk, 1, 3);
+    writeChunk(&script->chunk, 0, 3);
+    writeChunk(&script->chunk, OP_NIL, 3);
+    writeChunk(&script->chunk, OP_RETURN, 3);
+    addExceptionHandler(&script->chunk, 0, 2, 6);
+
+    uint8_t key[PROXC_KEY_SIZE];
+    proxc_cache_key("print(1);", 9, key);
+
+    uint8_t *buf;
+    size_t len;
+    CHECK(proxc_serialize(script, key, &buf, &len), "serialize");
+
+    /* Load from a private copy; "buf" is loaded again below */
+    uint8_t *image = (uint8_t *)malloc(len);
+    memcpy(image, buf, len);
+    ObjFunction *loaded = proxc_load(image, len, key);
+    CHECK(loaded != NULL, "load");
+    if (loaded != NULL) {
+        CHECK(same_chunk(&script->chunk, &loaded->chunk), "top-level chunk differs");
+        CHECK(loaded->name == NULL, "script should stay anonymous");
+        CHECK(loaded->chunk.borrowed && loaded->chunk.code >= image && loaded->chunk.code < image + len,
+              "code should be used in place");
+
+        Value c0 = loaded->chunk.constants.values[0];
+        Value c1 = loaded->chunk.constants.values[1];
+        CHECK(IS_NUMBER(c0) && AS_NUMBER(c0) == -2.5, "number constant");
+        CHECK(IS_STRING(c1) && AS_STRING(c1) == AS_STRING(script->chunk.constants.values[1]),
+              "string constant must come back interned");
+        CHECK(IS_BOOL(loaded->chunk.constants.values[2]), "bool constant");
+        CHECK(IS_NIL(loaded->chunk.constants.values[3]), "nil constant");
+
+        Value c4 = loaded->chunk.constants.values[4];
+        CHECK(IS_FUNCTION(c4), "nested function constant");
+        if (IS_FUNCTION(c4)) {
+            ObjFunction *f = AS_FUNCTION(c4);
+            CHECK(f->arity == 2 && f->upvalueCount == 1 && f->isStatic, "nested function header");
+            CHECK(f->name != NULL && strcmp(f->name->chars, "inner") == 0, "nested function name");
+            CHECK(same_chunk(&inner->chunk, &f->chunk), "nested chunk differs");
+        }
+    }
+
+    /* A string nobody else interned is adopted from the image without copying */
+    tableDelete(&vm.strings, AS_STRING(script->chunk.constants.values[5]));
+    ObjFunction *fresh = proxc_load(buf, len, key);
+    CHECK(fresh != NULL, "reload");
+    if (fresh != NULL) {
+        ObjString *adopted = AS_STRING(fresh->chunk.constants.values[5]);
+        CHECK((uint8_t *)adopted >= buf && (uint8_t *)adopted < buf + len, "string should live in the image");
+        CHECK(copyString("only-in-image", 13) == adopted, "image string should be the interned copy");
+    }
+
+    /* A different key, an out-of-range offset and a truncated image must all miss */
+    uint8_t other[PROXC_KEY_SIZE];
+    proxc_cache_key("print(2);", 9, other);
+    CHECK(proxc_load(image, len, other) == NULL, "wrong key accepted");
+    CHECK(proxc_load(image, len - 16, key) == NULL, "truncated image accepted");
+
+    uint8_t *corrupt = (uint8_t *)malloc(len);
+    memcpy(corrupt, image, len);
+    memset(corrupt + len - 8, 0xFF, 4); /* handler table offset of the last function */
+    CHECK(proxc_load(corrupt, len, key) == NULL, "corrupt function table accepted");
+    free(corrupt);
+
+    /* Checksummed bytes: a changed local slot operand must miss */
+    corrupt = (uint8_t *)malloc(len);
+    memcpy(corrupt, image, len);
+    bool found = false;
+    for (size_t i = 0; !found && i + 2 < len; i++) {
+        found = image[i] == OP_GET_LOCAL && image[i + 1] == 1 && image[i + 2] == OP_RETURN;
+        if (found) corrupt[i + 1] = 200;
+    }
+    CHECK(found, "find inner's code");
+    CHECK(proxc_load(corrupt, len, key) == NULL, "checksum mismatch accepted");
+    free(corrupt);
+
+    /* Well-formed images whose operands do not fit their function */
+    const uint8_t badCode[][6] = {
+        { OP_CONSTANT, 9, OP_RETURN },                 /* constant index past the pool */
+        { OP_GET_GLOBAL, 0, OP_RETURN },               /* name operand is a number */
+        { OP_JUMP, 0, 1, OP_CONSTANT, 0, OP_RETURN },  /* jump into an operand */
+        { OP_LOOP, 0, 9, OP_RETURN },                  /* loop before the start */
+        { OP_WIDE, OP_CALL, 0, 1, OP_RETURN },         /* OP_CALL has no wide form */
+        { OP_GET_UPVALUE, 0, OP_RETURN },              /* no upvalues */
+        { OP_NIL, OP_POP },                            /* runs off the end */
+        { OP_CONSTANT },                               /* truncated operand */
+    };
+    const int badLength[] = { 3, 3, 6, 4, 5, 3, 2, 1 };
+    for (int i = 0; i < (int)(sizeof(badLength) / sizeof(badLength[0])); i++) {
+        ObjFunction *bad = newFunction();
+        addConstant(&bad->chunk, NUMBER_VAL(1));
+        for (int b = 0; b < badLength[i]; b++) writeChunk(&bad->chunk, badCode[i][b], 1);
+        uint8_t *badBuf;
+        size_t badLen;
+        bool serialized = proxc_serialize(bad, key, &badBuf, &badLen);
+        CHECK(serialized, "serialize unchecked code");
+        if (serialized) {
+            CHECK(proxc_load(badBuf, badLen, key) == NULL, "bad operand accepted");
+            free(badBuf);
+        }
+    }
+
+    /* Unserializable constants make the whole function uncacheable */
+    ObjFunction *dynamic = newFunction();
+    addConstant(&dynamic->chunk, OBJ_VAL(newList()));
+    writeChunk(&dynamic->chunk, OP_RETURN, 1);
+    uint8_t *unused;
+    size_t unused_len;
+    CHECK(!proxc_serialize(dynamic, key, &unused, &unused_len), "list constant serialized");
+
+    /* File round-trip */
+    const char *tmp = "tmp_image_rt.proxc";
+    CHECK(write_function_image(tmp, script) == 0, "write image file");
+    ObjFunction *fromFile = read_function_image(tmp);
+    CHECK(fromFile != NULL && same_chunk(&script->chunk, &fromFile->chunk), "read image file");
+    remove(tmp);
+
+    /* 'buf' and 'image' stay alive: loaded functions and strings point into them */
+
+    if (failures == 0) {
+        printf("bytecode image round-trip OK\n");
+        return 0;
+    }
+    return 1;
+}
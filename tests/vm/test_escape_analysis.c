@@ -0,0 +1,186 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_escape_analysis.c
+ * Verifies escape analysis on both back ends. Closures: local functions are
+ * classified by how far they travel, only-called and only-passed ones run
+ * from the stack, a stack closure handed to a function that keeps it is
+ * moved to the heap first, and returned closures still see their captured
+ * variables. IR: list literals that stay in their function are marked for
+ * frame allocation or replaced by their elements, and parameter summaries
+ * cross calls, recursive ones included.
+ */
+
+#include "test_support.h"
+#include "ir_opt.h"
+#include "escape_analysis.h"
+
+// The first statement of the body of top-level function 'name'.
+static Stmt* firstInner(StmtList* program, const char* name) {
+    for (int i = 0; i < program->count; i++) {
+        Stmt* stmt = program->items[i];
+        if (stmt->type == STMT_FUNC_DECL && strcmp(stmt->as.func_decl.name, name) == 0) {
+            return stmt->as.func_decl.body->items[0];
+        }
+    }
+    return NULL;
+}
+
+static Stmt* topLevel(StmtList* program, const char* name) {
+    for (int i = 0; i < program->count; i++) {
+        Stmt* stmt = program->items[i];
+        if (stmt->type == STMT_FUNC_DECL && strcmp(stmt->as.func_decl.name, name) == 0) return stmt;
+    }
+    return NULL;
+}
+
+static void testClassification(void) {
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* program = parseSource(
+        "func a() { func r() { return 1; } return r; }\n"
+        "func b() { func h() { return 1; } let x = h; return x; }\n"
+        "func top() { return 1; }\n"
+        "func c() { func n() { return 1; } n(); return 0; }\n"
+        "func d(f) { func m() { return 1; } f(m); return 0; }\n"
+        "func e(p, q, r) { let s = q; f(p); return r; }\n"
+        "func w() { let y = 1; func inner() { func deeper() { return y; } return deeper(); } inner(); return 0; }\n");
+    CHECK(program != NULL, "parse classification source");
+    if (program == NULL) return;
+    analyzeEscapes(program);
+
+    CHECK(analyzeClosureEscape(firstInner(program, "a")) == ESCAPE_RETURN, "returned closure");
+    CHECK(analyzeClosureEscape(firstInner(program, "b")) == ESCAPE_HEAP, "stored closure");
+    CHECK(analyzeClosureEscape(topLevel(program, "top")) == ESCAPE_GLOBAL, "top-level function");
+    CHECK(analyzeClosureEscape(firstInner(program, "c")) == ESCAPE_NONE, "only-called closure");
+    CHECK(analyzeClosureEscape(firstInner(program, "d")) == ESCAPE_ARGUMENT, "closure passed to a call");
+    CHECK(isClosureStackEligible(firstInner(program, "d")), "passed closure is stack eligible");
+
+    Stmt* e = topLevel(program, "e");
+    CHECK(e != NULL && e->as.func_decl.retainedParams == 6, "stored and returned parameters retained");
+
+    /* inner captures nothing itself but creates a closure that does */
+    Stmt* w = topLevel(program, "w");
+    Stmt* inner = w ? w->as.func_decl.body->items[1] : NULL;
+    CHECK(inner != NULL && analyzeClosureEscape(inner) == ESCAPE_HEAP, "closure that creates closures stays on the heap");
+    endCompilation(&arena);
+}
+
+static void testClosures(void) {
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* program = parseSource(
+        "func mk() { let x = 5; func get() { return x; } return get; }\n"
+        "let g = mk();\n"
+        "func noise(a, b, c) { let q = 99; return q; }\n"
+        "noise(1, 2, 3);\n"
+        "let returned = g();\n"
+        "let fs = [];\n"
+        "let i = 0;\n"
+        "while (i < 3) { let j = i * 10; func c() { return j; } push(fs, c); i = i + 1; }\n"
+        "let f0 = fs[0]; let f1 = fs[1]; let f2 = fs[2];\n"
+        "let captured = f0() + f1() + f2();\n"
+        "func apply(f, v) { return f(v); }\n"
+        "func outer(k) { func scale(v) { return v * k; } return apply(scale, 4) + apply(scale, 5); }\n"
+        "let applied = outer(3);\n"
+        "let kept = [];\n"
+        "func keep(f) { push(kept, f); return 0; }\n"
+        "func build(n) { func add(v) { return v + n; } keep(add); return apply(add, 1); }\n"
+        "let built = build(7);\n"
+        "noise(4, 5, 6);\n"
+        "let k0 = kept[0];\n"
+        "let later = k0(1);\n");
+    CHECK(program != NULL, "parse closure source");
+    if (program == NULL) return;
+
+    ObjFunction* function = compileAST(&vm, program);
+    CHECK(function != NULL && interpretFunction(&vm, function) == INTERPRET_OK, "run closure source");
+    endCompilation(&arena);
+
+    CHECK(isNumber(global("returned"), 5), "returned closure reads its captured variable");
+    CHECK(isNumber(global("captured"), 30), "each iteration's capture is kept");
+    CHECK(isNumber(global("applied"), 27), "stack closure passed as an argument");
+    CHECK(vm.stackClosures != NULL && vm.stackClosureLimit > 0, "stack closures were used");
+    CHECK(isNumber(global("built"), 8), "retained closure still callable in its frame");
+    CHECK(isNumber(global("later"), 8), "retained closure outlives its frame");
+    Value k0 = global("k0");
+    CHECK(IS_CLOSURE(k0) && !AS_CLOSURE(k0)->onStack, "retained closure was moved to the heap");
+}
+
+// The only NEW_LIST left in 'func', or NULL when there is none or several.
+static IRInstruction* onlyList(IRFunction* func, int* count) {
+    IRInstruction* found = NULL;
+    *count = 0;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == IR_OP_NEW_LIST) {
+                found = instr;
+                (*count)++;
+            }
+        }
+    }
+    return *count == 1 ? found : NULL;
+}
+
+static void testLists(void) {
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* program = parseSource(
+        "func pick() { let xs = [3, 4, 5]; return xs[1] + len(xs); }\n"
+        "func leak() { let xs = [1, 2]; return xs; }\n"
+        "func scan(i) { let xs = [1, 2, 3]; return xs[i]; }\n"
+        "func count(xs, n) { if (n < 1) { return len(xs); } return count(xs, n - 1); }\n"
+        "func stash(xs, y) { y.keep = xs; return 0; }\n"
+        "func hold(y) { let xs = [1]; count(xs, 2); stash(xs, y); return 0; }\n"
+        "func quiet() { let xs = [1]; return count(xs, 2); }\n");
+    CHECK(program != NULL, "parse list source");
+    if (program == NULL) return;
+    IRModule* module = generateSSA_IR(program);
+    optimizeIRModule(module);
+
+    int lists;
+    IRFunction* pick = findFunction(module, "pick");
+    CHECK(pick != NULL, "pick exists");
+    if (pick != NULL) {
+        onlyList(pick, &lists);
+        CHECK(lists == 0, "constant-indexed list replaced by its elements");
+    }
+
+    IRFunction* leak = findFunction(module, "leak");
+    IRInstruction* list = leak ? onlyList(leak, &lists) : NULL;
+    CHECK(list != NULL && list->escapes, "returned list escapes");
+
+    IRFunction* scan = findFunction(module, "scan");
+    list = scan ? onlyList(scan, &lists) : NULL;
+    CHECK(list != NULL && !list->escapes, "list read at a dynamic index stays in the frame");
+
+    IRFunction* count = findFunction(module, "count");
+    CHECK(count != NULL && count->paramEscapes != NULL && !count->paramEscapes[0],
+          "recursive callee does not keep its list");
+    IRFunction* stash = findFunction(module, "stash");
+    CHECK(stash != NULL && stash->paramEscapes != NULL && stash->paramEscapes[0], "stored parameter escapes");
+
+    IRFunction* hold = findFunction(module, "hold");
+    list = hold ? onlyList(hold, &lists) : NULL;
+    CHECK(list != NULL && list->escapes, "list passed to a keeping callee escapes");
+
+    IRFunction* quiet = findFunction(module, "quiet");
+    list = quiet ? onlyList(quiet, &lists) : NULL;
+    CHECK(list != NULL && !list->escapes, "list passed to a non-keeping callee stays in the frame");
+    endCompilation(&arena);
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testClassification();
+    testClosures();
+    testLists();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All escape analysis tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
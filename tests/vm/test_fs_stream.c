@@ -0,0 +1,161 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_fs_stream.c
+ * Verifies streaming file access in std.fs: lines that span read-buffer
+ * refills, CRLF endings and a last line without a newline; chunked reads
+ * into a reused Buffer; batched writes; read-only mapped views; and that
+ * read_file still returns the whole file.
+ */
+
+#include "test_support.h"
+
+#define INPUT_PATH  "fs_stream_input.tmp"
+#define OUTPUT_PATH "fs_stream_output.tmp"
+#define LONG_LINE   100000
+
+static char* content;
+static int contentLength;
+
+// 1000 short lines, a CRLF line, one line longer than the read buffer and
+// a last line with no newline
+static bool writeInput(void) {
+    content = (char*)malloc(LONG_LINE + 20000);
+    int n = 0;
+    for (int i = 0; i < 1000; i++) n += sprintf(content + n, "line%d\n", i);
+    n += sprintf(content + n, "crlf\r\n");
+    memset(content + n, 'x', LONG_LINE);
+    n += LONG_LINE;
+    content[n++] = '\n';
+    n += sprintf(content + n, "tail");
+    contentLength = n;
+
+    FILE* file = fopen(INPUT_PATH, "wb");
+    if (!file) return false;
+    fwrite(content, 1, n, file);
+    fclose(file);
+    return true;
+}
+
+static void testStreaming(void) {
+    run("use std.fs;\n"
+        "use std.buffer;\n"
+        "let f = std.fs.open(\"" INPUT_PATH "\", \"r\");\n"
+        "let lines = 0;\n"
+        "let longest = 0;\n"
+        "let crlf = null;\n"
+        "let last = null;\n"
+        "let line = std.fs.read_line(f);\n"
+        "while (line != null) {\n"
+        "    lines = lines + 1;\n"
+        "    if (len(line) > longest) { longest = len(line); }\n"
+        "    if (lines == 1001) { crlf = line; }\n"
+        "    last = line;\n"
+        "    line = std.fs.read_line(f);\n"
+        "}\n"
+        "let closed = std.fs.close(f);\n"
+        "let reusedClosed = std.fs.read_line(f);\n"
+        "\n"
+        "let g = std.fs.open(\"" INPUT_PATH "\");\n"
+        "let first = std.fs.read_line(g);\n"
+        "let buf = std.buffer.alloc(16);\n"
+        "let chunks = 0;\n"
+        "let bytes = 0;\n"
+        "let n = std.fs.read_chunk(g, 4096, buf);\n"
+        "while (n > 0) {\n"
+        "    chunks = chunks + 1;\n"
+        "    bytes = bytes + n;\n"
+        "    n = std.fs.read_chunk(g, 4096, buf);\n"
+        "}\n"
+        "let bufSize = std.buffer.size(buf);\n"
+        "std.fs.close(g);\n"
+        "\n"
+        "let h = std.fs.open(\"" INPUT_PATH "\");\n"
+        "let head = std.fs.read_chunk(h, 5);\n"
+        "let cannotWrite = std.fs.write(h, \"x\");\n"
+        "std.fs.close(h);\n"
+        "let badMode = std.fs.open(\"" INPUT_PATH "\", \"rw\");\n"
+        "let missing = std.fs.open(\"no/such/file.tmp\");\n");
+
+    CHECK(isNumber(global("lines"), 1003), "line count");
+    CHECK(isNumber(global("longest"), LONG_LINE), "line longer than the read buffer");
+    CHECK(isString(global("crlf"), "crlf"), "CRLF ending stripped");
+    CHECK(isString(global("last"), "tail"), "last line without a newline");
+    CHECK(IS_BOOL(global("closed")) && AS_BOOL(global("closed")), "close");
+    CHECK(IS_NIL(global("reusedClosed")), "closed handle reads nothing");
+
+    CHECK(isString(global("first"), "line0"), "line before chunks");
+    CHECK(isNumber(global("bytes"), contentLength - 6), "chunks pick up after the line");
+    CHECK(isNumber(global("chunks"), (contentLength - 6 + 4095) / 4096), "chunk count");
+    CHECK(isNumber(global("bufSize"), 0), "buffer emptied at end of file");
+
+    CHECK(isString(global("head"), "line0"), "chunk as a string");
+    CHECK(IS_BOOL(global("cannotWrite")) && !AS_BOOL(global("cannotWrite")), "read handle rejects writes");
+    CHECK(IS_NIL(global("badMode")), "unknown mode");
+    CHECK(IS_NIL(global("missing")), "missing file");
+}
+
+static void testWritesAndViews(void) {
+    run("use std.fs;\n"
+        "use std.buffer;\n"
+        "let w = std.fs.open(\"" OUTPUT_PATH "\", \"w\");\n"
+        "let i = 0;\n"
+        "while (i < 10000) { std.fs.write(w, \"ab\"); i = i + 1; }\n"
+        "let payload = std.buffer.alloc(8);\n"
+        "std.buffer.write_string(payload, \"END\");\n"
+        "std.fs.write(w, payload);\n"
+        "std.fs.close(w);\n"
+        "let written = std.fs.metadata(\"" OUTPUT_PATH "\");\n"
+        "let a = std.fs.open(\"" OUTPUT_PATH "\", \"a\");\n"
+        "std.fs.write(a, \"!\");\n"
+        "std.fs.close(a);\n"
+        "let appended = std.fs.metadata(\"" OUTPUT_PATH "\");\n"
+        "\n"
+        "let view = std.fs.map(\"" INPUT_PATH "\");\n"
+        "let viewSize = std.buffer.size(view);\n"
+        "let viewHead = std.buffer.to_string(std.buffer.slice(view, 0, 5));\n"
+        "let viewTail = std.buffer.slice(view, 1000);\n"
+        "let viewByte = std.buffer.read_byte(view, 4);\n"
+        "std.buffer.write_byte(view, 65);\n"
+        "std.buffer.clear(view);\n"
+        "let viewAfterWrite = std.buffer.size(view);\n"
+        "let unmapped = std.fs.unmap(view);\n"
+        "let viewAfterUnmap = std.buffer.size(view);\n"
+        "let tailAfterUnmap = std.buffer.size(viewTail);\n"
+        "let whole = std.fs.read_file(\"" INPUT_PATH "\");\n");
+
+    CHECK(isNumber(global("written"), 20003), "batched writes reach the file");
+    CHECK(isNumber(global("appended"), 20004), "append mode");
+    CHECK(isNumber(global("viewSize"), contentLength), "mapped view size");
+    CHECK(isString(global("viewHead"), "line0"), "mapped view slice");
+    CHECK(isNumber(global("viewByte"), '0'), "mapped view byte");
+    CHECK(isNumber(global("viewAfterWrite"), contentLength), "mapped view is read-only");
+    CHECK(IS_BOOL(global("unmapped")) && AS_BOOL(global("unmapped")), "unmap");
+    CHECK(isNumber(global("viewAfterUnmap"), 0), "view empty after unmap");
+    CHECK(isNumber(global("tailAfterUnmap"), 0), "slices of a view empty after unmap");
+
+    Value whole = global("whole");
+    CHECK(IS_STRING(whole) && AS_STRING(whole)->length == contentLength &&
+          memcmp(AS_CSTRING(whole), content, contentLength) == 0, "read_file");
+}
+
+int main(void) {
+    if (!writeInput()) {
+        fprintf(stderr, "FAIL: cannot create %s\n", INPUT_PATH);
+        return 1;
+    }
+    initVM(&vm);
+    registerStdLib(&vm);
+    testStreaming();
+    testWritesAndViews();
+    freeVM(&vm);
+    remove(INPUT_PATH);
+    remove(OUTPUT_PATH);
+    free(content);
+
+    if (failures == 0) printf("All fs stream tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_hash.c
+ * Verifies std.hash: known digests for SHA-256, MD5, XXH64 and CRC32C;
+ * that streaming in pieces matches hashing in one call at every split
+ * point; that multi-buffer SHA-256 matches the single-stream digests; and
+ * that script-level hashers, buffers with NUL bytes and file hashing work.
+ */
+
+#include "test_support.h"
+#include "gc.h"
+#include "sha256.h"
+#include "checksum.h"
+
+#define FILE_PATH "hash_input.tmp"
+
+static void toHex(const unsigned char* digest, int length, char* out) {
+    for (int i = 0; i < length; i++) sprintf(out + i * 2, "%02x", digest[i]);
+}
+
+static bool sha256Is(const void* data, size_t length, const char* expected) {
+    SHA256_CTX ctx;
+    unsigned char digest[SHA256_BLOCK_SIZE];
+    char hex[65];
+    sha256_init(&ctx);
+    sha256_update(&ctx, (const unsigned char*)data, length);
+    sha256_final(&ctx, digest);
+    toHex(digest, SHA256_BLOCK_SIZE, hex);
+    return strcmp(hex, expected) == 0;
+}
+
+// Bytes (i * 7 + 3) & 255, the same pattern the expected digests were made from
+static unsigned char* pattern(size_t length) {
+    unsigned char* data = (unsigned char*)malloc(length);
+    for (size_t i = 0; i < length; i++) data[i] = (unsigned char)((i * 7 + 3) & 255);
+    return data;
+}
+
+static void testKnownDigests(void) {
+    CHECK(sha256Is("", 0, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"), "sha256 empty");
+    CHECK(sha256Is("abc", 3, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), "sha256 abc");
+    CHECK(sha256Is("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56,
+                   "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"), "sha256 two blocks");
+    unsigned char* data = pattern(100000);
+    CHECK(sha256Is(data, 100000, "d96bab6a55ee326ba206dd4a85a6e95e14360d7fabbf448f03e689c24382b7d0"), "sha256 long input");
+
+    CHECK(xxh64("", 0, 0) == 0xef46db3751d8e999ULL, "xxh64 empty");
+    CHECK(xxh64("abc", 3, 0) == 0x44bc2cf5ad770999ULL, "xxh64 abc");
+    CHECK(xxh64(data, 1000, 0) == 0x5f235fa033f1a3fbULL, "xxh64 long input");
+    CHECK(xxh64(data, 1000, 2654435761ULL) == 0x83080310ee83cc20ULL, "xxh64 seeded");
+
+    CHECK(crc32c_update(0, "123456789", 9) == 0xe3069283u, "crc32c check value");
+    CHECK(crc32c_update(0, data, 1000) == 0xdd2edff7u, "crc32c long input");
+    CHECK(crc32c_update(crc32c_update(0, data, 333), data + 333, 667) == 0xdd2edff7u, "crc32c continued");
+    free(data);
+}
+
+static void testStreamingSplits(void) {
+    unsigned char* data = pattern(300);
+    unsigned char whole[SHA256_BLOCK_SIZE], part[SHA256_BLOCK_SIZE];
+    SHA256_CTX ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, 300);
+    sha256_final(&ctx, whole);
+    uint64_t xxWhole = xxh64(data, 300, 7);
+
+    bool shaOk = true, xxOk = true;
+    for (size_t split = 0; split <= 300; split++) {
+        sha256_init(&ctx);
+        sha256_update(&ctx, data, split);
+        sha256_update(&ctx, data + split, 300 - split);
+        sha256_final(&ctx, part);
+        if (memcmp(whole, part, SHA256_BLOCK_SIZE) != 0) shaOk = false;
+
+        XXH64_CTX xx;
+        xxh64_init(&xx, 7);
+        for (size_t i = 0; i < split; i++) xxh64_update(&xx, data + i, 1);
+        xxh64_update(&xx, data + split, 300 - split);
+        if (xxh64_final(&xx) != xxWhole) xxOk = false;
+    }
+    CHECK(shaOk, "sha256 split updates");
+    CHECK(xxOk, "xxh64 split updates");
+    free(data);
+}
+
+static void testMultiBuffer(void) {
+    // More messages than lanes, with lengths around the padding boundaries
+    enum { COUNT = 21 };
+    static const size_t lengths[COUNT] = {0, 1, 3, 55, 56, 63, 64, 65, 119, 120, 127, 128,
+                                          200, 1000, 4096, 5, 64, 0, 333, 56, 10000};
+    unsigned char* data = pattern(10000);
+    const unsigned char* inputs[COUNT];
+    unsigned char digests[COUNT][SHA256_BLOCK_SIZE];
+    for (int i = 0; i < COUNT; i++) inputs[i] = data + i;
+    size_t clipped[COUNT];
+    for (int i = 0; i < COUNT; i++) clipped[i] = lengths[i] + i > 10000 ? 10000 - i : lengths[i];
+
+    sha256_many(inputs, clipped, COUNT, digests);
+    bool ok = true;
+    for (int i = 0; i < COUNT; i++) {
+        unsigned char expected[SHA256_BLOCK_SIZE];
+        SHA256_CTX ctx;
+        sha256_init(&ctx);
+        sha256_update(&ctx, inputs[i], clipped[i]);
+        sha256_final(&ctx, expected);
+        if (memcmp(expected, digests[i], SHA256_BLOCK_SIZE) != 0) ok = false;
+    }
+    CHECK(ok, "multi-buffer sha256 matches single stream");
+    free(data);
+}
+
+static void testScriptApi(void) {
+    FILE* file = fopen(FILE_PATH, "wb");
+    CHECK(file != NULL, "create hash input");
+    if (file) {
+        fputs("hello world", file);
+        fclose(file);
+    }
+
+    run("use std.hash;\n"
+        "use std.buffer;\n"
+        "let oneShot = std.hash.sha256(\"hello world\");\n"
+        "let md5 = std.hash.md5(\"abc\");\n"
+        "let xx = std.hash.xxh64(\"abc\");\n"
+        "let crc = std.hash.crc32c(\"123456789\");\n"
+        "let nul = std.buffer.from_string(\"a\");\n"
+        "std.buffer.write_u8(nul, 1, 0);\n"
+        "std.buffer.write_u8(nul, 2, 98);\n"
+        "let nulSha = std.hash.sha256(nul);\n"
+        "let nulMd5 = std.hash.md5(nul);\n"
+        "let h = std.hash.hasher(\"sha256\");\n"
+        "std.hash.update(std.hash.update(h, \"hello \"), std.buffer.from_string(\"world\"));\n"
+        "let streamed = std.hash.digest(h);\n"
+        "let again = std.hash.digest(h);\n"
+        "let raw = std.buffer.size(std.hash.digest(h, true));\n"
+        "std.hash.reset(h);\n"
+        "let afterReset = std.hash.digest(std.hash.update(h, \"abc\"));\n"
+        "let c = std.hash.hasher(\"crc32c\");\n"
+        "std.hash.update(c, \"12345\");\n"
+        "std.hash.update(c, \"6789\");\n"
+        "let crcStream = std.hash.digest(c);\n"
+        "let many = std.hash.sha256_many([\"abc\", \"hello world\", nul]);\n"
+        "let fromFile = std.hash.file(\"" FILE_PATH "\");\n"
+        "let fileMd5 = std.hash.file(\"" FILE_PATH "\", \"md5\");\n"
+        "let badAlg = std.hash.hasher(\"sha1\");\n"
+        "let badData = std.hash.sha256(42);\n"
+        "let missing = std.hash.file(\"no/such/file.tmp\");\n");
+
+    const char* hello = "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9";
+    const char* abc = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+    const char* nulDigest = "59b271ae1bbcb1d31d41929817f4b16fb439eb4f31520b5ad1d5ce98920a7138";
+    CHECK(isString(global("oneShot"), hello), "script sha256");
+    CHECK(isString(global("md5"), "900150983cd24fb0d6963f7d28e17f72"), "script md5");
+    CHECK(isString(global("xx"), "44bc2cf5ad770999"), "script xxh64");
+    CHECK(IS_NUMBER(global("crc")) && AS_NUMBER(global("crc")) == 0xe3069283u, "script crc32c");
+    CHECK(isString(global("nulSha"), nulDigest), "sha256 hashes past a NUL byte");
+    CHECK(isString(global("nulMd5"), "70350f6027bce3713f6b76473084309b"), "md5 hashes past a NUL byte");
+    CHECK(isString(global("streamed"), hello), "hasher over a string and a buffer");
+    CHECK(isString(global("again"), hello), "digest leaves the hasher unchanged");
+    CHECK(IS_NUMBER(global("raw")) && AS_NUMBER(global("raw")) == 32, "raw digest buffer");
+    CHECK(isString(global("afterReset"), abc), "reset hasher");
+    CHECK(isString(global("crcStream"), "e3069283"), "streamed crc32c");
+
+    Value many = global("many");
+    CHECK(IS_LIST(many) && AS_LIST(many)->count == 3 &&
+          isString(AS_LIST(many)->items[0], abc) &&
+          isString(AS_LIST(many)->items[1], hello) &&
+          isString(AS_LIST(many)->items[2], nulDigest), "sha256_many");
+    CHECK(isString(global("fromFile"), hello), "file sha256");
+    CHECK(isString(global("fileMd5"), "5eb63bbbe01eeed093cb22bb8f5acdc3"), "file md5");
+    CHECK(IS_NIL(global("badAlg")), "unknown algorithm");
+    CHECK(IS_NIL(global("badData")), "non-byte data");
+    CHECK(IS_NIL(global("missing")), "missing file");
+
+    // Unreachable hashers release their state when collected
+    run("h = null;\nc = null;\n");
+    collectGarbage(&vm);
+    remove(FILE_PATH);
+}
+
+int main(void) {
+    testKnownDigests();
+    testStreamingSplits();
+    testMultiBuffer();
+
+    initVM(&vm);
+    registerStdLib(&vm);
+    testScriptApi();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All hash tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
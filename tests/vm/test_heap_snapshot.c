@@ -0,0 +1,237 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_heap_snapshot.c
+ * Verifies that the heap built by registerStdLib survives a snapshot
+ * round-trip: same globals, same modules and exports, and natives that
+ * still point at the right C functions; and that a process which only
+ * restores (never running registerStdLib) still gets the stdlib state kept
+ * outside the heap, so par_map takes the parallel path. Snapshots whose
+ * native table does not match this binary's, or that index past it, are
+ * rejected. The default path is per user and never in the working
+ * directory.
+ */
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#include "test_support.h"
+#include "snapshot.h"
+#include "scheduler.h"
+
+static int exportCount(const char* module) {
+    Value value;
+    if (!tableGet(&vm.importer.modules, copyString(module, (int)strlen(module)), &value)) return -1;
+    if (!IS_MODULE(value)) return -1;
+    return AS_MODULE(value)->exports.count;
+}
+
+// Field patches on a written snapshot; each returns false if it found
+// nothing to change. The header ends with the native count and ABI hash,
+// and the object table (last in the file) holds a native's table index.
+static long findAbi(const uint8_t* image, long size) {
+    uint64_t abi = stdlibNativeAbi();
+    for (long at = 0; at + 8 <= size && at < 256; at += 8) {
+        if (memcmp(image + at, &abi, 8) == 0) return at;
+    }
+    return -1;
+}
+
+static bool patchAbi(uint8_t* image, long size) {
+    long at = findAbi(image, size);
+    if (at < 0) return false;
+    image[at] ^= 0x5A;
+    return true;
+}
+
+static bool patchNativeCount(uint8_t* image, long size) {
+    long abiAt = findAbi(image, size);
+    uint32_t count = stdlibNativeCount();
+    for (long at = abiAt - 4; abiAt > 0 && at >= abiAt - 8; at -= 4) {
+        if (memcmp(image + at, &count, 4) == 0) {
+            count++;
+            memcpy(image + at, &count, 4);
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool patchNativeIndex(uint8_t* image, long size) {
+    uint32_t count = stdlibNativeCount();
+    for (long at = (size - 24) & ~7L; at >= 0; at -= 8) {
+        uint32_t fields[6];
+        memcpy(fields, image + at, sizeof(fields));
+        if (fields[0] == OBJ_NATIVE && fields[1] == 0 && fields[2] == 0 && fields[3] == 0 &&
+            fields[4] < count && fields[5] == 0) {
+            fields[4] = count;
+            memcpy(image + at, fields, sizeof(fields));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Loads a patched copy of the snapshot at 'path' into a fresh VM
+static bool acceptsPatched(const char* path, bool (*patch)(uint8_t*, long)) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return true;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* image = (uint8_t*)malloc((size_t)size);
+    bool read = image != NULL && fread(image, 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    if (!read || !patch(image, size)) {
+        free(image);
+        return true;
+    }
+
+    const char* patched = "tmp_heap_patched.pxsnap";
+    f = fopen(patched, "wb");
+    bool written = f != NULL && fwrite(image, 1, (size_t)size, f) == (size_t)size;
+    if (f != NULL) fclose(f);
+    free(image);
+
+    freeVM(&vm);
+    initVM(&vm);
+    bool accepted = !written || loadHeapSnapshot(&vm, patched);
+    remove(patched);
+    return accepted;
+}
+
+#ifdef __linux__
+static bool startsWith(const char* path, const char* prefix) {
+    return path != NULL && strncmp(path, prefix, strlen(prefix)) == 0;
+}
+
+static void testSnapshotPath(void) {
+    unsetenv("PROXPL_CACHE_DIR");
+    unsetenv("XDG_CACHE_HOME");
+    setenv("HOME", "/tmp/prox-home", 1);
+    char* path = heapSnapshotPath();
+    CHECK(startsWith(path, "/tmp/prox-home/.cache/proxpl/stdlib-"), "snapshot under ~/.cache/proxpl");
+    free(path);
+
+    setenv("XDG_CACHE_HOME", "/tmp/prox-xdg", 1);
+    path = heapSnapshotPath();
+    CHECK(startsWith(path, "/tmp/prox-xdg/proxpl/stdlib-"), "snapshot under $XDG_CACHE_HOME/proxpl");
+    free(path);
+
+    setenv("PROXPL_CACHE_DIR", "/tmp/prox-cache", 1);
+    path = heapSnapshotPath();
+    CHECK(startsWith(path, "/tmp/prox-cache/stdlib-"), "PROXPL_CACHE_DIR overrides the user cache");
+    free(path);
+
+    unsetenv("PROXPL_CACHE_DIR");
+    unsetenv("XDG_CACHE_HOME");
+    unsetenv("HOME");
+    CHECK(heapSnapshotPath() == NULL, "no snapshot without a home directory");
+
+    setenv("HOME", "/tmp/prox-home", 1);
+    setenv("PROXPL_NO_CACHE", "1", 1);
+    CHECK(heapSnapshotPath() == NULL, "PROXPL_NO_CACHE disables snapshots");
+    unsetenv("PROXPL_NO_CACHE");
+}
+
+// The parallel-safe registry is process-wide, so the snapshot is written by
+// a child and this process restores it without ever registering the stdlib.
+static void testRestoredParallelKernels(const char* path) {
+    pid_t child = fork();
+    if (child == 0) {
+        initVM(&vm);
+        registerStdLib(&vm);
+        _exit(saveHeapSnapshot(&vm, path) ? 0 : 1);
+    }
+    int status = 0;
+    CHECK(child > 0 && waitpid(child, &status, 0) == child && WIFEXITED(status) &&
+          WEXITSTATUS(status) == 0, "child writes snapshot");
+
+    initVM(&vm);
+    CHECK(loadHeapSnapshot(&vm, path), "restore without registerStdLib");
+
+    // par_map takes the parallel path exactly when its callback is registered
+    Value absFn = global("abs");
+    CHECK(IS_NATIVE(absFn) && scheduler_parallel_safe(AS_NATIVE(absFn)),
+          "math kernels are parallel-safe after a restore");
+
+    run("use std.collections;\n"
+        "let xs = [];\n"
+        "for (let i = 0; i < 10000; i = i + 1) { list_push(xs, i - 5000); }\n"
+        "let mapped = std.collections.par_map(xs, abs);\n"
+        "let mappedSerial = std.collections.map(xs, abs);\n");
+    Value mapped = global("mapped");
+    Value serial = global("mappedSerial");
+    bool same = IS_LIST(mapped) && IS_LIST(serial) && AS_LIST(mapped)->count == 10000 &&
+                memcmp(AS_LIST(mapped)->items, AS_LIST(serial)->items, sizeof(Value) * 10000) == 0;
+    CHECK(same, "par_map after a restore");
+
+    freeVM(&vm);
+    remove(path);
+}
+#endif
+
+int main(void) {
+#ifndef __linux__
+    printf("heap snapshots are not supported on this platform, skipping\n");
+    return 0;
+#else
+    const char* path = "tmp_heap.pxsnap";
+    testSnapshotPath();
+    testRestoredParallelKernels(path);
+
+    initVM(&vm);
+    registerStdLib(&vm);
+    int globals = vm.globals.count;
+    int modules = vm.importer.modules.count;
+    int mathExports = exportCount("std.native.math");
+    Value len = global("len");
+    NativeFn lenFn = IS_NATIVE(len) ? AS_NATIVE(len) : NULL;
+
+    CHECK(saveHeapSnapshot(&vm, path), "save snapshot");
+    freeVM(&vm);
+
+    initVM(&vm);
+    CHECK(loadHeapSnapshot(&vm, path), "load snapshot");
+    CHECK(vm.globals.count == globals, "global count differs");
+    CHECK(vm.importer.modules.count == modules, "module count differs");
+    CHECK(exportCount("std.native.math") == mathExports, "math exports differ");
+    CHECK(vm.initString != NULL && strcmp(vm.initString->chars, "init") == 0, "initString");
+
+    Value restored = global("len");
+    CHECK(IS_NATIVE(restored) && AS_NATIVE(restored) == lenFn, "native pointer not relocated");
+
+    Value std = global("std");
+    Value io;
+    CHECK(IS_MODULE(std) && tableGet(&AS_MODULE(std)->exports, copyString("io", 2), &io) && IS_MODULE(io),
+          "std.io binding");
+
+    CHECK(!acceptsPatched(path, patchAbi), "snapshot with another native ABI accepted");
+    CHECK(!acceptsPatched(path, patchNativeCount), "snapshot with another native count accepted");
+    CHECK(!acceptsPatched(path, patchNativeIndex), "out-of-range native index accepted");
+
+    /* A truncated snapshot is rejected without touching the VM */
+    FILE* f = fopen(path, "r+b");
+    if (f != NULL) {
+        fseek(f, 0, SEEK_END);
+        long size = ftell(f);
+        fclose(f);
+        CHECK(truncate(path, size / 2) == 0, "truncate");
+        int before = vm.globals.count;
+        CHECK(!loadHeapSnapshot(&vm, path), "truncated snapshot accepted");
+        CHECK(vm.globals.count == before, "rejected snapshot modified the VM");
+    }
+    remove(path);
+
+    if (failures == 0) {
+        printf("heap snapshot round-trip OK\n");
+        return 0;
+    }
+    return 1;
+#endif
+}
@@ -0,0 +1,116 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_ir_inline.c
+ * Verifies the interprocedural SSA passes: calls to declared functions
+ * resolve directly, small callees are inlined and folded away, recursive
+ * and oversized callees are left as calls, all-numeric call sites reach a
+ * type-specialized clone, and unused pure instructions are removed.
+ */
+
+#include "test_support.h"
+#include "ir_opt.h"
+
+static IRModule* lower(const char* source) {
+    StmtList* statements = parseSource(source);
+    if (statements == NULL) return NULL;
+
+    IRModule* module = generateSSA_IR(statements);
+    optimizeIRModule(module);
+    return module;
+}
+
+// Direct calls from func to the function with the given name.
+static int countCallsTo(IRFunction* func, const char* name) {
+    int count = 0;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == IR_OP_CALL && instr->operands[0].type == OPERAND_FUNC &&
+                strcmp(instr->operands[0].as.func->name, name) == 0) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static bool returnsConstant(IRFunction* func, double expected) {
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode != IR_OP_RETURN || instr->operandCount == 0) continue;
+            IROperand* op = &instr->operands[0];
+            if (op->type == OPERAND_CONST) return IS_NUMBER(op->as.constant) && AS_NUMBER(op->as.constant) == expected;
+            for (int j = 0; j < func->blockCount; j++) {
+                for (IRInstruction* def = func->blocks[j]->first; def; def = def->next) {
+                    if (def->result == op->as.ssaVal && def->opcode == IR_OP_CONST) {
+                        Value value = def->operands[0].as.constant;
+                        return IS_NUMBER(value) && AS_NUMBER(value) == expected;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+int main(void) {
+    initVM(&vm);
+
+    Arena arena;
+    beginCompilation(&arena);
+    IRModule* module = lower(
+        "func area(w, h) { return w * h; }\n"
+        "func sign(x) { if (x < 0) { return 0 - 1; } return 1; }\n"
+        "func fact(n) { if (n < 2) { return 1; } return n * fact(n - 1); }\n"
+        "func folded() { let unused = 2 + 3; return area(3, 4) + 1; }\n"
+        "func both(x) { return sign(x) + area(x, 2); }\n"
+        "func numeric(k) { return fact(5) + fact(k); }\n");
+    CHECK(module != NULL, "lower source");
+    if (module == NULL) return 1;
+
+    /* A tiny callee with constant arguments folds into a constant */
+    IRFunction* folded = findFunction(module, "folded");
+    CHECK(folded != NULL, "folded exists");
+    if (folded != NULL) {
+        CHECK(countOp(folded, IR_OP_CALL) == 0, "area inlined into folded");
+        CHECK(returnsConstant(folded, 13), "inlined arithmetic folds to 13");
+        CHECK(countOp(folded, IR_OP_ADD) == 0 && countOp(folded, IR_OP_MUL) == 0, "dead arithmetic removed");
+    }
+
+    /* Callees with several returns merge through a phi */
+    IRFunction* both = findFunction(module, "both");
+    if (both != NULL) {
+        CHECK(countOp(both, IR_OP_CALL) == 0, "sign and area inlined into both");
+        CHECK(countOp(both, IR_OP_PHI) >= 1, "multiple returns merge through a phi");
+        CHECK(countOp(both, IR_OP_RETURN) == 1, "inlined returns become jumps");
+    }
+
+    /* Recursion is never inlined; numeric calls reach a specialized clone */
+    IRFunction* numeric = findFunction(module, "numeric");
+    IRFunction* clone = findFunction(module, "fact$i");
+    CHECK(clone != NULL, "fact specialized for an int argument");
+    if (numeric != NULL) {
+        CHECK(countCallsTo(numeric, "fact$i") == 1, "constant argument call uses the clone");
+        CHECK(countCallsTo(numeric, "fact") == 1, "untyped argument call keeps the original");
+    }
+    if (clone != NULL) {
+        CHECK(clone->paramTypes != NULL && clone->paramTypes[0] == IR_TYPE_INT, "clone parameter is INT");
+        CHECK(countCallsTo(clone, "fact$i") == 1, "clone recursion stays in the clone");
+        CHECK(countOp(clone, IR_OP_CMP_LT) == 1, "clone keeps its comparison");
+    }
+    IRFunction* fact = findFunction(module, "fact");
+    if (fact != NULL) {
+        CHECK(countCallsTo(fact, "fact") == 1, "original keeps its boxed recursion");
+    }
+
+    endCompilation(&arena);
+
+    if (failures == 0) {
+        printf("ir inlining OK\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,141 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_ir_loops.c
+ * Verifies the SSA loop passes: invariant lengths, arithmetic and header
+ * property loads leave the loop, multiplies of an induction variable
+ * become adds, and `arr[i]` under `i < len(arr)` loses its bounds check
+ * unless a call in the loop could resize the list.
+ */
+
+#include "test_support.h"
+#include "ir_opt.h"
+
+static IRModule* lower(const char* source) {
+    StmtList* statements = parseSource(source);
+    if (statements == NULL) return NULL;
+
+    IRModule* module = generateSSA_IR(statements);
+    optimizeIRModule(module);
+    return module;
+}
+
+// Whether control can leave the block and return to it.
+static bool inLoop(IRFunction* func, IRBasicBlock* block) {
+    bool seen[256] = {false};
+    IRBasicBlock* stack[256];
+    int top = 0;
+    for (int i = 0; i < block->succCount; i++) stack[top++] = block->successors[i];
+    while (top > 0) {
+        IRBasicBlock* current = stack[--top];
+        if (current == block) return true;
+        if (seen[current->id]) continue;
+        seen[current->id] = true;
+        for (int i = 0; i < current->succCount; i++) stack[top++] = current->successors[i];
+    }
+    return false;
+}
+
+// Counts instructions with the given opcode inside (or outside) loops.
+static int countInLoops(IRFunction* func, IROpcode opcode, bool insideLoops) {
+    int count = 0;
+    for (int i = 0; i < func->blockCount; i++) {
+        if (inLoop(func, func->blocks[i]) != insideLoops) continue;
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == opcode) count++;
+        }
+    }
+    return count;
+}
+
+static int countChecked(IRFunction* func, IROpcode opcode, bool checked) {
+    int count = 0;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == opcode && instr->checked == checked) count++;
+        }
+    }
+    return count;
+}
+
+int main(void) {
+    initVM(&vm);
+
+    Arena arena;
+    beginCompilation(&arena);
+    IRModule* module = lower(
+        "func sum(arr) { let s = 0; for (let i = 0; i < len(arr); i = i + 1) { s = s + arr[i]; } return s; }\n"
+        "func fill(arr) { for (let i = 0; i < len(arr); i = i + 1) { arr[i] = i; arr[i + 1] = 0; } }\n"
+        "func shrink(arr) { for (let i = 0; i < len(arr); i = i + 1) { let x = arr[i]; list_pop(arr); } }\n"
+        "func hoist(s, n) { let t = 0; for (let i = 0; i < n; i = i + 1) { t = t + len(s) * 2; } return t; }\n"
+        "func field(p) { let t = 0; let i = 0; while (i < p.limit) { t = t + i; i = i + 1; } return t; }\n"
+        "func scaled(n) { let t = 0; let i = 0; while (i < n) { t = t + i * 4; i = i + 1; } return t; }\n");
+    CHECK(module != NULL, "lower source");
+    if (module == NULL) return 1;
+
+    /* for i in 0..len(arr): the length is hoisted and arr[i] is in range */
+    IRFunction* sum = findFunction(module, "sum");
+    CHECK(sum != NULL, "sum exists");
+    if (sum != NULL) {
+        CHECK(countInLoops(sum, IR_OP_LENGTH, true) == 0, "len(arr) hoisted out of the loop");
+        CHECK(countInLoops(sum, IR_OP_LENGTH, false) == 1, "len(arr) computed once");
+        CHECK(countChecked(sum, IR_OP_GET_INDEX, false) == 1, "arr[i] is unchecked");
+    }
+
+    /* Stores through the induction variable too, but not other indices */
+    IRFunction* fill = findFunction(module, "fill");
+    if (fill != NULL) {
+        CHECK(countChecked(fill, IR_OP_SET_INDEX, false) == 1, "arr[i] = i is unchecked");
+        CHECK(countChecked(fill, IR_OP_SET_INDEX, true) == 1, "arr[i + 1] keeps its check");
+    }
+
+    /* A call may resize the list: nothing moves and the check stays */
+    IRFunction* shrink = findFunction(module, "shrink");
+    if (shrink != NULL) {
+        CHECK(countInLoops(shrink, IR_OP_LENGTH, true) == 1, "len(arr) stays in a loop with calls");
+        CHECK(countChecked(shrink, IR_OP_GET_INDEX, true) == 1, "arr[i] keeps its check");
+    }
+
+    /* Invariant length and the numeric multiply of it leave the loop */
+    IRFunction* hoist = findFunction(module, "hoist");
+    if (hoist != NULL) {
+        CHECK(countInLoops(hoist, IR_OP_LENGTH, true) == 0, "invariant len(s) hoisted");
+        CHECK(countInLoops(hoist, IR_OP_MUL, true) == 0, "invariant multiply hoisted");
+        CHECK(countInLoops(hoist, IR_OP_MUL, false) == 1, "multiply kept before the loop");
+    }
+
+    /* A property read in the loop header is hoisted when nothing stores */
+    IRFunction* field = findFunction(module, "field");
+    if (field != NULL) {
+        CHECK(countInLoops(field, IR_OP_GET_MEMBER, true) == 0, "p.limit hoisted");
+        CHECK(countInLoops(field, IR_OP_GET_MEMBER, false) == 1, "p.limit read once");
+    }
+
+    /* i * 4 becomes a second induction variable stepped by 4 */
+    IRFunction* scaled = findFunction(module, "scaled");
+    if (scaled != NULL) {
+        CHECK(countInLoops(scaled, IR_OP_MUL, true) == 0, "multiply strength-reduced");
+        CHECK(countInLoops(scaled, IR_OP_PHI, true) == 3, "derived induction variable added");
+        bool stepsByFour = false;
+        for (int i = 0; i < scaled->blockCount; i++) {
+            for (IRInstruction* instr = scaled->blocks[i]->first; instr; instr = instr->next) {
+                if (instr->opcode == IR_OP_ADD && instr->operands[1].type == OPERAND_CONST &&
+                    AS_NUMBER(instr->operands[1].as.constant) == 4) {
+                    stepsByFour = instr->type == IR_TYPE_INT;
+                }
+            }
+        }
+        CHECK(stepsByFour, "derived variable steps by 4 as INT");
+    }
+
+    endCompilation(&arena);
+
+    if (failures == 0) {
+        printf("ir loop optimizations OK\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,86 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_ir_types.c
+ * Verifies the SSA type inference pass: types flow through phis and loop
+ * back-edges, integral values widen to float when mixed, and anything that
+ * touches an untyped parameter stays boxed.
+ */
+
+#include "test_support.h"
+#include "ir_opt.h"
+#include "arena.h"
+
+static IRModule* lower(const char* source) {
+    StmtList* statements = parseSource(source);
+    if (statements == NULL) return NULL;
+
+    IRModule* module = generateSSA_IR(statements);
+    for (int i = 0; i < module->funcCount; i++) {
+        promoteMemoryToRegisters(module->functions[i]);
+        constantFold(module->functions[i]);
+        runTypeInferencePass(module->functions[i]);
+        deadCodeElimination(module->functions[i]);
+    }
+    return module;
+}
+
+// Counts instructions with the given opcode and type.
+static int countTyped(IRFunction* func, IROpcode opcode, IRType type) {
+    int count = 0;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == opcode && instr->type == type) count++;
+        }
+    }
+    return count;
+}
+
+int main(void) {
+    initVM(&vm);
+
+    Arena arena;
+    beginCompilation(&arena);
+    IRModule* module = lower(
+        "func count(n) { let s = 0; let i = 0; while (i < n) { s = s + i * 2; i = i + 1; } return s; }\n"
+        "func mixed(n) { let x = 1; while (x < n) { x = x / 2; } return x; }\n"
+        "func pick(a, n) { let v = 0; if (n > 1) { v = a; } return v; }\n");
+    CHECK(module != NULL, "lower source");
+    if (module == NULL) return 1;
+
+    /* Integer loop: both loop-carried phis stay INT across the back-edge */
+    IRFunction* count = findFunction(module, "count");
+    CHECK(count != NULL && count->paramCount == 1, "count has one parameter");
+    if (count != NULL) {
+        CHECK(countOp(count, IR_OP_PHI) == 2, "two loop phis");
+        CHECK(countTyped(count, IR_OP_PHI, IR_TYPE_INT) == 2, "loop phis are INT");
+        CHECK(countTyped(count, IR_OP_ADD, IR_TYPE_INT) == 2, "increments are INT");
+        CHECK(countTyped(count, IR_OP_MUL, IR_TYPE_INT) == 1, "multiply is INT");
+        CHECK(countTyped(count, IR_OP_CMP_LT, IR_TYPE_BOOL) == 1, "comparison is BOOL");
+    }
+
+    /* Division makes the loop-carried value FLOAT, widening the phi */
+    IRFunction* mixed = findFunction(module, "mixed");
+    if (mixed != NULL) {
+        CHECK(countTyped(mixed, IR_OP_DIV, IR_TYPE_FLOAT) == 1, "division is FLOAT");
+        CHECK(countTyped(mixed, IR_OP_PHI, IR_TYPE_FLOAT) == 1, "INT joined with FLOAT is FLOAT");
+    }
+
+    /* A phi mixing a number with an untyped parameter stays boxed */
+    IRFunction* pick = findFunction(module, "pick");
+    if (pick != NULL) {
+        CHECK(countOp(pick, IR_OP_PHI) == 1, "one merge phi");
+        CHECK(countTyped(pick, IR_OP_PHI, IR_TYPE_UNKNOWN) == 1, "merge with parameter is UNKNOWN");
+    }
+
+    endCompilation(&arena);
+
+    if (failures == 0) {
+        printf("ir type inference OK\n");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,158 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_iterator.c
+ * Verifies the iterator protocol: for-in over lists, tensors, strings and
+ * iterators with break, continue and per-iteration captures; that lazy
+ * std.iter pipelines only pull the items they produce, even from a range
+ * of a billion; the combinators and consumers; and that errors from a
+ * non-iterable value or a failing callback reach the caller.
+ */
+
+#include "test_support.h"
+#include "gc.h"
+
+static void testForIn(void) {
+    run("use std.iter;\n"
+        "let total = 0;\n"
+        "for (let x in [10, 20, 30]) { total = total + x; }\n"
+        "let joined = \"\";\n"
+        "for (s in [\"a\", \"b\", \"c\", \"d\"]) {\n"
+        "    if (s == \"b\") { continue; }\n"
+        "    if (s == \"d\") { break; }\n"
+        "    joined = joined + s;\n"
+        "}\n"
+        "let chars = 0;\n"
+        "let last = null;\n"
+        "for (let c in \"h\xc3\xa9llo\") { chars = chars + 1; if (chars == 2) { last = c; } }\n"
+        "let pairs = 0;\n"
+        "for (let i in std.iter.range(3)) { for (let j in std.iter.range(i)) { pairs = pairs + 1; } }\n"
+        "let fns = [];\n"
+        "for (let k in std.iter.range(3)) { push(fns, func() { return k; }); }\n"
+        "let captured = fns[0]() + fns[1]() * 10 + fns[2]() * 100;\n"
+        "func firstOver(xs, limit) {\n"
+        "    for (let x in xs) { if (x > limit) { return x; } }\n"
+        "    return -1;\n"
+        "}\n"
+        "let over = firstOver(std.iter.range(0, 100, 7), 30);\n"
+        "let none = firstOver([1, 2], 5);\n"
+        "let slot = 0;\n"
+        "for (let i = 0; i < 3; i = i + 1) { slot = slot + i; }\n");
+
+    CHECK(isNumber(global("total"), 60), "for-in over a numeric literal");
+    CHECK(isString(global("joined"), "ac"), "continue and break");
+    CHECK(isNumber(global("chars"), 5), "strings iterate by character");
+    CHECK(isString(global("last"), "\xc3\xa9"), "multi-byte character");
+    CHECK(isNumber(global("pairs"), 3), "nested loops");
+    CHECK(isNumber(global("captured"), 210), "closures capture each iteration's value");
+    CHECK(isNumber(global("over"), 35), "return from inside a loop");
+    CHECK(isNumber(global("none"), -1), "loop inside a function");
+    CHECK(isNumber(global("slot"), 3), "locals after a use statement");
+}
+
+static void testLazyPipeline(void) {
+    run("use std.iter;\n"
+        "let tested = 0;\n"
+        "let squares = std.iter.take(\n"
+        "    std.iter.map(\n"
+        "        std.iter.filter(std.iter.range(0, 1000000000),\n"
+        "                        func(x) { tested = tested + 1; return x % 3 == 0; }),\n"
+        "        func(x) { return x * x; }),\n"
+        "    5);\n"
+        "let testedBefore = tested;\n"
+        "let firstFive = std.iter.collect(squares);\n"
+        "let again = std.iter.collect(squares);\n"
+        "let garbage = std.iter.map(std.iter.range(2000),\n"
+        "    func(x) { let s = \"n\" + to_string(x); if (x % 500 == 0) { std.gc.collect(); } return s; });\n"
+        "let kept = 0;\n"
+        "for (let s in garbage) { if (len(s) == 4) { kept = kept + 1; } }\n");
+
+    double squares[] = { 0, 9, 36, 81, 144 };
+    CHECK(isNumber(global("testedBefore"), 0), "building a pipeline runs nothing");
+    CHECK(isNumberList(global("firstFive"), squares, 5), "filter, map and take");
+    CHECK(isNumber(global("tested"), 13), "only the needed items are pulled");
+    CHECK(isNumberList(global("again"), NULL, 0), "an exhausted pipeline stays exhausted");
+    CHECK(isNumber(global("kept"), 900), "items survive collections mid-pipeline");
+}
+
+static void testCombinators(void) {
+    run("use std.iter;\n"
+        "let skipped = std.iter.collect(std.iter.skip(std.iter.range(10), 7));\n"
+        "let chained = std.iter.collect(std.iter.chain([1, 2], std.iter.range(3, 5)));\n"
+        "let zipped = std.iter.collect(std.iter.zip([\"a\", \"b\", \"c\"], std.iter.range(100)));\n"
+        "let numbered = std.iter.collect(std.iter.enumerate(\"xy\"));\n"
+        "let it = std.iter.iter([5, 6]);\n"
+        "let n1 = std.iter.next(it);\n"
+        "let n2 = std.iter.next(it);\n"
+        "let n3 = std.iter.next(it, -1);\n"
+        "let rest = std.iter.collect(std.iter.skip(std.iter.range(1, 2, 0.25), 1));\n"
+        "let down = std.iter.collect(std.iter.range(3, 0, -1));\n"
+        "let product = std.iter.reduce(std.iter.range(1, 6), func(a, b) { return a * b; }, 1);\n"
+        "let total = std.iter.sum(std.iter.range(1, 101));\n"
+        "let mixed = std.iter.sum([1, \"x\"]);\n"
+        "let counted = std.iter.count(std.iter.filter(std.iter.range(100), func(x) { return x % 10 == 0; }));\n"
+        "let notIterable = std.iter.map(5, func(x) { return x; });\n"
+        "let badCount = std.iter.take([1], -1);\n");
+
+    double skipped[] = { 7, 8, 9 };
+    double chained[] = { 1, 2, 3, 4 };
+    double rest[] = { 1.25, 1.5, 1.75 };
+    double down[] = { 3, 2, 1 };
+    CHECK(isNumberList(global("skipped"), skipped, 3), "skip");
+    CHECK(isNumberList(global("chained"), chained, 4), "chain");
+
+    Value zipped = global("zipped");
+    CHECK(IS_LIST(zipped) && AS_LIST(zipped)->count == 3, "zip stops at the shorter side");
+    if (IS_LIST(zipped) && AS_LIST(zipped)->count == 3) {
+        Value pair = AS_LIST(zipped)->items[2];
+        CHECK(IS_LIST(pair) && isString(AS_LIST(pair)->items[0], "c") &&
+              isNumber(AS_LIST(pair)->items[1], 2), "zip pairs");
+    }
+    Value numbered = global("numbered");
+    CHECK(IS_LIST(numbered) && AS_LIST(numbered)->count == 2, "enumerate");
+    if (IS_LIST(numbered) && AS_LIST(numbered)->count == 2) {
+        Value pair = AS_LIST(numbered)->items[1];
+        CHECK(IS_LIST(pair) && isNumber(AS_LIST(pair)->items[0], 1) &&
+              isString(AS_LIST(pair)->items[1], "y"), "enumerate pairs");
+    }
+
+    CHECK(isNumber(global("n1"), 5) && isNumber(global("n2"), 6), "next");
+    CHECK(isNumber(global("n3"), -1), "next past the end returns the default");
+    CHECK(isNumberList(global("rest"), rest, 3), "fractional steps");
+    CHECK(isNumberList(global("down"), down, 3), "negative steps");
+    CHECK(isNumber(global("product"), 120), "reduce");
+    CHECK(isNumber(global("total"), 5050), "sum");
+    CHECK(IS_NIL(global("mixed")), "sum of a non-number");
+    CHECK(isNumber(global("counted"), 10), "count");
+    CHECK(IS_NIL(global("notIterable")), "non-iterable source");
+    CHECK(IS_NIL(global("badCount")), "negative count");
+}
+
+static void testErrors(void) {
+    CHECK(execute("for (let x in 5) { print(x); }\n") == INTERPRET_RUNTIME_ERROR,
+          "for-in over a number fails");
+    CHECK(execute("use std.iter;\n"
+                  "let failing = std.iter.map([1, 2], func(x) { return x + null; });\n"
+                  "for (let y in failing) { print(y); }\n") == INTERPRET_RUNTIME_ERROR,
+          "a failing callback stops the loop");
+    CHECK(execute("use std.iter;\n"
+                  "let afterError = std.iter.sum(std.iter.range(4));\n") == INTERPRET_OK,
+          "the VM runs again after an error");
+    CHECK(isNumber(global("afterError"), 6), "result after an error");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testForIn();
+    testLazyPipeline();
+    testCombinators();
+    testErrors();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All iterator tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
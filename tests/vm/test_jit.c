@@ -0,0 +1,93 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_jit.c
+ * Verifies the tier-up analysis (which functions qualify, stack depths,
+ * loop headers, feedback-driven types) and that hot functions give the same
+ * results whether they run compiled, deoptimize or stay interpreted.
+ */
+
+#include "test_support.h"
+#include "jit.h"
+#include "bytecode.h"
+
+static ObjFunction* globalFunction(const char* name) {
+    Value value = global(name);
+    return IS_CLOSURE(value) ? AS_CLOSURE(value)->function : NULL;
+}
+
+int main(void) {
+    initVM(&vm);
+
+    const char* source =
+        "func sum(n) { let s = 0; let i = 0; while (i < n) { s = s + i; i = i + 1; } return s; }\n"
+        "func show(x) { print(x); }\n"
+        "func add(a, b) { return a + b; }\n"
+        "func div(a, b) { return a / b; }\n";
+    CHECK(execute(source) == INTERPRET_OK, "define functions");
+
+    ObjFunction* sum = globalFunction("sum");
+    ObjFunction* show = globalFunction("show");
+    CHECK(sum != NULL && show != NULL, "functions defined");
+    if (sum == NULL || show == NULL) return 1;
+
+    /* Without feedback parameters are untyped; loop variables are numbers */
+    JitPlan plan;
+    CHECK(jitAnalyze(sum, &plan), "numeric loop should be compilable");
+    if (plan.depth != NULL) {
+        int headers = 0;
+        for (int ip = 0; ip < plan.codeLength; ip++) {
+            if (!(plan.flags[ip] & JIT_FLAG_OSR)) continue;
+            headers++;
+            CHECK(plan.depth[ip] == 4, "callee, n, s and i are live at the loop header");
+            CHECK(plan.types[ip * plan.maxDepth + 1] == JIT_TYPE_ANY, "n has no feedback yet");
+            CHECK(plan.types[ip * plan.maxDepth + 2] == JIT_TYPE_NUMBER, "s is a number");
+            CHECK(plan.types[ip * plan.maxDepth + 3] == JIT_TYPE_NUMBER, "i is a number");
+        }
+        CHECK(headers == 1, "one loop header");
+        jitFreePlan(&plan);
+    }
+
+    sum->paramFeedback = JIT_FEEDBACK_SEEN;
+    CHECK(jitAnalyze(sum, &plan), "reanalyze with feedback");
+    if (plan.depth != NULL) {
+        CHECK(plan.types[1] == JIT_TYPE_NUMBER, "numeric feedback types the parameter");
+        jitFreePlan(&plan);
+    }
+    sum->paramFeedback = 0;
+
+    CHECK(!jitAnalyze(show, &plan), "functions touching globals stay interpreted");
+
+    /* Hot calls, a long loop (OSR) and deopts must not change results */
+    CHECK(execute("let total = 0;\n"
+                  "let k = 0;\n"
+                  "while (k < 3000) { total = total + add(k, 1); k = k + 1; }\n"
+                  "let big = sum(100000);\n"
+                  "let joined = add(\"a\", 1);\n"
+                  "let again = add(2, 3);\n"
+                  "let q = 0;\n"
+                  "while (q < 2000) { div(q, 4); q = q + 1; }\n"
+                  "let quarter = div(1, 4);\n") == INTERPRET_OK, "run hot code");
+    CHECK(isNumber(global("total"), 4501500), "sum of add() results");
+    CHECK(isNumber(global("big"), 4999950000.0), "sum(100000)");
+    CHECK(isNumber(global("again"), 5), "add() after a deopt");
+    CHECK(isNumber(global("quarter"), 0.25), "div()");
+    Value joined = global("joined");
+    CHECK(IS_STRING(joined) && strcmp(AS_STRING(joined)->chars, "a1") == 0, "string argument deoptimizes");
+
+    ObjFunction* add = globalFunction("add");
+    CHECK(add != NULL && add->jitState != JIT_COLD, "hot function left the cold tier");
+    CHECK(add != NULL && add->jitState == JIT_COMPILED ? add->jitCode != NULL : true, "compiled code present");
+
+    /* Division by zero is still reported by the interpreter */
+    CHECK(execute("div(1, 0);\n") != INTERPRET_OK, "division by zero must fail");
+
+    if (failures == 0) {
+        printf("jit tiering OK (%s)\n", add != NULL && add->jitState == JIT_COMPILED ? "native" : "interpreted");
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,201 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_json.c
+ * Verifies the JSON engine: documents build the expected lists and
+ * dictionaries, escapes decode (including backslash runs that straddle the
+ * 64-byte blocks of the structural index), malformed input is rejected,
+ * on-demand lookups find values without validating the rest, and the
+ * serializer escapes strings, formats numbers that read back exactly and
+ * stops on cycles. The natives are checked end to end from a script.
+ */
+
+#include <math.h>
+#include "test_support.h"
+#include "json.h"
+
+static bool parseText(const char* text, Value* out) {
+    JsonError error;
+    return jsonParse(text, strlen(text), out, &error);
+}
+
+static Value field(Value dict, const char* key) {
+    Value value = NIL_VAL;
+    if (IS_DICTIONARY(dict)) {
+        tableGet(&AS_DICTIONARY(dict)->items, copyString(key, (int)strlen(key)), &value);
+    }
+    return value;
+}
+
+static bool stringifiesTo(Value value, const char* expected) {
+    JsonError error;
+    ObjString* text = jsonStringify(value, &error);
+    return text != NULL && strcmp(text->chars, expected) == 0;
+}
+
+static void testParse(void) {
+    Value doc;
+    CHECK(parseText(" {\"a\": [1, 2.5, -3e2, true, false, null],\n"
+                "  \"s\": \"h\\u00e9\\n\\\"q\\\"\\/\", \"o\": {\"k\": \"v\", \"e\": {}, \"l\": []}} ", &doc),
+          "parse document");
+    push(&vm, doc);
+    Value a = field(doc, "a");
+    CHECK(IS_LIST(a) && AS_LIST(a)->count == 6, "array length");
+    if (IS_LIST(a) && AS_LIST(a)->count == 6) {
+        Value* items = AS_LIST(a)->items;
+        CHECK(isNumber(items[0], 1) && isNumber(items[1], 2.5) && isNumber(items[2], -300), "numbers");
+        CHECK(IS_BOOL(items[3]) && AS_BOOL(items[3]) && IS_BOOL(items[4]) && !AS_BOOL(items[4]), "booleans");
+        CHECK(IS_NIL(items[5]), "null");
+    }
+    CHECK(isString(field(doc, "s"), "h\xc3\xa9\n\"q\"/"), "string escapes");
+    Value o = field(doc, "o");
+    CHECK(isString(field(o, "k"), "v"), "nested object");
+    CHECK(IS_DICTIONARY(field(o, "e")) && IS_LIST(field(o, "l")), "empty containers");
+    pop(&vm);
+
+    Value value;
+    CHECK(parseText("\"\\ud83d\\ude00\"", &value) && isString(value, "\xf0\x9f\x98\x80"), "surrogate pair");
+    CHECK(parseText("12345678901234567890", &value) && isNumber(value, 12345678901234567890.0), "long integer");
+    CHECK(parseText("0.1", &value) && isNumber(value, 0.1), "fraction");
+    CHECK(parseText("-0", &value) && isNumber(value, 0), "negative zero");
+    CHECK(parseText("{\"k\": 1, \"k\": 2}", &value) && isNumber(field(value, "k"), 2), "last duplicate key wins");
+
+    /* Backslash runs at every position around the block boundaries */
+    char text[256];
+    char expected[256];
+    for (int pad = 0; pad < 140; pad++) {
+        memset(text, 0, sizeof(text));
+        text[0] = '"';
+        memset(text + 1, 'x', (size_t)pad);
+        strcpy(text + 1 + pad, "\\\\\\\"z\\\\\"");
+        memset(expected, 'x', (size_t)pad);
+        strcpy(expected + pad, "\\\"z\\");
+        if (!parseText(text, &value) || !isString(value, expected)) {
+            fprintf(stderr, "FAIL: backslashes after %d bytes\n", pad);
+            failures++;
+            break;
+        }
+    }
+}
+
+static void testMalformed(void) {
+    const char* bad[] = {
+        "", "   ", "[1,]", "{\"a\" 1}", "[1 2]", "\"abc", "tru", "nulls", "01", "1.", "1e", "-",
+        "[1]x", "{\"a\":1,}", "\"a\x01\"", "[\"\\x\"]", "\"\\ud83d\"", "{1: 2}", "[", "]", "\"a\" \"b\"",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        Value value;
+        JsonError error;
+        if (jsonParse(bad[i], strlen(bad[i]), &value, &error) || error.message == NULL) {
+            fprintf(stderr, "FAIL: accepted malformed input '%s'\n", bad[i]);
+            failures++;
+        }
+    }
+
+    char deep[JSON_MAX_DEPTH * 2 + 8];
+    memset(deep, '[', JSON_MAX_DEPTH + 1);
+    memset(deep + JSON_MAX_DEPTH + 1, ']', JSON_MAX_DEPTH + 1);
+    deep[(JSON_MAX_DEPTH + 1) * 2] = '\0';
+    Value value;
+    CHECK(!parseText(deep, &value), "nesting limit");
+}
+
+static bool getPath(const char* text, const char* a, const char* b, Value* out) {
+    JsonPathSegment path[2] = { { a, strlen(a) }, { b, b ? strlen(b) : 0 } };
+    JsonError error;
+    return jsonGet(text, strlen(text), path, b ? 2 : 1, out, &error);
+}
+
+static void testGet(void) {
+    const char* doc = "{\"skip\": {\"deep\": [1, {\"x\": \"}\"}]}, \"a\": [10, {\"b\": \"found\"}], \"t\\\"q\": 3}";
+    Value value;
+    CHECK(getPath(doc, "a", "1", &value) && IS_DICTIONARY(value) && isString(field(value, "b"), "found"),
+          "path through an array");
+    CHECK(getPath(doc, "a", "0", &value) && isNumber(value, 10), "array index");
+    CHECK(getPath(doc, "a", "5", &value) && IS_NIL(value), "index past the end");
+    CHECK(getPath(doc, "missing", NULL, &value) && IS_NIL(value), "missing key");
+    CHECK(getPath(doc, "t\"q", NULL, &value) && isNumber(value, 3), "escaped key");
+    CHECK(getPath(doc, "skip", "deep", &value) && IS_LIST(value) && AS_LIST(value)->count == 2,
+          "object value");
+
+    /* The rest of the document is never built or validated */
+    CHECK(getPath("{\"a\": 1, \"b\": [1 2 3}", "a", NULL, &value) && isNumber(value, 1),
+          "malformed tail is not visited");
+    CHECK(!getPath("{\"a\": 1, \"b\": \"open}", "a", NULL, &value), "unterminated string still fails");
+}
+
+static void testStringify(void) {
+    ObjList* list = newList();
+    push(&vm, OBJ_VAL(list));
+    appendToList(list, NUMBER_VAL(1));
+    appendToList(list, NUMBER_VAL(2.5));
+    appendToList(list, OBJ_VAL(copyString("a\"b\\\n\x01", 6)));
+    appendToList(list, BOOL_VAL(true));
+    appendToList(list, NIL_VAL);
+    appendToList(list, NUMBER_VAL(-42));
+    CHECK(stringifiesTo(OBJ_VAL(list), "[1,2.5,\"a\\\"b\\\\\\n\\u0001\",true,null,-42]"), "list");
+
+    ObjDictionary* dict = newDictionary();
+    push(&vm, OBJ_VAL(dict));
+    tableSet(&dict->items, copyString("k", 1), OBJ_VAL(list));
+    CHECK(stringifiesTo(OBJ_VAL(dict), "{\"k\":[1,2.5,\"a\\\"b\\\\\\n\\u0001\",true,null,-42]}"), "dictionary");
+
+    CHECK(stringifiesTo(NUMBER_VAL(0.1), "0.1"), "short fraction");
+    CHECK(stringifiesTo(NUMBER_VAL(1.0 / 3.0), "0.33333333333333331"), "fraction needing 17 digits");
+    CHECK(stringifiesTo(NUMBER_VAL(1e300), "1e+300"), "large number");
+    CHECK(stringifiesTo(NUMBER_VAL(NAN), "null"), "NaN");
+
+    /* Round trip */
+    JsonError error;
+    ObjString* text = jsonStringify(OBJ_VAL(dict), &error);
+    Value back;
+    CHECK(text != NULL && jsonParse(text->chars, (size_t)text->length, &back, &error), "round trip parses");
+    CHECK(stringifiesTo(back, text ? text->chars : ""), "round trip is stable");
+
+    appendToList(list, OBJ_VAL(list));
+    CHECK(jsonStringify(OBJ_VAL(list), &error) == NULL && error.message != NULL, "cycle detected");
+    pop(&vm);
+    pop(&vm);
+}
+
+static void testNatives(void) {
+    const char* source =
+        "use std.json;\n"
+        "let text = std.json.stringify([7, [\"x\", \"y\"], null]);\n"
+        "let doc = std.json.parse(text);\n"
+        "let n = doc[0];\n"
+        "let tag = std.json.get(text, \"1.1\");\n"
+        "let listed = std.json.get(text, [1, 0]);\n"
+        "let bad = std.json.parse(\"[1,\");\n";
+    CHECK(execute(source) == INTERPRET_OK, "run native source");
+
+    Value value;
+    tableGet(&vm.globals, copyString("n", 1), &value);
+    CHECK(isNumber(value, 7), "parse from a script");
+    tableGet(&vm.globals, copyString("tag", 3), &value);
+    CHECK(isString(value, "y"), "get with a dotted path");
+    tableGet(&vm.globals, copyString("listed", 6), &value);
+    CHECK(isString(value, "x"), "get with a list path");
+    tableGet(&vm.globals, copyString("text", 4), &value);
+    CHECK(isString(value, "[7,[\"x\",\"y\"],null]"), "stringify from a script");
+    value = NUMBER_VAL(0);
+    tableGet(&vm.globals, copyString("bad", 3), &value);
+    CHECK(IS_NIL(value), "malformed input yields nil");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testParse();
+    testMalformed();
+    testGet();
+    testStringify();
+    testNatives();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All JSON tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_loop_layout.c
+ * Verifies rotated loops and the branch opcodes: relational loop conditions
+ * compile to a single fused backward branch, 'break' and 'continue' still
+ * land in the right place, and <= / >= compare directly (including through
+ * operator overloads) instead of negating > / <.
+ */
+
+#include "test_support.h"
+#include "bytecode.h"
+
+// Counts raw bytes equal to 'op'. Good enough for these small functions,
+// whose operands never collide with the opcodes checked.
+static int countByte(ObjFunction* function, uint8_t op) {
+    int count = 0;
+    for (int i = 0; i < function->chunk.count; i++) {
+        if (function->chunk.code[i] == op) count++;
+    }
+    return count;
+}
+
+int main(void) {
+    initVM(&vm);
+
+    CHECK(execute("func sum(n) { let s = 0; let i = 0; while (i < n) { s = s + i; i = i + 1; } return s; }\n"
+                  "func down(n) { let s = 0; for (let i = n; i >= 0; i = i - 1) { s = s + i; } return s; }\n"
+                  "func skip(n) {\n"
+                  "  let s = 0;\n"
+                  "  for (let i = 0; i <= n; i = i + 1) { if (i == 3) continue; if (i == 8) break; s = s + i; }\n"
+                  "  return s;\n"
+                  "}\n"
+                  "func odd(n) { let s = 0; while (n > 0) { n = n - 1; if (n % 2 == 0) continue; s = s + n; } return s; }\n"
+                  "func le(a, b) { return a <= b; }\n"
+                  "func ge(a, b) { return a >= b; }\n") == INTERPRET_OK, "define functions");
+
+    /* Each relational loop ends in one fused compare-and-branch */
+    Value sum = global("sum");
+    Value down = global("down");
+    CHECK(IS_CLOSURE(sum) && IS_CLOSURE(down), "functions defined");
+    if (IS_CLOSURE(sum)) {
+        ObjFunction* function = AS_CLOSURE(sum)->function;
+        CHECK(countByte(function, OP_LOOP_IF_LESS) == 1, "while (i < n) uses OP_LOOP_IF_LESS");
+        CHECK(countByte(function, OP_LOOP) == 0, "no unconditional back-edge");
+    }
+    if (IS_CLOSURE(down)) {
+        ObjFunction* function = AS_CLOSURE(down)->function;
+        CHECK(countByte(function, OP_LOOP_IF_GREATER_EQUAL) == 1, "for (; i >= 0;) uses OP_LOOP_IF_GREATER_EQUAL");
+        CHECK(countByte(function, OP_NOT) == 0, ">= no longer lowers to OP_LESS + OP_NOT");
+    }
+
+    CHECK(execute("let a = sum(100);\n"
+                  "let b = down(10);\n"
+                  "let c = skip(20);\n"
+                  "let d = odd(10);\n"
+                  "let e = sum(0);\n"
+                  "let le1 = le(1, 2);\n"
+                  "let le2 = le(2, 2);\n"
+                  "let le3 = le(3, 2);\n"
+                  "let ge1 = ge(3, 2);\n"
+                  "let ge2 = ge(1, 2);\n") == INTERPRET_OK, "run loops");
+    CHECK(isNumber(global("a"), 4950), "while loop");
+    CHECK(isNumber(global("b"), 55), "counting-down for loop");
+    CHECK(isNumber(global("c"), 0 + 1 + 2 + 4 + 5 + 6 + 7), "continue runs the increment, break exits");
+    CHECK(isNumber(global("d"), 9 + 7 + 5 + 3 + 1), "continue re-tests a while condition");
+    CHECK(isNumber(global("e"), 0), "loop that never runs");
+    CHECK(isBool(global("le1"), true) && isBool(global("le2"), true) && isBool(global("le3"), false), "<= on numbers");
+    CHECK(isBool(global("ge1"), true) && isBool(global("ge2"), false), ">= on numbers");
+
+    /* <= dispatches to operator<=, including inside a fused loop test */
+    CHECK(execute("class Box {\n"
+                  "  init(v) { this.v = v; }\n"
+                  "  operator<=(other) { return this.v <= other.v; }\n"
+                  "}\n"
+                  "let small = Box(1) <= Box(2);\n"
+                  "let large = Box(3) <= Box(2);\n"
+                  "let limit = Box(5);\n"
+                  "let steps = 0;\n"
+                  "let box = Box(0);\n"
+                  "while (box <= limit) { steps = steps + 1; box = Box(box.v + 1); }\n") == INTERPRET_OK, "run operator<=");
+    CHECK(isBool(global("small"), true) && isBool(global("large"), false), "operator<= result");
+    CHECK(isNumber(global("steps"), 6), "operator<= in a loop condition");
+
+    CHECK(execute("let bad = 1 <= \"x\";\n") != INTERPRET_OK, "mixed comparison must fail");
+
+    if (failures == 0) {
+        printf("loop layout OK\n");
+        return 0;
+    }
+    return 1;
+}
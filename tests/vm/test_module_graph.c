@@ -0,0 +1,295 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_module_graph.c
+ * Verifies the parallel module pipeline: dotted `use` names resolve to
+ * files under the entry directory, shared dependencies are compiled once
+ * and linked before their users, each module exports what it defined,
+ * cycles terminate, and a module that fails to scan fails the build.
+ * Literals created by the workers survive a collection after the build,
+ * and the collection threshold is restored whether or not it succeeds.
+ * Rebuilds skip unchanged modules, and only an interface change in a
+ * dependency recompiles its users. Only entry files whose every `use` is a
+ * registered native module may go through the compile cache, and the PRM
+ * builder counts and watches what it actually compiled.
+ */
+
+#include <sys/stat.h>
+#include "test_support.h"
+#include "module_graph.h"
+#include "gc.h"
+#include "prm/prm.h"
+
+static char root[64];
+
+static void writeModule(const char* relative, const char* source) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", root, relative);
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "cannot write %s\n", path);
+        exit(1);
+    }
+    fputs(source, file);
+    fclose(file);
+}
+
+static bool runEntry(StmtList* statements) {
+    ObjFunction* function = compileAST(&vm, statements);
+    return function != NULL && interpretFunction(&vm, function) == INTERPRET_OK;
+}
+
+static ObjModule* module(const char* name) {
+    Value value = NIL_VAL;
+    if (!tableGet(&vm.importer.modules, copyString(name, (int)strlen(name)), &value)) return NULL;
+    return IS_MODULE(value) ? AS_MODULE(value) : NULL;
+}
+
+static bool exports(ObjModule* mod, const char* name) {
+    Value value;
+    return mod != NULL && tableGet(&mod->exports, copyString(name, (int)strlen(name)), &value);
+}
+
+static void testDiamond(void) {
+    /* util and the entry both use lib.math; lib.math and util use lib.base */
+    writeModule("lib/base.prox", "let base = 3;\nlet label = \"diamond base\";\n");
+    writeModule("lib/math.prox", "use lib.base;\nfunc square(x) { return x * x; }\nlet tau = base * 2;\n");
+    writeModule("util.prox", "use lib.base;\nuse lib.math;\nlet answer = square(6) + base;\n");
+
+    char entryPath[128];
+    snprintf(entryPath, sizeof(entryPath), "%s/main.prox", root);
+
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* entry = parseSource("use util;\nuse lib.math;\nlet result = square(4) + tau + answer;\n");
+    CHECK(entry != NULL, "parse entry");
+
+    ModuleGraph graph;
+    initModuleGraph(&graph, entryPath);
+    CHECK(buildModuleGraph(&graph, entry), "build diamond graph");
+    CHECK(graph.count == 3, "each module compiled once");
+    CHECK(graph.rootCount == 2, "entry roots");
+
+    /* Worker-created literals are pinned in the unit arenas */
+    collectGarbage(&vm);
+    CHECK(linkModuleGraph(&graph, &vm) == INTERPRET_OK, "link diamond graph");
+    CHECK(runEntry(entry), "run entry");
+    endCompilation(&arena);
+    freeModuleGraph(&graph);
+
+    CHECK(isNumber(global("tau"), 6), "dependency linked before its user");
+    CHECK(isNumber(global("answer"), 39), "module sees its dependencies");
+    CHECK(isNumber(global("result"), 16 + 6 + 39), "entry sees linked modules");
+
+    ObjModule* math = module("lib.math");
+    CHECK(math != NULL, "lib.math registered");
+    CHECK(exports(math, "square") && exports(math, "tau"), "lib.math exports its definitions");
+    CHECK(!exports(math, "base"), "lib.math does not re-export lib.base");
+    CHECK(exports(module("lib.base"), "base"), "lib.base exports base");
+    CHECK(isString(global("label"), "diamond base"), "literal survives a collection after the build");
+}
+
+static void testCycle(void) {
+    writeModule("ping.prox", "use pong;\nlet pingValue = 1;\n");
+    writeModule("pong.prox", "use ping;\nlet pongValue = 2;\n");
+
+    char entryPath[128];
+    snprintf(entryPath, sizeof(entryPath), "%s/main.prox", root);
+
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* entry = parseSource("use ping;\nlet both = pingValue + pongValue;\n");
+
+    ModuleGraph graph;
+    initModuleGraph(&graph, entryPath);
+    CHECK(buildModuleGraph(&graph, entry), "build cyclic graph");
+    CHECK(graph.count == 2, "cycle compiled once per module");
+    CHECK(linkModuleGraph(&graph, &vm) == INTERPRET_OK, "link cyclic graph");
+    CHECK(runEntry(entry), "run cyclic entry");
+    endCompilation(&arena);
+    freeModuleGraph(&graph);
+
+    CHECK(isNumber(global("both"), 3), "both sides of the cycle ran");
+}
+
+static void testFailure(void) {
+    writeModule("broken.prox", "let text = \"unterminated;\n");
+    writeModule("fine.prox", "let fine = 1;\n");
+
+    char entryPath[128];
+    snprintf(entryPath, sizeof(entryPath), "%s/main.prox", root);
+
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* entry = parseSource("use fine;\nuse broken;\n");
+
+    ModuleGraph graph;
+    initModuleGraph(&graph, entryPath);
+    size_t nextGC = vm.nextGC;
+    CHECK(!buildModuleGraph(&graph, entry), "scan error fails the build");
+    CHECK(vm.nextGC == nextGC, "failed build restores the collection threshold");
+    CHECK(graph.count == 2, "healthy modules still compiled");
+    endCompilation(&arena);
+    freeModuleGraph(&graph);
+}
+
+static void testNativeModulesIgnored(void) {
+    char entryPath[128];
+    snprintf(entryPath, sizeof(entryPath), "%s/main.prox", root);
+
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* entry = parseSource("use std.no_such_file;\n");
+
+    ModuleGraph graph;
+    initModuleGraph(&graph, entryPath);
+    CHECK(buildModuleGraph(&graph, entry), "unresolved names are left to the importer");
+    CHECK(graph.count == 0, "no source unit for unresolved names");
+    endCompilation(&arena);
+    freeModuleGraph(&graph);
+}
+
+static bool cacheable(const char* source) {
+    int count = 0;
+    Token* tokens = scanAllTokens(source, &count);
+    bool result = entryCacheable(&vm, tokens, count);
+    free(tokens);
+    return result;
+}
+
+static void testEntryCacheable(void) {
+    /* A fresh VM has only the native modules registered */
+    freeVM(&vm);
+    initVM(&vm);
+    registerStdLib(&vm);
+    CHECK(cacheable("print(1);\n"), "no use at all");
+    CHECK(cacheable("use std.io;\nprint(1);\n"), "a native module");
+    CHECK(cacheable("use std.native.math, std/io;\n"), "several native modules, either separator");
+    CHECK(!cacheable("use lib.math;\n"), "a source module");
+    CHECK(!cacheable("use std.io, std.no_such_file;\n"), "a name that may become a file later");
+    CHECK(!cacheable("use std.ui;\nApp Demo {}\n"), "UI apps emit files while compiling");
+}
+
+typedef struct {
+    int compiled;
+    int cached;
+} BuildStats;
+
+static bool buildOnly(const char* entrySource, BuildStats* stats, bool link) {
+    char entryPath[128];
+    snprintf(entryPath, sizeof(entryPath), "%s/main.prox", root);
+
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* entry = parseSource(entrySource);
+
+    ModuleGraph graph;
+    initModuleGraph(&graph, entryPath);
+    bool ok = buildModuleGraph(&graph, entry);
+    stats->compiled = stats->cached = 0;
+    for (int i = 0; i < graph.count; i++) {
+        if (graph.units[i]->compiled) stats->compiled++;
+        if (graph.units[i]->image != NULL) stats->cached++;
+    }
+    if (ok && link) {
+        ok = linkModuleGraph(&graph, &vm) == INTERPRET_OK && runEntry(entry);
+    } else if (ok) {
+        ok = compileModuleGraph(&graph, &vm);
+    }
+    endCompilation(&arena);
+    freeModuleGraph(&graph);
+    return ok;
+}
+
+static void testIncremental(void) {
+    const char* entry = "use user;\nlet total = userValue;\n";
+    writeModule("leaf.prox", "func scale(x) { return x * 2; }\n");
+    writeModule("user.prox", "use leaf;\nlet userValue = scale(5);\n");
+
+    BuildStats stats;
+    CHECK(buildOnly(entry, &stats, false), "first build");
+    CHECK(stats.compiled == 2 && stats.cached == 0, "first build compiles everything");
+
+    CHECK(buildOnly(entry, &stats, false), "unchanged rebuild");
+    CHECK(stats.compiled == 0 && stats.cached == 2, "unchanged rebuild loads cached images");
+
+    writeModule("leaf.prox", "func scale(x) { return x * 3; }\n");
+    CHECK(buildOnly(entry, &stats, false), "body edit rebuild");
+    CHECK(stats.compiled == 1 && stats.cached == 1, "body edit recompiles only the edited module");
+
+    writeModule("leaf.prox", "func scale(x, y) { return x * y; }\nlet seven = 7;\n");
+    writeModule("user.prox", "use leaf;\nlet userValue = scale(5, seven);\n");
+    CHECK(buildOnly(entry, &stats, false), "interface edit rebuild");
+    CHECK(stats.compiled == 2, "interface edit recompiles users");
+
+    writeModule("user.prox", "use leaf;\nlet userValue = scale(5, seven) + 1;\n");
+    CHECK(buildOnly(entry, &stats, false), "user edit rebuild");
+    CHECK(stats.compiled == 1 && stats.cached == 1, "user edit leaves its dependency cached");
+
+    /* A fresh VM runs straight from the cached images */
+    freeVM(&vm);
+    initVM(&vm);
+    CHECK(buildOnly(entry, &stats, true), "run from cache");
+    CHECK(stats.compiled == 0 && stats.cached == 2, "run needs no front-end");
+    CHECK(isNumber(global("total"), 36), "cached images run correctly");
+}
+
+static void testBuilder(void) {
+    char entryPath[128];
+    snprintf(entryPath, sizeof(entryPath), "%s/app.prox", root);
+    BuildReport report;
+    /* Each pass sets up and tears down the global VM itself */
+    freeVM(&vm);
+
+    writeModule("app.prox", "use std.io;\nlet x = 1;\n");
+    CHECK(prm_compile(entryPath, false, &report), "native-only build");
+    CHECK(report.modules == 1 && report.compiled == 1, "first build compiles the entry point");
+    CHECK(prm_compile(entryPath, false, &report), "native-only rebuild");
+    CHECK(report.modules == 1 && report.compiled == 0, "cached entry point is not counted as compiled");
+
+    writeModule("app.prox", "use leaf;\nlet y = scale(2, 3);\n");
+    CHECK(prm_compile(entryPath, false, &report), "build with a source module");
+    CHECK(report.modules == 2 && report.compiled == 1, "only the entry point is compiled");
+
+    /* A failing entry point still resolves its modules for the watch list */
+    writeModule("app.prox", "use leaf;\nlet y = -\"text\";\n");
+    CHECK(!prm_compile(entryPath, false, &report), "failing build");
+    CHECK(report.watched == 0, "plain builds watch nothing");
+    CHECK(!prm_compile(entryPath, true, &report), "failing watch pass");
+    CHECK(report.watched == 2, "watch pass keeps the used module");
+    initVM(&vm);
+}
+
+int main(void) {
+    snprintf(root, sizeof(root), "/tmp/prox_modules_XXXXXX");
+    if (mkdtemp(root) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+    char lib[128];
+    snprintf(lib, sizeof(lib), "%s/lib", root);
+    mkdir(lib, 0755);
+    char cache[128];
+    snprintf(cache, sizeof(cache), "%s/cache", root);
+    setenv("PROXPL_CACHE_DIR", cache, 1);
+
+    initVM(&vm);
+    testDiamond();
+    testCycle();
+    testFailure();
+    testNativeModulesIgnored();
+    testIncremental();
+    testEntryCacheable();
+    testBuilder();
+    freeVM(&vm);
+
+    char command[256];
+    snprintf(command, sizeof(command), "rm -rf %s", root);
+    if (system(command) != 0) fprintf(stderr, "could not remove %s\n", root);
+
+    if (failures == 0) printf("All module graph tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
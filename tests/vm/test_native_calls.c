@@ -0,0 +1,131 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_native_calls.c
+ * Verifies re-entrant calls from native code: vmCallValue on closures,
+ * natives and classes from C; std.collections map/filter/reduce/sort/
+ * group_by running script callbacks, including nested and allocating ones;
+ * and that an error inside a callback unwinds the nested frames and is
+ * reported at the native's call site.
+ */
+
+#include "test_support.h"
+#include "gc.h"
+
+static Value nativeTwice(int argCount, Value* args) {
+    if (argCount < 1 || !IS_NUMBER(args[0])) return NIL_VAL;
+    return NUMBER_VAL(AS_NUMBER(args[0]) * 2);
+}
+
+static void testFromC(void) {
+    CHECK(execute("func add(a, b) { return a + b; }\n"
+                  "let base = 100;\n"
+                  "func withBase(x) { return x + base; }\n"
+                  "class Point { func init(x) { this.x = x; } }\n"
+                  "func fails(x) { return x + nowhere; }\n") == INTERPRET_OK, "define callees");
+
+    Value result = NIL_VAL;
+    Value args[2] = { NUMBER_VAL(2), NUMBER_VAL(40) };
+    Value* top = vm.stackTop;
+    CHECK(vmCallValue(&vm, global("add"), 2, args, &result) && isNumber(result, 42), "call a closure");
+    CHECK(vmCallValue(&vm, global("withBase"), 1, args, &result) && isNumber(result, 102), "closure reads globals");
+    CHECK(vmCallValue(&vm, OBJ_VAL(newNative(nativeTwice)), 1, args, &result) && isNumber(result, 4), "call a native");
+    CHECK(vmCallValue(&vm, global("Point"), 1, args, &result) && IS_INSTANCE(result), "call a class");
+    CHECK(vm.stackTop == top && vm.frameCount == 0, "stack balanced after calls");
+
+    CHECK(!vmCallValue(&vm, global("fails"), 1, args, &result), "failing callee");
+    CHECK(vm.nativeErrorPending && strstr(vm.nativeError, "nowhere") != NULL, "error held for the caller");
+    CHECK(!vmCallValue(&vm, global("add"), 1, args, &result), "arity mismatch");
+    CHECK(vm.stackTop == top && vm.frameCount == 0 && vm.frameBase == 0, "state restored after errors");
+    vm.nativeErrorPending = false;
+}
+
+static void testCollections(void) {
+    CHECK(execute("use std.collections;\n"
+                  "let words = [\"pear\", \"fig\", \"apple\", \"kiwi\", \"banana\"];\n"
+                  "let lengths = std.collections.map(words, func(w) { return len(w); });\n"
+                  "let scale = 10;\n"
+                  "let scaled = std.collections.map([1, 2, 3], func(x) { return x * scale; });\n"
+                  "let short = std.collections.filter(words, func(w) { return len(w) < 5; });\n"
+                  "let total = std.collections.reduce([1, 2, 3, 4], func(a, b) { return a + b; });\n"
+                  "let joined = std.collections.reduce(words, func(a, w) { return a + w; }, \">\");\n"
+                  "let sorted = std.collections.sort(words);\n"
+                  "let byLength = std.collections.sort(words, func(a, b) { return len(a) - len(b); });\n"
+                  "let descending = std.collections.sort([5, 3, 9, 1, 7], func(a, b) { return b < a; });\n"
+                  "let groups = std.collections.group_by(words, func(w) { return len(w); });\n"
+                  "let anyLong = std.collections.any(words, func(w) { return len(w) > 5; });\n"
+                  "let allShort = std.collections.all(words, func(w) { return len(w) < 6; });\n"
+                  "let nested = std.collections.map([1, 2], func(x) {\n"
+                  "    return std.collections.reduce(std.collections.map([1, 2, 3], func(y) { return x * y; }),\n"
+                  "                                  func(a, b) { return a + b; });\n"
+                  "});\n"
+                  "let strings = std.collections.map(words, func(w) { return w + w + w; });\n"
+                  "let viaNative = std.collections.map(words, len);\n") == INTERPRET_OK, "run collections source");
+
+    const double lengths[] = {4, 3, 5, 4, 6};
+    const double scaled[] = {10, 20, 30};
+    const double descending[] = {9, 7, 5, 3, 1};
+    const double nested[] = {6, 12};
+    CHECK(isNumberList(global("lengths"), lengths, 5), "map over strings");
+    CHECK(isNumberList(global("scaled"), scaled, 3), "map over a number literal with a global");
+    CHECK(isNumberList(global("descending"), descending, 5), "sort with a boolean comparator");
+    CHECK(isNumberList(global("nested"), nested, 2), "callbacks that call natives that call back");
+    CHECK(isNumberList(global("viaNative"), lengths, 5), "map with a native");
+
+    Value shortWords = global("short");
+    CHECK(IS_LIST(shortWords) && AS_LIST(shortWords)->count == 3 &&
+          isString(AS_LIST(shortWords)->items[2], "kiwi"), "filter");
+    CHECK(isNumber(global("total"), 10), "reduce without an initial value");
+    CHECK(isString(global("joined"), ">pearfigapplekiwibanana"), "reduce with an initial value");
+
+    Value sorted = global("sorted");
+    CHECK(IS_LIST(sorted) && AS_LIST(sorted)->count == 5 &&
+          isString(AS_LIST(sorted)->items[0], "apple") &&
+          isString(AS_LIST(sorted)->items[4], "pear"), "default string sort");
+    Value byLength = global("byLength");
+    CHECK(IS_LIST(byLength) && isString(AS_LIST(byLength)->items[0], "fig") &&
+          isString(AS_LIST(byLength)->items[1], "pear") &&
+          isString(AS_LIST(byLength)->items[2], "kiwi"), "comparator sort is stable");
+
+    Value groups = global("groups");
+    Value four = NIL_VAL;
+    CHECK(IS_DICTIONARY(groups) &&
+          tableGet(&AS_DICTIONARY(groups)->items, copyString("4", 1), &four) &&
+          IS_LIST(four) && AS_LIST(four)->count == 2, "group_by number keys");
+    CHECK(IS_BOOL(global("anyLong")) && AS_BOOL(global("anyLong")), "any");
+    CHECK(IS_BOOL(global("allShort")) && !AS_BOOL(global("allShort")), "all");
+    Value strings = global("strings");
+    CHECK(IS_LIST(strings) && isString(AS_LIST(strings)->items[1], "figfigfig"), "allocating callback");
+}
+
+static void testErrors(void) {
+    fprintf(stderr, "(expected runtime error follows)\n");
+    CHECK(execute("use std.collections;\n"
+                  "let reached = false;\n"
+                  "std.collections.map([\"a\", \"b\"], func(x) { return x + undefinedName; });\n"
+                  "reached = true;\n") == INTERPRET_RUNTIME_ERROR, "callback error fails the script");
+    CHECK(IS_BOOL(global("reached")) && !AS_BOOL(global("reached")), "script stops at the native call");
+    CHECK(!vm.nativeErrorPending && vm.frameCount == 0 && vm.frameBase == 0 &&
+          vm.nativeCallDepth == 0, "VM state after a callback error");
+
+    CHECK(execute("use std.collections;\n"
+                  "let recovered = std.collections.map([1, 2], func(x) { return x + 1; });\n") == INTERPRET_OK,
+          "VM usable after a callback error");
+    const double recovered[] = {2, 3};
+    CHECK(isNumberList(global("recovered"), recovered, 2), "result after recovery");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testFromC();
+    testCollections();
+    testErrors();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All native call tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_parallel.c
+ * Verifies parallel loops on the work-stealing scheduler: every item runs
+ * exactly once in grain-aligned chunks, nested loops, the parallel radix
+ * and merge sorts against the serial ones, and std.collections par_map/
+ * par_filter/par_reduce/par_sum/par_sort and '@' giving the same results
+ * as the serial paths, with parallel-safe natives and script callbacks.
+ */
+
+#include "test_support.h"
+#include "scheduler.h"
+#include "sort.h"
+
+#define LOOP_COUNT 1000003
+#define LOOP_GRAIN 1000
+
+static unsigned char visits[LOOP_COUNT];
+static int misaligned = 0;
+static int nestedTotal = 0;
+
+static void countVisits(size_t begin, size_t end, void* context) {
+    (void)context;
+    if (begin % LOOP_GRAIN != 0 || (end - begin != LOOP_GRAIN && end != LOOP_COUNT)) misaligned = 1;
+    for (size_t i = begin; i < end; i++) visits[i]++;
+}
+
+static void innerLoop(size_t begin, size_t end, void* context) {
+    int* sum = (int*)context;
+    for (size_t i = begin; i < end; i++) *sum += 1;
+}
+
+static void outerLoop(size_t begin, size_t end, void* context) {
+    (void)context;
+    for (size_t i = begin; i < end; i++) {
+        int sum = 0;
+        scheduler_parallel_for(100, 10, innerLoop, &sum);
+        if (sum == 100) __atomic_fetch_add(&nestedTotal, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static bool keyLess(const SortItem* a, const SortItem* b, void* context) {
+    (void)context;
+    if (a->key != b->key) return a->key < b->key;
+    return a->index < b->index;
+}
+
+static void testLoops(void) {
+    scheduler_parallel_for(LOOP_COUNT, LOOP_GRAIN, countVisits, NULL);
+    bool once = true;
+    for (size_t i = 0; i < LOOP_COUNT; i++) once = once && visits[i] == 1;
+    CHECK(once, "every item runs exactly once");
+    CHECK(!misaligned, "chunks follow the grain");
+
+    scheduler_parallel_for(64, 1, outerLoop, NULL);
+    CHECK(nestedTotal == 64, "nested loops run on the calling thread");
+    CHECK(scheduler_grain(100, 2048) == 2048 && scheduler_grain(10000000, 1) == 39063,
+          "grain depends only on the item count");
+}
+
+static void testSorts(void) {
+    const size_t n = 1000000;
+    uint64_t* serial = (uint64_t*)malloc(sizeof(uint64_t) * n);
+    uint64_t* parallel = (uint64_t*)malloc(sizeof(uint64_t) * n);
+    uint64_t* scratch = (uint64_t*)malloc(sizeof(uint64_t) * n);
+    uint32_t seed = 99;
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        double d = ((double)(seed >> 4) - 134217728.0) / 3.0;
+        serial[i] = parallel[i] = sortNumberKey(d);
+    }
+    sortRadix(serial, NULL, scratch, NULL, n);
+    sortRadixParallel(parallel, scratch, n);
+    CHECK(memcmp(serial, parallel, sizeof(uint64_t) * n) == 0, "parallel radix sort matches");
+
+    SortItem* items = (SortItem*)malloc(sizeof(SortItem) * n);
+    SortItem* itemScratch = (SortItem*)malloc(sizeof(SortItem) * n);
+    for (size_t i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        items[i].key = seed % 5000;
+        items[i].value = NIL_VAL;
+        items[i].index = (uint32_t)i;
+    }
+    sortParallel(items, itemScratch, n, keyLess, NULL);
+    bool ordered = true;
+    for (size_t i = 1; i < n; i++) ordered = ordered && keyLess(&items[i - 1], &items[i], NULL);
+    CHECK(ordered, "parallel chunk sort and merge");
+
+    free(serial);
+    free(parallel);
+    free(scratch);
+    free(items);
+    free(itemScratch);
+}
+
+// Numbers compare by bits and strings are interned
+static bool sameValues(Value a, Value b) {
+    if (!IS_LIST(a) || !IS_LIST(b) || AS_LIST(a)->count != AS_LIST(b)->count) return false;
+    for (int i = 0; i < AS_LIST(a)->count; i++) {
+        if (AS_LIST(a)->items[i] != AS_LIST(b)->items[i]) return false;
+    }
+    return true;
+}
+
+static Value nativeIsEven(int argCount, Value* args) {
+    if (argCount < 1 || !IS_NUMBER(args[0])) return BOOL_VAL(false);
+    return BOOL_VAL(((long long)AS_NUMBER(args[0])) % 2 == 0);
+}
+
+static Value nativeAdd(int argCount, Value* args) {
+    if (argCount < 2 || !IS_NUMBER(args[0]) || !IS_NUMBER(args[1])) return NIL_VAL;
+    return NUMBER_VAL(AS_NUMBER(args[0]) + AS_NUMBER(args[1]));
+}
+
+static void testCollections(void) {
+    defineNative(&vm, "isEven", nativeIsEven);
+    defineNative(&vm, "add", nativeAdd);
+    scheduler_mark_parallel_safe(nativeIsEven);
+    scheduler_mark_parallel_safe(nativeAdd);
+
+    run("use std.collections;\n"
+        "let xs = [];\n"
+        "let words = [];\n"
+        "let seed = 11;\n"
+        "let k = 0;\n"
+        "while (k < 100000) {\n"
+        "    seed = (seed * 75 + 74) % 65537;\n"
+        "    list_push(xs, seed - 32768);\n"
+        "    if (k < 30000) { list_push(words, \"w\" + to_string(seed)); }\n"
+        "    k = k + 1;\n"
+        "}\n"
+        "let mapped = std.collections.par_map(xs, abs);\n"
+        "let mappedSerial = std.collections.map(xs, abs);\n"
+        "let closureMapped = std.collections.par_map(xs, func(x) { return x * 2; });\n"
+        "let closureSerial = std.collections.map(xs, func(x) { return x * 2; });\n"
+        "let evens = std.collections.par_filter(xs, isEven);\n"
+        "let evensSerial = std.collections.filter(xs, isEven);\n"
+        "let total = std.collections.par_reduce(xs, add);\n"
+        "let totalFrom = std.collections.par_reduce(xs, add, 1000000);\n"
+        "let biggest = std.collections.par_reduce(xs, max);\n"
+        "let summed = std.collections.par_sum(xs);\n"
+        "let tensorSum = std.collections.par_sum([1.5, 2.5, 3]);\n"
+        "let sorted = std.collections.par_sort(xs);\n"
+        "let sortedSerial = std.collections.sort(xs);\n"
+        "let sortedWords = std.collections.par_sort(words);\n"
+        "let sortedWordsSerial = std.collections.sort(words);\n"
+        "let emptySum = std.collections.par_sum([]);\n");
+
+    CHECK(sameValues(global("mapped"), global("mappedSerial")), "par_map with a parallel-safe native");
+    CHECK(sameValues(global("closureMapped"), global("closureSerial")), "par_map with a closure");
+    CHECK(sameValues(global("evens"), global("evensSerial")), "par_filter keeps the order");
+    CHECK(sameValues(global("sorted"), global("sortedSerial")), "par_sort numbers");
+    CHECK(sameValues(global("sortedWords"), global("sortedWordsSerial")), "par_sort strings");
+
+    Value xs = global("xs");
+    double expected = 0;
+    double largest = -1e300;
+    for (int i = 0; i < AS_LIST(xs)->count; i++) {
+        double x = AS_NUMBER(AS_LIST(xs)->items[i]);
+        expected += x;
+        if (x > largest) largest = x;
+    }
+    CHECK(isNumber(global("total"), expected), "par_reduce");
+    CHECK(isNumber(global("totalFrom"), expected + 1000000), "par_reduce with an initial value");
+    CHECK(isNumber(global("biggest"), largest), "par_reduce with max");
+    CHECK(isNumber(global("summed"), expected), "par_sum");
+    CHECK(isNumber(global("tensorSum"), 7), "par_sum over a number literal");
+    CHECK(isNumber(global("emptySum"), 0), "par_sum of nothing");
+}
+
+static void testMatmul(void) {
+    int dims[2] = { 300, 300 };
+    ObjTensor* a = newTensor(2, dims, NULL);
+    push(&vm, OBJ_VAL(a));
+    ObjTensor* b = newTensor(2, dims, NULL);
+    push(&vm, OBJ_VAL(b));
+    for (int i = 0; i < 300 * 300; i++) {
+        a->data[i] = (double)(i % 7);
+        b->data[i] = (i / 300 == i % 300) ? 2.0 : 0.0; // 2 * identity
+    }
+    tableSet(&vm.globals, copyString("ma", 2), OBJ_VAL(a));
+    tableSet(&vm.globals, copyString("mb", 2), OBJ_VAL(b));
+    pop(&vm);
+    pop(&vm);
+
+    run("let product = ma @ mb;\n");
+    Value product = global("product");
+    bool same = IS_TENSOR(product) && AS_TENSOR(product)->size == 300 * 300;
+    for (int i = 0; same && i < 300 * 300; i++) same = AS_TENSOR(product)->data[i] == 2.0 * (i % 7);
+    CHECK(same, "matrix product split across workers");
+}
+
+int main(void) {
+#ifndef _WIN32
+    setenv("PROXPL_THREADS", "4", 0);
+#endif
+    testLoops();
+    testSorts();
+    initVM(&vm);
+    registerStdLib(&vm);
+    testCollections();
+    testMatmul();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All parallel tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
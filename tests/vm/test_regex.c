@@ -0,0 +1,233 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_regex.c
+ * Verifies the regex engine: leftmost-first matches and capture groups
+ * agree with backtracking engines, the DFA and the Pike VM agree on
+ * whether there is a match (including when the DFA cache overflows),
+ * literal prefilters find matches at every alignment, and bad patterns are
+ * rejected. The std.regex natives are checked end to end from a script.
+ */
+
+#include "test_support.h"
+#include "regex_engine.h"
+
+typedef struct {
+    const char* pattern;
+    int flags;
+    const char* text;
+    int start, end;        // -1 when there is no match
+    const char* group1;    // NULL when group 1 does not take part
+    const char* group2;
+} MatchCase;
+
+static const MatchCase cases[] = {
+    { "abc", 0, "xxabcxx", 2, 5, NULL, NULL },
+    { "a+b", 0, "caaab", 1, 5, NULL, NULL },
+    { "a*?b", 0, "aab", 0, 3, NULL, NULL },
+    { "(a|ab)(c|bcd)(d*)", 0, "abcd", 0, 4, "a", "bcd" },
+    { "^abc$", 0, "abc", 0, 3, NULL, NULL },
+    { "^abc$", 0, "xabc", -1, -1, NULL, NULL },
+    { "^b", REGEX_MULTILINE, "a\nb", 2, 3, NULL, NULL },
+    { "ab$", REGEX_MULTILINE, "ab\ncd", 0, 2, NULL, NULL },
+    { "a.c", 0, "a\nc", -1, -1, NULL, NULL },
+    { "a.c", REGEX_DOTALL, "a\nc", 0, 3, NULL, NULL },
+    { "\\bfoo\\b", 0, "a foo b", 2, 5, NULL, NULL },
+    { "\\bfoo\\b", 0, "afoo", -1, -1, NULL, NULL },
+    { "\\Bo\\B", 0, "foo", 1, 2, NULL, NULL },
+    { "[a-c]+", 0, "xxbcaz", 2, 5, NULL, NULL },
+    { "[^0-9]+", 0, "12ab3", 2, 4, NULL, NULL },
+    { "[\\]a]+", 0, "x]a]", 1, 4, NULL, NULL },
+    { "\\d{3}-\\d{4}", 0, "call 555-1234 now", 5, 13, NULL, NULL },
+    { "x{2,3}", 0, "xxxx", 0, 3, NULL, NULL },
+    { "x{2,3}?", 0, "xxxx", 0, 2, NULL, NULL },
+    { "x{2,}", 0, "axxxxb", 1, 5, NULL, NULL },
+    { "x{3}", 0, "xxaxxx", 3, 6, NULL, NULL },
+    { "HeLLo", REGEX_ICASE, "say hello", 4, 9, NULL, NULL },
+    { "[^a]", REGEX_ICASE, "aAb", 2, 3, NULL, NULL },
+    { "colou?r", 0, "color", 0, 5, NULL, NULL },
+    { "(\\w+)@(\\w+)\\.com", 0, "mail bob@example.com", 5, 20, "bob", "example" },
+    { "(\\d+)-(\\d+)", 0, "x 10-20", 2, 7, "10", "20" },
+    { "", 0, "abc", 0, 0, NULL, NULL },
+    { "a|", 0, "b", 0, 0, NULL, NULL },
+    { "(a)|b", 0, "b", 0, 1, NULL, NULL },
+    { "\\x41", 0, "zA", 1, 2, NULL, NULL },
+    { "a\\.b", 0, "axb a.b", 4, 7, NULL, NULL },
+    { "(?:ab)+", 0, "ababab", 0, 6, NULL, NULL },
+    { "(?:a*)*b", 0, "aaab", 0, 4, NULL, NULL },
+    { "(a+)+$", 0, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaab", -1, -1, NULL, NULL },
+    { "\\s+", 0, "a \t b", 1, 4, NULL, NULL },
+    { "cat|dog|bird", 0, "hotdog", 3, 6, NULL, NULL },
+    { "(x)(y)?", 0, "x", 0, 1, "x", NULL },
+};
+
+static bool groupIs(const char* text, const int* captures, int group, const char* expected) {
+    int from = captures[group * 2];
+    if (expected == NULL) return from < 0;
+    int length = captures[group * 2 + 1] - from;
+    return from >= 0 && length == (int)strlen(expected) && memcmp(text + from, expected, length) == 0;
+}
+
+static void testMatches(void) {
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const MatchCase* c = &cases[i];
+        const char* error;
+        Regex* regex = regexCompile(c->pattern, (int)strlen(c->pattern), c->flags, &error);
+        if (regex == NULL) {
+            fprintf(stderr, "FAIL: /%s/ did not compile: %s\n", c->pattern, error);
+            failures++;
+            continue;
+        }
+        int captures[20];
+        int length = (int)strlen(c->text);
+        bool found = regexSearch(regex, c->text, length, 0, captures);
+        bool ok = found == (c->start >= 0);
+        if (ok && found) {
+            ok = captures[0] == c->start && captures[1] == c->end;
+            if (regexGroupCount(regex) >= 1) ok = ok && groupIs(c->text, captures, 1, c->group1);
+            if (regexGroupCount(regex) >= 2) ok = ok && groupIs(c->text, captures, 2, c->group2);
+        }
+        if (!ok) {
+            fprintf(stderr, "FAIL: /%s/ on \"%s\": got %d (%d, %d)\n", c->pattern, c->text, found,
+                    found ? captures[0] : -1, found ? captures[1] : -1);
+            failures++;
+        }
+        if (regexTest(regex, c->text, length, 0) != found) {
+            fprintf(stderr, "FAIL: /%s/ on \"%s\": DFA disagrees\n", c->pattern, c->text);
+            failures++;
+        }
+        regexFree(regex);
+    }
+}
+
+static void testErrors(void) {
+    const char* bad[] = {
+        "(", ")", "a)", "[a", "a**", "*a", "+", "\\", "a{3,1}", "(?=a)", "(?<n>a)", "(a)\\1", "[z-a]",
+        "a{1001}", "\\q", "((a{100}){100}){100}",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        const char* error = NULL;
+        Regex* regex = regexCompile(bad[i], (int)strlen(bad[i]), 0, &error);
+        if (regex != NULL || error == NULL) {
+            fprintf(stderr, "FAIL: accepted bad pattern /%s/\n", bad[i]);
+            failures++;
+            regexFree(regex);
+        }
+    }
+}
+
+// Matches iff the 11th byte from the end is 'a'; a DFA for this needs more
+// states than the cache holds, so it flushes and falls back to the Pike VM
+static void testDfaOverflow(void) {
+    const char* pattern = "(a|b)*a(a|b){10}$";
+    const char* error;
+    Regex* regex = regexCompile(pattern, (int)strlen(pattern), 0, &error);
+    CHECK(regex != NULL, "compile overflow pattern");
+    if (regex == NULL) return;
+
+    int length = 20000;
+    char* text = (char*)malloc(length);
+    uint32_t seed = 12345;
+    for (int i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        text[i] = (seed >> 16) & 1 ? 'a' : 'b';
+    }
+    int captures[6];
+    for (int round = 0; round < 2; round++) {
+        text[length - 11] = round == 0 ? 'b' : 'a';
+        bool expected = round == 1;
+        CHECK(regexTest(regex, text, length, 0) == expected, "DFA under cache pressure");
+        CHECK(regexSearch(regex, text, length, 0, captures) == expected, "search under cache pressure");
+        if (expected) CHECK(captures[1] == length, "match runs to the end");
+    }
+    free(text);
+    regexFree(regex);
+}
+
+static void testPrefilters(void) {
+    const char* patterns[] = { "needle", "NeEdLe", "n[e]edle\\d*", "(?:needle|nexxx)" };
+    int flags[] = { 0, REGEX_ICASE, 0, 0 };
+    char text[200];
+    for (int p = 0; p < 4; p++) {
+        const char* error;
+        Regex* regex = regexCompile(patterns[p], (int)strlen(patterns[p]), flags[p], &error);
+        if (regex == NULL) {
+            CHECK(false, "compile prefilter pattern");
+            continue;
+        }
+        for (int at = 0; at < 150; at++) {
+            memset(text, 'x', sizeof(text));
+            memcpy(text + at, "needle", 6);
+            text[at / 2] = 'n'; // A decoy first byte before the match
+            int captures[4];
+            int length = at + 6 + (at % 7);
+            if (!regexSearch(regex, text, length, 0, captures) || captures[0] != at || captures[1] != at + 6) {
+                fprintf(stderr, "FAIL: /%s/ at offset %d\n", patterns[p], at);
+                failures++;
+                break;
+            }
+            if (regexTest(regex, text, at + 5, 0)) {
+                fprintf(stderr, "FAIL: /%s/ matched a truncated needle at %d\n", patterns[p], at);
+                failures++;
+                break;
+            }
+        }
+        regexFree(regex);
+    }
+}
+
+static void testNatives(void) {
+    const char* source =
+        "use std.regex;\n"
+        "let ok = std.regex.test(\"^[a-z]+@[a-z]+\\.com$\", \"bob@example.com\");\n"
+        "let caseless = std.regex.test(\"^BOB\", \"bob\", \"i\");\n"
+        "let groups = std.regex.match(\"(\\w+)=(\\w+)\", \"key=value\");\n"
+        "let second = groups[2];\n"
+        "let missing = std.regex.match(\"z+\", \"abc\");\n"
+        "let at = std.regex.search(\"\\d\", \"ab3\");\n"
+        "let swapped = std.regex.replaceAll(\"(\\w+)=(\\w+)\", \"a=1, b=2\", \"$2=$1\");\n"
+        "let once = std.regex.replace(\"o\", \"foo\", \"0\");\n"
+        "let parts = std.regex.split(\"\\s*,\\s*\", \"x , y,z\");\n"
+        "let middle = parts[1];\n"
+        "let partCount = len(parts);\n"
+        "let found = std.regex.findAll(\"\\d+\", \"a1b22c333\");\n"
+        "let last = found[2];\n"
+        "let bad = std.regex.test(\"(\", \"x\");\n"
+        "let valid = std.regex.isValid(\"a{2}\");\n";
+    CHECK(execute(source) == INTERPRET_OK, "run regex source");
+
+    Value value = global("ok");
+    CHECK(IS_BOOL(value) && AS_BOOL(value), "test from a script");
+    value = global("caseless");
+    CHECK(IS_BOOL(value) && AS_BOOL(value), "flags from a script");
+    CHECK(isString(global("second"), "value"), "match groups");
+    CHECK(IS_NIL(global("missing")), "match without a match");
+    value = global("at");
+    CHECK(IS_NUMBER(value) && AS_NUMBER(value) == 2, "search index");
+    CHECK(isString(global("swapped"), "1=a, 2=b"), "replaceAll with groups");
+    CHECK(isString(global("once"), "f0o"), "replace first only");
+    CHECK(isString(global("middle"), "y"), "split on a pattern");
+    value = global("partCount");
+    CHECK(IS_NUMBER(value) && AS_NUMBER(value) == 3, "split piece count");
+    CHECK(isString(global("last"), "333"), "findAll");
+    CHECK(IS_NIL(global("bad")), "invalid pattern yields nil");
+    value = global("valid");
+    CHECK(IS_BOOL(value) && AS_BOOL(value), "isValid");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testMatches();
+    testErrors();
+    testDfaOverflow();
+    testPrefilters();
+    testNatives();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All regex tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
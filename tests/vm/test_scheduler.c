@@ -0,0 +1,48 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_scheduler.c
+ * Drives the coroutine scheduler through the runtime entry points compiled
+ * code calls. Running with an empty deque must leave it usable: a task
+ * queued afterwards still runs, and so do tasks queued after that.
+ */
+
+#include "test_support.h"
+
+// Runtime ABI for compiled code; there is no header for it
+void scheduler_init(int worker_id);
+void scheduler_run(void);
+Value prox_rt_new_task(void* hdl, ResumeFn resume);
+
+static void countResume(void* handle) {
+    (*(int*)handle)++;
+}
+
+static void testEmptyDeque(void) {
+    int resumed = 0;
+    scheduler_init(0);
+
+    scheduler_run();
+    prox_rt_new_task(&resumed, countResume);
+    scheduler_run();
+    CHECK(resumed == 1, "task queued after an empty run is resumed");
+
+    scheduler_run();
+    scheduler_run();
+    prox_rt_new_task(&resumed, countResume);
+    prox_rt_new_task(&resumed, countResume);
+    scheduler_run();
+    CHECK(resumed == 3, "deque stays usable after repeated empty runs");
+}
+
+int main(void) {
+    initVM(&vm);
+    testEmptyDeque();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All scheduler tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
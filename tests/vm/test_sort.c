@@ -0,0 +1,219 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_sort.c
+ * Verifies the sort core (radix sort of doubles, pdqsort, the stable run
+ * merge) on adversarial patterns and with an inconsistent comparison, and
+ * std.collections sort/sort_by: native number and string paths, stable and
+ * unstable comparator sorts, decorated keys and rejected mixed lists.
+ */
+
+#include "test_support.h"
+#include "sort.h"
+
+static uint32_t rngState = 12345;
+
+static uint32_t nextRandom(void) {
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+static bool keyLess(const SortItem* a, const SortItem* b, void* context) {
+    (void)context;
+    return a->key < b->key;
+}
+
+static bool coinLess(const SortItem* a, const SortItem* b, void* context) {
+    (void)a;
+    (void)b;
+    (void)context;
+    return nextRandom() & 1;
+}
+
+enum { RANDOM, SORTED, REVERSED, FEW, ORGAN, EQUAL, PATTERNS };
+
+static void fill(SortItem* items, size_t n, int pattern) {
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key;
+        switch (pattern) {
+            case RANDOM:   key = nextRandom(); break;
+            case SORTED:   key = i; break;
+            case REVERSED: key = n - i; break;
+            case FEW:      key = nextRandom() % 4; break;
+            case ORGAN:    key = i < n / 2 ? i : n - i; break;
+            default:       key = 7; break;
+        }
+        items[i].key = key;
+        items[i].value = NIL_VAL;
+        items[i].index = (uint32_t)i;
+    }
+}
+
+static bool ordered(const SortItem* items, size_t n, bool stable) {
+    for (size_t i = 1; i < n; i++) {
+        if (items[i].key < items[i - 1].key) return false;
+        if (stable && items[i].key == items[i - 1].key && items[i].index < items[i - 1].index) return false;
+    }
+    return true;
+}
+
+// Every original position appears exactly once
+static bool permutation(const SortItem* items, size_t n) {
+    char* seen = (char*)calloc(n + 1, 1);
+    bool ok = true;
+    for (size_t i = 0; i < n && ok; i++) {
+        if (items[i].index >= n || seen[items[i].index]) ok = false;
+        else seen[items[i].index] = 1;
+    }
+    free(seen);
+    return ok;
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void testCore(void) {
+    const size_t sizes[] = {0, 1, 2, 5, 23, 24, 25, 100, 129, 1000, 50000};
+    SortItem* items = (SortItem*)malloc(sizeof(SortItem) * 50000);
+    SortItem* scratch = (SortItem*)malloc(sizeof(SortItem) * 25001);
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        for (int pattern = 0; pattern < PATTERNS; pattern++) {
+            fill(items, n, pattern);
+            sortPdq(items, n, keyLess, NULL);
+            CHECK(ordered(items, n, false) && permutation(items, n), "pdqsort orders every pattern");
+            fill(items, n, pattern);
+            sortTim(items, scratch, n, keyLess, NULL);
+            CHECK(ordered(items, n, true) && permutation(items, n), "run merge is stable on every pattern");
+        }
+    }
+
+    // A comparison that answers at random may misorder but must not lose items
+    fill(items, 10000, RANDOM);
+    sortPdq(items, 10000, coinLess, NULL);
+    CHECK(permutation(items, 10000), "pdqsort with an inconsistent comparison");
+    fill(items, 10000, RANDOM);
+    sortTim(items, scratch, 10000, coinLess, NULL);
+    CHECK(permutation(items, 10000), "run merge with an inconsistent comparison");
+    free(items);
+    free(scratch);
+
+    const size_t n = 100000;
+    double* expected = (double*)malloc(sizeof(double) * n);
+    uint64_t* keys = (uint64_t*)malloc(sizeof(uint64_t) * n);
+    uint64_t* keyScratch = (uint64_t*)malloc(sizeof(uint64_t) * n);
+    uint32_t* indices = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    uint32_t* indexScratch = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    for (size_t i = 0; i < n; i++) {
+        double d = ((double)nextRandom() - 8388608.0) / 1024.0;
+        if (i % 1000 == 0) d = (i % 3000 == 0) ? 1.0 / 0.0 : -1.0 / 0.0;
+        if (i % 777 == 0) d = -0.0;
+        expected[i] = d;
+        keys[i] = sortNumberKey(d);
+        indices[i] = (uint32_t)i;
+    }
+    sortRadix(keys, indices, keyScratch, indexScratch, n);
+    qsort(expected, n, sizeof(double), compareDoubles);
+    bool same = true;
+    for (size_t i = 0; i < n && same; i++) {
+        same = sortNumberFromKey(keys[i]) == expected[i] && sortNumberKey(expected[i]) != 0;
+    }
+    CHECK(same, "radix sort matches qsort on doubles");
+    CHECK(sortNumberKey(-0.0) < sortNumberKey(0.0) && sortNumberKey(-2.5) < sortNumberKey(-1.0),
+          "number keys keep signed order");
+
+    // Small integers share their high digits, so most passes are skipped
+    for (size_t i = 0; i < n; i++) keys[i] = sortNumberKey((double)(n - i));
+    sortRadix(keys, NULL, keyScratch, NULL, n);
+    CHECK(sortNumberFromKey(keys[0]) == 1 && sortNumberFromKey(keys[n - 1]) == (double)n,
+          "radix sort without indices");
+    free(expected);
+    free(keys);
+    free(keyScratch);
+    free(indices);
+    free(indexScratch);
+}
+
+static bool isStrings(Value value, const char* const* expected, int count) {
+    if (!IS_LIST(value) || AS_LIST(value)->count != count) return false;
+    for (int i = 0; i < count; i++) {
+        if (!isString(AS_LIST(value)->items[i], expected[i])) return false;
+    }
+    return true;
+}
+
+static void testNative(void) {
+    run("use std.collections;\n"
+        "let numbers = std.collections.sort([3, -1.5, 10, 0, -20, 2.25, 3]);\n"
+        "let big = [];\n"
+        "let seed = 7;\n"
+        "let k = 0;\n"
+        "while (k < 20000) {\n"
+        "    seed = (seed * 75 + 74) % 65537;\n"
+        "    list_push(big, seed - 30000);\n"
+        "    k = k + 1;\n"
+        "}\n"
+        "let bigSorted = std.collections.sort(big);\n"
+        "let words = std.collections.sort([\"prefix_beta\", \"b\", \"prefix_alpha\", \"\", \"prefix_\", \"a\"]);\n"
+        "let mixed = std.collections.sort([1, \"a\"]);\n"
+        "let empty = std.collections.sort([]);\n"
+        "\n"
+        "let calls = 0;\n"
+        "let ascending = std.collections.sort(bigSorted, func(a, b) { calls = calls + 1; return a - b; });\n"
+        "let unstable = std.collections.sort(big, func(a, b) { return b - a; }, false);\n"
+        "\n"
+        "let people = [[\"ann\", 31], [\"bob\", 25], [\"cy\", 31], [\"dee\", 25], [\"eve\", 40]];\n"
+        "let keyCalls = 0;\n"
+        "let byAge = std.collections.sort_by(people, func(p) { keyCalls = keyCalls + 1; return p[1]; });\n"
+        "let ages = std.collections.map(byAge, func(p) { return p[0]; });\n"
+        "let byName = std.collections.map(std.collections.sort_by(people, func(p) { return p[0]; }),\n"
+        "                                 func(p) { return p[1]; });\n"
+        "let badKeys = std.collections.sort_by(people, func(p) { return p; });\n");
+
+    const double numbers[] = {-20, -1.5, 0, 2.25, 3, 3, 10};
+    CHECK(isNumberList(global("numbers"), numbers, 7), "number literal sorted natively");
+
+    Value big = global("bigSorted");
+    bool sorted = IS_LIST(big) && AS_LIST(big)->count == 20000;
+    for (int i = 1; sorted && i < 20000; i++) {
+        sorted = AS_NUMBER(AS_LIST(big)->items[i - 1]) <= AS_NUMBER(AS_LIST(big)->items[i]);
+    }
+    CHECK(sorted, "large number list");
+    Value unstable = global("unstable");
+    sorted = IS_LIST(unstable) && AS_LIST(unstable)->count == 20000;
+    for (int i = 1; sorted && i < 20000; i++) {
+        sorted = AS_NUMBER(AS_LIST(unstable)->items[i - 1]) >= AS_NUMBER(AS_LIST(unstable)->items[i]);
+    }
+    CHECK(sorted, "unstable comparator sort");
+    CHECK(isNumber(global("calls"), 19999), "stable comparator sort is linear on sorted input");
+
+    const char* words[] = {"", "a", "b", "prefix_", "prefix_alpha", "prefix_beta"};
+    CHECK(isStrings(global("words"), words, 6), "strings with shared prefixes");
+    CHECK(IS_NIL(global("mixed")), "mixed list has no default order");
+    CHECK(IS_LIST(global("empty")) && AS_LIST(global("empty"))->count == 0, "empty list");
+
+    const char* byAge[] = {"bob", "dee", "ann", "cy", "eve"};
+    const double byName[] = {31, 25, 31, 25, 40};
+    CHECK(isStrings(global("ages"), byAge, 5), "sort_by number keys is stable");
+    CHECK(isNumber(global("keyCalls"), 5), "sort_by calls the key once per item");
+    CHECK(isNumberList(global("byName"), byName, 5), "sort_by string keys");
+    CHECK(IS_NIL(global("badKeys")), "sort_by rejects keys without an order");
+}
+
+int main(void) {
+    testCore();
+    initVM(&vm);
+    registerStdLib(&vm);
+    testNative();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All sort tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
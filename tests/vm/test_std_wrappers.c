@@ -0,0 +1,205 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_std_wrappers.c
+ * Loads the std/lib wrappers over the native modules through the module
+ * graph, exactly as `use std.lib.<name>;` does from the source tree, and
+ * calls into each binding they reach as std.<name>.
+ */
+
+#include "test_support.h"
+#include "module_graph.h"
+
+#ifndef PROX_SOURCE_DIR
+#define PROX_SOURCE_DIR "."
+#endif
+
+static bool loaded(const char* name) {
+    Value value = NIL_VAL;
+    return tableGet(&vm.importer.modules, copyString(name, (int)strlen(name)), &value) && IS_MODULE(value);
+}
+
+// Runs 'source' in a fresh VM after linking the wrappers it uses
+static bool runWithWrappers(const char* source) {
+    freeVM(&vm);
+    initVM(&vm);
+    registerStdLib(&vm);
+
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* entry = parseSource(source);
+    ModuleGraph graph;
+    initModuleGraph(&graph, PROX_SOURCE_DIR "/main.prox");
+    bool ok = entry != NULL && buildModuleGraph(&graph, entry) &&
+              linkModuleGraph(&graph, &vm) == INTERPRET_OK;
+    ObjFunction* function = ok ? compileAST(&vm, entry) : NULL;
+    ok = function != NULL && interpretFunction(&vm, function) == INTERPRET_OK;
+    endCompilation(&arena);
+    freeModuleGraph(&graph);
+    return ok;
+}
+
+static void testJson(void) {
+    CHECK(runWithWrappers(
+        "use std.lib.json;\n"
+        "let text = JSON.stringify([\"a\", true]);\n"
+        "let doc = JSON.parse(\"[3, 4]\");\n"
+        "let second = doc[1];\n"
+        "let deep = JSON.get(\"[5, [6, 7]]\", \"1.1\");\n"), "json wrapper runs");
+    CHECK(loaded("std.lib.json"), "json wrapper registered");
+    CHECK(isString(global("text"), "[\"a\",true]"), "std.json.stringify from JSON");
+    CHECK(isNumber(global("second"), 4), "std.json.parse from JSON");
+    CHECK(isNumber(global("deep"), 7), "std.json.get from JSON");
+}
+
+static void testRegex(void) {
+    CHECK(runWithWrappers(
+        "use std.lib.regex;\n"
+        "let matched = Regex(\"a+b\", null).test(\"xaab\");\n"
+        "let at = Regex(\"b+\", null).search(\"aabb\");\n"
+        "let swapped = Regex(\"(\\w+)-(\\w+)\", null).replace(\"ab-cd\", \"$2-$1\");\n"
+        "let address = Pattern.isIPv4(\"10.0.0.255\");\n"
+        "let slug = TextUtils.slugify(\" Hello World \");\n"), "regex wrapper runs");
+    CHECK(loaded("std.lib.regex"), "regex wrapper registered");
+    CHECK(isBool(global("matched"), true), "std.regex.test from Regex");
+    CHECK(isNumber(global("at"), 2), "std.regex.search from Regex");
+    CHECK(isString(global("swapped"), "cd-ab"), "std.regex.replace from Regex");
+    CHECK(isBool(global("address"), true), "Pattern helpers");
+    CHECK(isString(global("slug"), "hello-world"), "TextUtils helpers");
+}
+
+static void testValidation(void) {
+    CHECK(runWithWrappers(
+        "use std.lib.validation;\n"
+        "let errors = [];\n"
+        "StringValidator().matches(\"^[a-z]+$\")._validate(\"code\", \"ABC\", errors);\n"
+        "let invalid = ValidationResult(false, errors, null).hasError(\"code\");\n"
+        "let clean = [];\n"
+        "StringValidator().matches(\"^[a-z]+$\")._validate(\"code\", \"abc\", clean);\n"
+        "let passed = len(clean);\n"
+        "let short = [];\n"
+        "Validator.string().minLength(2)._validate(\"name\", \"A\", short);\n"
+        "let tooShort = len(short);\n"
+        "let email = Validate.isEmail(\"a@b.io\");\n"), "validation wrapper runs");
+    CHECK(loaded("std.lib.validation"), "validation wrapper registered");
+    CHECK(isBool(global("invalid"), true), "std.regex from the string validator");
+    CHECK(isNumber(global("passed"), 0), "matching value records no error");
+    CHECK(isNumber(global("tooShort"), 1), "Validator builds typed validators");
+    CHECK(isBool(global("email"), true), "Validate helpers");
+}
+
+#define FS_PATH "std_wrappers_fs.tmp"
+
+static void testFs(void) {
+    FILE* file = fopen(FS_PATH, "wb");
+    CHECK(file != NULL, "create fs input");
+    if (file == NULL) return;
+    fputs("one\ntwo\n", file);
+    fclose(file);
+
+    CHECK(runWithWrappers(
+        "use std.lib.fs;\n"
+        "let exists = File.exists(\"" FS_PATH "\");\n"
+        "let first = Stream(\"" FS_PATH "\", \"r\").readLine();\n"
+        "let lines = 0;\n"
+        "func countLine(line) { lines = lines + 1; }\n"
+        "File.eachLine(\"" FS_PATH "\", countLine);\n"
+        "let missing = File.read(\"no/such/file.txt\");\n"
+        "let closed = Stream(\"no/such/file.txt\", null).readLine();\n"), "fs wrapper runs");
+    remove(FS_PATH);
+    CHECK(loaded("std.lib.fs"), "fs wrapper registered");
+    CHECK(isBool(global("exists"), true), "std.fs.exists from File");
+    CHECK(isString(global("first"), "one"), "std.fs.read_line from Stream");
+    CHECK(isNumber(global("lines"), 2), "File.eachLine streams every line");
+    CHECK(IS_NIL(global("missing")), "missing file reads as null");
+    CHECK(IS_NIL(global("closed")), "stream on a missing file returns null");
+}
+
+static void testBuffer(void) {
+    CHECK(runWithWrappers(
+        "use std.lib.buffer;\n"
+        "let buf = Buffer.alloc(8);\n"
+        "Buffer.writeU32(buf, 0, 258, true);\n"
+        "let word = Buffer.readU32(buf, 0, true);\n"
+        "let high = Buffer.readU8(buf, 2);\n"
+        "let text = Buffer.fromString(\"hello\");\n"
+        "let tail = Buffer.toString(Buffer.slice(text, 1, 3));\n"), "buffer wrapper runs");
+    CHECK(loaded("std.lib.buffer"), "buffer wrapper registered");
+    CHECK(isNumber(global("word"), 258), "std.buffer typed access from Buffer");
+    CHECK(isNumber(global("high"), 1), "big-endian byte order");
+    CHECK(isString(global("tail"), "ell"), "std.buffer.slice from Buffer");
+}
+
+static void testHash(void) {
+    CHECK(runWithWrappers(
+        "use std.lib.hash;\n"
+        "let digest = Hasher(\"sha256\", null).update(\"abc\").hex();\n"
+        "let direct = Hash.sha256(\"abc\");\n"
+        "let streamed = Hash.hasher(\"sha256\", null).update(\"a\").update(\"bc\").hex();\n"
+        "let crc = Hash.crc32c(\"123456789\", null);\n"), "hash wrapper runs");
+    const char* abc = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+    CHECK(loaded("std.lib.hash"), "hash wrapper registered");
+    CHECK(isString(global("digest"), abc), "std.hash from Hasher");
+    CHECK(isString(global("direct"), abc), "std.hash.sha256 from Hash");
+    CHECK(isString(global("streamed"), abc), "incremental hashing from Hash.hasher");
+    CHECK(isNumber(global("crc"), 0xe3069283u), "std.hash.crc32c from Hash");
+}
+
+static void testIter(void) {
+    CHECK(runWithWrappers(
+        "use std.lib.iter;\n"
+        "func double(x) { return x * 2; }\n"
+        "func odd(x) { return x % 2 == 1; }\n"
+        "let total = Iter.sum(Iter.map(Iter.filter(Iter.range(0, 10, 1), odd), double));\n"
+        "let firstTwo = Iter.collect(Iter.take(Iter.range(5, 100, 1), 2));\n"
+        "let head = firstTwo[1];\n"
+        "let it = Iter.of(\"ab\");\n"
+        "Iter.next(it, null);\n"
+        "let second = Iter.next(it, null);\n"
+        "let done = Iter.next(it, \"end\");\n"), "iter wrapper runs");
+    CHECK(loaded("std.lib.iter"), "iter wrapper registered");
+    CHECK(isNumber(global("total"), 50), "std.iter stages from Iter");
+    CHECK(isNumber(global("head"), 6), "Iter.take and Iter.collect");
+    CHECK(isString(global("second"), "b"), "std.iter.next from Iter");
+    CHECK(isString(global("done"), "end"), "exhausted iterator gives the fallback");
+}
+
+static void testTyped(void) {
+    CHECK(runWithWrappers(
+        "use std.lib.typed;\n"
+        "let floats = Float64Array.of(4);\n"
+        "TypedArray.fill(floats, 1.5);\n"
+        "let total = TypedArray.sum(floats);\n"
+        "let ints = Int32Array.of(3);\n"
+        "ints[1] = 2.7;\n"
+        "let truncated = ints[1];\n"
+        "let kind = TypedArray.kind(ints);\n"
+        "let found = TypedArray.indexOf(ints, 2, 0);\n"
+        "let part = len(TypedArray.toList(TypedArray.slice(floats, 1, 3)));\n"), "typed wrapper runs");
+    CHECK(loaded("std.lib.typed"), "typed wrapper registered");
+    CHECK(isNumber(global("total"), 6), "std.typed fill and sum from TypedArray");
+    CHECK(isNumber(global("truncated"), 2), "Int32Array stores 32-bit integers");
+    CHECK(isString(global("kind"), "int32"), "std.typed.kind from TypedArray");
+    CHECK(isNumber(global("found"), 1), "std.typed.index_of from TypedArray");
+    CHECK(isNumber(global("part"), 2), "std.typed.slice and to_list from TypedArray");
+}
+
+int main(void) {
+    setenv("PROXPL_NO_CACHE", "1", 1);
+    initVM(&vm);
+    testJson();
+    testRegex();
+    testValidation();
+    testFs();
+    testBuffer();
+    testHash();
+    testIter();
+    testTyped();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All std wrapper tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
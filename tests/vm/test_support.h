@@ -0,0 +1,113 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_support.h
+ * Fixtures shared by the VM tests: the CHECK macro and its failure count,
+ * parsing and running a source string, reading globals back, and finding
+ * functions in lowered IR. Each test is a single translation unit, so
+ * everything here is static.
+ */
+
+#ifndef PROX_TEST_SUPPORT_H
+#define PROX_TEST_SUPPORT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vm.h"
+#include "scanner.h"
+#include "parser.h"
+#include "table.h"
+#include "arena.h"
+#include "ir.h"
+
+#include "../include/value.h"
+#include "../include/object.h"
+
+void registerStdLib(VM* vm);
+IRModule* generateSSA_IR(StmtList* program);
+
+static int failures = 0;
+
+#define CHECK(cond, msg) \
+    do { if (!(cond)) { fprintf(stderr, "FAIL: %s\n", msg); failures++; } } while (0)
+
+// Parses 'source' into the current compilation's arena. NULL on a parse
+// error.
+static inline StmtList* parseSource(const char* source) {
+    int count = 0;
+    Token* tokens = scanAllTokens(source, &count);
+    Parser parser;
+    initParser(&parser, tokens, count, source);
+    StmtList* statements = parse(&parser);
+    free(tokens);
+    return statements;
+}
+
+// Compiles and runs 'source' as a script in the global VM
+static inline InterpretResult execute(const char* source) {
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* statements = parseSource(source);
+    ObjFunction* function = statements ? compileAST(&vm, statements) : NULL;
+    InterpretResult result = function ? interpretFunction(&vm, function) : INTERPRET_COMPILE_ERROR;
+    endCompilation(&arena);
+    return result;
+}
+
+// Runs 'source', counting a failure if it does not finish cleanly
+static inline bool run(const char* source) {
+    bool ok = execute(source) == INTERPRET_OK;
+    CHECK(ok, "source runs");
+    return ok;
+}
+
+static inline Value global(const char* name) {
+    Value value = NIL_VAL;
+    tableGet(&vm.globals, copyString(name, (int)strlen(name)), &value);
+    return value;
+}
+
+static inline bool isNumber(Value value, double expected) {
+    return IS_NUMBER(value) && AS_NUMBER(value) == expected;
+}
+
+static inline bool isBool(Value value, bool expected) {
+    return IS_BOOL(value) && AS_BOOL(value) == expected;
+}
+
+static inline bool isString(Value value, const char* expected) {
+    return IS_STRING(value) && AS_STRING(value)->length == (int)strlen(expected) &&
+           memcmp(AS_CSTRING(value), expected, strlen(expected)) == 0;
+}
+
+// True if 'value' is a list of exactly these numbers
+static inline bool isNumberList(Value value, const double* expected, int count) {
+    if (!IS_LIST(value) || AS_LIST(value)->count != count) return false;
+    for (int i = 0; i < count; i++) {
+        if (!isNumber(AS_LIST(value)->items[i], expected[i])) return false;
+    }
+    return true;
+}
+
+static inline IRFunction* findFunction(IRModule* module, const char* name) {
+    for (int i = 0; i < module->funcCount; i++) {
+        if (strcmp(module->functions[i]->name, name) == 0) return module->functions[i];
+    }
+    return NULL;
+}
+
+static inline int countOp(IRFunction* func, IROpcode opcode) {
+    int count = 0;
+    for (int i = 0; i < func->blockCount; i++) {
+        for (IRInstruction* instr = func->blocks[i]->first; instr; instr = instr->next) {
+            if (instr->opcode == opcode) count++;
+        }
+    }
+    return count;
+}
+
+#endif // PROX_TEST_SUPPORT_H
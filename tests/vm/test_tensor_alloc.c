@@ -0,0 +1,41 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_tensor_alloc.c
+ * Forces a collection while newTensor allocates its dims and data, and
+ * checks that the tensor survives it with its shape and values intact.
+ */
+
+#include "test_support.h"
+
+static bool isLive(Obj* object) {
+    for (Obj* live = vm.objects; live != NULL; live = live->next) {
+        if (live == object) return true;
+    }
+    return false;
+}
+
+static void testCollectDuringAllocation(void) {
+    int dims[2] = {2, 3};
+    double data[6] = {1, 2, 3, 4, 5, 6};
+
+    // The object itself fits under the threshold; its first array does not
+    vm.nextGC = vm.bytesAllocated + sizeof(ObjTensor);
+    ObjTensor* tensor = newTensor(2, dims, data);
+
+    CHECK(isLive((Obj*)tensor), "tensor survives a collection in newTensor");
+    CHECK(tensor->dimCount == 2 && tensor->dims[0] == 2 && tensor->dims[1] == 3, "dims are copied");
+    CHECK(tensor->size == 6 && tensor->data[5] == 6, "data is copied");
+}
+
+int main(void) {
+    initVM(&vm);
+    testCollectDuringAllocation();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All tensor allocation tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_typed_array.c
+ * Verifies Float64Array and Int32Array: creation, indexing and stores
+ * (with Int32 truncation), bounds and type errors, len and for-in, and the
+ * std.typed aggregates on lengths that exercise both the vector bodies and
+ * their scalar tails.
+ */
+
+#include "test_support.h"
+#include "gc.h"
+
+static void testIndexing(void) {
+    run("use std.typed;\n"
+        "let f = std.typed.float64(4);\n"
+        "f[0] = 1.5;\n"
+        "f[3] = f[0] * 2;\n"
+        "let fFirst = f[0];\n"
+        "let fLast = f[3];\n"
+        "let fZero = f[1];\n"
+        "let fLen = len(f);\n"
+        "let n = std.typed.int32([1, 2, 3]);\n"
+        "n[0] = 7.9;\n"
+        "n[1] = -7.9;\n"
+        "n[2] = 4294967297;\n"
+        "let n0 = n[0];\n"
+        "let n1 = n[1];\n"
+        "let n2 = n[2];\n"
+        "let total = 0;\n"
+        "for (let x in std.typed.float64(std.typed.int32([10, 20, 30]))) { total = total + x; }\n"
+        "let kindF = std.typed.kind(f);\n"
+        "let kindN = std.typed.kind(n);\n"
+        "let mixed = std.typed.float64([1, \"x\"]);\n"
+        "let negative = std.typed.int32(-1);\n");
+
+    CHECK(isNumber(global("fFirst"), 1.5), "Float64Array store and load");
+    CHECK(isNumber(global("fLast"), 3), "element arithmetic");
+    CHECK(isNumber(global("fZero"), 0), "new arrays are zero-filled");
+    CHECK(isNumber(global("fLen"), 4), "len");
+    CHECK(isNumber(global("n0"), 7) && isNumber(global("n1"), -7), "Int32Array truncates");
+    CHECK(isNumber(global("n2"), 1), "Int32Array wraps modulo 2^32");
+    CHECK(isNumber(global("total"), 60), "for-in and conversion between kinds");
+    CHECK(isString(global("kindF"), "float64") && isString(global("kindN"), "int32"), "kind");
+    CHECK(IS_NIL(global("mixed")), "a list with a non-number");
+    CHECK(IS_NIL(global("negative")), "negative length");
+}
+
+static void testErrors(void) {
+    CHECK(execute("let a = std.typed.float64(2);\nprint(a[2]);\n") == INTERPRET_RUNTIME_ERROR,
+          "load out of bounds");
+    CHECK(execute("let a = std.typed.int32(2);\na[-1] = 1;\n") == INTERPRET_RUNTIME_ERROR,
+          "store out of bounds");
+    CHECK(execute("let a = std.typed.float64(2);\na[0] = \"x\";\n") == INTERPRET_RUNTIME_ERROR,
+          "storing a non-number");
+    CHECK(execute("let a = std.typed.float64(2);\nprint(a[\"x\"]);\n") == INTERPRET_RUNTIME_ERROR,
+          "non-number index");
+}
+
+static void testAggregates(void) {
+    // 1003 elements: whole vectors plus a tail of three
+    run("use std.typed;\n"
+        "let f = std.typed.float64(1003);\n"
+        "let n = std.typed.int32(1003);\n"
+        "for (let i = 0; i < 1003; i = i + 1) {\n"
+        "    f[i] = i * 0.5;\n"
+        "    n[i] = i - 500;\n"
+        "}\n"
+        "std.gc.collect();\n"
+        "let fSum = std.typed.sum(f);\n"
+        "let nSum = std.typed.sum(n);\n"
+        "let fMin = std.typed.min(f);\n"
+        "let fMax = std.typed.max(f);\n"
+        "n[700] = -9000;\n"
+        "n[1002] = 9000;\n"
+        "let nMin = std.typed.min(n);\n"
+        "let nMax = std.typed.max(n);\n"
+        "let ones = std.typed.fill(std.typed.float64(1003), 1);\n"
+        "let dotF = std.typed.dot(f, ones);\n"
+        "let dotMixed = std.typed.dot(std.typed.int32([1, 2, 3]), std.typed.float64([0.5, 0.5, 0.5]));\n"
+        "let dotUneven = std.typed.dot(f, std.typed.float64(2));\n"
+        "let found = std.typed.index_of(f, 250.5);\n"
+        "let foundTail = std.typed.index_of(f, 501);\n"
+        "let foundFrom = std.typed.index_of(std.typed.int32([4, 4, 4]), 4, 1);\n"
+        "let notWhole = std.typed.index_of(n, 0.5);\n"
+        "let missing = std.typed.index_of(f, -1);\n"
+        "let scaled = std.typed.scale(std.typed.float64([1, 2, 3, 4, 5]), 3);\n"
+        "let scaledLast = scaled[4];\n"
+        "let halved = std.typed.scale(std.typed.int32([5, -5]), 0.5);\n"
+        "let part = std.typed.slice(n, 1000);\n"
+        "let partList = std.typed.to_list(part);\n"
+        "let emptyMin = std.typed.min(std.typed.float64(0));\n");
+
+    // f[i] = i / 2 for i < 1003, n[i] = i - 500 with two elements replaced
+    CHECK(isNumber(global("fSum"), 1002.0 * 1003.0 / 4.0), "Float64 sum");
+    CHECK(isNumber(global("nSum"), 1002.0 * 1003.0 / 2.0 - 500.0 * 1003.0), "Int32 sum");
+    CHECK(isNumber(global("fMin"), 0) && isNumber(global("fMax"), 501), "Float64 min and max");
+    CHECK(isNumber(global("nMin"), -9000) && isNumber(global("nMax"), 9000), "Int32 min and max");
+    CHECK(isNumber(global("dotF"), 1002.0 * 1003.0 / 4.0), "Float64 dot");
+    CHECK(isNumber(global("dotMixed"), 3), "dot across kinds");
+    CHECK(IS_NIL(global("dotUneven")), "dot of different lengths");
+    CHECK(isNumber(global("found"), 501), "index_of in the vector body");
+    CHECK(isNumber(global("foundTail"), 1002), "index_of in the tail");
+    CHECK(isNumber(global("foundFrom"), 1), "index_of from a start");
+    CHECK(isNumber(global("notWhole"), -1), "a fraction is never in an Int32Array");
+    CHECK(isNumber(global("missing"), -1), "index_of a missing value");
+    CHECK(isNumber(global("scaledLast"), 15), "scale in place");
+
+    Value halved = global("halved");
+    CHECK(IS_TYPED_ARRAY(halved) && AS_TYPED_ARRAY(halved)->as.i32[0] == 2 &&
+          AS_TYPED_ARRAY(halved)->as.i32[1] == -2, "Int32 scale truncates");
+
+    Value part = global("partList");
+    CHECK(IS_LIST(part) && AS_LIST(part)->count == 3 && isNumber(AS_LIST(part)->items[0], 500) &&
+          isNumber(AS_LIST(part)->items[2], 9000), "slice and to_list");
+    CHECK(IS_NIL(global("emptyMin")), "min of an empty array");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testIndexing();
+    testErrors();
+    testAggregates();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All typed array tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
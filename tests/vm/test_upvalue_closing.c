@@ -0,0 +1,61 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_upvalue_closing.c
+ * Verifies that captured locals move into their upvalues when their slot
+ * goes away: on return, at the end of a block, and when break or continue
+ * leaves a loop body. A closure must keep reading its own value after a
+ * later call reuses the slot.
+ */
+
+#include "test_support.h"
+
+static void testClosing(void) {
+    InterpretResult result = execute(
+        "func mk() { let x = 5; func get() { return x; } return get; }\n"
+        "func name() { let s = \"kept\"; func get() { return s; } return get; }\n"
+        "func noise(a, b, c) { let q = 99; return q; }\n"
+        "let g = mk();\n"
+        "let h = name();\n"
+        "noise(1, 2, 3);\n"
+        "let returned = g();\n"
+        "let named = h();\n"
+        "let fs = [];\n"
+        "let i = 0;\n"
+        "while (i < 3) { let j = i * 10; func c() { return j; } push(fs, c); i = i + 1; }\n"
+        "let f0 = fs[0]; let f1 = fs[1]; let f2 = fs[2];\n"
+        "let scoped = f0() + f1() + f2();\n"
+        "let gs = [];\n"
+        "let n = 0;\n"
+        "while (true) {\n"
+        "  let v = n + 1;\n"
+        "  func c() { return v; }\n"
+        "  push(gs, c);\n"
+        "  n = n + 1;\n"
+        "  if (n < 2) continue;\n"
+        "  break;\n"
+        "}\n"
+        "noise(4, 5, 6);\n"
+        "let g0 = gs[0]; let g1 = gs[1];\n"
+        "let jumped = g0() * 10 + g1();\n");
+    CHECK(result == INTERPRET_OK, "run closing source");
+
+    CHECK(isNumber(global("returned"), 5), "return closes captured locals");
+    Value named = global("named");
+    CHECK(IS_STRING(named) && strcmp(AS_CSTRING(named), "kept") == 0, "captured string survives the return");
+    CHECK(isNumber(global("scoped"), 30), "block exit closes each iteration's capture");
+    CHECK(isNumber(global("jumped"), 12), "continue and break close captured locals");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testClosing();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All upvalue closing tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_upvalue_flattening.c
+ * Verifies closure capture: variables that are never reassigned are copied
+ * into the closure, directly or through an enclosing closure, while
+ * reassigned ones are still shared through upvalues and closed when their
+ * scope ends. Functions that capture nothing reuse one closure object.
+ */
+
+#include "test_support.h"
+
+static ObjFunction* closureFunction(const char* name) {
+    Value value = global(name);
+    return IS_CLOSURE(value) ? AS_CLOSURE(value)->function : NULL;
+}
+
+static void testFlatCaptures(void) {
+    CHECK(execute("func mk(a) { let b = a * 2; func get() { return a + b; } return get; }\n"
+                  "let g = mk(4);\n"
+                  "let h = mk(10);\n"
+                  "let fromG = g();\n"
+                  "let fromH = h();\n"
+                  "func outer(x) { func mid() { func inner() { return x; } return inner; } return mid(); }\n"
+                  "let deep = outer(42);\n"
+                  "let fromDeep = deep();\n"
+                  "let fs = [];\n"
+                  "let i = 0;\n"
+                  "while (i < 3) { let j = i * 10; push(fs, func() { return j; }); i = i + 1; }\n"
+                  "let f0 = fs[0]; let f2 = fs[2];\n"
+                  "let perIteration = f0() + f2();\n") == INTERPRET_OK,
+          "run flat capture source");
+
+    CHECK(isNumber(global("fromG"), 12) && isNumber(global("fromH"), 30), "closures keep their own copies");
+    ObjFunction* get = closureFunction("g");
+    CHECK(get != NULL && get->captureCount == 2 && get->upvalueCount == 0,
+          "never-reassigned variables are flat captures");
+    CHECK(isNumber(global("fromDeep"), 42), "capture through an enclosing closure");
+    ObjFunction* inner = closureFunction("deep");
+    CHECK(inner != NULL && inner->captureCount == 1 && inner->upvalueCount == 0,
+          "transitive capture stays flat");
+    CHECK(isNumber(global("perIteration"), 20), "each iteration's value is copied");
+}
+
+static void testMutableCaptures(void) {
+    CHECK(execute("func counter() { let n = 0; func inc() { n = n + 1; return n; } return inc; }\n"
+                  "let c = counter();\n"
+                  "c(); c();\n"
+                  "let counted = c();\n"
+                  "func pair() { let v = 1; func set(x) { v = x; return 0; } func get() { return v; } set(9); return get(); }\n"
+                  "let shared = pair();\n"
+                  "func late() { let w = 1; func get() { return w; } w = 5; return get; }\n"
+                  "let lateGet = late();\n"
+                  "let afterReturn = lateGet();\n"
+                  "let gs = [];\n"
+                  "let k = 0;\n"
+                  "while (k < 3) { let j = k * 10; push(gs, func() { j = j + 1; return j; }); k = k + 1; }\n"
+                  "let g1 = gs[1];\n"
+                  "g1();\n"
+                  "let bumped = g1();\n") == INTERPRET_OK,
+          "run mutable capture source");
+
+    CHECK(isNumber(global("counted"), 3), "reassigned variable is shared through an upvalue");
+    ObjFunction* inc = closureFunction("c");
+    CHECK(inc != NULL && inc->upvalueCount == 1 && inc->captureCount == 0, "reassigned variable is boxed");
+    CHECK(isNumber(global("shared"), 9), "sibling closures share a reassigned variable");
+    CHECK(isNumber(global("afterReturn"), 5), "assignment after capture is seen");
+    CHECK(isNumber(global("bumped"), 12), "each iteration's upvalue is closed separately");
+    CHECK(vm.openUpvalueTop == 0, "no upvalue left open");
+}
+
+static void testSharedClosures(void) {
+    CHECK(execute("func make() { func k() { return 7; } return k; }\n"
+                  "let s1 = make();\n"
+                  "let s2 = make();\n"
+                  "func makeLambda() { return func(v) { return v + 1; }; }\n"
+                  "let l1 = makeLambda();\n"
+                  "let l2 = makeLambda();\n"
+                  "let total = s1() + l2(1);\n"
+                  "func makeCapturing(a) { return func() { return a; }; }\n"
+                  "let c1 = makeCapturing(1);\n"
+                  "let c2 = makeCapturing(2);\n") == INTERPRET_OK,
+          "run shared closure source");
+
+    CHECK(isNumber(global("total"), 9), "shared closures run");
+    Value s1 = global("s1"), s2 = global("s2");
+    CHECK(IS_CLOSURE(s1) && IS_CLOSURE(s2) && AS_OBJ(s1) == AS_OBJ(s2),
+          "capture-free function has one closure");
+    Value l1 = global("l1"), l2 = global("l2");
+    CHECK(IS_CLOSURE(l1) && IS_CLOSURE(l2) && AS_OBJ(l1) == AS_OBJ(l2),
+          "capture-free lambda has one closure");
+    Value c1 = global("c1"), c2 = global("c2");
+    CHECK(IS_CLOSURE(c1) && IS_CLOSURE(c2) && AS_OBJ(c1) != AS_OBJ(c2),
+          "capturing lambda gets a closure per evaluation");
+}
+
+int main(void) {
+    initVM(&vm);
+    registerStdLib(&vm);
+    testFlatCaptures();
+    testMutableCaptures();
+    testSharedClosures();
+    freeVM(&vm);
+
+    if (failures == 0) printf("All upvalue flattening tests passed.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* test_wide_operands.c
+ * Verifies the OP_WIDE operand forms: programs with more than 256
+ * constants, globals, locals, upvalues or literal elements, more than 64K
+ * constants or names, and function bodies whose jumps span more than 64KB
+ * of code.
+ */
+
+#include <stdarg.h>
+#include "test_support.h"
+#include "bytecode.h"
+#include "bytecode_image.h"
+
+typedef struct {
+    char* chars;
+    size_t length;
+    size_t capacity;
+} Source;
+
+static void append(Source* source, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    char piece[256];
+    int length = vsnprintf(piece, sizeof(piece), format, args);
+    va_end(args);
+
+    if (source->length + length + 1 > source->capacity) {
+        source->capacity = (source->capacity + length + 1) * 2;
+        source->chars = (char*)realloc(source->chars, source->capacity);
+    }
+    memcpy(source->chars + source->length, piece, length + 1);
+    source->length += length;
+}
+
+static bool runSource(Source* source) {
+    bool ok = execute(source->chars) == INTERPRET_OK;
+    free(source->chars);
+    source->chars = NULL;
+    source->length = source->capacity = 0;
+    return ok;
+}
+
+int main(void) {
+    initVM(&vm);
+    Source source = {NULL, 0, 0};
+
+    /* 300 globals, each with its own name and number constant */
+    for (int i = 0; i < 300; i++) append(&source, "let g%d = %d;\n", i, i);
+    append(&source, "let globals = g0");
+    for (int i = 1; i < 300; i++) append(&source, " + g%d", i);
+    append(&source, ";\n");
+    CHECK(runSource(&source), "run 300 globals");
+    CHECK(isNumber(global("globals"), 299 * 300 / 2), "sum of 300 globals");
+
+    /* 300 locals, and a closure capturing all of them */
+    append(&source, "func locals() {\n");
+    for (int i = 0; i < 300; i++) append(&source, "  let l%d = %d;\n", i, i);
+    append(&source, "  l299 = l299 + l0 + 1;\n");
+    append(&source, "  func inner() { return l0");
+    for (int i = 1; i < 300; i++) append(&source, " + l%d", i);
+    append(&source, "; }\n");
+    append(&source, "  return inner() + l299;\n");
+    append(&source, "}\n");
+    append(&source, "let captured = locals();\n");
+    CHECK(runSource(&source), "run 300 locals");
+    CHECK(isNumber(global("captured"), 299 * 300 / 2 + 1 + 300), "locals above slot 255 and their upvalues");
+
+    /* List and map literals with more than 256 elements */
+    append(&source, "let list = [");
+    for (int i = 0; i < 300; i++) append(&source, "%s\"e%d\"", i ? ", " : "", i);
+    append(&source, "];\n");
+    append(&source, "let map = {");
+    for (int i = 0; i < 300; i++) append(&source, "%s\"k%d\": %d", i ? ", " : "", i, i);
+    append(&source, "};\n");
+    append(&source, "let first = list[0];\nlet last = list[299];\nlet mapped = map[\"k299\"];\n");
+    CHECK(runSource(&source), "run large literals");
+    Value first = global("first");
+    Value last = global("last");
+    CHECK(IS_STRING(first) && strcmp(AS_STRING(first)->chars, "e0") == 0, "300-element list head");
+    CHECK(IS_STRING(last) && strcmp(AS_STRING(last)->chars, "e299") == 0, "300-element list tail");
+    CHECK(isNumber(global("mapped"), 299), "300-entry map");
+
+    /* More than 64K constants reach for OP_CONSTANT_LONG */
+    append(&source, "let constants = 0;\n");
+    for (int i = 0; i < 70000; i++) append(&source, "constants = constants + %d;\n", i);
+    CHECK(runSource(&source), "run 70000 constants");
+    CHECK(isNumber(global("constants"), 69999.0 * 70000.0 / 2), "sum of 70000 constants");
+
+    /* More than 64K names: the class, its method and the invoke that
+     * follow sit past constant index 65535 */
+    for (int i = 0; i < 70000; i++) append(&source, "let n%d = %d;\n", i, i);
+    append(&source, "let names = n0 + n65535 + n69999;\n");
+    append(&source, "class Far { func get() { return n69998; } }\n");
+    append(&source, "let farName = Far().get();\n");
+    Arena arena;
+    beginCompilation(&arena);
+    StmtList* statements = parseSource(source.chars);
+    ObjFunction* script = statements ? compileAST(&vm, statements) : NULL;
+    endCompilation(&arena);
+    CHECK(script != NULL && script->chunk.constants.count > 2 * 70000, "compile 70000 names");
+
+    uint8_t key[PROXC_KEY_SIZE];
+    proxc_cache_key(source.chars, source.length, key);
+    uint8_t* image = NULL;
+    size_t length = 0;
+    ObjFunction* loaded = NULL;
+    if (script != NULL && proxc_serialize(script, key, &image, &length)) {
+        loaded = proxc_load(image, length, key);
+    }
+    CHECK(loaded != NULL, "image with 24-bit name operands loads");
+    CHECK(loaded != NULL && interpretFunction(&vm, loaded) == INTERPRET_OK, "run 70000 names");
+    CHECK(isNumber(global("names"), 65535 + 69999), "globals named past index 65535");
+    CHECK(isNumber(global("farName"), 69998), "class, method and invoke past index 65535");
+    free(source.chars);
+    source.chars = NULL;
+    source.length = source.capacity = 0;
+
+    /* Branches and a loop whose bodies span more than 64KB of bytecode */
+    append(&source, "func far(n) {\n  let x = 0;\n  if (n > 0) {\n");
+    for (int i = 0; i < 9000; i++) append(&source, "    x = x + 1;\n");
+    append(&source, "  }\n  let i = 0;\n  while (i < n) {\n");
+    for (int i = 0; i < 9000; i++) append(&source, "    x = x + 1;\n");
+    append(&source, "    i = i + 1;\n  }\n  return x;\n}\n");
+    append(&source, "let farZero = far(0);\nlet farTwo = far(2);\n");
+    CHECK(runSource(&source), "run 64KB jumps");
+    CHECK(isNumber(global("farZero"), 0), "long forward jump over the if body");
+    CHECK(isNumber(global("farTwo"), 9000 + 2 * 9000), "long backward loop");
+
+    Value far = global("far");
+    CHECK(IS_CLOSURE(far) && AS_CLOSURE(far)->function->chunk.count > 2 * 65535,
+          "far() bodies exceed the 16-bit jump range");
+
+    /* Small programs keep the compact encodings */
+    CHECK(execute("func small(a) { if (a > 1) { return a; } return 0; }\n") == INTERPRET_OK, "define small");
+    Value small = global("small");
+    if (IS_CLOSURE(small)) {
+        Chunk* chunk = &AS_CLOSURE(small)->function->chunk;
+        bool wide = false;
+        for (int i = 0; i < chunk->count; i++) {
+            if (chunk->code[i] == OP_WIDE) wide = true;
+        }
+        CHECK(!wide, "no OP_WIDE in a small function");
+    }
+
+    if (failures == 0) {
+        printf("wide operands OK\n");
+        return 0;
+    }
+    return 1;
+}
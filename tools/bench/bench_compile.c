@@ -0,0 +1,129 @@
+// --------------------------------------------------
+//   Project: ProX Programming Language (ProXPL)
+//   Author:  ProgrammerKR
+//   Created: 2026-10-18
+//   Copyright © 2026. ProXentix India Pvt. Ltd.  All rights reserved.
+
+/* bench_compile.c
+ * Compile-throughput benchmark: generates a large synthetic program and
+ * times each front-end phase (scan, parse, optimize, type check, bytecode
+ * generation) without running the result.
+ *
+ * Usage: bench_compile [functions] [runs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../../include/vm.h"
+#include "../../include/scanner.h"
+#include "../../include/parser.h"
+#include "../../include/optimizer.h"
+#include "../../include/type_checker.h"
+#include "../../include/arena.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+static double now_seconds(void) {
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER cnt;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&cnt);
+    return (double)cnt.QuadPart / (double)freq.QuadPart;
+}
+#else
+static double now_seconds(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+#endif
+
+/* Operator-heavy functions, the shape of our generated sources */
+static const char *TEMPLATE =
+    "func f%d(a, b) {\n"
+    "  let x = a * 2 + b - %d;\n"
+    "  let y = (x << 1) | (b & 7) ^ (a >> 2);\n"
+    "  if (x > y && a != b || !(x == 0)) { x = x - y; } else { y = y + x %% 3; }\n"
+    "  let i = 0;\n"
+    "  while (i <= 10) { x = x + i * a / 2 - -y; i = i + 1; }\n"
+    "  return x >= y or a < 0 and b != 1;\n"
+    "}\n";
+
+static char *generate(int functions, int *lines) {
+    size_t capacity = (size_t)functions * 512 + 1;
+    char *source = (char *)malloc(capacity);
+    size_t length = 0;
+    for (int i = 0; i < functions; i++) {
+        length += snprintf(source + length, capacity - length, TEMPLATE, i, i);
+    }
+    *lines = functions * 8;
+    return source;
+}
+
+int main(int argc, char **argv) {
+    int functions = argc > 1 ? atoi(argv[1]) : 5000;
+    int runs = argc > 2 ? atoi(argv[2]) : 5;
+
+    initVM(&vm);
+    int lines;
+    char *source = generate(functions, &lines);
+    size_t bytes = strlen(source);
+
+    double scan = 0, parseTime = 0, optimize = 0, check = 0, codegen = 0;
+    for (int r = 0; r < runs; r++) {
+        Arena arena;
+        beginCompilation(&arena);
+        double t0 = now_seconds();
+        int count = 0;
+        Token *tokens = scanAllTokens(source, &count);
+
+        double t1 = now_seconds();
+        Parser parser;
+        initParser(&parser, tokens, count, source);
+        StmtList *statements = parse(&parser);
+        if (statements == NULL) {
+            fprintf(stderr, "parse failed\n");
+            return 1;
+        }
+
+        double t2 = now_seconds();
+        optimizeAST(statements);
+
+        double t3 = now_seconds();
+        TypeChecker checker;
+        initTypeChecker(&checker);
+        checkTypes(&checker, statements);
+        freeTypeChecker(&checker);
+
+        double t4 = now_seconds();
+        ObjFunction *function = compileAST(&vm, statements);
+        double t5 = now_seconds();
+        if (function == NULL) {
+            fprintf(stderr, "bytecode generation failed\n");
+            return 1;
+        }
+
+        scan += t1 - t0;
+        parseTime += t2 - t1;
+        optimize += t3 - t2;
+        check += t4 - t3;
+        codegen += t5 - t4;
+
+        endCompilation(&arena);
+        free(tokens);
+    }
+
+    double total = scan + parseTime + optimize + check + codegen;
+    printf("functions=%d lines=%d bytes=%zu runs=%d\n", functions, lines, bytes, runs);
+    printf("scan=%.2fms parse=%.2fms optimize=%.2fms check=%.2fms codegen=%.2fms\n",
+           scan / runs * 1000.0, parseTime / runs * 1000.0, optimize / runs * 1000.0,
+           check / runs * 1000.0, codegen / runs * 1000.0);
+    printf("total=%.2fms throughput=%.0f lines/s (%.2f MB/s)\n",
+           total / runs * 1000.0, lines * runs / total, bytes * runs / total / 1e6);
+
+    free(source);
+    freeVM(&vm);
+    return 0;
+}
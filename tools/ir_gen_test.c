@@ -10,6 +10,7 @@
 #include "../include/ir.h"
 #include "../include/ir_opt.h"
 #include "../include/vm.h"
+#include "../include/arena.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -33,29 +34,27 @@ void test_ir(const char* source) {
         if (token.type == TOKEN_EOF || token.type == TOKEN_ERROR) break;
     }
 
+    Arena arena;
+    beginCompilation(&arena);
     Parser parser;
     initParser(&parser, tokens, tokenCount, source);
     StmtList* statements = parse(&parser);
 
     if (!statements) {
         printf("Parse failed\n");
+        endCompilation(&arena);
         return;
     }
 
     IRModule* ir = generateSSA_IR(statements);
     
     // Run optimizations
-    for (int i = 0; i < ir->funcCount; i++) {
-        promoteMemoryToRegisters(ir->functions[i]);
-        constantFold(ir->functions[i]);
-        deadCodeElimination(ir->functions[i]);
-    }
+    optimizeIRModule(ir);
 
     printf("\nGenerated Optimized IR:\n");
     dumpIR(ir);
 
-    freeIRModule(ir);
-    freeStmtList(statements);
+    endCompilation(&arena);
 }
 
 int main() {
@@ -68,7 +67,8 @@ int main() {
         "} else {\n"
         "    x = x + 1;\n"
         "}\n"
-        "let z = 10 * 5;\n"
+        "func twice(n) { return n * 2; }\n"
+        "let z = twice(10 * 5);\n"
         "while (x > 0) {\n"
         "    x = x - 1;\n"
         "}\n"